@@ -12,8 +12,10 @@
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/file.h"
+#include "core/format.h"
 #include "core/path.h"
 #include "core/signal.h"
+#include "core/thread.h"
 #include "core/time.h"
 #include "data/read.h"
 #include "data/utils.h"
@@ -71,10 +73,14 @@ Ret:
   return success;
 }
 
+#define pack_num_write_tasks 16
+
 typedef enum {
   PackState_Gathering,
-  PackState_Waiting, // Wait a single frame to flush loads to the cache.
-  PackState_Build,
+  PackState_Waiting,    // Wait a single frame to flush loads to the cache.
+  PackState_BuildBegin, // Layout the pack file and reserve the regions.
+  PackState_BuildWrite, // Entries are written (in parallel) by 'PackWriteSys'.
+  PackState_BuildEnd,   // Write the header and finalize the output file.
 
   PackState_Interupted,
   PackState_Failed,
@@ -88,19 +94,26 @@ typedef struct {
 } PackAsset;
 
 ecs_comp_define(PackComp) {
-  PackConfig cfg;
-  String     outputPath;
-  DynArray   assets; // PackAsset[], sorted on entity.
-  TimeSteady timeStart;
-  u64        frameIdx;
-  u32        uncachedCount;
-  PackState  state;
+  PackConfig   cfg;
+  String       outputPath;
+  String       orderPath;    // Optional load-order manifest; empty when not provided.
+  DynArray     assets;       // PackAsset[], sorted on entity.
+  TimeSteady   timeStart;
+  u64          frameIdx;
+  u32          uncachedCount;
+  PackState    state;
+  bool         incremental;
+  AssetPacker* packer;       // Valid during the build states.
+  File*        outFile;      // Valid during the build states.
+  File*        baselineFile; // Valid during the build states (optional).
+  i32          writeFailed;
 };
 
 static void ecs_destruct_texture_comp(void* data) {
   PackComp* comp = data;
   data_destroy(g_dataReg, g_allocHeap, g_packConfigMeta, mem_var(comp->cfg));
   string_free(g_allocHeap, comp->outputPath);
+  string_maybe_free(g_allocHeap, comp->orderPath);
   dynarray_destroy(&comp->assets);
 }
 
@@ -114,6 +127,18 @@ ecs_view_define(PackGlobalView) {
   ecs_access_write(PackComp);
 }
 
+ecs_view_define(PackWriteView) {
+  /**
+   * Mark the view as allowing parallel writes, reason is 'PackWriteSys' writes pack entries from
+   * multiple tasks in parallel. This is safe as different tasks write different entries.
+   */
+  ecs_view_flags(EcsViewFlags_AllowParallelRandomWrite);
+
+  ecs_access_read(AssetImportEnvComp);
+  ecs_access_write(AssetManagerComp);
+  ecs_access_write(PackComp);
+}
+
 ecs_view_define(PackAssetView) {
   ecs_access_read(AssetComp);
   ecs_access_maybe_read(AssetGraphicComp);
@@ -211,50 +236,149 @@ static String pack_write_path(const PackComp* pack) {
   return fmt_write_scratch("{}.tmp", fmt_text(pack->outputPath));
 }
 
-static bool pack_build(PackComp* p, AssetManagerComp* assetMan, const AssetImportEnvComp* impEnv) {
-  File*                 file       = null;
+static void pack_build_cleanup(PackComp* p) {
+  if (p->packer) {
+    asset_packer_destroy(p->packer);
+    p->packer = null;
+  }
+  if (p->baselineFile) {
+    file_destroy(p->baselineFile);
+    p->baselineFile = null;
+  }
+  if (p->outFile) {
+    file_destroy(p->outFile);
+    p->outFile = null;
+  }
+}
+
+/**
+ * Attempt to use the previous output file as a baseline so unchanged entries can be copied over
+ * instead of being re-read from the asset sources.
+ */
+static void pack_build_baseline(PackComp* p) {
+  File*            file;
+  const FileResult fileRes =
+      file_create(g_allocHeap, p->outputPath, FileMode_Open, FileAccess_Read, &file);
+  if (fileRes != FileResult_Success) {
+    log_i("No baseline pack file found", log_param("path", fmt_path(p->outputPath)));
+    return;
+  }
+  if (asset_packer_baseline(p->packer, file)) {
+    p->baselineFile = file; // NOTE: Has to stay open until the packer is destroyed.
+  } else {
+    file_destroy(file); // Baseline unusable (for example an older format); do a full build.
+  }
+}
+
+/**
+ * Apply a load-order manifest (one asset-id per line, see the dev asset panel to record one) so
+ * entries that are accessed early at runtime are laid out sequentially at the start of the file.
+ */
+static void pack_apply_order(PackComp* p) {
+  File*            file;
+  const FileResult fileRes =
+      file_create(g_allocHeap, p->orderPath, FileMode_Open, FileAccess_Read, &file);
+  if (fileRes != FileResult_Success) {
+    log_w(
+        "Failed to open order manifest",
+        log_param("path", fmt_path(p->orderPath)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+    return;
+  }
+  String data;
+  if (file_map(file, 0 /* offset */, 0 /* size */, FileHints_Prefetch, &data) == 0) {
+    u32 order = 0, matched = 0;
+    while (!string_is_empty(data)) {
+      String line;
+      data = format_read_line(data, &line);
+      line = string_trim_whitespace(line);
+      if (string_is_empty(line)) {
+        continue;
+      }
+      matched += asset_packer_order(p->packer, line, order++);
+    }
+    log_i(
+        "Applied order manifest",
+        log_param("path", fmt_path(p->orderPath)),
+        log_param("entries", fmt_int(order)),
+        log_param("matched", fmt_int(matched)));
+  } else {
+    log_w("Failed to map order manifest", log_param("path", fmt_path(p->orderPath)));
+  }
+  file_destroy(file);
+}
+
+static bool
+pack_build_begin(PackComp* p, AssetManagerComp* assetMan, const AssetImportEnvComp* impEnv) {
   const FileAccessFlags fileAccess = FileAccess_Read | FileAccess_Write;
   FileResult            fileRes    = file_create_dir_sync(path_parent(p->outputPath));
   if (LIKELY(fileRes == FileResult_Success)) {
-    fileRes = file_create(g_allocHeap, pack_write_path(p), FileMode_Create, fileAccess, &file);
+    const String path = pack_write_path(p);
+    fileRes = file_create(g_allocHeap, path, FileMode_Create, fileAccess, &p->outFile);
   }
   if (UNLIKELY(fileRes != FileResult_Success)) {
-    goto FileError;
+    log_e(
+        "Failed to create output file",
+        log_param("path", fmt_path(p->outputPath)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+    return false;
+  }
+  p->packer = asset_packer_create(g_allocHeap, (u32)p->assets.size);
+  if (p->incremental) {
+    pack_build_baseline(p);
   }
-  AssetPacker* packer = asset_packer_create(g_allocHeap, (u32)p->assets.size);
 
   bool success = true;
   dynarray_for_t(&p->assets, PackAsset, packAsset) {
     diag_assert(!packAsset->loading && !string_is_empty(packAsset->id));
 
-    if (!asset_packer_push(packer, assetMan, impEnv, packAsset->id)) {
+    if (!asset_packer_push(p->packer, assetMan, impEnv, packAsset->id)) {
       log_e("Failed to push file", log_param("path", fmt_text(packAsset->id)));
       success = false;
     }
   }
-  if (success) {
-    AssetPackerStats stats;
-    if (asset_packer_write(packer, assetMan, impEnv, file, &stats)) {
-      log_i(
-          "Pack file build",
-          log_param("path", fmt_path(p->outputPath)),
-          log_param("size", fmt_size(stats.size)),
-          log_param("padding", fmt_size(stats.padding)),
-          log_param("header-size", fmt_size(stats.headerSize)),
-          log_param("entries", fmt_int(stats.entries)),
-          log_param("regions", fmt_int(stats.regions)),
-          log_param("blocks", fmt_int(stats.blocks)));
-    } else {
-      log_e("Failed to build pack file");
-      success = false;
-    }
+  if (success && !string_is_empty(p->orderPath)) {
+    pack_apply_order(p);
   }
-  asset_packer_destroy(packer);
+  if (!success || !asset_packer_write_begin(p->packer, p->outFile)) {
+    pack_build_cleanup(p);
+    file_delete_sync(pack_write_path(p));
+    return false;
+  }
+  return true;
+}
 
-  file_destroy(file);
+static bool pack_build_end(PackComp* p) {
+  bool success = !thread_atomic_load_i32(&p->writeFailed);
+
+  AssetPackerStats stats;
+  if (asset_packer_write_end(p->packer, p->outFile, &stats)) {
+    log_i(
+        "Pack file build",
+        log_param("path", fmt_path(p->outputPath)),
+        log_param("size", fmt_size(stats.size)),
+        log_param("padding", fmt_size(stats.padding)),
+        log_param("header-size", fmt_size(stats.headerSize)),
+        log_param("dedup-size", fmt_size(stats.dedupSize)),
+        log_param("entries", fmt_int(stats.entries)),
+        log_param("entries-reused", fmt_int(stats.entriesReused)),
+        log_param("entries-deduped", fmt_int(stats.entriesDeduped)),
+        log_param("regions", fmt_int(stats.regions)),
+        log_param("blocks", fmt_int(stats.blocks)));
+  } else {
+    log_e("Failed to build pack file");
+    success = false;
+  }
+  pack_build_cleanup(p);
+
+  FileResult fileRes;
   if (UNLIKELY(fileRes = file_rename(pack_write_path(p), p->outputPath))) {
     file_delete_sync(pack_write_path(p));
-    goto FileError;
+    log_e(
+        "Failed to create output file",
+        log_param("path", fmt_path(p->outputPath)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+    return false;
   }
 
   const TimeDuration duration = time_steady_duration(p->timeStart, time_steady_clock());
@@ -263,13 +387,6 @@ static bool pack_build(PackComp* p, AssetManagerComp* assetMan, const AssetImpor
       log_param("success", fmt_bool(success)),
       log_param("duration", fmt_duration(duration)));
   return success;
-
-FileError:
-  log_e(
-      "Failed to create output file",
-      log_param("path", fmt_path(p->outputPath)),
-      log_param("error", fmt_text(file_result_str(fileRes))));
-  return false;
 }
 
 ecs_system_define(PackUpdateSys) {
@@ -284,6 +401,11 @@ ecs_system_define(PackUpdateSys) {
 
   if (signal_is_received(Signal_Terminate) || signal_is_received(Signal_Interrupt)) {
     log_w("Packing interrupted", log_param("frames", fmt_int(pack->frameIdx)));
+    if (pack->packer) {
+      asset_packer_write_abort(pack->packer, pack->outFile);
+      pack_build_cleanup(pack);
+      file_delete_sync(pack_write_path(pack));
+    }
     pack->state = PackState_Interupted;
     return;
   }
@@ -303,8 +425,18 @@ ecs_system_define(PackUpdateSys) {
   case PackState_Waiting:
     ++pack->state;
     break;
-  case PackState_Build:
-    if (pack_build(pack, assetMan, importEnv)) {
+  case PackState_BuildBegin:
+    if (pack_build_begin(pack, assetMan, importEnv)) {
+      ++pack->state; // Entries are written by 'PackWriteSys' this frame.
+    } else {
+      pack->state = PackState_Failed;
+    }
+    break;
+  case PackState_BuildWrite:
+    ++pack->state; // 'PackWriteSys' has written the entries last frame.
+    break;
+  case PackState_BuildEnd:
+    if (pack_build_end(pack)) {
       pack->state = PackState_Finished;
     } else {
       pack->state = PackState_Failed;
@@ -317,16 +449,47 @@ ecs_system_define(PackUpdateSys) {
   }
 }
 
+/**
+ * Write the pack entries into their reserved region slots.
+ * Writing an entry involves opening the asset source (potentially decompressing it from the cache)
+ * and computing its checksum; fan this out over multiple tasks as its the bulk of the pack time.
+ */
+ecs_system_define(PackWriteSys) {
+  EcsView*     globalView = ecs_world_view_t(world, PackWriteView);
+  EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
+  if (UNLIKELY(!globalItr)) {
+    return; // Initialization failed; application will be terminated.
+  }
+  PackComp* pack = ecs_view_write_t(globalItr, PackComp);
+  if (pack->state != PackState_BuildWrite) {
+    return;
+  }
+  AssetManagerComp*         assetMan  = ecs_view_write_t(globalItr, AssetManagerComp);
+  const AssetImportEnvComp* importEnv = ecs_view_read_t(globalItr, AssetImportEnvComp);
+
+  const u32 entryCount = asset_packer_entry_count(pack->packer);
+  for (u32 i = parIndex; i < entryCount; i += parCount) {
+    if (UNLIKELY(!asset_packer_write_entry(pack->packer, assetMan, importEnv, i))) {
+      thread_atomic_store_i32(&pack->writeFailed, true);
+    }
+  }
+}
+
 ecs_module_init(pack_module) {
   ecs_register_comp(PackComp, .destructor = ecs_destruct_texture_comp);
 
   ecs_register_view(PackGlobalView);
+  ecs_register_view(PackWriteView);
   ecs_register_view(PackAssetView);
 
   ecs_register_system(PackUpdateSys, ecs_view_id(PackGlobalView), ecs_view_id(PackAssetView));
+
+  ecs_register_system(PackWriteSys, ecs_view_id(PackWriteView));
+  ecs_parallel(PackWriteSys, pack_num_write_tasks);
+  ecs_order(PackWriteSys, 1); // After 'PackUpdateSys' so writing starts in the begin frame.
 }
 
-static CliId g_optConfigPath, g_optAssetsPath, g_optOutputPath;
+static CliId g_optConfigPath, g_optAssetsPath, g_optOutputPath, g_optIncremental, g_optOrderPath;
 
 AppType app_ecs_configure(CliApp* app) {
   cli_app_register_desc(app, string_lit("Playground asset packer"));
@@ -342,6 +505,17 @@ AppType app_ecs_configure(CliApp* app) {
   g_optOutputPath = cli_register_flag(app, 'o', string_lit("output"), CliOptionFlags_Value);
   cli_register_desc(app, g_optOutputPath, string_lit("Output file path."));
 
+  g_optIncremental = cli_register_flag(app, 'i', string_lit("incremental"), CliOptionFlags_None);
+  cli_register_desc(
+      app, g_optIncremental, string_lit("Reuse unchanged entries from the previous output file."));
+
+  g_optOrderPath = cli_register_flag(app, '\0', string_lit("order"), CliOptionFlags_Value);
+  cli_register_desc(
+      app,
+      g_optOrderPath,
+      string_lit("Path to a load-order manifest (one asset-id per line) to optimize the layout."));
+  cli_register_validator(app, g_optOrderPath, cli_validate_file_regular);
+
   return AppType_Console;
 }
 
@@ -364,7 +538,8 @@ bool app_ecs_init(EcsWorld* world, const CliInvocation* invoc) {
     log_e("Invalid output path", log_param("path", fmt_path(outputPath)));
     return false;
   }
-  const String cfgPath = cli_read_string(invoc, g_optConfigPath, string_empty);
+  const String orderPath = cli_read_string(invoc, g_optOrderPath, string_empty);
+  const String cfgPath   = cli_read_string(invoc, g_optConfigPath, string_empty);
   PackConfig   cfg;
   if (!pack_config_load(cfgPath, &cfg)) {
     return false; // Invalid config.
@@ -374,10 +549,12 @@ bool app_ecs_init(EcsWorld* world, const CliInvocation* invoc) {
       world,
       ecs_world_global(world),
       PackComp,
-      .cfg        = cfg,
-      .outputPath = string_dup(g_allocHeap, path_build_scratch(outputPath)),
-      .assets     = dynarray_create_t(g_allocHeap, PackAsset, 512),
-      .timeStart  = time_steady_clock());
+      .cfg         = cfg,
+      .outputPath  = string_dup(g_allocHeap, path_build_scratch(outputPath)),
+      .orderPath   = string_maybe_dup(g_allocHeap, orderPath),
+      .assets      = dynarray_create_t(g_allocHeap, PackAsset, 512),
+      .timeStart   = time_steady_clock(),
+      .incremental = cli_parse_provided(invoc, g_optIncremental));
 
   const AssetManagerFlags assetFlags = AssetManagerFlags_PortableCache;
   AssetManagerComp*       assetMan   = asset_manager_create_fs(world, assetFlags, assetPath);
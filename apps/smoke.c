@@ -7,7 +7,9 @@
 #include "cli/validate.h"
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
+#include "core/dynarray.h"
 #include "core/dynstring.h"
 #include "core/file.h"
 #include "core/float.h"
@@ -16,12 +18,14 @@
 #include "core/math.h"
 #include "core/rng.h"
 #include "core/version.h"
+#include "ecs/runner.h"
 #include "ecs/utils.h"
 #include "ecs/view.h"
 #include "gap/error.h"
 #include "gap/input.h"
 #include "gap/register.h"
 #include "gap/window.h"
+#include "jobs/executor.h"
 #include "log/logger.h"
 #include "rend/error.h"
 #include "rend/register.h"
@@ -765,6 +769,10 @@ ecs_comp_define(DemoComp) {
   EcsEntityId uiCanvas;
   TimeSteady  lastTime;
 
+  TimeDuration benchDur; // Benchmark duration; 0 when not benchmarking.
+  TimeSteady   benchStart;
+  DynArray     benchFrameDurs; // TimeDuration[]
+
   SimState sim;
 
   f32 smokeMin, smokeMax;
@@ -786,27 +794,33 @@ static EcsEntityId demo_create_window(EcsWorld* world, const u16 width, const u1
   return gap_window_create(world, mode, flags, size, icon, titleScratch);
 }
 
-static DemoComp* demo_create(EcsWorld* world, const u16 winWidth, const u16 winHeight) {
+static DemoComp* demo_create(
+    EcsWorld*          world,
+    const u16          winWidth,
+    const u16          winHeight,
+    const u16          simWidth,
+    const u16          simHeight,
+    const TimeDuration benchDur) {
   const EcsEntityId global = ecs_world_global(world);
 
   DemoComp* demo = ecs_world_add_t(world, global, DemoComp);
 
-  demo->window   = demo_create_window(world, winWidth, winHeight);
-  demo->uiCanvas = ui_canvas_create(world, demo->window, UiCanvasCreateFlags_ToBack);
-  demo->overlay  = DemoOverlay_Default;
-  demo->smokeMin = 0.001f;
-  demo->smokeMax = 0.1f;
+  demo->window         = demo_create_window(world, winWidth, winHeight);
+  demo->uiCanvas       = ui_canvas_create(world, demo->window, UiCanvasCreateFlags_ToBack);
+  demo->overlay        = DemoOverlay_Default;
+  demo->smokeMin       = 0.001f;
+  demo->smokeMax       = 0.1f;
+  demo->benchDur       = benchDur;
+  demo->benchFrameDurs = dynarray_create_t(g_allocHeap, TimeDuration, 0);
 
   rend_settings_window_init(world, demo->window)->flags |= RendFlags_2D;
 
-  const u32 simWidth  = 40;
-  const u32 simHeight = 30;
-  demo->sim           = sim_state_create(simWidth, simHeight);
+  demo->sim = sim_state_create(simWidth, simHeight);
 
-  sim_emitter_add_default(&demo->sim, (SimCoord){37, 2});
+  sim_emitter_add_default(&demo->sim, (SimCoord){simWidth - 3, 2});
 
-  sim_solid_set(&demo->sim, (SimCoord){34, 4});
-  sim_solid_set(&demo->sim, (SimCoord){35, 5});
+  sim_solid_set(&demo->sim, (SimCoord){simWidth - 6, 4});
+  sim_solid_set(&demo->sim, (SimCoord){simWidth - 5, 5});
 
   return demo;
 }
@@ -814,6 +828,7 @@ static DemoComp* demo_create(EcsWorld* world, const u16 winWidth, const u16 winH
 static void demo_destroy(void* data) {
   DemoComp* comp = data;
   sim_state_destroy(&comp->sim);
+  dynarray_destroy(&comp->benchFrameDurs);
 }
 
 static f32 demo_time_to_seconds(const TimeDuration dur) {
@@ -821,6 +836,55 @@ static f32 demo_time_to_seconds(const TimeDuration dur) {
   return (f32)((f64)dur * g_toSecMul);
 }
 
+static TimeDuration demo_bench_percentile(const DynArray* sortedDurs, const f32 frac) {
+  const usize idx = (usize)math_round_nearest_f32(frac * (f32)(sortedDurs->size - 1));
+  return *dynarray_at_t(sortedDurs, idx, TimeDuration);
+}
+
+static void demo_bench_report(DemoComp* demo) {
+  if (!demo->benchFrameDurs.size) {
+    return;
+  }
+  dynarray_sort(&demo->benchFrameDurs, compare_i64);
+
+  TimeDuration sum = 0;
+  dynarray_for_t(&demo->benchFrameDurs, TimeDuration, itr) { sum += *itr; }
+
+  const usize        frames = demo->benchFrameDurs.size;
+  const TimeDuration avg    = sum / (TimeDuration)frames;
+  const TimeDuration p50    = demo_bench_percentile(&demo->benchFrameDurs, 0.50f);
+  const TimeDuration p95    = demo_bench_percentile(&demo->benchFrameDurs, 0.95f);
+  const TimeDuration max    = *dynarray_at_t(&demo->benchFrameDurs, frames - 1, TimeDuration);
+
+  const EcsRunnerStats ecsStats = ecs_runner_stats_query(g_ecsRunningRunner);
+
+  log_i(
+      "Benchmark finished",
+      log_param("frames", fmt_int(frames)),
+      log_param("frame-avg", fmt_duration(avg)),
+      log_param("frame-p50", fmt_duration(p50)),
+      log_param("frame-p95", fmt_duration(p95)),
+      log_param("frame-max", fmt_duration(max)));
+
+  // Emit a single-line json report to std-out for automated tracking.
+  DynString str = dynstring_create(g_allocScratch, 512);
+  dynstring_append_char(&str, '{');
+  fmt_write(&str, "\"simWidth\":{},", fmt_int(demo->sim.width));
+  fmt_write(&str, "\"simHeight\":{},", fmt_int(demo->sim.height));
+  fmt_write(&str, "\"frames\":{},", fmt_int(frames));
+  fmt_write(&str, "\"frameAvgNs\":{},", fmt_int(avg));
+  fmt_write(&str, "\"frameP50Ns\":{},", fmt_int(p50));
+  fmt_write(&str, "\"frameP95Ns\":{},", fmt_int(p95));
+  fmt_write(&str, "\"frameMaxNs\":{},", fmt_int(max));
+  fmt_write(&str, "\"jobWorkers\":{},", fmt_int(g_jobsWorkerCount));
+  fmt_write(&str, "\"ecsFlushAvgNs\":{},", fmt_int(ecsStats.flushDurAvg));
+  fmt_write(&str, "\"ecsPlanEstSpanNs\":{}", fmt_int(ecsStats.planEstSpan));
+  dynstring_append_char(&str, '}');
+  dynstring_append_char(&str, '\n');
+  file_write_sync(g_fileStdOut, dynstring_view(&str));
+  dynstring_destroy(&str);
+}
+
 static f32 demo_cell_size(UiCanvasComp* c, const SimState* s) {
   const f32 border = 10;
   const f32 xSize  = (ui_canvas_resolution(c).width - border * 2) / (f32)s->width;
@@ -1513,6 +1577,17 @@ ecs_system_define(DemoUpdateSys) {
   if (winItr) {
     GapWindowComp* winComp  = ecs_view_write_t(winItr, GapWindowComp);
     UiCanvasComp*  uiCanvas = null;
+    if (demo->benchDur) {
+      if (!demo->benchStart) {
+        demo->benchStart = timeNew;
+      } else {
+        *dynarray_push_t(&demo->benchFrameDurs, TimeDuration) = timeDelta;
+      }
+      if (time_steady_duration(demo->benchStart, timeNew) >= demo->benchDur) {
+        demo_bench_report(demo);
+        gap_window_close(winComp);
+      }
+    }
     if (ecs_view_maybe_jump(canvasItr, demo->uiCanvas)) {
       uiCanvas = ecs_view_write_t(canvasItr, UiCanvasComp);
       ui_canvas_reset(uiCanvas);
@@ -1587,7 +1662,7 @@ ecs_module_init(demo_module) {
       DemoUpdateSys, ecs_view_id(UpdateView), ecs_view_id(WindowView), ecs_view_id(UiCanvasView));
 }
 
-static CliId g_optAssets, g_optWidth, g_optHeight;
+static CliId g_optAssets, g_optWidth, g_optHeight, g_optSimWidth, g_optSimHeight, g_optBench;
 
 AppType app_ecs_configure(CliApp* app) {
   cli_app_register_desc(app, string_lit("Smoke Demo"));
@@ -1604,6 +1679,18 @@ AppType app_ecs_configure(CliApp* app) {
   cli_register_desc(app, g_optHeight, string_lit("Window height in pixels."));
   cli_register_validator(app, g_optHeight, cli_validate_u16);
 
+  g_optSimWidth = cli_register_flag(app, '\0', string_lit("sim-width"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optSimWidth, string_lit("Simulation grid width in cells."));
+  cli_register_validator(app, g_optSimWidth, cli_validate_u16);
+
+  g_optSimHeight = cli_register_flag(app, '\0', string_lit("sim-height"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optSimHeight, string_lit("Simulation grid height in cells."));
+  cli_register_validator(app, g_optSimHeight, cli_validate_u16);
+
+  g_optBench = cli_register_flag(app, '\0', string_lit("bench"), CliOptionFlags_Value);
+  cli_register_desc(app, g_optBench, string_lit("Benchmark duration in seconds (0 = disabled)."));
+  cli_register_validator(app, g_optBench, cli_validate_u16);
+
   return AppType_Gui;
 }
 
@@ -1667,8 +1754,12 @@ bool app_ecs_init(EcsWorld* world, const CliInvocation* invoc) {
 
   const u16 windowWidth  = (u16)cli_read_u64(invoc, g_optWidth, 1600);
   const u16 windowHeight = (u16)cli_read_u64(invoc, g_optHeight, 1200);
+  const u16 simWidth     = math_max((u16)cli_read_u64(invoc, g_optSimWidth, 40), 8);
+  const u16 simHeight    = math_max((u16)cli_read_u64(invoc, g_optSimHeight, 30), 8);
+
+  const TimeDuration benchDur = time_seconds(cli_read_u64(invoc, g_optBench, 0));
 
-  demo_create(world, windowWidth, windowHeight);
+  demo_create(world, windowWidth, windowHeight, simWidth, simHeight, benchDur);
 
   return true; // Initialization succeeded.
 }
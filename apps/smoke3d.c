@@ -7,7 +7,10 @@
 #include "cli/validate.h"
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/dynstring.h"
 #include "core/file.h"
 #include "core/float.h"
 #include "core/format.h"
@@ -30,6 +33,7 @@
 #include "rend/object.h"
 #include "rend/register.h"
 #include "rend/settings.h"
+#include "rend/stats.h"
 #include "rend/tag.h"
 #include "ui/canvas.h"
 #include "ui/layout.h"
@@ -873,6 +877,16 @@ ecs_comp_define(DemoComp) {
   EcsEntityId rendObj;
   TimeSteady  lastTime;
 
+  u32      benchFrames; // Total frames to benchmark; 0 when not benchmarking.
+  u32      benchFrameIdx;
+  DynArray benchFrameDurs; // TimeDuration[] cpu frame durations.
+  DynArray benchGpuDurs;   // TimeDuration[] gpu execution durations.
+  u64      benchDraws, benchInstances;
+
+  u32          benchPassCount;
+  String       benchPassNames[rend_stats_max_passes]; // Persistently allocated by rend.
+  TimeDuration benchPassDurs[rend_stats_max_passes];
+
   SimState sim;
 
   bool hideMenu;
@@ -902,17 +916,25 @@ demo_create_rend_obj(EcsWorld* world, AssetManagerComp* assets, const EcsEntityI
   return entity;
 }
 
-static DemoComp*
-demo_create(EcsWorld* world, AssetManagerComp* assets, const u16 winWidth, const u16 winHeight) {
+static DemoComp* demo_create(
+    EcsWorld*         world,
+    AssetManagerComp* assets,
+    const u16         winWidth,
+    const u16         winHeight,
+    const u32         benchFrames) {
   const EcsEntityId global = ecs_world_global(world);
 
   DemoComp* demo = ecs_world_add_t(world, global, DemoComp);
 
-  demo->window   = demo_create_window(world, winWidth, winHeight);
-  demo->uiCanvas = ui_canvas_create(world, demo->window, UiCanvasCreateFlags_ToBack);
-  demo->rendObj  = demo_create_rend_obj(world, assets, demo->window);
-  demo->smokeMin = 0.001f;
-  demo->smokeMax = 0.1f;
+  demo->window         = demo_create_window(world, winWidth, winHeight);
+  demo->uiCanvas       = ui_canvas_create(world, demo->window, UiCanvasCreateFlags_ToBack);
+  demo->rendObj        = demo_create_rend_obj(world, assets, demo->window);
+  demo->smokeMin       = 0.001f;
+  demo->smokeMax       = 0.1f;
+  demo->benchFrames    = benchFrames;
+  demo->benchFrameDurs = dynarray_create_t(g_allocHeap, TimeDuration, 0);
+  demo->benchGpuDurs   = dynarray_create_t(g_allocHeap, TimeDuration, 0);
+  demo->hideMenu       = benchFrames != 0; // No interactive menu during a benchmark.
 
   ecs_world_add_t(
       world,
@@ -942,6 +964,8 @@ demo_create(EcsWorld* world, AssetManagerComp* assets, const u16 winWidth, const
 static void demo_destroy(void* data) {
   DemoComp* comp = data;
   sim_state_destroy(&comp->sim);
+  dynarray_destroy(&comp->benchFrameDurs);
+  dynarray_destroy(&comp->benchGpuDurs);
 }
 
 static f32 demo_time_to_seconds(const TimeDuration dur) {
@@ -949,6 +973,102 @@ static f32 demo_time_to_seconds(const TimeDuration dur) {
   return (f32)((f64)dur * g_toSecMul);
 }
 
+// Fixed benchmark timestep; makes the simulation (and thus the rendered workload) deterministic.
+#define demo_bench_timestep (time_second / 60)
+
+static TimeDuration demo_bench_percentile(const DynArray* sortedDurs, const f32 frac) {
+  const usize idx = (usize)math_round_nearest_f32(frac * (f32)(sortedDurs->size - 1));
+  return *dynarray_at_t(sortedDurs, idx, TimeDuration);
+}
+
+/**
+ * Scripted camera path for the benchmark: orbit around the simulation volume at a fixed rate.
+ * Only a function of the frame index so replays are comparable across runs.
+ */
+static void demo_bench_camera(RendCameraComp* cam, const SimState* s, const u32 frameIdx) {
+  const f32       secs   = (f32)frameIdx * demo_time_to_seconds(demo_bench_timestep);
+  const f32       angle  = secs * 0.25f;
+  const f32       radius = (f32)math_max(s->width, s->depth) * 1.5f;
+  const GeoVector center =
+      geo_vector((f32)s->width * 0.5f, (f32)s->height * 0.5f, (f32)s->depth * 0.5f);
+  const GeoVector offset = geo_vector(
+      math_cos_f32(angle) * radius, (f32)s->height * 0.75f, math_sin_f32(angle) * radius);
+
+  cam->position = geo_vector_add(center, offset);
+  cam->rotation = geo_quat_look(geo_vector_norm(geo_vector_mul(offset, -1.0f)), geo_up);
+}
+
+static void demo_bench_capture(DemoComp* demo, const RendStatsComp* rendStats) {
+  *dynarray_push_t(&demo->benchGpuDurs, TimeDuration) = rendStats->gpuExecDur;
+  demo->benchPassCount = math_max(demo->benchPassCount, rendStats->passCount);
+  for (u32 i = 0; i != rendStats->passCount; ++i) {
+    demo->benchDraws += rendStats->passes[i].draws;
+    demo->benchInstances += rendStats->passes[i].instances;
+    demo->benchPassNames[i] = rendStats->passes[i].name;
+    demo->benchPassDurs[i] += rendStats->passes[i].gpuExecDur;
+  }
+}
+
+static void demo_bench_report(DemoComp* demo) {
+  if (!demo->benchFrameDurs.size) {
+    return;
+  }
+  dynarray_sort(&demo->benchFrameDurs, compare_i64);
+  dynarray_sort(&demo->benchGpuDurs, compare_i64);
+
+  TimeDuration sum = 0;
+  dynarray_for_t(&demo->benchFrameDurs, TimeDuration, itr) { sum += *itr; }
+
+  const usize        frames = demo->benchFrameDurs.size;
+  const TimeDuration avg    = sum / (TimeDuration)frames;
+  const TimeDuration p50    = demo_bench_percentile(&demo->benchFrameDurs, 0.50f);
+  const TimeDuration p95    = demo_bench_percentile(&demo->benchFrameDurs, 0.95f);
+  const TimeDuration max    = *dynarray_at_t(&demo->benchFrameDurs, frames - 1, TimeDuration);
+
+  const usize        gpuFrames = demo->benchGpuDurs.size;
+  const TimeDuration gpuP50 = gpuFrames ? demo_bench_percentile(&demo->benchGpuDurs, 0.50f) : 0;
+  const TimeDuration gpuP95 = gpuFrames ? demo_bench_percentile(&demo->benchGpuDurs, 0.95f) : 0;
+
+  log_i(
+      "Benchmark finished",
+      log_param("frames", fmt_int(frames)),
+      log_param("frame-avg", fmt_duration(avg)),
+      log_param("frame-p50", fmt_duration(p50)),
+      log_param("frame-p95", fmt_duration(p95)),
+      log_param("gpu-exec-p50", fmt_duration(gpuP50)),
+      log_param("gpu-exec-p95", fmt_duration(gpuP95)));
+
+  // Emit a single-line json report to std-out for automated tracking.
+  DynString str = dynstring_create(g_allocScratch, usize_kibibyte);
+  dynstring_append_char(&str, '{');
+  fmt_write(&str, "\"frames\":{},", fmt_int(frames));
+  fmt_write(&str, "\"frameAvgNs\":{},", fmt_int(avg));
+  fmt_write(&str, "\"frameP50Ns\":{},", fmt_int(p50));
+  fmt_write(&str, "\"frameP95Ns\":{},", fmt_int(p95));
+  fmt_write(&str, "\"frameMaxNs\":{},", fmt_int(max));
+  fmt_write(&str, "\"gpuExecP50Ns\":{},", fmt_int(gpuP50));
+  fmt_write(&str, "\"gpuExecP95Ns\":{},", fmt_int(gpuP95));
+  if (gpuFrames) {
+    fmt_write(&str, "\"drawsPerFrame\":{},", fmt_int(demo->benchDraws / gpuFrames));
+    fmt_write(&str, "\"instancesPerFrame\":{},", fmt_int(demo->benchInstances / gpuFrames));
+  }
+  dynstring_append(&str, string_lit("\"passes\":["));
+  for (u32 i = 0; i != demo->benchPassCount; ++i) {
+    if (i) {
+      dynstring_append_char(&str, ',');
+    }
+    dynstring_append_char(&str, '{');
+    fmt_write(&str, "\"name\":\"{}\",", fmt_text(demo->benchPassNames[i]));
+    fmt_write(&str, "\"gpuAvgNs\":{}", fmt_int(demo->benchPassDurs[i] / (i64)gpuFrames));
+    dynstring_append_char(&str, '}');
+  }
+  dynstring_append_char(&str, ']');
+  dynstring_append_char(&str, '}');
+  dynstring_append_char(&str, '\n');
+  file_write_sync(g_fileStdOut, dynstring_view(&str));
+  dynstring_destroy(&str);
+}
+
 static void demo_particle_draw(RendObjectComp* obj, const GeoVector p, const GeoColor c) {
   typedef struct {
     ALIGNAS(16)
@@ -1172,6 +1292,7 @@ ecs_view_define(UpdateView) { ecs_access_write(DemoComp); }
 ecs_view_define(WindowView) {
   ecs_access_write(GapWindowComp);
   ecs_access_write(RendCameraComp);
+  ecs_access_maybe_read(RendStatsComp); // Only present when benchmarking (and after a few frames).
 }
 
 ecs_view_define(UiCanvasView) {
@@ -1198,6 +1319,7 @@ ecs_system_define(DemoUpdateSys) {
   (void)sim_speed;
   (void)sim_angle;
 
+  const bool       bench     = demo->benchFrames != 0;
   const TimeSteady timeNew   = time_steady_clock();
   TimeDuration     timeDelta = 0;
   if (demo->lastTime) {
@@ -1205,7 +1327,9 @@ ecs_system_define(DemoUpdateSys) {
     timeDelta = math_min(timeDelta, time_second); // Avoid huge delta's when process was paused.
   }
   demo->lastTime = timeNew;
-  const f32 dt   = demo_time_to_seconds(timeDelta);
+
+  // Benchmarks advance the simulation at a fixed timestep to make replays deterministic.
+  const f32 dt = demo_time_to_seconds(bench ? demo_bench_timestep : timeDelta);
 
   sim_update(&demo->sim, dt);
 
@@ -1230,7 +1354,22 @@ ecs_system_define(DemoUpdateSys) {
       uiCanvas = ecs_view_write_t(canvasItr, UiCanvasComp);
       ui_canvas_reset(uiCanvas);
     }
-    demo_camera_update(winComp, uiCanvas, camComp, dt);
+    if (bench) {
+      demo_bench_camera(camComp, &demo->sim, demo->benchFrameIdx);
+      if (demo->benchFrameIdx) { // Skip the first frame; no valid frame duration yet.
+        *dynarray_push_t(&demo->benchFrameDurs, TimeDuration) = timeDelta;
+        const RendStatsComp* rendStats = ecs_view_read_t(winItr, RendStatsComp);
+        if (rendStats) {
+          demo_bench_capture(demo, rendStats);
+        }
+      }
+      if (++demo->benchFrameIdx > demo->benchFrames) {
+        demo_bench_report(demo);
+        gap_window_close(winComp);
+      }
+    } else {
+      demo_camera_update(winComp, uiCanvas, camComp, dt);
+    }
     if (gap_window_key_down(winComp, GapKey_Alt) && gap_window_key_pressed(winComp, GapKey_F4)) {
       gap_window_close(winComp);
     }
@@ -1281,7 +1420,7 @@ ecs_module_init(demo_module) {
       ecs_view_id(RendObjView));
 }
 
-static CliId g_optAssets, g_optWidth, g_optHeight;
+static CliId g_optAssets, g_optWidth, g_optHeight, g_optBench;
 
 AppType app_ecs_configure(CliApp* app) {
   cli_app_register_desc(app, string_lit("3D Smoke Demo"));
@@ -1298,6 +1437,11 @@ AppType app_ecs_configure(CliApp* app) {
   cli_register_desc(app, g_optHeight, string_lit("Window height in pixels."));
   cli_register_validator(app, g_optHeight, cli_validate_u16);
 
+  g_optBench = cli_register_flag(app, '\0', string_lit("bench"), CliOptionFlags_Value);
+  cli_register_desc(
+      app, g_optBench, string_lit("Replay the scripted benchmark for the given frame count."));
+  cli_register_validator(app, g_optBench, cli_validate_u64);
+
   return AppType_Gui;
 }
 
@@ -1312,12 +1456,13 @@ static void game_crash_handler(const String message, void* ctx) {
 }
 
 void app_ecs_register(EcsDef* def, const CliInvocation* invoc) {
-  (void)invoc;
   diag_crash_handler(game_crash_handler, null); // Register a crash handler.
 
+  const bool bench = cli_read_u64(invoc, g_optBench, 0) != 0;
+
   asset_register(def, &(AssetRegisterContext){.devSupport = false});
   gap_register(def);
-  rend_register(def, &(RendRegisterContext){.enableStats = false});
+  rend_register(def, &(RendRegisterContext){.enableStats = bench});
   ui_register(def);
   ecs_register_module(def, demo_module);
 }
@@ -1361,8 +1506,9 @@ bool app_ecs_init(EcsWorld* world, const CliInvocation* invoc) {
 
   const u16 windowWidth  = (u16)cli_read_u64(invoc, g_optWidth, 1600);
   const u16 windowHeight = (u16)cli_read_u64(invoc, g_optHeight, 1200);
+  const u32 benchFrames  = (u32)cli_read_u64(invoc, g_optBench, 0);
 
-  demo_create(world, assets, windowWidth, windowHeight);
+  demo_create(world, assets, windowWidth, windowHeight, benchFrames);
 
   return true; // Initialization succeeded.
 }
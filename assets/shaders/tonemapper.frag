@@ -5,7 +5,7 @@ struct TonemapperData {
   f32 exposure;
   u32 mode;
   f32 grayscaleFrac;
-  f32 unused;
+  f32 sharpen;
 };
 
 const u32 c_modeLinear        = 0;
@@ -67,8 +67,31 @@ f32v3 tonemap_aces_approx(const f32v3 hdr) {
   return clamp((hdr * (a * hdr + b)) / (hdr * (c * hdr + d) + e), 0.0, 1.0);
 }
 
+/**
+ * Sharpen the given center sample using an unsharp-mask over the 4 direct neighbors.
+ * The result is clamped to the local neighborhood to avoid ringing; used to recover detail when
+ * rendering below the output resolution.
+ */
+f32v3 sharpen(const f32v3 center) {
+  const f32v2 texelSize = 1.0 / f32v2(textureSize(u_texHdr, 0));
+  const f32v3 n         = texture(u_texHdr, in_texcoord + f32v2(0, -texelSize.y)).rgb;
+  const f32v3 s         = texture(u_texHdr, in_texcoord + f32v2(0, texelSize.y)).rgb;
+  const f32v3 w         = texture(u_texHdr, in_texcoord + f32v2(-texelSize.x, 0)).rgb;
+  const f32v3 e         = texture(u_texHdr, in_texcoord + f32v2(texelSize.x, 0)).rgb;
+
+  const f32v3 blurred   = (n + s + w + e) * 0.25;
+  const f32v3 sharpened = center + (center - blurred) * u_draw.sharpen;
+
+  const f32v3 neighborMin = min(center, min(min(n, s), min(w, e)));
+  const f32v3 neighborMax = max(center, max(max(n, s), max(w, e)));
+  return clamp(sharpened, neighborMin, neighborMax);
+}
+
 void main() {
-  const f32v3 colorHdrInput  = texture(u_texHdr, in_texcoord).rgb;
+  f32v3 colorHdrInput = texture(u_texHdr, in_texcoord).rgb;
+  if (u_draw.sharpen > 0.0) {
+    colorHdrInput = sharpen(colorHdrInput);
+  }
   const f32v3 colorHdr = colorHdrInput * u_draw.exposure;
 
   f32v3 colorSdr;
@@ -4,10 +4,14 @@
 #include "cli/parse.h"
 #include "cli/read.h"
 #include "core/alloc.h"
+#include "core/dynstring.h"
 #include "core/file.h"
+#include "core/format.h"
+#include "core/init.h"
 #include "core/path.h"
 #include "core/signal.h"
 #include "core/thread.h"
+#include "core/time.h"
 #include "core/version.h"
 #include "ecs/runner.h"
 #include "ecs/world.h"
@@ -15,6 +19,7 @@
 #include "log/logger.h"
 #include "log/sink_json.h"
 #include "log/sink_pretty.h"
+#include "trace/dump.h"
 #include "trace/init.h"
 #include "trace/sink_store.h"
 #include "trace/sink_superluminal.h"
@@ -22,7 +27,7 @@
 
 static CliId              g_optJobWorkers;
 static CliId              g_optNoEcsReplan;
-MAYBE_UNUSED static CliId g_optTraceNoStore, g_optTraceSl;
+MAYBE_UNUSED static CliId g_optTraceNoStore, g_optTraceSl, g_optTraceRing;
 
 AppType app_cli_configure(CliApp* app) {
   const AppType appType = app_ecs_configure(app);
@@ -39,11 +44,46 @@ AppType app_cli_configure(CliApp* app) {
 
   g_optTraceSl = cli_register_flag(app, '\0', string_lit("trace-sl"), 0);
   cli_register_desc(app, g_optTraceSl, string_lit("Enable the SuperLuminal trace sink."));
+
+  g_optTraceRing = cli_register_flag(app, '\0', string_lit("trace-ring"), 0);
+  cli_register_desc(
+      app, g_optTraceRing, string_lit("Continuously flush trace dumps to a ring of files."));
 #endif
 
   return appType;
 }
 
+/**
+ * Report the recorded startup phases. Phases are replayed into the tracer as custom events as most
+ * of them ran before the trace sinks were ready.
+ */
+static void app_startup_phases_report(void) {
+  const CoreInitPhase* phases = core_init_phase_data();
+  const u32            count  = core_init_phase_count();
+
+  TimeDuration totalDur = 0;
+  DynString    str      = dynstring_create_over(mem_stack(512));
+  for (u32 i = 0; i != count; ++i) {
+    if (i) {
+      dynstring_append(&str, string_lit(", "));
+    }
+    fmt_write(&str, "{}: {}", fmt_text(phases[i].name), fmt_duration(phases[i].duration));
+    totalDur += phases[i].duration;
+  }
+  log_i(
+      "Startup phases",
+      log_param("total-dur", fmt_duration(totalDur)),
+      log_param("breakdown", fmt_text(dynstring_view(&str))));
+
+#ifdef VOLO_TRACE
+  for (u32 i = 0; i != count; ++i) {
+    trace_event_custom_begin(g_tracer, string_lit("startup"), phases[i].name, TraceColor_Default);
+    trace_event_custom_end(
+        g_tracer, string_lit("startup"), phases[i].timeBegin, phases[i].duration);
+  }
+#endif
+}
+
 i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
   trace_init();
 
@@ -68,6 +108,16 @@ i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
   if (cli_parse_provided(invoc, g_optTraceSl)) {
     trace_add_sink(g_tracer, trace_sink_superluminal(g_allocHeap));
   }
+  TraceDumpRing* traceRing = null;
+  if (cli_parse_provided(invoc, g_optTraceRing) && trace_sink_store_find(g_tracer)) {
+    const String ringPathPrefix = path_build_scratch(
+        path_parent(g_pathExecutable),
+        string_lit("logs"),
+        fmt_write_scratch("{}-ring", fmt_text(path_stem(g_pathExecutable))));
+    file_create_dir_sync(path_parent(ringPathPrefix));
+    traceRing = trace_dump_ring_create(
+        g_allocHeap, ringPathPrefix, 4 /* fileCount */, time_seconds(10) /* interval */);
+  }
 #endif
 
   const JobsConfig jobsConfig = {
@@ -83,17 +133,31 @@ i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
     runnerFlags &= ~EcsRunnerFlags_Replan;
   }
 
+  core_init_phase_begin(string_lit("ecs-register"));
   EcsDef* def = def = ecs_def_create(g_allocHeap);
   app_ecs_register(def, invoc);
 
   EcsWorld*  world  = ecs_world_create(g_allocHeap, def);
   EcsRunner* runner = ecs_runner_create(g_allocHeap, world, runnerFlags);
-  if (!app_ecs_init(world, invoc)) {
+  core_init_phase_end();
+
+  core_init_phase_begin(string_lit("ecs-init"));
+  const bool initSuccess = app_ecs_init(world, invoc);
+  core_init_phase_end();
+  app_startup_phases_report();
+  if (!initSuccess) {
     goto Shutdown;
   }
 
   ecs_world_flush(world); // Flush any entity / component additions made during the init.
 
+  /**
+   * Frame loop.
+   * NOTE: Render submission is not pipelined against the next frame's simulation: both run in the
+   * same job graph and already overlap where their views do not conflict, and the main thread
+   * helps execute the graph while waiting. True multi-frame pipelining would require the renderer
+   * to read from a world snapshot (see 'ecs_world_snapshot_take()') instead of from live views.
+   */
   u64 frameIdx = 0;
   do {
     trace_begin_msg("app_frame", TraceColor_Blue, "frame-{}", fmt_int(frameIdx));
@@ -101,12 +165,26 @@ i32 app_cli_run(MAYBE_UNUSED const CliApp* app, const CliInvocation* invoc) {
     app_ecs_set_frame(world, frameIdx);
     ecs_run_sync(runner);
 
+    alloc_reset(g_allocFrame); // Free this frame's transient allocations in one go.
+
     trace_end();
 
+#ifdef VOLO_TRACE
+    if (traceRing) {
+      trace_dump_ring_update(traceRing, trace_sink_store_find(g_tracer));
+    }
+#endif
+
     ++frameIdx;
   } while ((status = app_ecs_status(world)) == AppEcsStatus_Running);
 
 Shutdown:
+#ifdef VOLO_TRACE
+  if (traceRing) {
+    trace_dump_ring_flush(traceRing, trace_sink_store_find(g_tracer)); // Capture the final state.
+    trace_dump_ring_destroy(traceRing);
+  }
+#endif
   ecs_runner_destroy(runner);
   ecs_world_destroy(world);
   ecs_def_destroy(def);
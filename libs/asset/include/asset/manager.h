@@ -16,6 +16,15 @@ typedef enum {
   AssetManagerFlags_PortableCache = 1 << 3, // Supports a cache from a different asset directory.
 } AssetManagerFlags;
 
+typedef enum {
+  AssetMemCategory_Texture,
+  AssetMemCategory_Mesh,
+  AssetMemCategory_Sound,
+  AssetMemCategory_Other,
+
+  AssetMemCategory_Count,
+} AssetMemCategory;
+
 /**
  * The AssetManager is responsible for loading and unloaded assets.
  */
@@ -137,11 +146,20 @@ u32 asset_query(
  */
 void asset_loading_budget_set(AssetManagerComp*, TimeDuration loadingTimeBudget);
 
+/**
+ * Set a memory budget (in bytes) for assets of the given category (0 means infinite).
+ * While a category is over budget, unreferenced assets in it are unloaded in least-recently-used
+ * order; referenced assets are never unloaded and can thus still exceed the budget.
+ */
+void asset_memory_budget_set(AssetManagerComp*, AssetMemCategory, usize maxBytes);
+
 /**
  * Debug apis.
  */
 u32  asset_ref_count(const AssetComp*);
 u32  asset_load_count(const AssetComp*);
+u32  asset_load_order(const AssetComp*); // First-load sequence number; sentinel_u32 if not loaded.
+u32  asset_load_size(const AssetComp*);
 bool asset_is_loading(const AssetComp*);
 bool asset_is_cached(const AssetComp*);
 u32  asset_ticks_until_unload(const AssetComp*);
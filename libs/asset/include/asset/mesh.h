@@ -5,6 +5,7 @@
 #include "geo/box.h"
 
 #define asset_mesh_vertices_max u16_max
+#define asset_mesh_lods_max 4
 #define asset_mesh_joints_max 75
 #define asset_mesh_anims_max 32
 
@@ -14,7 +15,10 @@ typedef u16 AssetMeshIndex;
 typedef u32 AssetMeshDataPtr;
 
 /**
- * Packed vertex.
+ * Packed (quantized) vertex, 32 bytes.
+ * Position, normal, tangent and texcoord are quantized to 16 bit floats at import time and the
+ * skinning is packed as four u16 joint-index (low 8 bits) / joint-weight (high 8 bits) pairs,
+ * halving the vertex fetch bandwidth compared to a full precision vertex.
  * Compatible with the structure defined in 'vertex.glsl' using the std140 glsl layout.
  */
 typedef struct {
@@ -28,11 +32,20 @@ typedef struct {
 ASSERT(sizeof(AssetMeshVertexPacked) == 32, "Unexpected vertex size");
 ASSERT(alignof(AssetMeshVertexPacked) == 16, "Unexpected vertex alignment");
 
+/**
+ * Simplified level-of-detail; an alternative (coarser) index range over the same vertices.
+ */
+typedef struct {
+  u32 indexOffset, indexCount;
+} AssetMeshLod;
+
 ecs_comp_extern_public(AssetMeshComp) {
-  u32     vertexCount, indexCount;
-  DataMem vertexData; // AssetMeshVertexPacked[]
-  DataMem indexData;  // AssetMeshIndex[]
-  GeoBox  bounds;
+  u32          vertexCount, indexCount; // NOTE: indexCount covers the full-detail level only.
+  u32          lodCount;                // Amount of simplified levels, finest first.
+  AssetMeshLod lods[asset_mesh_lods_max];
+  DataMem      vertexData; // AssetMeshVertexPacked[]
+  DataMem      indexData;  // AssetMeshIndex[], full-detail indices followed by the lod levels.
+  GeoBox       bounds;
 };
 
 typedef enum {
@@ -65,6 +78,12 @@ typedef struct {
   f32                  mask[asset_mesh_joints_max];
 } AssetMeshAnim;
 
+/**
+ * Skeleton and animation data for a skinned mesh.
+ * NOTE: Skinning itself runs on the gpu: the packed vertices carry joint indices / weights and the
+ * skinned vertex shaders apply per-instance joint-delta matrices (see 'standard_skin_mat' in the
+ * 'standard.glsl' shader include); only animation sampling happens on the cpu.
+ */
 ecs_comp_extern_public(AssetMeshSkeletonComp) {
   HeapArray_t(AssetMeshAnim) anims;
   AssetMeshDataPtr bindMatInv;      // GeoMatrix[jointCount]. From world to bind space.
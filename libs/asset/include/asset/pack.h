@@ -6,7 +6,10 @@ typedef struct sAssetPacker AssetPacker;
 typedef struct {
   u64 size, padding;
   u64 headerSize;
+  u64 dedupSize; // Bytes saved by deduplicating entries with identical content.
   u32 entries;
+  u32 entriesReused;  // Entries copied from the baseline pack file.
+  u32 entriesDeduped; // Entries sharing identical content with another entry (stored once).
   u32 regions;
   u32 blocks;
 } AssetPackerStats;
@@ -16,9 +19,46 @@ void         asset_packer_destroy(AssetPacker*);
 
 bool asset_packer_push(AssetPacker*, AssetManagerComp*, const AssetImportEnvComp*, String assetId);
 
-bool asset_packer_write(
-    AssetPacker*,
-    AssetManagerComp*,
-    const AssetImportEnvComp*,
-    File*             outFile,
-    AssetPackerStats* outStats);
+/**
+ * Assign a layout order to a previously pushed entry; entries with an order are laid out at the
+ * start of the file in ascending order (before the unordered entries). Matching the layout to the
+ * runtime access order (see 'asset_load_order') makes startup and level loads sequential reads.
+ * Returns false when no entry with the given asset-id has been pushed.
+ * Pre-condition: asset_packer_write_begin() has not been called.
+ */
+bool asset_packer_order(AssetPacker*, String assetId, u32 order);
+
+/**
+ * Use an existing pack file as a baseline for an incremental build: entries whose source content
+ * is unchanged (matching persisted source checksum) are copied from the baseline instead of being
+ * re-read from the asset sources.
+ * NOTE: The baseline file has to stay open until the packer is destroyed.
+ */
+bool asset_packer_baseline(AssetPacker*, File* baselineFile);
+
+/**
+ * Begin writing the pack file: lays out all pushed entries and reserves (and maps) the file
+ * regions up front. After a successful begin the individual entries can be written.
+ */
+bool asset_packer_write_begin(AssetPacker*, File* outFile);
+
+u32 asset_packer_entry_count(const AssetPacker*);
+
+/**
+ * Write the entry at the given index into its reserved region slot.
+ * NOTE: Thread-safe; different entries can be written in parallel.
+ * Pre-condition: asset_packer_write_begin() succeeded.
+ */
+bool asset_packer_write_entry(AssetPacker*, AssetManagerComp*, const AssetImportEnvComp*, u32 index);
+
+/**
+ * Finish writing the pack file: computes the region checksums, unmaps the regions and writes the
+ * header.
+ * Pre-condition: All entries have been written.
+ */
+bool asset_packer_write_end(AssetPacker*, File* outFile, AssetPackerStats* outStats);
+
+/**
+ * Abort writing the pack file: unmaps the regions without writing the header.
+ */
+void asset_packer_write_abort(AssetPacker*, File* outFile);
@@ -10,3 +10,21 @@ ecs_comp_extern_public(AssetSoundComp) {
 };
 
 extern DataMeta g_assetSoundMeta;
+
+/**
+ * Streamed sound; instead of being decoded up-front the frames are decoded on demand, meaning only
+ * a small window of the sound needs to be resident at any time.
+ * NOTE: The asset source stays open for the lifetime of the component.
+ */
+ecs_comp_extern(AssetSoundStreamComp);
+
+u8  asset_sound_stream_channels(const AssetSoundStreamComp*);
+u32 asset_sound_stream_frame_count(const AssetSoundStreamComp*);
+u32 asset_sound_stream_frame_rate(const AssetSoundStreamComp*);
+
+/**
+ * Decode frames into the output buffer as interleaved (LRLRLR) channel samples.
+ * NOTE: Thread-safe; the same stream can be read in parallel.
+ * Pre-condition: frame + frameCount <= asset_sound_stream_frame_count().
+ */
+void asset_sound_stream_read(const AssetSoundStreamComp*, u32 frame, u32 frameCount, f32* out);
@@ -42,6 +42,12 @@ extern DataMeta g_assetTexProcDefMeta;
 String asset_texture_format_str(AssetTextureFormat);
 Mem    asset_texture_data(const AssetTextureComp*);
 
+/**
+ * Retrieve the pixel data starting at the given mip level.
+ * NOTE: Only mips with source data can be retrieved (so 'mipLevel' has to be below 'mipsData').
+ */
+Mem asset_texture_data_mip(const AssetTextureComp*, u32 mipLevel);
+
 /**
  * Lookup the color of a specific pixel specified by the given index.
  * NOTE: Always samples mip-level 0.
@@ -1,8 +1,10 @@
 #include "core/alloc.h"
 #include "core/array.h"
+#include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
 #include "core/file.h"
+#include "core/file_iterator.h"
 #include "core/math.h"
 #include "core/path.h"
 #include "core/stringtable.h"
@@ -18,6 +20,12 @@
 static const String g_assetCachePath    = string_static(".cache");
 static const String g_assetCacheRegName = string_static("registry.blob");
 
+/**
+ * Registry entries are sharded on their id-hash so parallel loads only contend when their assets
+ * happen to land on the same shard. NOTE: Has to be a power of two.
+ */
+#define asset_cache_shards 16
+
 typedef struct {
   u32 typeNameHash; // Hash of the type's name.
   u32 formatHash;   // Deep hash of the type's format ('data_hash()').
@@ -40,6 +48,7 @@ typedef struct {
   TimeReal       sourceModTime;
   u32            sourceChecksum;
   u32            sourceLoaderHash;
+  u32            blobChecksum; // crc32 (ISO 3309) of the blob; blobs are stored by content.
   HeapArray_t(AssetCacheDependency) dependencies;
 } AssetCacheEntry;
 
@@ -47,15 +56,20 @@ typedef struct {
   DynArray entries; // AssetCacheEntry[], sorted on idHash.
 } AssetCacheRegistry;
 
+typedef struct {
+  ThreadMutex mutex;
+  DynArray    entries; // AssetCacheEntry[], sorted on idHash.
+} AssetCacheShard;
+
 struct sAssetCache {
-  Allocator*         alloc;
-  bool               error;
-  AssetCacheFlags    flags;
-  String             rootPath;
-  AssetCacheRegistry reg;
-  ThreadMutex        regMutex;
-  bool               regDirty;
-  File*              regFile;
+  Allocator*      alloc;
+  bool            error;
+  AssetCacheFlags flags;
+  String          rootPath;
+  AssetCacheShard shards[asset_cache_shards];
+  ThreadMutex     regMutex; // Serializes registry file writes.
+  i32             regDirty;
+  File*           regFile;
 };
 
 DataMeta g_assetCacheMeta;
@@ -66,11 +80,37 @@ static i8 cache_compare_entry(const void* a, const void* b) {
   return compare_stringhash(&entryA->idHash, &entryB->idHash);
 }
 
-static String cache_blob_path_scratch(AssetCache* c, const StringHash idHash) {
-  const String blobName = fmt_write_scratch("{}.blob", fmt_int(idHash));
+static AssetCacheShard* cache_shard(AssetCache* c, const StringHash idHash) {
+  return &c->shards[idHash & (asset_cache_shards - 1)];
+}
+
+static String cache_blob_path_scratch(AssetCache* c, const u32 blobChecksum) {
+  const String blobName = fmt_write_scratch("{}.blob", fmt_int(blobChecksum));
   return path_build_scratch(c->rootPath, g_assetCachePath, blobName);
 }
 
+/**
+ * Delete all blob files in the cache directory.
+ * Used when the registry is recreated (for example an incompatible registry from an older
+ * version); without the registry the existing blobs are unreachable.
+ */
+static void cache_blobs_clear(AssetCache* c) {
+  const String  dirPath = path_build_scratch(c->rootPath, g_assetCachePath);
+  FileIterator* itr     = file_iterator_create(c->alloc, dirPath);
+
+  FileIteratorEntry  entry;
+  FileIteratorResult itrResult;
+  while ((itrResult = file_iterator_next(itr, &entry)) == FileIteratorResult_Found) {
+    if (entry.type != FileType_Regular || string_eq(entry.name, g_assetCacheRegName)) {
+      continue;
+    }
+    if (string_eq(path_extension(entry.name), string_lit("blob"))) {
+      file_delete_sync(path_build_scratch(dirPath, entry.name));
+    }
+  }
+  file_iterator_destroy(itr);
+}
+
 static bool cache_ensure_dir(AssetCache* c) {
   const String     path      = path_build_scratch(c->rootPath, g_assetCachePath);
   const FileResult createRes = file_create_dir_sync(path);
@@ -87,8 +127,22 @@ static bool cache_ensure_dir(AssetCache* c) {
 static bool cache_reg_save(AssetCache* c) {
   bool result = true;
 
+  /**
+   * Serialize a snapshot of all shards into a single registry.
+   * NOTE: All shard mutexes are held while serializing to guarantee a consistent snapshot (entry
+   * dependency arrays are freed when entries are updated).
+   */
+  AssetCacheRegistry reg = {.entries = dynarray_create_t(c->alloc, AssetCacheEntry, 128)};
+  array_for_t(c->shards, AssetCacheShard, shard) { thread_mutex_lock(shard->mutex); }
+  array_for_t(c->shards, AssetCacheShard, shard) {
+    dynarray_for_t(&shard->entries, AssetCacheEntry, entry) {
+      *dynarray_insert_sorted_t(&reg.entries, AssetCacheEntry, cache_compare_entry, entry) = *entry;
+    }
+  }
   DynString blobBuffer = dynstring_create(c->alloc, 256);
-  data_write_bin(g_dataReg, &blobBuffer, g_assetCacheMeta, mem_var(c->reg));
+  data_write_bin(g_dataReg, &blobBuffer, g_assetCacheMeta, mem_var(reg));
+  array_for_t(c->shards, AssetCacheShard, shard) { thread_mutex_unlock(shard->mutex); }
+  dynarray_destroy(&reg.entries);
 
   FileResult fileRes;
   if ((fileRes = file_resize_sync(c->regFile, 0))) {
@@ -139,9 +193,10 @@ static bool cache_reg_open(AssetCache* c) {
     return false;
   }
 
+  AssetCacheRegistry  reg;
   const DataReadFlags readFlags = DataReadFlags_None;
   DataReadResult      readRes;
-  data_read_bin(g_dataReg, data, c->alloc, g_assetCacheMeta, readFlags, mem_var(c->reg), &readRes);
+  data_read_bin(g_dataReg, data, c->alloc, g_assetCacheMeta, readFlags, mem_var(reg), &readRes);
   if (UNLIKELY(readRes.error)) {
     log_w(
         "Failed to read asset cache registry",
@@ -156,7 +211,15 @@ static bool cache_reg_open(AssetCache* c) {
       "Opened asset cache registry",
       log_param("path", fmt_path(path)),
       log_param("size", fmt_size(data.size)),
-      log_param("entries", fmt_int(c->reg.entries.size)));
+      log_param("entries", fmt_int(reg.entries.size)));
+
+  // Distribute the entries over the shards (entry ownership moves to the shards).
+  // NOTE: The registry is sorted on idHash so the shard entries stay sorted.
+  dynarray_for_t(&reg.entries, AssetCacheEntry, entry) {
+    AssetCacheShard* shard                             = cache_shard(c, entry->idHash);
+    *dynarray_push_t(&shard->entries, AssetCacheEntry) = *entry;
+  }
+  dynarray_destroy(&reg.entries);
 
   file_unmap(c->regFile, data);
   return true;
@@ -178,9 +241,8 @@ static bool cache_reg_create(AssetCache* c) {
     return false;
   }
 
-  c->reg = (AssetCacheRegistry){
-      .entries = dynarray_create_t(c->alloc, AssetCacheEntry, 32),
-  };
+  // Without a registry any existing blobs are unreachable; delete them.
+  cache_blobs_clear(c);
 
   return cache_reg_save(c);
 }
@@ -193,11 +255,12 @@ static bool cache_reg_open_or_create(AssetCache* c) {
 }
 
 /**
- * Pre-condition: cache->regMutex is held by this thread.
+ * Pre-condition: shard->mutex is held by this thread.
  */
-static AssetCacheEntry* cache_reg_add(AssetCache* c, const String id, const StringHash idHash) {
+static AssetCacheEntry*
+cache_reg_add(AssetCacheShard* shard, const String id, const StringHash idHash) {
   const AssetCacheEntry key = {.idHash = idHash};
-  AssetCacheEntry* res = dynarray_find_or_insert_sorted(&c->reg.entries, cache_compare_entry, &key);
+  AssetCacheEntry* res = dynarray_find_or_insert_sorted(&shard->entries, cache_compare_entry, &key);
   if (res->idHash == idHash) {
     // Existing entry.
     diag_assert_msg(string_eq(res->id, id), "Asset id hash collision detected");
@@ -212,11 +275,11 @@ static AssetCacheEntry* cache_reg_add(AssetCache* c, const String id, const Stri
 }
 
 /**
- * Pre-condition: cache->regMutex is held by this thread.
+ * Pre-condition: shard->mutex is held by this thread.
  */
-static const AssetCacheEntry* cache_reg_get(AssetCache* c, const StringHash idHash) {
+static const AssetCacheEntry* cache_reg_get(AssetCacheShard* shard, const StringHash idHash) {
   const AssetCacheEntry key = {.idHash = idHash};
-  return dynarray_search_binary(&c->reg.entries, cache_compare_entry, &key);
+  return dynarray_search_binary(&shard->entries, cache_compare_entry, &key);
 }
 
 static bool cache_reg_validate_file(
@@ -250,7 +313,7 @@ static bool cache_reg_validate_file(
 }
 
 /**
- * Pre-condition: cache->regMutex is held by this thread.
+ * Pre-condition: the entry's shard mutex is held by this thread.
  */
 static bool cache_reg_validate(
     const AssetCache* c, const AssetCacheEntry* entry, const AssetRepoLoaderHasher loaderHasher) {
@@ -320,6 +383,7 @@ void asset_data_init_cache(void) {
   data_reg_field_t(g_dataReg, AssetCacheEntry, sourceModTime, data_prim_t(i64));
   data_reg_field_t(g_dataReg, AssetCacheEntry, sourceChecksum, data_prim_t(u32));
   data_reg_field_t(g_dataReg, AssetCacheEntry, sourceLoaderHash, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, AssetCacheEntry, blobChecksum, data_prim_t(u32));
   data_reg_field_t(g_dataReg, AssetCacheEntry, dependencies, t_AssetCacheDependency, .container = DataContainer_HeapArray);
 
   data_reg_struct_t(g_dataReg, AssetCacheRegistry);
@@ -341,6 +405,10 @@ asset_cache_create(Allocator* alloc, const String rootPath, const AssetCacheFlag
       .rootPath = string_dup(alloc, rootPath),
       .regMutex = thread_mutex_create(alloc),
   };
+  array_for_t(c->shards, AssetCacheShard, shard) {
+    shard->mutex   = thread_mutex_create(alloc);
+    shard->entries = dynarray_create_t(alloc, AssetCacheEntry, 8);
+  }
 
   if (UNLIKELY(!cache_ensure_dir(c))) {
     c->error = true;
@@ -356,13 +424,21 @@ Ret:
 }
 
 void asset_cache_destroy(AssetCache* c) {
-  if (c->regDirty && !c->error) {
+  if (thread_atomic_load_i32(&c->regDirty) && !c->error) {
     cache_reg_save(c);
   }
   if (c->regFile) {
     file_destroy(c->regFile);
   }
-  data_destroy(g_dataReg, c->alloc, g_assetCacheMeta, mem_var(c->reg));
+  array_for_t(c->shards, AssetCacheShard, shard) {
+    dynarray_for_t(&shard->entries, AssetCacheEntry, entry) {
+      if (entry->dependencies.count) {
+        alloc_free_array_t(c->alloc, entry->dependencies.values, entry->dependencies.count);
+      }
+    }
+    dynarray_destroy(&shard->entries);
+    thread_mutex_destroy(shard->mutex);
+  }
   thread_mutex_destroy(c->regMutex);
 
   string_free(c->alloc, c->rootPath);
@@ -375,8 +451,8 @@ void asset_cache_flush(AssetCache* c) {
   }
   thread_mutex_lock(c->regMutex);
   {
-    if (c->regDirty && cache_reg_save(c)) {
-      c->regDirty = false;
+    if (thread_atomic_exchange_i32(&c->regDirty, 0) && !cache_reg_save(c)) {
+      thread_atomic_store_i32(&c->regDirty, 1); // Save failed; retry on the next flush.
     }
   }
   thread_mutex_unlock(c->regMutex);
@@ -395,15 +471,22 @@ void asset_cache_set(
   const StringHash     idHash    = string_hash(source->id);
   const AssetCacheMeta cacheMeta = cache_meta_create(g_dataReg, blobMeta);
 
-  // Save the blob to disk.
-  const String     blobPath     = cache_blob_path_scratch(c, idHash);
-  const FileResult blobWriteRes = file_write_to_path_atomic(blobPath, blob);
-  if (UNLIKELY(blobWriteRes != FileResult_Success)) {
-    log_w(
-        "Failed to write asset cache blob",
-        log_param("path", fmt_path(blobPath)),
-        log_param("error", fmt_text(file_result_str(blobWriteRes))));
-    return;
+  /**
+   * Save the blob to disk, addressed by its content checksum.
+   * When a blob with the same content already exists (for example the same source imported under
+   * two ids) the existing blob is shared instead of being written again.
+   */
+  const u32    blobChecksum = bits_crc_32(0, blob);
+  const String blobPath     = cache_blob_path_scratch(c, blobChecksum);
+  if (file_stat_path_sync(blobPath).type != FileType_Regular) {
+    const FileResult blobWriteRes = file_write_to_path_atomic(blobPath, blob);
+    if (UNLIKELY(blobWriteRes != FileResult_Success)) {
+      log_w(
+          "Failed to write asset cache blob",
+          log_param("path", fmt_path(blobPath)),
+          log_param("error", fmt_text(file_result_str(blobWriteRes))));
+      return;
+    }
   }
 
   // Initialize the dependency array.
@@ -422,23 +505,25 @@ void asset_cache_set(
   }
 
   // Add an entry to the registry.
-  thread_mutex_lock(c->regMutex);
+  AssetCacheShard* shard = cache_shard(c, idHash);
+  thread_mutex_lock(shard->mutex);
   {
-    AssetCacheEntry* entry  = cache_reg_add(c, source->id, idHash);
+    AssetCacheEntry* entry  = cache_reg_add(shard, source->id, idHash);
     entry->meta             = cacheMeta;
     entry->sourceModTime    = source->modTime;
     entry->sourceChecksum   = source->checksum;
     entry->sourceLoaderHash = source->loaderHash;
+    entry->blobChecksum     = blobChecksum;
     if (entry->dependencies.count) {
       // Cleanup the old dependencies.
       alloc_free_array_t(c->alloc, entry->dependencies.values, entry->dependencies.count);
     }
     entry->dependencies.values = cacheDependencies;
     entry->dependencies.count  = depCount;
-
-    c->regDirty = true;
   }
-  thread_mutex_unlock(c->regMutex);
+  thread_mutex_unlock(shard->mutex);
+
+  thread_atomic_store_i32(&c->regDirty, 1);
 }
 
 bool asset_cache_get(
@@ -454,10 +539,12 @@ bool asset_cache_get(
   const StringHash idHash = string_hash(id);
 
   // Lookup an entry in the registry.
-  bool success = false;
-  thread_mutex_lock(c->regMutex);
+  bool             success      = false;
+  u32              blobChecksum = 0;
+  AssetCacheShard* shard        = cache_shard(c, idHash);
+  thread_mutex_lock(shard->mutex);
   {
-    const AssetCacheEntry* entry = cache_reg_get(c, idHash);
+    const AssetCacheEntry* entry = cache_reg_get(shard, idHash);
     if (entry) {
       diag_assert_msg(string_eq(entry->id, id), "Asset id hash collision detected");
 
@@ -470,15 +557,16 @@ bool asset_cache_get(
       out->sourceModTime    = entry->sourceModTime;
       out->sourceChecksum   = entry->sourceChecksum;
       out->sourceLoaderHash = entry->sourceLoaderHash;
+      blobChecksum          = entry->blobChecksum;
       success               = true;
     }
   Incompatible:;
   }
-  thread_mutex_unlock(c->regMutex);
+  thread_mutex_unlock(shard->mutex);
 
   // Open the blob file.
   if (success) {
-    const String path = cache_blob_path_scratch(c, idHash);
+    const String path = cache_blob_path_scratch(c, blobChecksum);
     FileResult   fileRes;
     if ((fileRes = file_create(c->alloc, path, FileMode_Open, FileAccess_Read, &out->blobFile))) {
       log_w(
@@ -493,14 +581,110 @@ bool asset_cache_get(
   return success;
 }
 
+void asset_cache_set_aux(
+    AssetCache*    c,
+    const String   id,
+    const u32      keyHash,
+    const Mem      blob,
+    const DataMeta blobMeta) {
+  if (UNLIKELY(c->error)) {
+    return;
+  }
+  const StringHash     idHash    = string_hash(id);
+  const AssetCacheMeta cacheMeta = cache_meta_create(g_dataReg, blobMeta);
+
+  // Save the blob to disk, addressed by its content checksum (shared when content matches).
+  const u32    blobChecksum = bits_crc_32(0, blob);
+  const String blobPath     = cache_blob_path_scratch(c, blobChecksum);
+  if (file_stat_path_sync(blobPath).type != FileType_Regular) {
+    const FileResult blobWriteRes = file_write_to_path_atomic(blobPath, blob);
+    if (UNLIKELY(blobWriteRes != FileResult_Success)) {
+      log_w(
+          "Failed to write asset cache blob",
+          log_param("path", fmt_path(blobPath)),
+          log_param("error", fmt_text(file_result_str(blobWriteRes))));
+      return;
+    }
+  }
+
+  /**
+   * Add an entry to the registry.
+   * Auxiliary entries have no source file; the caller provided key hash is stored in the
+   * loader-hash field and is the only validation performed on lookup.
+   */
+  AssetCacheShard* shard = cache_shard(c, idHash);
+  thread_mutex_lock(shard->mutex);
+  {
+    AssetCacheEntry* entry  = cache_reg_add(shard, id, idHash);
+    entry->meta             = cacheMeta;
+    entry->sourceModTime    = 0;
+    entry->sourceChecksum   = 0;
+    entry->sourceLoaderHash = keyHash;
+    entry->blobChecksum     = blobChecksum;
+    if (entry->dependencies.count) {
+      // Cleanup the old dependencies.
+      alloc_free_array_t(c->alloc, entry->dependencies.values, entry->dependencies.count);
+      entry->dependencies.values = null;
+      entry->dependencies.count  = 0;
+    }
+  }
+  thread_mutex_unlock(shard->mutex);
+
+  thread_atomic_store_i32(&c->regDirty, 1);
+}
+
+bool asset_cache_get_aux(
+    AssetCache* c, const String id, const u32 keyHash, AssetCacheRecord* out) {
+  if (UNLIKELY(c->error)) {
+    return false;
+  }
+  const StringHash idHash = string_hash(id);
+
+  // Lookup an entry in the registry.
+  bool             success      = false;
+  u32              blobChecksum = 0;
+  AssetCacheShard* shard        = cache_shard(c, idHash);
+  thread_mutex_lock(shard->mutex);
+  {
+    const AssetCacheEntry* entry = cache_reg_get(shard, idHash);
+    if (entry && entry->sourceLoaderHash == keyHash) {
+      diag_assert_msg(string_eq(entry->id, id), "Asset id hash collision detected");
+
+      if (cache_meta_resolve(g_dataReg, &entry->meta, &out->meta)) {
+        out->sourceModTime    = entry->sourceModTime;
+        out->sourceChecksum   = entry->sourceChecksum;
+        out->sourceLoaderHash = entry->sourceLoaderHash;
+        blobChecksum          = entry->blobChecksum;
+        success               = true;
+      }
+    }
+  }
+  thread_mutex_unlock(shard->mutex);
+
+  // Open the blob file.
+  if (success) {
+    const String path = cache_blob_path_scratch(c, blobChecksum);
+    FileResult   fileRes;
+    if ((fileRes = file_create(c->alloc, path, FileMode_Open, FileAccess_Read, &out->blobFile))) {
+      log_w(
+          "Failed to open asset cache blob",
+          log_param("error", fmt_text(file_result_str(fileRes))));
+      success = false;
+    }
+  }
+
+  return success;
+}
+
 usize asset_cache_deps(
     AssetCache* c, String id, AssetRepoDep out[PARAM_ARRAY_SIZE(asset_repo_cache_deps_max)]) {
   const StringHash idHash = string_hash(id);
 
-  usize result = 0;
-  thread_mutex_lock(c->regMutex);
+  usize            result = 0;
+  AssetCacheShard* shard  = cache_shard(c, idHash);
+  thread_mutex_lock(shard->mutex);
   {
-    const AssetCacheEntry* entry = cache_reg_get(c, idHash);
+    const AssetCacheEntry* entry = cache_reg_get(shard, idHash);
     if (entry) {
       result = math_min(entry->dependencies.count, asset_repo_cache_deps_max);
       for (usize i = 0; i != result; ++i) {
@@ -513,6 +697,6 @@ usize asset_cache_deps(
       }
     }
   }
-  thread_mutex_unlock(c->regMutex);
+  thread_mutex_unlock(shard->mutex);
   return result;
 }
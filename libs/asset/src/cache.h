@@ -50,3 +50,18 @@ bool asset_cache_get(AssetCache*, String id, AssetRepoLoaderHasher, AssetCacheRe
  */
 usize asset_cache_deps(
     AssetCache*, String id, AssetRepoDep out[PARAM_ARRAY_SIZE(asset_repo_cache_deps_max)]);
+
+/**
+ * Save an auxiliary blob in the cache.
+ * Auxiliary blobs are keyed by an explicit hash instead of a source asset; callers are responsible
+ * for including all inputs (for example the source content checksum) in the key hash.
+ * NOTE: Overwrites any existing blobs with the same id.
+ */
+void asset_cache_set_aux(AssetCache*, String id, u32 keyHash, Mem blob, DataMeta blobMeta);
+
+/**
+ * Lookup an auxiliary cache record with the given id.
+ * Returns true when a blob with a matching key hash was found.
+ * NOTE: When successful the caller is responsible for destroying the blob file handle.
+ */
+bool asset_cache_get_aux(AssetCache*, String id, u32 keyHash, AssetCacheRecord* out);
@@ -365,3 +365,33 @@ u32 asset_data_query_refs_unpatched(
   data_visit(g_dataReg, meta, data, g_assetRefType, &ctx, asset_data_query_refs_visitor);
   return ctx.outCount;
 }
+
+typedef struct {
+  StringHash* out;
+  u32         outCount, outMax;
+} AssetDataQueryIdCtx;
+
+static void asset_data_query_ref_ids_visitor(void* ctx, const Mem data) {
+  AssetDataQueryIdCtx* queryCtx = ctx;
+  const AssetRef*      refData  = mem_as_t(data, AssetRef);
+
+  if (UNLIKELY(queryCtx->outCount == queryCtx->outMax)) {
+    return;
+  }
+  if (!refData->id) {
+    return;
+  }
+  for (u32 i = 0; i != queryCtx->outCount; ++i) {
+    if (queryCtx->out[i] == refData->id) {
+      return; // Duplicate reference.
+    }
+  }
+  queryCtx->out[queryCtx->outCount++] = refData->id;
+}
+
+u32 asset_data_query_ref_ids(
+    const DataMeta meta, const Mem data, StringHash out[], const u32 outMax) {
+  AssetDataQueryIdCtx ctx = {.out = out, .outMax = outMax};
+  data_visit(g_dataReg, meta, data, g_assetRefType, &ctx, asset_data_query_ref_ids_visitor);
+  return ctx.outCount;
+}
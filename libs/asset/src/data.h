@@ -38,3 +38,4 @@ bool asset_data_patch_refs(EcsWorld*, AssetManagerComp*, DataMeta, Mem data);
 u32  asset_data_query_refs(DataMeta, Mem data, EcsEntityId out[], u32 outMax);
 u32  asset_data_query_refs_unpatched(
      EcsWorld*, AssetManagerComp*, DataMeta, Mem data, EcsEntityId out[], u32 outMax);
+u32  asset_data_query_ref_ids(DataMeta, Mem data, StringHash out[], u32 outMax);
@@ -115,3 +115,8 @@ AssetFormat asset_format_from_bin_meta(const DataMeta meta) {
   }
   return AssetFormat_Raw;
 }
+
+const DataMeta* asset_format_bin_meta(const AssetFormat fmt) {
+  diag_assert(fmt < AssetFormat_Count);
+  return g_assetFormatBinMeta[fmt];
+}
@@ -46,3 +46,8 @@ typedef enum eAssetFormat {
 String      asset_format_str(AssetFormat);
 AssetFormat asset_format_from_ext(String ext);
 AssetFormat asset_format_from_bin_meta(DataMeta);
+
+/**
+ * Lookup the data-type of binary formats, returns null for non-binary formats.
+ */
+const DataMeta* asset_format_bin_meta(AssetFormat);
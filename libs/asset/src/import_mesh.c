@@ -71,6 +71,24 @@ static ScriptVal import_eval_flat_normals(AssetImportContext* ctx, ScriptBinderC
   return script_null();
 }
 
+static ScriptVal import_eval_weld(AssetImportContext* ctx, ScriptBinderCall* call) {
+  AssetImportMesh* data = ctx->data;
+  if (call->argCount < 1) {
+    return script_bool(data->weld);
+  }
+  data->weld = script_arg_bool(call, 0);
+  return script_null();
+}
+
+static ScriptVal import_eval_lods(AssetImportContext* ctx, ScriptBinderCall* call) {
+  AssetImportMesh* data = ctx->data;
+  if (call->argCount < 1) {
+    return script_bool(data->lods);
+  }
+  data->lods = script_arg_bool(call, 0);
+  return script_null();
+}
+
 static ScriptVal import_eval_joint_count(AssetImportContext* ctx, ScriptBinderCall* call) {
   (void)call;
   AssetImportMesh* data = ctx->data;
@@ -254,6 +272,24 @@ void asset_data_init_import_mesh(const bool devSupport) {
     };
     asset_import_bind(binder, name, doc, ret, args, array_elems(args), import_eval_flat_normals);
   }
+  {
+    const String       name   = string_lit("weld");
+    const String       doc    = string_lit("Weld vertices that are equal within a small tolerance (reduces the vertex count).");
+    const ScriptMask   ret    = script_mask_bool | script_mask_null;
+    const ScriptSigArg args[] = {
+        {string_lit("weld"), script_mask_bool | script_mask_null},
+    };
+    asset_import_bind(binder, name, doc, ret, args, array_elems(args), import_eval_weld);
+  }
+  {
+    const String       name   = string_lit("lods");
+    const String       doc    = string_lit("Generate simplified level-of-detail index ranges for the mesh (used when rendering at a distance).");
+    const ScriptMask   ret    = script_mask_bool | script_mask_null;
+    const ScriptSigArg args[] = {
+        {string_lit("lods"), script_mask_bool | script_mask_null},
+    };
+    asset_import_bind(binder, name, doc, ret, args, array_elems(args), import_eval_lods);
+  }
   {
     const String       name   = string_lit("joint_count");
     const String       doc    = string_lit("Query the amount of joints in the mesh.\nThe joints are topologically sorted so the root is always at index 0.");
@@ -20,6 +20,8 @@ typedef struct {
 
 typedef struct {
   bool flatNormals;
+  bool weld; // Weld vertices that are equal within a small tolerance.
+  bool lods; // Generate simplified level-of-detail index ranges.
 
   GeoVector vertexTranslation;
   GeoQuat   vertexRotation;
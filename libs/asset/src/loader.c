@@ -29,7 +29,7 @@
   _X_(AssetFormat_ShaderGlslVert,   shader_glsl_vert,   4  )                                       \
   _X_(AssetFormat_ShaderSpv,        shader_spv,         3  )                                       \
   _X_(AssetFormat_SoundBin,         sound_bin,          2  )                                       \
-  _X_(AssetFormat_SoundWav,         sound_wav,          2  )                                       \
+  _X_(AssetFormat_SoundWav,         sound_wav,          3  )                                       \
   _X_(AssetFormat_TexArray,         tex_array,          3  )                                       \
   _X_(AssetFormat_TexAtlas,         tex_atlas,          4  )                                       \
   _X_(AssetFormat_TexAtlasBin,      tex_atlas_bin,      2  )                                       \
@@ -70,9 +70,15 @@ ecs_module_init(asset_mesh_module) {
 
 void asset_data_init_mesh(void) {
   // clang-format off
+  data_reg_struct_t(g_dataReg, AssetMeshLod);
+  data_reg_field_t(g_dataReg, AssetMeshLod, indexOffset, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, AssetMeshLod, indexCount, data_prim_t(u32));
+
   data_reg_struct_t(g_dataReg, AssetMeshComp);
   data_reg_field_t(g_dataReg, AssetMeshComp, vertexCount, data_prim_t(u32));
   data_reg_field_t(g_dataReg, AssetMeshComp, indexCount, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, AssetMeshComp, lodCount, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, AssetMeshComp, lods, t_AssetMeshLod, .container = DataContainer_InlineArray, .fixedCount = asset_mesh_lods_max);
   data_reg_field_t(g_dataReg, AssetMeshComp, vertexData, data_prim_t(DataMem), .flags = DataFlags_ExternalMemory);
   data_reg_field_t(g_dataReg, AssetMeshComp, indexData, data_prim_t(DataMem), .flags = DataFlags_ExternalMemory);
   data_reg_field_t(g_dataReg, AssetMeshComp, bounds, g_assetGeoBoxType);
@@ -14,10 +14,12 @@
 #include "ecs/view.h"
 #include "ecs/world.h"
 #include "geo/matrix.h"
+#include "data/utils.h"
 #include "json/doc.h"
 #include "json/read.h"
 #include "trace/tracer.h"
 
+#include "data.h"
 #include "import_mesh.h"
 #include "loader_mesh.h"
 #include "manager.h"
@@ -42,10 +44,16 @@
 
 #define glb_chunk_count_max 16
 
+/**
+ * Number of parallel tasks for the decode phase; allows both overlapping multiple asset loads and
+ * starting on a new asset while an earlier (expensive) one is still decoding.
+ */
+#define gltf_decode_tasks 4
+
 typedef enum {
   GltfLoadPhase_BuffersAcquire,
   GltfLoadPhase_BuffersWait,
-  GltfLoadPhase_Parse,
+  GltfLoadPhase_Decode, // Parse + build; cpu-heavy, executed in parallel by AssetGltfDecodeSys.
 } GltfLoadPhase;
 
 typedef struct {
@@ -153,6 +161,41 @@ typedef struct {
   GltfAnimChannel channels[asset_mesh_joints_max][AssetMeshAnimTarget_Count];
 } GltfAnim;
 
+typedef enum {
+  GltfError_None = 0,
+  GltfError_InvalidJson,
+  GltfError_MalformedFile,
+  GltfError_MalformedGlbHeader,
+  GltfError_MalformedGlbChunk,
+  GltfError_MalformedBuffers,
+  GltfError_MalformedBufferViews,
+  GltfError_MalformedAccessors,
+  GltfError_MalformedPrims,
+  GltfError_MalformedPrimIndices,
+  GltfError_MalformedPrimPositions,
+  GltfError_MalformedPrimNormals,
+  GltfError_MalformedPrimTangents,
+  GltfError_MalformedPrimTexcoords,
+  GltfError_MalformedPrimJoints,
+  GltfError_MalformedPrimWeights,
+  GltfError_MalformedBindMatrix,
+  GltfError_MalformedSceneTransform,
+  GltfError_MalformedSkin,
+  GltfError_MalformedNodes,
+  GltfError_MalformedAnimation,
+  GltfError_JointCountExceedsMaximum,
+  GltfError_AnimCountExceedsMaximum,
+  GltfError_InvalidBuffer,
+  GltfError_UnsupportedPrimitiveMode,
+  GltfError_UnsupportedGlbVersion,
+  GltfError_GlbJsonChunkMissing,
+  GltfError_GlbChunkCountExceedsMaximum,
+  GltfError_NoPrimitives,
+  GltfError_ImportFailed,
+
+  GltfError_Count,
+} GltfError;
+
 ecs_comp_define(AssetGltfLoadComp) {
   Allocator*    transientAlloc;
   String        assetId;
@@ -178,6 +221,11 @@ ecs_comp_define(AssetGltfLoadComp) {
 
   AssetSource* glbDataSource;
   GlbChunk     glbBinChunk;
+
+  GltfError             resultErr;
+  bool                  resultPending;  // Decoded results are waiting to be finalized.
+  AssetMeshComp         resultMesh;     // Only valid while 'resultPending'.
+  AssetMeshSkeletonComp resultSkeleton; // Only valid while 'resultPending' for skinned meshes.
 };
 
 typedef AssetGltfLoadComp GltfLoad;
@@ -188,45 +236,16 @@ static void ecs_destruct_gltf_load_comp(void* data) {
   if (comp->glbDataSource) {
     asset_repo_close(comp->glbDataSource);
   }
+  if (comp->resultPending) {
+    data_destroy(g_dataReg, g_allocHeap, g_assetMeshMeta, mem_var(comp->resultMesh));
+    if (comp->jointCount) {
+      data_destroy(g_dataReg, g_allocHeap, g_assetMeshSkeletonMeta, mem_var(comp->resultSkeleton));
+    }
+  }
   alloc_chunked_destroy(comp->transientAlloc);
   dynarray_destroy(&comp->animData);
 }
 
-typedef enum {
-  GltfError_None = 0,
-  GltfError_InvalidJson,
-  GltfError_MalformedFile,
-  GltfError_MalformedGlbHeader,
-  GltfError_MalformedGlbChunk,
-  GltfError_MalformedBuffers,
-  GltfError_MalformedBufferViews,
-  GltfError_MalformedAccessors,
-  GltfError_MalformedPrims,
-  GltfError_MalformedPrimIndices,
-  GltfError_MalformedPrimPositions,
-  GltfError_MalformedPrimNormals,
-  GltfError_MalformedPrimTangents,
-  GltfError_MalformedPrimTexcoords,
-  GltfError_MalformedPrimJoints,
-  GltfError_MalformedPrimWeights,
-  GltfError_MalformedBindMatrix,
-  GltfError_MalformedSceneTransform,
-  GltfError_MalformedSkin,
-  GltfError_MalformedNodes,
-  GltfError_MalformedAnimation,
-  GltfError_JointCountExceedsMaximum,
-  GltfError_AnimCountExceedsMaximum,
-  GltfError_InvalidBuffer,
-  GltfError_UnsupportedPrimitiveMode,
-  GltfError_UnsupportedGlbVersion,
-  GltfError_GlbJsonChunkMissing,
-  GltfError_GlbChunkCountExceedsMaximum,
-  GltfError_NoPrimitives,
-  GltfError_ImportFailed,
-
-  GltfError_Count,
-} GltfError;
-
 static String gltf_error_str(const GltfError err) {
   static const String g_msgs[] = {
       string_static("None"),
@@ -1389,6 +1408,13 @@ static void gltf_build_mesh(
   if (!(meta.features & GltfFeature_Tangents) || importData->flatNormals) {
     asset_mesh_compute_tangents(builder);
   }
+  if (importData->weld) {
+    asset_mesh_weld(builder);
+  }
+  asset_mesh_optimize(builder);
+  if (importData->lods) {
+    asset_mesh_generate_lods(builder);
+  }
   *out = asset_mesh_create(builder);
   *err = GltfError_None;
 
@@ -1757,11 +1783,80 @@ static bool gltf_import(const AssetImportEnvComp* importEnv, GltfLoad* ld, Asset
   return asset_import_mesh(importEnv, ld->assetId, out);
 }
 
-ecs_view_define(LoadGlobalView) {
-  ecs_access_write(AssetManagerComp);
-  ecs_access_read(AssetImportEnvComp);
+/**
+ * Decode the gltf data: parse the json structures, run the import logic and build the mesh (and
+ * optionally skeleton). Purely cpu work on the already loaded buffers; safe to run in parallel for
+ * different loads. Results are stored on the load component to be finalized by the load system.
+ */
+static void gltf_decode(const AssetImportEnvComp* importEnv, GltfLoad* ld) {
+  GltfError err = GltfError_None;
+  gltf_parse_views(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_accessors(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_primitives(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_scene_transform(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_skin(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_skeleton_nodes(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_bind_matrices(ld, &err);
+  if (err) {
+    goto Done;
+  }
+  gltf_parse_animations(ld, &err);
+  if (err) {
+    goto Done;
+  }
+
+  AssetImportMesh importData;
+  if (!gltf_import(importEnv, ld, &importData)) {
+    err = GltfError_ImportFailed;
+    goto Done;
+  }
+
+#ifdef VOLO_TRACE
+  const String traceMsg = path_filename(ld->assetId);
+#endif
+  trace_begin_msg("asset_gltf_build", TraceColor_Blue, "{}", fmt_text(traceMsg));
+
+  gltf_build_mesh(ld, &importData, &ld->resultMesh, &err);
+
+  trace_end();
+  if (err) {
+    goto Done;
+  }
+  if (ld->jointCount) {
+    gltf_build_skeleton(ld, &importData, &ld->resultSkeleton, &err);
+    if (err) {
+      data_destroy(g_dataReg, g_allocHeap, g_assetMeshMeta, mem_var(ld->resultMesh));
+      goto Done;
+    }
+  }
+  ld->resultPending = true;
+
+Done:
+  ld->resultErr = err;
 }
 
+ecs_view_define(LoadGlobalView) { ecs_access_write(AssetManagerComp); }
+
+ecs_view_define(DecodeGlobalView) { ecs_access_read(AssetImportEnvComp); }
+
 ecs_view_define(LoadView) {
   ecs_access_write(AssetGltfLoadComp);
   ecs_access_read(AssetComp);
@@ -1778,14 +1873,11 @@ ecs_system_define(AssetGltfLoadSys) {
   if (!globalItr) {
     return; // Global dependencies not initialized.
   }
-  AssetManagerComp*         manager   = ecs_view_write_t(globalItr, AssetManagerComp);
-  const AssetImportEnvComp* importEnv = ecs_view_read_t(globalItr, AssetImportEnvComp);
+  AssetManagerComp* manager = ecs_view_write_t(globalItr, AssetManagerComp);
 
   EcsView*     loadView  = ecs_world_view_t(world, LoadView);
   EcsIterator* bufferItr = ecs_view_itr(ecs_world_view_t(world, BufferView));
 
-  AssetImportMesh importData;
-
   for (EcsIterator* itr = ecs_view_itr(loadView); ecs_view_walk(itr);) {
     const EcsEntityId  entity = ecs_view_entity(itr);
     AssetGltfLoadComp* ld     = ecs_view_write_t(itr, AssetGltfLoadComp);
@@ -1823,81 +1915,13 @@ ecs_system_define(AssetGltfLoadSys) {
         buffer->data = string_slice(data, 0, buffer->length);
       }
       ++ld->phase;
-      // Fallthrough.
-    case GltfLoadPhase_Parse: {
-      gltf_parse_views(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_accessors(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_primitives(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_scene_transform(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_skin(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_skeleton_nodes(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_bind_matrices(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      gltf_parse_animations(ld, &err);
-      if (err) {
-        goto Error;
-      }
-      if (!gltf_import(importEnv, ld, &importData)) {
-        err = GltfError_ImportFailed;
-        goto Error;
-      }
-
-#ifdef VOLO_TRACE
-      const String traceMsg = path_filename(asset_id(ecs_view_read_t(itr, AssetComp)));
-#endif
-      trace_begin_msg("asset_gltf_build", TraceColor_Blue, "{}", fmt_text(traceMsg));
-
-      AssetMeshBundle meshBundle;
-      gltf_build_mesh(ld, &importData, &meshBundle.mesh, &err);
-
-      trace_end();
-      if (err) {
-        goto Error;
-      }
-      *ecs_world_add_t(world, entity, AssetMeshComp) = meshBundle.mesh;
-      if (ld->jointCount) {
-        AssetMeshSkeletonComp resultSkeleton;
-        gltf_build_skeleton(ld, &importData, &resultSkeleton, &err);
-        if (err) {
-          goto Error;
-        }
-        meshBundle.skeleton  = ecs_world_add_t(world, entity, AssetMeshSkeletonComp);
-        *meshBundle.skeleton = resultSkeleton;
-      } else {
-        meshBundle.skeleton = null;
-      }
-
-      asset_mark_load_success(world, entity);
-
-      asset_cache(world, entity, g_assetMeshBundleMeta, mem_var(meshBundle));
-      goto Cleanup;
-    }
+      goto Next; // Ready to be decoded (in parallel) by 'AssetGltfDecodeSys'.
+    case GltfLoadPhase_Decode:
+      goto Next; // Decoded and finalized by 'AssetGltfDecodeSys'.
     }
 
   Error:
     asset_mark_load_failure(world, entity, ld->assetId, gltf_error_str(err), (i32)err);
-
-  Cleanup:
     for (GltfBuffer* buffer = ld->buffers; buffer != ld->buffers + ld->bufferCount; ++buffer) {
       if (buffer->entity) {
         asset_release(world, buffer->entity);
@@ -1910,10 +1934,66 @@ ecs_system_define(AssetGltfLoadSys) {
   }
 }
 
+/**
+ * Finalize a decoded load: add the result components (or mark the load as failed) and clean up the
+ * load state. Only performs (thread-safe) world operations; safe to call from a parallel system.
+ */
+static void gltf_finalize(EcsWorld* world, const EcsEntityId entity, GltfLoad* ld) {
+  if (ld->resultErr) {
+    const GltfError err = ld->resultErr;
+    asset_mark_load_failure(world, entity, ld->assetId, gltf_error_str(err), (i32)err);
+  } else {
+    AssetMeshBundle meshBundle;
+    meshBundle.mesh                                = ld->resultMesh;
+    *ecs_world_add_t(world, entity, AssetMeshComp) = ld->resultMesh;
+    if (ld->jointCount) {
+      meshBundle.skeleton  = ecs_world_add_t(world, entity, AssetMeshSkeletonComp);
+      *meshBundle.skeleton = ld->resultSkeleton;
+    } else {
+      meshBundle.skeleton = null;
+    }
+    ld->resultPending = false; // Ownership transferred to the result components.
+
+    asset_mark_load_success(world, entity);
+
+    asset_cache(world, entity, g_assetMeshBundleMeta, mem_var(meshBundle));
+  }
+  for (GltfBuffer* buffer = ld->buffers; buffer != ld->buffers + ld->bufferCount; ++buffer) {
+    if (buffer->entity) {
+      asset_release(world, buffer->entity);
+    }
+  }
+  ecs_world_remove_t(world, entity, AssetGltfLoadComp);
+}
+
+/**
+ * Decode (and finalize) all loads that have their buffers available.
+ * NOTE: Runs as multiple parallel tasks; each task decodes a disjoint set of loads.
+ */
+ecs_system_define(AssetGltfDecodeSys) {
+  EcsView*     globalView = ecs_world_view_t(world, DecodeGlobalView);
+  EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
+  if (!globalItr) {
+    return; // Global dependencies not initialized.
+  }
+  const AssetImportEnvComp* importEnv = ecs_view_read_t(globalItr, AssetImportEnvComp);
+
+  EcsView* loadView = ecs_world_view_t(world, LoadView);
+  for (EcsIterator* itr = ecs_view_itr_step(loadView, parCount, parIndex); ecs_view_walk(itr);) {
+    AssetGltfLoadComp* ld = ecs_view_write_t(itr, AssetGltfLoadComp);
+    if (ld->phase != GltfLoadPhase_Decode) {
+      continue;
+    }
+    gltf_decode(importEnv, ld);
+    gltf_finalize(world, ecs_view_entity(itr), ld);
+  }
+}
+
 ecs_module_init(asset_mesh_gltf_module) {
   ecs_register_comp(AssetGltfLoadComp, .destructor = ecs_destruct_gltf_load_comp);
 
   ecs_register_view(LoadGlobalView);
+  ecs_register_view(DecodeGlobalView);
   ecs_register_view(LoadView);
   ecs_register_view(BufferView);
 
@@ -1922,6 +2002,11 @@ ecs_module_init(asset_mesh_gltf_module) {
       ecs_view_id(LoadGlobalView),
       ecs_view_id(LoadView),
       ecs_view_id(BufferView));
+
+  ecs_register_system(AssetGltfDecodeSys, ecs_view_id(DecodeGlobalView), ecs_view_id(LoadView));
+  ecs_parallel(AssetGltfDecodeSys, gltf_decode_tasks);
+  ecs_order(AssetGltfDecodeSys, 1); // After 'AssetGltfLoadSys'; decode in the same tick as the
+                                    // buffers become available.
 }
 
 static GltfLoad* gltf_load(
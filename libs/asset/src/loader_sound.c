@@ -1,5 +1,5 @@
-#include "asset/sound.h"
 #include "core/alloc.h"
+#include "core/diag.h"
 #include "data/read.h"
 #include "data/utils.h"
 #include "ecs/entity.h"
@@ -8,13 +8,21 @@
 #include "ecs/world.h"
 
 #include "import.h"
+#include "loader_sound.h"
 #include "manager.h"
-#include "repo.h"
 
 DataMeta g_assetSoundMeta;
 
 ecs_comp_define(AssetSoundComp);
 
+ecs_comp_define(AssetSoundStreamComp) {
+  u8           frameChannels;
+  u32          frameCount;
+  u32          frameRate;
+  const i16*   samples; // Interleaved (LRLRLR) samples inside the retained source.
+  AssetSource* src;
+};
+
 ecs_comp_define(AssetSoundSourceComp) { AssetSource* src; };
 
 static void ecs_destruct_sound_comp(void* data) {
@@ -22,6 +30,11 @@ static void ecs_destruct_sound_comp(void* data) {
   data_destroy(g_dataReg, g_allocHeap, g_assetSoundMeta, mem_create(comp, sizeof(AssetSoundComp)));
 }
 
+static void ecs_destruct_sound_stream_comp(void* data) {
+  AssetSoundStreamComp* comp = data;
+  asset_repo_close(comp->src);
+}
+
 static void ecs_destruct_sound_source_comp(void* data) {
   AssetSoundSourceComp* comp = data;
   asset_repo_close(comp->src);
@@ -32,6 +45,11 @@ ecs_view_define(UnloadView) {
   ecs_access_without(AssetLoadedComp);
 }
 
+ecs_view_define(UnloadStreamView) {
+  ecs_access_with(AssetSoundStreamComp);
+  ecs_access_without(AssetLoadedComp);
+}
+
 /**
  * Remove any sound-asset components for unloaded assets.
  */
@@ -42,15 +60,59 @@ ecs_system_define(AssetSoundUnloadSys) {
     ecs_world_remove_t(world, entity, AssetSoundComp);
     ecs_utils_maybe_remove_t(world, entity, AssetSoundSourceComp);
   }
+  EcsView* unloadStreamView = ecs_world_view_t(world, UnloadStreamView);
+  for (EcsIterator* itr = ecs_view_itr(unloadStreamView); ecs_view_walk(itr);) {
+    ecs_world_remove_t(world, ecs_view_entity(itr), AssetSoundStreamComp);
+  }
 }
 
 ecs_module_init(asset_sound_module) {
   ecs_register_comp(AssetSoundComp, .destructor = ecs_destruct_sound_comp);
+  ecs_register_comp(AssetSoundStreamComp, .destructor = ecs_destruct_sound_stream_comp);
   ecs_register_comp(AssetSoundSourceComp, .destructor = ecs_destruct_sound_source_comp);
 
   ecs_register_view(UnloadView);
+  ecs_register_view(UnloadStreamView);
+
+  ecs_register_system(AssetSoundUnloadSys, ecs_view_id(UnloadView), ecs_view_id(UnloadStreamView));
+}
+
+u8 asset_sound_stream_channels(const AssetSoundStreamComp* comp) { return comp->frameChannels; }
+
+u32 asset_sound_stream_frame_count(const AssetSoundStreamComp* comp) { return comp->frameCount; }
+
+u32 asset_sound_stream_frame_rate(const AssetSoundStreamComp* comp) { return comp->frameRate; }
+
+void asset_sound_stream_read(
+    const AssetSoundStreamComp* comp, const u32 frame, const u32 frameCount, f32* out) {
+  diag_assert(frame + frameCount <= comp->frameCount);
+
+  static const f32 g_i16MaxInv = 1.0f / i16_max;
+  // Assumes the host system is using little-endian byte-order and 2's complement integers.
+  const i16* data        = comp->samples + frame * comp->frameChannels;
+  const u32  sampleCount = frameCount * comp->frameChannels;
+  for (u32 i = 0; i != sampleCount; ++i) {
+    out[i] = (f32)data[i] * g_i16MaxInv;
+  }
+}
 
-  ecs_register_system(AssetSoundUnloadSys, ecs_view_id(UnloadView));
+void asset_sound_stream_create(
+    EcsWorld*         world,
+    const EcsEntityId entity,
+    const u8          frameChannels,
+    const u32         frameCount,
+    const u32         frameRate,
+    const i16*        samples,
+    AssetSource*      src) {
+  ecs_world_add_t(
+      world,
+      entity,
+      AssetSoundStreamComp,
+      .frameChannels = frameChannels,
+      .frameCount    = frameCount,
+      .frameRate     = frameRate,
+      .samples       = samples,
+      .src           = src);
 }
 
 void asset_data_init_sound(void) {
@@ -0,0 +1,17 @@
+#include "asset/sound.h"
+
+#include "repo.h"
+
+/**
+ * Create a streamed sound component for the given asset entity.
+ * NOTE: Takes ownership of the source; it stays open until the component is destroyed.
+ * Pre-condition: samples contains frameCount * frameChannels interleaved (LRLRLR) 16 bit samples.
+ */
+void asset_sound_stream_create(
+    EcsWorld*,
+    EcsEntityId  entity,
+    u8           frameChannels,
+    u32          frameCount,
+    u32          frameRate,
+    const i16*   samples,
+    AssetSource* src);
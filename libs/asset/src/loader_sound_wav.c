@@ -1,12 +1,11 @@
-#include "asset/sound.h"
 #include "core/alloc.h"
 #include "core/array.h"
 #include "core/dynarray.h"
 #include "ecs/entity.h"
 #include "ecs/world.h"
 
+#include "loader_sound.h"
 #include "manager.h"
-#include "repo.h"
 
 /**
  * Waveform Audio File Format.
@@ -19,6 +18,13 @@
 #define wav_frames_min 64
 #define wav_frames_max (1024 * 1024 * 64)
 
+/**
+ * Sounds whose decoded samples exceed this threshold are streamed: instead of decoding all frames
+ * up-front the source is kept open and frames are decoded on demand (ahead of the play cursor).
+ * This avoids keeping long music / ambience tracks fully resident.
+ */
+#define wav_stream_threshold (usize_mebibyte * 4)
+
 typedef struct {
   String tag;
   Mem    data;
@@ -184,10 +190,6 @@ static void wav_read_samples(
     *err = WavError_DataChunkMissing;
     return;
   }
-  if (format.sampleDepth != 16) {
-    *err = WavError_SampleDepthUnsupported;
-    return;
-  }
   static const f32 g_i16MaxInv = 1.0f / i16_max;
   // Assumes the host system is using little-endian byte-order and 2's complement integers.
   i16*      data        = chunk->data.ptr;
@@ -271,6 +273,24 @@ void asset_load_sound_wav(
     asset_mark_load_failure(world, entity, id, wav_error_str(err), (i32)err);
     goto End;
   }
+  if (format.sampleDepth != 16) {
+    err = WavError_SampleDepthUnsupported;
+    asset_mark_load_failure(world, entity, id, wav_error_str(err), (i32)err);
+    goto End;
+  }
+  const usize decodedSize = sizeof(f32) * frameCount * format.channels;
+  if (decodedSize >= wav_stream_threshold) {
+    /**
+     * Big sound: create a streamed sound (frames decoded on demand) instead of decoding up-front.
+     * NOTE: Not cached; the source itself is the stream's backing and decoding frames is cheap.
+     */
+    const WavChunk* dataChunk = wav_chunk(&chunks, string_lit("data"));
+    asset_sound_stream_create(
+        world, entity, (u8)format.channels, frameCount, format.frameRate, dataChunk->data.ptr, src);
+    asset_mark_load_success(world, entity);
+    src = null; // Moved into the stream component, which will take ownership.
+    goto End;
+  }
   sampleMem = alloc_alloc(g_allocHeap, sizeof(f32) * frameCount * format.channels, alignof(f32));
   wav_read_samples(format, &chunks, frameCount, sampleMem.ptr, &err);
   if (err) {
@@ -284,5 +304,7 @@ void asset_load_sound_wav(
 End:
   dynarray_destroy(&chunks);
   alloc_maybe_free(g_allocHeap, sampleMem);
-  asset_repo_close(src);
+  if (src) {
+    asset_repo_close(src);
+  }
 }
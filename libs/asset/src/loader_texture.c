@@ -12,6 +12,9 @@
 #include "ecs/utils.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
 
 #include "import.h"
 #include "loader_texture.h"
@@ -394,6 +397,199 @@ static usize tex_bc_encode_block(const Bc0Block* b, const AssetTextureFormat fmt
   }
 }
 
+/**
+ * Block-compression is fanned out over the job system in bands of block rows (4 pixel rows each);
+ * bands below this size are not worth the scheduling overhead and are encoded serially.
+ */
+#define tex_compress_band_rows_min 16
+
+/**
+ * Maximum number of bands a mip layer is split into.
+ */
+#define tex_compress_bands_max 64
+
+typedef struct {
+  const u8* restrict inPtr;  // First source pixel of the band.
+  u8* restrict       outPtr; // Encode destination for the band.
+  Bc0Block*          blocks; // Optional: extracted blocks of the band (for mip generation).
+  u32                width;  // Width of the mip in pixels.
+  u32                inChannels;
+  u32                blockRows; // Amount of block rows (of 4 pixel rows each) in the band.
+  AssetTextureFormat format;
+} TexEncodeBand;
+
+typedef struct {
+  const Bc0Block* restrict srcBlocks; // Blocks of the previous mip (for the whole layer).
+  Bc0Block* restrict       dstBlocks; // Down-sampled blocks of this mip (for the whole layer).
+  u8* restrict             outPtr;    // Encode destination for the band.
+  u32                      blockCountX;
+  u32                      blockYBegin, blockYEnd;
+  AssetTextureFormat       format;
+} TexDownsampleBand;
+
+/**
+ * Extract 4x4 pixel blocks from the source data and encode them, one band of block rows.
+ */
+static void tex_encode_band(const TexEncodeBand* band) {
+  const u8* restrict inPtr    = band->inPtr;
+  u8* restrict       outPtr   = band->outPtr;
+  Bc0Block*          blockPtr = band->blocks;
+
+  for (u32 row = 0; row != band->blockRows; ++row, inPtr += band->width * 4 * band->inChannels) {
+    for (u32 x = 0; x < band->width; x += 4) {
+      Bc0Block block;
+      bc0_extract(inPtr + x * band->inChannels, band->inChannels, band->width, &block);
+      if (blockPtr) {
+        *blockPtr++ = block;
+      }
+      outPtr += tex_bc_encode_block(&block, band->format, outPtr);
+    }
+  }
+}
+
+/**
+ * Down-sample blocks of the previous mip into new 4x4 blocks and encode them, one band of rows.
+ */
+static void tex_downsample_band(const TexDownsampleBand* band) {
+  u8* restrict outPtr = band->outPtr;
+  for (u32 blockY = band->blockYBegin; blockY != band->blockYEnd; ++blockY) {
+    for (u32 blockX = 0; blockX != band->blockCountX; ++blockX) {
+      Bc0Block block;
+      // Fill the 4x4 block by down-sampling from 4 blocks of the previous mip.
+      for (u32 y = 0; y != 4; ++y) {
+        for (u32 x = 0; x != 4; ++x) {
+          const u32       srcBlockY = blockY * 2 + (y >= 2);
+          const u32       srcBlockX = blockX * 2 + (x >= 2);
+          const Bc0Block* src  = &band->srcBlocks[srcBlockY * band->blockCountX * 2 + srcBlockX];
+          const u32       srcX = (x % 2) * 2;
+          const u32       srcY = (y % 2) * 2;
+
+          const BcColor8888 c0 = src->colors[srcY * 4 + srcX];
+          const BcColor8888 c1 = src->colors[srcY * 4 + srcX + 1];
+          const BcColor8888 c2 = src->colors[(srcY + 1) * 4 + srcX];
+          const BcColor8888 c3 = src->colors[(srcY + 1) * 4 + srcX + 1];
+
+          block.colors[y * 4 + x] = tex_bc0_color_avg(c0, c1, c2, c3);
+        }
+      }
+      // Save the down-sampled block for use in the next mip.
+      band->dstBlocks[blockY * band->blockCountX + blockX] = block;
+      // Encode and output this block.
+      outPtr += tex_bc_encode_block(&block, band->format, outPtr);
+    }
+  }
+}
+
+static void tex_task_encode_band(const void* context) {
+  tex_encode_band(*(const TexEncodeBand* const*)context);
+}
+
+static void tex_task_downsample_band(const void* context) {
+  tex_downsample_band(*(const TexDownsampleBand* const*)context);
+}
+
+/**
+ * Compute over how many parallel bands to split the encoding of 'blockCountY' block rows.
+ */
+static u32 tex_compress_band_count(const u32 blockCountY) {
+  if (!g_jobsIsWorker) {
+    return 1; // Not called from the job system (for example a tool); encode serially.
+  }
+  u32 bands = math_min((u32)g_jobsWorkerCount, tex_compress_bands_max);
+  bands     = math_min(bands, blockCountY / tex_compress_band_rows_min);
+  return math_max(bands, 1);
+}
+
+static bool tex_compress_job_finished(const void* context) {
+  return jobs_scheduler_is_finished(*(const JobId*)context);
+}
+
+/**
+ * Run the given graph of encode tasks and help out with the work while waiting.
+ * NOTE: Loaders execute inside ecs systems (so mid-task); waiting is done through the nested
+ * 'jobs_wait_help()' instead of 'jobs_scheduler_wait_help()'.
+ */
+static void tex_compress_run(JobGraph* graph) {
+  const JobId job = jobs_scheduler_run(graph, g_allocHeap);
+  jobs_wait_help(tex_compress_job_finished, &job);
+  jobs_graph_destroy(graph);
+}
+
+/**
+ * Encode a single mip layer, fanning bands of block rows out over the job system when big enough.
+ */
+static void tex_compress_encode_mip(const TexEncodeBand* whole, const u32 blockCountX) {
+  const u32 bandCount = tex_compress_band_count(whole->blockRows);
+  if (bandCount == 1) {
+    tex_encode_band(whole);
+    return;
+  }
+  const u32   rowsPerBand = whole->blockRows / bandCount;
+  const usize inRowSize   = whole->width * 4 * whole->inChannels;
+  const usize outRowSize  = blockCountX * tex_format_stride(whole->format);
+
+  // NOTE: Bands live on our stack; tasks only receive a pointer as the task context is limited.
+  TexEncodeBand bands[tex_compress_bands_max];
+  JobGraph* graph = jobs_graph_create(g_allocHeap, string_lit("TexEncode"), bandCount);
+  for (u32 i = 0; i != bandCount; ++i) {
+    const u32 rowBegin = i * rowsPerBand;
+    const u32 rowEnd   = (i == bandCount - 1) ? whole->blockRows : rowBegin + rowsPerBand;
+
+    bands[i] = (TexEncodeBand){
+        .inPtr      = whole->inPtr + rowBegin * inRowSize,
+        .outPtr     = whole->outPtr + rowBegin * outRowSize,
+        .blocks     = whole->blocks ? whole->blocks + rowBegin * blockCountX : null,
+        .width      = whole->width,
+        .inChannels = whole->inChannels,
+        .blockRows  = rowEnd - rowBegin,
+        .format     = whole->format,
+    };
+    const TexEncodeBand* bandPtr = &bands[i];
+    jobs_graph_add_task(
+        graph, string_lit("TexEncodeBand"), tex_task_encode_band, mem_var(bandPtr),
+        JobTaskFlags_None);
+  }
+  tex_compress_run(graph);
+}
+
+/**
+ * Down-sample and encode a single mip layer, fanning bands of block rows out over the job system
+ * when big enough.
+ */
+static void tex_compress_downsample_mip(const TexDownsampleBand* whole) {
+  const u32 blockCountY = whole->blockYEnd - whole->blockYBegin;
+  const u32 bandCount   = tex_compress_band_count(blockCountY);
+  if (bandCount == 1) {
+    tex_downsample_band(whole);
+    return;
+  }
+  const u32   rowsPerBand = blockCountY / bandCount;
+  const usize outRowSize  = whole->blockCountX * tex_format_stride(whole->format);
+
+  // NOTE: Bands live on our stack; tasks only receive a pointer as the task context is limited.
+  TexDownsampleBand bands[tex_compress_bands_max];
+  JobGraph* graph = jobs_graph_create(g_allocHeap, string_lit("TexDownsample"), bandCount);
+  for (u32 i = 0; i != bandCount; ++i) {
+    const u32 rowBegin = i * rowsPerBand;
+    const u32 rowEnd   = (i == bandCount - 1) ? blockCountY : rowBegin + rowsPerBand;
+
+    bands[i] = (TexDownsampleBand){
+        .srcBlocks   = whole->srcBlocks,
+        .dstBlocks   = whole->dstBlocks,
+        .outPtr      = whole->outPtr + rowBegin * outRowSize,
+        .blockCountX = whole->blockCountX,
+        .blockYBegin = rowBegin,
+        .blockYEnd   = rowEnd,
+        .format      = whole->format,
+    };
+    const TexDownsampleBand* bandPtr = &bands[i];
+    jobs_graph_add_task(
+        graph, string_lit("TexDownsampleBand"), tex_task_downsample_band, mem_var(bandPtr),
+        JobTaskFlags_None);
+  }
+  tex_compress_run(graph);
+}
+
 /**
  * The following load utils use the same to RGBA conversion rules as the Vulkan spec:
  * https://registry.khronos.org/vulkan/specs/1.0/html/chap16.html#textures-conversion-to-rgba
@@ -460,17 +656,24 @@ static void tex_load_u8_compress(
 
   u8* restrict outPtr = tex->pixelData.ptr;
 
-  Bc0Block block;
   for (u32 mip = 0; mip != inMips; ++mip) {
-    const u32 mipWidth  = math_max(tex->width >> mip, 1);
-    const u32 mipHeight = math_max(tex->height >> mip, 1);
+    const u32 mipWidth    = math_max(tex->width >> mip, 1);
+    const u32 mipHeight   = math_max(tex->height >> mip, 1);
+    const u32 blockCountX = math_max(mipWidth / 4, 1);
+    const u32 blockCountY = math_max(mipHeight / 4, 1);
     for (u32 l = 0; l != inLayers; ++l) {
-      for (u32 y = 0; y < mipHeight; y += 4, inPtr += mipWidth * 4 * inChannels) {
-        for (u32 x = 0; x < mipWidth; x += 4) {
-          bc0_extract(inPtr + x * inChannels, inChannels, mipWidth, &block);
-          outPtr += tex_bc_encode_block(&block, tex->format, outPtr);
-        }
-      }
+      tex_compress_encode_mip(
+          &(TexEncodeBand){
+              .inPtr      = inPtr,
+              .outPtr     = outPtr,
+              .width      = mipWidth,
+              .inChannels = inChannels,
+              .blockRows  = blockCountY,
+              .format     = tex->format,
+          },
+          blockCountX);
+      inPtr += blockCountY * mipWidth * 4 * inChannels;
+      outPtr += blockCountY * blockCountX * tex_format_stride(tex->format);
     }
   }
   diag_assert(mem_from_to(in.ptr, inPtr).size == in.size);
@@ -500,54 +703,60 @@ static void tex_load_u8_compress_gen_mips(
   const usize blockBufferSize = inLayers * layerBlockCount * sizeof(Bc0Block);
   const Mem   blockBuffer     = alloc_alloc(g_allocHeap, blockBufferSize, alignof(Bc0Block));
 
-  Bc0Block* blockPtr = blockBuffer.ptr;
+  /**
+   * Bands of a mip are down-sampled in parallel and cannot compact the blocks in-place (a band
+   * would overwrite blocks that another band still reads); instead they write to a scratch buffer
+   * which is copied back to the block buffer after each mip.
+   */
+  const Mem blockBufferTmp = alloc_alloc(g_allocHeap, blockBufferSize, alignof(Bc0Block));
 
   // Extract 4x4 blocks from the source data and encode mip0.
-  for (u32 l = 0; l != inLayers; ++l) {
-    for (u32 y = 0; y < tex->height; y += 4, inPtr += tex->width * 4 * inChannels) {
-      for (u32 x = 0; x < tex->width; x += 4, ++blockPtr) {
-        bc0_extract(inPtr + x * inChannels, inChannels, tex->width, blockPtr);
-        outPtr += tex_bc_encode_block(blockPtr, tex->format, outPtr);
-      }
+  {
+    const u32 blockCountX = tex->width / 4;
+    const u32 blockCountY = tex->height / 4;
+    for (u32 l = 0; l != inLayers; ++l) {
+      tex_compress_encode_mip(
+          &(TexEncodeBand){
+              .inPtr      = inPtr,
+              .outPtr     = outPtr,
+              .blocks     = (Bc0Block*)blockBuffer.ptr + l * layerBlockCount,
+              .width      = tex->width,
+              .inChannels = inChannels,
+              .blockRows  = blockCountY,
+              .format     = tex->format,
+          },
+          blockCountX);
+      inPtr += tex->height * tex->width * inChannels;
+      outPtr += blockCountY * blockCountX * tex_format_stride(tex->format);
     }
   }
 
   // Down-sample and encode the other mips.
   for (u32 mip = 1; mip < tex->mipsMax; ++mip) {
-    blockPtr              = blockBuffer.ptr; // Reset the block pointer to the beginning.
     const u32 blockCountX = math_max((tex->width >> mip) / 4, 1);
     const u32 blockCountY = math_max((tex->height >> mip) / 4, 1);
     for (u32 l = 0; l != inLayers; ++l) {
-      for (u32 blockY = 0; blockY != blockCountY; ++blockY) {
-        for (u32 blockX = 0; blockX != blockCountX; ++blockX) {
-          Bc0Block block;
-          // Fill the 4x4 block by down-sampling from 4 blocks of the previous mip.
-          for (u32 y = 0; y != 4; ++y) {
-            for (u32 x = 0; x != 4; ++x) {
-              const u32       srcBlockY = blockY * 2 + (y >= 2);
-              const u32       srcBlockX = blockX * 2 + (x >= 2);
-              const Bc0Block* src       = &blockPtr[srcBlockY * blockCountX * 2 + srcBlockX];
-              const u32       srcX      = (x % 2) * 2;
-              const u32       srcY      = (y % 2) * 2;
-
-              const BcColor8888 c0 = src->colors[srcY * 4 + srcX];
-              const BcColor8888 c1 = src->colors[srcY * 4 + srcX + 1];
-              const BcColor8888 c2 = src->colors[(srcY + 1) * 4 + srcX];
-              const BcColor8888 c3 = src->colors[(srcY + 1) * 4 + srcX + 1];
-
-              block.colors[y * 4 + x] = tex_bc0_color_avg(c0, c1, c2, c3);
-            }
-          }
-          // Save the down-sampled block for use in the next mip.
-          blockPtr[blockY * blockCountX + blockX] = block;
-          // Encode and output this block.
-          outPtr += tex_bc_encode_block(&block, tex->format, outPtr);
-        }
-      }
-      blockPtr += layerBlockCount;
+      tex_compress_downsample_mip(&(TexDownsampleBand){
+          .srcBlocks   = (const Bc0Block*)blockBuffer.ptr + l * layerBlockCount,
+          .dstBlocks   = (Bc0Block*)blockBufferTmp.ptr + l * layerBlockCount,
+          .outPtr      = outPtr,
+          .blockCountX = blockCountX,
+          .blockYBegin = 0,
+          .blockYEnd   = blockCountY,
+          .format      = tex->format,
+      });
+      outPtr += blockCountY * blockCountX * tex_format_stride(tex->format);
+    }
+    // Copy the down-sampled blocks back for use in the next mip.
+    for (u32 l = 0; l != inLayers; ++l) {
+      const usize mipBlocksSize = blockCountX * blockCountY * sizeof(Bc0Block);
+      mem_cpy(
+          mem_create((Bc0Block*)blockBuffer.ptr + l * layerBlockCount, mipBlocksSize),
+          mem_create((Bc0Block*)blockBufferTmp.ptr + l * layerBlockCount, mipBlocksSize));
     }
   }
 
+  alloc_free(g_allocHeap, blockBufferTmp);
   alloc_free(g_allocHeap, blockBuffer);
   diag_assert(mem_from_to(in.ptr, inPtr).size == in.size);
 }
@@ -749,6 +958,15 @@ String asset_texture_format_str(const AssetTextureFormat format) {
 
 Mem asset_texture_data(const AssetTextureComp* t) { return data_mem(t->pixelData); }
 
+Mem asset_texture_data_mip(const AssetTextureComp* t, const u32 mipLevel) {
+  diag_assert(mipLevel < t->mipsData);
+  usize offset = 0;
+  for (u32 mip = 0; mip != mipLevel; ++mip) {
+    offset += tex_format_mip_size(t->format, t->width, t->height, t->layers, mip);
+  }
+  return mem_consume(asset_texture_data(t), offset);
+}
+
 GeoColor asset_texture_at(const AssetTextureComp* t, const u32 layer, const usize index) {
   const usize offsetMip0 = tex_format_mip_size(t->format, t->width, t->height, layer, 0);
   const void* pixelsMip0 = bits_ptr_offset(t->pixelData.ptr, offsetMip0);
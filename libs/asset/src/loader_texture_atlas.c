@@ -3,6 +3,7 @@
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
+#include "core/math.h"
 #include "core/search.h"
 #include "core/sort.h"
 #include "core/stringtable.h"
@@ -13,6 +14,9 @@
 #include "ecs/utils.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
 
 #include "import.h"
 #include "loader_texture.h"
@@ -20,6 +24,7 @@
 #include "repo.h"
 
 #define atlas_max_size (1024 * 16)
+#define atlas_batch_size 128
 
 typedef struct {
   String name;
@@ -109,15 +114,6 @@ static AssetTextureFlags atlas_texture_flags(const AtlasDef* def) {
   return flags;
 }
 
-static void atlas_color_to_b4(const GeoColor color, u8 out[PARAM_ARRAY_SIZE(4)]) {
-  static const f32 g_u8MaxPlusOneRoundDown = 255.999f;
-
-  out[0] = (u8)(color.r * g_u8MaxPlusOneRoundDown);
-  out[1] = (u8)(color.g * g_u8MaxPlusOneRoundDown);
-  out[2] = (u8)(color.b * g_u8MaxPlusOneRoundDown);
-  out[3] = (u8)(color.a * g_u8MaxPlusOneRoundDown);
-}
-
 static f32 atlas_clamp01(const f32 val) {
   if (val < 0.0f) {
     return 0.0f;
@@ -145,26 +141,72 @@ static void atlas_generate_entry(
   diag_assert(texY + sizeWithPadding <= def->size);
   diag_assert(texX + sizeWithPadding <= def->size);
 
+  // Sample, convert and pack a batch of pixels at a time to utilize the batched color kernels.
+  GeoColor batch[atlas_batch_size];
   for (u32 entryPixelY = 0; entryPixelY != sizeWithPadding; ++entryPixelY) {
-    const f32 yNorm = atlas_clamp01((entryPixelY - padding + 0.5f) * sizeWithoutPaddingInv);
-    for (u32 entryPixelX = 0; entryPixelX != sizeWithPadding; ++entryPixelX) {
-      const f32 xNorm = atlas_clamp01((entryPixelX - padding + 0.5f) * sizeWithoutPaddingInv);
-
-      GeoColor color;
-      if (def->nearest) {
-        color = asset_texture_sample_nearest(texture, xNorm, yNorm, 0 /* layer */);
-      } else {
-        color = asset_texture_sample(texture, xNorm, yNorm, 0 /* layer */);
+    const f32 yNorm  = atlas_clamp01((entryPixelY - padding + 0.5f) * sizeWithoutPaddingInv);
+    u8*       outRow = &out[((usize)texY + entryPixelY) * def->size * 4 + (usize)texX * 4];
+    for (u32 entryPixelX = 0; entryPixelX != sizeWithPadding;) {
+      const u32 batchCount = math_min(sizeWithPadding - entryPixelX, atlas_batch_size);
+      for (u32 i = 0; i != batchCount; ++i, ++entryPixelX) {
+        const f32 xNorm = atlas_clamp01((entryPixelX - padding + 0.5f) * sizeWithoutPaddingInv);
+        if (def->nearest) {
+          batch[i] = asset_texture_sample_nearest(texture, xNorm, yNorm, 0 /* layer */);
+        } else {
+          batch[i] = asset_texture_sample(texture, xNorm, yNorm, 0 /* layer */);
+        }
       }
       if (def->srgb) {
-        color = geo_color_linear_to_srgb(color);
+        geo_color_linear_to_srgb_batch(batch, batchCount);
       }
+      geo_color_pack_u8_batch(batch, batchCount, outRow);
+      outRow += batchCount * 4;
+    }
+  }
+}
+
+typedef struct {
+  const AtlasDef*         def;
+  const AssetTextureComp* texture;
+  u8*                     out;
+  u32                     index;
+} AtlasEntryTask;
+
+static void atlas_task_generate_entry(const void* context) {
+  const AtlasEntryTask* task = context;
+  atlas_generate_entry(task->def, task->texture, task->index, task->out);
+}
 
-      const usize outTexPixelY = texY + entryPixelY;
-      const usize outTexPixelX = texX + entryPixelX;
-      atlas_color_to_b4(color, &out[outTexPixelY * def->size * 4 + outTexPixelX * 4]);
+static bool atlas_job_finished(const void* context) {
+  return jobs_scheduler_is_finished(*(const JobId*)context);
+}
+
+/**
+ * Render all the entries into the output pixels.
+ * Each entry samples its source texture into a disjoint rect of the output, so entries can be
+ * rasterized in parallel over the job system.
+ */
+static void atlas_generate_entries(
+    const AtlasDef* def, const AssetTextureComp** textures, const u32 entryCount, u8* out) {
+  if (!g_jobsIsWorker || g_jobsWorkerCount <= 1 || entryCount == 1) {
+    for (u32 i = 0; i != entryCount; ++i) {
+      atlas_generate_entry(def, textures[i], i, out);
     }
+    return;
+  }
+  JobGraph* graph = jobs_graph_create(g_allocHeap, string_lit("AtlasGen"), entryCount);
+  for (u32 i = 0; i != entryCount; ++i) {
+    jobs_graph_add_task(
+        graph,
+        string_lit("AtlasGenEntry"),
+        atlas_task_generate_entry,
+        mem_struct(AtlasEntryTask, .def = def, .texture = textures[i], .out = out, .index = i),
+        JobTaskFlags_None);
   }
+  // NOTE: Loads execute inside ecs systems (so mid-task); wait with the nested helper.
+  const JobId job = jobs_scheduler_run(graph, g_allocHeap);
+  jobs_wait_help(atlas_job_finished, &job);
+  jobs_graph_destroy(graph);
 }
 
 static void atlas_generate(
@@ -190,9 +232,9 @@ static void atlas_generate(
   AssetAtlasEntry* entries    = alloc_array_t(g_allocHeap, AssetAtlasEntry, entryCount);
 
   // Render entries into the pixels.
-  u8* pixels = pixelMem.ptr;
+  atlas_generate_entries(def, textures, entryCount, pixelMem.ptr);
+
   for (u32 i = 0; i != entryCount; ++i) {
-    atlas_generate_entry(def, textures[i], i, pixels);
     entries[i] = (AssetAtlasEntry){
         .name       = stringtable_add(g_stringtable, def->entries.values[i].name),
         .atlasIndex = i,
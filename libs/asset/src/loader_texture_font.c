@@ -4,6 +4,7 @@
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
+#include "core/format.h"
 #include "core/math.h"
 #include "core/utf8.h"
 #include "data/read.h"
@@ -12,6 +13,9 @@
 #include "ecs/utils.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
 
 #include "import.h"
 #include "loader_texture.h"
@@ -53,8 +57,20 @@ typedef struct {
   AssetTextureComp texture;
 } FontTexBundle;
 
+/**
+ * Persistent cache of rasterized glyph sdf tiles, keyed on the source font (content and
+ * rasterization parameters). Avoids re-rasterizing glyphs when a fonttex definition changes (for
+ * example when characters for a new locale are added).
+ */
+typedef struct {
+  u32 glyphSize;
+  HeapArray_t(u32) glyphs; // Indices (in the source font) of the cached glyphs, same order as tiles.
+  HeapArray_t(u8)  pixels; // One 'glyphSize * glyphSize' sdf tile per cached glyph.
+} FontTexGlyphCache;
+
 DataMeta g_assetFontTexBundleMeta;
 DataMeta g_assetFontTexDefMeta;
+DataMeta g_assetFontTexGlyphCacheMeta;
 DataMeta g_assetFontTexMeta;
 
 ecs_comp_define(AssetFontTexComp);
@@ -155,18 +171,11 @@ static u32 fonttex_lookup_chars(
   return index;
 }
 
-static void fonttex_generate_glyph(
+static void fonttex_raster_glyph(
     const FontTexDef*     def,
     const AssetFontComp*  font,
     const AssetFontGlyph* glyph,
-    const u32             index,
-    u8*                   out) {
-
-  const u32 texY = index * def->glyphSize / def->size * def->glyphSize;
-  const u32 texX = index * def->glyphSize % def->size;
-
-  diag_assert(texY + def->glyphSize <= def->size);
-  diag_assert(texX + def->glyphSize <= def->size);
+    u8*                   outTile) {
 
   const u32 glyphSize    = def->glyphSize;
   const f32 invGlyphSize = 1.0f / glyphSize;
@@ -184,15 +193,116 @@ static void fonttex_generate_glyph(
       const f32 borderFrac = math_clamp_f32(dist * invBorder, -1.0f, 1.0f);
       const u8  value      = (u8)((borderFrac * 0.5f + 0.5f) * 255.999f);
 
-      const usize texPixelY                  = texY + glyphPixelY;
-      const usize texPixelX                  = texX + glyphPixelX;
-      out[texPixelY * def->size + texPixelX] = value;
+      outTile[glyphPixelY * glyphSize + glyphPixelX] = value;
     }
   }
 }
 
+typedef struct {
+  const FontTexDef*     def;
+  const AssetFontComp*  font;
+  const AssetFontGlyph* glyph;
+  u8*                   outTile;
+} FontTexRasterTask;
+
+static void fonttex_task_raster_glyph(const void* context) {
+  const FontTexRasterTask* task = *(const FontTexRasterTask* const*)context;
+  fonttex_raster_glyph(task->def, task->font, task->glyph, task->outTile);
+}
+
+static bool fonttex_raster_job_finished(const void* context) {
+  return jobs_scheduler_is_finished(*(const JobId*)context);
+}
+
+/**
+ * Rasterize the given glyphs (sdf distance evaluation per pixel), fanning one task per glyph out
+ * over the job system when called from a job worker.
+ * NOTE: Loaders execute inside ecs systems (so mid-task); waiting is done through the nested
+ * 'jobs_wait_help()' instead of 'jobs_scheduler_wait_help()'.
+ */
+static void fonttex_raster_glyphs(
+    const FontTexDef*    def,
+    const AssetFontComp* font,
+    const DynArray*      glyphs, // u32[], indices in the source font.
+    DynArray*            pixels  /* u8[], one tile per glyph */) {
+
+  const u32 count    = (u32)glyphs->size;
+  const u32 tileSize = def->glyphSize * def->glyphSize;
+
+  if (count <= 1 || !g_jobsIsWorker) {
+    // Too little work to parallelize (or not called from the job system); rasterize serially.
+    for (u32 i = 0; i != count; ++i) {
+      const u32 fontGlyphIndex = *dynarray_at_t(glyphs, i, u32);
+      u8*       outTile        = dynarray_at(pixels, i * tileSize, tileSize).ptr;
+      fonttex_raster_glyph(def, font, &font->glyphs.values[fontGlyphIndex], outTile);
+    }
+    return;
+  }
+
+  FontTexRasterTask* tasks = alloc_array_t(g_allocHeap, FontTexRasterTask, count);
+  JobGraph*          graph = jobs_graph_create(g_allocHeap, string_lit("FontTexRaster"), count);
+  for (u32 i = 0; i != count; ++i) {
+    const u32 fontGlyphIndex = *dynarray_at_t(glyphs, i, u32);
+
+    tasks[i] = (FontTexRasterTask){
+        .def     = def,
+        .font    = font,
+        .glyph   = &font->glyphs.values[fontGlyphIndex],
+        .outTile = dynarray_at(pixels, i * tileSize, tileSize).ptr,
+    };
+    const FontTexRasterTask* taskPtr = &tasks[i];
+    jobs_graph_add_task(
+        graph, string_lit("FontTexRasterGlyph"), fonttex_task_raster_glyph, mem_var(taskPtr),
+        JobTaskFlags_None);
+  }
+  const JobId job = jobs_scheduler_run(graph, g_allocHeap);
+  jobs_wait_help(fonttex_raster_job_finished, &job);
+  jobs_graph_destroy(graph);
+  alloc_free_array_t(g_allocHeap, tasks, count);
+}
+
+static void fonttex_blit_glyph(const FontTexDef* def, const u8* tile, const u32 index, u8* out) {
+  const u32 texY = index * def->glyphSize / def->size * def->glyphSize;
+  const u32 texX = index * def->glyphSize % def->size;
+
+  diag_assert(texY + def->glyphSize <= def->size);
+  diag_assert(texX + def->glyphSize <= def->size);
+
+  for (u32 y = 0; y != def->glyphSize; ++y) {
+    mem_cpy(
+        mem_create(out + (texY + y) * def->size + texX, def->glyphSize),
+        mem_create(tile + y * def->glyphSize, def->glyphSize));
+  }
+}
+
+/**
+ * Find a rasterized tile for the given glyph, either from the loaded cache or from the tiles that
+ * were rasterized during this generation. Returns null when the glyph has not been rasterized yet.
+ */
+static const u8* fonttex_cache_tile_find(
+    const FontTexGlyphCache* cache,
+    DynArray*                newGlyphs, // u32[]
+    DynArray*                newPixels, // u8[]
+    const u32                tileSize,
+    const u32                fontGlyphIndex) {
+  for (usize i = 0; i != cache->glyphs.count; ++i) {
+    if (cache->glyphs.values[i] == fontGlyphIndex) {
+      return cache->pixels.values + i * tileSize;
+    }
+  }
+  for (usize i = 0; i != newGlyphs->size; ++i) {
+    if (*dynarray_at_t(newGlyphs, i, u32) == fontGlyphIndex) {
+      return dynarray_at(newPixels, i * tileSize, tileSize).ptr;
+    }
+  }
+  return null;
+}
+
 typedef struct {
   const AssetFontComp* data;
+  String               id;
+  TimeReal             modTime;  // Source modification time of the font.
+  u32                  checksum; // Source checksum of the font.
   u8                   variation;
   f32                  yOffset;
   f32                  spacing;
@@ -201,6 +311,7 @@ typedef struct {
 
 static void fonttex_generate_font(
     const FontTexDef*            def,
+    const AssetManagerComp*      manager,
     const FontTexDefResolvedFont font,
     const FontTexGenFlags        flags,
     u32                          maxGlyphs,
@@ -215,6 +326,37 @@ static void fonttex_generate_font(
     return;
   }
 
+  /**
+   * Lookup previously rasterized glyph tiles for this font; the key hash covers all rasterization
+   * inputs so a changed font results in a cache miss.
+   */
+  const u32    tileSize = def->glyphSize * def->glyphSize;
+  const String cacheId  = fmt_write_scratch(
+      "{}|glyphs|{}-{}", fmt_text(font.id), fmt_int(def->glyphSize), fmt_int(def->border));
+  const u32 cacheKeyParts[] = {
+      (u32)font.modTime,
+      (u32)((u64)font.modTime >> 32),
+      font.checksum,
+      def->glyphSize,
+      def->border,
+  };
+  const u32 cacheKey = bits_hash_32(mem_var(cacheKeyParts));
+
+  FontTexGlyphCache cache = {0};
+  bool              cacheLoaded =
+      asset_cache_aux_load(manager, cacheId, cacheKey, g_assetFontTexGlyphCacheMeta, mem_var(cache));
+  if (cacheLoaded &&
+      (cache.glyphSize != def->glyphSize || cache.pixels.count != cache.glyphs.count * tileSize)) {
+    data_destroy(g_dataReg, g_allocHeap, g_assetFontTexGlyphCacheMeta, mem_var(cache));
+    cacheLoaded = false;
+    cache       = (FontTexGlyphCache){0};
+  }
+  DynArray newGlyphs = dynarray_create_t(g_allocHeap, u32, 64); // Glyphs rasterized this run.
+  DynArray newPixels = dynarray_create(g_allocHeap, 1, 1, 64 * tileSize);
+
+  const usize charsBegin = outChars->size;
+
+  // Assign glyph indices and queue glyphs that are not in the cache for rasterization.
   for (u32 i = 0; i != charCount; ++i) {
     *dynarray_push_t(outChars, AssetFontTexChar) = (AssetFontTexChar){
         .cp         = inputChars[i].cp,
@@ -228,11 +370,68 @@ static void fonttex_generate_font(
     if (inputChars[i].glyph->segmentCount) {
       if (UNLIKELY(*nextGlyphIndex >= maxGlyphs || *nextGlyphIndex == u16_max)) {
         *err = FontTexError_TooManyGlyphs;
-        return;
+        goto Ret;
+      }
+      ++*nextGlyphIndex;
+
+      const u32 fontGlyphIndex = (u32)(inputChars[i].glyph - font.data->glyphs.values);
+      if (!fonttex_cache_tile_find(&cache, &newGlyphs, &newPixels, tileSize, fontGlyphIndex)) {
+        // Not rasterized before; reserve a tile for it (rasterized in parallel below).
+        *dynarray_push_t(&newGlyphs, u32) = fontGlyphIndex;
+        dynarray_push(&newPixels, tileSize);
       }
-      fonttex_generate_glyph(def, font.data, inputChars[i].glyph, (*nextGlyphIndex)++, outPixels);
     }
   }
+
+  // Rasterize the queued glyphs; fanned out over the job system.
+  fonttex_raster_glyphs(def, font.data, &newGlyphs, &newPixels);
+
+  // Blit the glyph tiles into the output atlas.
+  for (u32 i = 0; i != charCount; ++i) {
+    if (!inputChars[i].glyph->segmentCount) {
+      continue;
+    }
+    const AssetFontTexChar* ch = dynarray_at_t(outChars, charsBegin + i, AssetFontTexChar);
+    const u32 fontGlyphIndex = (u32)(inputChars[i].glyph - font.data->glyphs.values);
+    const u8* tile =
+        fonttex_cache_tile_find(&cache, &newGlyphs, &newPixels, tileSize, fontGlyphIndex);
+    diag_assert(tile);
+    fonttex_blit_glyph(def, tile, ch->glyphIndex, outPixels);
+  }
+
+  if (newGlyphs.size) {
+    // Store the updated raster cache (the previously cached tiles plus the new ones).
+    const usize totalGlyphs  = cache.glyphs.count + newGlyphs.size;
+    const Mem   mergedGlyphs = alloc_alloc(g_allocHeap, totalGlyphs * sizeof(u32), alignof(u32));
+    const Mem   mergedPixels = alloc_alloc(g_allocHeap, totalGlyphs * tileSize, 1);
+
+    mem_cpy(mergedGlyphs, mem_create(cache.glyphs.values, cache.glyphs.count * sizeof(u32)));
+    mem_cpy(
+        mem_consume(mergedGlyphs, cache.glyphs.count * sizeof(u32)),
+        dynarray_at(&newGlyphs, 0, newGlyphs.size));
+    mem_cpy(mergedPixels, mem_create(cache.pixels.values, cache.pixels.count));
+    mem_cpy(
+        mem_consume(mergedPixels, cache.pixels.count), dynarray_at(&newPixels, 0, newPixels.size));
+
+    const FontTexGlyphCache newCache = {
+        .glyphSize     = def->glyphSize,
+        .glyphs.values = mergedGlyphs.ptr,
+        .glyphs.count  = totalGlyphs,
+        .pixels.values = mergedPixels.ptr,
+        .pixels.count  = totalGlyphs * tileSize,
+    };
+    asset_cache_aux(manager, cacheId, cacheKey, g_assetFontTexGlyphCacheMeta, mem_var(newCache));
+
+    alloc_free(g_allocHeap, mergedGlyphs);
+    alloc_free(g_allocHeap, mergedPixels);
+  }
+
+Ret:
+  if (cacheLoaded) {
+    data_destroy(g_dataReg, g_allocHeap, g_assetFontTexGlyphCacheMeta, mem_var(cache));
+  }
+  dynarray_destroy(&newGlyphs);
+  dynarray_destroy(&newPixels);
 }
 
 static AssetTextureFlags fonttex_output_flags(const FontTexDef* def) {
@@ -245,6 +444,7 @@ static AssetTextureFlags fonttex_output_flags(const FontTexDef* def) {
 
 static void fonttex_generate(
     const FontTexDef*             def,
+    const AssetManagerComp*       manager,
     const FontTexDefResolvedFont* fonts,
     const u32                     fontCount,
     AssetFontTexComp*             outFontTex,
@@ -268,7 +468,8 @@ static void fonttex_generate(
   for (u32 i = 0; i != fontCount; ++i) {
     const FontTexGenFlags genFlags = i == 0 ? FontTexGenFlags_IncludeGlyph0 : 0;
 
-    fonttex_generate_font(def, fonts[i], genFlags, maxGlyphs, &nextGlyphIndex, &chars, pixels, err);
+    fonttex_generate_font(
+        def, manager, fonts[i], genFlags, maxGlyphs, &nextGlyphIndex, &chars, pixels, err);
     if (UNLIKELY(*err)) {
       goto Ret;
     }
@@ -310,7 +511,10 @@ ecs_view_define(LoadView) {
   ecs_access_write(AssetFontTexLoadComp);
 }
 
-ecs_view_define(FontView) { ecs_access_write(AssetFontComp); }
+ecs_view_define(FontView) {
+  ecs_access_read(AssetComp);
+  ecs_access_write(AssetFontComp);
+}
 
 /**
  * Update all active loads.
@@ -350,8 +554,13 @@ ecs_system_define(AssetFontTexLoadSys) {
         err = FontTexError_FontInvalid;
         goto Error;
       }
+      const AssetComp* fontAssetComp = ecs_view_read_t(fontItr, AssetComp);
+
       fonts[i] = (FontTexDefResolvedFont){
           .data       = ecs_view_read_t(fontItr, AssetFontComp),
+          .id         = defFont->id,
+          .modTime    = asset_load_mod_time(fontAssetComp),
+          .checksum   = asset_load_checksum(fontAssetComp),
           .variation  = defFont->variation,
           .yOffset    = defFont->yOffset,
           .spacing    = defFont->spacing,
@@ -360,7 +569,7 @@ ecs_system_define(AssetFontTexLoadSys) {
     }
 
     FontTexBundle bundle;
-    fonttex_generate(&load->def, fonts, fontCount, &bundle.fonttex, &bundle.texture, &err);
+    fonttex_generate(&load->def, manager, fonts, fontCount, &bundle.fonttex, &bundle.texture, &err);
     if (UNLIKELY(err)) {
       goto Error;
     }
@@ -457,11 +666,17 @@ void asset_data_init_fonttex(void) {
   data_reg_struct_t(g_dataReg, FontTexBundle);
   data_reg_field_t(g_dataReg, FontTexBundle, fonttex, t_AssetFontTexComp);
   data_reg_field_t(g_dataReg, FontTexBundle, texture, g_assetTexMeta.type);
+
+  data_reg_struct_t(g_dataReg, FontTexGlyphCache);
+  data_reg_field_t(g_dataReg, FontTexGlyphCache, glyphSize, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, FontTexGlyphCache, glyphs, data_prim_t(u32), .container = DataContainer_HeapArray);
+  data_reg_field_t(g_dataReg, FontTexGlyphCache, pixels, data_prim_t(u8), .container = DataContainer_HeapArray);
   // clang-format on
 
-  g_assetFontTexBundleMeta = data_meta_t(t_FontTexBundle);
-  g_assetFontTexDefMeta    = data_meta_t(t_FontTexDef);
-  g_assetFontTexMeta       = data_meta_t(t_AssetFontTexComp);
+  g_assetFontTexBundleMeta     = data_meta_t(t_FontTexBundle);
+  g_assetFontTexDefMeta        = data_meta_t(t_FontTexDef);
+  g_assetFontTexGlyphCacheMeta = data_meta_t(t_FontTexGlyphCache);
+  g_assetFontTexMeta           = data_meta_t(t_AssetFontTexComp);
 }
 
 void asset_load_tex_font(
@@ -6,7 +6,9 @@
 #include "core/dynstring.h"
 #include "core/path.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
 #include "core/time.h"
+#include "data/read.h"
 #include "data/write.h"
 #include "ecs/entity.h"
 #include "ecs/utils.h"
@@ -51,7 +53,8 @@ ecs_comp_define(AssetManagerComp) {
   AssetRepo*        repo;
   AssetManagerFlags flags;
   TimeDuration      loadingBudget; // Max loading time (per task) for each frame (0 is inf).
-  DynArray          lookup;        // AssetEntry[], kept sorted on the idHash.
+  usize             memBudget[AssetMemCategory_Count]; // Max bytes per category (0 is inf).
+  DynArray          lookup;                            // AssetEntry[], kept sorted on the idHash.
 };
 
 ecs_comp_define(AssetComp) {
@@ -61,11 +64,17 @@ ecs_comp_define(AssetComp) {
   u16         unloadTicks;
   AssetFlags  flags : 8;
   AssetFormat loadFormat : 8; // Source format of the last load (valid if loadCount > 0).
+  u32         loadSize;       // Source size (in bytes) of the last load (valid if loadCount > 0).
   TimeReal    loadModTime;    // Source modification of the last load (valid if loadCount > 0).
   u32         loadChecksum;   // Source checksum of the last load (valid if loadCount > 0).
   u32         loaderHash;     // Hash of the loader at the time of the last load.
+  u32         loadOrder;      // Sequence number of the first load, 'sentinel_u32' if never loaded.
 };
 
+// Global counter for the order in which assets are first loaded, useful for optimizing pack file
+// layouts to match the observed access order.
+static i32 g_assetLoadOrderCounter;
+
 ecs_comp_define(AssetLoadedComp);
 ecs_comp_define(AssetFailedComp) {
   String error;
@@ -73,6 +82,10 @@ ecs_comp_define(AssetFailedComp) {
 };
 ecs_comp_define(AssetChangedComp);
 ecs_comp_define(AssetCacheInitComp);
+ecs_comp_define(AssetPrefetchInitComp);
+ecs_comp_define(AssetPrefetchComp) {
+  DynArray assets; // EcsEntityId[], dependency assets acquired on behalf of this asset.
+};
 ecs_comp_define(AssetDirtyComp) { u32 numAcquire, numRelease; };
 ecs_comp_define(AssetInstantUnloadComp);
 
@@ -210,6 +223,21 @@ static void ecs_combine_asset_ext_load(void* dataA, void* dataB) {
   }
 }
 
+static void ecs_destruct_asset_prefetch(void* data) {
+  AssetPrefetchComp* comp = data;
+  dynarray_destroy(&comp->assets);
+}
+
+static void ecs_combine_asset_prefetch(void* dataA, void* dataB) {
+  AssetPrefetchComp* compA = dataA;
+  AssetPrefetchComp* compB = dataB;
+
+  dynarray_for_t(&compB->assets, EcsEntityId, asset) {
+    *dynarray_push_t(&compA->assets, EcsEntityId) = *asset;
+  }
+  dynarray_destroy(&compB->assets);
+}
+
 static void ecs_destruct_cache_request_comp(void* data) {
   AssetCacheRequestComp* comp = data;
   alloc_free(g_allocHeap, comp->blobMem);
@@ -239,7 +267,7 @@ static EcsEntityId asset_entity_create(EcsWorld* world, StringTable* stringTable
   }
 
   const EcsEntityId entity = ecs_world_entity_create(world);
-  ecs_world_add_t(world, entity, AssetComp, .id = idDup);
+  ecs_world_add_t(world, entity, AssetComp, .id = idDup, .loadOrder = sentinel_u32);
   return entity;
 }
 
@@ -291,9 +319,17 @@ static AssetLoadResult asset_manager_load(
     asset->flags |= AssetFlags_Cached;
     ecs_world_add_empty_t(world, assetEntity, AssetCacheInitComp);
   }
+  if (asset_repo_deps_supported(manager->repo)) {
+    ecs_world_add_empty_t(world, assetEntity, AssetPrefetchInitComp);
+  }
 
   ++asset->loadCount;
+  if (asset->loadCount == 1) {
+    // NOTE: Atomic as loads from multiple assets can start in parallel.
+    asset->loadOrder = (u32)thread_atomic_add_i32(&g_assetLoadOrderCounter, 1);
+  }
   asset->loadFormat   = source->format;
+  asset->loadSize     = (u32)source->data.size;
   asset->loadModTime  = source->modTime;
   asset->loadChecksum = source->checksum;
   asset->loaderHash   = asset_loader_hash(importEnv, asset->id);
@@ -550,6 +586,7 @@ ecs_system_define(AssetLoadExtSys) {
 
     assetComp->loadCount += extLoadComp->count;
     assetComp->loadFormat   = extLoadComp->format;
+    assetComp->loadSize     = 0; // Size is unknown for external loads.
     assetComp->loadChecksum = extLoadComp->checksum;
     assetComp->loadModTime  = extLoadComp->modTime;
 
@@ -560,6 +597,106 @@ ecs_system_define(AssetLoadExtSys) {
   }
 }
 
+static AssetMemCategory asset_mem_category(const AssetFormat format) {
+  switch (format) {
+  case AssetFormat_TexArray:
+  case AssetFormat_TexAtlas:
+  case AssetFormat_TexAtlasBin:
+  case AssetFormat_TexBin:
+  case AssetFormat_TexFont:
+  case AssetFormat_TexFontBin:
+  case AssetFormat_TexHeight16:
+  case AssetFormat_TexHeight32:
+  case AssetFormat_TexPng:
+  case AssetFormat_TexPpm:
+  case AssetFormat_TexProc:
+  case AssetFormat_TexTga:
+    return AssetMemCategory_Texture;
+  case AssetFormat_MeshBin:
+  case AssetFormat_MeshGlb:
+  case AssetFormat_MeshGltf:
+  case AssetFormat_MeshObj:
+  case AssetFormat_MeshProc:
+    return AssetMemCategory_Mesh;
+  case AssetFormat_SoundBin:
+  case AssetFormat_SoundWav:
+    return AssetMemCategory_Sound;
+  default:
+    return AssetMemCategory_Other;
+  }
+}
+
+typedef struct {
+  EcsEntityId      entity;
+  AssetMemCategory category : 8;
+  u16              unloadTicks;
+  u32              size;
+} AssetEvictCandidate;
+
+static i8 asset_compare_evict_candidate(const void* a, const void* b) {
+  // Sort assets that have been unreferenced the longest (least-recently-used) first.
+  const u16 ticksA = ((const AssetEvictCandidate*)a)->unloadTicks;
+  const u16 ticksB = ((const AssetEvictCandidate*)b)->unloadTicks;
+  return ticksA > ticksB ? -1 : ticksA < ticksB ? 1 : 0;
+}
+
+ecs_view_define(LoadedAssetView) {
+  ecs_access_read(AssetComp);
+  ecs_access_with(AssetLoadedComp);
+}
+
+/**
+ * Enforce the per-category memory budgets by unloading unreferenced assets in least-recently-used
+ * order while a category is over budget.
+ */
+ecs_system_define(AssetMemBudgetSys) {
+  const AssetManagerComp* man = asset_manager_readonly(world);
+  if (!man) {
+    return; // Manager not initialized.
+  }
+  bool anyBudget = false;
+  array_for_t(man->memBudget, usize, budget) { anyBudget |= *budget != 0; }
+  if (!anyBudget) {
+    return; // No budgets configured; assets stay resident until explicitly unloaded.
+  }
+
+  usize    usedBytes[AssetMemCategory_Count] = {0};
+  DynArray candidates = dynarray_create_t(g_allocHeap, AssetEvictCandidate, 64);
+
+  EcsView* assetsView = ecs_world_view_t(world, LoadedAssetView);
+  for (EcsIterator* itr = ecs_view_itr(assetsView); ecs_view_walk(itr);) {
+    const AssetComp*       assetComp = ecs_view_read_t(itr, AssetComp);
+    const AssetMemCategory category  = asset_mem_category(assetComp->loadFormat);
+    usedBytes[category] += assetComp->loadSize;
+
+    if (!assetComp->refCount && man->memBudget[category]) {
+      *dynarray_push_t(&candidates, AssetEvictCandidate) = (AssetEvictCandidate){
+          .entity      = ecs_view_entity(itr),
+          .category    = category,
+          .unloadTicks = assetComp->unloadTicks,
+          .size        = assetComp->loadSize,
+      };
+    }
+  }
+
+  dynarray_sort(&candidates, asset_compare_evict_candidate);
+  dynarray_for_t(&candidates, AssetEvictCandidate, cand) {
+    if (usedBytes[cand->category] <= man->memBudget[cand->category]) {
+      continue; // Category is within budget.
+    }
+    usedBytes[cand->category] -= cand->size;
+    ecs_utils_maybe_add_t(world, cand->entity, AssetInstantUnloadComp);
+    ecs_utils_maybe_add_t(world, cand->entity, AssetDirtyComp);
+#if VOLO_ASSET_LOGGING
+    log_d(
+        "Asset evicted",
+        log_param("entity", ecs_entity_fmt(cand->entity)),
+        log_param("size", fmt_size(cand->size)));
+#endif
+  }
+  dynarray_destroy(&candidates);
+}
+
 ecs_view_define(AssetCacheRequestView) {
   ecs_access_read(AssetComp);
   ecs_access_read(AssetCacheRequestComp);
@@ -665,6 +802,65 @@ ecs_system_define(AssetCacheSys) {
   }
 }
 
+ecs_view_define(AssetPrefetchInitView) {
+  ecs_access_read(AssetComp);
+  ecs_access_with(AssetPrefetchInitComp);
+}
+
+ecs_view_define(AssetPrefetchUnloadView) {
+  ecs_access_read(AssetPrefetchComp);
+  ecs_access_without(AssetLoadedComp);
+  ecs_access_without(AssetFailedComp);
+  ecs_access_without(AssetDirtyComp);
+}
+
+/**
+ * Prefetch the dependencies of assets that started loading, when the repository can enumerate them
+ * (for example pack repositories which store dependency info per entry). The dependencies of the
+ * dependencies are prefetched in turn when their own loads start, expanding the transitive closure
+ * without waiting for any asset to finish loading.
+ */
+ecs_system_define(AssetPrefetchSys) {
+  AssetManagerComp* manager = asset_manager_mutable(world);
+  if (!manager) {
+    return;
+  }
+
+  EcsView* initView   = ecs_world_view_t(world, AssetPrefetchInitView);
+  EcsView* unloadView = ecs_world_view_t(world, AssetPrefetchUnloadView);
+
+  String depIds[asset_repo_deps_max];
+
+  // Acquire the dependencies of assets that started loading.
+  for (EcsIterator* itr = ecs_view_itr(initView); ecs_view_walk(itr);) {
+    const EcsEntityId assetEntity = ecs_view_entity(itr);
+    const AssetComp*  assetComp   = ecs_view_read_t(itr, AssetComp);
+
+    const usize depCount = asset_repo_deps(manager->repo, assetComp->id, depIds);
+    if (depCount) {
+      DynArray depAssets = dynarray_create_t(g_allocHeap, EcsEntityId, depCount);
+      for (usize i = 0; i != depCount; ++i) {
+        const EcsEntityId depEntity = asset_lookup(world, manager, depIds[i]);
+        asset_acquire(world, depEntity);
+        *dynarray_push_t(&depAssets, EcsEntityId) = depEntity;
+      }
+      ecs_world_add_t(world, assetEntity, AssetPrefetchComp, .assets = depAssets);
+    }
+    ecs_world_remove_t(world, assetEntity, AssetPrefetchInitComp);
+  }
+
+  // Release the dependencies of assets that have been unloaded.
+  for (EcsIterator* itr = ecs_view_itr(unloadView); ecs_view_walk(itr);) {
+    const EcsEntityId        assetEntity  = ecs_view_entity(itr);
+    const AssetPrefetchComp* prefetchComp = ecs_view_read_t(itr, AssetPrefetchComp);
+
+    dynarray_for_t(&prefetchComp->assets, EcsEntityId, depAsset) {
+      asset_release(world, *depAsset);
+    }
+    ecs_world_remove_t(world, assetEntity, AssetPrefetchComp);
+  }
+}
+
 ecs_module_init(asset_manager_module) {
   ecs_register_comp(AssetManagerComp, .destructor = ecs_destruct_manager_comp, .destructOrder = 30);
   ecs_register_comp(AssetComp);
@@ -672,6 +868,11 @@ ecs_module_init(asset_manager_module) {
   ecs_register_comp_empty(AssetLoadedComp);
   ecs_register_comp_empty(AssetChangedComp);
   ecs_register_comp_empty(AssetCacheInitComp);
+  ecs_register_comp_empty(AssetPrefetchInitComp);
+  ecs_register_comp(
+      AssetPrefetchComp,
+      .destructor = ecs_destruct_asset_prefetch,
+      .combinator = ecs_combine_asset_prefetch);
   ecs_register_comp_empty(AssetInstantUnloadComp);
   ecs_register_comp(AssetDirtyComp, .combinator = ecs_combine_asset_dirty);
   ecs_register_comp(
@@ -701,12 +902,22 @@ ecs_module_init(asset_manager_module) {
   ecs_register_system(AssetLoadExtSys, ecs_register_view(AssetLoadExtView));
   ecs_order(AssetLoadExtSys, AssetOrder_Update);
 
+  ecs_register_system(
+      AssetMemBudgetSys, ecs_register_view(LoadedAssetView), ecs_view_id(GlobalReadView));
+  ecs_order(AssetMemBudgetSys, AssetOrder_Update + 1);
+
   ecs_register_system(
       AssetCacheSys,
       ecs_register_view(AssetCacheRequestView),
       ecs_register_view(AssetCacheInitView),
       ecs_register_view(AssetDepView),
       ecs_view_id(GlobalWriteView));
+
+  ecs_register_system(
+      AssetPrefetchSys,
+      ecs_register_view(AssetPrefetchInitView),
+      ecs_register_view(AssetPrefetchUnloadView),
+      ecs_view_id(GlobalWriteView));
 }
 
 String     asset_id(const AssetComp* comp) { return comp->id; }
@@ -816,8 +1027,16 @@ void asset_loading_budget_set(AssetManagerComp* manager, const TimeDuration load
   manager->loadingBudget = loadingTimeBudget;
 }
 
+void asset_memory_budget_set(
+    AssetManagerComp* manager, const AssetMemCategory category, const usize maxBytes) {
+  diag_assert(category < AssetMemCategory_Count);
+  manager->memBudget[category] = maxBytes;
+}
+
 u32  asset_ref_count(const AssetComp* asset) { return asset->refCount; }
 u32  asset_load_count(const AssetComp* asset) { return asset->loadCount; }
+u32  asset_load_order(const AssetComp* asset) { return asset->loadOrder; }
+u32  asset_load_size(const AssetComp* asset) { return asset->loadSize; }
 bool asset_is_loading(const AssetComp* asset) { return (asset->flags & AssetFlags_Loading) != 0; }
 bool asset_is_cached(const AssetComp* asset) { return (asset->flags & AssetFlags_Cached) != 0; }
 
@@ -825,6 +1044,9 @@ u32 asset_ticks_until_unload(const AssetComp* asset) {
   return asset_max_unload_delay - asset->unloadTicks;
 }
 
+TimeReal asset_load_mod_time(const AssetComp* asset) { return asset->loadModTime; }
+u32      asset_load_checksum(const AssetComp* asset) { return asset->loadChecksum; }
+
 bool asset_save(AssetManagerComp* manager, const String id, const String data) {
   diag_assert_msg(path_extension(id).size, "Asset id's must have an extension");
   return asset_repo_save(manager->repo, id, data);
@@ -961,3 +1183,41 @@ void asset_cache(
       .blobSize = blobBuffer.size,
       .blobMem  = blobBuffer.data);
 }
+
+void asset_cache_aux(
+    const AssetManagerComp* manager,
+    const String            id,
+    const u32               keyHash,
+    const DataMeta          dataMeta,
+    const Mem               data) {
+  DynString blobBuffer = dynstring_create(g_allocHeap, 256);
+  data_write_bin(g_dataReg, &blobBuffer, dataMeta, data);
+
+  asset_repo_cache_aux(manager->repo, id, keyHash, dynstring_view(&blobBuffer), dataMeta);
+
+  dynstring_destroy(&blobBuffer);
+}
+
+bool asset_cache_aux_load(
+    const AssetManagerComp* manager,
+    const String            id,
+    const u32               keyHash,
+    const DataMeta          dataMeta,
+    const Mem               out) {
+  Mem blob;
+  if (!asset_repo_cache_aux_load(manager->repo, id, keyHash, dataMeta, g_allocHeap, &blob)) {
+    return false;
+  }
+  const DataReadFlags readFlags = DataReadFlags_None;
+  DataReadResult      readRes;
+  data_read_bin(g_dataReg, blob, g_allocHeap, dataMeta, readFlags, out, &readRes);
+  alloc_free(g_allocHeap, blob);
+  if (UNLIKELY(readRes.error)) {
+    log_w(
+        "Failed to read auxiliary cache blob",
+        log_param("id", fmt_text(id)),
+        log_param("error", fmt_text(readRes.errorMsg)));
+    return false;
+  }
+  return true;
+}
@@ -49,3 +49,18 @@ void asset_mark_external_load(
  * The cached data will be used for the next load provided the source asset hasn't changed.
  */
 void asset_cache(EcsWorld*, EcsEntityId asset, DataMeta, Mem data);
+
+/**
+ * Store / load auxiliary cached data, keyed by an explicit hash instead of a source asset.
+ * Useful for caching expensive intermediate results (for example rasterized font glyphs); callers
+ * are responsible for including all inputs (for example source checksums) in the key hash.
+ * Returns true when compatible data was loaded into the given (uninitialized) structure.
+ */
+void asset_cache_aux(const AssetManagerComp*, String id, u32 keyHash, DataMeta, Mem data);
+bool asset_cache_aux_load(const AssetManagerComp*, String id, u32 keyHash, DataMeta, Mem out);
+
+/**
+ * Source information of the last load (valid while the asset is loaded).
+ */
+TimeReal asset_load_mod_time(const AssetComp*);
+u32      asset_load_checksum(const AssetComp*);
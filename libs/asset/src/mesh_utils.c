@@ -1,8 +1,10 @@
+#include "core/array.h"
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/float.h"
 #include "core/math.h"
+#include "core/sentinel.h"
 #include "geo/matrix.h"
 
 #include "mesh_utils.h"
@@ -13,6 +15,8 @@ struct sAssetMeshBuilder {
   DynArray        indexData;  // AssetMeshIndex[]
   AssetMeshIndex* indexTable;
   u32             tableSize, maxVertexCount;
+  u32             lodCount;
+  AssetMeshLod    lods[asset_mesh_lods_max];
   GeoBox          bounds;
   Allocator*      alloc;
 };
@@ -101,7 +105,8 @@ void asset_mesh_builder_clear(AssetMeshBuilder* builder) {
   dynarray_clear(&builder->vertexData);
   dynarray_clear(&builder->skinData);
   dynarray_clear(&builder->indexData);
-  builder->bounds = geo_box_inverted3();
+  builder->lodCount = 0;
+  builder->bounds   = geo_box_inverted3();
 
   // Reset the index table.
   for (u32 i = 0; i != builder->tableSize; ++i) {
@@ -160,8 +165,11 @@ void asset_mesh_builder_set_skin(
 AssetMeshComp asset_mesh_create(const AssetMeshBuilder* builder) {
   diag_assert_msg(builder->indexData.size, "Empty mesh is invalid");
 
-  const u32  vertCount  = (u32)builder->vertexData.size;
-  const u32  indexCount = (u32)builder->indexData.size;
+  const u32 vertCount       = (u32)builder->vertexData.size;
+  const u32 indexCountTotal = (u32)builder->indexData.size;
+
+  // The lod levels are appended after the full-detail indices.
+  const u32  indexCount = builder->lodCount ? builder->lods[0].indexOffset : indexCountTotal;
   const bool isSkinned  = builder->skinData.size != 0;
   diag_assert(!isSkinned || builder->skinData.size == vertCount);
 
@@ -203,17 +211,20 @@ AssetMeshComp asset_mesh_create(const AssetMeshBuilder* builder) {
     }
   }
 
-  const usize indexDataSize = sizeof(AssetMeshIndex) * indexCount;
+  const usize indexDataSize = sizeof(AssetMeshIndex) * indexCountTotal;
   const Mem   indexData     = alloc_alloc(g_allocHeap, indexDataSize, sizeof(AssetMeshIndex));
-  mem_cpy(indexData, dynarray_at(&builder->indexData, 0, indexCount));
+  mem_cpy(indexData, dynarray_at(&builder->indexData, 0, indexCountTotal));
 
-  return (AssetMeshComp){
+  AssetMeshComp result = {
       .vertexCount = vertCount,
       .indexCount  = indexCount,
+      .lodCount    = builder->lodCount,
       .vertexData  = data_mem_create(vertexData),
       .indexData   = data_mem_create(indexData),
       .bounds      = builder->bounds,
   };
+  mem_cpy(mem_var(result.lods), mem_var(builder->lods));
+  return result;
 }
 
 GeoVector asset_mesh_tri_norm(const GeoVector a, const GeoVector b, const GeoVector c) {
@@ -350,3 +361,402 @@ void asset_mesh_compute_tangents(AssetMeshBuilder* builder) {
 
   alloc_free(g_allocHeap, bufferMem);
 }
+
+#define asset_mesh_weld_pos_frac 1e-4f // Position tolerance as a fraction of the bounds size.
+#define asset_mesh_weld_norm_eps 1e-2f
+#define asset_mesh_weld_uv_eps 1e-3f
+
+static u32 asset_mesh_weld_bucket(const i32 x, const i32 y, const i32 z, const u32 tableSize) {
+  const i32 coords[] = {x, y, z};
+  return bits_hash_32(mem_var(coords)) & (tableSize - 1);
+}
+
+static bool asset_mesh_weld_match(
+    const AssetMeshSnapshot* snapshot, const u32 a, const u32 b, const f32 posEps) {
+  const AssetMeshVertex* vA = &snapshot->vertexData[a];
+  const AssetMeshVertex* vB = &snapshot->vertexData[b];
+  if (!geo_vector_equal3(vA->position, vB->position, posEps)) {
+    return false;
+  }
+  if (!geo_vector_equal3(vA->normal, vB->normal, asset_mesh_weld_norm_eps)) {
+    return false;
+  }
+  if (!geo_vector_equal(vA->tangent, vB->tangent, asset_mesh_weld_norm_eps)) {
+    return false;
+  }
+  if (!geo_vector_equal(vA->texcoord, vB->texcoord, asset_mesh_weld_uv_eps)) {
+    return false;
+  }
+  if (snapshot->skinData) {
+    if (!mem_eq(mem_var(snapshot->skinData[a]), mem_var(snapshot->skinData[b]))) {
+      return false; // Never weld vertices with different skinning.
+    }
+  }
+  return true;
+}
+
+void asset_mesh_weld(AssetMeshBuilder* builder) {
+  diag_assert_msg(builder->indexData.size, "Empty mesh is invalid");
+  diag_assert_msg(!builder->lodCount, "Welding has to happen before lod generation");
+
+  /**
+   * Weld vertices that are equal within a small epsilon. The exact-duplicate removal of
+   * 'asset_mesh_builder_push()' misses near-duplicates that art tools commonly export (eg from
+   * accumulated transform error); those are found here with a spatial hash grid: representative
+   * vertices are inserted into their grid cell and every vertex searches the cells overlapping its
+   * epsilon region for a matching representative.
+   */
+
+  const GeoVector boundsSize = geo_box_size(&builder->bounds);
+  const f32       boundsDim  = math_max(boundsSize.x, math_max(boundsSize.y, boundsSize.z));
+  if (boundsDim <= f32_epsilon) {
+    return; // Degenerate bounds.
+  }
+  const f32 posEps      = boundsDim * asset_mesh_weld_pos_frac;
+  const f32 invCellSize = 1.0f / (posEps * 2.0f);
+
+  AssetMeshSnapshot snapshot = asset_mesh_snapshot(builder, g_allocHeap);
+  asset_mesh_builder_clear(builder);
+
+  const u32 vertCount = snapshot.vertexCount;
+  const u32 tableSize = bits_nextpow2(vertCount * 2);
+
+  const Mem tableMem = alloc_alloc(g_allocHeap, tableSize * sizeof(u32), alignof(u32));
+  const Mem nextMem  = alloc_alloc(g_allocHeap, vertCount * sizeof(u32), alignof(u32));
+  const Mem remapMem = alloc_alloc(g_allocHeap, vertCount * sizeof(u32), alignof(u32));
+
+  u32* table = tableMem.ptr; // Head (snapshot) vertex per bucket, chained through 'next'.
+  u32* next  = nextMem.ptr;
+  u32* remap = remapMem.ptr; // Representative (snapshot) vertex per vertex.
+  mem_set(tableMem, 0xFF);
+
+  for (u32 v = 0; v != vertCount; ++v) {
+    const GeoVector pos = snapshot.vertexData[v].position;
+    remap[v]            = v;
+
+    // Search the (up to 8) cells overlapping the epsilon region for a matching representative.
+    const i32 cellMinX = (i32)math_round_down_f32((pos.x - posEps) * invCellSize);
+    const i32 cellMinY = (i32)math_round_down_f32((pos.y - posEps) * invCellSize);
+    const i32 cellMinZ = (i32)math_round_down_f32((pos.z - posEps) * invCellSize);
+    for (i32 z = cellMinZ; z != cellMinZ + 2 && remap[v] == v; ++z) {
+      for (i32 y = cellMinY; y != cellMinY + 2 && remap[v] == v; ++y) {
+        for (i32 x = cellMinX; x != cellMinX + 2 && remap[v] == v; ++x) {
+          const u32 bucket = asset_mesh_weld_bucket(x, y, z, tableSize);
+          for (u32 u = table[bucket]; !sentinel_check(u); u = next[u]) {
+            if (asset_mesh_weld_match(&snapshot, v, u, posEps)) {
+              remap[v] = u;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    if (remap[v] == v) {
+      // No representative found; this vertex becomes one, insert it into its cell.
+      const i32 cellX  = (i32)math_round_down_f32(pos.x * invCellSize);
+      const i32 cellY  = (i32)math_round_down_f32(pos.y * invCellSize);
+      const i32 cellZ  = (i32)math_round_down_f32(pos.z * invCellSize);
+      const u32 bucket = asset_mesh_weld_bucket(cellX, cellY, cellZ, tableSize);
+      next[v]          = table[bucket];
+      table[bucket]    = v;
+    }
+  }
+
+  // Rebuild the mesh from the welded vertices; triangles that collapsed are dropped.
+  diag_assert((snapshot.indexCount % 3) == 0); // Input has to be triangles.
+  for (u32 i = 0; i != snapshot.indexCount; i += 3) {
+    const u32 a = remap[snapshot.indexData[i + 0]];
+    const u32 b = remap[snapshot.indexData[i + 1]];
+    const u32 c = remap[snapshot.indexData[i + 2]];
+    if (a == b || b == c || a == c) {
+      continue; // Triangle collapsed during welding.
+    }
+    const AssetMeshIndex idxA = asset_mesh_builder_push(builder, &snapshot.vertexData[a]);
+    const AssetMeshIndex idxB = asset_mesh_builder_push(builder, &snapshot.vertexData[b]);
+    const AssetMeshIndex idxC = asset_mesh_builder_push(builder, &snapshot.vertexData[c]);
+    if (snapshot.skinData) {
+      asset_mesh_builder_set_skin(builder, idxA, snapshot.skinData[a]);
+      asset_mesh_builder_set_skin(builder, idxB, snapshot.skinData[b]);
+      asset_mesh_builder_set_skin(builder, idxC, snapshot.skinData[c]);
+    }
+  }
+
+  if (UNLIKELY(!builder->indexData.size)) {
+    // All triangles collapsed (degenerate micro mesh); restore the original triangles.
+    for (u32 i = 0; i != snapshot.indexCount; ++i) {
+      const u32            v   = snapshot.indexData[i];
+      const AssetMeshIndex idx = asset_mesh_builder_push(builder, &snapshot.vertexData[v]);
+      if (snapshot.skinData) {
+        asset_mesh_builder_set_skin(builder, idx, snapshot.skinData[v]);
+      }
+    }
+  }
+
+  alloc_free(g_allocHeap, tableMem);
+  alloc_free(g_allocHeap, nextMem);
+  alloc_free(g_allocHeap, remapMem);
+  alloc_free(g_allocHeap, snapshot.mem);
+}
+
+#define asset_mesh_opt_cache_size 32
+#define asset_mesh_opt_last_tri_score 0.75f
+#define asset_mesh_opt_cache_decay_power 1.5f
+#define asset_mesh_opt_valence_scale 2.0f
+#define asset_mesh_opt_valence_power -0.5f
+
+typedef struct {
+  f32 score;
+  u32 triCount;   // Amount of triangles that use this vertex.
+  u32 activeTris; // Amount of not yet emitted triangles that use this vertex.
+  u32 triOffset;  // Start of this vertex's range in the triangle list.
+  i32 cachePos;   // Position in the simulated post-transform cache, -1 when not cached.
+} AssetMeshOptVertex;
+
+static f32 asset_mesh_opt_score(const AssetMeshOptVertex* vert) {
+  if (!vert->activeTris) {
+    return -1.0f; // All triangles using this vertex have been emitted.
+  }
+  f32 score = 0.0f;
+  if (vert->cachePos < 0) {
+    // Not in the cache; no bonus.
+  } else if (vert->cachePos < 3) {
+    score = asset_mesh_opt_last_tri_score; // Used by the last emitted triangle.
+  } else {
+    const f32 scale = 1.0f / (asset_mesh_opt_cache_size - 3);
+    score = math_pow_f32(1.0f - (vert->cachePos - 3) * scale, asset_mesh_opt_cache_decay_power);
+  }
+  // Boost vertices with few remaining triangles so they don't get stranded.
+  score += asset_mesh_opt_valence_scale *
+           math_pow_f32((f32)vert->activeTris, asset_mesh_opt_valence_power);
+  return score;
+}
+
+void asset_mesh_optimize(AssetMeshBuilder* builder) {
+  diag_assert_msg(builder->indexData.size, "Empty mesh is invalid");
+
+  /**
+   * Reorder the triangles for better vertex cache efficiency ("Linear-Speed Vertex Cache
+   * Optimisation", Tom Forsyth, 2006): greedily emit the triangle with the highest combined
+   * vertex score, where vertices score higher when they are in the simulated post-transform
+   * cache and when few not yet emitted triangles still use them.
+   */
+
+  const u32 idxCount  = (u32)builder->indexData.size;
+  const u32 triCount  = idxCount / 3;
+  const u32 vertCount = (u32)builder->vertexData.size;
+  diag_assert((idxCount % 3) == 0); // Input has to be triangles.
+  if (triCount < 2) {
+    return; // Nothing to reorder.
+  }
+
+  AssetMeshIndex* indices = dynarray_begin_t(&builder->indexData, AssetMeshIndex);
+
+  const Mem vertMem = alloc_alloc(
+      g_allocHeap, vertCount * sizeof(AssetMeshOptVertex), alignof(AssetMeshOptVertex));
+  const Mem triListMem  = alloc_alloc(g_allocHeap, idxCount * sizeof(u32), alignof(u32));
+  const Mem triScoreMem = alloc_alloc(g_allocHeap, triCount * sizeof(f32), alignof(f32));
+  const Mem triDoneMem  = alloc_alloc(g_allocHeap, triCount, 1);
+  const Mem outMem      = alloc_alloc(g_allocHeap, idxCount * sizeof(AssetMeshIndex), 2);
+
+  AssetMeshOptVertex* verts     = vertMem.ptr;
+  u32*                triList   = triListMem.ptr;
+  f32*                triScores = triScoreMem.ptr;
+  u8*                 triDone   = triDoneMem.ptr;
+  AssetMeshIndex*     out       = outMem.ptr;
+
+  // Build the per-vertex triangle lists.
+  mem_set(vertMem, 0);
+  mem_set(triDoneMem, 0);
+  for (u32 i = 0; i != idxCount; ++i) {
+    ++verts[indices[i]].triCount;
+  }
+  for (u32 v = 0, offset = 0; v != vertCount; ++v) {
+    verts[v].triOffset = offset;
+    verts[v].cachePos  = -1;
+    offset += verts[v].triCount;
+  }
+  for (u32 t = 0; t != triCount; ++t) {
+    for (u32 c = 0; c != 3; ++c) {
+      AssetMeshOptVertex* vert                        = &verts[indices[t * 3 + c]];
+      triList[vert->triOffset + vert->activeTris++]   = t;
+    }
+  }
+
+  // Compute the initial scores and find the best triangle to start with.
+  for (u32 v = 0; v != vertCount; ++v) {
+    verts[v].score = asset_mesh_opt_score(&verts[v]);
+  }
+  u32 bestTri = 0;
+  for (u32 t = 0; t != triCount; ++t) {
+    triScores[t] = verts[indices[t * 3 + 0]].score + verts[indices[t * 3 + 1]].score +
+                   verts[indices[t * 3 + 2]].score;
+    if (triScores[t] > triScores[bestTri]) {
+      bestTri = t;
+    }
+  }
+
+  u16 cache[asset_mesh_opt_cache_size + 3];
+  u32 cacheCount = 0;
+  u32 scanPos    = 0; // Fallback cursor for finding a triangle in a disconnected part.
+
+  for (u32 emitted = 0; emitted != triCount; ++emitted) {
+    if (sentinel_check(bestTri)) {
+      // No candidate in the cache; pick the next not yet emitted triangle.
+      while (triDone[scanPos]) {
+        ++scanPos;
+      }
+      bestTri = scanPos;
+    }
+    triDone[bestTri] = true;
+
+    const AssetMeshIndex i0 = indices[bestTri * 3 + 0];
+    const AssetMeshIndex i1 = indices[bestTri * 3 + 1];
+    const AssetMeshIndex i2 = indices[bestTri * 3 + 2];
+
+    out[emitted * 3 + 0] = i0;
+    out[emitted * 3 + 1] = i1;
+    out[emitted * 3 + 2] = i2;
+
+    --verts[i0].activeTris;
+    --verts[i1].activeTris;
+    --verts[i2].activeTris;
+
+    // Push the triangle's vertices to the front of the simulated cache.
+    u16 newCache[asset_mesh_opt_cache_size + 3];
+    u32 newCount       = 0;
+    newCache[newCount++] = i0;
+    newCache[newCount++] = i1;
+    newCache[newCount++] = i2;
+    for (u32 c = 0; c != cacheCount && newCount != array_elems(newCache); ++c) {
+      if (cache[c] != i0 && cache[c] != i1 && cache[c] != i2) {
+        newCache[newCount++] = cache[c];
+      }
+    }
+    mem_cpy(mem_var(cache), mem_var(newCache));
+    cacheCount = newCount;
+
+    // Re-score the cached (and just evicted) vertices and their remaining triangles.
+    for (u32 c = 0; c != cacheCount; ++c) {
+      AssetMeshOptVertex* vert = &verts[cache[c]];
+      vert->cachePos           = c < asset_mesh_opt_cache_size ? (i32)c : -1;
+      vert->score              = asset_mesh_opt_score(vert);
+    }
+    bestTri      = sentinel_u32;
+    f32 bestScore = -1.0f;
+    for (u32 c = 0; c != cacheCount; ++c) {
+      const AssetMeshOptVertex* vert = &verts[cache[c]];
+      for (u32 i = 0; i != vert->triCount; ++i) {
+        const u32 tri = triList[vert->triOffset + i];
+        if (triDone[tri]) {
+          continue;
+        }
+        triScores[tri] = verts[indices[tri * 3 + 0]].score + verts[indices[tri * 3 + 1]].score +
+                         verts[indices[tri * 3 + 2]].score;
+        if (triScores[tri] > bestScore) {
+          bestScore = triScores[tri];
+          bestTri   = tri;
+        }
+      }
+    }
+    cacheCount = math_min(cacheCount, (u32)asset_mesh_opt_cache_size);
+  }
+
+  mem_cpy(mem_create(indices, idxCount * sizeof(AssetMeshIndex)), outMem);
+
+  alloc_free(g_allocHeap, vertMem);
+  alloc_free(g_allocHeap, triListMem);
+  alloc_free(g_allocHeap, triScoreMem);
+  alloc_free(g_allocHeap, triDoneMem);
+  alloc_free(g_allocHeap, outMem);
+}
+
+#define asset_mesh_lod_min_indices 768
+#define asset_mesh_lod_grid_res 128
+#define asset_mesh_lod_min_reduction 0.1f
+
+static u32 asset_mesh_lod_cell(
+    const GeoVector pos, const GeoVector boundsMin, const f32 invCellSize, const u32 gridRes) {
+  const u32 x = math_min((u32)((pos.x - boundsMin.x) * invCellSize), gridRes - 1);
+  const u32 y = math_min((u32)((pos.y - boundsMin.y) * invCellSize), gridRes - 1);
+  const u32 z = math_min((u32)((pos.z - boundsMin.z) * invCellSize), gridRes - 1);
+  return x + y * gridRes + z * gridRes * gridRes;
+}
+
+void asset_mesh_generate_lods(AssetMeshBuilder* builder) {
+  diag_assert_msg(builder->indexData.size, "Empty mesh is invalid");
+  diag_assert_msg(!builder->lodCount, "Lods have already been generated");
+
+  /**
+   * Simplify by clustering vertices on a uniform grid (halving the resolution for every level):
+   * all vertices in a cell collapse onto the first vertex of that cell and triangles that
+   * degenerate are dropped. The levels reuse the existing vertices so only index data is added,
+   * appended after the full-detail indices.
+   */
+
+  const u32 baseIndexCount = (u32)builder->indexData.size;
+  if (baseIndexCount < asset_mesh_lod_min_indices) {
+    return; // Not enough detail to benefit from lods.
+  }
+
+  const GeoVector boundsSize = geo_box_size(&builder->bounds);
+  const f32 boundsDim = math_max(boundsSize.x, math_max(boundsSize.y, boundsSize.z));
+  if (boundsDim <= f32_epsilon) {
+    return; // Degenerate bounds.
+  }
+  const GeoVector boundsMin = builder->bounds.min;
+
+  // Snapshot the full-detail indices; appending lod indices can re-allocate the index array.
+  const Mem baseIdxMem = alloc_alloc(g_allocHeap, baseIndexCount * sizeof(AssetMeshIndex), 2);
+  mem_cpy(baseIdxMem, dynarray_at(&builder->indexData, 0, baseIndexCount));
+  const AssetMeshIndex* baseIndices = baseIdxMem.ptr;
+
+  // Representative vertex per grid cell, shared by all levels (finer levels use a sub-range).
+  const u32 maxGridRes   = asset_mesh_lod_grid_res >> 1;
+  const u32 maxCellCount = maxGridRes * maxGridRes * maxGridRes;
+  const Mem cellMem = alloc_alloc(g_allocHeap, maxCellCount * sizeof(AssetMeshIndex), 2);
+  AssetMeshIndex* cells = cellMem.ptr;
+
+  const AssetMeshVertex* verts = dynarray_begin_t(&builder->vertexData, AssetMeshVertex);
+
+  u32 prevIndexCount = baseIndexCount;
+  for (u32 level = 1; level <= asset_mesh_lods_max; ++level) {
+    const u32 gridRes     = asset_mesh_lod_grid_res >> level;
+    const f32 invCellSize = (f32)gridRes / boundsDim;
+
+    mem_set(mem_slice(cellMem, 0, gridRes * gridRes * gridRes * sizeof(AssetMeshIndex)), 0xFF);
+    ASSERT(asset_mesh_vertices_max == u16_max, "Cell table relies on u16_max as sentinel");
+
+    const u32 lodIndexOffset = (u32)builder->indexData.size;
+    for (u32 i = 0; i != baseIndexCount; i += 3) {
+      AssetMeshIndex rep[3];
+      for (u32 c = 0; c != 3; ++c) {
+        const AssetMeshIndex vertIdx = baseIndices[i + c];
+        const u32 cell = asset_mesh_lod_cell(verts[vertIdx].position, boundsMin, invCellSize, gridRes);
+        if (cells[cell] == asset_mesh_vertices_max) {
+          cells[cell] = vertIdx;
+        }
+        rep[c] = cells[cell];
+      }
+      if (rep[0] == rep[1] || rep[1] == rep[2] || rep[0] == rep[2]) {
+        continue; // Triangle collapsed.
+      }
+      mem_cpy(dynarray_push(&builder->indexData, 3), mem_var(rep));
+    }
+
+    const u32 lodIndexCount = (u32)builder->indexData.size - lodIndexOffset;
+    if (lodIndexCount >= (u32)(prevIndexCount * (1.0f - asset_mesh_lod_min_reduction))) {
+      // Not enough reduction over the previous level to be worth the extra index data.
+      dynarray_resize(&builder->indexData, lodIndexOffset);
+      break;
+    }
+    builder->lods[builder->lodCount++] = (AssetMeshLod){
+        .indexOffset = lodIndexOffset,
+        .indexCount  = lodIndexCount,
+    };
+    prevIndexCount = lodIndexCount;
+  }
+
+  alloc_free(g_allocHeap, cellMem);
+  alloc_free(g_allocHeap, baseIdxMem);
+}
@@ -40,3 +40,22 @@ void asset_mesh_compute_flat_normals(AssetMeshBuilder*);
  * Calculate smooth tangents based on the vertex normals and texcoords.
  */
 void asset_mesh_compute_tangents(AssetMeshBuilder*);
+
+/**
+ * Weld vertices that are equal within a small tolerance (position / normal / texcoord).
+ * Removes the near-duplicate vertices that art tools commonly export; triangles that collapse
+ * during welding are dropped.
+ * NOTE: Call this before 'asset_mesh_optimize()'.
+ */
+void asset_mesh_weld(AssetMeshBuilder*);
+
+/**
+ * Reorder the triangles for better vertex cache efficiency.
+ */
+void asset_mesh_optimize(AssetMeshBuilder*);
+
+/**
+ * Generate simplified level-of-detail index ranges for the mesh.
+ * NOTE: Call this after all vertices have been pushed; levels reuse the existing vertices.
+ */
+void asset_mesh_generate_lods(AssetMeshBuilder*);
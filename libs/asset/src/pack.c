@@ -7,7 +7,10 @@
 #include "core/dynstring.h"
 #include "core/file.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
 #include "core/types.h"
+#include "data/read.h"
+#include "data/utils.h"
 #include "data/write.h"
 #include "log/logger.h"
 
@@ -25,6 +28,10 @@
  * the content of individual blocks is as consistent as possible (the order of blocks might shift
  * however).
  *
+ * Entries are packed in their cached (imported) representation when available, for example scripts
+ * are stored as compiled programs (ScriptBin) so loading from a pack is a straight deserialize
+ * without running the script pipeline on the target machine.
+ *
  * NOTE: Using 1 MiB blocks for compat with Steam: https://partner.steamgames.com/doc/sdk/uploading
  * NOTE: The header always needs to fit into a single block.
  */
@@ -34,16 +41,192 @@
 #define asset_pack_big_entry_threshold (768 * usize_kibibyte)
 #define asset_pack_other_buckets 32
 #define asset_pack_file_align 16
+#define asset_pack_entry_deps_max 64
+#define asset_pack_ordered_region_size (8 * usize_mebibyte)
 
 DataMeta g_assetPackMeta;
 
 struct sAssetPacker {
   Allocator* alloc;
-  DynArray   entries; // AssetPackEntry[].
-  DynArray   regions; // AssetPackRegion[].
+  DynArray   entries;    // AssetPackEntry[].
+  DynArray   regions;    // AssetPackRegion[].
+  DynArray   regionMaps; // Mem[], mapped region memory; valid between write-begin and write-end.
   u64        sourceSize;
+  u64        fileSize;
+
+  u32* dupOf; // Per entry: canonical entry index when the content is identical to another entry,
+              // 'sentinel_u32' when unique. Valid from write-begin.
+  u64  dedupSize;
+  u32  entriesDeduped;
+
+  File*           baselineFile; // Optional baseline pack to copy unchanged entries from.
+  Mem             baselineMap;
+  AssetPackHeader baselineHeader;
+  i64             entriesReused;
 };
 
+typedef struct {
+  u32 sourceChecksum;
+  u32 size;
+  u32 entryIndex;
+  u16 format;
+} PackerContentKey;
+
+static i8 packer_compare_content_key(const void* a, const void* b) {
+  const PackerContentKey* keyA  = a;
+  const PackerContentKey* keyB  = b;
+  i8                      order = compare_u32(&keyA->sourceChecksum, &keyB->sourceChecksum);
+  if (!order) {
+    order = compare_u32(&keyA->size, &keyB->size);
+  }
+  if (!order) {
+    order = compare_u16(&keyA->format, &keyB->format);
+  }
+  return order;
+}
+
+/**
+ * Find entries with identical source content (matching checksum, size and format) so their data is
+ * stored only once; duplicates point at the canonical entry's slot in the header. Identical
+ * textures are common (for example roughness / metallic maps shared across material variants) so
+ * this is a cheap way to shrink the pack.
+ */
+static void packer_find_duplicates(AssetPacker* packer) {
+  const u32 entryCount = (u32)packer->entries.size;
+  packer->dupOf        = alloc_array_t(g_allocHeap, u32, entryCount);
+  for (u32 i = 0; i != entryCount; ++i) {
+    packer->dupOf[i] = sentinel_u32;
+  }
+  DynArray keys = dynarray_create_t(g_allocHeap, PackerContentKey, entryCount);
+  for (u32 i = 0; i != entryCount; ++i) {
+    const AssetPackEntry* entry = dynarray_at_t(&packer->entries, i, AssetPackEntry);
+    if (sentinel_check(entry->sourceChecksum)) {
+      continue; // Source content unknown; cannot be deduplicated.
+    }
+    *dynarray_push_t(&keys, PackerContentKey) = (PackerContentKey){
+        .sourceChecksum = entry->sourceChecksum,
+        .size           = entry->size,
+        .entryIndex     = i,
+        .format         = (u16)entry->format,
+    };
+  }
+  dynarray_sort(&keys, packer_compare_content_key);
+
+  for (u32 i = 0; i < keys.size;) {
+    // Find the run of keys with identical content.
+    u32 runEnd = i + 1;
+    while (runEnd < keys.size &&
+           !packer_compare_content_key(
+               dynarray_at_t(&keys, i, PackerContentKey),
+               dynarray_at_t(&keys, runEnd, PackerContentKey))) {
+      ++runEnd;
+    }
+    // Pick the entry with the lowest layout-order as the canonical one (so an explicit layout
+    // still applies); the remaining entries reference its data.
+    u32 canonical = dynarray_at_t(&keys, i, PackerContentKey)->entryIndex;
+    for (u32 k = i + 1; k != runEnd; ++k) {
+      const u32             index = dynarray_at_t(&keys, k, PackerContentKey)->entryIndex;
+      const AssetPackEntry* canonEntry =
+          dynarray_at_t(&packer->entries, canonical, AssetPackEntry);
+      const AssetPackEntry* entry = dynarray_at_t(&packer->entries, index, AssetPackEntry);
+      if (entry->layoutOrder < canonEntry->layoutOrder) {
+        canonical = index;
+      }
+    }
+    for (u32 k = i; k != runEnd; ++k) {
+      const u32 index = dynarray_at_t(&keys, k, PackerContentKey)->entryIndex;
+      if (index == canonical) {
+        continue;
+      }
+      packer->dupOf[index] = canonical;
+      packer->dedupSize += dynarray_at_t(&packer->entries, index, AssetPackEntry)->size;
+      ++packer->entriesDeduped;
+    }
+    i = runEnd;
+  }
+  dynarray_destroy(&keys);
+}
+
+static bool packer_entry_is_dup(const AssetPacker* packer, const AssetPackEntry* entry) {
+  const u32 index = (u32)(entry - dynarray_begin_t(&packer->entries, AssetPackEntry));
+  return !sentinel_check(packer->dupOf[index]);
+}
+
+static const AssetPackEntry* packer_baseline_find(AssetPacker* packer, const StringHash idHash) {
+  const AssetPackEntry target = {.idHash = idHash};
+  return dynarray_search_binary(&packer->baselineHeader.entries, asset_pack_compare_entry, &target);
+}
+
+/**
+ * Attempt to copy the entry content from the baseline pack file.
+ * Only possible when the source is unchanged compared to when the baseline pack was built.
+ */
+static bool packer_reuse_entry(AssetPacker* packer, AssetPackEntry* entry, const Mem regionMem) {
+  if (!packer->baselineFile || sentinel_check(entry->sourceChecksum)) {
+    return false;
+  }
+  const AssetPackEntry* base = packer_baseline_find(packer, entry->idHash);
+  if (!base || base->sourceChecksum != entry->sourceChecksum) {
+    return false;
+  }
+  if (base->format != entry->format || base->size != entry->size) {
+    return false;
+  }
+  const AssetPackRegion* baseRegion =
+      dynarray_at_t(&packer->baselineHeader.regions, base->region, AssetPackRegion);
+  const Mem baseMem = mem_slice(packer->baselineMap, baseRegion->offset + base->offset, base->size);
+
+  entry->checksum = base->checksum;
+  mem_cpy(mem_slice(regionMem, entry->offset, entry->size), baseMem);
+
+  if (base->deps.count) {
+    const usize depsSize = sizeof(StringHash) * base->deps.count;
+    entry->deps.values   = alloc_array_t(g_allocHeap, StringHash, base->deps.count);
+    entry->deps.count    = base->deps.count;
+    mem_cpy(mem_create(entry->deps.values, depsSize), mem_create(base->deps.values, depsSize));
+  }
+
+  thread_atomic_add_i64(&packer->entriesReused, 1);
+  return true;
+}
+
+/**
+ * Collect the assets that the entry content references; stored in the pack so dependencies can be
+ * prefetched at runtime. Only binary blobs can be inspected cheaply; entries in other formats are
+ * packed without dependency information.
+ */
+static void packer_collect_deps(AssetPackEntry* entry, const Mem data) {
+  const DataMeta* binMeta = asset_format_bin_meta(entry->format);
+  if (!binMeta) {
+    return; // Non-binary asset.
+  }
+  const usize structSize  = data_meta_size(g_dataReg, *binMeta);
+  const usize structAlign = data_meta_align(g_dataReg, *binMeta);
+  const Mem   structMem   = alloc_alloc(g_allocHeap, structSize, structAlign);
+
+  DataReadResult readRes;
+  data_read_bin(g_dataReg, data, g_allocHeap, *binMeta, DataReadFlags_None, structMem, &readRes);
+  if (UNLIKELY(readRes.error)) {
+    log_w(
+        "Failed to read packed asset blob",
+        log_param("asset", fmt_text(entry->id)),
+        log_param("error", fmt_text(readRes.errorMsg)));
+    goto Done;
+  }
+  StringHash refs[asset_pack_entry_deps_max];
+  const u32  refCount = asset_data_query_ref_ids(*binMeta, structMem, refs, array_elems(refs));
+  if (refCount) {
+    const usize depsSize = sizeof(StringHash) * refCount;
+    entry->deps.values   = alloc_array_t(g_allocHeap, StringHash, refCount);
+    entry->deps.count    = refCount;
+    mem_cpy(mem_create(entry->deps.values, depsSize), mem_create(refs, depsSize));
+  }
+  data_destroy(g_dataReg, g_allocHeap, *binMeta, structMem);
+
+Done:
+  alloc_free(g_allocHeap, structMem);
+}
+
 static bool packer_write_entry(
     AssetManagerComp*         manager,
     const AssetImportEnvComp* importEnv,
@@ -61,6 +244,7 @@ static bool packer_write_entry(
   }
   entry->checksum = bits_crc_32(0, source->data);
   mem_cpy(mem_slice(regionMem, entry->offset, entry->size), source->data);
+  packer_collect_deps(entry, source->data);
   asset_repo_close(source);
   return true;
 }
@@ -97,9 +281,10 @@ static bool packer_write_header(AssetPacker* packer, File* file, u64* headerSize
   return true;
 }
 
-static u16 packer_region_add(AssetPacker* packer, const u64 offset, const u32 size) {
+static u16 packer_region_add(AssetPacker* packer, const u64 offset, const u32 size, const Mem map) {
   diag_assert(bits_aligned(offset, asset_pack_block_size));
   diag_assert(bits_aligned(size, asset_pack_block_size));
+  diag_assert(map.size == size);
 
   if (UNLIKELY(packer->regions.size == u16_max)) {
     diag_crash_msg("Pack region count exceeds limit: {}", fmt_int(u16_max));
@@ -109,9 +294,20 @@ static u16 packer_region_add(AssetPacker* packer, const u64 offset, const u32 si
       .offset = offset,
       .size   = size,
   };
+  *dynarray_push_t(&packer->regionMaps, Mem) = map;
   return (u16)(packer->regions.size - 1);
 }
 
+static void packer_unmap_regions(AssetPacker* packer, File* file) {
+  FileResult fileRes;
+  dynarray_for_t(&packer->regionMaps, Mem, map) {
+    if (UNLIKELY(fileRes = file_unmap(file, *map))) {
+      log_e("Failed to unmap pack file", log_param("error", fmt_text(file_result_str(fileRes))));
+    }
+  }
+  dynarray_clear(&packer->regionMaps);
+}
+
 static void packer_region_compute_checksum(AssetPacker* packer, const u16 region, const Mem mem) {
   diag_assert(region < packer->regions.size);
 
@@ -119,21 +315,101 @@ static void packer_region_compute_checksum(AssetPacker* packer, const u16 region
   data->checksum        = bits_crc_32(0, mem);
 }
 
+static i8 packer_compare_entry_layout_order(const void* a, const void* b) {
+  const AssetPackEntry* entryA = *(const AssetPackEntry* const*)a;
+  const AssetPackEntry* entryB = *(const AssetPackEntry* const*)b;
+  return compare_u32(&entryA->layoutOrder, &entryB->layoutOrder);
+}
+
+static bool packer_layout_ordered_region(
+    AssetPacker*          packer,
+    File*                 file,
+    u64*                  fileOffset,
+    AssetPackEntry* const entries[],
+    const u32             count,
+    const u32             size) {
+  const u32  regionSize = (u32)bits_align(size, asset_pack_block_size);
+  FileResult fileRes;
+  if (UNLIKELY(fileRes = file_resize_sync(file, *fileOffset + regionSize))) {
+    log_e("Failed to resize pack file", log_param("error", fmt_text(file_result_str(fileRes))));
+    return false;
+  }
+  String regionMapping;
+  if (UNLIKELY(fileRes = file_map(file, *fileOffset, regionSize, 0, &regionMapping))) {
+    log_e("Failed to map pack file", log_param("error", fmt_text(file_result_str(fileRes))));
+    return false;
+  }
+  const u16 region       = packer_region_add(packer, *fileOffset, regionSize, regionMapping);
+  u32       regionOffset = 0;
+  for (u32 i = 0; i != count; ++i) {
+    entries[i]->region = region;
+    entries[i]->offset = regionOffset;
+    regionOffset += bits_align(entries[i]->size, asset_pack_file_align);
+  }
+  *fileOffset += regionSize;
+  return true;
+}
+
+/**
+ * Reserve sequential regions for the entries with an explicit layout order (in that order).
+ * Laying entries out in the runtime access order (see 'asset_packer_order') means startup and
+ * level loads become (mostly) sequential reads, which is a big win on spinning disks.
+ */
+static bool packer_layout_ordered_entries(AssetPacker* packer, File* file, u64* fileOffset) {
+  DynArray ordered = dynarray_create_t(g_allocHeap, AssetPackEntry*, 128);
+  dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
+    if (!sentinel_check(entry->layoutOrder) && !packer_entry_is_dup(packer, entry)) {
+      *dynarray_push_t(&ordered, AssetPackEntry*) = entry;
+    }
+  }
+  bool success = true;
+  if (ordered.size) {
+    dynarray_sort(&ordered, packer_compare_entry_layout_order);
+
+    // Split into regions of at most 'asset_pack_ordered_region_size' to keep some delta-patching
+    // granularity; the regions are allocated back-to-back so reads stay sequential.
+    u32 groupBegin = 0, groupSize = 0;
+    for (u32 i = 0; i != ordered.size && success; ++i) {
+      const AssetPackEntry* entry       = *dynarray_at_t(&ordered, i, AssetPackEntry*);
+      const u32             alignedSize = (u32)bits_align(entry->size, asset_pack_file_align);
+      if (groupSize && groupSize + alignedSize > asset_pack_ordered_region_size) {
+        success = packer_layout_ordered_region(
+            packer,
+            file,
+            fileOffset,
+            dynarray_at_t(&ordered, groupBegin, AssetPackEntry*),
+            i - groupBegin,
+            groupSize);
+        groupBegin = i;
+        groupSize  = 0;
+      }
+      groupSize += alignedSize;
+    }
+    if (success && groupSize) {
+      success = packer_layout_ordered_region(
+          packer,
+          file,
+          fileOffset,
+          dynarray_at_t(&ordered, groupBegin, AssetPackEntry*),
+          (u32)ordered.size - groupBegin,
+          groupSize);
+    }
+  }
+  dynarray_destroy(&ordered);
+  return success;
+}
+
 /**
- * Write a region containing all small entries.
+ * Reserve a region containing all small entries.
  * Combining these in a single region means this region will likely always change during patching
  * but because the entries are so small this region is unlikely to ever be bigger then a few blocks.
  */
-static bool packer_add_small_entries(
-    AssetPacker*              packer,
-    AssetManagerComp*         manager,
-    const AssetImportEnvComp* importEnv,
-    File*                     file,
-    u64*                      fileOffset) {
+static bool packer_layout_small_entries(AssetPacker* packer, File* file, u64* fileOffset) {
   u32 regionSize = 0;
   dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
-    if (sentinel_check(entry->region) && entry->size <= asset_pack_small_entry_threshold) {
-      regionSize += entry->size;
+    if (sentinel_check(entry->region) && entry->size <= asset_pack_small_entry_threshold &&
+        !packer_entry_is_dup(packer, entry)) {
+      regionSize += bits_align(entry->size, asset_pack_file_align);
     }
   }
   if (!regionSize) {
@@ -152,39 +428,29 @@ static bool packer_add_small_entries(
     return false;
   }
 
-  const u16 region       = packer_region_add(packer, *fileOffset, regionSize);
-  bool      success      = true;
+  const u16 region       = packer_region_add(packer, *fileOffset, regionSize, regionMapping);
   u32       regionOffset = 0;
   dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
-    if (sentinel_check(entry->region) && entry->size <= asset_pack_small_entry_threshold) {
+    if (sentinel_check(entry->region) && entry->size <= asset_pack_small_entry_threshold &&
+        !packer_entry_is_dup(packer, entry)) {
       entry->region = region;
       entry->offset = regionOffset;
-      success &= packer_write_entry(manager, importEnv, entry, regionMapping);
       regionOffset += bits_align(entry->size, asset_pack_file_align);
     }
   }
-
-  packer_region_compute_checksum(packer, region, regionMapping);
-  if (UNLIKELY(fileRes = file_unmap(file, regionMapping))) {
-    log_e("Failed to unmap pack file", log_param("error", fmt_text(file_result_str(fileRes))));
-  }
   *fileOffset += regionSize;
-  return success;
+  return true;
 }
 
 /**
- * Push a new region for every big file.
+ * Reserve a new region for every big file.
  * Placing big files on individual regions (each starting at a block boundary) means delta patching
  * can re-use those blocks if the files didn't change.
  */
-static bool packer_add_big_entries(
-    AssetPacker*              packer,
-    AssetManagerComp*         manager,
-    const AssetImportEnvComp* importEnv,
-    File*                     file,
-    u64*                      fileOffset) {
+static bool packer_layout_big_entries(AssetPacker* packer, File* file, u64* fileOffset) {
   dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
-    if (!sentinel_check(entry->region) || entry->size < asset_pack_big_entry_threshold) {
+    if (!sentinel_check(entry->region) || entry->size < asset_pack_big_entry_threshold ||
+        packer_entry_is_dup(packer, entry)) {
       continue;
     }
     const u32 regionSize = bits_align(entry->size, asset_pack_block_size);
@@ -199,16 +465,8 @@ static bool packer_add_big_entries(
       log_e("Failed to map pack file", log_param("error", fmt_text(file_result_str(fileRes))));
       return false;
     }
-    entry->region      = packer_region_add(packer, *fileOffset, regionSize);
-    const bool success = packer_write_entry(manager, importEnv, entry, regionMapping);
-
-    packer_region_compute_checksum(packer, entry->region, regionMapping);
-    if (UNLIKELY(fileRes = file_unmap(file, regionMapping))) {
-      log_e("Failed to unmap pack file", log_param("error", fmt_text(file_result_str(fileRes))));
-    }
-    if (!success) {
-      return false;
-    }
+    entry->region = packer_region_add(packer, *fileOffset, regionSize, regionMapping);
+    entry->offset = 0;
     *fileOffset += regionSize;
   }
   return true;
@@ -224,93 +482,132 @@ static bool packer_add_big_entries(
  * NOTE: In the future we can consider a smarter algorithm for dividing the entries into buckets
  * that takes the entry size into account to better load-balance the buckets.
  */
-static bool packer_add_other_entries(
-    AssetPacker*              packer,
-    AssetManagerComp*         manager,
-    const AssetImportEnvComp* importEnv,
-    File*                     file,
-    u64*                      fileOffset) {
+static bool packer_layout_other_entries(AssetPacker* packer, File* file, u64* fileOffset) {
   struct {
     u32 size, offset;
     u16 region;
-    Mem mapping;
   } buckets[asset_pack_other_buckets];
   mem_set(array_mem(buckets), 0);
 
   // Compute the size for each bucket.
   dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
-    if (sentinel_check(entry->region)) {
-      buckets[entry->idHash % asset_pack_other_buckets].size += entry->size;
+    if (sentinel_check(entry->region) && !packer_entry_is_dup(packer, entry)) {
+      const u32 bucket = entry->idHash % asset_pack_other_buckets;
+      buckets[bucket].size += bits_align(entry->size, asset_pack_file_align);
     }
   }
 
   // For each filled bucket allocate a region and map it.
   FileResult fileRes;
-  bool       success = true;
   for (u32 i = 0; i != asset_pack_other_buckets; ++i) {
     if (!buckets[i].size) {
       continue; // Empty bucket.
     }
-    buckets[i].size   = bits_align(buckets[i].size, asset_pack_block_size);
-    buckets[i].region = packer_region_add(packer, *fileOffset, buckets[i].size);
+    buckets[i].size = bits_align(buckets[i].size, asset_pack_block_size);
     if (UNLIKELY(fileRes = file_resize_sync(file, *fileOffset + buckets[i].size))) {
       log_e("Failed to resize pack file", log_param("error", fmt_text(file_result_str(fileRes))));
-      success = false;
-      continue;
+      return false;
     }
-    if (UNLIKELY(fileRes = file_map(file, *fileOffset, buckets[i].size, 0, &buckets[i].mapping))) {
+    String bucketMapping;
+    if (UNLIKELY(fileRes = file_map(file, *fileOffset, buckets[i].size, 0, &bucketMapping))) {
       log_e("Failed to map pack file", log_param("error", fmt_text(file_result_str(fileRes))));
-      success = false;
-      continue;
+      return false;
     }
+    buckets[i].region = packer_region_add(packer, *fileOffset, buckets[i].size, bucketMapping);
     *fileOffset += buckets[i].size;
   }
 
-  // Write entries to the buckets.
-  if (success) {
-    dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
-      if (sentinel_check(entry->region)) {
-        const u32 bucket = entry->idHash % asset_pack_other_buckets;
-        diag_assert(!string_is_empty(buckets[bucket].mapping));
-        entry->region = buckets[bucket].region;
-        entry->offset = buckets[bucket].offset;
-        success &= packer_write_entry(manager, importEnv, entry, buckets[bucket].mapping);
-        buckets[bucket].offset += bits_align(entry->size, asset_pack_file_align);
-      }
-    }
-  }
-
-  // Unmap all regions.
-  for (u32 i = 0; i != asset_pack_other_buckets; ++i) {
-    if (!string_is_empty(buckets[i])) {
-      packer_region_compute_checksum(packer, buckets[i].region, buckets[i].mapping);
-      if (UNLIKELY(fileRes = file_unmap(file, buckets[i].mapping))) {
-        log_e("Failed to unmap pack file", log_param("error", fmt_text(file_result_str(fileRes))));
-      }
+  // Assign entries to slots in the buckets.
+  dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
+    if (sentinel_check(entry->region) && !packer_entry_is_dup(packer, entry)) {
+      const u32 bucket = entry->idHash % asset_pack_other_buckets;
+      entry->region    = buckets[bucket].region;
+      entry->offset    = buckets[bucket].offset;
+      buckets[bucket].offset += bits_align(entry->size, asset_pack_file_align);
     }
   }
-
-  return success;
+  return true;
 }
 
 AssetPacker* asset_packer_create(Allocator* alloc, const u32 assetCapacity) {
   AssetPacker* packer = alloc_alloc_t(alloc, AssetPacker);
 
   *packer = (AssetPacker){
-      .alloc   = alloc,
-      .entries = dynarray_create_t(alloc, AssetPackEntry, assetCapacity),
-      .regions = dynarray_create_t(alloc, AssetPackRegion, 128),
+      .alloc      = alloc,
+      .entries    = dynarray_create_t(alloc, AssetPackEntry, assetCapacity),
+      .regions    = dynarray_create_t(alloc, AssetPackRegion, 128),
+      .regionMaps = dynarray_create_t(alloc, Mem, 128),
   };
 
   return packer;
 }
 
 void asset_packer_destroy(AssetPacker* packer) {
+  diag_assert_msg(!packer->regionMaps.size, "Packer destroyed while regions are still mapped");
+
+  if (packer->baselineFile) {
+    file_unmap(packer->baselineFile, packer->baselineMap);
+    data_destroy(g_dataReg, g_allocHeap, g_assetPackMeta, mem_var(packer->baselineHeader));
+  }
+  dynarray_for_t(&packer->entries, AssetPackEntry, entry) {
+    if (entry->deps.count) {
+      alloc_free_array_t(g_allocHeap, entry->deps.values, entry->deps.count);
+    }
+  }
+  if (packer->dupOf) {
+    alloc_free_array_t(g_allocHeap, packer->dupOf, packer->entries.size);
+  }
   dynarray_destroy(&packer->entries);
   dynarray_destroy(&packer->regions);
+  dynarray_destroy(&packer->regionMaps);
   alloc_free_t(packer->alloc, packer);
 }
 
+bool asset_packer_baseline(AssetPacker* packer, File* baselineFile) {
+  diag_assert_msg(!packer->baselineFile, "Packer already has a baseline");
+
+  FileResult fileRes;
+  Mem        map;
+  if (UNLIKELY(fileRes = file_map(baselineFile, 0, 0 /* size */, FileHints_Prefetch, &map))) {
+    log_w(
+        "Failed to map baseline pack file",
+        log_param("error", fmt_text(file_result_str(fileRes))));
+    return false;
+  }
+  AssetPackHeader     header;
+  DataReadResult      readRes;
+  const DataReadFlags readFlags = DataReadFlags_None;
+  data_read_bin(g_dataReg, map, g_allocHeap, g_assetPackMeta, readFlags, mem_var(header), &readRes);
+  if (UNLIKELY(readRes.error)) {
+    log_w("Failed to read baseline pack header", log_param("error", fmt_text(readRes.errorMsg)));
+    file_unmap(baselineFile, map);
+    return false;
+  }
+  // Validate that the baseline entries are within bounds of the mapped file.
+  dynarray_for_t(&header.entries, AssetPackEntry, entry) {
+    if (UNLIKELY(entry->region >= header.regions.size)) {
+      goto Malformed;
+    }
+    const AssetPackRegion* region = dynarray_at_t(&header.regions, entry->region, AssetPackRegion);
+    if (UNLIKELY((u64)entry->offset + entry->size > region->size)) {
+      goto Malformed;
+    }
+    if (UNLIKELY(region->offset + region->size > map.size)) {
+      goto Malformed;
+    }
+  }
+  packer->baselineFile   = baselineFile;
+  packer->baselineMap    = map;
+  packer->baselineHeader = header;
+  return true;
+
+Malformed:
+  log_w("Malformed baseline pack file");
+  data_destroy(g_dataReg, g_allocHeap, g_assetPackMeta, mem_var(header));
+  file_unmap(baselineFile, map);
+  return false;
+}
+
 bool asset_packer_push(
     AssetPacker*              packer,
     AssetManagerComp*         manager,
@@ -342,56 +639,139 @@ bool asset_packer_push(
   packer->sourceSize += info.size;
 
   const AssetPackEntry e = {
-      .id       = stringtable_intern(g_stringtable, assetId),
-      .idHash   = string_hash(assetId),
-      .format   = info.format,
-      .checksum = sentinel_u32, // Filled in when writing.
-      .size     = (u32)info.size,
-      .region   = sentinel_u16, // Assigned when writing.
+      .id             = stringtable_intern(g_stringtable, assetId),
+      .idHash         = string_hash(assetId),
+      .format         = info.format,
+      .checksum       = sentinel_u32, // Filled in when writing.
+      .sourceChecksum = info.checksum,
+      .size           = (u32)info.size,
+      .region         = sentinel_u16, // Assigned when writing.
+      .layoutOrder    = sentinel_u32, // Optionally assigned through 'asset_packer_order'.
   };
   *dynarray_insert_sorted_t(&packer->entries, AssetPackEntry, asset_pack_compare_entry, &e) = e;
   return true;
 }
 
-bool asset_packer_write(
-    AssetPacker*              packer,
-    AssetManagerComp*         manager,
-    const AssetImportEnvComp* importEnv,
-    File*                     outFile,
-    AssetPackerStats*         outStats) {
+bool asset_packer_order(AssetPacker* packer, const String assetId, const u32 order) {
+  diag_assert_msg(!packer->regions.size, "Packer has already begun writing");
+  diag_assert(!sentinel_check(order));
+
+  const AssetPackEntry target = {.idHash = string_hash(assetId)};
+  AssetPackEntry*      entry =
+      dynarray_search_binary(&packer->entries, asset_pack_compare_entry, &target);
+  if (!entry) {
+    return false; // Unknown asset.
+  }
+  entry->layoutOrder = order;
+  return true;
+}
+
+bool asset_packer_write_begin(AssetPacker* packer, File* outFile) {
+  diag_assert_msg(!packer->regions.size, "Packer has already begun writing");
+
   if (UNLIKELY(!dynarray_size(&packer->entries))) {
     log_e("Empty pack file is not supported");
     return false;
   }
+  packer_find_duplicates(packer);
+
   u64 fileOffset = asset_pack_block_size; // Reserve a single block for the header.
-  if (!packer_add_small_entries(packer, manager, importEnv, outFile, &fileOffset)) {
-    return false;
+  if (!packer_layout_ordered_entries(packer, outFile, &fileOffset)) {
+    goto Error;
   }
-  if (!packer_add_big_entries(packer, manager, importEnv, outFile, &fileOffset)) {
-    return false;
+  if (!packer_layout_small_entries(packer, outFile, &fileOffset)) {
+    goto Error;
   }
-  if (!packer_add_other_entries(packer, manager, importEnv, outFile, &fileOffset)) {
-    return false;
+  if (!packer_layout_big_entries(packer, outFile, &fileOffset)) {
+    goto Error;
+  }
+  if (!packer_layout_other_entries(packer, outFile, &fileOffset)) {
+    goto Error;
   }
   diag_assert(bits_aligned(fileOffset, asset_pack_block_size));
 
+  packer->fileSize = fileOffset;
+  return true;
+
+Error:
+  packer_unmap_regions(packer, outFile);
+  return false;
+}
+
+u32 asset_packer_entry_count(const AssetPacker* packer) { return (u32)packer->entries.size; }
+
+bool asset_packer_write_entry(
+    AssetPacker*              packer,
+    AssetManagerComp*         manager,
+    const AssetImportEnvComp* importEnv,
+    const u32                 index) {
+  diag_assert(index < packer->entries.size);
+
+  AssetPackEntry* entry = dynarray_at_t(&packer->entries, index, AssetPackEntry);
+  if (packer_entry_is_dup(packer, entry)) {
+    return true; // Content is written by the canonical entry; resolved at write-end.
+  }
+  diag_assert_msg(!sentinel_check(entry->region), "Entry region has not been reserved");
+
+  const Mem regionMap = *dynarray_at_t(&packer->regionMaps, entry->region, Mem);
+  if (packer_reuse_entry(packer, entry, regionMap)) {
+    return true;
+  }
+  return packer_write_entry(manager, importEnv, entry, regionMap);
+}
+
+bool asset_packer_write_end(AssetPacker* packer, File* outFile, AssetPackerStats* outStats) {
+  // Point duplicate entries at the canonical entry's data.
+  for (u32 i = 0; i != packer->entries.size; ++i) {
+    if (sentinel_check(packer->dupOf[i])) {
+      continue;
+    }
+    AssetPackEntry*       entry = dynarray_at_t(&packer->entries, i, AssetPackEntry);
+    const AssetPackEntry* canon =
+        dynarray_at_t(&packer->entries, packer->dupOf[i], AssetPackEntry);
+    entry->region   = canon->region;
+    entry->offset   = canon->offset;
+    entry->checksum = canon->checksum;
+    if (canon->deps.count) {
+      const usize depsSize = sizeof(StringHash) * canon->deps.count;
+      entry->deps.values   = alloc_array_t(g_allocHeap, StringHash, canon->deps.count);
+      entry->deps.count    = canon->deps.count;
+      mem_cpy(mem_create(entry->deps.values, depsSize), mem_create(canon->deps.values, depsSize));
+    }
+  }
+
+  for (u16 region = 0; region != (u16)packer->regions.size; ++region) {
+    const Mem regionMap = *dynarray_at_t(&packer->regionMaps, region, Mem);
+    packer_region_compute_checksum(packer, region, regionMap);
+  }
+  packer_unmap_regions(packer, outFile);
+
   u64 headerSize;
   if (!packer_write_header(packer, outFile, &headerSize)) {
     return false;
   }
   if (outStats) {
+    const u64 storedSize = packer->sourceSize - packer->dedupSize;
+
     *outStats = (AssetPackerStats){
-        .size       = fileOffset,
-        .padding    = fileOffset - packer->sourceSize - headerSize,
-        .headerSize = headerSize,
-        .entries    = (u32)packer->entries.size,
-        .regions    = (u32)packer->regions.size,
-        .blocks     = (u32)(fileOffset / asset_pack_block_size),
+        .size           = packer->fileSize,
+        .padding        = packer->fileSize - storedSize - headerSize,
+        .headerSize     = headerSize,
+        .dedupSize      = packer->dedupSize,
+        .entries        = (u32)packer->entries.size,
+        .entriesReused  = (u32)packer->entriesReused,
+        .entriesDeduped = packer->entriesDeduped,
+        .regions        = (u32)packer->regions.size,
+        .blocks         = (u32)(packer->fileSize / asset_pack_block_size),
     };
   }
   return true;
 }
 
+void asset_packer_write_abort(AssetPacker* packer, File* outFile) {
+  packer_unmap_regions(packer, outFile);
+}
+
 void asset_data_init_pack(void) {
   // clang-format off
   data_reg_struct_t(g_dataReg, AssetPackEntry);
@@ -399,9 +779,11 @@ void asset_data_init_pack(void) {
   data_reg_field_t(g_dataReg, AssetPackEntry, idHash, data_prim_t(u32));
   data_reg_field_t(g_dataReg, AssetPackEntry, format, g_assetFormatType);
   data_reg_field_t(g_dataReg, AssetPackEntry, checksum, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, AssetPackEntry, sourceChecksum, data_prim_t(u32));
   data_reg_field_t(g_dataReg, AssetPackEntry, region, data_prim_t(u16));
   data_reg_field_t(g_dataReg, AssetPackEntry, offset, data_prim_t(u32));
   data_reg_field_t(g_dataReg, AssetPackEntry, size, data_prim_t(u32));
+  data_reg_field_t(g_dataReg, AssetPackEntry, deps, data_prim_t(StringHash), .container = DataContainer_HeapArray, .flags = DataFlags_Opt);
 
   data_reg_struct_t(g_dataReg, AssetPackRegion);
   data_reg_field_t(g_dataReg, AssetPackRegion, offset, data_prim_t(u64));
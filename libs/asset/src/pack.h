@@ -1,3 +1,4 @@
+#include "core/array.h"
 #include "core/dynarray.h"
 
 #include "format.h"
@@ -6,9 +7,12 @@ typedef struct {
   String      id;
   StringHash  idHash;
   AssetFormat format;
-  u32         checksum; // crc32 (ISO 3309).
+  u32         checksum;       // crc32 (ISO 3309).
+  u32         sourceChecksum; // crc32 (ISO 3309) of the source, 'sentinel_u32' when unknown.
   u16         region;
-  u32         offset, size; // Within the region.
+  u32         offset, size;     // Within the region.
+  u32         layoutOrder;      // Optional order, 'sentinel_u32' when unordered. Not serialized.
+  HeapArray_t(StringHash) deps; // Id-hashes of assets referenced by this asset.
 } AssetPackEntry;
 
 typedef struct {
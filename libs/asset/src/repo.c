@@ -100,3 +100,37 @@ usize asset_repo_cache_deps(
   }
   return 0;
 }
+
+void asset_repo_cache_aux(
+    AssetRepo*     repo,
+    const String   id,
+    const u32      keyHash,
+    const Mem      blob,
+    const DataMeta blobMeta) {
+  if (repo->cacheAux) {
+    repo->cacheAux(repo, id, keyHash, blob, blobMeta);
+  }
+}
+
+bool asset_repo_cache_aux_load(
+    AssetRepo*     repo,
+    const String   id,
+    const u32      keyHash,
+    const DataMeta blobMeta,
+    Allocator*     alloc,
+    Mem*           outBlob) {
+  if (repo->cacheAuxLoad) {
+    return repo->cacheAuxLoad(repo, id, keyHash, blobMeta, alloc, outBlob);
+  }
+  return false;
+}
+
+usize asset_repo_deps(
+    AssetRepo* repo, const String id, String out[PARAM_ARRAY_SIZE(asset_repo_deps_max)]) {
+  if (repo->deps) {
+    return repo->deps(repo, id, out);
+  }
+  return 0;
+}
+
+bool asset_repo_deps_supported(const AssetRepo* repo) { return repo->deps != null; }
@@ -5,6 +5,7 @@
 #include "format.h"
 
 #define asset_repo_cache_deps_max 256
+#define asset_repo_deps_max 64
 
 typedef struct sAssetRepo   AssetRepo;
 typedef struct sAssetSource AssetSource;
@@ -19,6 +20,7 @@ typedef struct sAssetInfo {
   AssetInfoFlags flags;
   usize          size;
   TimeReal       modTime;
+  u32            checksum; // crc32 (ISO 3309) of the source, 'sentinel_u32' when unknown.
 } AssetInfo;
 
 typedef struct {
@@ -70,6 +72,10 @@ struct sAssetRepo {
       usize               depCount);
   usize (*cacheDeps)(
       AssetRepo*, String id, AssetRepoDep out[PARAM_ARRAY_SIZE(asset_repo_cache_deps_max)]);
+  void (*cacheAux)(AssetRepo*, String id, u32 keyHash, Mem blob, DataMeta blobMeta);
+  bool (*cacheAuxLoad)(
+      AssetRepo*, String id, u32 keyHash, DataMeta blobMeta, Allocator*, Mem* outBlob);
+  usize (*deps)(AssetRepo*, String id, String out[PARAM_ARRAY_SIZE(asset_repo_deps_max)]);
 };
 
 struct sAssetSource {
@@ -116,3 +122,21 @@ void asset_repo_cache(
 
 usize asset_repo_cache_deps(
     AssetRepo*, String id, AssetRepoDep out[PARAM_ARRAY_SIZE(asset_repo_cache_deps_max)]);
+
+/**
+ * Save / load an auxiliary cache blob, keyed by an explicit hash instead of a source asset.
+ * Useful for caching expensive intermediate results (for example rasterized font glyphs); callers
+ * are responsible for including all inputs (for example source checksums) in the key hash.
+ * NOTE: On successful load the blob is allocated from the given allocator; caller should free it.
+ */
+void asset_repo_cache_aux(AssetRepo*, String id, u32 keyHash, Mem blob, DataMeta blobMeta);
+bool asset_repo_cache_aux_load(
+    AssetRepo*, String id, u32 keyHash, DataMeta blobMeta, Allocator*, Mem* outBlob);
+
+/**
+ * Retrieve the ids of assets that the given asset references.
+ * Used to prefetch the dependencies of an asset when it is requested.
+ * NOTE: Returned strings are potentially scratch allocated; copy them if they need to be retained.
+ */
+usize asset_repo_deps(AssetRepo*, String id, String out[PARAM_ARRAY_SIZE(asset_repo_deps_max)]);
+bool  asset_repo_deps_supported(const AssetRepo*);
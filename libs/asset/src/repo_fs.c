@@ -5,6 +5,7 @@
 #include "core/file_iterator.h"
 #include "core/file_monitor.h"
 #include "core/path.h"
+#include "core/sentinel.h"
 #include "log/logger.h"
 #include "trace/tracer.h"
 
@@ -39,10 +40,11 @@ static bool asset_source_fs_stat(
   AssetCacheRecord cacheRecord;
   if (asset_cache_get(repoFs->cache, id, loaderHasher, &cacheRecord)) {
     *out = (AssetInfo){
-        .format  = asset_format_from_bin_meta(cacheRecord.meta),
-        .flags   = AssetInfoFlags_Cached,
-        .size    = file_stat_sync(cacheRecord.blobFile).size,
-        .modTime = cacheRecord.sourceModTime,
+        .format   = asset_format_from_bin_meta(cacheRecord.meta),
+        .flags    = AssetInfoFlags_Cached,
+        .size     = file_stat_sync(cacheRecord.blobFile).size,
+        .modTime  = cacheRecord.sourceModTime,
+        .checksum = cacheRecord.sourceChecksum,
     };
     file_destroy(cacheRecord.blobFile);
     return true;
@@ -53,10 +55,11 @@ static bool asset_source_fs_stat(
     return false;
   }
   *out = (AssetInfo){
-      .format  = asset_format_from_ext(path_extension(id)),
-      .flags   = AssetInfoFlags_None,
-      .size    = fileInfo.size,
-      .modTime = fileInfo.modTime,
+      .format   = asset_format_from_ext(path_extension(id)),
+      .flags    = AssetInfoFlags_None,
+      .size     = fileInfo.size,
+      .modTime  = fileInfo.modTime,
+      .checksum = sentinel_u32,
   };
   return true;
 }
@@ -325,6 +328,50 @@ static usize asset_repo_fs_cache_deps(
   return asset_cache_deps(repoFs->cache, id, out);
 }
 
+static void asset_repo_fs_cache_aux(
+    AssetRepo*     repo,
+    const String   id,
+    const u32      keyHash,
+    const Mem      blob,
+    const DataMeta blobMeta) {
+  AssetRepoFs* repoFs = (AssetRepoFs*)repo;
+
+  asset_cache_set_aux(repoFs->cache, id, keyHash, blob, blobMeta);
+  asset_cache_flush(repoFs->cache); // NOTE: We could batch flushes to be more efficient.
+}
+
+static bool asset_repo_fs_cache_aux_load(
+    AssetRepo*     repo,
+    const String   id,
+    const u32      keyHash,
+    const DataMeta blobMeta,
+    Allocator*     alloc,
+    Mem*           outBlob) {
+  AssetRepoFs* repoFs = (AssetRepoFs*)repo;
+
+  AssetCacheRecord cacheRecord;
+  if (!asset_cache_get_aux(repoFs->cache, id, keyHash, &cacheRecord)) {
+    return false;
+  }
+  bool success = false;
+  if (cacheRecord.meta.type == blobMeta.type && cacheRecord.meta.container == blobMeta.container &&
+      cacheRecord.meta.flags == blobMeta.flags) {
+    String     mapping;
+    FileResult fileRes;
+    if ((fileRes = file_map(cacheRecord.blobFile, 0, 0, FileHints_Prefetch, &mapping))) {
+      log_w(
+          "Failed to map asset cache blob",
+          log_param("error", fmt_text(file_result_str(fileRes))));
+    } else {
+      *outBlob = alloc_dup(alloc, mapping, 1 /* align */);
+      file_unmap(cacheRecord.blobFile, mapping);
+      success = true;
+    }
+  }
+  file_destroy(cacheRecord.blobFile);
+  return success;
+}
+
 static void asset_repo_fs_destroy(AssetRepo* repo) {
   AssetRepoFs* repoFs = (AssetRepoFs*)repo;
 
@@ -361,6 +408,8 @@ AssetRepo* asset_repo_create_fs(const String rootPath, const bool portableCache)
               .query        = asset_repo_fs_query,
               .cache        = asset_repo_fs_cache,
               .cacheDeps    = asset_repo_fs_cache_deps,
+              .cacheAux     = asset_repo_fs_cache_aux,
+              .cacheAuxLoad = asset_repo_fs_cache_aux_load,
           },
       .sourceAlloc = alloc_block_create(g_allocHeap, sizeof(AssetSourceFs), alignof(AssetSourceFs)),
       .rootPath    = string_dup(g_allocHeap, rootPath),
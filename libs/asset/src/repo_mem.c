@@ -39,10 +39,11 @@ static bool asset_source_mem_stat(
   }
 
   *out = (AssetInfo){
-      .format  = fmt,
-      .flags   = AssetInfoFlags_None,
-      .size    = entry->data.size,
-      .modTime = repoMem->createTime,
+      .format   = fmt,
+      .flags    = AssetInfoFlags_None,
+      .size     = entry->data.size,
+      .modTime  = repoMem->createTime,
+      .checksum = entry->checksum,
   };
   return true;
 }
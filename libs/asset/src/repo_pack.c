@@ -1,8 +1,10 @@
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/file.h"
+#include "core/search.h"
 #include "core/thread.h"
 #include "data/read.h"
 #include "data/utils.h"
@@ -24,12 +26,18 @@ typedef struct {
 } AssetRegionState;
 
 typedef struct {
-  AssetRepo         api;
-  File*             file;
-  ThreadMutex       fileMutex;
-  AssetRegionState* regions;
-  AssetPackHeader   header;
-  Allocator*        sourceAlloc; // Allocator for AssetSourcePack objects.
+  StringHash idHash;
+  u32        entryIndex; // Index into the header entries.
+} AssetPackLookupEntry;
+
+typedef struct {
+  AssetRepo             api;
+  File*                 file;
+  ThreadMutex           fileMutex;
+  AssetRegionState*     regions;
+  AssetPackHeader       header;
+  AssetPackLookupEntry* lookup; // Eytzinger-ordered id table, built once after loading the header.
+  Allocator*            sourceAlloc; // Allocator for AssetSourcePack objects.
 } AssetRepoPack;
 
 typedef struct {
@@ -48,11 +56,48 @@ static bool asset_repo_pack_validate(const AssetPackHeader* header) {
   return true;
 }
 
+static i8 asset_repo_pack_compare_lookup(const void* a, const void* b) {
+  return compare_stringhash(
+      field_ptr(a, AssetPackLookupEntry, idHash), field_ptr(b, AssetPackLookupEntry, idHash));
+}
+
+/**
+ * Build the id lookup table for the given (idHash sorted) entries.
+ * The entries themselves are too big to probe cache-efficiently, instead search a compact
+ * (idHash, index) table laid out in Eytzinger order so the hot probes share cache-lines.
+ */
+static AssetPackLookupEntry* asset_repo_pack_lookup_build(const DynArray* entries) {
+  const u32             count  = (u32)entries->size;
+  AssetPackLookupEntry* sorted = alloc_array_t(g_allocHeap, AssetPackLookupEntry, count);
+  for (u32 i = 0; i != count; ++i) {
+    sorted[i] = (AssetPackLookupEntry){
+        .idHash     = dynarray_at_t(entries, i, AssetPackEntry)->idHash,
+        .entryIndex = i,
+    };
+  }
+  AssetPackLookupEntry* lookup = alloc_array_t(g_allocHeap, AssetPackLookupEntry, count);
+  search_eytzinger_build_t(sorted, sorted + count, AssetPackLookupEntry, lookup);
+  alloc_free_array_t(g_allocHeap, sorted, count);
+  return lookup;
+}
+
+static const AssetPackEntry*
+asset_repo_pack_find_hash(AssetRepoPack* pack, const StringHash idHash) {
+  const u32                   count = (u32)pack->header.entries.size;
+  const AssetPackLookupEntry* res   = search_eytzinger_t(
+      pack->lookup,
+      pack->lookup + count,
+      AssetPackLookupEntry,
+      asset_repo_pack_compare_lookup,
+      &(AssetPackLookupEntry){.idHash = idHash});
+  if (!res) {
+    return null;
+  }
+  return dynarray_at_t(&pack->header.entries, res->entryIndex, AssetPackEntry);
+}
+
 static const AssetPackEntry* asset_repo_pack_find(AssetRepoPack* pack, const String id) {
-  const AssetPackEntry* entry = dynarray_search_binary(
-      &pack->header.entries,
-      asset_pack_compare_entry,
-      &(AssetPackEntry){.idHash = string_hash(id)});
+  const AssetPackEntry* entry = asset_repo_pack_find_hash(pack, string_hash(id));
   if (!entry) {
     return null;
   }
@@ -131,10 +176,11 @@ static bool asset_source_pack_stat(
     return false;
   }
   *out = (AssetInfo){
-      .format  = entry->format,
-      .flags   = AssetInfoFlags_None,
-      .size    = entry->size,
-      .modTime = 0, // Mod-time not tracked in pack files.
+      .format   = entry->format,
+      .flags    = AssetInfoFlags_None,
+      .size     = entry->size,
+      .modTime  = 0, // Mod-time not tracked in pack files.
+      .checksum = entry->sourceChecksum,
   };
   return true;
 }
@@ -179,6 +225,23 @@ asset_source_pack_open(AssetRepo* repo, const String id, const AssetRepoLoaderHa
   return (AssetSource*)src;
 }
 
+static usize asset_repo_pack_deps(
+    AssetRepo* repo, const String id, String out[PARAM_ARRAY_SIZE(asset_repo_deps_max)]) {
+  AssetRepoPack*        repoPack = (AssetRepoPack*)repo;
+  const AssetPackEntry* entry    = asset_repo_pack_find(repoPack, id);
+  if (!entry) {
+    return 0;
+  }
+  usize count = 0;
+  for (usize i = 0; i != entry->deps.count && count != asset_repo_deps_max; ++i) {
+    const AssetPackEntry* depEntry = asset_repo_pack_find_hash(repoPack, entry->deps.values[i]);
+    if (depEntry) {
+      out[count++] = depEntry->id;
+    }
+  }
+  return count;
+}
+
 static AssetRepoQueryResult asset_repo_pack_query(
     AssetRepo* repo, const String pattern, void* ctx, const AssetRepoQueryHandler handler) {
   AssetRepoPack* repoPack = (AssetRepoPack*)repo;
@@ -198,6 +261,7 @@ static void asset_repo_pack_destroy(AssetRepo* repo) {
   file_destroy(repoPack->file);
   thread_mutex_destroy(repoPack->fileMutex);
   alloc_free_array_t(g_allocHeap, repoPack->regions, repoPack->header.regions.size);
+  alloc_free_array_t(g_allocHeap, repoPack->lookup, repoPack->header.entries.size);
   data_destroy(g_dataReg, g_allocHeap, g_assetPackMeta, mem_var(repoPack->header));
 
   alloc_block_destroy(repoPack->sourceAlloc);
@@ -269,11 +333,13 @@ AssetRepo* asset_repo_create_pack(const String filePath) {
               .open    = asset_source_pack_open,
               .destroy = asset_repo_pack_destroy,
               .query   = asset_repo_pack_query,
+              .deps    = asset_repo_pack_deps,
           },
       .file      = file,
       .fileMutex = thread_mutex_create(g_allocHeap),
       .regions   = regions,
       .header    = header,
+      .lookup    = asset_repo_pack_lookup_build(&header.entries),
       .sourceAlloc =
           alloc_block_create(g_allocHeap, sizeof(AssetSourcePack), alignof(AssetSourcePack)),
   };
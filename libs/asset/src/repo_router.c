@@ -220,6 +220,54 @@ static usize asset_repo_router_cache_deps(
   return 0;
 }
 
+static void asset_repo_router_cache_aux(
+    AssetRepo*     repo,
+    const String   id,
+    const u32      keyHash,
+    const Mem      blob,
+    const DataMeta blobMeta) {
+  AssetRepoRouter* repoRouter = (AssetRepoRouter*)repo;
+
+  AssetRepoLaneEntry laneEntry;
+  if (asset_repo_router_find(repoRouter, id, &laneEntry)) {
+    AssetRepo* laneRepo = repoRouter->laneRepos[laneEntry.lane];
+    asset_repo_cache_aux(laneRepo, laneEntry.innerId, keyHash, blob, blobMeta);
+  }
+}
+
+static bool asset_repo_router_cache_aux_load(
+    AssetRepo*     repo,
+    const String   id,
+    const u32      keyHash,
+    const DataMeta blobMeta,
+    Allocator*     alloc,
+    Mem*           outBlob) {
+  AssetRepoRouter* repoRouter = (AssetRepoRouter*)repo;
+
+  AssetRepoLaneEntry laneEntry;
+  if (asset_repo_router_find(repoRouter, id, &laneEntry)) {
+    AssetRepo* laneRepo = repoRouter->laneRepos[laneEntry.lane];
+    return asset_repo_cache_aux_load(laneRepo, laneEntry.innerId, keyHash, blobMeta, alloc, outBlob);
+  }
+  return false;
+}
+
+static usize asset_repo_router_deps(
+    AssetRepo* repo, const String id, String out[PARAM_ARRAY_SIZE(asset_repo_deps_max)]) {
+  AssetRepoRouter* repoRouter = (AssetRepoRouter*)repo;
+
+  AssetRepoLaneEntry laneEntry;
+  if (asset_repo_router_find(repoRouter, id, &laneEntry)) {
+    AssetRepo*  laneRepo = repoRouter->laneRepos[laneEntry.lane];
+    const usize count    = asset_repo_deps(laneRepo, laneEntry.innerId, out);
+    for (usize i = 0; i != count; ++i) {
+      out[i] = asset_repo_router_id(repoRouter, laneEntry.lane, out[i]);
+    }
+    return count;
+  }
+  return 0;
+}
+
 static void asset_repo_router_destroy(AssetRepo* repo) {
   AssetRepoRouter* repoRouter = (AssetRepoRouter*)repo;
 
@@ -256,6 +304,8 @@ AssetRepo* asset_repo_create_router(const AssetRepoLane lanes[], const u32 laneC
               .query        = asset_repo_router_query,
               .cache        = asset_repo_router_cache,
               .cacheDeps    = asset_repo_router_cache_deps,
+              .cacheAux     = asset_repo_router_cache_aux,
+              .cacheAuxLoad = asset_repo_router_cache_aux_load,
           },
   };
 
@@ -263,6 +313,9 @@ AssetRepo* asset_repo_create_router(const AssetRepoLane lanes[], const u32 laneC
   for (u32 i = 0; i != laneCount; ++i) {
     repo->laneIds[i]   = string_maybe_dup(g_allocHeap, lanes[i].id);
     repo->laneRepos[i] = lanes[i].repo;
+    if (asset_repo_deps_supported(lanes[i].repo)) {
+      repo->api.deps = asset_repo_router_deps; // Only advertise deps when a lane supports them.
+    }
   }
 
   return (AssetRepo*)repo;
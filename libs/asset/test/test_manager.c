@@ -245,6 +245,36 @@ spec(manager) {
     check(!ecs_world_has_t(world, entity, AssetDirtyComp));
   }
 
+  it("evicts unreferenced assets when over the memory budget") {
+    EcsWorld*         budgetWorld = ecs_world_create(g_allocHeap, def);
+    AssetManagerComp* manager     = asset_manager_create_mem(
+        budgetWorld, AssetManagerFlags_DelayUnload, g_records, array_elems(g_records));
+    asset_memory_budget_set(manager, AssetMemCategory_Other, 1 /* maxBytes */);
+    ecs_world_flush(budgetWorld);
+
+    EcsRunner* budgetRunner = ecs_runner_create(g_allocHeap, budgetWorld, EcsRunnerFlags_None);
+
+    manager = ecs_utils_write_first_t(budgetWorld, ManagerView, AssetManagerComp);
+    const EcsEntityId asset = asset_lookup(budgetWorld, manager, string_lit("a.raw"));
+    asset_acquire(budgetWorld, asset);
+
+    asset_test_wait(budgetRunner);
+
+    // Referenced assets are never evicted, even when over budget.
+    check(ecs_world_has_t(budgetWorld, asset, AssetLoadedComp));
+
+    asset_release(budgetWorld, asset);
+
+    asset_test_wait(budgetRunner);
+    asset_test_wait(budgetRunner);
+
+    // Unreferenced and over budget: evicted despite the unload delay.
+    check(!ecs_world_has_t(budgetWorld, asset, AssetLoadedComp));
+
+    ecs_runner_destroy(budgetRunner);
+    ecs_world_destroy(budgetWorld);
+  }
+
   it("supports querying all assets with a wildcard") {
     AssetManagerComp* manager = ecs_utils_write_first_t(world, ManagerView, AssetManagerComp);
 
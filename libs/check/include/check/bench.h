@@ -0,0 +1,34 @@
+#pragma once
+#include "check/spec.h"
+#include "core/time.h"
+
+#define check_bench_runs 8
+
+typedef struct sCheckBenchContext {
+  CheckTestContext* testCtx;
+  String            name;
+  SourceLoc         source;
+  u32               phase; // Internal state, do not modify.
+  u32               run;
+  u64               itrsPerRun;
+  u64               itr;
+  TimeSteady        runStart;
+  TimeDuration      runDurs[check_bench_runs];
+} CheckBenchContext;
+
+// clang-format off
+
+/**
+ * Define a benchmark block. Only valid inside test blocks.
+ * The body is executed repeatedly: the iteration count is automatically calibrated, a warm-up run
+ * is performed and the median duration over multiple timed runs is reported to the outputs.
+ */
+#define bench(_NAME_)                                                                              \
+  for (CheckBenchContext _benchCtx =                                                               \
+          check_bench_begin(_testCtx, string_lit(_NAME_), source_location());                      \
+       check_bench_itr(&_benchCtx);)
+
+// clang-format on
+
+CheckBenchContext check_bench_begin(CheckTestContext*, String name, SourceLoc);
+bool              check_bench_itr(CheckBenchContext*);
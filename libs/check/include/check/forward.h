@@ -5,8 +5,9 @@
  * Forward header for the check library.
  */
 
-typedef struct sCheckDef         CheckDef;
-typedef struct sCheckSpecContext CheckSpecContext;
-typedef struct sCheckTest        CheckTest;
-typedef struct sCheckTestContext CheckTestContext;
-typedef u32                      CheckTestId;
+typedef struct sCheckBenchContext CheckBenchContext;
+typedef struct sCheckDef          CheckDef;
+typedef struct sCheckSpecContext  CheckSpecContext;
+typedef struct sCheckTest         CheckTest;
+typedef struct sCheckTestContext  CheckTestContext;
+typedef u32                       CheckTestId;
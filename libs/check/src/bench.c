@@ -0,0 +1,66 @@
+#include "check/bench.h"
+#include "core/compare.h"
+#include "core/sort.h"
+
+#include "spec.h"
+
+/**
+ * Duration a single (timed) run should take; during calibration the iteration count is doubled
+ * until a run takes at least this long.
+ */
+#define bench_run_target_dur time_milliseconds(2)
+#define bench_itrs_per_run_max (u64_lit(1) << 24)
+
+typedef enum {
+  BenchPhase_Calibrate, // Doubling the iteration count until a run is long enough to time.
+  BenchPhase_Warmup,    // Single full-length run that is not recorded.
+  BenchPhase_Measure,   // Timed runs that are recorded.
+} BenchPhase;
+
+static TimeDuration bench_median(TimeDuration durs[], const u32 count) {
+  sort_quicksort_t(durs, durs + count, TimeDuration, compare_i64);
+  return durs[count / 2];
+}
+
+CheckBenchContext
+check_bench_begin(CheckTestContext* testCtx, const String name, const SourceLoc source) {
+  return (CheckBenchContext){
+      .testCtx    = testCtx,
+      .name       = name,
+      .source     = source,
+      .itrsPerRun = 1,
+  };
+}
+
+bool check_bench_itr(CheckBenchContext* ctx) {
+  if (ctx->itr) {
+    --ctx->itr;
+    return true; // Current run is still in progress.
+  }
+  if (ctx->runStart) {
+    const TimeDuration dur = time_steady_duration(ctx->runStart, time_steady_clock());
+    switch ((BenchPhase)ctx->phase) {
+    case BenchPhase_Calibrate:
+      if (dur >= bench_run_target_dur || ctx->itrsPerRun == bench_itrs_per_run_max) {
+        ctx->phase = BenchPhase_Warmup;
+      } else {
+        ctx->itrsPerRun *= 2;
+      }
+      break;
+    case BenchPhase_Warmup:
+      ctx->phase = BenchPhase_Measure;
+      break;
+    case BenchPhase_Measure:
+      ctx->runDurs[ctx->run++] = dur;
+      if (ctx->run == check_bench_runs) {
+        const TimeDuration median = bench_median(ctx->runDurs, check_bench_runs);
+        check_result_bench(ctx->testCtx->result, ctx->name, ctx->itrsPerRun, median);
+        return false;
+      }
+      break;
+    }
+  }
+  ctx->itr      = ctx->itrsPerRun - 1;
+  ctx->runStart = time_steady_clock();
+  return true;
+}
@@ -64,6 +64,15 @@ static void output_test_finished(
           "result", type == CheckResultType_Pass ? fmt_text_lit("pass") : fmt_text_lit("fail")),
       log_param("duration", fmt_duration(result->duration)));
 
+  dynarray_for_t(&result->benchs, CheckBench, bnch) {
+    log(logOut->logger,
+        LogLevel_Info,
+        "Benchmark finished",
+        log_param("name", fmt_text(bnch->name)),
+        log_param("itrs", fmt_int(bnch->itrs)),
+        log_param("duration", fmt_duration(bnch->dur)));
+  }
+
   dynarray_for_t(&result->errors, CheckError, err) {
     log(logOut->logger,
         LogLevel_Error,
@@ -116,6 +116,19 @@ static void output_test_finished(
   const JsonVal errObj = json_add_object(doc);
   json_add_field_lit(doc, testObj, "err", errObj);
 
+  if (result->benchs.size) {
+    // Note: Not part of the standard Mocha format; used for tracking benchmark results over time.
+    const JsonVal benchArr = json_add_array(doc);
+    json_add_field_lit(doc, testObj, "benchs", benchArr);
+    dynarray_for_t(&result->benchs, CheckBench, bnch) {
+      const JsonVal benchObj = json_add_object(doc);
+      json_add_field_lit(doc, benchObj, "name", json_add_string(doc, bnch->name));
+      json_add_field_lit(doc, benchObj, "itrs", json_add_number(doc, (f64)bnch->itrs));
+      json_add_field_lit(doc, benchObj, "durNs", json_add_number(doc, (f64)bnch->dur));
+      json_add_elem(doc, benchArr, benchObj);
+    }
+  }
+
   if (result->errors.size) {
     // Note: Unfortunately Mocha's format only supports one error per test, so we take the first.
     const CheckError* err = dynarray_at_t(&result->errors, 0, CheckError);
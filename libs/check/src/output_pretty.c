@@ -1,3 +1,4 @@
+#include "check/bench.h"
 #include "core/alloc.h"
 #include "core/dynstring.h"
 #include "core/path.h"
@@ -14,6 +15,7 @@ typedef struct {
   String        suiteName;
   CheckRunFlags runFlags;
   bool          style;
+  ThreadMutex   mutex;
 } CheckOutputPretty;
 
 static FormatArg arg_style_bold(CheckOutputPretty* prettyOut) {
@@ -35,7 +37,13 @@ static FormatArg arg_style_result(CheckOutputPretty* prettyOut, const CheckResul
 }
 
 static void output_write(CheckOutputPretty* prettyOut, const String str) {
+  /**
+   * Tests finish concurrently on the job workers; serialize the writes so the (fully formatted)
+   * per-test blocks cannot interleave.
+   */
+  thread_mutex_lock(prettyOut->mutex);
   file_write_sync(prettyOut->file, str);
+  thread_mutex_unlock(prettyOut->mutex);
 }
 
 static void output_run_started(CheckOutput* out) {
@@ -85,7 +93,9 @@ static void output_test_finished(
     CheckResult*          result) {
   CheckOutputPretty* prettyOut = (CheckOutputPretty*)out;
 
-  if (!(prettyOut->runFlags & CheckRunFlags_OutputPassingTests) && type != CheckResultType_Fail) {
+  const bool shouldOutput = (prettyOut->runFlags & CheckRunFlags_OutputPassingTests) != 0 ||
+                            type == CheckResultType_Fail || result->benchs.size != 0;
+  if (!shouldOutput) {
     return;
   }
 
@@ -108,6 +118,20 @@ static void output_test_finished(
       fmt_duration(result->duration),
       arg_style_reset(prettyOut));
 
+  dynarray_for_t(&result->benchs, CheckBench, bnch) {
+    fmt_write(
+        &str,
+        "  {}{}{}: {} / itr {}(runs: {}, itrs: {}){}\n",
+        arg_style_bold(prettyOut),
+        fmt_text(bnch->name),
+        arg_style_reset(prettyOut),
+        fmt_duration((TimeDuration)(bnch->dur / (f64)bnch->itrs)),
+        arg_style_dim(prettyOut),
+        fmt_int(check_bench_runs),
+        fmt_int(bnch->itrs),
+        arg_style_reset(prettyOut));
+  }
+
   dynarray_for_t(&result->errors, CheckError, err) {
     fmt_write(
         &str,
@@ -163,6 +187,7 @@ static void output_run_finished(
 
 static void output_destroy(CheckOutput* out) {
   CheckOutputPretty* prettyOut = (CheckOutputPretty*)out;
+  thread_mutex_destroy(prettyOut->mutex);
   alloc_free_t(prettyOut->alloc, prettyOut);
 }
 
@@ -183,6 +208,7 @@ CheckOutput* check_output_pretty(Allocator* alloc, File* file, const CheckRunFla
                         .suiteName = path_stem(g_pathExecutable),
                         .runFlags  = runFlags,
                         .style     = tty_isatty(file),
+                        .mutex     = thread_mutex_create(alloc),
   };
   return (CheckOutput*)prettyOut;
 }
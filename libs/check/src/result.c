@@ -11,6 +11,7 @@ CheckResult* check_result_create(Allocator* alloc) {
   *result = (CheckResult){
       .alloc  = alloc,
       .errors = dynarray_create_t(alloc, CheckError, 0),
+      .benchs = dynarray_create_t(alloc, CheckBench, 0),
   };
 
   return result;
@@ -19,6 +20,8 @@ CheckResult* check_result_create(Allocator* alloc) {
 void check_result_destroy(CheckResult* result) {
   dynarray_for_t(&result->errors, CheckError, err) { string_free(result->alloc, err->msg); }
   dynarray_destroy(&result->errors);
+  dynarray_for_t(&result->benchs, CheckBench, bench) { string_free(result->alloc, bench->name); }
+  dynarray_destroy(&result->benchs);
   alloc_free_t(result->alloc, result);
 }
 
@@ -48,6 +51,18 @@ void check_result_error(CheckResult* result, String msg, const SourceLoc source)
   g_checkBusy = false;
 }
 
+void check_result_bench(
+    CheckResult* result, const String name, const u64 itrs, const TimeDuration dur) {
+  if (UNLIKELY(result->finished)) {
+    diag_crash_msg("Result is already finished");
+  }
+  *dynarray_push_t(&result->benchs, CheckBench) = (CheckBench){
+      .name = string_dup(result->alloc, name),
+      .itrs = itrs,
+      .dur  = dur,
+  };
+}
+
 void check_result_finish(CheckResult* result, const TimeDuration duration) {
   diag_assert_msg(!result->finished, "Result is already finished");
   diag_assert_msg(duration >= 0, "Negative duration {} is not valid", fmt_duration(duration));
@@ -8,14 +8,22 @@ typedef struct {
   SourceLoc source;
 } CheckError;
 
+typedef struct {
+  String       name;
+  u64          itrs;
+  TimeDuration dur; // Median duration of a single run ('itrs' iterations).
+} CheckBench;
+
 typedef struct {
   Allocator*   alloc;
   bool         finished, errorsTruncated;
   TimeDuration duration;
   DynArray     errors; // CheckError[]
+  DynArray     benchs; // CheckBench[]
 } CheckResult;
 
 CheckResult* check_result_create(Allocator*);
 void         check_result_destroy(CheckResult*);
 void         check_result_error(CheckResult*, String msg, SourceLoc);
+void         check_result_bench(CheckResult*, String name, u64 itrs, TimeDuration dur);
 void         check_result_finish(CheckResult*, TimeDuration);
@@ -43,11 +43,14 @@ void cli_parse_destroy(CliInvocation*);
 
 /**
  * Retrieve the result of parsing the given invocation.
+ * NOTE: Runs any validators that have not run yet; validators are lazy and otherwise only run on
+ * the first value read of their option.
  */
 CliParseResult cli_parse_result(const CliInvocation*);
 
 /**
  * Retrieve the errors that occurred during the parsing of the given invocation.
+ * NOTE: Runs any validators that have not run yet (see 'cli_parse_result').
  */
 CliParseErrors cli_parse_errors(const CliInvocation*);
 
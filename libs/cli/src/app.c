@@ -1,5 +1,7 @@
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/ascii.h"
+#include "core/compare.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
 #include "core/path.h"
@@ -15,8 +17,12 @@ CliApp* cli_app_create(Allocator* alloc) {
              .name       = path_stem(g_pathExecutable),
              .options    = dynarray_create_t(alloc, CliOption, 16),
              .exclusions = dynarray_create_t(alloc, CliExclusion, 8),
-             .alloc      = alloc,
-             .allocAux   = alloc_chunked_create(alloc, alloc_bump_create, cli_app_aux_chunk_size),
+             .table      = {
+                      .names     = dynarray_create_t(alloc, CliTableName, 16),
+                      .positions = dynarray_create_t(alloc, CliId, 4),
+      },
+             .alloc    = alloc,
+             .allocAux = alloc_chunked_create(alloc, alloc_bump_create, cli_app_aux_chunk_size),
   };
   return app;
 }
@@ -25,6 +31,8 @@ void cli_app_destroy(CliApp* app) {
   alloc_chunked_destroy(app->allocAux);
   dynarray_destroy(&app->options);
   dynarray_destroy(&app->exclusions);
+  dynarray_destroy(&app->table.names);
+  dynarray_destroy(&app->table.positions);
 
   alloc_free_t(app->alloc, app);
 }
@@ -63,6 +71,7 @@ CliId cli_register_flag(
           .character = character,
           .name      = string_dup(app->allocAux, name),
       }};
+  app->table.ready = false;
   return id;
 }
 
@@ -87,6 +96,7 @@ CliId cli_register_arg(CliApp* app, const String name, const CliOptionFlags flag
           .position = position,
           .name     = string_dup(app->allocAux, name),
       }};
+  app->table.ready = false;
   return id;
 }
 
@@ -190,6 +200,41 @@ bool cli_excludes(const CliApp* app, const CliId a, const CliId b) {
   return false;
 }
 
+static i8 cli_compare_table_name(const void* a, const void* b) {
+  return compare_stringhash(
+      field_ptr(a, CliTableName, nameHash), field_ptr(b, CliTableName, nameHash));
+}
+
+void cli_app_table_update(CliApp* app) {
+  if (app->table.ready) {
+    return;
+  }
+  mem_set(array_mem(app->table.charLookup), 0xFF); // Fill with 'sentinel_u16' entries.
+  dynarray_clear(&app->table.names);
+  dynarray_clear(&app->table.positions);
+
+  for (CliId id = 0; id != app->options.size; ++id) {
+    const CliOption* opt = dynarray_at_t(&app->options, id, CliOption);
+    switch (opt->type) {
+    case CliOptionType_Flag:
+      if (opt->dataFlag.character) {
+        app->table.charLookup[opt->dataFlag.character] = id;
+      }
+      *dynarray_push_t(&app->table.names, CliTableName) = (CliTableName){
+          .nameHash = string_hash(opt->dataFlag.name),
+          .id       = id,
+      };
+      break;
+    case CliOptionType_Arg:
+      // NOTE: Positions are assigned in registration order (see 'cli_register_arg').
+      *dynarray_push_t(&app->table.positions, CliId) = id;
+      break;
+    }
+  }
+  dynarray_sort(&app->table.names, cli_compare_table_name);
+  app->table.ready = true;
+}
+
 CliOption* cli_option(const CliApp* app, const CliId id) {
   diag_assert_msg(id < app->options.size, "Out of bounds CliId");
   return dynarray_at_t(&app->options, id, CliOption);
@@ -209,6 +254,10 @@ String cli_option_name(const CliApp* app, const CliId id) {
 CliId cli_find_by_character(const CliApp* app, const u8 character) {
   diag_assert_msg(character, "Null is not a valid flag character");
 
+  if (app->table.ready) {
+    return app->table.charLookup[character];
+  }
+  // Fallback for lookups during registration (before the table is built).
   for (CliId id = 0; id != app->options.size; ++id) {
     CliOption* opt = dynarray_at_t(&app->options, id, CliOption);
     if (opt->type == CliOptionType_Flag && opt->dataFlag.character == character) {
@@ -221,6 +270,13 @@ CliId cli_find_by_character(const CliApp* app, const u8 character) {
 CliId cli_find_by_name(const CliApp* app, const String name) {
   diag_assert_msg(!string_is_empty(name), "Empty string is not a valid flag name");
 
+  if (app->table.ready) {
+    const CliTableName  tgt = {.nameHash = string_hash(name)};
+    const CliTableName* entry =
+        dynarray_search_binary((DynArray*)&app->table.names, cli_compare_table_name, &tgt);
+    return entry ? entry->id : sentinel_u16;
+  }
+  // Fallback for lookups during registration (before the table is built).
   for (CliId id = 0; id != app->options.size; ++id) {
     CliOption* opt = dynarray_at_t(&app->options, id, CliOption);
     if (opt->type == CliOptionType_Flag && string_eq(opt->dataFlag.name, name)) {
@@ -231,6 +287,13 @@ CliId cli_find_by_name(const CliApp* app, const String name) {
 }
 
 CliId cli_find_by_position(const CliApp* app, const u16 position) {
+  if (app->table.ready) {
+    if (position >= app->table.positions.size) {
+      return sentinel_u16;
+    }
+    return *dynarray_at_t(&app->table.positions, position, CliId);
+  }
+  // Fallback for lookups during registration (before the table is built).
   for (CliId id = 0; id != app->options.size; ++id) {
     CliOption* opt = dynarray_at_t(&app->options, id, CliOption);
     if (opt->type == CliOptionType_Arg && opt->dataArg.position == position) {
@@ -32,11 +32,28 @@ typedef struct {
   };
 } CliOption;
 
+typedef struct {
+  StringHash nameHash;
+  CliId      id;
+} CliTableName;
+
+/**
+ * Precompiled option lookup table, avoids scanning all options per input argument while parsing.
+ * Built lazily from the registered options (see 'cli_app_table_update').
+ */
+typedef struct {
+  bool     ready;
+  CliId    charLookup[256]; // Per character: the matching flag, 'sentinel_u16' when unbound.
+  DynArray names;           // CliTableName[], sorted on the nameHash.
+  DynArray positions;       // CliId[], indexed by the argument position.
+} CliTable;
+
 struct sCliApp {
   String     name;
   String     desc;
   DynArray   options;    // CliOption[]
   DynArray   exclusions; // CliExclusion[]
+  CliTable   table;
   Allocator* alloc;
   Allocator* allocAux; // (chunked) bump allocator for axillary data (eg option names).
 };
@@ -44,6 +61,11 @@ struct sCliApp {
 CliOption* cli_option(const CliApp*, CliId);
 String     cli_option_name(const CliApp* app, CliId);
 
+/**
+ * (Re)build the precompiled option lookup table when its out of date with the registered options.
+ */
+void cli_app_table_update(CliApp*);
+
 /**
  * Find an option by its character
  * NOTE: Returns 'sentinel_u16' if no option was found with the given character
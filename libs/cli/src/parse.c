@@ -11,14 +11,16 @@
 
 typedef struct {
   bool     provided;
-  DynArray values; // String[]
+  bool     validated; // Validator has run for this option's values.
+  DynArray values;    // String[]
 } CliInvocationOption;
 
 struct sCliInvocation {
-  Allocator* alloc;
-  Allocator* allocText; // Chunked allocator for text data.
-  DynArray   errors;    // String[]
-  DynArray   options;   // CliInvocationOption[]
+  const CliApp* app;
+  Allocator*    alloc;
+  Allocator*    allocText; // Chunked allocator for text data.
+  DynArray      errors;    // String[]
+  DynArray      options;   // CliInvocationOption[]
 };
 
 typedef struct {
@@ -269,24 +271,40 @@ static void cli_parse_options(CliParseCtx* ctx) {
   }
 }
 
-static void cli_parse_check_validator(CliParseCtx* ctx, const CliId optId) {
-  CliInvocationOption* invocOpt = dynarray_at_t(&ctx->options, optId, CliInvocationOption);
-  dynarray_for_t(&invocOpt->values, String, val) {
-    if (!cli_option(ctx->app, optId)->validator(*val)) {
+/**
+ * Run the option's validator over its values (if any), memoized so it runs at most once.
+ * Validation is lazy: it happens on the first value read of an option (or when querying the
+ * invocation result / errors), avoiding potentially expensive checks for options that are never
+ * read.
+ */
+static void cli_invocation_validate_option(CliInvocation* invoc, const CliId id) {
+  CliInvocationOption* opt = cli_invocation_option(invoc, id);
+  if (opt->validated) {
+    return;
+  }
+  opt->validated                  = true;
+  const CliValidateFunc validator = cli_option(invoc->app, id)->validator;
+  if (!validator) {
+    return;
+  }
+  dynarray_for_t(&opt->values, String, val) {
+    if (!validator(*val)) {
       const String err = fmt_write_scratch(
           "Invalid input '{}' for option '{}'",
           fmt_text(*val, .flags = FormatTextFlags_EscapeNonPrintAscii),
-          fmt_text(cli_option_name(ctx->app, optId)));
-      cli_parse_add_error(ctx, err);
+          fmt_text(cli_option_name(invoc->app, id)));
+      const String errDup = string_dup(invoc->allocText, err);
+      if (UNLIKELY(!errDup.ptr)) {
+        diag_crash_msg("Cli text allocator ran out of space");
+      }
+      *dynarray_push_t(&invoc->errors, String) = errDup;
     }
   }
 }
 
-static void cli_parse_check_validators(CliParseCtx* ctx) {
-  for (CliId optId = 0; optId != ctx->options.size; ++optId) {
-    if (cli_option(ctx->app, optId)->validator) {
-      cli_parse_check_validator(ctx, optId);
-    }
+static void cli_invocation_validate_all(CliInvocation* invoc) {
+  for (CliId id = 0; id != invoc->options.size; ++id) {
+    cli_invocation_validate_option(invoc, id);
   }
 }
 
@@ -357,6 +375,8 @@ static void cli_parse_check_required_options(CliParseCtx* ctx) {
 }
 
 CliInvocation* cli_parse(const CliApp* app, const String* input, const u32 inputCount) {
+  cli_app_table_update((CliApp*)app); // Lazily (re)build the precompiled option lookup table.
+
   Allocator* allocText = alloc_chunked_create(app->alloc, alloc_bump_create, cli_text_chunk_size);
 
   CliParseCtx ctx = {
@@ -380,13 +400,13 @@ CliInvocation* cli_parse(const CliApp* app, const String* input, const u32 input
   }
 
   cli_parse_options(&ctx);
-  cli_parse_check_validators(&ctx);
   cli_parse_check_exclusions(&ctx);
   cli_parse_check_required_options(&ctx);
 
   CliInvocation* invoc = alloc_alloc_t(app->alloc, CliInvocation);
 
   *invoc = (CliInvocation){
+      .app       = app,
       .alloc     = app->alloc,
       .allocText = allocText,
       .errors    = ctx.errors,
@@ -407,10 +427,12 @@ void cli_parse_destroy(CliInvocation* invoc) {
 }
 
 CliParseResult cli_parse_result(const CliInvocation* invoc) {
+  cli_invocation_validate_all((CliInvocation*)invoc);
   return invoc->errors.size ? CliParseResult_Fail : CliParseResult_Success;
 }
 
 CliParseErrors cli_parse_errors(const CliInvocation* invoc) {
+  cli_invocation_validate_all((CliInvocation*)invoc);
   return (CliParseErrors){
       .values = invoc->errors.size ? dynarray_at_t(&invoc->errors, 0, String) : null,
       .count  = invoc->errors.size,
@@ -422,6 +444,7 @@ bool cli_parse_provided(const CliInvocation* invoc, const CliId id) {
 }
 
 CliParseValues cli_parse_values(const CliInvocation* invoc, const CliId id) {
+  cli_invocation_validate_option((CliInvocation*)invoc, id);
   const CliInvocationOption* opt = cli_invocation_option((CliInvocation*)invoc, id);
   return (CliParseValues){
       .values = opt->values.size ? dynarray_at_t(&opt->values, 0, String) : null,
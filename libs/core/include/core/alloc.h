@@ -58,6 +58,15 @@ extern Allocator* g_allocPage;
  */
 extern Allocator* g_allocPersist;
 
+/**
+ * Frame allocator, wait-free bump allocator for transient data that lives for a single frame.
+ * Threads bump-allocate from thread-local chunks claimed from a shared fixed-size heap; all
+ * allocations are freed in one go when the app runner resets the allocator at the end of the
+ * frame (individual frees are not needed).
+ * NOTE: Thread-safe, apart from 'alloc_reset()' which requires no concurrent allocations.
+ */
+extern Allocator* g_allocFrame;
+
 /**
  * Scratch allocator, allocates from a fixed size thread-local circular heap buffer.
  * Meant for very short lived allocations. As its backed by a fixed-size buffer allocations will be
@@ -137,6 +146,31 @@ usize alloc_max_size(Allocator*);
  */
 void alloc_reset(Allocator*);
 
+/**
+ * Opt-in to huge-page (transparent 2MiB pages on linux) backing for large page allocations.
+ * Reduces TLB pressure for big long-lived buffers (for example asset payloads).
+ * NOTE: Best effort, only applies to allocations of at least 2MiB and silently falls back to
+ * regular pages when huge pages are unavailable. Currently a no-op on win32.
+ */
+void alloc_page_huge_enable(bool);
+bool alloc_page_huge_enabled(void);
+
+/**
+ * Query the amount of NUMA (Non-Uniform-Memory-Access) nodes in the system.
+ * Returns 1 on systems without multiple memory nodes.
+ */
+u32 alloc_page_numa_node_count(void);
+
+/**
+ * Set a thread-local NUMA node hint for page allocations made by the calling thread.
+ * Allows worker threads to keep their allocations local to the socket they are pinned to.
+ * NOTE: Best effort, the kernel is free to fall back to the default placement policy.
+ * Pre-condition: node < alloc_page_numa_node_count().
+ */
+void alloc_page_numa_hint_set(u32 node);
+void alloc_page_numa_hint_clear(void);
+u32  alloc_page_numa_hint(void); // Sentinel when no hint is active on the calling thread.
+
 /**
  * Allocation statistics.
  * NOTE: Does not include global memory, stacks and memory allocated by external apis.
@@ -152,6 +186,22 @@ typedef struct {
 
 AllocStats alloc_stats_query(void);
 
+/**
+ * Statistical allocation sampling.
+ * Captures a stack every 'intervalBytes' allocated heap bytes and aggregates the samples per
+ * call-site. Much cheaper then full tracking, cheap enough to leave enabled in production.
+ */
+typedef struct sAllocSampleInfo {
+  SymbolAddrRel addr;  // Call-site of the sampled allocations.
+  u64           count; // Amount of sampled allocations from this call-site.
+  u64           size;  // Total sampled bytes from this call-site.
+} AllocSampleInfo;
+
+void  alloc_sample_set_interval(usize intervalBytes); // 0 disables sampling.
+usize alloc_sample_interval(void);
+void  alloc_sample_reset(void);
+usize alloc_sample_query(AllocSampleInfo*, usize outCapacity); // Sorted on size, descending.
+
 /**
  * Dump the active heap allocations to std-out.
  * NOTE: Requires memory-tracking to be compiled in.
@@ -129,6 +129,12 @@ void bitset_or(BitSet, BitSet other);
  */
 void bitset_and(BitSet, BitSet other);
 
+/**
+ * Perform a bit-wise 'and' with the complement of the other bits; unsets all bits that are set in
+ * the other BitSet.
+ */
+void bitset_and_not(BitSet, BitSet other);
+
 /**
  * Perform a bit-wise 'exclusive-or' operation over all the bits.
  * Pre-condition: bitset_size(other) >= bitset_size
@@ -14,3 +14,17 @@ typedef enum {
  * The decoded data is written to the given DynString.
  */
 String deflate_decode(String input, DynString* out, DeflateError*);
+
+/**
+ * Encode (deflate) data into a DEFLATE (RFC 1951) compressed data stream.
+ * The encoded data is written to the given DynString.
+ */
+void deflate_encode(String input, DynString* out);
+
+/**
+ * Encode a single chunk of a DEFLATE (RFC 1951) compressed data stream.
+ * Each chunk ends on a byte boundary, so chunks encoded independently (for example on different
+ * threads) can be concatenated to form a single valid stream. The last chunk terminates the stream.
+ * The encoded data is written to the given DynString.
+ */
+void deflate_encode_chunk(String input, bool last, DynString* out);
@@ -25,6 +25,25 @@ typedef void (*CrashHandler)(String msg, void* context);
  */
 #define diag_assert(_CONDITION_) diag_assert_msg(_CONDITION_, #_CONDITION_)
 
+/**
+ * Assert the given condition evaluates to true.
+ * Hot variant: for checks on performance critical paths (for example per-allocation or
+ * per-iteration checks); compiled out when the 'VOLO_ASSERT_HOT' option is disabled, which allows
+ * profiling builds to keep the structural asserts while avoiding the per-operation overhead.
+ */
+#if !defined(VOLO_RELEASE) && defined(VOLO_ASSERT_HOT)
+#define diag_assert_hot_msg(_CONDITION_, _MSG_FORMAT_LIT_, ...)                                    \
+  diag_assert_msg(_CONDITION_, _MSG_FORMAT_LIT_, __VA_ARGS__)
+#else
+#define diag_assert_hot_msg(_CONDITION_, _MSG_FORMAT_LIT_, ...)
+#endif
+
+/**
+ * Assert the given condition evaluates to true.
+ * Hot variant, see 'diag_assert_hot_msg()' for details.
+ */
+#define diag_assert_hot(_CONDITION_) diag_assert_hot_msg(_CONDITION_, #_CONDITION_)
+
 /**
  * Print a message to the stdout stream.
  */
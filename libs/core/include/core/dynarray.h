@@ -14,6 +14,7 @@ typedef struct sDynArray {
   usize      size;
   u32        stride;
   u16        align;
+  bool       ownsMem; // Backing memory is owned (and thus freed) by this array.
 } DynArray;
 
 /**
@@ -103,6 +104,12 @@ DynArray dynarray_create(Allocator*, u32 stride, u16 align, usize capacity);
  */
 DynArray dynarray_create_over(Mem, u32 stride);
 
+/**
+ * Create a new dynamic array over the given memory that spills to the given allocator when the
+ * memory runs out. The initial memory is not owned by the array (and thus never freed).
+ */
+DynArray dynarray_create_over_spill(Mem, u32 stride, u16 align, Allocator*);
+
 /**
  * Free resources held by the dynamic-array.
  */
@@ -122,9 +129,17 @@ void dynarray_resize(DynArray*, usize size);
 
 /**
  * Increase the capacity of the dynamic-array, will allocate when bigger then the current.
+ * NOTE: Allocates exactly the given capacity; unlike growth from pushes (which overshoots
+ * geometrically) this does not reserve any slack.
  */
 void dynarray_reserve(DynArray*, usize capacity);
 
+/**
+ * Reduce the capacity of the dynamic-array to exactly fit the current size, freeing the slack.
+ * NOTE: No-op for arrays that do not own their memory (for example created with 'create_over').
+ */
+void dynarray_shrink_to_fit(DynArray*);
+
 /**
  * Resizes the dynamic-array to be 0 length.
  */
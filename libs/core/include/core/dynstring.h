@@ -9,6 +9,14 @@
  */
 typedef DynArray DynString;
 
+/**
+ * Create a new dynamic string with a small inline (stack) buffer of '_SIZE_' bytes; only allocates
+ * from the given allocator when the buffer runs out. Useful for typically-small transient strings.
+ * NOTE: The string must not outlive the current stack frame.
+ */
+#define dynstring_create_inline(_ALLOCATOR_, _SIZE_)                                               \
+  dynstring_create_over_spill(mem_stack(_SIZE_), (_ALLOCATOR_))
+
 /**
  * Create a new dynamic string.
  * 'capacity' determines the size of the initial allocation, further allocations will be made
@@ -23,6 +31,12 @@ DynString dynstring_create(Allocator*, usize capacity);
  */
 DynString dynstring_create_over(Mem);
 
+/**
+ * Create a new dynamic string over the given memory that spills to the given allocator when the
+ * memory runs out. The initial memory is not owned by the string (and thus never freed).
+ */
+DynString dynstring_create_over_spill(Mem, Allocator*);
+
 /**
  * Free resources held by the dynamic-string.
  */
@@ -26,6 +26,7 @@ typedef enum eFileResult {
   FileResult_FileEmpty,
   FileResult_FileTooBig,
   FileResult_InvalidMapping,
+  FileResult_WouldBlock,
   FileResult_UnknownError,
 
   FileResult_Count,
@@ -79,8 +80,10 @@ typedef struct sFileInfo {
  * File mapping (performance) hints.
  */
 typedef enum eFileHints {
-  FileHints_None     = 0,
-  FileHints_Prefetch = 1 << 0, // Start reading the file in the background.
+  FileHints_None       = 0,
+  FileHints_Prefetch   = 1 << 0, // Start reading the file in the background.
+  FileHints_Sequential = 1 << 1, // Expect sequential access (enables aggressive read-ahead).
+  FileHints_Random     = 1 << 2, // Expect random access (disables read-ahead).
 } FileHints;
 
 extern File* g_fileStdIn;
@@ -204,6 +207,14 @@ FileResult file_map(File*, usize offset, usize size, FileHints, String* output);
  */
 FileResult file_unmap(File*, String mapping);
 
+/**
+ * Apply (performance) hints to a region of a mapped file.
+ * Useful for streaming from huge mapped pack files: prefetch windows of the mapping ahead of use
+ * and tune the read-ahead behavior, without copying the data to the heap.
+ * NOTE: The region has to be contained in a mapping created with 'file_map()'.
+ */
+FileResult file_map_advise(File*, String region, FileHints);
+
 /**
  * Rename the file at the given path.
  * NOTE: oldPath and newPath need to be on the same filesystem.
@@ -0,0 +1,59 @@
+#pragma once
+#include "core/file.h"
+
+/**
+ * Asynchronous file operation queue.
+ * Allows issuing many overlapping reads / writes from a single thread, results are retrieved by
+ * polling (or waiting for) the individual operations.
+ * On Linux the queue is backed by io_uring; when that is unavailable (or on other platforms)
+ * operations complete synchronously at submission time.
+ * NOTE: Api is thread-safe.
+ */
+typedef struct sFileAsync FileAsync;
+
+/**
+ * Identifier for a submitted asynchronous operation.
+ */
+typedef u32 FileAsyncId;
+
+/**
+ * Create a new asynchronous operation queue.
+ * Destroy using 'file_async_destroy()'.
+ */
+FileAsync* file_async_create(Allocator*);
+
+/**
+ * Destroy an asynchronous operation queue.
+ * NOTE: Blocks until all pending operations have completed.
+ */
+void file_async_destroy(FileAsync*);
+
+/**
+ * Read up to 'buffer.size' bytes at the given file offset into the buffer.
+ * NOTE: The buffer (and the file handle) have to stay valid until the operation completes.
+ * NOTE: When the queue is full this blocks until an operation completes.
+ */
+FileAsyncId file_async_read(FileAsync*, File*, usize offset, Mem buffer);
+
+/**
+ * Write the given data at the given file offset.
+ * NOTE: The data (and the file handle) have to stay valid until the operation completes.
+ * NOTE: When the queue is full this blocks until an operation completes.
+ */
+FileAsyncId file_async_write(FileAsync*, File*, usize offset, String data);
+
+/**
+ * Poll for the completion of the given operation.
+ *
+ * Returns:
+ * 'true':  Operation completed; its result and transferred byte count are written to the output
+ *          pointers. A read of zero bytes results in 'FileResult_NoDataAvailable' (end of file).
+ * 'false': Operation is still in flight.
+ */
+bool file_async_poll(FileAsync*, FileAsyncId, FileResult* outResult, usize* outBytes);
+
+/**
+ * Wait for the completion of the given operation.
+ * NOTE: Blocks until the operation has completed.
+ */
+FileResult file_async_wait(FileAsync*, FileAsyncId, usize* outBytes);
@@ -1,5 +1,6 @@
 #pragma once
 #include "core/string.h"
+#include "core/time.h"
 
 /**
  * File Monitor.
@@ -75,3 +76,18 @@ FileMonitorResult file_monitor_watch(FileMonitor*, String path, u64 userData);
  * 'false': When no more events are available at this time.
  */
 bool file_monitor_poll(FileMonitor*, FileMonitorEvent* out);
+
+/**
+ * Poll for a batch of file-monitor events.
+ * Coalesces events that occur within the given window: after observing the first event it keeps
+ * collecting (and de-duplicating) events until the window has elapsed and then delivers them as a
+ * single array. This allows consumers to react once per burst of modifications (for example a bulk
+ * export touching many files) instead of once per file.
+ *
+ * NOTE: Returns immediately (without waiting for the window) when no events are available.
+ * NOTE: Returns early when the output array capacity is reached.
+ *
+ * Returns the number of events written to the output array.
+ */
+usize file_monitor_poll_many(
+    FileMonitor*, TimeDuration window, FileMonitorEvent out[], usize outCapacity);
@@ -67,6 +67,18 @@ f16 float_f32_to_f16(f32);
  */
 f32 float_f16_to_f32(f16);
 
+/**
+ * Convert a batch of 32 bit floating point values to 16 bit.
+ * NOTE: 'out' is allowed to alias 'in' (conversion in place).
+ */
+void float_f32_to_f16_batch(const f32 in[], f16 out[], usize count);
+
+/**
+ * Convert a batch of 16 bit floating point values to 32 bit.
+ * Pre-condition: 'in' and 'out' do not overlap.
+ */
+void float_f16_to_f32_batch(const f16 in[], f32 out[], usize count);
+
 /**
  * Quantize a float to use a limited number of mantissa bits.
  * Pre-condition: maxMantissaBits > 0 && maxMantissaBits <= 23
@@ -355,6 +355,20 @@ struct sFormatArg {
 #define fmt_write_scratch(_FORMAT_LIT_, ...)                                                       \
   format_write_formatted_scratch(string_lit(_FORMAT_LIT_), fmt_args(__VA_ARGS__))
 
+/**
+ * Write a format string with arguments; identical to 'fmt_write' except the format string is
+ * parsed only on the first execution (stored in a hidden static) instead of at every call.
+ * Meant for hot paths that format the same literal many times.
+ */
+#define fmt_write_compiled(_DYNSTRING_, _FORMAT_LIT_, ...)                                         \
+  do {                                                                                             \
+    static FormatCompiled g_fmtCompiled_;                                                          \
+    format_write_compiled(                                                                         \
+        (_DYNSTRING_),                                                                             \
+        format_compile_lazy(&g_fmtCompiled_, string_lit(_FORMAT_LIT_)),                            \
+        fmt_args(__VA_ARGS__));                                                                    \
+  } while (false)
+
 /**
  * Create a formatted string in scratch memory. Meant for very short lived strings as the scratch
  * memory will be overwritten eventually.
@@ -403,6 +417,42 @@ String format_write_arg_scratch(const FormatArg*);
  */
 void format_write_formatted(DynString*, String format, const FormatArg* args);
 
+#define format_compiled_max_spans 16
+
+/**
+ * Pre-parsed format string; compile once with 'format_compile' and execute many times with
+ * 'format_write_compiled'. Fields are implementation details, do not access them directly.
+ * NOTE: References the format string memory, the format string must outlive this object.
+ */
+typedef struct sFormatCompiled {
+  i32    ready; // Used by 'format_compile_lazy', loaded / stored atomically.
+  u32    spanCount;
+  String tail; // Literal text after the last replacement.
+  struct {
+    String text; // Literal text emitted before this argument.
+    u32    padKind;
+    i32    padAmount;
+  } spans[format_compiled_max_spans];
+} FormatCompiled;
+
+/**
+ * Pre-parse the given format string.
+ * Pre-condition: format contains at most 'format_compiled_max_spans' replacements.
+ */
+void format_compile(FormatCompiled*, String format);
+
+/**
+ * Pre-parse the given format string on the first call; later calls return the existing result.
+ * Safe to call from multiple threads (concurrent first calls compile redundantly but identically).
+ */
+const FormatCompiled* format_compile_lazy(FormatCompiled*, String format);
+
+/**
+ * Write a pre-parsed format string with arguments; output is identical to
+ * 'format_write_formatted' with the original format string.
+ */
+void format_write_compiled(DynString*, const FormatCompiled*, const FormatArg* args);
+
 /**
  * Create a formatted string in scratch memory. Meant for very short lived strings as the scratch
  * memory will be overwritten eventually.
@@ -30,3 +30,17 @@ String gzip_error_str(GzipError);
  * The decoded data is written to the given DynString.
  */
 String gzip_decode(String input, GzipMeta* outMeta, DynString* out, GzipError*);
+
+/**
+ * Encode a GZIP (RFC 1952) compressed data stream.
+ * The encoded data is written to the given DynString.
+ */
+void gzip_encode(String input, DynString* out);
+
+/**
+ * Encode only the GZIP header / trailer, for callers that produce the contained deflate stream
+ * themselves (for example in parallel chunks).
+ * NOTE: The trailer is computed over the uncompressed input.
+ */
+void gzip_encode_header(DynString* out);
+void gzip_encode_trailer(String input, DynString* out);
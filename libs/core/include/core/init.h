@@ -1,4 +1,6 @@
 #pragma once
+#include "core/string.h"
+#include "core/time.h"
 
 /**
  * Initialize all the core subsystems.
@@ -11,3 +13,28 @@ void core_init(void);
  * Should be called once at application shutdown.
  */
 void core_teardown(void);
+
+/**
+ * Named startup phase timing.
+ * Phases are recorded into a static buffer so timings of phases that run before the tracer (or
+ * logger) is ready can still be reported afterwards.
+ */
+typedef struct sCoreInitPhase {
+  String       name;
+  TimeSteady   timeBegin;
+  TimeDuration duration;
+} CoreInitPhase;
+
+/**
+ * Record a named startup phase; each begin has to be matched with an end before the next begin.
+ * Pre-condition: Should only be called from the main-thread.
+ * Pre-condition: name is constant throughout the program (for example a literal).
+ */
+void core_init_phase_begin(String name);
+void core_init_phase_end(void);
+
+/**
+ * Retrieve the recorded startup phases.
+ */
+const CoreInitPhase* core_init_phase_data(void);
+u32                  core_init_phase_count(void);
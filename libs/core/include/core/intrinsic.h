@@ -123,6 +123,12 @@ MAYBE_UNUSED INLINE_HINT static f64 intrinsic_round_up_f64(const f64 v) {
 #define intrinsic_popcnt_32 _mm_popcnt_u32
 #define intrinsic_popcnt_64 _mm_popcnt_u64
 
+/**
+ * Hint to the cpu to fetch the cache-line containing the given address.
+ * NOTE: Never faults, the address does not need to point to valid memory.
+ */
+#define intrinsic_prefetch(_PTR_) _mm_prefetch((const char*)(_PTR_), _MM_HINT_T0)
+
 /**
  * Pre-condition: mask != 0.
  */
@@ -6,3 +6,34 @@
  * Returns a float in the -1 to 1 range.
  */
 f32 noise_perlin3(f32 x, f32 y, f32 z);
+
+/**
+ * Evaluate 3d perlin noise for 'count' samples in a single call.
+ * Considerably faster then sampling one value at a time; samples are evaluated 4 at a time.
+ */
+void noise_perlin3_many(const f32 xs[], const f32 ys[], const f32 zs[], f32 out[], usize count);
+
+/**
+ * Fractional brownian motion: sum multiple perlin noise octaves, each octave scaling the frequency
+ * by 'lacunarity' and the amplitude by 'persistence'.
+ * Returns a float in the -1 to 1 range (the octaves are normalized by the total amplitude).
+ *
+ * Pre-condition: octaves > 0
+ */
+f32 noise_perlin3_fbm(f32 x, f32 y, f32 z, u32 octaves, f32 lacunarity, f32 persistence);
+
+/**
+ * Evaluate fractional brownian motion for 'count' samples in a single call.
+ * Samples are evaluated 4 at a time with the accumulation kept in registers across the octaves.
+ *
+ * Pre-condition: octaves > 0
+ */
+void noise_perlin3_fbm_many(
+    const f32 xs[],
+    const f32 ys[],
+    const f32 zs[],
+    f32       out[],
+    usize     count,
+    u32       octaves,
+    f32       lacunarity,
+    f32       persistence);
@@ -75,6 +75,8 @@ String path_parent(String);
  *
  * NOTE: Only performs basic lexical canonization, does NOT resolve symlinks, or validate that the
  * path is compatible with the underlying filesystem.
+ * NOTE: The canonical directory prefix is cached per thread, building many sibling paths in the
+ * same directory (for example during directory scans) only canonizes the directory once.
  * Return false if there was no canonical form possible.
  */
 bool   path_canonize(DynString*, String path);
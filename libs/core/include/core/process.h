@@ -16,6 +16,12 @@ typedef enum {
   ProcessFlags_PipeStdErr = 1 << 2, // Create a pipe for reading from std-err.
   ProcessFlags_NewGroup   = 1 << 3, // Create a new process group for the child proccess.
   ProcessFlags_Detached   = 1 << 4, // Leave the process running when closing the handle.
+
+  // Non-blocking reads from the std-out / std-err pipes: when the child has not produced data the
+  // read returns 'FileResult_WouldBlock' instead of waiting. Useful for polling the output of many
+  // concurrent child processes from a single thread.
+  ProcessFlags_NonBlockingOutput = 1 << 5,
+
   ProcessFlags_PipeAny = ProcessFlags_PipeStdIn | ProcessFlags_PipeStdOut | ProcessFlags_PipeStdErr,
 } ProcessFlags;
 
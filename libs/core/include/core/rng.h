@@ -32,6 +32,25 @@ u32 rng_sample_u32(Rng*);
  */
 f32 rng_sample_f32(Rng*);
 
+/**
+ * Get the next 'count' values in the random sequence in a single call.
+ * Considerably faster then sampling one value at a time when many samples are needed.
+ *
+ * rng_sample_many_u32: u32's with a uniform distribution.
+ * rng_sample_many_f32: f32's between 0.0 (inclusive) and 1.0 (exclusive), uniform distribution.
+ */
+void rng_sample_many_u32(Rng*, u32 out[], usize count);
+void rng_sample_many_f32(Rng*, f32 out[], usize count);
+
+/**
+ * Get the next value in the random sequence.
+ * Returns a u32 between min (inclusive) and max (exclusive) with a uniform distribution.
+ * NOTE: Unlike the 'rng_sample_range' macro this does not suffer from float rounding bias.
+ *
+ * Pre-condition: max > min
+ */
+u32 rng_sample_range_u32(Rng*, u32 min, u32 max);
+
 typedef struct {
   f32 a, b;
 } RngGaussPairF32;
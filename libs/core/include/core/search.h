@@ -25,6 +25,84 @@ void* search_linear(u8* begin, u8* end, u16 stride, CompareFunc, const void* tgt
  */
 void* search_binary(u8* begin, u8* end, u16 stride, CompareFunc, const void* tgt);
 
+/**
+ * Returns an element matching the given target or null if none matched.
+ * Branchless variant of 'search_binary'; the probe locations do not depend on the comparison
+ * outcomes which avoids branch mispredictions on unpredictable keys.
+ * Pre-condition: data is sorted.
+ */
+#define search_binary_branchless_t(_BEGIN_, _END_, _TYPE_, _COMPARE_FUNC_, _TGT_)                  \
+  ((_TYPE_*)search_binary_branchless(                                                              \
+      (u8*)(_BEGIN_), (u8*)(_END_), sizeof(_TYPE_), (_COMPARE_FUNC_), (_TGT_)))
+
+/**
+ * Returns an element matching the given target or null if none matched.
+ * Branchless variant of 'search_binary'; the probe locations do not depend on the comparison
+ * outcomes which avoids branch mispredictions on unpredictable keys.
+ * Pre-condition: data is sorted.
+ */
+void* search_binary_branchless(u8* begin, u8* end, u16 stride, CompareFunc, const void* tgt);
+
+/**
+ * Find matching elements for many targets in a single forward walk over the data.
+ * For each target 'out' receives a pointer to a matching element (or null if none matched).
+ * Considerably faster then separate searches when the targets are dense in the data.
+ * Pre-condition: data is sorted.
+ * Pre-condition: targets are sorted (by the same compare function).
+ */
+#define search_binary_many_t(_BEGIN_, _END_, _TYPE_, _COMPARE_FUNC_, _TGTS_, _TGT_COUNT_, _OUT_)   \
+  search_binary_many(                                                                              \
+      (u8*)(_BEGIN_),                                                                              \
+      (u8*)(_END_),                                                                                \
+      sizeof(_TYPE_),                                                                              \
+      (_COMPARE_FUNC_),                                                                            \
+      (const u8*)(_TGTS_),                                                                         \
+      (_TGT_COUNT_),                                                                               \
+      (_OUT_))
+
+/**
+ * Find matching elements for many targets in a single forward walk over the data.
+ * For each target 'out' receives a pointer to a matching element (or null if none matched).
+ * Considerably faster then separate searches when the targets are dense in the data.
+ * Pre-condition: data is sorted.
+ * Pre-condition: targets are sorted (by the same compare function).
+ */
+void search_binary_many(
+    u8* begin, u8* end, u16 stride, CompareFunc, const u8* tgts, usize tgtCount, void* out[]);
+
+/**
+ * Fill 'out' with the given sorted elements in Eytzinger (breadth-first) order.
+ * The resulting layout keeps the hot (early) probes of a binary search on the same cache-lines,
+ * use 'search_eytzinger' to search it. Useful for static tables that are built once.
+ * Pre-condition: data is sorted.
+ * Pre-condition: out is at least as big as the input data.
+ */
+#define search_eytzinger_build_t(_BEGIN_, _END_, _TYPE_, _OUT_)                                    \
+  search_eytzinger_build((const u8*)(_BEGIN_), (const u8*)(_END_), sizeof(_TYPE_), (u8*)(_OUT_))
+
+/**
+ * Fill 'out' with the given sorted elements in Eytzinger (breadth-first) order.
+ * The resulting layout keeps the hot (early) probes of a binary search on the same cache-lines,
+ * use 'search_eytzinger' to search it. Useful for static tables that are built once.
+ * Pre-condition: data is sorted.
+ * Pre-condition: out is at least as big as the input data.
+ */
+void search_eytzinger_build(const u8* begin, const u8* end, u16 stride, u8* out);
+
+/**
+ * Returns an element matching the given target or null if none matched.
+ * Pre-condition: data is laid out in Eytzinger order (see 'search_eytzinger_build').
+ */
+#define search_eytzinger_t(_BEGIN_, _END_, _TYPE_, _COMPARE_FUNC_, _TGT_)                          \
+  ((_TYPE_*)search_eytzinger(                                                                      \
+      (u8*)(_BEGIN_), (u8*)(_END_), sizeof(_TYPE_), (_COMPARE_FUNC_), (_TGT_)))
+
+/**
+ * Returns an element matching the given target or null if none matched.
+ * Pre-condition: data is laid out in Eytzinger order (see 'search_eytzinger_build').
+ */
+void* search_eytzinger(u8* begin, u8* end, u16 stride, CompareFunc, const void* tgt);
+
 /**
  * Returns the first element greater then the given target (or null if none was greater).
  * Pre-condition: data is sorted.
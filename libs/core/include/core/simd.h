@@ -176,6 +176,10 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_sub(const SimdVec a, const Simd
   return _mm_sub_ps(a, b);
 }
 
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_add_i32(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_sub_i32(const SimdVec a, const SimdVec b) {
   return _mm_castsi128_ps(_mm_sub_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
 }
@@ -188,6 +192,35 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_div(const SimdVec a, const Simd
   return _mm_div_ps(a, b);
 }
 
+/**
+ * Multiply unsigned 16 bit values and keep the high 16 bits of each 32 bit product.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_mul_hi_u16(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_mulhi_epu16(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+/**
+ * Multiply 16 bit values and keep the low 16 bits of each 32 bit product.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_mul_lo_u16(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_mullo_epi16(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+/**
+ * Multiply the unsigned bytes of 'a' with the signed bytes of 'b' and sum adjacent pairs into
+ * (saturated) 16 bit values.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_mul_add_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_maddubs_epi16(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+/**
+ * Multiply signed 16 bit values and sum adjacent pairs into 32 bit values.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_mul_add_u16(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_madd_epi16(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_xor(const SimdVec a, const SimdVec b) {
   return _mm_xor_ps(a, b);
 }
@@ -200,6 +233,29 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_max(const SimdVec a, const Simd
   return _mm_max_ps(a, b);
 }
 
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_add_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_add_epi8(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_sub_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_sub_epi8(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+/**
+ * Subtract bytes with unsigned saturation (clamps to zero instead of wrapping).
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_sub_sat_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_subs_epu8(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_min_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_min_epu8(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_max_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_max_epu8(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_less(const SimdVec a, const SimdVec b) {
   return _mm_cmplt_ps(a, b);
 }
@@ -226,6 +282,10 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_eq_u8(const SimdVec a, const Si
   return _mm_castsi128_ps(_mm_cmpeq_epi8(_mm_castps_si128(a), _mm_castps_si128(b)));
 }
 
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_less_i32(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_cmplt_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_eq_u32(const SimdVec a, const SimdVec b) {
   return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
 }
@@ -242,6 +302,10 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_pack_u32_to_u16(const SimdVec a
   return _mm_castsi128_ps(_mm_packs_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
 }
 
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_pack_u16_to_u8(const SimdVec a, const SimdVec b) {
+  return _mm_castsi128_ps(_mm_packus_epi16(_mm_castps_si128(a), _mm_castps_si128(b)));
+}
+
 MAYBE_UNUSED INLINE_HINT static u32 simd_vec_mask_u32(const SimdVec a) {
   return _mm_movemask_ps(a);
 }
@@ -250,6 +314,15 @@ MAYBE_UNUSED INLINE_HINT static u32 simd_vec_mask_u8(const SimdVec a) {
   return _mm_movemask_epi8(_mm_castps_si128(a));
 }
 
+/**
+ * Shuffle the bytes of 'vec' using the low 4 bits of the bytes of 'indices'; bytes whose index has
+ * the high bit set are zeroed.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec
+simd_vec_shuffle_u8(const SimdVec vec, const SimdVec indices) {
+  return _mm_castsi128_ps(_mm_shuffle_epi8(_mm_castps_si128(vec), _mm_castps_si128(indices)));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec
 simd_vec_select(const SimdVec a, const SimdVec b, const SimdVec mask) {
   return _mm_blendv_ps(a, b, mask);
@@ -372,6 +445,13 @@ MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_round_down(const SimdVec a) {
   return _mm_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
 }
 
+/**
+ * Convert the f32 components to i32 components, truncating towards zero.
+ */
+MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_f32_to_i32(const SimdVec a) {
+  return _mm_castsi128_ps(_mm_cvttps_epi32(a));
+}
+
 MAYBE_UNUSED INLINE_HINT static SimdVec simd_vec_round_up(const SimdVec a) {
   return _mm_round_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
 }
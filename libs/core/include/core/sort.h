@@ -34,6 +34,15 @@ void sort_quicksort(u8* begin, u8* end, u16 stride, CompareFunc);
  */
 void sort_bubblesort(u8* begin, u8* end, u16 stride, CompareFunc);
 
+/**
+ * Sort unsigned integer keys using a least-significant-digit radix sort.
+ * Runs in linear time, useful for large key collections where comparison sorts dominate.
+ * NOTE: The sort is stable, meaning order of equal elements is preserved.
+ * NOTE: Allocates a temporary buffer of the same size as the input from the heap.
+ */
+void sort_radixsort_u32(u32* begin, u32* end);
+void sort_radixsort_u64(u64* begin, u64* end);
+
 /**
  * Index based sorting routines.
  * Instead of operating directly on memory it operates on indices and leaves the memory operations
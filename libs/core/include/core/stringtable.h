@@ -33,7 +33,7 @@ u32 stringtable_count(const StringTable*);
 /**
  * Lookup a String by hash.
  * NOTE: If the hash has not been added to the table an empty String is returned.
- * NOTE: Thread-safe.
+ * NOTE: Thread-safe and lock-free; never blocks concurrent adds.
  */
 String stringtable_lookup(const StringTable*, StringHash);
 
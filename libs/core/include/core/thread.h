@@ -44,6 +44,37 @@ extern THREAD_LOCAL uptr g_threadStackTop;
  */
 extern u16 g_threadCoreCount;
 
+/**
+ * Maximum amount of logical cpus tracked in the topology.
+ * NOTE: Matches the size of a single win32 processor group; cpus beyond this are ignored.
+ */
+#define thread_topology_max_cpus 64
+
+typedef enum {
+  ThreadCpuType_Performance, // Cores optimized for throughput / latency (eg Intel P-cores).
+  ThreadCpuType_Efficiency,  // Cores optimized for power usage (eg Intel E-cores).
+} ThreadCpuType;
+
+typedef struct {
+  u16           id;      // Logical cpu id as known to the os.
+  u16           coreId;  // Physical core; logical cpus with the same coreId are SMT siblings.
+  u16           cacheId; // Last-level cache domain; cpus with the same cacheId share the cache.
+  ThreadCpuType type;
+} ThreadCpu;
+
+typedef struct {
+  u16       cpuCount;         // Amount of logical cpus available to this process.
+  u16       performanceCount; // Amount of logical cpus of the performance type.
+  u16       efficiencyCount;  // Amount of logical cpus of the efficiency type.
+  ThreadCpu cpus[thread_topology_max_cpus];
+} ThreadTopology;
+
+/**
+ * Cpu topology of the machine.
+ * On machines where the topology cannot be queried all cpus are reported as performance cpus.
+ */
+extern ThreadTopology g_threadTopology;
+
 /**
  * Function to run on an execution thread.
  */
@@ -115,6 +146,7 @@ bool thread_atomic_compare_exchange_i64(i64* ptr, i64* expected, i64 value);
  * This includes a general memory barrier.
  */
 i32 thread_atomic_add_i32(i32*, i32 value);
+u32 thread_atomic_add_u32(u32*, u32 value);
 i64 thread_atomic_add_i64(i64*, i64 value);
 
 /**
@@ -168,6 +200,19 @@ void thread_ensure_init(void);
  */
 bool thread_prioritize(ThreadPriority);
 
+typedef enum {
+  ThreadPin_None,        // Allow the os to schedule the thread on any cpu.
+  ThreadPin_Performance, // Restrict the thread to the performance cpus.
+  ThreadPin_Efficiency,  // Restrict the thread to the efficiency cpus.
+} ThreadPin;
+
+/**
+ * Pin the current thread to a set of cpus (see 'g_threadTopology').
+ * Returns true if successful otherwise false.
+ * NOTE: A no-op (returning true) on machines where all cpus are of the requested type.
+ */
+bool thread_pin(ThreadPin);
+
 /**
  * Wait for the given thread to finish and clean up its resources.
  * NOTE: Should be called exactly once per started thread.
@@ -223,6 +268,18 @@ bool thread_mutex_trylock(ThreadMutex);
  */
 void thread_mutex_unlock(ThreadMutex);
 
+typedef struct {
+  u64          contendedCount; // Amount of lock acquisitions that had to wait.
+  TimeDuration contendedDur;   // Total time threads have spent waiting to acquire mutexes.
+} ThreadMutexStats;
+
+/**
+ * Query the (process wide) mutex contention statistics.
+ * Tracks lock acquisitions that could not be satisfied immediately and how long they waited.
+ * NOTE: Counters accumulate over the application lifetime; diff two queries for an interval view.
+ */
+ThreadMutexStats thread_mutex_stats_query(void);
+
 /**
  * Create a new condition.
  * Should be cleaned up using 'thread_cond_destroy()'.
@@ -40,3 +40,12 @@ void  utf8_cp_write_to(DynString*, Unicode);
  * NOTE: Returns the Unicode NULL (0) character when invalid utf8 is detected.
  */
 String utf8_cp_read(String, Unicode* out);
+
+/**
+ * Bulk-read Unicode codepoints from the given utf8 string.
+ * Reads up to 'capacity' codepoints, the amount read is written to 'outCount'.
+ * Considerably faster then repeated 'utf8_cp_read()' calls for mostly-ascii text.
+ * NOTE: Invalid utf8 sequences decode as the Unicode NULL (0) character.
+ * Returns the remaining utf8 string.
+ */
+String utf8_cp_read_many(String, Unicode out[], usize capacity, usize* outCount);
@@ -23,3 +23,17 @@ String zlib_error_str(ZlibError);
  * The decoded data is written to the given DynString.
  */
 String zlib_decode(String input, DynString* out, ZlibError*);
+
+/**
+ * Encode a ZLIB (RFC 1950) compressed data stream.
+ * The encoded data is written to the given DynString.
+ */
+void zlib_encode(String input, DynString* out);
+
+/**
+ * Encode only the ZLIB header / trailer, for callers that produce the contained deflate stream
+ * themselves (for example in parallel chunks).
+ * NOTE: The trailer is computed over the uncompressed input.
+ */
+void zlib_encode_header(DynString* out);
+void zlib_encode_trailer(String input, DynString* out);
@@ -8,6 +8,7 @@
 #include <sanitizer/asan_interface.h>
 #endif
 
+Allocator*              g_allocFrame;
 Allocator*              g_allocHeap;
 Allocator*              g_allocPage;
 Allocator*              g_allocPageCache;
@@ -36,11 +37,15 @@ void alloc_init(void) {
   g_allocPageCache = alloc_pagecache_init();
   g_allocHeap      = alloc_heap_init();
   g_allocPersist   = alloc_persist_init();
+  g_allocFrame     = alloc_frame_init();
 }
 
 void alloc_leak_detect(void) { alloc_heap_leak_detect(); }
 
 void alloc_teardown(void) {
+  alloc_frame_teardown();
+  g_allocFrame = null;
+
   alloc_persist_teardown();
   g_allocPersist = null;
 
@@ -58,9 +63,13 @@ void alloc_teardown(void) {
 #endif
 }
 
-void alloc_init_thread(void) { g_allocScratch = alloc_scratch_init(); }
+void alloc_init_thread(void) {
+  g_allocScratch = alloc_scratch_init();
+  alloc_heap_init_thread();
+}
 
 void alloc_teardown_thread(void) {
+  alloc_heap_flush_thread();
   alloc_scratch_teardown();
   g_allocScratch = null;
 }
@@ -68,15 +77,15 @@ void alloc_teardown_thread(void) {
 Mem alloc_alloc(Allocator* allocator, const usize size, const usize align) {
   alloc_verify_allocator(allocator);
 
-  diag_assert_msg(size, "alloc_alloc: 0 byte allocations are not valid");
-  diag_assert_msg(
+  diag_assert_hot_msg(size, "alloc_alloc: 0 byte allocations are not valid");
+  diag_assert_hot_msg(
       bits_ispow2(align), "alloc_alloc: Alignment '{}' is not a power-of-two", fmt_int(align));
-  diag_assert_msg(
+  diag_assert_hot_msg(
       bits_aligned(size, align),
       "alloc_alloc: Size '{}' is not a multiple of the alignment '{}'",
       fmt_size(size),
       fmt_int(align));
-  diag_assert_msg(
+  diag_assert_hot_msg(
       size <= alloc_max_alloc_size,
       "alloc_alloc: Size '{}' is bigger then the maximum of '{}'",
       fmt_size(size),
@@ -93,7 +102,7 @@ Mem alloc_alloc(Allocator* allocator, const usize size, const usize align) {
 
 void alloc_free(Allocator* allocator, const Mem mem) {
   alloc_verify_allocator(allocator);
-  diag_assert_msg(mem.size, "alloc_free: 0 byte allocations are not valid");
+  diag_assert_hot_msg(mem.size, "alloc_free: 0 byte allocations are not valid");
 
   if (LIKELY(allocator->free)) {
     allocator->free(allocator, mem);
@@ -41,7 +41,12 @@ struct sAllocator {
 
 extern Allocator* g_allocPageCache;
 
+Allocator* alloc_frame_init(void);
+void       alloc_frame_teardown(void);
+
 Allocator* alloc_heap_init(void);
+void       alloc_heap_init_thread(void);  // Activate the thread-local magazines.
+void       alloc_heap_flush_thread(void); // Return the thread-local magazines to the shared heap.
 void       alloc_heap_leak_detect(void);
 void       alloc_heap_teardown(void);
 u64        alloc_heap_active(void);
@@ -85,6 +90,8 @@ void alloc_unpoison(Mem);
  */
 typedef struct sAllocTracker AllocTracker;
 
+void alloc_tracker_sample(usize size); // Feed an allocation to the statistical sampler.
+
 AllocTracker* alloc_tracker_create(void);
 void          alloc_tracker_destroy(AllocTracker*);
 void          alloc_tracker_add(AllocTracker*, Mem, SymbolStack);
@@ -111,7 +111,7 @@ ret:
 }
 
 static void alloc_block_free(Allocator* allocator, Mem mem) {
-  diag_assert(mem_valid(mem));
+  diag_assert_hot(mem_valid(mem));
 
   alloc_tag_free(mem, AllocMemType_Normal);
 
@@ -38,7 +38,7 @@ static Mem alloc_bump_alloc(Allocator* allocator, const usize size, const usize
 }
 
 static void alloc_bump_free(Allocator* allocator, Mem mem) {
-  diag_assert(mem_valid(mem));
+  diag_assert_hot(mem_valid(mem));
 
   struct AllocatorBump* allocatorBump = (struct AllocatorBump*)allocator;
 
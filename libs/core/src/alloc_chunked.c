@@ -76,7 +76,7 @@ static Mem alloc_chunked_alloc(Allocator* allocator, const usize size, const usi
 }
 
 static void alloc_chunked_free(Allocator* allocator, Mem mem) {
-  diag_assert(mem_valid(mem));
+  diag_assert_hot(mem_valid(mem));
 
   AllocatorChunked* alloc = (AllocatorChunked*)allocator;
 
@@ -0,0 +1,118 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/thread.h"
+
+#include "alloc.h"
+
+#define frame_heap_size (usize_mebibyte * 8)
+#define frame_chunk_size (usize_kibibyte * 64)
+#define frame_max_alloc_size frame_chunk_size
+
+typedef struct {
+  Allocator api;
+  Mem       memory;
+  i64       chunkHead; // Offset of the next chunk to hand out.
+  i64       epoch;     // Incremented on every reset; invalidates all thread-local chunks.
+} AllocatorFrame;
+
+/**
+ * Thread-local chunk to bump-allocate from; claimed lazily from the shared frame heap.
+ * A chunk from a previous frame (epoch mismatch) is abandoned and a fresh one is claimed.
+ */
+typedef struct {
+  u8* head;
+  u8* end;
+  i64 epoch;
+} AllocatorFrameChunk;
+
+/**
+ * Pre-condition: bits_ispow2(_ALIGN_)
+ */
+INLINE_HINT static u8* alloc_frame_align_ptr(u8* ptr, const usize align) {
+  return (u8*)((uptr)ptr + ((~(uptr)ptr + 1) & (align - 1)));
+}
+
+static AllocatorFrame                   g_allocatorIntern;
+static THREAD_LOCAL AllocatorFrameChunk g_allocatorChunk;
+
+static Mem alloc_frame_alloc(Allocator* allocator, const usize size, const usize align) {
+  AllocatorFrame* allocFrame = (AllocatorFrame*)allocator;
+
+  if (UNLIKELY(size > frame_max_alloc_size)) {
+    // Too big allocation, each allocation has to fit within a single chunk.
+    return mem_create(null, size);
+  }
+
+  const i64 epoch = thread_atomic_load_i64(&allocFrame->epoch);
+  if (LIKELY(g_allocatorChunk.epoch == epoch)) {
+    u8* alignedHead = alloc_frame_align_ptr(g_allocatorChunk.head, align);
+    if (LIKELY(alignedHead + size <= g_allocatorChunk.end)) {
+      g_allocatorChunk.head = alignedHead + size;
+      return mem_create(alignedHead, size);
+    }
+  }
+
+  // Chunk is exhausted (or from a previous frame); claim a new chunk from the shared heap.
+  // NOTE: Wait-free, a single atomic add regardless of what other threads are doing.
+  const i64 chunkOffset = thread_atomic_add_i64(&allocFrame->chunkHead, frame_chunk_size);
+  if (UNLIKELY((usize)chunkOffset + frame_chunk_size > allocFrame->memory.size)) {
+    return mem_create(null, size); // Frame heap exhausted; free happens at the next reset.
+  }
+  g_allocatorChunk.head  = mem_begin(allocFrame->memory) + chunkOffset;
+  g_allocatorChunk.end   = g_allocatorChunk.head + frame_chunk_size;
+  g_allocatorChunk.epoch = epoch;
+
+  u8* alignedHead = alloc_frame_align_ptr(g_allocatorChunk.head, align);
+  if (UNLIKELY(alignedHead + size > g_allocatorChunk.end)) {
+    return mem_create(null, size); // Does not fit in a fresh chunk due to alignment padding.
+  }
+  g_allocatorChunk.head = alignedHead + size;
+  return mem_create(alignedHead, size);
+}
+
+static void alloc_frame_free(Allocator* allocator, Mem mem) {
+  (void)allocator;
+  (void)mem;
+
+  diag_assert_hot(mem_valid(mem));
+
+  // NOTE: Tag the freed memory to detect UAF.
+  alloc_tag_free(mem, AllocMemType_Scratch);
+}
+
+static usize alloc_frame_max_size(Allocator* allocator) {
+  (void)allocator;
+  return frame_max_alloc_size;
+}
+
+static void alloc_frame_reset(Allocator* allocator) {
+  AllocatorFrame* allocFrame = (AllocatorFrame*)allocator;
+
+  /**
+   * Invalidate all chunks; threads observe the new epoch on their next allocation and claim a
+   * fresh chunk.
+   * Pre-condition: No concurrent allocations are being made (called between frames).
+   */
+  thread_atomic_store_i64(&allocFrame->chunkHead, 0);
+  thread_atomic_add_i64(&allocFrame->epoch, 1);
+}
+
+Allocator* alloc_frame_init(void) {
+  Mem framePages    = alloc_alloc(g_allocPage, frame_heap_size, sizeof(void*));
+  g_allocatorIntern = (AllocatorFrame){
+      (Allocator){
+          .alloc   = alloc_frame_alloc,
+          .free    = alloc_frame_free,
+          .maxSize = alloc_frame_max_size,
+          .reset   = alloc_frame_reset,
+      },
+      .memory = framePages,
+      .epoch  = 1, // Start at epoch 1 so zero-initialized thread chunks are invalid.
+  };
+  return (Allocator*)&g_allocatorIntern;
+}
+
+void alloc_frame_teardown(void) {
+  alloc_free(g_allocPage, g_allocatorIntern.memory);
+  g_allocatorIntern = (AllocatorFrame){0};
+}
@@ -16,6 +16,25 @@ ASSERT(block_bucket_size_min == 16, "Unexpected bucket min size");
 ASSERT(block_bucket_size_max == 2048, "Unexpected bucket max size");
 ASSERT(block_bucket_count == 8, "Unexpected bucket count");
 
+/**
+ * Thread-local magazines that cache free blocks for the small buckets. Allocations that hit a
+ * magazine never touch the shared block allocators (and thus never take their spin-locks); the
+ * shared allocators are only used to refill a drained magazine or drain a full one.
+ */
+#define heap_magazine_pow_max 9 // Blocks up to 512 bytes are cached per-thread.
+#define heap_magazine_bucket_count (heap_magazine_pow_max - block_bucket_pow_min + 1)
+#define heap_magazine_capacity 16
+
+ASSERT(heap_magazine_bucket_count == 6, "Unexpected magazine bucket count");
+
+typedef struct {
+  void* blocks[heap_magazine_capacity];
+  u32   count;
+} HeapMagazine;
+
+static THREAD_LOCAL HeapMagazine g_heapMagazines[heap_magazine_bucket_count];
+static THREAD_LOCAL bool         g_heapMagazinesActive; // Only managed threads use magazines.
+
 typedef struct {
   Allocator  api;
   Allocator* blockBuckets[block_bucket_count];
@@ -31,6 +50,18 @@ static usize alloc_heap_pow_index(const usize size) {
   return bits_ctz(sizePow2);
 }
 
+static usize alloc_heap_pow_block_size(const usize powIdx) {
+  return usize_lit(1) << (powIdx < block_bucket_pow_min ? block_bucket_pow_min : powIdx);
+}
+
+static HeapMagazine* alloc_heap_magazine(const usize powIdx) {
+  if (!g_heapMagazinesActive || powIdx > heap_magazine_pow_max) {
+    return null; // Thread without magazines or size too big to be cached per-thread.
+  }
+  const usize bucketIdx = powIdx < block_bucket_pow_min ? 0 : powIdx - block_bucket_pow_min;
+  return &g_heapMagazines[bucketIdx];
+}
+
 static Allocator* alloc_heap_sub_allocator(AllocatorHeap* allocHeap, const usize size) {
   const usize powIdx = alloc_heap_pow_index(size);
   if (UNLIKELY(powIdx < block_bucket_pow_min)) {
@@ -44,10 +75,22 @@ static Allocator* alloc_heap_sub_allocator(AllocatorHeap* allocHeap, const usize
 
 static Mem alloc_heap_alloc(Allocator* allocator, const usize size, const usize align) {
   AllocatorHeap* allocHeap = (AllocatorHeap*)allocator;
-  Allocator*     allocSub  = alloc_heap_sub_allocator(allocHeap, size);
   thread_atomic_add_i64(&allocHeap->counter, 1);
-
-  const Mem result = alloc_alloc(allocSub, size, align);
+  alloc_tracker_sample(size);
+
+  Mem           result;
+  const usize   powIdx   = alloc_heap_pow_index(size);
+  HeapMagazine* magazine = alloc_heap_magazine(powIdx);
+  if (magazine && magazine->count) {
+    // Fast-path: serve the allocation from the thread-local magazine, no locks taken.
+    // NOTE: Magazine blocks satisfy any valid alignment as they are block-size aligned.
+    void* blockPtr = magazine->blocks[--magazine->count];
+    alloc_unpoison(mem_create(blockPtr, alloc_heap_pow_block_size(powIdx)));
+    result = mem_create(blockPtr, size);
+  } else {
+    Allocator* allocSub = alloc_heap_sub_allocator(allocHeap, size);
+    result              = alloc_alloc(allocSub, size, align);
+  }
 #ifdef VOLO_MEMORY_TRACKING
   if (LIKELY(mem_valid(result))) {
     alloc_tracker_add(allocHeap->tracker, result, symbol_stack_walk());
@@ -58,10 +101,19 @@ static Mem alloc_heap_alloc(Allocator* allocator, const usize size, const usize
 
 static void alloc_heap_free(Allocator* allocator, const Mem mem) {
   AllocatorHeap* allocHeap = (AllocatorHeap*)allocator;
-  Allocator*     allocSub  = alloc_heap_sub_allocator(allocHeap, mem.size);
 #ifdef VOLO_MEMORY_TRACKING
   alloc_tracker_remove(allocHeap->tracker, mem);
 #endif
+  const usize   powIdx   = alloc_heap_pow_index(mem.size);
+  HeapMagazine* magazine = alloc_heap_magazine(powIdx);
+  if (magazine && magazine->count != heap_magazine_capacity) {
+    // Fast-path: cache the block in the thread-local magazine, no locks taken.
+    alloc_tag_free(mem, AllocMemType_Normal);
+    magazine->blocks[magazine->count++] = mem.ptr;
+    alloc_poison(mem_create(mem.ptr, alloc_heap_pow_block_size(powIdx)));
+    return;
+  }
+  Allocator* allocSub = alloc_heap_sub_allocator(allocHeap, mem.size);
   alloc_free(allocSub, mem);
 }
 
@@ -92,6 +144,26 @@ Allocator* alloc_heap_init(void) {
   return (Allocator*)&g_allocatorIntern;
 }
 
+void alloc_heap_init_thread(void) { g_heapMagazinesActive = true; }
+
+void alloc_heap_flush_thread(void) {
+  g_heapMagazinesActive = false; // Frees after this go directly to the shared allocators.
+  for (usize bucketIdx = 0; bucketIdx != heap_magazine_bucket_count; ++bucketIdx) {
+    HeapMagazine* magazine   = &g_heapMagazines[bucketIdx];
+    Allocator*    allocBlock = g_allocatorIntern.blockBuckets[bucketIdx];
+    if (!allocBlock) {
+      continue; // Heap allocator not initialized (or already torn down).
+    }
+    const usize blockSize = usize_lit(1) << (bucketIdx + block_bucket_pow_min);
+    for (u32 i = 0; i != magazine->count; ++i) {
+      const Mem blockMem = mem_create(magazine->blocks[i], blockSize);
+      alloc_unpoison(blockMem);
+      alloc_free(allocBlock, blockMem);
+    }
+    magazine->count = 0;
+  }
+}
+
 void alloc_heap_leak_detect(void) {
 #ifdef VOLO_MEMORY_TRACKING
   const usize leakedAllocations = alloc_tracker_count(g_allocatorIntern.tracker);
@@ -1,10 +1,14 @@
+#include "core/ascii.h"
 #include "core/bits.h"
+#include "core/sentinel.h"
 #include "core/thread.h"
 
 #include "alloc.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 /**
@@ -13,13 +17,76 @@
  * become unsafe to be called after fork (as another thread might have held the lock).
  */
 
+#define alloc_page_mpol_preferred 1 // MPOL_PREFERRED from 'linux/mempolicy.h'.
+#define alloc_page_huge_size (2 * usize_mebibyte)
+
 typedef struct {
   Allocator api;
   usize     pageSize;
+  u32       numaNodeCount;
   i64       allocatedPages;
   i64       counter; // Incremented on every allocation.
 } AllocatorPage;
 
+/**
+ * Preferred NUMA node for page allocations made by this thread, sentinel when no hint is active.
+ */
+static THREAD_LOCAL u32 g_allocPageNumaHint = sentinel_u32;
+
+/**
+ * Detect the amount of NUMA nodes in the system.
+ * NOTE: Uses raw syscalls as this runs before the other core systems are initialized.
+ */
+static u32 alloc_page_numa_detect(void) {
+  const int fd = open("/sys/devices/system/node/possible", O_RDONLY);
+  if (fd < 0) {
+    return 1; // Kernel without NUMA support.
+  }
+  char          buffer[64];
+  const ssize_t bytesRead = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (bytesRead <= 0) {
+    return 1;
+  }
+  buffer[bytesRead] = '\0';
+
+  // Parse the highest node index from a range string, for example '0-3' or '0'.
+  u32 highestNode = 0, current = 0;
+  for (ssize_t i = 0; i != bytesRead; ++i) {
+    if (ascii_is_digit(buffer[i])) {
+      current = current * 10 + (u32)(buffer[i] - '0');
+    } else {
+      highestNode = current > highestNode ? current : highestNode;
+      current     = 0;
+    }
+  }
+  highestNode = current > highestNode ? current : highestNode;
+  return highestNode + 1;
+}
+
+/**
+ * Opt-in for transparent huge-page backing of large page allocations, updated atomically.
+ */
+static i32 g_allocPageHugeEnabled;
+
+static void alloc_page_huge_advise(void* ptr, const usize size) {
+  if (LIKELY(!thread_atomic_load_i32(&g_allocPageHugeEnabled)) || size < alloc_page_huge_size) {
+    return;
+  }
+  // Best effort: kernels with transparent huge pages disabled reject the advice.
+  madvise(ptr, size, MADV_HUGEPAGE);
+}
+
+static void alloc_page_numa_bind(AllocatorPage* allocPage, void* ptr, const usize size) {
+  const u32 numaHint = g_allocPageNumaHint;
+  if (LIKELY(sentinel_check(numaHint)) || allocPage->numaNodeCount < 2) {
+    return;
+  }
+  // Bind the mapping to the hinted node, best effort: failure falls back to the default policy.
+  const unsigned long nodeMask = 1ul << numaHint;
+  syscall(SYS_mbind, ptr, size, alloc_page_mpol_preferred, &nodeMask, sizeof(nodeMask) * 8, 0);
+}
+
 static u32 alloc_page_num_pages(AllocatorPage* allocPage, const usize size) {
   return (u32)((size + allocPage->pageSize - 1) / allocPage->pageSize);
 }
@@ -43,6 +110,9 @@ static Mem alloc_page_alloc(Allocator* allocator, const usize size, const usize
     return mem_create(null, size);
   }
 
+  alloc_page_huge_advise(res, realSize);
+  alloc_page_numa_bind(allocPage, res, realSize);
+
   thread_atomic_add_i64(&allocPage->allocatedPages, pages);
   thread_atomic_add_i64(&allocPage->counter, 1);
   return mem_create(res, size);
@@ -86,13 +156,37 @@ Allocator* alloc_page_init(void) {
               .maxSize = alloc_page_max_size,
               .reset   = null,
           },
-      .pageSize = pageSize,
+      .pageSize      = pageSize,
+      .numaNodeCount = alloc_page_numa_detect(),
   };
   return (Allocator*)&g_allocatorIntern;
 }
 
 usize alloc_page_size(void) { return g_allocatorIntern.pageSize; }
 
+void alloc_page_huge_enable(const bool enabled) {
+  thread_atomic_store_i32(&g_allocPageHugeEnabled, enabled);
+}
+
+bool alloc_page_huge_enabled(void) {
+  return thread_atomic_load_i32(&g_allocPageHugeEnabled) != 0;
+}
+
+u32 alloc_page_numa_node_count(void) { return g_allocatorIntern.numaNodeCount; }
+
+void alloc_page_numa_hint_set(const u32 node) {
+#ifndef VOLO_RELEASE
+  if (UNLIKELY(node >= g_allocatorIntern.numaNodeCount)) {
+    alloc_crash_with_msg("alloc_page_numa_hint_set: Node '{}' out of bounds", fmt_int(node));
+  }
+#endif
+  g_allocPageNumaHint = node;
+}
+
+void alloc_page_numa_hint_clear(void) { g_allocPageNumaHint = sentinel_u32; }
+
+u32 alloc_page_numa_hint(void) { return g_allocPageNumaHint; }
+
 u32 alloc_page_allocated_pages(void) {
   return (u32)thread_atomic_load_i64(&g_allocatorIntern.allocatedPages);
 }
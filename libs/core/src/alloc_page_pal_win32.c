@@ -1,4 +1,5 @@
 #include "core/bits.h"
+#include "core/sentinel.h"
 #include "core/thread.h"
 
 #include "alloc.h"
@@ -12,10 +13,24 @@
 typedef struct {
   Allocator api;
   usize     pageSize;
+  u32       numaNodeCount;
   i64       allocatedPages;
   i64       counter; // Incremented on every allocation.
 } AllocatorPage;
 
+/**
+ * Preferred NUMA node for page allocations made by this thread, sentinel when no hint is active.
+ */
+static THREAD_LOCAL u32 g_allocPageNumaHint = sentinel_u32;
+
+static u32 alloc_page_numa_detect(void) {
+  ULONG highestNode;
+  if (!GetNumaHighestNodeNumber(&highestNode)) {
+    return 1;
+  }
+  return (u32)highestNode + 1;
+}
+
 static u32 alloc_page_num_pages(AllocatorPage* allocPage, const usize size) {
   return (u32)((size + allocPage->pageSize - 1) / allocPage->pageSize);
 }
@@ -34,7 +49,14 @@ static Mem alloc_page_alloc(Allocator* allocator, const usize size, const usize
   const u32   pages    = alloc_page_num_pages(allocPage, size);
   const usize realSize = pages * allocPage->pageSize;
 
-  void* ptr = VirtualAlloc(null, realSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  void*     ptr;
+  const u32 numaHint = g_allocPageNumaHint;
+  if (!sentinel_check(numaHint) && allocPage->numaNodeCount > 1) {
+    ptr = VirtualAllocExNuma(
+        GetCurrentProcess(), null, realSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, numaHint);
+  } else {
+    ptr = VirtualAlloc(null, realSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  }
   if (UNLIKELY(!ptr)) {
     return mem_create(null, size);
   }
@@ -85,13 +107,44 @@ Allocator* alloc_page_init(void) {
               .maxSize = alloc_page_max_size,
               .reset   = null,
           },
-      .pageSize = pageSize,
+      .pageSize      = pageSize,
+      .numaNodeCount = alloc_page_numa_detect(),
   };
   return (Allocator*)&g_allocatorIntern;
 }
 
 usize alloc_page_size(void) { return g_allocatorIntern.pageSize; }
 
+/**
+ * Opt-in for huge-page backing of large page allocations, updated atomically.
+ * NOTE: No-op on win32 at this time: large pages require the SeLockMemoryPrivilege and change the
+ * alignment requirements of every mapping.
+ */
+static i32 g_allocPageHugeEnabled;
+
+void alloc_page_huge_enable(const bool enabled) {
+  thread_atomic_store_i32(&g_allocPageHugeEnabled, enabled);
+}
+
+bool alloc_page_huge_enabled(void) {
+  return thread_atomic_load_i32(&g_allocPageHugeEnabled) != 0;
+}
+
+u32 alloc_page_numa_node_count(void) { return g_allocatorIntern.numaNodeCount; }
+
+void alloc_page_numa_hint_set(const u32 node) {
+#ifndef VOLO_RELEASE
+  if (UNLIKELY(node >= g_allocatorIntern.numaNodeCount)) {
+    alloc_crash_with_msg("alloc_page_numa_hint_set: Node '{}' out of bounds", fmt_int(node));
+  }
+#endif
+  g_allocPageNumaHint = node;
+}
+
+void alloc_page_numa_hint_clear(void) { g_allocPageNumaHint = sentinel_u32; }
+
+u32 alloc_page_numa_hint(void) { return g_allocPageNumaHint; }
+
 u32 alloc_page_allocated_pages(void) {
   return (u32)thread_atomic_load_i64(&g_allocatorIntern.allocatedPages);
 }
@@ -181,8 +181,15 @@ static usize pagecache_warmup_size(AllocatorPageCache* cache) {
 static void pagecache_warmup(AllocatorPageCache* cache) {
   diag_assert(!mem_valid(cache->warmupMem));
 
-  const usize warmupSize = pagecache_warmup_size(cache);
-  cache->warmupMem       = alloc_alloc(g_allocPage, warmupSize, cache->pageSize);
+  /**
+   * The warmup region is multiple MiB of hot allocator memory; backing it with huge pages avoids
+   * allot of TLB pressure on the allocation fast-path.
+   */
+  const bool  hugeWasEnabled = alloc_page_huge_enabled();
+  const usize warmupSize     = pagecache_warmup_size(cache);
+  alloc_page_huge_enable(true);
+  cache->warmupMem = alloc_alloc(g_allocPage, warmupSize, cache->pageSize);
+  alloc_page_huge_enable(hugeWasEnabled);
   if (!mem_valid(cache->warmupMem)) {
     alloc_crash_with_msg("pagecache_warmup: Failed to allocate warmup memory");
   }
@@ -64,7 +64,7 @@ static void alloc_scratch_free(Allocator* allocator, Mem mem) {
   (void)allocator;
   (void)mem;
 
-  diag_assert(mem_valid(mem));
+  diag_assert_hot(mem_valid(mem));
 
   // NOTE: Tag the freed memory to detect UAF.
   alloc_tag_free(mem, AllocMemType_Scratch);
@@ -1,6 +1,7 @@
 #include "core/array.h"
 #include "core/bits.h"
 #include "core/file.h"
+#include "core/sort.h"
 #include "core/thread.h"
 
 #include "alloc.h"
@@ -8,6 +9,113 @@
 #define tracker_slots_initial (16 * 1024)
 #define tracker_slots_loadfactor 0.75f
 
+#define sampler_slots 512
+
+/**
+ * Statistical allocation sampler.
+ * Unlike the full tracker (which observes every allocation) the sampler only captures a stack
+ * every N allocated bytes, making it cheap enough to leave enabled in production builds. Samples
+ * are aggregated per call-site and can be polled for live inspection.
+ */
+
+static i64              g_samplerInterval; // In bytes, 0 == sampling disabled.
+static THREAD_LOCAL i64 g_samplerCountdown;
+static ThreadSpinLock   g_samplerLock;
+static AllocSampleInfo  g_samplerSlotsStorage[sampler_slots]; // Keyed on call-site addr.
+static usize            g_samplerSlotsUsed;
+
+static AllocSampleInfo* sampler_slot(const SymbolAddrRel addr) {
+  const u64 hash   = bits_hash_64_val((u64)addr);
+  usize     bucket = (usize)(hash & (sampler_slots - 1));
+  for (usize i = 0; i != sampler_slots; ++i) {
+    AllocSampleInfo* slot = &g_samplerSlotsStorage[bucket];
+    if (LIKELY(slot->addr == addr || !slot->count)) {
+      return slot; // Found the right slot (or an empty one to claim).
+    }
+    // Hash collision, jump to a new bucket (quadratic probing).
+    bucket = (bucket + i + 1) & (sampler_slots - 1);
+  }
+  return null; // Table is full; drop the sample.
+}
+
+NO_INLINE_HINT static void sampler_capture(const usize size) {
+  const SymbolStack stack = symbol_stack_walk();
+
+  // Attribute the sample to the top-most frame (the call-site of the allocation).
+  SymbolAddrRel addr = sentinel_u32;
+  for (u32 frameIndex = 0; frameIndex != array_elems(stack.frames); ++frameIndex) {
+    if (!sentinel_check(stack.frames[frameIndex])) {
+      addr = stack.frames[frameIndex];
+      break;
+    }
+  }
+  if (sentinel_check(addr)) {
+    return; // No usable frame (for example an external thread).
+  }
+
+  thread_spinlock_lock(&g_samplerLock);
+  {
+    AllocSampleInfo* slot = sampler_slot(addr);
+    if (LIKELY(slot)) {
+      if (!slot->count) {
+        slot->addr = addr;
+        ++g_samplerSlotsUsed;
+      }
+      slot->count += 1;
+      slot->size += size;
+    }
+  }
+  thread_spinlock_unlock(&g_samplerLock);
+}
+
+void alloc_tracker_sample(const usize size) {
+  const i64 interval = thread_atomic_load_i64(&g_samplerInterval);
+  if (LIKELY(!interval)) {
+    return; // Sampling disabled.
+  }
+  g_samplerCountdown -= (i64)size;
+  if (LIKELY(g_samplerCountdown > 0)) {
+    return;
+  }
+  do {
+    g_samplerCountdown += interval;
+  } while (g_samplerCountdown <= 0);
+  sampler_capture(size);
+}
+
+void alloc_sample_set_interval(const usize bytes) {
+  thread_atomic_store_i64(&g_samplerInterval, (i64)bytes);
+}
+
+usize alloc_sample_interval(void) { return (usize)thread_atomic_load_i64(&g_samplerInterval); }
+
+void alloc_sample_reset(void) {
+  thread_spinlock_lock(&g_samplerLock);
+  mem_set(array_mem(g_samplerSlotsStorage), 0);
+  g_samplerSlotsUsed = 0;
+  thread_spinlock_unlock(&g_samplerLock);
+}
+
+static i8 sampler_compare_size(const void* a, const void* b) {
+  return compare_u64_reverse(
+      field_ptr(a, AllocSampleInfo, size), field_ptr(b, AllocSampleInfo, size));
+}
+
+usize alloc_sample_query(AllocSampleInfo* out, const usize outCapacity) {
+  usize count = 0;
+  thread_spinlock_lock(&g_samplerLock);
+  {
+    for (usize i = 0; i != sampler_slots && count != outCapacity; ++i) {
+      if (g_samplerSlotsStorage[i].count) {
+        out[count++] = g_samplerSlotsStorage[i];
+      }
+    }
+  }
+  thread_spinlock_unlock(&g_samplerLock);
+  sort_quicksort_t(out, out + count, AllocSampleInfo, sampler_compare_size);
+  return count;
+}
+
 typedef struct {
   Mem         mem; // mem_empty indicates that the slot is empty.
   SymbolStack stack;
@@ -4,6 +4,10 @@
 #include "core/dynstring.h"
 #include "core/string.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
 /**
  * Table of Base64 characters.
  * For the source see the wiki page: https://en.wikipedia.org/wiki/Base64
@@ -46,7 +50,58 @@ usize base64_decoded_size(const String encoded) {
   return encoded.size / 4 * 3 - padding;
 }
 
+#ifdef VOLO_SIMD
+/**
+ * Encode 12 byte blocks (to 16 base64 chars) at a time using the shuffle-based approach from
+ * Wojciech Muła: http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html
+ * Returns the amount of input bytes that were consumed; the rest is left for the scalar path.
+ */
+static usize base64_encode_simd(DynString* str, const String data) {
+  // Spread the 12 input bytes over the four 32-bit lanes (one lane per 3-byte group).
+  ALIGNAS(16) static const u8 g_shuffle[16] = {1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10};
+  // Offset from a 6-bit value to its base64 ascii char, indexed by the reduced range index.
+  ALIGNAS(16) static const u8 g_shifts[16] = {
+      'a' - 26,       (u8)('0' - 52), (u8)('0' - 52), (u8)('0' - 52),
+      (u8)('0' - 52), (u8)('0' - 52), (u8)('0' - 52), (u8)('0' - 52),
+      (u8)('0' - 52), (u8)('0' - 52), (u8)('0' - 52), (u8)('+' - 62),
+      (u8)('/' - 63), 'A',            0,              0,
+  };
+  const SimdVec shuffle = simd_vec_load(g_shuffle);
+  const SimdVec shifts  = simd_vec_load(g_shifts);
+
+  const u8* in        = mem_begin(data);
+  usize     remaining = data.size;
+  while (remaining >= 16) { // 16 bytes are loaded per block (of which 12 are consumed).
+    const SimdVec input    = simd_vec_load_unaligned(in);
+    const SimdVec shuffled = simd_vec_shuffle_u8(input, shuffle);
+
+    // Extract the four 6-bit values of each 3-byte group into the bytes of its 32-bit lane.
+    const SimdVec t0      = simd_vec_and(shuffled, simd_vec_broadcast_u32(0x0fc0fc00));
+    const SimdVec t1      = simd_vec_mul_hi_u16(t0, simd_vec_broadcast_u32(0x04000040));
+    const SimdVec t2      = simd_vec_and(shuffled, simd_vec_broadcast_u32(0x003f03f0));
+    const SimdVec t3      = simd_vec_mul_lo_u16(t2, simd_vec_broadcast_u32(0x01000010));
+    const SimdVec indices = simd_vec_or(t1, t3);
+
+    // Reduce each value to a range index (0-25 -> 13, 26-51 -> 0, 52-61 -> 1-10, 62/63 -> 11/12)
+    // and translate to ascii by adding the shift of its range.
+    SimdVec       reduced = simd_vec_sub_sat_u8(indices, simd_vec_broadcast_u8(51));
+    const SimdVec isAlpha = simd_vec_greater_i8(simd_vec_broadcast_u8(26), indices);
+    reduced               = simd_vec_or(reduced, simd_vec_and(isAlpha, simd_vec_broadcast_u8(13)));
+    const SimdVec chars   = simd_vec_add_u8(indices, simd_vec_shuffle_u8(shifts, reduced));
+
+    simd_vec_store_unaligned(chars, mem_begin(dynstring_push(str, 16)));
+    in += 12;
+    remaining -= 12;
+  }
+  return data.size - remaining;
+}
+#endif
+
 void base64_encode(DynString* str, const String data) {
+  String input = data;
+#ifdef VOLO_SIMD
+  input = string_consume(input, base64_encode_simd(str, input));
+#endif
   /**
    * Implementation based on answer of 'Manuel Martinez' in the so question:
    * https://stackoverflow.com/questions/180947/base64-decode-snippet-in-c
@@ -54,7 +109,7 @@ void base64_encode(DynString* str, const String data) {
   u32 val          = 0;
   u32 valBits      = 0; // 6 indicates we have a full value in 'val'.
   u32 bytesWritten = 0;
-  mem_for_u8(data, itr) {
+  mem_for_u8(input, itr) {
     val = (val << 8) + *itr;
     valBits += 8;
     while (valBits >= 6) {
@@ -70,14 +125,80 @@ void base64_encode(DynString* str, const String data) {
   dynstring_append_chars(str, '=', bits_padding_32(bytesWritten, 4));
 }
 
+#ifdef VOLO_SIMD
+/**
+ * Decode 16 base64 char blocks (to 12 bytes) at a time.
+ * Stops at the first block containing padding (or invalid) characters; those are left for the
+ * scalar path to handle (and validate).
+ * Returns the amount of input characters that were consumed.
+ */
+static usize base64_decode_simd(DynString* str, const String encoded) {
+  // Gather the 3 decoded bytes of each 32-bit lane (and zero the last 4 bytes).
+  ALIGNAS(16) static const u8 g_shuffle[16] = {
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 0x80, 0x80, 0x80, 0x80,
+  };
+  const SimdVec shuffle = simd_vec_load(g_shuffle);
+
+  const u8* in        = mem_begin(encoded);
+  usize     remaining = encoded.size;
+  while (remaining >= 20) { // Keep 4 trailing chars (possibly padding) for the scalar path.
+    const SimdVec input = simd_vec_load_unaligned(in);
+
+    // Classify each character into its base64 range.
+    const SimdVec isUpper = simd_vec_and(
+        simd_vec_greater_i8(input, simd_vec_broadcast_u8('A' - 1)),
+        simd_vec_greater_i8(simd_vec_broadcast_u8('Z' + 1), input));
+    const SimdVec isLower = simd_vec_and(
+        simd_vec_greater_i8(input, simd_vec_broadcast_u8('a' - 1)),
+        simd_vec_greater_i8(simd_vec_broadcast_u8('z' + 1), input));
+    const SimdVec isDigit = simd_vec_and(
+        simd_vec_greater_i8(input, simd_vec_broadcast_u8('0' - 1)),
+        simd_vec_greater_i8(simd_vec_broadcast_u8('9' + 1), input));
+    const SimdVec isPlus  = simd_vec_eq_u8(input, simd_vec_broadcast_u8('+'));
+    const SimdVec isSlash = simd_vec_eq_u8(input, simd_vec_broadcast_u8('/'));
+
+    const SimdVec valid = simd_vec_or(
+        simd_vec_or(isUpper, isLower), simd_vec_or(isDigit, simd_vec_or(isPlus, isSlash)));
+    if (simd_vec_mask_u8(valid) != 0xFFFF) {
+      break; // Block contains padding or invalid characters.
+    }
+
+    // Translate ascii to 6-bit values by adding the offset of each character's range.
+    SimdVec delta = simd_vec_and(isUpper, simd_vec_broadcast_u8((u8)(0 - 'A')));
+    delta = simd_vec_or(delta, simd_vec_and(isLower, simd_vec_broadcast_u8((u8)(26 - 'a'))));
+    delta = simd_vec_or(delta, simd_vec_and(isDigit, simd_vec_broadcast_u8((u8)(52 - '0'))));
+    delta = simd_vec_or(delta, simd_vec_and(isPlus, simd_vec_broadcast_u8((u8)(62 - '+'))));
+    delta = simd_vec_or(delta, simd_vec_and(isSlash, simd_vec_broadcast_u8((u8)(63 - '/'))));
+    const SimdVec values = simd_vec_add_u8(input, delta);
+
+    // Pack the 16 6-bit values into 12 bytes.
+    const SimdVec merged = simd_vec_mul_add_u8(values, simd_vec_broadcast_u32(0x01400140));
+    const SimdVec packed = simd_vec_mul_add_u16(merged, simd_vec_broadcast_u32(0x00011000));
+    const SimdVec bytes  = simd_vec_shuffle_u8(packed, shuffle);
+
+    ALIGNAS(16) u8 buffer[16];
+    simd_vec_store(bytes, buffer);
+    dynstring_append(str, mem_create(buffer, 12));
+
+    in += 16;
+    remaining -= 16;
+  }
+  return encoded.size - remaining;
+}
+#endif
+
 bool base64_decode(DynString* str, const String encoded) {
+  String input = encoded;
+#ifdef VOLO_SIMD
+  input = string_consume(input, base64_decode_simd(str, input));
+#endif
   /**
    * Implementation based on answer of 'nunojpg' in the so question:
    * https://stackoverflow.com/questions/180947/base64-decode-snippet-in-c
    */
   u32 val     = 0;
   u32 valBits = 0; // 8 indicates we have a full value in 'val'.
-  mem_for_u8(encoded, itr) {
+  mem_for_u8(input, itr) {
     if (*itr == '=') {
       continue; // Padding character.
     }
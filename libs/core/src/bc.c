@@ -5,6 +5,10 @@
 #include "core/float.h"
 #include "core/math.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
 /**
  * Texture Block Compression.
  *
@@ -32,12 +36,14 @@ INLINE_HINT static BcVec bc_vec_mul(const BcVec a, const f32 scalar) {
 
 INLINE_HINT static f32 bc_vec_max(const BcVec a) { return math_max(a.x, math_max(a.y, a.z)); }
 
+#ifndef VOLO_SIMD
 INLINE_HINT static u32 bc_color_dist3_sqr(const BcColor8888 a, const BcColor8888 b) {
   const i32 dR = b.r - a.r;
   const i32 dG = b.g - a.g;
   const i32 dB = b.b - a.b;
   return dR * dR + dG * dG + dB * dB;
 }
+#endif // !VOLO_SIMD
 
 INLINE_HINT static f32 bc_color_dot3(const BcColor8888 c, const BcVec axis) {
   return (f32)c.r * axis.x + (f32)c.g * axis.y + (f32)c.b * axis.z;
@@ -70,6 +76,7 @@ INLINE_HINT static BcColor8888 bc_color_from_565(const BcColor565 c) {
 /**
  * Pick the reference color that is closest in RGB space.
  */
+#ifndef VOLO_SIMD
 INLINE_HINT static u8
 bc_color_pick3(const BcColor8888 ref[PARAM_ARRAY_SIZE(4)], const BcColor8888 c) {
   u32 bestDistSqr = u32_max;
@@ -83,6 +90,7 @@ bc_color_pick3(const BcColor8888 ref[PARAM_ARRAY_SIZE(4)], const BcColor8888 c)
   }
   return bestIndex;
 }
+#endif // !VOLO_SIMD
 
 INLINE_HINT static BcColor8888 bc_block_mean3(const Bc0Block* b) {
   u32 sumR = b->colors[0].r, sumG = b->colors[0].g, sumB = b->colors[0].b;
@@ -256,11 +264,37 @@ INLINE_HINT static void bc_colors_encode(
     const BcColor8888 colors[PARAM_ARRAY_SIZE(16)],
     const BcColor8888 ref[PARAM_ARRAY_SIZE(4)],
     u32*              outIndices) {
+#ifdef VOLO_SIMD
+  /**
+   * Compute the squared RGB distance to all 4 reference colors at once (one per lane) and pick the
+   * lowest lane, ties are broken in favor of the lowest index (same as the scalar path).
+   */
+  const SimdVec refR = simd_vec_set(ref[0].r, ref[1].r, ref[2].r, ref[3].r);
+  const SimdVec refG = simd_vec_set(ref[0].g, ref[1].g, ref[2].g, ref[3].g);
+  const SimdVec refB = simd_vec_set(ref[0].b, ref[1].b, ref[2].b, ref[3].b);
+
+  *outIndices = 0;
+  for (u32 i = 0; i != 16; ++i) {
+    const SimdVec dR = simd_vec_sub(simd_vec_broadcast(colors[i].r), refR);
+    const SimdVec dG = simd_vec_sub(simd_vec_broadcast(colors[i].g), refG);
+    const SimdVec dB = simd_vec_sub(simd_vec_broadcast(colors[i].b), refB);
+
+    SimdVec distSqr = simd_vec_mul(dR, dR);
+    distSqr         = simd_vec_add(distSqr, simd_vec_mul(dG, dG));
+    distSqr         = simd_vec_add(distSqr, simd_vec_mul(dB, dB));
+
+    const SimdVec distMin = simd_vec_splat(simd_vec_min_comp(distSqr), 0);
+    const u32     mask    = simd_vec_mask_u32(simd_vec_greater(distSqr, distMin));
+    const u32     index   = bits_ctz_32(~mask & 0b1111);
+    *outIndices |= index << (i * 2);
+  }
+#else
   *outIndices = 0;
   for (u32 i = 0; i != 16; ++i) {
     const u8 index = bc_color_pick3(ref, colors[i]);
     *outIndices |= index << (i * 2);
   }
+#endif
 }
 
 INLINE_HINT static void bc_colors_decode(
@@ -274,18 +308,39 @@ INLINE_HINT static void bc_colors_decode(
 }
 
 /**
- * Compute the endpoints of a line through 1D space that can be used to approximate the values in
- * the given block.
+ * Compute the endpoints of a line through 1D space that can be used to approximate the values of a
+ * single color channel (identified by its byte offset) in the given block.
  */
-INLINE_HINT static void bc_value_fit(const u8* values, const u32 valueStride, u8* out0, u8* out1) {
-  u8 min = *values, max = *values;
+INLINE_HINT static void
+bc_block_value_fit(const Bc0Block* b, const u32 channelOffset, u8* out0, u8* out1) {
+#ifdef VOLO_SIMD
+  const SimdVec rowA = simd_vec_load(b->colors + 0);
+  const SimdVec rowB = simd_vec_load(b->colors + 4);
+  const SimdVec rowC = simd_vec_load(b->colors + 8);
+  const SimdVec rowD = simd_vec_load(b->colors + 12);
+
+  SimdVec min = simd_vec_min_u8(simd_vec_min_u8(rowA, rowB), simd_vec_min_u8(rowC, rowD));
+  SimdVec max = simd_vec_max_u8(simd_vec_max_u8(rowA, rowB), simd_vec_max_u8(rowC, rowD));
+
+  // Reduce the four pixel columns; the first lane ends up with the min / max of all channels.
+  min = simd_vec_min_u8(min, simd_vec_permute(min, 2, 3, 2, 3));
+  min = simd_vec_min_u8(min, simd_vec_permute(min, 1, 1, 1, 1));
+  max = simd_vec_max_u8(max, simd_vec_permute(max, 2, 3, 2, 3));
+  max = simd_vec_max_u8(max, simd_vec_permute(max, 1, 1, 1, 1));
+
+  *out0 = (u8)(simd_vec_u64(max) >> (channelOffset * 8));
+  *out1 = (u8)(simd_vec_u64(min) >> (channelOffset * 8));
+#else
+  const u8* values = bits_ptr_offset(b->colors, channelOffset);
+  u8        min = *values, max = *values;
   for (u32 i = 0; i != 15; ++i) {
-    values += valueStride;
+    values += sizeof(BcColor8888);
     min = math_min(min, *values);
     max = math_max(max, *values);
   }
   *out0 = max;
   *out1 = min;
+#endif
 }
 
 /**
@@ -351,6 +406,10 @@ void bc0_extract(
   diag_assert(channels);
   diag_assert_msg(bits_aligned(width, 4), "Width has to be a multiple of 4");
 
+  if (channels == 4) {
+    bc0_extract4((const BcColor8888*)in, width, out);
+    return;
+  }
   for (u32 y = 0; y != 4; ++y, in += width * channels) {
     for (u32 x = 0; x != 4; ++x) {
       BcColor8888* outColor = &out->colors[y * 4 + x];
@@ -365,21 +424,33 @@ void bc0_extract(
 void bc0_extract4(const BcColor8888* restrict in, const u32 width, Bc0Block* restrict out) {
   diag_assert_msg(bits_aligned(width, 4), "Width has to be a multiple of 4");
 
+#ifdef VOLO_SIMD
+  for (u32 y = 0; y != 4; ++y, in += width) {
+    simd_vec_store(simd_vec_load_unaligned(in), out->colors + y * 4);
+  }
+#else
   for (u32 y = 0; y != 4; ++y, in += width) {
     for (u32 x = 0; x != 4; ++x) {
       out->colors[y * 4 + x] = in[x];
     }
   }
+#endif
 }
 
 void bc0_scanout4(const Bc0Block* restrict in, const u32 width, BcColor8888* restrict out) {
   diag_assert_msg(bits_aligned(width, 4), "Width has to be a multiple of 4");
 
+#ifdef VOLO_SIMD
+  for (u32 y = 0; y != 4; ++y, out += width) {
+    simd_vec_store_unaligned(simd_vec_load(in->colors + y * 4), out);
+  }
+#else
   for (u32 y = 0; y != 4; ++y, out += width) {
     for (u32 x = 0; x != 4; ++x) {
       *(out + x) = in->colors[y * 4 + x];
     }
   }
+#endif
 }
 
 void bc1_encode(const Bc0Block* restrict in, Bc1Block* restrict out) {
@@ -421,7 +492,7 @@ void bc1_decode(const Bc1Block* restrict in, Bc0Block* restrict out) {
 }
 
 void bc3_encode(const Bc0Block* restrict in, Bc3Block* restrict out) {
-  bc_value_fit(bc_block_values_a(in), 4, &out->alpha0, &out->alpha1);
+  bc_block_value_fit(in, offsetof(BcColor8888, a), &out->alpha0, &out->alpha1);
 
   if (out->alpha0 == out->alpha1) {
     mem_set(array_mem(out->alphaIndices), 0);
@@ -459,7 +530,7 @@ void bc3_decode(const Bc3Block* restrict in, Bc0Block* restrict out) {
 }
 
 void bc4_encode(const Bc0Block* restrict in, Bc4Block* restrict out) {
-  bc_value_fit(bc_block_values_r(in), 4, &out->value0, &out->value1);
+  bc_block_value_fit(in, offsetof(BcColor8888, r), &out->value0, &out->value1);
 
   if (out->value0 == out->value1) {
     mem_set(array_mem(out->valueIndices), 0);
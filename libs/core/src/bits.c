@@ -4,7 +4,7 @@
 #include "core/intrinsic.h"
 
 static const u32 g_crcPolynomial = 0xEDB88320; // Reversed version of: 0x04C11DB7.
-static u32       g_crcTable[256];
+static u32       g_crcTable[8][256];
 
 static void bits_init_crc(void) {
   /**
@@ -12,7 +12,7 @@ static void bits_init_crc(void) {
    * Based on the gzip spec:
    * https://www.rfc-editor.org/rfc/rfc1952
    */
-  for (u32 i = 0; i != array_elems(g_crcTable); ++i) {
+  for (u32 i = 0; i != array_elems(g_crcTable[0]); ++i) {
     u32 res = i;
     for (u32 k = 0; k != 8; ++k) {
       if (res & 1) {
@@ -21,7 +21,17 @@ static void bits_init_crc(void) {
         res >>= 1;
       }
     }
-    g_crcTable[i] = res;
+    g_crcTable[0][i] = res;
+  }
+  /**
+   * Derive the tables for processing 8 input bytes at a time (slice-by-8).
+   * Ref: https://create.stephan-brumme.com/crc32/#slicing-by-8-overview
+   */
+  for (u32 slice = 1; slice != array_elems(g_crcTable); ++slice) {
+    for (u32 i = 0; i != array_elems(g_crcTable[0]); ++i) {
+      const u32 prev       = g_crcTable[slice - 1][i];
+      g_crcTable[slice][i] = g_crcTable[0][prev & 0xFF] ^ (prev >> 8);
+    }
   }
 }
 
@@ -182,7 +192,24 @@ u32 bits_crc_32(const u32 crc, const Mem mem) {
    * https://www.rfc-editor.org/rfc/rfc1952
    */
   u32 res = crc ^ 0xffffffff;
-  mem_for_u8(mem, byte) { res = g_crcTable[(res ^ *byte) & 0xff] ^ (res >> 8); }
+
+  const u8* itr = mem_begin(mem);
+  const u8* end = mem_end(mem);
+
+  // Process blocks of 8 input bytes at a time (slice-by-8); identical output to the byte-wise
+  // loop but considerably higher throughput on big inputs.
+  for (; (end - itr) >= 8; itr += 8) {
+    const u32 low  = res ^ ((u32)itr[0] | (u32)itr[1] << 8 | (u32)itr[2] << 16 | (u32)itr[3] << 24);
+    const u32 high = (u32)itr[4] | (u32)itr[5] << 8 | (u32)itr[6] << 16 | (u32)itr[7] << 24;
+
+    res = g_crcTable[7][low & 0xff] ^ g_crcTable[6][low >> 8 & 0xff] ^
+          g_crcTable[5][low >> 16 & 0xff] ^ g_crcTable[4][low >> 24] ^ g_crcTable[3][high & 0xff] ^
+          g_crcTable[2][high >> 8 & 0xff] ^ g_crcTable[1][high >> 16 & 0xff] ^
+          g_crcTable[0][high >> 24];
+  }
+  for (; itr != end; ++itr) {
+    res = g_crcTable[0][(res ^ *itr) & 0xff] ^ (res >> 8);
+  }
   return res ^ 0xffffffff;
 }
 
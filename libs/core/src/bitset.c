@@ -5,6 +5,21 @@
 #include "core/intrinsic.h"
 #include "core/math.h"
 
+/**
+ * Load (up to) 8 bytes into a 64-bit word; bytes beyond the given count read as zero.
+ * NOTE: Assumes little-endian byte order so bit indices map onto word bit positions directly.
+ */
+INLINE_HINT static u64 bitset_word_load(const BitSet bits, const usize byteIdx, const usize count) {
+  u64 word = 0;
+  mem_cpy(mem_var(word), mem_slice(bits, byteIdx, count));
+  return word;
+}
+
+INLINE_HINT static void
+bitset_word_store(const BitSet bits, const usize byteIdx, const usize count, const u64 word) {
+  mem_cpy(mem_slice(bits, byteIdx, count), mem_create(&word, count));
+}
+
 usize bitset_size(const BitSet bits) { return bytes_to_bits(bits.size); }
 
 bool bitset_test(const BitSet bits, const usize idx) {
@@ -17,13 +32,15 @@ bool bitset_test(const BitSet bits, const usize idx) {
 
 usize bitset_count(const BitSet bits) {
   usize result = 0;
-  mem_for_u8(bits, itr) { result += intrinsic_popcnt_32(*itr); }
+  for (usize i = 0; i < bits.size; i += sizeof(u64)) {
+    result += intrinsic_popcnt_64(bitset_word_load(bits, i, math_min(bits.size - i, sizeof(u64))));
+  }
   return result;
 }
 
 bool bitset_any(const BitSet bits) {
-  mem_for_u8(bits, itr) {
-    if (*itr) {
+  for (usize i = 0; i < bits.size; i += sizeof(u64)) {
+    if (bitset_word_load(bits, i, math_min(bits.size - i, sizeof(u64)))) {
       return true;
     }
   }
@@ -32,10 +49,9 @@ bool bitset_any(const BitSet bits) {
 
 bool bitset_any_of(const BitSet bits, const BitSet other) {
   const usize byteCount = math_min(bits.size, other.size);
-  for (usize i = 0; i != byteCount; ++i) {
-    u8* byte      = mem_at_u8(bits, i);
-    u8* otherByte = mem_at_u8(other, i);
-    if (*otherByte & *byte) {
+  for (usize i = 0; i < byteCount; i += sizeof(u64)) {
+    const usize wordBytes = math_min(byteCount - i, sizeof(u64));
+    if (bitset_word_load(bits, i, wordBytes) & bitset_word_load(other, i, wordBytes)) {
       return true;
     }
   }
@@ -44,10 +60,10 @@ bool bitset_any_of(const BitSet bits, const BitSet other) {
 
 bool bitset_all_of(const BitSet bits, const BitSet other) {
   diag_assert(bits.size >= other.size);
-  for (usize i = 0; i != other.size; ++i) {
-    u8* byte      = mem_at_u8(bits, i);
-    u8* otherByte = mem_at_u8(other, i);
-    if ((*byte & *otherByte) != *otherByte) {
+  for (usize i = 0; i < other.size; i += sizeof(u64)) {
+    const usize wordBytes = math_min(other.size - i, sizeof(u64));
+    const u64   otherWord = bitset_word_load(other, i, wordBytes);
+    if ((bitset_word_load(bits, i, wordBytes) & otherWord) != otherWord) {
       return false;
     }
   }
@@ -58,15 +74,16 @@ usize bitset_next(const BitSet bits, const usize idx) {
   if (UNLIKELY(idx >= bitset_size(bits))) {
     return sentinel_usize;
   }
-  usize byteIdx = bits_to_bytes(idx);
-  u8    byte    = *mem_at_u8(bits, byteIdx) >> bit_in_byte(idx);
-  if (byte) {
-    return idx + intrinsic_ctz_32(byte);
+  usize byteIdx = bits_to_bytes(idx) & ~(usize)(sizeof(u64) - 1); // Align down to a whole word.
+  u64 word = bitset_word_load(bits, byteIdx, math_min(bits.size - byteIdx, sizeof(u64)));
+  word >>= idx - bytes_to_bits(byteIdx); // Discard the bits before the given index.
+  if (word) {
+    return idx + intrinsic_ctz_64(word);
   }
-  for (++byteIdx; byteIdx != bits.size; ++byteIdx) {
-    byte = *mem_at_u8(bits, byteIdx);
-    if (byte) {
-      return bytes_to_bits(byteIdx) + intrinsic_ctz_32(byte);
+  for (byteIdx += sizeof(u64); byteIdx < bits.size; byteIdx += sizeof(u64)) {
+    word = bitset_word_load(bits, byteIdx, math_min(bits.size - byteIdx, sizeof(u64)));
+    if (word) {
+      return bytes_to_bits(byteIdx) + intrinsic_ctz_64(word);
     }
   }
   return sentinel_usize;
@@ -74,14 +91,15 @@ usize bitset_next(const BitSet bits, const usize idx) {
 
 usize bitset_index(const BitSet bits, const usize idx) {
   diag_assert(bitset_test(bits, idx));
-  usize    byteIdx = bits_to_bytes(idx);
-  const u8 byte    = (u8)(*mem_at_u8(bits, byteIdx) << (8 - bit_in_byte(idx)));
-  usize    result  = intrinsic_popcnt_32(byte);
-  while (byteIdx) {
-    --byteIdx;
-    result += intrinsic_popcnt_32(*mem_at_u8(bits, byteIdx));
+  const usize wordByteIdx = bits_to_bytes(idx) & ~(usize)(sizeof(u64) - 1);
+  usize       result      = 0;
+  for (usize i = 0; i != wordByteIdx; i += sizeof(u64)) {
+    result += intrinsic_popcnt_64(bitset_word_load(bits, i, sizeof(u64)));
   }
-  return result;
+  const usize wordBytes = math_min(bits.size - wordByteIdx, sizeof(u64));
+  const u64   word      = bitset_word_load(bits, wordByteIdx, wordBytes);
+  const u64   mask      = (u64_lit(1) << (idx - bytes_to_bits(wordByteIdx))) - 1;
+  return result + intrinsic_popcnt_64(word & mask);
 }
 
 usize bitset_nth(const BitSet bits, usize nth) {
@@ -149,27 +167,36 @@ void bitset_clear_all(const BitSet bits) { mem_set(bits, 0); }
 
 void bitset_or(const BitSet bits, const BitSet other) {
   diag_assert(bits.size >= other.size);
-  for (usize i = 0; i != other.size; ++i) {
-    u8* byte      = mem_at_u8(bits, i);
-    u8* otherByte = mem_at_u8(other, i);
-    *byte         = *byte | *otherByte;
+  for (usize i = 0; i < other.size; i += sizeof(u64)) {
+    const usize wordBytes = math_min(other.size - i, sizeof(u64));
+    const u64   word = bitset_word_load(bits, i, wordBytes) | bitset_word_load(other, i, wordBytes);
+    bitset_word_store(bits, i, wordBytes, word);
   }
 }
 
 void bitset_and(const BitSet bits, const BitSet other) {
   diag_assert(bits.size <= other.size);
-  for (usize i = 0; i != bits.size; ++i) {
-    u8* byte      = mem_at_u8(bits, i);
-    u8* otherByte = mem_at_u8(other, i);
-    *byte         = *byte & *otherByte;
+  for (usize i = 0; i < bits.size; i += sizeof(u64)) {
+    const usize wordBytes = math_min(bits.size - i, sizeof(u64));
+    const u64   word = bitset_word_load(bits, i, wordBytes) & bitset_word_load(other, i, wordBytes);
+    bitset_word_store(bits, i, wordBytes, word);
+  }
+}
+
+void bitset_and_not(const BitSet bits, const BitSet other) {
+  const usize byteCount = math_min(bits.size, other.size);
+  for (usize i = 0; i < byteCount; i += sizeof(u64)) {
+    const usize wordBytes = math_min(byteCount - i, sizeof(u64));
+    const u64   otherWord = bitset_word_load(other, i, wordBytes);
+    bitset_word_store(bits, i, wordBytes, bitset_word_load(bits, i, wordBytes) & ~otherWord);
   }
 }
 
 void bitset_xor(const BitSet bits, const BitSet other) {
   diag_assert(bits.size <= other.size);
-  for (usize i = 0; i != bits.size; ++i) {
-    u8* byte      = mem_at_u8(bits, i);
-    u8* otherByte = mem_at_u8(other, i);
-    *byte         = *byte ^ *otherByte;
+  for (usize i = 0; i < bits.size; i += sizeof(u64)) {
+    const usize wordBytes = math_min(bits.size - i, sizeof(u64));
+    const u64   word = bitset_word_load(bits, i, wordBytes) ^ bitset_word_load(other, i, wordBytes);
+    bitset_word_store(bits, i, wordBytes, word);
   }
 }
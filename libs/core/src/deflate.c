@@ -6,6 +6,12 @@
 #include "core/dynstring.h"
 #include "core/file.h"
 #include "core/forward.h"
+#include "core/math.h"
+#include "core/sentinel.h"
+
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
 
 /**
  * DEFLATE (RFC 1951) compressed data stream utilities.
@@ -18,6 +24,16 @@
 #define huffman_max_levels 16
 #define huffman_max_symbols 288
 
+/**
+ * Codes of up to this many bits can be decoded with a single table lookup instead of a bit-by-bit
+ * walk through the tree. 9 bits covers all codes of the fixed trees and the vast majority of codes
+ * in practical dynamic trees.
+ */
+#define huffman_lookup_bits 9
+#define huffman_lookup_size (1 << huffman_lookup_bits)
+#define huffman_lookup_shift 12
+#define huffman_lookup_symbol_mask ((1 << huffman_lookup_shift) - 1)
+
 /**
  * Huffman code, encodes a path through the tree.
  * Bit 0 represents following the left child and bit 1 the right child.
@@ -50,8 +66,35 @@ typedef struct {
   u16 leafCount;
   u16 leafCountPerLevel[huffman_max_levels]; // Number of leaf nodes per tree level.
   u16 leafSymbols[huffman_max_symbols];
+
+  /**
+   * Multi-bit decode table, indexed by the next 'huffman_lookup_bits' input bits (in stream
+   * order). Each entry packs the code length (high 4 bits) and the symbol (low 12 bits); an entry
+   * of zero means the code is longer then the table and a tree walk is required.
+   */
+  u16 lookup[huffman_lookup_size];
 } HuffmanTree;
 
+/**
+ * Run lengths and distances are based on an input symbol plus additional bits.
+ * Source of the tables can be found in the RFC.
+ */
+static const u16 g_lengthBase[] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23,  27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+static const u16 g_lengthBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+static const u16 g_distBase[] = {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+    193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+static const u16 g_distBits[] = {
+    0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+    6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+
 typedef struct {
   String     input;
   u32        inputBitIndex;
@@ -70,6 +113,17 @@ static bool huffman_code_sample(const HuffmanCode code, const u32 level) {
   return (code.bits & (1 << (code.level - 1 - level))) != 0;
 }
 
+/**
+ * Convert a code to stream bit-order (first path bit in the lowest bit).
+ */
+static u16 huffman_code_stream_bits(const HuffmanCode code) {
+  u16 streamBits = 0;
+  for (u32 level = 0; level != code.level; ++level) {
+    streamBits |= (u16)huffman_code_sample(code, level) << level;
+  }
+  return streamBits;
+}
+
 static void huffman_code_write(const HuffmanCode code, DynString* out) {
   for (u32 level = 0; level != code.level; ++level) {
     dynstring_append_char(out, huffman_code_sample(code, level) ? '1' : '0');
@@ -263,6 +317,26 @@ static DeflateError huffman_build(HuffmanTree* t, const u8 symbolLevels[], const
     }
   }
 #endif
+
+  // Build the multi-bit decode table for the short codes.
+  mem_set(array_mem(t->lookup), 0);
+  if (t->leafCount) {
+    HuffmanCode codes[huffman_max_symbols];
+    huffman_codes(t, codes);
+
+    for (u32 i = 0; i != t->leafCount; ++i) {
+      const HuffmanCode code = codes[i];
+      if (code.level > huffman_lookup_bits) {
+        continue; // Code too long for the table; decoded with a tree walk instead.
+      }
+      // Fill all table entries whose low bits match this code (in stream bit-order).
+      const u16 streamBits = huffman_code_stream_bits(code);
+      const u16 entry      = (u16)(code.level << huffman_lookup_shift) | t->leafSymbols[i];
+      for (u32 idx = streamBits; idx < huffman_lookup_size; idx += 1 << code.level) {
+        t->lookup[idx] = entry;
+      }
+    }
+  }
   return DeflateError_None;
 }
 
@@ -362,6 +436,38 @@ static u32 inflate_read_unaligned(InflateCtx* ctx, const u32 bits, DeflateError*
   return res;
 }
 
+/**
+ * Peek at the next input bits without consuming them; bits past the end of the input read as zero.
+ */
+static u32 inflate_peek_unaligned(const InflateCtx* ctx, const u32 bits) {
+  diag_assert(bits + 8 <= 32);
+  const u8* data = mem_begin(ctx->input);
+  u64       acc  = 0;
+  switch (ctx->input.size) {
+  default:
+    acc |= (u64)data[3] << 24; // Fallthrough.
+  case 3:
+    acc |= (u64)data[2] << 16; // Fallthrough.
+  case 2:
+    acc |= (u64)data[1] << 8; // Fallthrough.
+  case 1:
+    acc |= (u64)data[0]; // Fallthrough.
+  case 0:
+    break;
+  }
+  return (u32)(acc >> ctx->inputBitIndex) & ((1u << bits) - 1);
+}
+
+static u32 inflate_available_bits(const InflateCtx* ctx) {
+  return (u32)(ctx->input.size * 8) - ctx->inputBitIndex;
+}
+
+static void inflate_consume_bits(InflateCtx* ctx, const u32 bits) {
+  const u32 total = ctx->inputBitIndex + bits;
+  inflate_consume(ctx, total / 8);
+  ctx->inputBitIndex = total % 8;
+}
+
 static void inflate_read_align(InflateCtx* ctx) {
   if (ctx->inputBitIndex) {
     diag_assert(ctx->input.size);
@@ -387,6 +493,16 @@ static u16 inflate_read_symbol(InflateCtx* ctx, const HuffmanTree* t, DeflateErr
     *err = DeflateError_Malformed;
     return sentinel_u16;
   }
+  // Fast path: decode short codes with a single multi-bit table lookup.
+  const u16 entry = t->lookup[inflate_peek_unaligned(ctx, huffman_lookup_bits)];
+  if (LIKELY(entry)) {
+    const u32 codeBits = entry >> huffman_lookup_shift;
+    if (LIKELY(codeBits <= inflate_available_bits(ctx))) {
+      inflate_consume_bits(ctx, codeBits);
+      return entry & huffman_lookup_symbol_mask;
+    }
+    // Not enough input left; fall through to the bit-by-bit path to diagnose truncation.
+  }
   HuffmanNode node        = {.level = 0, .index = 0}; // Root node.
   u16         symbolStart = 0;
   while (*err == DeflateError_None) {
@@ -409,17 +525,6 @@ static u32 inflate_read_run_length(InflateCtx* ctx, const u16 symbol, DeflateErr
     *err = DeflateError_Malformed;
     return sentinel_u32;
   }
-  /**
-   * Run length is based on the input symbol plus additional bits.
-   * Source of the tables can be found in the RFC.
-   */
-  static const u16 g_lengthBase[] = {
-      3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23,  27,
-      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
-  };
-  static const u16 g_lengthBits[] = {
-      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
-  };
   const u32 tableIndex = symbol - 257; // 0 - 28.
   diag_assert(tableIndex < array_elems(g_lengthBase) && tableIndex < array_elems(g_lengthBits));
   return g_lengthBase[tableIndex] + inflate_read_unaligned(ctx, g_lengthBits[tableIndex], err);
@@ -431,18 +536,6 @@ static u32 inflate_read_run_distance(InflateCtx* ctx, const HuffmanTree* t, Defl
     *err = DeflateError_Malformed;
     return sentinel_u32;
   }
-  /**
-   * Run distance is based on an input symbol plus additional bits.
-   * Source of the tables can be found in the RFC.
-   */
-  static const u16 g_distBase[] = {
-      1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
-      193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
-  };
-  static const u16 g_distBits[] = {
-      0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
-      6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
-  };
   return g_distBase[symbol] + inflate_read_unaligned(ctx, g_distBits[symbol], err);
 }
 
@@ -563,6 +656,35 @@ static void inflate_read_huffman_trees(
 #endif
 }
 
+/**
+ * Copy a run from earlier output; the destination can overlap the source (for distances smaller
+ * then the length the run repeats itself).
+ */
+static void inflate_run_copy(u8* dst, const u8* src, const u32 length, const u32 distance) {
+  if (distance >= length) {
+    // No overlap; plain copy.
+    mem_cpy(mem_create(dst, length), mem_create((u8*)src, length));
+    return;
+  }
+  if (distance == 1) {
+    // Run of a single repeated byte.
+    mem_set(mem_create(dst, length), *src);
+    return;
+  }
+  u32 i = 0;
+#ifdef VOLO_SIMD
+  if (distance >= 16) {
+    // Overlapping copy in 16 byte chunks; safe as the source stays at least 16 bytes behind.
+    for (; i + 16 <= length; i += 16) {
+      simd_vec_store_unaligned(simd_vec_load_unaligned(src + i), dst + i);
+    }
+  }
+#endif
+  for (; i != length; ++i) {
+    dst[i] = src[i];
+  }
+}
+
 static void inflate_block_uncompressed(InflateCtx* ctx, DeflateError* err) {
   const u16 len  = inflate_read_u16(ctx, err);
   const u16 nlen = inflate_read_u16(ctx, err);
@@ -615,11 +737,9 @@ static void inflate_block_compressed(
       break;
     }
     // Copy section from output.
-    for (u32 i = 0; i != runLength; ++i) {
-      const String history                 = mem_create(ctx->out->data.ptr, ctx->out->size);
-      const u8     historySymbol           = *(mem_end(history) - runDistance);
-      *(u8*)dynarray_push(ctx->out, 1).ptr = historySymbol;
-    }
+    u8*       dst = dynarray_push(ctx->out, runLength).ptr;
+    const u8* src = dst - runDistance;
+    inflate_run_copy(dst, src, runLength, runDistance);
   }
 }
 
@@ -655,6 +775,161 @@ static bool inflate_block(InflateCtx* ctx, DeflateError* err) {
   return !finalBlock;
 }
 
+/**
+ * Encoder (deflate).
+ * Produces blocks with the fixed Huffman codes and greedy LZ77 matching through a single-entry
+ * hash table of 3-byte sequences.
+ */
+
+#define deflate_encode_hash_bits 15
+#define deflate_encode_hash_size (1 << deflate_encode_hash_bits)
+#define deflate_encode_min_match 3
+#define deflate_encode_max_match 258
+#define deflate_encode_max_dist 32768
+
+typedef struct {
+  u16 bits; // Code in stream bit-order.
+  u8  count;
+} DeflateEncCode;
+
+static DeflateEncCode g_fixedLiteralEnc[huffman_max_symbols];
+static DeflateEncCode g_fixedDistanceEnc[32];
+
+typedef struct {
+  DynString* out;
+  u32        bitBuffer; // Bits not yet written to the output.
+  u32        bitCount;
+} DeflateEncCtx;
+
+static void deflate_write_bits(DeflateEncCtx* ctx, const u32 value, const u32 bits) {
+  diag_assert(bits <= 16 && !(value >> bits));
+  ctx->bitBuffer |= value << ctx->bitCount;
+  ctx->bitCount += bits;
+  while (ctx->bitCount >= 8) {
+    dynstring_append_char(ctx->out, (u8)ctx->bitBuffer);
+    ctx->bitBuffer >>= 8;
+    ctx->bitCount -= 8;
+  }
+}
+
+static void deflate_write_align(DeflateEncCtx* ctx) {
+  if (ctx->bitCount) {
+    dynstring_append_char(ctx->out, (u8)ctx->bitBuffer);
+    ctx->bitBuffer = 0;
+    ctx->bitCount  = 0;
+  }
+}
+
+static void deflate_write_code(DeflateEncCtx* ctx, const DeflateEncCode code) {
+  deflate_write_bits(ctx, code.bits, code.count);
+}
+
+static void deflate_write_run(DeflateEncCtx* ctx, const u32 length, const u32 distance) {
+  diag_assert(length >= deflate_encode_min_match && length <= deflate_encode_max_match);
+  diag_assert(distance >= 1 && distance <= deflate_encode_max_dist);
+
+  // Find the largest length symbol whose base does not exceed the length.
+  u32 lengthIdx = array_elems(g_lengthBase);
+  while (g_lengthBase[--lengthIdx] > length)
+    ;
+  deflate_write_code(ctx, g_fixedLiteralEnc[257 + lengthIdx]);
+  deflate_write_bits(ctx, length - g_lengthBase[lengthIdx], g_lengthBits[lengthIdx]);
+
+  // Find the largest distance symbol whose base does not exceed the distance.
+  u32 distIdx = array_elems(g_distBase);
+  while (g_distBase[--distIdx] > distance)
+    ;
+  deflate_write_code(ctx, g_fixedDistanceEnc[distIdx]);
+  deflate_write_bits(ctx, distance - g_distBase[distIdx], g_distBits[distIdx]);
+}
+
+static u32 deflate_encode_hash(const u8* data) {
+  const u32 sequence = data[0] | (u32)data[1] << 8 | (u32)data[2] << 16;
+  return (sequence * 2654435761u) >> (32 - deflate_encode_hash_bits);
+}
+
+void deflate_encode_chunk(const String input, const bool last, DynString* out) {
+  diag_assert_msg(input.size < u32_max, "deflate_encode_chunk: Input too big");
+
+  DeflateEncCtx ctx = {.out = out};
+
+  // Block header: final flag (only when no other chunk follows) and the fixed-Huffman block type.
+  deflate_write_bits(&ctx, last ? 1 : 0, 1);
+  deflate_write_bits(&ctx, 1 /* fixed Huffman codes */, 2);
+
+  const Mem hashMem =
+      alloc_alloc(g_allocHeap, sizeof(u32) * deflate_encode_hash_size, alignof(u32));
+  u32* hashTable = hashMem.ptr;
+  mem_set(hashMem, 0xFF); // Initialize all positions to sentinel.
+
+  const u8*   data = mem_begin(input);
+  const usize size = input.size;
+  for (usize pos = 0; pos != size;) {
+    usize matchLength = 0, matchDist = 0;
+    if (pos + deflate_encode_min_match <= size) {
+      const u32 hash      = deflate_encode_hash(data + pos);
+      const u32 candidate = hashTable[hash];
+      hashTable[hash]     = (u32)pos;
+      if (!sentinel_check(candidate) && (pos - candidate) <= deflate_encode_max_dist) {
+        const usize limit = math_min(size - pos, deflate_encode_max_match);
+        usize       len   = 0;
+        while (len != limit && data[candidate + len] == data[pos + len]) {
+          ++len;
+        }
+        if (len >= deflate_encode_min_match) {
+          matchLength = len;
+          matchDist   = pos - candidate;
+        }
+      }
+    }
+    if (matchLength) {
+      deflate_write_run(&ctx, (u32)matchLength, (u32)matchDist);
+      // Register the hashes of the sequences inside the match.
+      const usize hashEnd = math_min(pos + matchLength, size - deflate_encode_min_match + 1);
+      for (usize i = pos + 1; i < hashEnd; ++i) {
+        hashTable[deflate_encode_hash(data + i)] = (u32)i;
+      }
+      pos += matchLength;
+    } else {
+      deflate_write_code(&ctx, g_fixedLiteralEnc[data[pos]]);
+      ++pos;
+    }
+  }
+
+  deflate_write_code(&ctx, g_fixedLiteralEnc[256]); // End of block.
+
+  if (last) {
+    deflate_write_align(&ctx);
+  } else {
+    /**
+     * Sync flush: an empty stored block to end the chunk on a byte boundary, making it possible to
+     * concatenate independently encoded chunks into a single valid stream.
+     */
+    deflate_write_bits(&ctx, 0, 1); // Not the final block.
+    deflate_write_bits(&ctx, 0, 2); // Stored (uncompressed) block.
+    deflate_write_align(&ctx);
+    dynstring_append_char(out, 0x00); // LEN.
+    dynstring_append_char(out, 0x00);
+    dynstring_append_char(out, 0xFF); // NLEN.
+    dynstring_append_char(out, 0xFF);
+  }
+
+  alloc_free(g_allocHeap, hashMem);
+}
+
+void deflate_encode(const String input, DynString* out) { deflate_encode_chunk(input, true, out); }
+
+static void deflate_init_enc_table(const HuffmanTree* tree, DeflateEncCode out[]) {
+  HuffmanCode codes[huffman_max_symbols];
+  huffman_codes(tree, codes);
+  for (u32 i = 0; i != tree->leafCount; ++i) {
+    out[tree->leafSymbols[i]] = (DeflateEncCode){
+        .bits  = huffman_code_stream_bits(codes[i]),
+        .count = (u8)codes[i].level,
+    };
+  }
+}
+
 static void deflate_init_fixed_literal_tree(HuffmanTree* tree) {
   u8  symbolLevels[huffman_max_symbols];
   u32 i = 0;
@@ -682,6 +957,8 @@ static void deflate_init_fixed_distance_tree(HuffmanTree* tree) {
 void deflate_init(void) {
   deflate_init_fixed_literal_tree(&g_fixedLiteralTree);
   deflate_init_fixed_distance_tree(&g_fixedDistanceTree);
+  deflate_init_enc_table(&g_fixedLiteralTree, g_fixedLiteralEnc);
+  deflate_init_enc_table(&g_fixedDistanceTree, g_fixedDistanceEnc);
 }
 
 String deflate_decode(const String input, DynString* out, DeflateError* err) {
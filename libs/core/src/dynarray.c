@@ -18,9 +18,10 @@ DynArray
 dynarray_create(Allocator* alloc, const u32 stride, const u16 align, const usize capacity) {
   diag_assert(stride);
   DynArray array = {
-      .stride = stride,
-      .align  = align,
-      .alloc  = alloc,
+      .stride  = stride,
+      .align   = align,
+      .alloc   = alloc,
+      .ownsMem = true,
   };
   if (capacity) {
     const usize capacityBytes = bits_nextpow2_64(capacity * stride);
@@ -40,28 +41,46 @@ DynArray dynarray_create_over(const Mem memory, const u32 stride) {
   return array;
 }
 
+DynArray
+dynarray_create_over_spill(const Mem memory, const u32 stride, const u16 align, Allocator* alloc) {
+  diag_assert(stride);
+  DynArray array = {
+      .stride = stride,
+      .align  = align,
+      .alloc  = alloc,
+      .data   = memory,
+  };
+  return array;
+}
+
 void dynarray_destroy(DynArray* a) {
-  if (a->alloc && LIKELY(mem_valid(a->data))) {
-    // Having a allocator pointer (and a valid allocation) means we should free the backing memory.
+  if (a->ownsMem && LIKELY(mem_valid(a->data))) {
     alloc_free(a->alloc, a->data);
   }
 }
 
 usize dynarray_size(const DynArray* a) { return a->size; }
 
-NO_INLINE_HINT static void dynarray_resize_grow(DynArray* a, const usize capacity) {
+static void dynarray_grow_to(DynArray* a, const usize capacityBytes) {
   diag_assert_msg(a->alloc, "DynArray without an allocator ran out of memory");
 
-  const Mem newMem = alloc_alloc(a->alloc, bits_nextpow2_64(capacity * a->stride), a->align);
+  const Mem newMem = alloc_alloc(a->alloc, capacityBytes, a->align);
   if (UNLIKELY(!mem_valid(newMem))) {
     diag_crash_msg("Dynamic array allocation failed");
   }
 
   if (LIKELY(mem_valid(a->data))) {
     mem_cpy(newMem, a->data);
-    alloc_free(a->alloc, a->data);
+    if (a->ownsMem) {
+      alloc_free(a->alloc, a->data);
+    }
   }
-  a->data = newMem;
+  a->data    = newMem;
+  a->ownsMem = true;
+}
+
+NO_INLINE_HINT static void dynarray_resize_grow(DynArray* a, const usize capacity) {
+  dynarray_grow_to(a, bits_nextpow2_64(capacity * a->stride));
 }
 
 INLINE_HINT static void dynarray_resize_internal(DynArray* a, const usize size) {
@@ -74,16 +93,39 @@ INLINE_HINT static void dynarray_resize_internal(DynArray* a, const usize size)
 void dynarray_resize(DynArray* a, const usize size) { dynarray_resize_internal(a, size); }
 
 void dynarray_reserve(DynArray* a, const usize capacity) {
-  if (UNLIKELY(capacity * a->stride > a->data.size)) {
-    dynarray_resize_grow(a, capacity);
+  if (capacity * a->stride > a->data.size) {
+    // NOTE: Sized exactly (no geometric overshoot); reserving callers know their final count.
+    dynarray_grow_to(a, capacity * a->stride);
+  }
+}
+
+void dynarray_shrink_to_fit(DynArray* a) {
+  if (!a->ownsMem || !mem_valid(a->data)) {
+    return; // Array does not own its memory (or has no allocation).
   }
+  const usize usedBytes = a->size * a->stride;
+  if (usedBytes == a->data.size) {
+    return;
+  }
+  if (!usedBytes) {
+    alloc_free(a->alloc, a->data);
+    a->data = mem_empty;
+    return;
+  }
+  const Mem newMem = alloc_alloc(a->alloc, usedBytes, a->align);
+  if (UNLIKELY(!mem_valid(newMem))) {
+    return; // Allocation failed; keep the current (bigger) allocation.
+  }
+  mem_cpy(newMem, mem_slice(a->data, 0, usedBytes));
+  alloc_free(a->alloc, a->data);
+  a->data = newMem;
 }
 
 void dynarray_clear(DynArray* a) { a->size = 0; }
 
 void dynarray_release(DynArray* a) {
   a->size = 0;
-  if (mem_valid(a->data)) {
+  if (a->ownsMem && mem_valid(a->data)) {
     alloc_free(a->alloc, a->data);
     a->data = mem_empty;
   }
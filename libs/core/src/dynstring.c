@@ -9,6 +9,10 @@ DynString dynstring_create(Allocator* alloc, usize capacity) {
 
 DynString dynstring_create_over(Mem memory) { return dynarray_create_over(memory, 1u); }
 
+DynString dynstring_create_over_spill(Mem memory, Allocator* alloc) {
+  return dynarray_create_over_spill(memory, 1u, 1u, alloc);
+}
+
 void dynstring_destroy(DynString* dynstring) { dynarray_destroy(dynstring); }
 
 usize dynstring_size(const DynString* dynstring) { return dynstring->size; }
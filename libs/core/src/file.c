@@ -27,6 +27,7 @@ static const String g_fileResultStrs[] = {
     string_static("FileEmpty"),
     string_static("FileTooBig"),
     string_static("InvalidMapping"),
+    string_static("FileWouldBlock"),
     string_static("FileUnknownError"),
 };
 
@@ -43,6 +44,17 @@ static FileMapping* file_mapping_find(File* file, void* ptr) {
   return dynarray_search_binary(&file->mappings, file_mapping_compare, &target);
 }
 
+static FileMapping* file_mapping_find_containing(File* file, const String region) {
+  dynarray_for_t(&file->mappings, FileMapping, mapping) {
+    const u8* mappingBegin = mapping->ptr;
+    const u8* mappingEnd   = mappingBegin + mapping->size;
+    if ((const u8*)region.ptr >= mappingBegin && (const u8*)string_end(region) <= mappingEnd) {
+      return mapping;
+    }
+  }
+  return null;
+}
+
 static void file_mapping_add(File* file, const FileMapping* mapping) {
   *dynarray_insert_sorted_t(&file->mappings, FileMapping, file_mapping_compare, mapping) = *mapping;
 }
@@ -139,6 +151,14 @@ FileResult file_unmap(File* file, const String mapping) {
   return res;
 }
 
+FileResult file_map_advise(File* file, const String region, const FileHints hints) {
+  FileMapping* mappingInfo = file_mapping_find_containing(file, region);
+  if (UNLIKELY(!mappingInfo)) {
+    return FileResult_InvalidMapping;
+  }
+  return file_pal_map_advise(file, mappingInfo, region, hints);
+}
+
 FileResult file_write_to_path_sync(const String path, const String data) {
   File*      file = null;
   FileResult res;
@@ -32,6 +32,7 @@ FileResult file_pal_temp(Allocator*, File** file);
 void       file_pal_destroy(File*);
 
 FileResult file_pal_map(File*, usize offset, usize size, FileHints, FileMapping* out);
+FileResult file_pal_map_advise(File*, const FileMapping*, String region, FileHints);
 FileResult file_pal_unmap(File*, FileMapping* mapping);
 
 /**
@@ -0,0 +1,7 @@
+#if defined(VOLO_LINUX)
+#include "file_async_pal_linux.c"
+#elif defined(VOLO_WIN32)
+#include "file_async_pal_win32.c"
+#else
+#error Unsupported platform
+#endif
@@ -0,0 +1,325 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/file_async.h"
+#include "core/thread.h"
+
+#include "file.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Maximum number of operations that can be in flight at the same time.
+ */
+#define file_async_queue_depth 64
+
+typedef enum {
+  FileAsyncOpState_Free,
+  FileAsyncOpState_Pending,
+  FileAsyncOpState_Done,
+} FileAsyncOpState;
+
+typedef struct {
+  FileAsyncId      id;
+  FileAsyncOpState state;
+  FileResult       result;
+  usize            bytes;
+} FileAsyncOp;
+
+struct sFileAsync {
+  Allocator*     alloc;
+  ThreadSpinLock lock;
+  FileAsyncId    nextId;
+  u32            pendingCount;
+  FileAsyncOp    ops[file_async_queue_depth];
+
+  /**
+   * io_uring instance; when setup fails (kernel too old or the syscall is denied) 'ringFd' is
+   * negative and operations complete synchronously at submission time instead.
+   */
+  int ringFd;
+
+  // Submission queue (mapped from the ring fd).
+  u32*                sqHead, *sqTail, *sqMask, *sqArray;
+  struct io_uring_sqe* sqes;
+  void*                sqRingMem;
+  usize                sqRingSize, sqesSize;
+
+  // Completion queue (mapped from the ring fd).
+  u32*                 cqHead, *cqTail, *cqMask;
+  struct io_uring_cqe* cqes;
+  void*                cqRingMem;
+  usize                cqRingSize;
+};
+
+static int file_async_io_uring_setup(const u32 entries, struct io_uring_params* params) {
+  return (int)syscall(SYS_io_uring_setup, entries, params);
+}
+
+static int file_async_io_uring_enter(
+    const int fd, const u32 toSubmit, const u32 minComplete, const u32 flags) {
+  return (int)syscall(SYS_io_uring_enter, fd, toSubmit, minComplete, flags, null, 0);
+}
+
+NO_INLINE_HINT static FileResult file_async_result_from_errno(const int err) {
+  switch (err) {
+  case EACCES:
+  case EPERM:
+  case EROFS:
+    return FileResult_NoAccess;
+  case EDQUOT:
+  case ENOSPC:
+    return FileResult_DiskFull;
+  case EFBIG:
+    return FileResult_FileTooBig;
+  case EISDIR:
+    return FileResult_IsDirectory;
+  }
+  return FileResult_UnknownError;
+}
+
+static bool file_async_ring_init(FileAsync* async) {
+  struct io_uring_params params = {0};
+
+  async->ringFd = file_async_io_uring_setup(file_async_queue_depth, &params);
+  if (async->ringFd < 0) {
+    return false; // io_uring unavailable; fall back to synchronous completion.
+  }
+
+  async->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+  async->sqRingMem  = mmap(
+      null,
+      async->sqRingSize,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      async->ringFd,
+      IORING_OFF_SQ_RING);
+
+  async->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+  async->sqes     = mmap(
+      null,
+      async->sqesSize,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      async->ringFd,
+      IORING_OFF_SQES);
+
+  async->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  async->cqRingMem  = mmap(
+      null,
+      async->cqRingSize,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      async->ringFd,
+      IORING_OFF_CQ_RING);
+
+  if (async->sqRingMem == MAP_FAILED || async->sqes == MAP_FAILED ||
+      async->cqRingMem == MAP_FAILED) {
+    diag_crash_msg("file-async: Failed to map the io_uring rings");
+  }
+
+  u8* sqRing     = async->sqRingMem;
+  async->sqHead  = (u32*)(sqRing + params.sq_off.head);
+  async->sqTail  = (u32*)(sqRing + params.sq_off.tail);
+  async->sqMask  = (u32*)(sqRing + params.sq_off.ring_mask);
+  async->sqArray = (u32*)(sqRing + params.sq_off.array);
+
+  u8* cqRing    = async->cqRingMem;
+  async->cqHead = (u32*)(cqRing + params.cq_off.head);
+  async->cqTail = (u32*)(cqRing + params.cq_off.tail);
+  async->cqMask = (u32*)(cqRing + params.cq_off.ring_mask);
+  async->cqes   = (struct io_uring_cqe*)(cqRing + params.cq_off.cqes);
+  return true;
+}
+
+static void file_async_ring_teardown(FileAsync* async) {
+  if (async->ringFd < 0) {
+    return;
+  }
+  munmap(async->sqRingMem, async->sqRingSize);
+  munmap(async->sqes, async->sqesSize);
+  munmap(async->cqRingMem, async->cqRingSize);
+  close(async->ringFd);
+}
+
+static FileAsyncOp* file_async_op(FileAsync* async, const FileAsyncId id) {
+  return &async->ops[id & (file_async_queue_depth - 1)];
+}
+
+/**
+ * Process all available completion queue entries.
+ * Pre-condition: Lock is held.
+ */
+static void file_async_reap(FileAsync* async) {
+  if (async->ringFd < 0) {
+    return;
+  }
+  u32       head = thread_atomic_load_u32(async->cqHead);
+  const u32 tail = thread_atomic_load_u32(async->cqTail);
+  for (; head != tail; ++head) {
+    const struct io_uring_cqe* cqe = &async->cqes[head & *async->cqMask];
+    FileAsyncOp*               op  = file_async_op(async, (FileAsyncId)cqe->user_data);
+
+    diag_assert(op->state == FileAsyncOpState_Pending);
+    op->state = FileAsyncOpState_Done;
+    if (cqe->res < 0) {
+      op->result = file_async_result_from_errno(-cqe->res);
+      op->bytes  = 0;
+    } else {
+      op->result = cqe->res ? FileResult_Success : FileResult_NoDataAvailable;
+      op->bytes  = (usize)cqe->res;
+    }
+    --async->pendingCount;
+  }
+  thread_atomic_store_u32(async->cqHead, head);
+}
+
+/**
+ * Block until at least one pending operation completes.
+ * Pre-condition: Lock is held.
+ */
+static void file_async_wait_any(FileAsync* async) {
+  diag_assert(async->pendingCount);
+  file_async_io_uring_enter(async->ringFd, 0, 1, IORING_ENTER_GETEVENTS);
+  file_async_reap(async);
+}
+
+/**
+ * Submit an operation to the ring (or complete it synchronously in fallback mode).
+ * Pre-condition: Lock is held.
+ */
+static FileAsyncId file_async_submit(
+    FileAsync*  async,
+    File*       file,
+    const u8    opcode,
+    const usize offset,
+    void*       buffer,
+    const usize size) {
+
+  const FileAsyncId id = async->nextId++;
+  FileAsyncOp*      op = file_async_op(async, id);
+
+  // When the queue slot is still occupied wait for older operations to complete.
+  while (op->state == FileAsyncOpState_Pending) {
+    file_async_wait_any(async);
+  }
+  op->id    = id;
+  op->state = FileAsyncOpState_Pending;
+
+  if (async->ringFd < 0) {
+    // Fallback: complete the operation synchronously at submission time.
+    const iptr res = opcode == IORING_OP_READ ? pread(file->handle, buffer, size, (off_t)offset)
+                                              : pwrite(file->handle, buffer, size, (off_t)offset);
+    op->state = FileAsyncOpState_Done;
+    if (res < 0) {
+      op->result = file_async_result_from_errno(errno);
+      op->bytes  = 0;
+    } else {
+      op->result = res ? FileResult_Success : FileResult_NoDataAvailable;
+      op->bytes  = (usize)res;
+    }
+    return id;
+  }
+
+  const u32            tail = thread_atomic_load_u32(async->sqTail);
+  const u32            idx  = tail & *async->sqMask;
+  struct io_uring_sqe* sqe  = &async->sqes[idx];
+
+  *sqe = (struct io_uring_sqe){
+      .opcode    = opcode,
+      .fd        = file->handle,
+      .off       = offset,
+      .addr      = (u64)(uptr)buffer,
+      .len       = (u32)size,
+      .user_data = id,
+  };
+  async->sqArray[idx] = idx;
+  thread_atomic_store_u32(async->sqTail, tail + 1);
+
+  ++async->pendingCount;
+  const int res = file_async_io_uring_enter(async->ringFd, 1, 0, 0);
+  if (UNLIKELY(res < 0)) {
+    diag_crash_msg("file-async: io_uring submission failed");
+  }
+  return id;
+}
+
+FileAsync* file_async_create(Allocator* alloc) {
+  FileAsync* async = alloc_alloc_t(alloc, FileAsync);
+
+  *async = (FileAsync){.alloc = alloc};
+  file_async_ring_init(async);
+  return async;
+}
+
+void file_async_destroy(FileAsync* async) {
+  thread_spinlock_lock(&async->lock);
+  while (async->pendingCount) {
+    file_async_wait_any(async);
+  }
+  thread_spinlock_unlock(&async->lock);
+
+  file_async_ring_teardown(async);
+  alloc_free_t(async->alloc, async);
+}
+
+FileAsyncId file_async_read(FileAsync* async, File* file, const usize offset, const Mem buffer) {
+  diag_assert(file->access & FileAccess_Read);
+
+  thread_spinlock_lock(&async->lock);
+  file_async_reap(async);
+  const FileAsyncId id =
+      file_async_submit(async, file, IORING_OP_READ, offset, mem_begin(buffer), buffer.size);
+  thread_spinlock_unlock(&async->lock);
+  return id;
+}
+
+FileAsyncId file_async_write(FileAsync* async, File* file, const usize offset, const String data) {
+  diag_assert(file->access & FileAccess_Write);
+
+  thread_spinlock_lock(&async->lock);
+  file_async_reap(async);
+  const FileAsyncId id =
+      file_async_submit(async, file, IORING_OP_WRITE, offset, mem_begin(data), data.size);
+  thread_spinlock_unlock(&async->lock);
+  return id;
+}
+
+bool file_async_poll(
+    FileAsync* async, const FileAsyncId id, FileResult* outResult, usize* outBytes) {
+  bool done = false;
+
+  thread_spinlock_lock(&async->lock);
+  file_async_reap(async);
+  FileAsyncOp* op = file_async_op(async, id);
+  diag_assert_msg(op->id == id, "file-async: Operation already recycled");
+  if (op->state == FileAsyncOpState_Done) {
+    op->state  = FileAsyncOpState_Free;
+    *outResult = op->result;
+    *outBytes  = op->bytes;
+    done       = true;
+  }
+  thread_spinlock_unlock(&async->lock);
+  return done;
+}
+
+FileResult file_async_wait(FileAsync* async, const FileAsyncId id, usize* outBytes) {
+  FileResult result;
+
+  thread_spinlock_lock(&async->lock);
+  file_async_reap(async);
+  FileAsyncOp* op = file_async_op(async, id);
+  diag_assert_msg(op->id == id, "file-async: Operation already recycled");
+  while (op->state == FileAsyncOpState_Pending) {
+    file_async_wait_any(async);
+  }
+  diag_assert(op->state == FileAsyncOpState_Done);
+  op->state = FileAsyncOpState_Free;
+  result    = op->result;
+  *outBytes = op->bytes;
+  thread_spinlock_unlock(&async->lock);
+  return result;
+}
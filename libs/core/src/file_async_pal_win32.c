@@ -0,0 +1,126 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/file_async.h"
+#include "core/thread.h"
+
+#include "file.h"
+
+#include <Windows.h>
+
+/**
+ * Maximum number of operations that can be in flight at the same time.
+ */
+#define file_async_queue_depth 64
+
+/**
+ * Win32 implementation completes operations synchronously at submission time (positioned
+ * reads / writes through the OVERLAPPED offset), results are still delivered through the same
+ * poll / wait api.
+ */
+
+typedef enum {
+  FileAsyncOpState_Free,
+  FileAsyncOpState_Done,
+} FileAsyncOpState;
+
+typedef struct {
+  FileAsyncId      id;
+  FileAsyncOpState state;
+  FileResult       result;
+  usize            bytes;
+} FileAsyncOp;
+
+struct sFileAsync {
+  Allocator*     alloc;
+  ThreadSpinLock lock;
+  FileAsyncId    nextId;
+  FileAsyncOp    ops[file_async_queue_depth];
+};
+
+NO_INLINE_HINT static FileResult file_async_result_from_lasterror(void) {
+  switch (GetLastError()) {
+  case ERROR_ACCESS_DENIED:
+    return FileResult_NoAccess;
+  case ERROR_DISK_FULL:
+    return FileResult_DiskFull;
+  case ERROR_HANDLE_EOF:
+    return FileResult_NoDataAvailable;
+  }
+  return FileResult_UnknownError;
+}
+
+static FileAsyncOp* file_async_op(FileAsync* async, const FileAsyncId id) {
+  return &async->ops[id & (file_async_queue_depth - 1)];
+}
+
+static FileAsyncId file_async_submit(
+    FileAsync* async, File* file, const bool read, const usize offset, void* buffer, usize size) {
+
+  const FileAsyncId id = async->nextId++;
+  FileAsyncOp*      op = file_async_op(async, id);
+
+  op->id    = id;
+  op->state = FileAsyncOpState_Done;
+
+  OVERLAPPED overlapped = {
+      .Offset     = (DWORD)offset,
+      .OffsetHigh = (DWORD)(offset >> 32),
+  };
+  DWORD bytes;
+  const BOOL success = read ? ReadFile(file->handle, buffer, (DWORD)size, &bytes, &overlapped)
+                            : WriteFile(file->handle, buffer, (DWORD)size, &bytes, &overlapped);
+  if (!success) {
+    op->result = file_async_result_from_lasterror();
+    op->bytes  = 0;
+  } else {
+    op->result = bytes ? FileResult_Success : FileResult_NoDataAvailable;
+    op->bytes  = (usize)bytes;
+  }
+  return id;
+}
+
+FileAsync* file_async_create(Allocator* alloc) {
+  FileAsync* async = alloc_alloc_t(alloc, FileAsync);
+
+  *async = (FileAsync){.alloc = alloc};
+  return async;
+}
+
+void file_async_destroy(FileAsync* async) { alloc_free_t(async->alloc, async); }
+
+FileAsyncId file_async_read(FileAsync* async, File* file, const usize offset, const Mem buffer) {
+  diag_assert(file->access & FileAccess_Read);
+
+  thread_spinlock_lock(&async->lock);
+  const FileAsyncId id = file_async_submit(async, file, true, offset, mem_begin(buffer), buffer.size);
+  thread_spinlock_unlock(&async->lock);
+  return id;
+}
+
+FileAsyncId file_async_write(FileAsync* async, File* file, const usize offset, const String data) {
+  diag_assert(file->access & FileAccess_Write);
+
+  thread_spinlock_lock(&async->lock);
+  const FileAsyncId id = file_async_submit(async, file, false, offset, mem_begin(data), data.size);
+  thread_spinlock_unlock(&async->lock);
+  return id;
+}
+
+bool file_async_poll(
+    FileAsync* async, const FileAsyncId id, FileResult* outResult, usize* outBytes) {
+  thread_spinlock_lock(&async->lock);
+  FileAsyncOp* op = file_async_op(async, id);
+  diag_assert_msg(op->id == id, "file-async: Operation already recycled");
+  diag_assert(op->state == FileAsyncOpState_Done);
+  op->state  = FileAsyncOpState_Free;
+  *outResult = op->result;
+  *outBytes  = op->bytes;
+  thread_spinlock_unlock(&async->lock);
+  return true;
+}
+
+FileResult file_async_wait(FileAsync* async, const FileAsyncId id, usize* outBytes) {
+  FileResult result;
+  file_async_poll(async, id, &result, outBytes);
+  return result;
+}
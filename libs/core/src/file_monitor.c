@@ -1,6 +1,8 @@
 #include "core/array.h"
 #include "core/diag.h"
 #include "core/file_monitor.h"
+#include "core/math.h"
+#include "core/thread.h"
 
 static const String g_fileMonitorResultStrs[] = {
     string_static("FileMonitorSuccess"),
@@ -21,3 +23,45 @@ String file_monitor_result_str(const FileMonitorResult result) {
   diag_assert(result < FileMonitorResult_Count);
   return g_fileMonitorResultStrs[result];
 }
+
+static bool file_monitor_event_contains(
+    const FileMonitorEvent events[], const usize count, const FileMonitorEvent* event) {
+  for (usize i = 0; i != count; ++i) {
+    if (string_eq(events[i].path, event->path) && events[i].userData == event->userData) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static usize file_monitor_drain(
+    FileMonitor* monitor, FileMonitorEvent out[], usize count, const usize outCapacity) {
+  FileMonitorEvent event;
+  while (count != outCapacity && file_monitor_poll(monitor, &event)) {
+    if (!file_monitor_event_contains(out, count, &event)) {
+      out[count++] = event;
+    }
+  }
+  return count;
+}
+
+usize file_monitor_poll_many(
+    FileMonitor*       monitor,
+    const TimeDuration window,
+    FileMonitorEvent   out[],
+    const usize        outCapacity) {
+  usize count = file_monitor_drain(monitor, out, 0, outCapacity);
+  if (!count) {
+    return 0; // No burst in progress; do not make the caller wait for the window.
+  }
+  const TimeSteady burstStart = time_steady_clock();
+  while (count != outCapacity) {
+    const TimeDuration elapsed = time_steady_duration(burstStart, time_steady_clock());
+    if (elapsed >= window) {
+      break;
+    }
+    thread_sleep(math_min(window - elapsed, time_millisecond));
+    count = file_monitor_drain(monitor, out, count, outCapacity);
+  }
+  return count;
+}
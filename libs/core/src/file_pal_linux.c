@@ -56,6 +56,8 @@ NO_INLINE_HINT static FileResult fileresult_from_errno(void) {
     return FileResult_InvalidFilename;
   case EISDIR:
     return FileResult_IsDirectory;
+  case EAGAIN:
+    return FileResult_WouldBlock;
   }
   return FileResult_UnknownError;
 }
@@ -434,6 +436,12 @@ file_pal_map(File* file, const usize offset, usize size, const FileHints hints,
       diag_crash_msg("posix_fadvise() (errno: {})", fmt_int(errno));
     }
   }
+  if (hints & FileHints_Sequential) {
+    madvise(addr, size + padding, MADV_SEQUENTIAL);
+  }
+  if (hints & FileHints_Random) {
+    madvise(addr, size + padding, MADV_RANDOM);
+  }
 
   *out = (FileMapping){
       .offset = offset,
@@ -443,6 +451,35 @@ file_pal_map(File* file, const usize offset, usize size, const FileHints hints,
   return FileResult_Success;
 }
 
+FileResult file_pal_map_advise(
+    File* file, const FileMapping* mapping, const String region, const FileHints hints) {
+  (void)file;
+  (void)mapping;
+
+  // Align the region start down to a page boundary as required by madvise.
+  const uptr  regionAddr    = (uptr)region.ptr;
+  const uptr  alignedAddr   = regionAddr / g_filePageSize * g_filePageSize;
+  const usize alignedSize   = region.size + (regionAddr - alignedAddr);
+  void* const alignedPtr    = (void*)alignedAddr;
+
+  if (hints & FileHints_Prefetch) {
+    if (UNLIKELY(madvise(alignedPtr, alignedSize, MADV_WILLNEED) != 0)) {
+      return fileresult_from_errno();
+    }
+  }
+  if (hints & FileHints_Sequential) {
+    if (UNLIKELY(madvise(alignedPtr, alignedSize, MADV_SEQUENTIAL) != 0)) {
+      return fileresult_from_errno();
+    }
+  }
+  if (hints & FileHints_Random) {
+    if (UNLIKELY(madvise(alignedPtr, alignedSize, MADV_RANDOM) != 0)) {
+      return fileresult_from_errno();
+    }
+  }
+  return FileResult_Success;
+}
+
 FileResult file_pal_unmap(File* file, FileMapping* mapping) {
   (void)file;
   diag_assert_msg(mapping->ptr, "Invalid mapping");
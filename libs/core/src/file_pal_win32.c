@@ -74,6 +74,8 @@ NO_INLINE_HINT static FileResult fileresult_from_lasterror(void) {
     return FileResult_AlreadyExists;
   case ERROR_MAPPED_ALIGNMENT:
     return FileResult_InvalidMapping;
+  case ERROR_NO_DATA:
+    return FileResult_WouldBlock;
   }
   return FileResult_UnknownError;
 }
@@ -498,6 +500,24 @@ file_pal_map(File* file, const usize offset, usize size, const FileHints hints,
   return FileResult_Success;
 }
 
+FileResult file_pal_map_advise(
+    File* file, const FileMapping* mapping, const String region, const FileHints hints) {
+  (void)file;
+  (void)mapping;
+
+  // NOTE: Win32 has no equivalent of the sequential / random access hints for existing mappings.
+  if (hints & FileHints_Prefetch) {
+    WIN32_MEMORY_RANGE_ENTRY entries[] = {
+        {.VirtualAddress = region.ptr, .NumberOfBytes = region.size},
+    };
+    HANDLE process = GetCurrentProcess();
+    if (UNLIKELY(!PrefetchVirtualMemory(process, array_elems(entries), entries, 0))) {
+      return fileresult_from_lasterror();
+    }
+  }
+  return FileResult_Success;
+}
+
 FileResult file_pal_unmap(File* file, FileMapping* mapping) {
   (void)file;
   diag_assert_msg(mapping->ptr, "Invalid mapping");
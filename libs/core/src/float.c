@@ -178,6 +178,41 @@ f32 float_f16_to_f32(const f16 val) {
   return float_f16_to_f32_soft(val);
 }
 
+void float_f32_to_f16_batch(const f32 in[], f16 out[], const usize count) {
+  usize i = 0;
+  if (g_f16cSupport) {
+    COMPILER_BARRIER(); // Don't allow re-ordering the intrinsic conversions before the check.
+    for (; count - i >= 4; i += 4) {
+      const __m128i packed = _mm_cvtps_ph(_mm_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+      _mm_storel_epi64((__m128i*)(out + i), packed);
+    }
+    for (; i != count; ++i) {
+      out[i] = float_f32_to_f16_intrinsic(in[i]);
+    }
+    return;
+  }
+  for (; i != count; ++i) {
+    out[i] = float_f32_to_f16_soft(in[i]);
+  }
+}
+
+void float_f16_to_f32_batch(const f16 in[], f32 out[], const usize count) {
+  usize i = 0;
+  if (g_f16cSupport) {
+    COMPILER_BARRIER(); // Don't allow re-ordering the intrinsic conversions before the check.
+    for (; count - i >= 4; i += 4) {
+      _mm_storeu_ps(out + i, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(in + i))));
+    }
+    for (; i != count; ++i) {
+      out[i] = float_f16_to_f32_intrinsic(in[i]);
+    }
+    return;
+  }
+  for (; i != count; ++i) {
+    out[i] = float_f16_to_f32_soft(in[i]);
+  }
+}
+
 f32 float_quantize_f32(const f32 val, const u8 maxMantissaBits) {
   u32 valBits = float_f32_as_u32(val);
 
@@ -10,6 +10,7 @@
 #include "core/math.h"
 #include "core/path.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
 #include "core/time.h"
 
 #define fmt_txt_len_max (4 * usize_kibibyte)
@@ -114,6 +115,32 @@ static bool format_replacement_find(String str, FormatRepl* result) {
   return true;
 }
 
+static void
+format_write_arg_with_opt(DynString* str, const FormatArg* arg, const FormatReplOpt opt) {
+  const usize argStart = str->size;
+  format_write_arg(str, arg);
+  const usize argEnd = str->size;
+
+  // Apply the formatting option.
+  switch (opt.kind) {
+  case FormatReplOptKind_None:
+    break;
+  case FormatReplOptKind_PadLeft: {
+    const usize padding = math_max(0, opt.value - (i32)(argEnd - argStart));
+    dynstring_insert_chars(str, ' ', argStart, padding);
+  } break;
+  case FormatReplOptKind_PadRight: {
+    const usize padding = math_max(0, opt.value - (i32)(argEnd - argStart));
+    dynstring_append_chars(str, ' ', padding);
+  } break;
+  case FormatReplOptKind_PadCenter: {
+    const usize padding = math_max(0, opt.value - (i32)(argEnd - argStart));
+    dynstring_insert_chars(str, ' ', argStart, padding / 2);
+    dynstring_append_chars(str, ' ', padding / 2 + padding % 2);
+  } break;
+  }
+}
+
 void format_write_formatted(DynString* str, String format, const FormatArg* argHead) {
   while (format.size) {
     FormatRepl repl;
@@ -128,33 +155,58 @@ void format_write_formatted(DynString* str, String format, const FormatArg* argH
 
     // Append the replacement argument.
     if (argHead->type != FormatArgType_End) {
-      const usize argStart = str->size;
-      format_write_arg(str, argHead);
-      const usize argEnd = str->size;
+      format_write_arg_with_opt(str, argHead, repl.opt);
+      ++argHead;
+    }
+    format_mem_consume_inplace(&format, repl.end);
+  }
+}
 
-      // Apply the formatting option.
-      switch (repl.opt.kind) {
-      case FormatReplOptKind_None:
-        break;
-      case FormatReplOptKind_PadLeft: {
-        const usize padding = math_max(0, repl.opt.value - (i32)(argEnd - argStart));
-        dynstring_insert_chars(str, ' ', argStart, padding);
-      } break;
-      case FormatReplOptKind_PadRight: {
-        const usize padding = math_max(0, repl.opt.value - (i32)(argEnd - argStart));
-        dynstring_append_chars(str, ' ', padding);
-      } break;
-      case FormatReplOptKind_PadCenter: {
-        const usize padding = math_max(0, repl.opt.value - (i32)(argEnd - argStart));
-        dynstring_insert_chars(str, ' ', argStart, padding / 2);
-        dynstring_append_chars(str, ' ', padding / 2 + padding % 2);
-      } break;
-      }
+void format_compile(FormatCompiled* out, String format) {
+  out->spanCount = 0;
+  while (format.size) {
+    FormatRepl repl;
+    if (!format_replacement_find(format, &repl)) {
+      break; // No replacement, the remaining text is the tail.
+    }
+    diag_assert_msg(
+        out->spanCount != format_compiled_max_spans,
+        "Format string contains more then {} replacements",
+        fmt_int(format_compiled_max_spans));
+
+    out->spans[out->spanCount].text      = string_slice(format, 0, repl.start);
+    out->spans[out->spanCount].padKind   = (u32)repl.opt.kind;
+    out->spans[out->spanCount].padAmount = repl.opt.value;
+    ++out->spanCount;
+
+    format_mem_consume_inplace(&format, repl.end);
+  }
+  out->tail = format;
+}
 
+const FormatCompiled* format_compile_lazy(FormatCompiled* compiled, const String format) {
+  if (UNLIKELY(!thread_atomic_load_i32(&compiled->ready))) {
+    // NOTE: Concurrent first calls compile redundantly but produce identical results.
+    format_compile(compiled, format);
+    thread_atomic_store_i32(&compiled->ready, true);
+  }
+  return compiled;
+}
+
+void format_write_compiled(DynString* str, const FormatCompiled* compiled, const FormatArg* args) {
+  const FormatArg* argHead = args;
+  for (u32 i = 0; i != compiled->spanCount; ++i) {
+    dynstring_append(str, compiled->spans[i].text);
+    if (argHead->type != FormatArgType_End) {
+      const FormatReplOpt opt = {
+          .kind  = (FormatReplOptKind)compiled->spans[i].padKind,
+          .value = compiled->spans[i].padAmount,
+      };
+      format_write_arg_with_opt(str, argHead, opt);
       ++argHead;
     }
-    format_mem_consume_inplace(&format, repl.end);
   }
+  dynstring_append(str, compiled->tail);
 }
 
 String format_write_formatted_scratch(String format, const FormatArg* args) {
@@ -143,6 +143,19 @@ static u16 gzip_read_header_crc(UnzipCtx* ctx, GzipError* err) {
 static void gzip_read_data(UnzipCtx* ctx, GzipError* err) {
   const usize outOffset = ctx->out->size;
 
+  /**
+   * Pre-allocate the output using the uncompressed size from the trailer. The trailer position is
+   * only known up front when the member ends at the end of the input (the common case); treat the
+   * value as a hint and ignore implausible sizes (for example when trailing data follows).
+   */
+  if (ctx->input.size >= 8) {
+    u32 uncompressedSize;
+    mem_consume_le_u32(mem_consume(ctx->input, ctx->input.size - 4), &uncompressedSize);
+    if (uncompressedSize && uncompressedSize < ctx->input.size * 64) {
+      dynstring_reserve(ctx->out, outOffset + uncompressedSize);
+    }
+  }
+
   DeflateError deflateErr;
   ctx->input = deflate_decode(ctx->input, ctx->out, &deflateErr);
   if (UNLIKELY(deflateErr)) {
@@ -216,6 +229,28 @@ String gzip_error_str(const GzipError err) {
   return g_errorStrs[err];
 }
 
+void gzip_encode_header(DynString* out) {
+  // Header: magic id bytes, deflate method, no flags, no mod-time, no extra flags, unknown OS.
+  dynstring_append_char(out, 0x1F);
+  dynstring_append_char(out, 0x8B);
+  dynstring_append_char(out, 8 /* deflate */);
+  dynstring_append_char(out, 0 /* flags */);
+  mem_write_le_u32(dynstring_push(out, 4), 0 /* mod-time */);
+  dynstring_append_char(out, 0 /* extra flags */);
+  dynstring_append_char(out, 0xFF /* unknown OS */);
+}
+
+void gzip_encode_trailer(const String input, DynString* out) {
+  mem_write_le_u32(dynstring_push(out, 4), bits_crc_32(0, input));
+  mem_write_le_u32(dynstring_push(out, 4), (u32)input.size);
+}
+
+void gzip_encode(const String input, DynString* out) {
+  gzip_encode_header(out);
+  deflate_encode(input, out);
+  gzip_encode_trailer(input, out);
+}
+
 String gzip_decode(const String input, GzipMeta* outMeta, DynString* out, GzipError* err) {
   UnzipCtx ctx = {
       .input     = input,
@@ -1,22 +1,61 @@
+#include "core/diag.h"
 #include "core/init.h"
 #include "core/thread.h"
 
 #include "init.h"
 
+#define core_init_phases_max 16
+
 static bool              g_initalized;
 static THREAD_LOCAL bool g_initializedThread;
 
+static CoreInitPhase g_initPhases[core_init_phases_max];
+static u32           g_initPhaseCount;
+static bool          g_initPhaseOpen;
+
+void core_init_phase_begin(const String name) {
+  diag_assert(g_threadTid == g_threadMainTid);
+  diag_assert_msg(!g_initPhaseOpen, "Init phase '{}' begun while another is open", fmt_text(name));
+
+  if (UNLIKELY(g_initPhaseCount == core_init_phases_max)) {
+    return; // Phase buffer is full; drop the phase.
+  }
+  g_initPhaseOpen                = true;
+  g_initPhases[g_initPhaseCount] = (CoreInitPhase){
+      .name      = name,
+      .timeBegin = time_steady_clock(),
+  };
+}
+
+void core_init_phase_end(void) {
+  diag_assert(g_threadTid == g_threadMainTid);
+
+  if (UNLIKELY(!g_initPhaseOpen)) {
+    return; // Matching begin was dropped due to a full phase buffer.
+  }
+  g_initPhaseOpen = false;
+
+  CoreInitPhase* phase = &g_initPhases[g_initPhaseCount++];
+  phase->duration      = time_steady_duration(phase->timeBegin, time_steady_clock());
+}
+
+const CoreInitPhase* core_init_phase_data(void) { return g_initPhases; }
+
+u32 core_init_phase_count(void) { return g_initPhaseCount; }
+
 void core_init(void) {
   if (!g_initalized) {
     version_init();
     thread_init();
     float_init();
+    time_init(); // NOTE: Initialized early so startup phases can be timed.
   }
   if (!g_initializedThread) {
     thread_init_thread();
     float_init_thread();
   }
   if (!g_initalized) {
+    core_init_phase_begin(string_lit("core"));
     alloc_init();
   }
   if (!g_initializedThread) {
@@ -27,7 +66,6 @@ void core_init(void) {
     bits_init();
     deflate_init();
     symbol_init();
-    time_init();
   }
   if (!g_initializedThread) {
     rng_init_thread();
@@ -39,6 +77,7 @@ void core_init(void) {
     path_init();
     dynlib_init();
     thread_init_late();
+    core_init_phase_end();
   }
 
   g_initalized        = true;
@@ -1,6 +1,11 @@
+#include "core/diag.h"
 #include "core/math.h"
 #include "core/noise.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
 static const u8 g_perlinPermutations[512] = {
     151, 160, 137, 91,  90,  15,  131, 13,  201, 95,  96,  53,  194, 233, 7,   225, 140, 36,  103,
     30,  69,  142, 8,   99,  37,  240, 21,  10,  23,  190, 6,   148, 247, 120, 234, 75,  0,   26,
@@ -82,3 +87,183 @@ f32 noise_perlin3(f32 x, f32 y, f32 z) {
                                                       perlin_grad(g_perlinPermutations[BB + 1], x - 1, y - 1, z - 1))));
   // clang-format on
 }
+
+#ifdef VOLO_SIMD
+
+static SimdVec noise_perlin_fade_simd(const SimdVec t) {
+  // t * t * t * (t * (t * 6 - 15) + 10).
+  const SimdVec t3    = simd_vec_mul(simd_vec_mul(t, t), t);
+  const SimdVec inner = simd_vec_sub(simd_vec_mul(t, simd_vec_broadcast(6)), simd_vec_broadcast(15));
+  return simd_vec_mul(t3, simd_vec_add(simd_vec_mul(t, inner), simd_vec_broadcast(10)));
+}
+
+static SimdVec noise_perlin_lerp_simd(const SimdVec t, const SimdVec a, const SimdVec b) {
+  return simd_vec_add(a, simd_vec_mul(t, simd_vec_sub(b, a)));
+}
+
+static SimdVec noise_perlin_grad_simd(
+    const SimdVec hash, const SimdVec x, const SimdVec y, const SimdVec z) {
+  // Branchless version of the scalar 'perlin_grad'; selects are driven by comparison masks.
+  const SimdVec h       = simd_vec_and(hash, simd_vec_broadcast_i32(15));
+  const SimdVec hLess8  = simd_vec_less_i32(h, simd_vec_broadcast_i32(8));
+  const SimdVec hLess4  = simd_vec_less_i32(h, simd_vec_broadcast_i32(4));
+  const SimdVec hEq12   = simd_vec_eq_u32(h, simd_vec_broadcast_i32(12));
+  const SimdVec hEq14   = simd_vec_eq_u32(h, simd_vec_broadcast_i32(14));
+  const SimdVec vElse   = simd_vec_select(z, x, simd_vec_or(hEq12, hEq14));
+  const SimdVec u       = simd_vec_select(y, x, hLess8);
+  const SimdVec v       = simd_vec_select(vElse, y, hLess4);
+
+  // Flip the signs of u and v based on the low two bits of the hash.
+  const SimdVec one      = simd_vec_broadcast_i32(1);
+  const SimdVec two      = simd_vec_broadcast_i32(2);
+  const SimdVec bit0     = simd_vec_eq_u32(simd_vec_and(h, one), one);
+  const SimdVec bit1     = simd_vec_eq_u32(simd_vec_and(h, two), two);
+  const SimdVec signMask = simd_vec_sign_mask();
+  const SimdVec uSigned  = simd_vec_xor(u, simd_vec_and(bit0, signMask));
+  const SimdVec vSigned  = simd_vec_xor(v, simd_vec_and(bit1, signMask));
+  return simd_vec_add(uSigned, vSigned);
+}
+
+/**
+ * Evaluate 3d perlin noise for 4 samples at once (x, y and z holding one coordinate per lane).
+ * The arithmetic is fully vectorized; only the permutation-table lookups are per-lane as sse has
+ * no gather instruction.
+ */
+static SimdVec noise_perlin3_simd(SimdVec x, SimdVec y, SimdVec z) {
+  const SimdVec floorX = simd_vec_round_down(x);
+  const SimdVec floorY = simd_vec_round_down(y);
+  const SimdVec floorZ = simd_vec_round_down(z);
+
+  // Find the unit cube that contains each point.
+  const SimdVec mask255 = simd_vec_broadcast_i32(255);
+  const SimdVec iX      = simd_vec_and(simd_vec_f32_to_i32(floorX), mask255);
+  const SimdVec iY      = simd_vec_and(simd_vec_f32_to_i32(floorY), mask255);
+  const SimdVec iZ      = simd_vec_and(simd_vec_f32_to_i32(floorZ), mask255);
+
+  // Find relative x,y,z of each point in its cube.
+  x = simd_vec_sub(x, floorX);
+  y = simd_vec_sub(y, floorY);
+  z = simd_vec_sub(z, floorZ);
+
+  // Compute fade curves for each of x,y,z.
+  const SimdVec u = noise_perlin_fade_simd(x);
+  const SimdVec v = noise_perlin_fade_simd(y);
+  const SimdVec w = noise_perlin_fade_simd(z);
+
+  // Hash coordinates of the 8 cube corners, per lane.
+  ALIGNAS(16) i32 lanesX[4], lanesY[4], lanesZ[4];
+  simd_vec_store(iX, lanesX);
+  simd_vec_store(iY, lanesY);
+  simd_vec_store(iZ, lanesZ);
+
+  ALIGNAS(16) i32 hAA[4], hBA[4], hAB[4], hBB[4], hAA1[4], hBA1[4], hAB1[4], hBB1[4];
+  for (u32 l = 0; l != 4; ++l) {
+    const i32 pA  = g_perlinPermutations[lanesX[l]] + lanesY[l];
+    const i32 pB  = g_perlinPermutations[lanesX[l] + 1] + lanesY[l];
+    const i32 pAA = g_perlinPermutations[pA] + lanesZ[l];
+    const i32 pAB = g_perlinPermutations[pA + 1] + lanesZ[l];
+    const i32 pBA = g_perlinPermutations[pB] + lanesZ[l];
+    const i32 pBB = g_perlinPermutations[pB + 1] + lanesZ[l];
+
+    hAA[l]  = g_perlinPermutations[pAA];
+    hBA[l]  = g_perlinPermutations[pBA];
+    hAB[l]  = g_perlinPermutations[pAB];
+    hBB[l]  = g_perlinPermutations[pBB];
+    hAA1[l] = g_perlinPermutations[pAA + 1];
+    hBA1[l] = g_perlinPermutations[pBA + 1];
+    hAB1[l] = g_perlinPermutations[pAB + 1];
+    hBB1[l] = g_perlinPermutations[pBB + 1];
+  }
+
+  const SimdVec one = simd_vec_broadcast(1);
+  const SimdVec x1  = simd_vec_sub(x, one);
+  const SimdVec y1  = simd_vec_sub(y, one);
+  const SimdVec z1  = simd_vec_sub(z, one);
+
+  // And add blended results from the 8 corners of the cube.
+  // clang-format off
+  const SimdVec res0 = noise_perlin_lerp_simd(v,
+      noise_perlin_lerp_simd(u, noise_perlin_grad_simd(simd_vec_load(hAA), x,  y,  z),
+                                noise_perlin_grad_simd(simd_vec_load(hBA), x1, y,  z)),
+      noise_perlin_lerp_simd(u, noise_perlin_grad_simd(simd_vec_load(hAB), x,  y1, z),
+                                noise_perlin_grad_simd(simd_vec_load(hBB), x1, y1, z)));
+  const SimdVec res1 = noise_perlin_lerp_simd(v,
+      noise_perlin_lerp_simd(u, noise_perlin_grad_simd(simd_vec_load(hAA1), x,  y,  z1),
+                                noise_perlin_grad_simd(simd_vec_load(hBA1), x1, y,  z1)),
+      noise_perlin_lerp_simd(u, noise_perlin_grad_simd(simd_vec_load(hAB1), x,  y1, z1),
+                                noise_perlin_grad_simd(simd_vec_load(hBB1), x1, y1, z1)));
+  // clang-format on
+  return noise_perlin_lerp_simd(w, res0, res1);
+}
+
+#endif // VOLO_SIMD
+
+void noise_perlin3_many(
+    const f32 xs[], const f32 ys[], const f32 zs[], f32 out[], const usize count) {
+  usize i = 0;
+#ifdef VOLO_SIMD
+  for (; count - i >= 4; i += 4) {
+    const SimdVec res = noise_perlin3_simd(
+        simd_vec_load_unaligned(xs + i),
+        simd_vec_load_unaligned(ys + i),
+        simd_vec_load_unaligned(zs + i));
+    simd_vec_store_unaligned(res, out + i);
+  }
+#endif
+  for (; i != count; ++i) {
+    out[i] = noise_perlin3(xs[i], ys[i], zs[i]);
+  }
+}
+
+f32 noise_perlin3_fbm(
+    f32 x, f32 y, f32 z, const u32 octaves, const f32 lacunarity, const f32 persistence) {
+  diag_assert_msg(octaves, "noise_perlin3_fbm: At least a single octave is required");
+  f32 sum = 0.0f, amplitude = 1.0f, amplitudeTotal = 0.0f;
+  for (u32 o = 0; o != octaves; ++o) {
+    sum += noise_perlin3(x, y, z) * amplitude;
+    amplitudeTotal += amplitude;
+    amplitude *= persistence;
+    x *= lacunarity;
+    y *= lacunarity;
+    z *= lacunarity;
+  }
+  return sum / amplitudeTotal;
+}
+
+void noise_perlin3_fbm_many(
+    const f32   xs[],
+    const f32   ys[],
+    const f32   zs[],
+    f32         out[],
+    const usize count,
+    const u32   octaves,
+    const f32   lacunarity,
+    const f32   persistence) {
+  diag_assert_msg(octaves, "noise_perlin3_fbm: At least a single octave is required");
+  usize i = 0;
+#ifdef VOLO_SIMD
+  const SimdVec lac = simd_vec_broadcast(lacunarity);
+  for (; count - i >= 4; i += 4) {
+    SimdVec x   = simd_vec_load_unaligned(xs + i);
+    SimdVec y   = simd_vec_load_unaligned(ys + i);
+    SimdVec z   = simd_vec_load_unaligned(zs + i);
+    SimdVec sum = simd_vec_zero();
+
+    // The accumulator and coordinates stay in registers across the octaves.
+    f32 amplitude = 1.0f, amplitudeTotal = 0.0f;
+    for (u32 o = 0; o != octaves; ++o) {
+      const SimdVec octave = noise_perlin3_simd(x, y, z);
+      sum                  = simd_vec_add(sum, simd_vec_mul(octave, simd_vec_broadcast(amplitude)));
+      amplitudeTotal += amplitude;
+      amplitude *= persistence;
+      x = simd_vec_mul(x, lac);
+      y = simd_vec_mul(y, lac);
+      z = simd_vec_mul(z, lac);
+    }
+    simd_vec_store_unaligned(simd_vec_div(sum, simd_vec_broadcast(amplitudeTotal)), out + i);
+  }
+#endif
+  for (; i != count; ++i) {
+    out[i] = noise_perlin3_fbm(xs[i], ys[i], zs[i], octaves, lacunarity, persistence);
+  }
+}
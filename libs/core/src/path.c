@@ -91,7 +91,9 @@ String path_parent(const String path) {
   return path_is_root(parentWithSep) ? parentWithSep : string_slice(path, 0, lastSegStart);
 }
 
-bool path_canonize(DynString* str, String path) {
+#define path_canonize_max_segs 64
+
+static bool path_canonize_intern(DynString* str, String path, u32* outSegCount) {
 
   /**
    * Canonize the root in case of an absolute path.
@@ -112,7 +114,7 @@ bool path_canonize(DynString* str, String path) {
    * output string. This way we can erase a segment if we encounter a '..' entry.
    */
 
-  usize segStarts[64];
+  usize segStarts[path_canonize_max_segs];
   u32   segCount = 0;
 
   segStarts[segCount++] = str->size; // Start of the first segment.
@@ -151,9 +153,63 @@ bool path_canonize(DynString* str, String path) {
     dynstring_append(str, seg); // Write the segment to the output.
   }
 
+  *outSegCount = segCount;
   return success;
 }
 
+/**
+ * Cache of the last canonized directory prefix. Directory scans build many sibling paths in the
+ * same directory and would otherwise re-canonize the same prefix for every entry.
+ */
+typedef struct {
+  u16 rawSize, canonSize, segCount;
+  u8  raw[path_pal_max_size];
+  u8  canon[path_pal_max_size];
+} PathCanonCache;
+
+static THREAD_LOCAL PathCanonCache g_pathCanonCache;
+
+bool path_canonize(DynString* str, const String path) {
+  u32 segCount;
+
+  /**
+   * Fast path: when only the filename differs from the previously canonized path we can reuse the
+   * cached canonical directory; a single trailing segment cannot affect the earlier segments.
+   */
+  const usize nameStart = string_find_last_any(path, g_pathSeparators);
+  if (!sentinel_check(nameStart) && path.size <= path_pal_max_size) {
+    const String dir  = string_slice(path, 0, nameStart + 1); // Including the separator.
+    const String name = string_consume(path, nameStart + 1);
+    if (!string_is_empty(name) && !string_eq(name, string_lit(".")) &&
+        !string_eq(name, string_lit(".."))) {
+      PathCanonCache* cache = &g_pathCanonCache;
+      if (!string_eq(dir, mem_create(cache->raw, cache->rawSize))) {
+        // Cache miss; canonize the directory (writing directly into the cache) and remember it.
+        DynString dirStr = dynstring_create_over(array_mem(cache->canon));
+        if (!path_canonize_intern(&dirStr, dir, &segCount)) {
+          cache->rawSize = 0; // Invalidate; the directory itself has no canonical form.
+          return path_canonize_intern(str, path, &segCount);
+        }
+        mem_cpy(mem_create(cache->raw, dir.size), dir);
+        cache->rawSize   = (u16)dir.size;
+        cache->canonSize = (u16)dirStr.size;
+        cache->segCount  = (u16)segCount;
+      }
+      if (cache->segCount + 1 < path_canonize_max_segs) {
+        const String dirCanon = mem_create(cache->canon, cache->canonSize);
+        dynstring_append(str, dirCanon);
+        if (!string_is_empty(dirCanon) && !path_ends_with_separator(dirCanon)) {
+          dynstring_append_char(str, '/');
+        }
+        dynstring_append(str, name);
+        return true;
+      }
+    }
+  }
+
+  return path_canonize_intern(str, path, &segCount);
+}
+
 String path_canonize_scratch(const String path) {
   Mem       scratchMem = alloc_alloc(g_allocScratch, path_pal_max_size, 1);
   DynString str        = dynstring_create_over(scratchMem);
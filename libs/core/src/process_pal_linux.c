@@ -7,6 +7,7 @@
 #include "file.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <stdlib.h>
 #include <sys/syscall.h>
@@ -244,6 +245,17 @@ static ProcessResult process_start(const ProcessStartInfo* info, pid_t* outPid,
   process_maybe_close_fd(PIPE_FD_WRITE(pipeFds, StdOut));
   process_maybe_close_fd(PIPE_FD_WRITE(pipeFds, StdErr));
 
+  if (info->flags & ProcessFlags_NonBlockingOutput) {
+    // Make the parent side of the output pipes non-blocking; reads will return
+    // 'FileResult_WouldBlock' instead of waiting for the child to produce data.
+    if (PIPE_FD_READ(pipeFds, StdOut) != -1) {
+      fcntl(PIPE_FD_READ(pipeFds, StdOut), F_SETFL, O_NONBLOCK);
+    }
+    if (PIPE_FD_READ(pipeFds, StdErr) != -1) {
+      fcntl(PIPE_FD_READ(pipeFds, StdErr), F_SETFL, O_NONBLOCK);
+    }
+  }
+
   *outPid = forkedPid;
   if (info->flags & ProcessFlags_PipeStdIn) {
     outPipes[0] = (File){.handle = PIPE_FD_WRITE(pipeFds, StdIn), .access = FileAccess_Write};
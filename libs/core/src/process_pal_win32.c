@@ -158,6 +158,18 @@ process_start(const ProcessStartInfo* info, PROCESS_INFORMATION* outProcessInfo,
     process_maybe_close_handle(PIPE_HND_READ(pipeHandles, StdIn));
     process_maybe_close_handle(PIPE_HND_WRITE(pipeHandles, StdOut));
     process_maybe_close_handle(PIPE_HND_WRITE(pipeHandles, StdErr));
+
+    if (info->flags & ProcessFlags_NonBlockingOutput) {
+      // Make the parent side of the output pipes non-blocking; reads will return
+      // 'FileResult_WouldBlock' instead of waiting for the child to produce data.
+      DWORD pipeMode = PIPE_READMODE_BYTE | PIPE_NOWAIT;
+      if (PIPE_HND_READ(pipeHandles, StdOut)) {
+        SetNamedPipeHandleState(PIPE_HND_READ(pipeHandles, StdOut), &pipeMode, null, null);
+      }
+      if (PIPE_HND_READ(pipeHandles, StdErr)) {
+        SetNamedPipeHandleState(PIPE_HND_READ(pipeHandles, StdErr), &pipeMode, null, null);
+      }
+    }
   } else {
     // Failure; close both sides of all the pipes.
     process_maybe_close_handles(pipeHandles, array_elems(pipeHandles));
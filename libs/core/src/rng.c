@@ -1,4 +1,5 @@
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/diag.h"
 #include "core/math.h"
 #include "core/rng.h"
@@ -7,9 +8,14 @@
 
 struct sRng {
   u32 (*next)(Rng*);
+  void (*nextMany)(Rng*, u32 out[], usize count); // Optional; falls back to 'next' when null.
   void (*destroy)(Rng*);
 };
 
+// epsilon: 1.1920929E-7 (difference between 1.0f and the next representable f32 number).
+// margin: u32_max * epsilon = 512.00000181.
+static const f32 g_rngToFloat = 1.0f / ((f32)u32_max + 512.00000181f); // +512 to never return 1.0.
+
 struct RngXorWow {
   Rng        api;
   u32        state[5];
@@ -65,7 +71,43 @@ static u32 rng_xorwow_next(Rng* rng) {
   return t + *counter;
 }
 
-THREAD_LOCAL struct RngXorWow g_rngXorwow = {.api = {.next = rng_xorwow_next}};
+static void rng_xorwow_next_many(Rng* rng, u32 out[], const usize count) {
+  struct RngXorWow* rngXorWow = (struct RngXorWow*)rng;
+
+  diag_assert(
+      rngXorWow->state[0] || rngXorWow->state[1] || rngXorWow->state[2] || rngXorWow->state[3]);
+
+  // Keep the state in locals so the compiler can keep it in registers for the whole batch.
+  u32 s0      = rngXorWow->state[0];
+  u32 s1      = rngXorWow->state[1];
+  u32 s2      = rngXorWow->state[2];
+  u32 s3      = rngXorWow->state[3];
+  u32 counter = rngXorWow->state[4];
+
+  for (usize i = 0; i != count; ++i) {
+    u32 t = s3;
+    s3    = s2;
+    s2    = s1;
+    s1    = s0;
+
+    t ^= t >> 2U;
+    t ^= t << 1U;
+    t ^= s1 ^ (s1 << 4U);
+    s0 = t;
+
+    counter += 362437U;
+    out[i] = t + counter;
+  }
+
+  rngXorWow->state[0] = s0;
+  rngXorWow->state[1] = s1;
+  rngXorWow->state[2] = s2;
+  rngXorWow->state[3] = s3;
+  rngXorWow->state[4] = counter;
+}
+
+THREAD_LOCAL struct RngXorWow g_rngXorwow = {
+    .api = {.next = rng_xorwow_next, .nextMany = rng_xorwow_next_many}};
 THREAD_LOCAL Rng*             g_rng;
 
 void rng_init_thread(void) {
@@ -81,10 +123,50 @@ u32 rng_sample_u32(Rng* rng) {
 
 f32 rng_sample_f32(Rng* rng) {
   diag_assert_msg(rng, "rng_next: Rng is not initialized");
-  // epsilon: 1.1920929E-7 (difference between 1.0f and the next representable f32 number).
-  // margin: u32_max * epsilon = 512.00000181.
-  static const f32 g_toFloat = 1.0f / ((f32)u32_max + 512.00000181f); // +512 to never return 1.0.
-  return rng->next(rng) * g_toFloat;
+  return rng->next(rng) * g_rngToFloat;
+}
+
+void rng_sample_many_u32(Rng* rng, u32 out[], const usize count) {
+  diag_assert_msg(rng, "rng_next: Rng is not initialized");
+  if (LIKELY(rng->nextMany)) {
+    rng->nextMany(rng, out, count);
+    return;
+  }
+  for (usize i = 0; i != count; ++i) {
+    out[i] = rng->next(rng);
+  }
+}
+
+void rng_sample_many_f32(Rng* rng, f32 out[], usize count) {
+  u32 buffer[512];
+  while (count) {
+    const usize chunk = math_min(count, array_elems(buffer));
+    rng_sample_many_u32(rng, buffer, chunk);
+    for (usize i = 0; i != chunk; ++i) {
+      out[i] = buffer[i] * g_rngToFloat;
+    }
+    out += chunk;
+    count -= chunk;
+  }
+}
+
+u32 rng_sample_range_u32(Rng* rng, const u32 min, const u32 max) {
+  diag_assert_msg(max > min, "rng_sample_range_u32: max has to be greater then min");
+  const u32 range = max - min;
+  /**
+   * Multiply-shift range reduction with rejection of the biased low products.
+   * Source: Daniel Lemire - 'Fast Random Integer Generation in an Interval'.
+   */
+  u64 product = (u64)rng_sample_u32(rng) * range;
+  u32 low     = (u32)product;
+  if (UNLIKELY(low < range)) {
+    const u32 threshold = (0u - range) % range; // == (2^32 - range) % range.
+    while (low < threshold) {
+      product = (u64)rng_sample_u32(rng) * range;
+      low     = (u32)product;
+    }
+  }
+  return min + (u32)(product >> 32);
 }
 
 RngGaussPairF32 rng_sample_gauss_f32(Rng* rng) {
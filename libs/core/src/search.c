@@ -1,3 +1,7 @@
+#include "core/bits.h"
+#include "core/intrinsic.h"
+#include "core/math.h"
+#include "core/memory.h"
 #include "core/search.h"
 
 void* search_linear(u8* begin, u8* end, const u16 stride, CompareFunc compare, const void* tgt) {
@@ -32,6 +36,100 @@ void* search_binary(u8* begin, u8* end, const u16 stride, CompareFunc compare, c
   return null; // Not found.
 }
 
+void* search_binary_branchless(
+    u8* begin, u8* end, const u16 stride, CompareFunc compare, const void* tgt) {
+  /**
+   * Binary scan where the probe locations only depend on the element count; the comparison
+   * outcome selects the next range with a conditional-move instead of a branch.
+   */
+  usize count = (end - begin) / stride;
+  u8*   itr   = begin;
+  while (count > 1) {
+    const usize half = count / 2;
+    // Conditionally skip the first half; compiles to a conditional-move instead of a branch.
+    itr += (compare(itr + (half - 1) * stride, tgt) < 0) * half * stride;
+    count -= half;
+  }
+  if (itr != end && compare(itr, tgt) == 0) {
+    return itr;
+  }
+  return null; // Not found.
+}
+
+void search_binary_many(
+    u8*         begin,
+    u8*         end,
+    const u16   stride,
+    CompareFunc compare,
+    const u8*   tgts,
+    const usize tgtCount,
+    void*       out[]) {
+  /**
+   * Find all (sorted) targets in a single forward walk: gallop ahead from the previous result to
+   * bound the next target and then binary scan only within that range.
+   */
+  u8* itr = begin;
+  for (usize t = 0; t != tgtCount; ++t) {
+    const u8*   tgt       = tgts + t * stride;
+    const usize remaining = (usize)(end - itr) / stride;
+
+    // Double the bound until an element greater or equal to the target is found.
+    usize bound = 1;
+    while (bound < remaining && compare(itr + bound * stride, tgt) < 0) {
+      bound *= 2;
+    }
+
+    u8* rangeBegin = itr + (bound / 2) * stride;
+    u8* rangeEnd   = itr + math_min(bound + 1, remaining) * stride;
+    u8* elem       = search_binary_greater_or_equal(rangeBegin, rangeEnd, stride, compare, tgt);
+
+    out[t] = elem && compare(elem, tgt) == 0 ? elem : null;
+    itr    = elem ? elem : end;
+  }
+}
+
+static usize search_eytzinger_fill(
+    const u8* in, u8* out, const u16 stride, const usize count, usize i, const usize k) {
+  if (k <= count) {
+    i = search_eytzinger_fill(in, out, stride, count, i, k * 2);
+    mem_cpy(mem_create(out + (k - 1) * stride, stride), mem_create(in + i * stride, stride));
+    ++i;
+    i = search_eytzinger_fill(in, out, stride, count, i, k * 2 + 1);
+  }
+  return i;
+}
+
+void search_eytzinger_build(const u8* begin, const u8* end, const u16 stride, u8* out) {
+  /**
+   * Place the sorted elements in breadth-first (heap) order: element 0 is the tree root, the
+   * children of element i are elements i * 2 + 1 and i * 2 + 2.
+   */
+  const usize count = (usize)(end - begin) / stride;
+  search_eytzinger_fill(begin, out, stride, count, 0, 1);
+}
+
+void* search_eytzinger(u8* begin, u8* end, const u16 stride, CompareFunc compare, const void* tgt) {
+  /**
+   * Descend the implicit tree; every iteration moves to one of the two children so consecutive
+   * probes stay close together in memory for the hot top levels.
+   */
+  const usize count = (usize)(end - begin) / stride;
+  usize       k     = 1;
+  while (k <= count) {
+    // Fetch the grandchildren ahead of time; both reachable nodes of the next iteration.
+    // NOTE: Prefetching (harmlessly) runs past the end of the data on the last levels.
+    intrinsic_prefetch(begin + (k * 4 - 1) * stride);
+    k = k * 2 + (compare(begin + (k - 1) * stride, tgt) < 0);
+  }
+  // Undo the final right-descents (trailing one bits) to arrive at the lower-bound element.
+  k >>= bits_ctz_64(~(u64)k) + 1;
+  if (k == 0) {
+    return null; // Not found; target is greater then all elements.
+  }
+  u8* elem = begin + (k - 1) * stride;
+  return compare(elem, tgt) == 0 ? elem : null;
+}
+
 void* search_binary_greater(u8* begin, u8* end, u16 stride, CompareFunc compare, const void* tgt) {
   /**
    * Find the first element that is greater then the given target using a binary scan.
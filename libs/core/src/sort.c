@@ -1,3 +1,4 @@
+#include "core/alloc.h"
 #include "core/array.h"
 #include "core/bits.h"
 #include "core/diag.h"
@@ -265,6 +266,61 @@ void sort_bubblesort(u8* begin, u8* end, const u16 stride, CompareFunc compare)
   }
 }
 
+/**
+ * Least-significant-digit radix sort over 8 bit digits.
+ * Histograms for all passes are gathered in a single scan and uniform passes (all keys sharing the
+ * same digit) are skipped.
+ * - https://en.wikipedia.org/wiki/Radix_sort
+ */
+#define sort_radix_digit_bits 8
+#define sort_radix_digit_count 256
+#define sort_radix_digit_mask (sort_radix_digit_count - 1)
+
+#define SORT_RADIX_DEFINE(_TYPE_)                                                                  \
+  void sort_radixsort_##_TYPE_(_TYPE_* begin, _TYPE_* end) {                                       \
+    const usize count = (usize)(end - begin);                                                      \
+    if (count < 2) {                                                                               \
+      return;                                                                                      \
+    }                                                                                              \
+    const usize passes = sizeof(_TYPE_);                                                           \
+                                                                                                   \
+    u32 hist[sizeof(_TYPE_)][sort_radix_digit_count] = {0};                                        \
+    for (const _TYPE_* itr = begin; itr != end; ++itr) {                                           \
+      for (usize pass = 0; pass != passes; ++pass) {                                               \
+        ++hist[pass][(*itr >> (pass * sort_radix_digit_bits)) & sort_radix_digit_mask];            \
+      }                                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    const Mem tmpMem = alloc_alloc(g_allocHeap, count * sizeof(_TYPE_), alignof(_TYPE_));          \
+    _TYPE_*   src    = begin;                                                                      \
+    _TYPE_*   dst    = tmpMem.ptr;                                                                 \
+    for (usize pass = 0; pass != passes; ++pass) {                                                 \
+      const usize shift = pass * sort_radix_digit_bits;                                            \
+      if (hist[pass][(*src >> shift) & sort_radix_digit_mask] == count) {                          \
+        continue; /* All keys share this digit; nothing to reorder. */                             \
+      }                                                                                            \
+      usize offsets[sort_radix_digit_count];                                                       \
+      usize sum = 0;                                                                               \
+      for (u32 digit = 0; digit != sort_radix_digit_count; ++digit) {                              \
+        offsets[digit] = sum;                                                                      \
+        sum += hist[pass][digit];                                                                  \
+      }                                                                                            \
+      for (usize i = 0; i != count; ++i) {                                                         \
+        dst[offsets[(src[i] >> shift) & sort_radix_digit_mask]++] = src[i];                        \
+      }                                                                                            \
+      _TYPE_* swapTmp = src;                                                                       \
+      src             = dst;                                                                       \
+      dst             = swapTmp;                                                                   \
+    }                                                                                              \
+    if (src != begin) {                                                                            \
+      mem_cpy(mem_create(begin, count * sizeof(_TYPE_)), mem_create(src, count * sizeof(_TYPE_))); \
+    }                                                                                              \
+    alloc_free(g_allocHeap, tmpMem);                                                               \
+  }
+
+SORT_RADIX_DEFINE(u32)
+SORT_RADIX_DEFINE(u64)
+
 /**
  * Select a pivot to partition on.
  * At the moment we always use the center element as the pivot.
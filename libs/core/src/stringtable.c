@@ -1,18 +1,28 @@
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/stringtable.h"
 #include "core/thread.h"
 
+#define stringtable_shard_count 16
+#define stringtable_shard_bits 4
 #define stringtable_chunk_size (32 * usize_kibibyte)
 #define stringtable_string_size_max 512
-#define stringtable_slots_initial 1024
+#define stringtable_slots_initial 256
 #define stringtable_slots_loadfactor 0.75f
+#define stringtable_retired_max 24
 
 /**
  * Strings are looked up using a simple open-addressing hash table.
  * https://en.wikipedia.org/wiki/Open_addressing
  *
+ * The table is partitioned into shards (by the high hash bits, the low bits index slots within a
+ * shard) so writers only serialize within a shard. Readers are lock-free: slot hashes are
+ * atomically published after the string data is written and the slot arrays themselves are
+ * published through an atomic pointer, with old arrays retired until destroy / reset so concurrent
+ * readers can keep probing them (RCU-style).
+ *
  * NOTE: Strings cannot be removed from the table.
  */
 
@@ -21,12 +31,25 @@ typedef struct {
   String     data;
 } StringTableSlot;
 
+typedef struct {
+  u32             slotCount; // Always a power of two.
+  StringTableSlot slots[];
+} StringTableSlots;
+
+typedef struct {
+  ThreadSpinLock    lock; // Serializes writers; readers are lock-free.
+  u32               slotCountUsed;
+  StringTableSlots* slots; // Atomically published.
+  Allocator*        dataAlloc; // Allocator for the string character data.
+
+  // Old slot arrays that concurrent readers might still be probing.
+  StringTableSlots* retired[stringtable_retired_max];
+  u32               retiredCount;
+} StringTableShard;
+
 struct sStringTable {
-  Allocator*       alloc; // Allocator for string the meta-data.
-  ThreadSpinLock   slotsLock;
-  u32              slotCount, slotCountUsed;
-  StringTableSlot* slots;
-  Allocator*       dataAlloc; // Allocator for the string character data.
+  Allocator*       alloc; // Allocator for the table meta-data.
+  StringTableShard shards[stringtable_shard_count];
 };
 
 /**
@@ -36,51 +59,106 @@ StringTable* g_stringtable;
 void         stringtable_init(void) { g_stringtable = stringtable_create(g_allocHeap); }
 void         stringtable_teardown(void) { stringtable_destroy(g_stringtable); }
 
-INLINE_HINT static bool stringtable_should_grow(StringTable* table) {
-  return table->slotCountUsed >= (u32)(table->slotCount * stringtable_slots_loadfactor);
+INLINE_HINT static StringTableShard*
+stringtable_shard(const StringTable* table, const StringHash hash) {
+  // Shard by the high hash bits; the low bits are used to index slots within the shard.
+  return (StringTableShard*)&table->shards[hash >> (32 - stringtable_shard_bits)];
 }
 
-static StringTableSlot* stringtable_slots_alloc(Allocator* alloc, const u32 slotCount) {
-  const usize slotsMemSize = sizeof(StringTableSlot) * slotCount;
-  const Mem   slotsMem     = alloc_alloc(alloc, slotsMemSize, alignof(StringTableSlot));
-  mem_set(slotsMem, 0);
-  return slotsMem.ptr;
+static StringTableSlots* stringtable_slots_alloc(Allocator* alloc, const u32 slotCount) {
+  const usize memSize = sizeof(StringTableSlots) + sizeof(StringTableSlot) * slotCount;
+  const Mem   mem     = alloc_alloc(alloc, memSize, alignof(StringTableSlots));
+  mem_set(mem, 0);
+
+  StringTableSlots* res = mem.ptr;
+  res->slotCount        = slotCount;
+  return res;
+}
+
+static void stringtable_slots_free(Allocator* alloc, StringTableSlots* slots) {
+  const usize memSize = sizeof(StringTableSlots) + sizeof(StringTableSlot) * slots->slotCount;
+  alloc_free(alloc, mem_create(slots, memSize));
 }
 
+/**
+ * Find the slot for the given hash, either an already published slot or an empty one.
+ * NOTE: Safe to call concurrently with writers publishing new slots.
+ */
 INLINE_HINT static StringTableSlot*
-stringtable_slot(StringTableSlot* slots, const u32 slotCount, const StringHash hash) {
+stringtable_slot(StringTableSlots* slots, const StringHash hash) {
   diag_assert(hash); // Hash of 0 is invalid.
 
-  u32 bucket = hash & (slotCount - 1);
-  for (usize i = 0; i != slotCount; ++i) {
-    StringTableSlot* slot = &slots[bucket];
-    if (LIKELY(!slot->hash || slot->hash == hash)) {
+  u32 bucket = hash & (slots->slotCount - 1);
+  for (usize i = 0; i != slots->slotCount; ++i) {
+    StringTableSlot* slot     = &slots->slots[bucket];
+    const StringHash slotHash = thread_atomic_load_u32(&slot->hash);
+    if (LIKELY(!slotHash || slotHash == hash)) {
       return slot; // Slot is either empty or the desired hash.
     }
     // Hash collision, jump to a new place in the table (quadratic probing).
-    bucket = (bucket + i + 1) & (slotCount - 1);
+    bucket = (bucket + i + 1) & (slots->slotCount - 1);
   }
   diag_crash_msg("No available StringTable slots");
 }
 
-NO_INLINE_HINT static void stringtable_grow(StringTable* table) {
+NO_INLINE_HINT static void stringtable_grow(StringTable* table, StringTableShard* shard) {
   // Allocate new slots.
-  const u32        newSlotCount = bits_nextpow2_32(table->slotCount + 1);
-  StringTableSlot* newSlots     = stringtable_slots_alloc(table->alloc, newSlotCount);
+  StringTableSlots* oldSlots = shard->slots;
+  StringTableSlots* newSlots = stringtable_slots_alloc(table->alloc, oldSlots->slotCount * 2);
 
   // Insert the old data into the new slots.
-  for (StringTableSlot* slot = table->slots; slot != (table->slots + table->slotCount); ++slot) {
+  for (u32 i = 0; i != oldSlots->slotCount; ++i) {
+    StringTableSlot* slot = &oldSlots->slots[i];
     if (slot->hash) {
-      StringTableSlot* newSlot = stringtable_slot(newSlots, newSlotCount, slot->hash);
-      newSlot->hash            = slot->hash;
-      newSlot->data            = slot->data;
+      *stringtable_slot(newSlots, slot->hash) = *slot;
     }
   }
 
-  // Free the old slots.
-  alloc_free_array_t(table->alloc, table->slots, table->slotCount);
-  table->slots     = newSlots;
-  table->slotCount = newSlotCount;
+  // Publish the new slots; the old array is retired as readers might still be probing it.
+  diag_assert_msg(
+      shard->retiredCount != stringtable_retired_max, "StringTable retired too many slot arrays");
+  shard->retired[shard->retiredCount++] = oldSlots;
+  thread_atomic_store_u64((u64*)&shard->slots, (u64)(uptr)newSlots);
+}
+
+INLINE_HINT static bool stringtable_should_grow(StringTableShard* shard) {
+  return shard->slotCountUsed >= (u32)(shard->slots->slotCount * stringtable_slots_loadfactor);
+}
+
+/**
+ * Add the given string to the shard.
+ * Returns the interned string data.
+ * Pre-condition: Shard lock is held.
+ */
+static String stringtable_shard_add(
+    StringTable* table, StringTableShard* shard, const StringHash hash, const String str) {
+  StringTableSlot* slot = stringtable_slot(shard->slots, hash);
+  if (slot->hash) {
+    /**
+     * String already existed in the table.
+     */
+    diag_assert_msg(string_eq(str, slot->data), "StringHash collision in StringTable");
+    return slot->data;
+  }
+  /**
+   * New entry in the table.
+   * Copy the string data into the shard's data-allocator and then publish the hash; the hash store
+   * has to come last so lock-free readers never observe a slot without its string data.
+   */
+  String result = string_empty;
+  if (LIKELY(!string_is_empty(str))) {
+    result = string_dup(shard->dataAlloc, str);
+    diag_assert_msg(result.ptr, "StringTable allocator ran out of space");
+    slot->data = result;
+  }
+  thread_atomic_fence_release();
+  thread_atomic_store_u32(&slot->hash, hash);
+
+  ++shard->slotCountUsed;
+  if (UNLIKELY(stringtable_should_grow(shard))) {
+    stringtable_grow(table, shard);
+  }
+  return result;
 }
 
 StringTable* stringtable_create(Allocator* alloc) {
@@ -88,44 +166,62 @@ StringTable* stringtable_create(Allocator* alloc) {
 
   diag_assert(bits_ispow2_32(stringtable_slots_initial));
 
-  *table = (StringTable){
-      .alloc     = alloc,
-      .slotCount = stringtable_slots_initial,
-      .slots     = stringtable_slots_alloc(alloc, stringtable_slots_initial),
-      .dataAlloc = alloc_chunked_create(g_allocHeap, alloc_bump_create, stringtable_chunk_size),
-  };
+  *table = (StringTable){.alloc = alloc};
+  array_for_t(table->shards, StringTableShard, shard) {
+    shard->slots     = stringtable_slots_alloc(alloc, stringtable_slots_initial);
+    shard->dataAlloc = alloc_chunked_create(g_allocHeap, alloc_bump_create, stringtable_chunk_size);
+  }
   return table;
 }
 
 void stringtable_destroy(StringTable* table) {
-  alloc_free_array_t(table->alloc, table->slots, table->slotCount);
-  alloc_chunked_destroy(table->dataAlloc);
+  array_for_t(table->shards, StringTableShard, shard) {
+    stringtable_slots_free(table->alloc, shard->slots);
+    for (u32 i = 0; i != shard->retiredCount; ++i) {
+      stringtable_slots_free(table->alloc, shard->retired[i]);
+    }
+    alloc_chunked_destroy(shard->dataAlloc);
+  }
   alloc_free_t(table->alloc, table);
 }
 
 void stringtable_reset(StringTable* table) {
-  mem_set(mem_create(table->slots, sizeof(StringTableSlot) * table->slotCount), 0);
-  table->slotCountUsed = 0;
-
-  alloc_reset(table->dataAlloc);
+  array_for_t(table->shards, StringTableShard, shard) {
+    thread_spinlock_lock(&shard->lock);
+    {
+      const usize slotsMemSize = sizeof(StringTableSlot) * shard->slots->slotCount;
+      mem_set(mem_create(shard->slots->slots, slotsMemSize), 0);
+      for (u32 i = 0; i != shard->retiredCount; ++i) {
+        stringtable_slots_free(table->alloc, shard->retired[i]);
+      }
+      shard->retiredCount  = 0;
+      shard->slotCountUsed = 0;
+      alloc_reset(shard->dataAlloc);
+    }
+    thread_spinlock_unlock(&shard->lock);
+  }
 }
 
 u32 stringtable_count(const StringTable* table) {
-  StringTable* tableMutable = (StringTable*)table;
-  u32          res;
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  res = table->slotCountUsed;
-  thread_spinlock_unlock(&tableMutable->slotsLock);
+  u32 res = 0;
+  array_for_t(table->shards, StringTableShard, shard) {
+    StringTableShard* shardMutable = (StringTableShard*)shard;
+    thread_spinlock_lock(&shardMutable->lock);
+    res += shard->slotCountUsed;
+    thread_spinlock_unlock(&shardMutable->lock);
+  }
   return res;
 }
 
 String stringtable_lookup(const StringTable* table, const StringHash hash) {
-  StringTable* tableMutable = (StringTable*)table;
-  String       res;
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  res = stringtable_slot(table->slots, table->slotCount, hash)->data;
-  thread_spinlock_unlock(&tableMutable->slotsLock);
-  return res;
+  StringTableShard* shard = stringtable_shard(table, hash);
+  StringTableSlots* slots = (StringTableSlots*)(uptr)thread_atomic_load_u64((u64*)&shard->slots);
+  StringTableSlot*  slot  = stringtable_slot(slots, hash);
+  if (!thread_atomic_load_u32(&slot->hash)) {
+    return string_empty; // Hash is not present in the table.
+  }
+  thread_atomic_fence_acquire(); // Make sure we observe the slot's string data.
+  return slot->data;
 }
 
 StringHash stringtable_add(StringTable* table, const String str) {
@@ -134,33 +230,12 @@ StringHash stringtable_add(StringTable* table, const String str) {
       "String size '{}' exceeds maximum",
       fmt_size(str.size));
 
-  const StringHash hash = string_hash(str);
+  const StringHash  hash  = string_hash(str);
+  StringTableShard* shard = stringtable_shard(table, hash);
 
-  thread_spinlock_lock(&table->slotsLock);
-  {
-    StringTableSlot* slot = stringtable_slot(table->slots, table->slotCount, hash);
-    if (slot->hash) {
-      /**
-       * String already existed in the table.
-       */
-      diag_assert_msg(string_eq(str, slot->data), "StringHash collision in StringTable");
-    } else {
-      /**
-       * New entry in the table.
-       * Copy the string data into the table's data-allocator and initialize the values in the slot.
-       */
-      slot->hash = hash;
-      if (LIKELY(!string_is_empty(str))) {
-        slot->data = string_dup(table->dataAlloc, str);
-        diag_assert_msg(slot->data.ptr, "StringTable allocator ran out of space");
-      }
-      ++table->slotCountUsed;
-      if (UNLIKELY(stringtable_should_grow(table))) {
-        stringtable_grow(table);
-      }
-    }
-  }
-  thread_spinlock_unlock(&table->slotsLock);
+  thread_spinlock_lock(&shard->lock);
+  stringtable_shard_add(table, shard, hash, str);
+  thread_spinlock_unlock(&shard->lock);
   return hash;
 }
 
@@ -170,46 +245,18 @@ String stringtable_intern(StringTable* table, const String str) {
       "String size '{}' exceeds maximum",
       fmt_size(str.size));
 
-  const StringHash hash   = string_hash(str);
-  String           result = string_empty;
+  const StringHash  hash  = string_hash(str);
+  StringTableShard* shard = stringtable_shard(table, hash);
+  String            result;
 
-  thread_spinlock_lock(&table->slotsLock);
-  {
-    StringTableSlot* slot = stringtable_slot(table->slots, table->slotCount, hash);
-    if (slot->hash) {
-      /**
-       * String already existed in the table.
-       */
-      diag_assert_msg(string_eq(str, slot->data), "StringHash collision in StringTable");
-      result = slot->data;
-    } else {
-      /**
-       * New entry in the table.
-       * Copy the string data into the table's data-allocator and initialize the values in the slot.
-       */
-      slot->hash = hash;
-      if (LIKELY(!string_is_empty(str))) {
-        result = string_dup(table->dataAlloc, str);
-        diag_assert_msg(result.ptr, "StringTable allocator ran out of space");
-        slot->data = result;
-      }
-      ++table->slotCountUsed;
-      if (UNLIKELY(stringtable_should_grow(table))) {
-        stringtable_grow(table);
-      }
-    }
-  }
-  thread_spinlock_unlock(&table->slotsLock);
+  thread_spinlock_lock(&shard->lock);
+  result = stringtable_shard_add(table, shard, hash, str);
+  thread_spinlock_unlock(&shard->lock);
   return result;
 }
 
 StringTableArray stringtable_clone_strings(const StringTable* table, Allocator* alloc) {
-  StringTable* tableMutable = (StringTable*)table;
-  u32          count;
-  thread_spinlock_lock(&tableMutable->slotsLock);
-  count = table->slotCountUsed;
-  thread_spinlock_unlock(&tableMutable->slotsLock);
-
+  const u32 count = stringtable_count(table);
   if (!count) {
     return (StringTableArray){0};
   }
@@ -219,14 +266,18 @@ StringTableArray stringtable_clone_strings(const StringTable* table, Allocator*
       .count  = count,
   };
 
-  thread_spinlock_lock(&tableMutable->slotsLock);
   u32 i = 0;
-  for (StringTableSlot* slot = table->slots; slot != (table->slots + table->slotCount); ++slot) {
-    if (slot->hash && i != count) {
-      res.values[i++] = slot->data;
+  array_for_t(table->shards, StringTableShard, shard) {
+    StringTableShard* shardMutable = (StringTableShard*)shard;
+    thread_spinlock_lock(&shardMutable->lock);
+    StringTableSlots* slots = shard->slots;
+    for (u32 slotIdx = 0; slotIdx != slots->slotCount && i != count; ++slotIdx) {
+      if (slots->slots[slotIdx].hash) {
+        res.values[i++] = slots->slots[slotIdx].data;
+      }
     }
+    thread_spinlock_unlock(&shardMutable->lock);
   }
-  thread_spinlock_unlock(&tableMutable->slotsLock);
 
   return res;
 }
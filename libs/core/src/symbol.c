@@ -18,6 +18,9 @@
 
 #define symbol_reg_name_max 64
 #define symbol_reg_chunk_size (4 * usize_kibibyte)
+#define symbol_reg_cache_slots 1024
+
+ASSERT((symbol_reg_cache_slots & (symbol_reg_cache_slots - 1u)) == 0, "Has to be a pow2");
 
 typedef struct {
   SymbolAddrRel begin, end;
@@ -33,9 +36,16 @@ struct sSymbolReg {
 static bool        g_symInit;
 static SymbolAddr  g_symProgBegin;
 static SymbolAddr  g_symProgEnd;
-static SymbolReg*  g_symReg;
+static i64         g_symReg; // SymbolReg*, atomically published and immutable afterwards.
 static ThreadMutex g_symRegMutex;
 
+/**
+ * Lock-free direct-mapped cache of resolved addresses, packed as '(symbol index + 1) << 32 | addr'
+ * (so an empty slot never matches). Entries stay valid forever as the published registry is
+ * immutable, which makes the cache safe to read and update from signal context.
+ */
+static u64 g_symQueryCache[symbol_reg_cache_slots];
+
 static i8 sym_info_compare(const void* a, const void* b) {
   return compare_u32(field_ptr(a, SymbolInfo, begin), field_ptr(b, SymbolInfo, begin));
 }
@@ -109,9 +119,29 @@ static const SymbolInfo* symbol_reg_query(const SymbolReg* r, const SymbolAddrRe
   return sym_info_contains(candidate, addr) ? candidate : null;
 }
 
+/**
+ * Find information for the symbol that contains the given address, caching the result.
+ * Lock-free; safe to call from signal context and concurrent threads.
+ */
+static const SymbolInfo* symbol_reg_query_cached(const SymbolReg* r, const SymbolAddrRel addr) {
+  u64*      slot   = &g_symQueryCache[bits_hash_32_val(addr) & (symbol_reg_cache_slots - 1)];
+  const u64 cached = thread_atomic_load_u64(slot);
+  if ((u32)cached == addr && (cached >> 32)) {
+    const u32 symIndex = (u32)(cached >> 32) - 1;
+    return dynarray_begin_t(&r->syms, SymbolInfo) + symIndex;
+  }
+  const SymbolInfo* info = symbol_reg_query(r, addr);
+  if (info) {
+    const u64 symIndex = (u64)(info - dynarray_begin_t(&r->syms, SymbolInfo));
+    thread_atomic_store_u64(slot, (symIndex + 1) << 32 | addr);
+  }
+  return info; // NOTE: Misses are not cached; repeated unknown addresses re-run the search.
+}
+
 static const SymbolReg* symbol_reg_get(void) {
-  if (g_symReg) {
-    return g_symReg;
+  const SymbolReg* published = (const SymbolReg*)thread_atomic_load_i64(&g_symReg);
+  if (published) {
+    return published;
   }
   if (!g_symInit) {
     return null;
@@ -126,15 +156,16 @@ static const SymbolReg* symbol_reg_get(void) {
   }
   g_symRegInitializing = true;
   thread_mutex_lock(g_symRegMutex);
-  if (!g_symReg) {
+  published = (const SymbolReg*)thread_atomic_load_i64(&g_symReg);
+  if (!published) {
     SymbolReg* reg = symbol_reg_create();
     symbol_pal_dbg_init(reg);
-    thread_atomic_fence();
-    g_symReg = reg;
+    thread_atomic_store_i64(&g_symReg, (i64)(uptr)reg);
+    published = reg;
   }
   thread_mutex_unlock(g_symRegMutex);
   g_symRegInitializing = false;
-  return g_symReg;
+  return published;
 }
 
 void symbol_reg_set_offset(SymbolReg* r, const SymbolAddr addrOffset) {
@@ -158,9 +189,10 @@ void symbol_init(void) {
 }
 
 void symbol_teardown(void) {
-  g_symInit = false;
-  if (g_symReg) {
-    symbol_reg_destroy(g_symReg);
+  g_symInit      = false;
+  SymbolReg* reg = (SymbolReg*)thread_atomic_load_i64(&g_symReg);
+  if (reg) {
+    symbol_reg_destroy(reg);
   }
   thread_mutex_destroy(g_symRegMutex);
 }
@@ -294,7 +326,7 @@ void symbol_stack_write(const SymbolStack* stack, DynString* out) {
       break; // End of stack.
     }
     const SymbolAddr  addrInExec = (SymbolAddr)addr + addrOffset;
-    const SymbolInfo* info       = reg ? symbol_reg_query(reg, addr) : null;
+    const SymbolInfo* info       = reg ? symbol_reg_query_cached(reg, addr) : null;
     if (info) {
       const u32 offset = addr - info->begin;
       fmt_write(
@@ -341,7 +373,7 @@ String symbol_dbg_name(const SymbolAddrRel addr) {
   if (UNLIKELY(!reg || sentinel_check(addr))) {
     return string_empty;
   }
-  const SymbolInfo* info = symbol_reg_query(reg, addr);
+  const SymbolInfo* info = symbol_reg_query_cached(reg, addr);
   return info ? info->name : string_empty;
 }
 
@@ -350,7 +382,7 @@ SymbolAddrRel symbol_dbg_base(const SymbolAddrRel addr) {
   if (UNLIKELY(!reg || sentinel_check(addr))) {
     return sentinel_u32;
   }
-  const SymbolInfo* info = symbol_reg_query(reg, addr);
+  const SymbolInfo* info = symbol_reg_query_cached(reg, addr);
   return info ? info->begin : sentinel_u32;
 }
 
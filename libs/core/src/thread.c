@@ -60,6 +60,7 @@ THREAD_LOCAL ThreadId g_threadTid;
 THREAD_LOCAL String   g_threadName;
 THREAD_LOCAL uptr     g_threadStackTop;
 u16                   g_threadCoreCount;
+ThreadTopology        g_threadTopology;
 
 void thread_init(void) {
   /**
@@ -82,6 +83,7 @@ void thread_init_late(void) {
   thread_pal_init_late();
 
   thread_pal_set_name(g_threadName);
+  thread_pal_topology_query(&g_threadTopology);
 }
 
 void thread_teardown(void) { thread_pal_teardown(); }
@@ -150,6 +152,39 @@ void thread_ensure_init(void) {
 
 bool thread_prioritize(const ThreadPriority prio) { return thread_pal_set_priority(prio); }
 
+bool thread_pin(const ThreadPin pin) {
+  const ThreadTopology* topology = &g_threadTopology;
+  if (!topology->cpuCount) {
+    return false; // Topology not available (or not queried yet).
+  }
+  u16 cpuIds[thread_topology_max_cpus];
+  u16 count = 0;
+  switch (pin) {
+  case ThreadPin_None:
+    for (u16 i = 0; i != topology->cpuCount; ++i) {
+      cpuIds[count++] = topology->cpus[i].id;
+    }
+    break;
+  case ThreadPin_Performance:
+  case ThreadPin_Efficiency: {
+    const ThreadCpuType type =
+        pin == ThreadPin_Performance ? ThreadCpuType_Performance : ThreadCpuType_Efficiency;
+    for (u16 i = 0; i != topology->cpuCount; ++i) {
+      if (topology->cpus[i].type == type) {
+        cpuIds[count++] = topology->cpus[i].id;
+      }
+    }
+    if (!count) {
+      return false; // Machine has no cpus of the requested type.
+    }
+    if (count == topology->cpuCount) {
+      return true; // All cpus are of the requested type; nothing to restrict.
+    }
+  } break;
+  }
+  return thread_pal_set_affinity(cpuIds, count);
+}
+
 void thread_join(const ThreadHandle thread) { thread_pal_join(thread); }
 
 void thread_yield(void) { thread_pal_yield(); }
@@ -158,6 +193,21 @@ void thread_sleep(const TimeDuration duration) { thread_pal_sleep(duration); }
 
 bool thread_exists(const ThreadId tid) { return thread_pal_exists(tid); }
 
+static i64 g_threadMutexContendedCount;
+static i64 g_threadMutexContendedDur;
+
+void thread_mutex_contended(const TimeDuration waitDur) {
+  thread_atomic_add_i64(&g_threadMutexContendedCount, 1);
+  thread_atomic_add_i64(&g_threadMutexContendedDur, waitDur);
+}
+
+ThreadMutexStats thread_mutex_stats_query(void) {
+  return (ThreadMutexStats){
+      .contendedCount = (u64)thread_atomic_load_i64(&g_threadMutexContendedCount),
+      .contendedDur   = (TimeDuration)thread_atomic_load_i64(&g_threadMutexContendedDur),
+  };
+}
+
 #if defined(VOLO_THREAD_X86)
 
 void thread_spinlock_lock(ThreadSpinLock* lock) {
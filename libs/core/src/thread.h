@@ -18,12 +18,20 @@ void thread_pal_teardown(void);
 ThreadId thread_pal_pid(void);
 ThreadId thread_pal_tid(void);
 u16      thread_pal_core_count(void);
+void     thread_pal_topology_query(ThreadTopology*);
 uptr     thread_pal_stack_top(void);
 void     thread_pal_set_name(String);
 bool     thread_pal_set_priority(ThreadPriority);
+bool     thread_pal_set_affinity(const u16 cpuIds[], u16 count);
 
 ThreadHandle thread_pal_start(thread_pal_rettype(SYS_DECL*)(void*), void*);
 void         thread_pal_join(ThreadHandle);
 void         thread_pal_yield(void);
 void         thread_pal_sleep(TimeDuration);
 bool         thread_pal_exists(ThreadId);
+
+/**
+ * Record a contended mutex acquisition (one that had to wait for another thread).
+ * Called by the platform mutex implementations; surfaced through 'thread_mutex_stats_query()'.
+ */
+void thread_mutex_contended(TimeDuration waitDur);
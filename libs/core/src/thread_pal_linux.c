@@ -1,11 +1,13 @@
 #include "core/alloc.h"
 #include "core/diag.h"
+#include "core/format.h"
 #include "core/time.h"
 
 #include "thread.h"
 
 #include <dlfcn.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <pthread.h>
 #include <sched.h>
 #include <signal.h>
@@ -155,6 +157,93 @@ u16 thread_pal_core_count(void) {
   return CPU_COUNT(&cpuSet);
 }
 
+static const char* to_null_term_scratch(const String str) {
+  const Mem scratchMem = alloc_alloc(g_allocScratch, str.size + 1, 1);
+  mem_cpy(scratchMem, str);
+  *mem_at_u8(scratchMem, str.size) = '\0';
+  return scratchMem.ptr;
+}
+
+/**
+ * Read a non-negative decimal integer from a (sysfs) file.
+ * Returns a negative value when the file cannot be read.
+ */
+static i64 thread_sysfs_read(const String path) {
+  const int fd = open(to_null_term_scratch(path), O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  char    buffer[64];
+  ssize_t bytesRead;
+  do {
+    bytesRead = read(fd, buffer, sizeof(buffer));
+  } while (bytesRead < 0 && errno == EINTR);
+  close(fd);
+
+  i64 result = -1;
+  for (ssize_t i = 0; i < bytesRead; ++i) {
+    if (buffer[i] < '0' || buffer[i] > '9') {
+      break;
+    }
+    result = (result < 0 ? 0 : result * 10) + (buffer[i] - '0');
+  }
+  return result;
+}
+
+void thread_pal_topology_query(ThreadTopology* out) {
+  /**
+   * Enumerate the logical cpus available to this process (respecting the affinity mask) and read
+   * their layout from sysfs. Hybrid designs are not directly exposed on Linux; instead cpus whose
+   * maximum frequency is well below the machine's fastest cpu are classified as efficiency cpus,
+   * which matches current hybrid x86 designs (the margin leaves room for 'favored core' frequency
+   * differences between performance cpus).
+   *
+   * Docs: https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-devices-system-cpu
+   */
+  *out = (ThreadTopology){0};
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (UNLIKELY(sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)) {
+    diag_crash_msg("sched_getaffinity() failed");
+  }
+
+  i64 freqs[thread_topology_max_cpus];
+  i64 freqMax = 0;
+  for (u16 id = 0; id != CPU_SETSIZE && out->cpuCount != thread_topology_max_cpus; ++id) {
+    if (!CPU_ISSET(id, &cpuSet)) {
+      continue;
+    }
+    const String path = fmt_write_scratch("/sys/devices/system/cpu/cpu{}", fmt_int(id));
+    const i64    coreId =
+        thread_sysfs_read(fmt_write_scratch("{}/topology/core_id", fmt_text(path)));
+    const i64 cacheId =
+        thread_sysfs_read(fmt_write_scratch("{}/cache/index3/id", fmt_text(path)));
+    const i64 freq =
+        thread_sysfs_read(fmt_write_scratch("{}/cpufreq/cpuinfo_max_freq", fmt_text(path)));
+
+    freqs[out->cpuCount] = freq;
+    if (freq > freqMax) {
+      freqMax = freq;
+    }
+    out->cpus[out->cpuCount++] = (ThreadCpu){
+        .id      = id,
+        .coreId  = coreId >= 0 ? (u16)coreId : id,
+        .cacheId = cacheId >= 0 ? (u16)cacheId : 0,
+    };
+  }
+  for (u16 i = 0; i != out->cpuCount; ++i) {
+    // Classify cpus with a maximum frequency below 75% of the fastest cpu as efficiency cpus.
+    if (freqs[i] >= 0 && freqs[i] * 4 < freqMax * 3) {
+      out->cpus[i].type = ThreadCpuType_Efficiency;
+      ++out->efficiencyCount;
+    } else {
+      out->cpus[i].type = ThreadCpuType_Performance;
+      ++out->performanceCount;
+    }
+  }
+}
+
 uptr thread_pal_stack_top(void) {
   pthread_attr_t attr;
   if (g_palPthread.getattr_np(g_palPthread.self(), &attr)) {
@@ -214,6 +303,18 @@ bool thread_pal_set_priority(const ThreadPriority prio) {
   return true;
 }
 
+bool thread_pal_set_affinity(const u16 cpuIds[], const u16 count) {
+  diag_assert(count);
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (u16 i = 0; i != count; ++i) {
+    CPU_SET(cpuIds[i], &cpuSet);
+  }
+  // NOTE: Pid 0 applies to the calling thread (not the whole process).
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+}
+
 i32 thread_atomic_load_i32(i32* ptr) { return __atomic_load_n(ptr, __ATOMIC_SEQ_CST); }
 u32 thread_atomic_load_u32(u32* ptr) { return __atomic_load_n(ptr, __ATOMIC_SEQ_CST); }
 i64 thread_atomic_load_i64(i64* ptr) { return __atomic_load_n(ptr, __ATOMIC_SEQ_CST); }
@@ -246,6 +347,10 @@ i32 thread_atomic_add_i32(i32* ptr, const i32 value) {
   return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
 }
 
+u32 thread_atomic_add_u32(u32* ptr, const u32 value) {
+  return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
 i64 thread_atomic_add_i64(i64* ptr, const i64 value) {
   return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
 }
@@ -381,7 +486,14 @@ void thread_mutex_destroy(const ThreadMutex handle) {
 void thread_mutex_lock(const ThreadMutex handle) {
   ThreadMutexData* data = (ThreadMutexData*)handle;
 
-  const int res = g_palPthread.mutex_lock(&data->impl);
+  // Attempt an uncontended acquire first; only fall back to the (potentially blocking) lock when
+  // another thread holds the mutex, so contention can be tracked.
+  int res = g_palPthread.mutex_trylock(&data->impl);
+  if (UNLIKELY(res == EBUSY)) {
+    const TimeSteady waitStart = time_steady_clock();
+    res                        = g_palPthread.mutex_lock(&data->impl);
+    thread_mutex_contended(time_steady_duration(waitStart, time_steady_clock()));
+  }
   if (UNLIKELY(res != 0)) {
     diag_crash_msg("pthread_mutex_lock() failed: {}", fmt_int(res));
   }
@@ -120,6 +120,94 @@ u16 thread_pal_core_count(void) {
   return sysInfo.dwNumberOfProcessors;
 }
 
+void thread_pal_topology_query(ThreadTopology* out) {
+  /**
+   * Query the processor layout including hybrid (P/E core) information: each core reports an
+   * efficiency-class where higher classes are more performant; cores below the highest class are
+   * classified as efficiency cpus (on homogeneous machines all cores report the same class).
+   *
+   * NOTE: Only the first processor-group is supported (maximum of 64 logical cpus).
+   */
+  *out = (ThreadTopology){0};
+
+  DWORD_PTR processMask, systemMask;
+  if (UNLIKELY(!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))) {
+    diag_crash_msg("GetProcessAffinityMask() failed");
+  }
+
+  DWORD bufferSize = 0;
+  GetLogicalProcessorInformationEx(RelationAll, null, &bufferSize);
+  if (UNLIKELY(GetLastError() != ERROR_INSUFFICIENT_BUFFER)) {
+    diag_crash_msg("GetLogicalProcessorInformationEx() failed");
+  }
+  const Mem buffer = alloc_alloc(g_allocScratch, bufferSize, sizeof(void*));
+  if (UNLIKELY(!GetLogicalProcessorInformationEx(RelationAll, buffer.ptr, &bufferSize))) {
+    diag_crash_msg("GetLogicalProcessorInformationEx() failed");
+  }
+
+  u16 coreIds[thread_topology_max_cpus]  = {0};
+  u16 cacheIds[thread_topology_max_cpus] = {0};
+  u8  classes[thread_topology_max_cpus]  = {0};
+  u8  classMax                           = 0;
+  u16 coreCount = 0, cacheCount = 0;
+
+  for (u8* itr = buffer.ptr; itr < (u8*)buffer.ptr + bufferSize;) {
+    const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX* info = (const void*)itr;
+    itr += info->Size;
+
+    switch (info->Relationship) {
+    case RelationProcessorCore: {
+      if (info->Processor.GroupMask[0].Group != 0) {
+        continue; // Only the first processor-group is supported.
+      }
+      const u64 mask = (u64)info->Processor.GroupMask[0].Mask;
+      for (u16 id = 0; id != thread_topology_max_cpus; ++id) {
+        if (mask >> id & 1) {
+          coreIds[id] = coreCount;
+          classes[id] = info->Processor.EfficiencyClass;
+        }
+      }
+      if (info->Processor.EfficiencyClass > classMax) {
+        classMax = info->Processor.EfficiencyClass;
+      }
+      ++coreCount;
+    } break;
+    case RelationCache: {
+      if (info->Cache.Level != 3 || info->Cache.GroupMask.Group != 0) {
+        continue; // Only the last-level cache of the first processor-group is tracked.
+      }
+      const u64 mask = (u64)info->Cache.GroupMask.Mask;
+      for (u16 id = 0; id != thread_topology_max_cpus; ++id) {
+        if (mask >> id & 1) {
+          cacheIds[id] = cacheCount;
+        }
+      }
+      ++cacheCount;
+    } break;
+    default:
+      break;
+    }
+  }
+
+  for (u16 id = 0; id != thread_topology_max_cpus; ++id) {
+    if (!((u64)processMask >> id & 1)) {
+      continue; // Cpu not available to this process.
+    }
+    const bool performance = classes[id] == classMax;
+    if (performance) {
+      ++out->performanceCount;
+    } else {
+      ++out->efficiencyCount;
+    }
+    out->cpus[out->cpuCount++] = (ThreadCpu){
+        .id      = id,
+        .coreId  = coreIds[id],
+        .cacheId = cacheIds[id],
+        .type    = performance ? ThreadCpuType_Performance : ThreadCpuType_Efficiency,
+    };
+  }
+}
+
 uptr thread_pal_stack_top(void) {
   ULONG_PTR low, high;
   GetCurrentThreadStackLimits(&low, &high);
@@ -160,6 +248,16 @@ bool thread_pal_set_priority(const ThreadPriority prio) {
   return true; // No elevated permissions requirements on windows.
 }
 
+bool thread_pal_set_affinity(const u16 cpuIds[], const u16 count) {
+  diag_assert(count);
+
+  DWORD_PTR mask = 0;
+  for (u16 i = 0; i != count; ++i) {
+    mask |= (DWORD_PTR)1 << cpuIds[i];
+  }
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
 i32 thread_atomic_load_i32(i32* ptr) {
   return InterlockedCompareExchange((volatile LONG*)ptr, 0, 0);
 }
@@ -222,6 +320,10 @@ i32 thread_atomic_add_i32(i32* ptr, const i32 value) {
   return (i32)InterlockedExchangeAdd((volatile LONG*)ptr, value);
 }
 
+u32 thread_atomic_add_u32(u32* ptr, const u32 value) {
+  return (u32)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+}
+
 i64 thread_atomic_add_i64(i64* ptr, const i64 value) {
   return (i64)InterlockedExchangeAdd64((volatile LONG64*)ptr, value);
 }
@@ -310,7 +412,13 @@ void thread_mutex_destroy(const ThreadMutex handle) {
 void thread_mutex_lock(const ThreadMutex handle) {
   ThreadMutexData* data = (ThreadMutexData*)handle;
 
-  EnterCriticalSection(&data->impl);
+  // Attempt an uncontended acquire first; only fall back to the (potentially blocking) lock when
+  // another thread holds the mutex, so contention can be tracked.
+  if (UNLIKELY(!TryEnterCriticalSection(&data->impl))) {
+    const TimeSteady waitStart = time_steady_clock();
+    EnterCriticalSection(&data->impl);
+    thread_mutex_contended(time_steady_duration(waitStart, time_steady_clock()));
+  }
 }
 
 bool thread_mutex_trylock(const ThreadMutex handle) {
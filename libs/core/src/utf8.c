@@ -4,6 +4,10 @@
 #include "core/string.h"
 #include "core/utf8.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
 #define utf8_cp_max ((Unicode)0x10FFFF)
 #define utf8_cp_single_char ((Unicode)0x7F)
 #define utf8_cp_double_char ((Unicode)0x7FF)
@@ -29,6 +33,15 @@ bool utf8_validate(const String str) {
   const u8* chars    = string_begin(str);
   const u8* charsEnd = string_end(str);
   while (chars != charsEnd) {
+#ifdef VOLO_SIMD
+    // Fast path: whole blocks of ascii characters (no byte with the high bit set) are valid.
+    while ((usize)(charsEnd - chars) >= 16 && !simd_vec_mask_u8(simd_vec_load_unaligned(chars))) {
+      chars += 16;
+    }
+    if (chars == charsEnd) {
+      break;
+    }
+#endif
     const usize charCount = utf8_cp_bytes_from_first(chars[0]);
     if (UNLIKELY((usize)(charsEnd - chars) < charCount)) {
       return false; // Not enough characters left for this code-point.
@@ -62,8 +75,20 @@ bool utf8_validate(const String str) {
 }
 
 usize utf8_cp_count(const String str) {
-  usize result = 0;
-  mem_for_u8(str, itr) {
+  usize     result = 0;
+  const u8* itr    = string_begin(str);
+  const u8* end    = string_end(str);
+#ifdef VOLO_SIMD
+  // Count the continuation characters a whole block at a time.
+  const SimdVec contMask = simd_vec_broadcast_u8(0b11000000);
+  const SimdVec contVal  = simd_vec_broadcast_u8(0b10000000);
+  for (; (usize)(end - itr) >= 16; itr += 16) {
+    const SimdVec block = simd_vec_load_unaligned(itr);
+    const SimdVec cont  = simd_vec_eq_u8(simd_vec_and(block, contMask), contVal);
+    result += 16 - bits_popcnt_32(simd_vec_mask_u8(cont));
+  }
+#endif
+  for (; itr != end; ++itr) {
     if (!utf8_contchar_internal(*itr)) {
       ++result;
     }
@@ -185,3 +210,28 @@ String utf8_cp_read(String utf8, Unicode* out) {
   }
   return utf8_consume_bytes(utf8, charCount);
 }
+
+String utf8_cp_read_many(String utf8, Unicode out[], const usize capacity, usize* outCount) {
+  usize count = 0;
+  while (count != capacity && utf8.size) {
+#ifdef VOLO_SIMD
+    // Fast path: decode whole blocks of ascii characters at once.
+    while (utf8.size >= 16 && (capacity - count) >= 16) {
+      const u8* chars = string_begin(utf8);
+      if (simd_vec_mask_u8(simd_vec_load_unaligned(chars))) {
+        break; // Block contains non-ascii characters.
+      }
+      for (u32 i = 0; i != 16; ++i) {
+        out[count++] = chars[i];
+      }
+      utf8 = utf8_consume_bytes(utf8, 16);
+    }
+    if (count == capacity || !utf8.size) {
+      break;
+    }
+#endif
+    utf8 = utf8_cp_read(utf8, &out[count++]);
+  }
+  *outCount = count;
+  return utf8;
+}
@@ -1,4 +1,5 @@
 #include "core/array.h"
+#include "core/bits.h"
 #include "core/deflate.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
@@ -90,3 +91,22 @@ String zlib_decode(String input, DynString* out, ZlibError* err) {
   *err = ZlibError_None;
   return input;
 }
+
+void zlib_encode_header(DynString* out) {
+  /**
+   * Header: deflate method with a 32k window (cmf 0x78) and an flg byte chosen so the header
+   * passes the '% 31' checksum without a preset dictionary (0x9C).
+   */
+  dynstring_append_char(out, 0x78);
+  dynstring_append_char(out, 0x9C);
+}
+
+void zlib_encode_trailer(const String input, DynString* out) {
+  mem_write_be_u32(dynstring_push(out, 4), bits_adler_32(1, input));
+}
+
+void zlib_encode(const String input, DynString* out) {
+  zlib_encode_header(out);
+  deflate_encode(input, out);
+  zlib_encode_trailer(input, out);
+}
@@ -4,6 +4,7 @@ void app_check_init(CheckDef* check) {
   register_spec(check, alloc_block);
   register_spec(check, alloc_bump);
   register_spec(check, alloc_chunked);
+  register_spec(check, alloc_frame);
   register_spec(check, alloc_page);
   register_spec(check, alloc_scratch);
   register_spec(check, array);
@@ -20,6 +21,7 @@ void app_check_init(CheckDef* check) {
   register_spec(check, dynlib);
   register_spec(check, dynstring);
   register_spec(check, env);
+  register_spec(check, file_async);
   register_spec(check, file_iterator);
   register_spec(check, file_monitor);
   register_spec(check, file);
@@ -29,6 +31,7 @@ void app_check_init(CheckDef* check) {
   register_spec(check, macro);
   register_spec(check, math);
   register_spec(check, memory);
+  register_spec(check, noise);
   register_spec(check, path);
   register_spec(check, process);
   register_spec(check, rng);
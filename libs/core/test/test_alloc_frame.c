@@ -0,0 +1,38 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+
+spec(alloc_frame) {
+  it("respects the requested alignment") {
+    alloc_alloc(g_allocFrame, 32, 32); // Start with an alignment of (atleast) 32 bytes.
+
+    u8* startAddr = mem_begin(alloc_alloc(g_allocFrame, 1, 1));
+    u8* addr      = mem_begin(alloc_alloc(g_allocFrame, 6, 2));
+
+    check(addr == startAddr + 2);
+
+    addr = mem_begin(alloc_alloc(g_allocFrame, 8, 8));
+
+    check(addr == startAddr + 8);
+
+    addr = mem_begin(alloc_alloc(g_allocFrame, 64, 32));
+
+    check(addr == startAddr + 32);
+  }
+
+  it("reuses the memory after a reset") {
+    alloc_reset(g_allocFrame); // Claim a fresh chunk for this thread.
+
+    const Mem memA = alloc_alloc(g_allocFrame, 64, 8);
+    check(mem_valid(memA));
+
+    alloc_reset(g_allocFrame);
+
+    const Mem memB = alloc_alloc(g_allocFrame, 64, 8);
+    check(memB.ptr == memA.ptr);
+  }
+
+  it("fails allocations that exceed the maximum size") {
+    const usize maxSize = alloc_max_size(g_allocFrame);
+    check(!mem_valid(alloc_alloc(g_allocFrame, maxSize * 2, sizeof(void*))));
+  }
+}
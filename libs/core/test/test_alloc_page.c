@@ -1,5 +1,6 @@
 #include "check/spec.h"
 #include "core/alloc.h"
+#include "core/sentinel.h"
 
 spec(alloc_page) {
 
@@ -19,4 +20,20 @@ spec(alloc_page) {
 
     alloc_free(g_allocPage, alloc);
   }
+
+  it("reports at least one numa node") { check(alloc_page_numa_node_count() >= 1); }
+
+  it("can allocate memory with a numa hint active") {
+    check(sentinel_check(alloc_page_numa_hint()));
+
+    alloc_page_numa_hint_set(0);
+    check_eq_int(alloc_page_numa_hint(), 0);
+
+    const Mem alloc = alloc_alloc(g_allocPage, 64, 8);
+    check_eq_int(alloc.size, 64);
+    alloc_free(g_allocPage, alloc);
+
+    alloc_page_numa_hint_clear();
+    check(sentinel_check(alloc_page_numa_hint()));
+  }
 }
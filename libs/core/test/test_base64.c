@@ -1,8 +1,21 @@
 #include "check/spec.h"
 #include "core/base64.h"
+#include "core/rng.h"
 
 spec(base64) {
 
+  it("can encode/decode binary data of any size") {
+    u8 data[128];
+    for (u32 size = 0; size != sizeof(data); ++size) {
+      for (u32 i = 0; i != size; ++i) {
+        data[i] = (u8)rng_sample_u32(g_rng);
+      }
+      const String encoded = base64_encode_scratch(mem_create(data, size));
+      const String decoded = base64_decode_scratch(encoded);
+      check_eq_string(decoded, mem_create(data, size));
+    }
+  }
+
   it("can encode/decode helloworld") {
     const String encoded = string_lit("SGVsbG8gV29ybGQ=");
     const String decoded = base64_decode_scratch(encoded);
@@ -86,4 +86,36 @@ spec(bc) {
       check_eq_color8888(decodedBlock.colors[i], orgBlock.colors[i]);
     }
   }
+
+  it("can encode a checker bc3 block with varying alpha") {
+    static const BcColor8888 g_translucentWhite = {255, 255, 255, 0};
+
+    Bc0Block orgBlock;
+    test_bc0_block_fill_checker(&orgBlock, g_black, g_translucentWhite);
+
+    Bc3Block bc3Block;
+    bc3_encode(&orgBlock, &bc3Block);
+
+    Bc0Block decodedBlock;
+    bc3_decode(&bc3Block, &decodedBlock);
+
+    for (u32 i = 0; i != array_elems(decodedBlock.colors); ++i) {
+      check_eq_color8888(decodedBlock.colors[i], orgBlock.colors[i]);
+    }
+  }
+
+  it("can encode a black and white checker bc4 block") {
+    Bc0Block orgBlock;
+    test_bc0_block_fill_checker(&orgBlock, g_black, g_white);
+
+    Bc4Block bc4Block;
+    bc4_encode(&orgBlock, &bc4Block);
+
+    Bc0Block decodedBlock;
+    bc4_decode(&bc4Block, &decodedBlock);
+
+    for (u32 i = 0; i != array_elems(decodedBlock.colors); ++i) {
+      check_eq_int(decodedBlock.colors[i].r, orgBlock.colors[i].r);
+    }
+  }
 }
@@ -163,6 +163,8 @@ spec(bits) {
     check_eq_int(bits_crc_32(0, string_lit("h")), 0x916B06E7);
     check_eq_int(bits_crc_32(0, string_lit("hello")), 0x3610A686);
     check_eq_int(bits_crc_32(0, string_lit("Hello World")), 0x4A17B156);
+    const String pangram = string_lit("The quick brown fox jumps over the lazy dog");
+    check_eq_int(bits_crc_32(0, pangram), 0x414FA339);
     {
       u32 crc = 0;
       crc     = bits_crc_32(crc, string_lit("Hello"));
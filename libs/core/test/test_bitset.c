@@ -251,6 +251,30 @@ spec(bitset) {
     check_eq_int(bitset_next(evenBits64, 0), 42);
   }
 
+  it("can bitwise 'and-not' two bitsets") {
+    BitSet evenBits64   = bitset_from_var((u64){0});
+    BitSet unevenBits64 = bitset_from_var((u64){0});
+    for (u32 i = 0; i != 64; ++i) {
+      bitset_set(i % 2 ? unevenBits64 : evenBits64, i);
+    }
+
+    BitSet bits64 = bitset_from_var((u64){0});
+    bitset_or(bits64, evenBits64);
+    bitset_or(bits64, unevenBits64);
+    check_eq_int(bitset_count(bits64), 64);
+
+    bitset_and_not(bits64, unevenBits64);
+    check_eq_int(bitset_count(bits64), 32);
+
+    // Check that only the even bits remain.
+    for (u32 i = 0; i != 64; ++i) {
+      check(bitset_test(bits64, i) == (i % 2 == 0));
+    }
+
+    bitset_and_not(bits64, evenBits64);
+    check_eq_int(bitset_count(bits64), 0);
+  }
+
   it("can bitwise 'xor' two bitsets") {
     BitSet evenBits64   = bitset_from_var((u64){0});
     BitSet unevenBits64 = bitset_from_var((u64){0});
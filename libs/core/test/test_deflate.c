@@ -3,6 +3,7 @@
 #include "core/bits.h"
 #include "core/deflate.h"
 #include "core/dynstring.h"
+#include "core/rng.h"
 
 static String test_data_scratch(const String bitString) {
   Mem       scratchMem = alloc_alloc(g_allocScratch, bits_to_bytes(bitString.size) + 1, 1);
@@ -78,6 +79,22 @@ static void test_decode_fail(
       fmt_bitset(input, .order = FormatBitsetOrder_LeastToMostSignificant));
 }
 
+static void test_encode_roundtrip(CheckTestContext* _testCtx, const String data) {
+  Mem       encodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte * 16, 1);
+  DynString encodedBuffer = dynstring_create_over(encodedMem);
+  deflate_encode(data, &encodedBuffer);
+
+  Mem       decodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte * 16, 1);
+  DynString decodedBuffer = dynstring_create_over(decodedMem);
+
+  DeflateError err;
+  const String remaining = deflate_decode(dynstring_view(&encodedBuffer), &decodedBuffer, &err);
+
+  check_eq_int(err, DeflateError_None);
+  check_eq_int(remaining.size, 0);
+  check(mem_eq(dynstring_view(&decodedBuffer), data));
+}
+
 spec(deflate) {
   it("successfully decodes an empty uncompressed block") {
     test_decode_success(
@@ -514,4 +531,44 @@ spec(deflate) {
                    "000 000 100 000"),
         DeflateError_Truncated);
   }
+
+  it("round-trips encoded data") {
+    test_encode_roundtrip(_testCtx, string_empty);
+    test_encode_roundtrip(_testCtx, string_lit("Hello World!\n"));
+    test_encode_roundtrip(
+        _testCtx,
+        string_lit("The quick brown fox jumps over the lazy dog. "
+                   "The quick brown fox jumps over the lazy dog. "
+                   "The quick brown fox jumps over the lazy dog."));
+
+    // Incompressible (random) data.
+    Mem       randomMem = alloc_alloc(g_allocScratch, usize_kibibyte * 4, 1);
+    DynString randomStr = dynstring_create_over(randomMem);
+    for (usize i = 0; i != usize_kibibyte * 4; ++i) {
+      dynstring_append_char(&randomStr, (u8)rng_sample_u32(g_rng));
+    }
+    test_encode_roundtrip(_testCtx, dynstring_view(&randomStr));
+  }
+
+  it("round-trips independently encoded chunks as a single stream") {
+    const String chunkA = string_lit("Hello beautiful ");
+    const String chunkB = string_lit("world, hello hello!");
+
+    Mem       encodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte, 1);
+    DynString encodedBuffer = dynstring_create_over(encodedMem);
+    deflate_encode_chunk(chunkA, false /* last */, &encodedBuffer);
+    const usize chunkBoundary = encodedBuffer.size;
+    deflate_encode_chunk(chunkB, true /* last */, &encodedBuffer);
+
+    Mem       decodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte, 1);
+    DynString decodedBuffer = dynstring_create_over(decodedMem);
+
+    DeflateError err;
+    const String remaining = deflate_decode(dynstring_view(&encodedBuffer), &decodedBuffer, &err);
+
+    check(chunkBoundary != 0); // Chunks end on a byte boundary.
+    check_eq_int(err, DeflateError_None);
+    check_eq_int(remaining.size, 0);
+    check_eq_string(dynstring_view(&decodedBuffer), string_lit("Hello beautiful world, hello hello!"));
+  }
 }
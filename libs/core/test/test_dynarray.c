@@ -47,7 +47,30 @@ spec(dynarray) {
     Allocator* alloc = alloc_bump_create_stack(1024);
 
     DynArray array = dynarray_create_t(alloc, u64, 0);
-    dynarray_reserve(&array, 8);
+    dynarray_reserve(&array, 9);
+    check_eq_int(array.data.size, 9 * sizeof(u64)); // Reserved exactly; no geometric overshoot.
+
+    dynarray_destroy(&array);
+  }
+
+  it("can shrink the capacity to fit the size") {
+    Allocator* alloc = alloc_bump_create_stack(1024);
+
+    DynArray array = dynarray_create_t(alloc, u64, 0);
+    for (u64 i = 0; i != 5; ++i) {
+      *dynarray_push_t(&array, u64) = i;
+    }
+    check(array.data.size > 5 * sizeof(u64)); // Pushing overshoots geometrically.
+
+    dynarray_shrink_to_fit(&array);
+    check_eq_int(array.data.size, 5 * sizeof(u64));
+    for (u64 i = 0; i != 5; ++i) {
+      check_eq_int(*dynarray_at_t(&array, i, u64), i);
+    }
+
+    dynarray_resize(&array, 0);
+    dynarray_shrink_to_fit(&array);
+    check(!mem_valid(array.data));
 
     dynarray_destroy(&array);
   }
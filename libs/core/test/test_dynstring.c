@@ -1,4 +1,5 @@
 #include "check/spec.h"
+#include "core/alloc.h"
 #include "core/dynstring.h"
 
 spec(dynstring) {
@@ -9,6 +10,20 @@ spec(dynstring) {
     dynstring_destroy(&string);
   }
 
+  it("can spill from an inline buffer to an allocator") {
+    Allocator* alloc  = alloc_bump_create_stack(128);
+    DynString  string = dynstring_create_inline(alloc, 8);
+
+    dynstring_append(&string, string_lit("Hello")); // Fits in the inline buffer; no allocation.
+    check(!string.ownsMem);
+
+    dynstring_append(&string, string_lit(" World")); // Exceeds the buffer; spills to the allocator.
+    check(string.ownsMem);
+    check_eq_string(dynstring_view(&string), string_lit("Hello World"));
+
+    dynstring_destroy(&string);
+  }
+
   it("can append strings") {
     DynString string = dynstring_create_over(mem_stack(128));
 
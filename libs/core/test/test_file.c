@@ -124,6 +124,22 @@ spec(file) {
     check_eq_string(mapping, string_lit("Hello World!"));
   }
 
+  it("can apply access hints to a region of a memory map") {
+    file_write_sync(tmpFile, string_lit("Hello World!"));
+
+    String mapping;
+    check_eq_int(file_map(tmpFile, 0, 0, FileHints_Sequential, &mapping), FileResult_Success);
+
+    check_eq_int(file_map_advise(tmpFile, mapping, FileHints_Prefetch), FileResult_Success);
+    check_eq_int(
+        file_map_advise(tmpFile, mem_slice(mapping, 6, 5), FileHints_Random), FileResult_Success);
+
+    // Regions outside of any mapping are rejected.
+    u8 local[8];
+    check_eq_int(
+        file_map_advise(tmpFile, mem_var(local), FileHints_Prefetch), FileResult_InvalidMapping);
+  }
+
   it("can write file contents through a memory map") {
     file_resize_sync(tmpFile, 12);
 
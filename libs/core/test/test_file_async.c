@@ -0,0 +1,66 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/file_async.h"
+
+spec(file_async) {
+
+  File*      tmpFile = null;
+  FileAsync* async   = null;
+
+  setup() {
+    file_temp(g_allocHeap, &tmpFile);
+    async = file_async_create(g_allocHeap);
+  }
+
+  it("can read-back content that was written") {
+    const String      data    = string_lit("Hello Async World!");
+    usize             bytes;
+    const FileAsyncId writeOp = file_async_write(async, tmpFile, 0, data);
+    check_eq_int(file_async_wait(async, writeOp, &bytes), FileResult_Success);
+    check_eq_int(bytes, data.size);
+
+    Mem               buffer = alloc_alloc(g_allocScratch, data.size, 1);
+    const FileAsyncId readOp = file_async_read(async, tmpFile, 0, buffer);
+    check_eq_int(file_async_wait(async, readOp, &bytes), FileResult_Success);
+    check_eq_int(bytes, data.size);
+    check_eq_string(buffer, data);
+  }
+
+  it("can issue multiple overlapping reads") {
+    const String data = string_lit("0123456789");
+    usize        bytes;
+    check_eq_int(
+        file_async_wait(async, file_async_write(async, tmpFile, 0, data), &bytes),
+        FileResult_Success);
+
+    Mem         buffers[5];
+    FileAsyncId readOps[5];
+    for (u32 i = 0; i != 5; ++i) {
+      buffers[i] = alloc_alloc(g_allocScratch, 2, 1);
+      readOps[i] = file_async_read(async, tmpFile, i * 2, buffers[i]);
+    }
+    for (u32 i = 0; i != 5; ++i) {
+      check_eq_int(file_async_wait(async, readOps[i], &bytes), FileResult_Success);
+      check_eq_int(bytes, 2);
+      check_eq_string(buffers[i], string_slice(data, i * 2, 2));
+    }
+  }
+
+  it("reports no-data when reading past the end of the file") {
+    usize bytes;
+    check_eq_int(
+        file_async_wait(async, file_async_write(async, tmpFile, 0, string_lit("abc")), &bytes),
+        FileResult_Success);
+
+    Mem buffer = alloc_alloc(g_allocScratch, 16, 1);
+    check_eq_int(
+        file_async_wait(async, file_async_read(async, tmpFile, 100, buffer), &bytes),
+        FileResult_NoDataAvailable);
+    check_eq_int(bytes, 0);
+  }
+
+  teardown() {
+    file_async_destroy(async);
+    file_destroy(tmpFile);
+  }
+}
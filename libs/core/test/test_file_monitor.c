@@ -1,5 +1,6 @@
 #include "check/spec.h"
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/file.h"
 #include "core/file_monitor.h"
 #include "core/path.h"
@@ -128,6 +129,47 @@ spec(file_monitor) {
     file_delete_sync(pathAbsB);
   }
 
+  it("returns zero events when batch-polling when no modifications have happened") {
+    check_eq_int(file_monitor_watch(monitor, testFilePath, 0), FileMonitorResult_Success);
+
+    FileMonitorEvent events[8];
+    check_eq_int(
+        file_monitor_poll_many(monitor, time_milliseconds(5), events, array_elems(events)), 0);
+  }
+
+  /**
+   * TODO: Skipped for now as it can be a bit flaky on slow machines due to timing requirements.
+   */
+  skip_it("coalesces a burst of modifications into a single batch") {
+    const String pathRel = test_random_name();
+    const String pathAbs = path_build_scratch(g_pathTempDir, pathRel);
+    file_write_to_path_sync(pathAbs, string_lit(""));
+
+    check_eq_int(file_monitor_watch(monitor, pathRel, 42), FileMonitorResult_Success);
+
+    thread_sleep(time_milliseconds(1));
+
+    // Modify the same file multiple times in quick succession.
+    file_write_to_path_sync(pathAbs, string_lit("Hello"));
+    file_write_to_path_sync(pathAbs, string_lit("Hello World"));
+    file_write_to_path_sync(pathAbs, string_lit("Hello World!"));
+
+    thread_sleep(time_milliseconds(1));
+
+    FileMonitorEvent events[8];
+    const usize      count =
+        file_monitor_poll_many(monitor, time_milliseconds(5), events, array_elems(events));
+
+    // The burst is de-duplicated into a single event for the file.
+    check_require(count == 1);
+    check_eq_string(events[0].path, pathRel);
+    check_eq_int(events[0].userData, 42);
+
+    check(!file_monitor_poll_many(monitor, time_milliseconds(5), events, array_elems(events)));
+
+    file_delete_sync(pathAbs);
+  }
+
   it("watching fails when the root directory cannot be opened") {
     const String nonExistentDir = path_build_scratch(g_pathTempDir, string_lit("does-not-exist"));
     FileMonitor* mon = file_monitor_create(g_allocHeap, nonExistentDir, FileMonitorFlags_None);
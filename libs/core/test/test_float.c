@@ -1,4 +1,5 @@
 #include "check/spec.h"
+#include "core/array.h"
 #include "core/bits.h"
 #include "core/float.h"
 
@@ -61,6 +62,21 @@ spec(float) {
     check_eq_float(float_f16_to_f32(float_f32_to_f16(-13.37f)), -13.37f, 1e-2f);
   }
 
+  it("can convert between 32 and 16 bit floats in batches") {
+    f32 values[11];
+    for (u32 i = 0; i != array_elems(values); ++i) {
+      values[i] = ((i32)i - 5) * 13.37f;
+    }
+    f16 packed[array_elems(values)];
+    f32 unpacked[array_elems(values)];
+    float_f32_to_f16_batch(values, packed, array_elems(values));
+    float_f16_to_f32_batch(packed, unpacked, array_elems(values));
+    for (u32 i = 0; i != array_elems(values); ++i) {
+      check_eq_int(packed[i], float_f32_to_f16(values[i]));
+      check_eq_float(unpacked[i], values[i], 1e-1f);
+    }
+  }
+
   it("can quantize 32 bit floats to use a limited amount of mantissa bits") {
     check(1.1234f != 1.1235f);
     check(float_quantize_f32(1.1234f, 10) == float_quantize_f32(1.1235f, 10));
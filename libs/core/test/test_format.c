@@ -69,6 +69,45 @@ spec(format) {
     dynstring_destroy(&string);
   }
 
+  it("can write pre-compiled formatted strings") {
+    struct {
+      String           format;
+      const FormatArg* args;
+      String           expected;
+    } const data[] = {
+        {string_lit("Value {}"), fmt_args(fmt_int(42)), string_lit("Value 42")},
+        {string_lit("hello world"), fmt_args(), string_lit("hello world")},
+        {string_lit("{} hello world {  }-{ \t }"),
+         fmt_args(fmt_bool(false), fmt_int(42), fmt_bool(true)),
+         string_lit("false hello world 42-true")},
+        {string_lit("{>4}|{<4}|"), fmt_args(fmt_int(1), fmt_int(20)), string_lit("   1|20  |")},
+        {string_lit("{ >4 }|{ >4}|{:4}|{:4}|"),
+         fmt_args(fmt_int(1), fmt_int(20), fmt_int(1), fmt_int(42)),
+         string_lit("   1|  20| 1  | 42 |")},
+    };
+
+    DynString string = dynstring_create_over(mem_stack(128));
+    for (usize i = 0; i != array_elems(data); ++i) {
+      FormatCompiled compiled;
+      format_compile(&compiled, data[i].format);
+
+      dynstring_clear(&string);
+      format_write_compiled(&string, &compiled, data[i].args);
+      check_eq_string(dynstring_view(&string), data[i].expected);
+    }
+    dynstring_destroy(&string);
+  }
+
+  it("can write formatted strings with the compiled macro") {
+    DynString string = dynstring_create_over(mem_stack(128));
+    for (u32 i = 0; i != 2; ++i) { // Twice; the second call re-uses the hidden static.
+      dynstring_clear(&string);
+      fmt_write_compiled(&string, "Value {}!", fmt_int(i));
+      check_eq_string(dynstring_view(&string), fmt_write_scratch("Value {}!", fmt_int(i)));
+    }
+    dynstring_destroy(&string);
+  }
+
   it("can write memory as hex") {
     DynString string = dynstring_create_over(mem_stack(128));
 
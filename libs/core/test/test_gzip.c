@@ -22,4 +22,22 @@ spec(gzip) {
     check_eq_string(meta.name, string_lit("test.txt"));
     check_eq_string(dynstring_view(&outputBuffer), string_lit("Hello World!\n"));
   }
+
+  it("can round-trip encoded data") {
+    const String data = string_lit("Hello World, Hello World, Hello World!\n");
+
+    Mem       encodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte, 1);
+    DynString encodedBuffer = dynstring_create_over(encodedMem);
+    gzip_encode(data, &encodedBuffer);
+
+    Mem       decodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte, 1);
+    DynString decodedBuffer = dynstring_create_over(decodedMem);
+
+    GzipError    err;
+    const String remaining = gzip_decode(dynstring_view(&encodedBuffer), null, &decodedBuffer, &err);
+
+    check_eq_int(err, GzipError_None);
+    check_eq_string(remaining, string_empty);
+    check_eq_string(dynstring_view(&decodedBuffer), data);
+  }
 }
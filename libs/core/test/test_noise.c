@@ -0,0 +1,55 @@
+#include "check/spec.h"
+#include "core/array.h"
+#include "core/noise.h"
+#include "core/rng.h"
+
+spec(noise) {
+
+  it("returns values in the -1 to 1 range") {
+    for (u32 i = 0; i != 1000; ++i) {
+      const f32 x   = rng_sample_range(g_rng, -100.0f, 100.0f);
+      const f32 y   = rng_sample_range(g_rng, -100.0f, 100.0f);
+      const f32 z   = rng_sample_range(g_rng, -100.0f, 100.0f);
+      const f32 val = noise_perlin3(x, y, z);
+      check(val >= -1.0f);
+      check(val <= 1.0f);
+    }
+  }
+
+  it("matches the per-sample evaluation when sampling in bulk") {
+    f32 xs[31], ys[31], zs[31], out[31];
+    for (u32 i = 0; i != array_elems(xs); ++i) {
+      xs[i] = rng_sample_range(g_rng, -100.0f, 100.0f);
+      ys[i] = rng_sample_range(g_rng, -100.0f, 100.0f);
+      zs[i] = rng_sample_range(g_rng, -100.0f, 100.0f);
+    }
+    noise_perlin3_many(xs, ys, zs, out, array_elems(xs));
+
+    for (u32 i = 0; i != array_elems(xs); ++i) {
+      check_eq_float(out[i], noise_perlin3(xs[i], ys[i], zs[i]), 1e-5f);
+    }
+  }
+
+  it("matches the per-sample evaluation when sampling fbm in bulk") {
+    static const u32 g_octaves     = 4;
+    static const f32 g_lacunarity  = 2.0f;
+    static const f32 g_persistence = 0.5f;
+
+    f32 xs[31], ys[31], zs[31], out[31];
+    for (u32 i = 0; i != array_elems(xs); ++i) {
+      xs[i] = rng_sample_range(g_rng, -100.0f, 100.0f);
+      ys[i] = rng_sample_range(g_rng, -100.0f, 100.0f);
+      zs[i] = rng_sample_range(g_rng, -100.0f, 100.0f);
+    }
+    noise_perlin3_fbm_many(
+        xs, ys, zs, out, array_elems(xs), g_octaves, g_lacunarity, g_persistence);
+
+    for (u32 i = 0; i != array_elems(xs); ++i) {
+      const f32 expected =
+          noise_perlin3_fbm(xs[i], ys[i], zs[i], g_octaves, g_lacunarity, g_persistence);
+      check_eq_float(out[i], expected, 1e-5f);
+      check(out[i] >= -1.0f);
+      check(out[i] <= 1.0f);
+    }
+  }
+}
@@ -110,6 +110,30 @@ spec(path) {
     dynstring_destroy(&string);
   }
 
+  it("can canonize sibling paths in the same directory") {
+    // Building sibling paths hits the cached directory prefix; verify it matches a full canonize.
+    struct {
+      String path;
+      String expected;
+    } const data[] = {
+        {string_lit("/How/You//./Doing/a.txt"), string_lit("/How/You/Doing/a.txt")},
+        {string_lit("/How/You//./Doing/b.txt"), string_lit("/How/You/Doing/b.txt")},
+        {string_lit("/How/You//./Doing/c"), string_lit("/How/You/Doing/c")},
+        {string_lit("/How/.."), string_lit("/")},
+        {string_lit("/How/You//./Doing/d.txt"), string_lit("/How/You/Doing/d.txt")},
+        {string_lit("c:\\Stuff\\e.txt"), string_lit("C:/Stuff/e.txt")},
+        {string_lit("c:\\Stuff\\f.txt"), string_lit("C:/Stuff/f.txt")},
+    };
+
+    DynString string = dynstring_create_over(mem_stack(128));
+    for (usize i = 0; i != array_elems(data); ++i) {
+      dynstring_clear(&string);
+      path_canonize(&string, data[i].path);
+      check_eq_string(dynstring_view(&string), data[i].expected);
+    }
+    dynstring_destroy(&string);
+  }
+
   it("can append paths together") {
     DynString string = dynstring_create_over(mem_stack(128));
 
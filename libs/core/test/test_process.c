@@ -91,6 +91,23 @@ spec(process) {
     process_destroy(child);
   }
 
+  it("can read std-out without blocking") {
+    const String       args[]   = {string_lit("--block")};
+    const u32          argCount = array_elems(args);
+    const ProcessFlags flags    = ProcessFlags_PipeStdOut | ProcessFlags_NonBlockingOutput;
+    Process*           child    = process_create(g_allocHeap, helperPath, args, argCount, flags);
+
+    check_require(process_start_result(child) == ProcessResult_Success);
+
+    // The helper blocks without producing output; the read should not wait for it.
+    check_eq_int(file_read_sync(process_pipe_out(child), &buffer), FileResult_WouldBlock);
+
+    check_eq_int(process_signal(child, Signal_Kill), ProcessResult_Success);
+    check_eq_int(process_block(child), ProcessExitCode_TerminatedBySignal);
+
+    process_destroy(child);
+  }
+
   it("can read std-out") {
     const String       args[]   = {string_lit("--greet")};
     const u32          argCount = array_elems(args);
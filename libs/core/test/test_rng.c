@@ -1,5 +1,6 @@
 #include "check/spec.h"
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/rng.h"
 
 spec(rng) {
@@ -78,6 +79,69 @@ spec(rng) {
     rng_destroy(rng);
   }
 
+  it("matches the single-sample sequence when sampling in bulk") {
+    static const u64 g_seed = 42;
+
+    Allocator* alloc     = alloc_bump_create_stack(512);
+    Rng*       rngBulk   = rng_create_xorwow(alloc, g_seed);
+    Rng*       rngSingle = rng_create_xorwow(alloc, g_seed);
+
+    u32 samples[64];
+    rng_sample_many_u32(rngBulk, samples, array_elems(samples));
+
+    for (usize i = 0; i != array_elems(samples); ++i) {
+      check_eq_int(samples[i], rng_sample_u32(rngSingle));
+    }
+
+    rng_destroy(rngBulk);
+    rng_destroy(rngSingle);
+  }
+
+  it("can sample floats in bulk with a uniform distribution") {
+    static const u64 g_seed = 42;
+
+    Allocator* alloc = alloc_bump_create_stack(256);
+    Rng*       rng   = rng_create_xorwow(alloc, g_seed);
+
+    f32 samples[1000];
+    rng_sample_many_f32(rng, samples, array_elems(samples));
+
+    f64 sum = 0.0;
+    for (usize i = 0; i != array_elems(samples); ++i) {
+      check(samples[i] >= 0.0f);
+      check(samples[i] < 1.0f);
+      sum += samples[i];
+    }
+    const f32 avg = (f32)(sum / array_elems(samples));
+
+    // Uniform distribution should average out to 0.5.
+    check_eq_float(avg, 0.5f, 1e-1f);
+
+    rng_destroy(rng);
+  }
+
+  it("can sample unbiased integers in a specific range") {
+    static const usize g_iterations = 10 * 1000;
+    static const u64   g_seed       = 42;
+
+    Allocator* alloc = alloc_bump_create_stack(256);
+    Rng*       rng   = rng_create_xorwow(alloc, g_seed);
+
+    u32 counts[5] = {0};
+    for (usize i = 0; i != g_iterations; ++i) {
+      const u32 val = rng_sample_range_u32(rng, 10, 15);
+      check(val >= 10);
+      check(val < 15);
+      ++counts[val - 10];
+    }
+    for (usize i = 0; i != array_elems(counts); ++i) {
+      // Uniform distribution; each of the 5 values should occur roughly 1 in 5 times.
+      check_eq_float(counts[i] / (f32)g_iterations, 0.2f, 1e-2f);
+    }
+
+    rng_destroy(rng);
+  }
+
   it("returns consistent sample results using xorwow with a fixed seed") {
     Allocator* alloc = alloc_bump_create_stack(256);
 
@@ -21,6 +21,12 @@ static TestElem* test_search_binary(const TestElem* begin, const TestElem* end,
       begin, end, TestElem, compare_testelem, mem_struct(TestElem, .key = key).ptr);
 }
 
+static TestElem*
+test_search_binary_branchless(const TestElem* begin, const TestElem* end, const i32 key) {
+  return search_binary_branchless_t(
+      begin, end, TestElem, compare_testelem, mem_struct(TestElem, .key = key).ptr);
+}
+
 static TestElem*
 test_search_binary_greater(const TestElem* begin, const TestElem* end, const i32 key) {
   return search_binary_greater_t(
@@ -95,6 +101,125 @@ spec(search) {
     check(found == null);
   }
 
+  it("can find elements in ordered data without branching") {
+    const TestElem data[] = {
+        {.key = -42, .value = string_lit("A")},
+        {.key = 2, .value = string_lit("B")},
+        {.key = 8, .value = string_lit("C")},
+        {.key = 9, .value = string_lit("D")},
+        {.key = 12, .value = string_lit("E")},
+        {.key = 60, .value = string_lit("F")},
+        {.key = 256, .value = string_lit("G")},
+    };
+
+    const TestElem* found = null;
+
+    array_for_t(data, TestElem, elem) {
+      found = test_search_binary_branchless(data, data + array_elems(data), elem->key);
+      check_require(found != null);
+      check_eq_string(found->value, elem->value);
+    }
+
+    found = test_search_binary_branchless(data, data + array_elems(data), 10);
+    check(found == null);
+
+    found = test_search_binary_branchless(data, data + array_elems(data), -1000);
+    check(found == null);
+
+    found = test_search_binary_branchless(data, data + array_elems(data), 1000);
+    check(found == null);
+
+    // NOTE: Test an empty collection.
+    found = test_search_binary_branchless(data, data, 1);
+    check(found == null);
+  }
+
+  it("can find many elements in a single pass") {
+    const TestElem data[] = {
+        {.key = -42, .value = string_lit("A")},
+        {.key = 2, .value = string_lit("B")},
+        {.key = 8, .value = string_lit("C")},
+        {.key = 9, .value = string_lit("D")},
+        {.key = 12, .value = string_lit("E")},
+        {.key = 60, .value = string_lit("F")},
+        {.key = 256, .value = string_lit("G")},
+    };
+    const TestElem targets[] = {
+        {.key = -1000},
+        {.key = -42},
+        {.key = 2},
+        {.key = 2},
+        {.key = 10},
+        {.key = 60},
+        {.key = 1000},
+    };
+
+    void* out[array_elems(targets)];
+    search_binary_many_t(
+        data, data + array_elems(data), TestElem, compare_testelem, targets, array_elems(targets),
+        out);
+
+    check(out[0] == null); // Smaller then all elements.
+    check_require(out[1] != null);
+    check_eq_string(((const TestElem*)out[1])->value, string_lit("A"));
+    check_require(out[2] != null);
+    check_eq_string(((const TestElem*)out[2])->value, string_lit("B"));
+    check(out[3] == out[2]); // Duplicate target.
+    check(out[4] == null);   // Not present in the data.
+    check_require(out[5] != null);
+    check_eq_string(((const TestElem*)out[5])->value, string_lit("F"));
+    check(out[6] == null); // Greater then all elements.
+  }
+
+  it("can find elements in eytzinger ordered data") {
+    const TestElem data[] = {
+        {.key = -42, .value = string_lit("A")},
+        {.key = 2, .value = string_lit("B")},
+        {.key = 8, .value = string_lit("C")},
+        {.key = 9, .value = string_lit("D")},
+        {.key = 12, .value = string_lit("E")},
+        {.key = 60, .value = string_lit("F")},
+        {.key = 256, .value = string_lit("G")},
+    };
+
+    TestElem eytzinger[array_elems(data)];
+    search_eytzinger_build_t(data, data + array_elems(data), TestElem, eytzinger);
+
+    const TestElem* found = null;
+
+    array_for_t(data, TestElem, elem) {
+      found = search_eytzinger_t(
+          eytzinger,
+          eytzinger + array_elems(eytzinger),
+          TestElem,
+          compare_testelem,
+          mem_struct(TestElem, .key = elem->key).ptr);
+      check_require(found != null);
+      check_eq_string(found->value, elem->value);
+    }
+
+    found = search_eytzinger_t(
+        eytzinger,
+        eytzinger + array_elems(eytzinger),
+        TestElem,
+        compare_testelem,
+        mem_struct(TestElem, .key = 10).ptr);
+    check(found == null);
+
+    found = search_eytzinger_t(
+        eytzinger,
+        eytzinger + array_elems(eytzinger),
+        TestElem,
+        compare_testelem,
+        mem_struct(TestElem, .key = 1000).ptr);
+    check(found == null);
+
+    // NOTE: Test an empty collection.
+    found = search_eytzinger_t(
+        eytzinger, eytzinger, TestElem, compare_testelem, mem_struct(TestElem, .key = 1).ptr);
+    check(found == null);
+  }
+
   it("can find greater elements in ordered data") {
     const TestElem data[] = {
         {.key = -42, .value = string_lit("A")},
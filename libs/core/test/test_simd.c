@@ -40,6 +40,13 @@ spec(simd) {
     check_eq_float(simd_vec_x(simd_vec_max_comp3(simd_vec_set(42, -1, 4, 6))), 42, 1e-8f);
   }
 
+  it("can compute the component-wise u8 min / max") {
+    const SimdVec a = simd_vec_broadcast_u32(0x00FF2004);
+    const SimdVec b = simd_vec_broadcast_u32(0x10802108);
+    check_eq_int((u32)simd_vec_u64(simd_vec_min_u8(a, b)), 0x00802004);
+    check_eq_int((u32)simd_vec_u64(simd_vec_max_u8(a, b)), 0x10FF2108);
+  }
+
   it("can convert f32 to f16") {
     struct {
       ALIGNAS(16) f32 in[4];
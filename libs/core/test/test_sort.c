@@ -1,5 +1,8 @@
+#include "check/bench.h"
 #include "check/spec.h"
+#include "core/alloc.h"
 #include "core/array.h"
+#include "core/rng.h"
 #include "core/sort.h"
 
 static i8 test_sort_i32_index_compare(const void* ctx, const usize a, const usize b) {
@@ -129,4 +132,51 @@ spec(sort) {
       check(*itr > *prev);
     }
   }
+
+  it("can radix sort u32 keys") {
+    enum { KeyCount = 2048 };
+    u32* keys = alloc_array_t(g_allocScratch, u32, KeyCount);
+    for (u32 i = 0; i != KeyCount; ++i) {
+      keys[i] = rng_sample_u32(g_rng);
+    }
+    sort_radixsort_u32(keys, keys + KeyCount);
+
+    for (u32 i = 1; i != KeyCount; ++i) {
+      check(keys[i - 1] <= keys[i]);
+    }
+  }
+
+  it("benchmarks sorting u32 keys") {
+    enum { KeyCount = 4096 };
+    u32* source = alloc_array_t(g_allocScratch, u32, KeyCount);
+    u32* keys   = alloc_array_t(g_allocScratch, u32, KeyCount);
+    for (u32 i = 0; i != KeyCount; ++i) {
+      source[i] = rng_sample_u32(g_rng);
+    }
+    const Mem sourceMem = mem_create(source, sizeof(u32) * KeyCount);
+    const Mem keysMem   = mem_create(keys, sizeof(u32) * KeyCount);
+
+    bench("quicksort-u32-4096") {
+      mem_cpy(keysMem, sourceMem);
+      sort_quicksort_t(keys, keys + KeyCount, u32, compare_u32);
+    }
+
+    bench("radixsort-u32-4096") {
+      mem_cpy(keysMem, sourceMem);
+      sort_radixsort_u32(keys, keys + KeyCount);
+    }
+  }
+
+  it("can radix sort u64 keys") {
+    enum { KeyCount = 2048 };
+    u64* keys = alloc_array_t(g_allocScratch, u64, KeyCount);
+    for (u32 i = 0; i != KeyCount; ++i) {
+      keys[i] = (u64)rng_sample_u32(g_rng) << 32 | rng_sample_u32(g_rng);
+    }
+    sort_radixsort_u64(keys, keys + KeyCount);
+
+    for (u32 i = 1; i != KeyCount; ++i) {
+      check(keys[i - 1] <= keys[i]);
+    }
+  }
 }
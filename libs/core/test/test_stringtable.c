@@ -1,6 +1,20 @@
 #include "check/spec.h"
 #include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
+
+static void test_stringtable_add_lookup(void* data) {
+  StringTable* table = data;
+  for (u32 i = 0; i != 1000; ++i) {
+    const String     str  = fmt_write_scratch("Concurrent String {}", fmt_int(i));
+    const StringHash hash = stringtable_add(table, str);
+    if (!string_eq(stringtable_lookup(table, hash), str)) {
+      diag_crash_msg("Test 'test_stringtable_add_lookup' failed");
+    }
+  }
+}
 
 spec(stringtable) {
   StringTable* table;
@@ -36,6 +50,38 @@ spec(stringtable) {
     }
   }
 
+  it("can store enough strings to grow the table") {
+    const u32 count = 8192;
+
+    // Add all strings.
+    for (u32 i = 0; i != count; ++i) {
+      const String str = fmt_write_scratch("My String {}", fmt_int(i));
+      stringtable_add(table, str);
+    }
+
+    check_eq_int(stringtable_count(table), count);
+
+    // Retrieve all strings.
+    for (u32 i = 0; i != count; ++i) {
+      const String     str  = fmt_write_scratch("My String {}", fmt_int(i));
+      const StringHash hash = string_hash(str);
+      check_eq_string(stringtable_lookup(table, hash), str);
+    }
+  }
+
+  it("can add and lookup strings from multiple threads") {
+    ThreadHandle threads[4];
+    for (u32 i = 0; i != array_elems(threads); ++i) {
+      threads[i] = thread_start(
+          test_stringtable_add_lookup, table, string_lit("volo_test"), ThreadPriority_Normal);
+    }
+    for (u32 i = 0; i != array_elems(threads); ++i) {
+      thread_join(threads[i]);
+    }
+
+    check_eq_int(stringtable_count(table), 1000);
+  }
+
   it("can intern strings") {
     const String str      = string_lit("Hello World");
     const String interned = stringtable_intern(table, str);
@@ -109,6 +109,14 @@ spec(thread) {
     thread_join(exec);
   }
 
+  it("queries the cpu topology") {
+    check(g_threadTopology.cpuCount > 0);
+    check(g_threadTopology.cpuCount <= thread_topology_max_cpus);
+    check_eq_int(
+        g_threadTopology.performanceCount + g_threadTopology.efficiencyCount,
+        g_threadTopology.cpuCount);
+  }
+
   /**
    * TODO: Skipped for now as it can be a bit flaky on slow machines due to timing requirements.
    */
@@ -111,4 +111,30 @@ spec(utf8) {
       check_eq_int(result, data[i].expected);
     }
   }
+
+  it("can bulk-decode codepoints from utf8") {
+    const String str = string_lit("This is a longer piece of ascii text, Привет, мир, and more!");
+
+    Unicode cps[128];
+    usize   count;
+    const String remaining = utf8_cp_read_many(str, cps, array_elems(cps), &count);
+
+    check_eq_string(remaining, string_empty);
+    check_eq_int(count, utf8_cp_count(str));
+    check_eq_int(cps[0], 'T');
+    check_eq_int(cps[38], 0x41F); // 'П'.
+    check_eq_int(cps[count - 1], '!');
+  }
+
+  it("can bulk-decode codepoints up to the output capacity") {
+    const String str = string_lit("abcdefghijklmnopqrstuvwxyz");
+
+    Unicode cps[10];
+    usize   count;
+    const String remaining = utf8_cp_read_many(str, cps, array_elems(cps), &count);
+
+    check_eq_int(count, 10);
+    check_eq_string(remaining, string_lit("klmnopqrstuvwxyz"));
+    check_eq_int(cps[9], 'j');
+  }
 }
@@ -20,4 +20,22 @@ spec(zlib) {
     check_eq_string(remaining, string_empty);
     check_eq_string(dynstring_view(&outputBuffer), string_lit("Hello World!\n"));
   }
+
+  it("can round-trip encoded data") {
+    const String data = string_lit("Hello World, Hello World, Hello World!\n");
+
+    Mem       encodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte, 1);
+    DynString encodedBuffer = dynstring_create_over(encodedMem);
+    zlib_encode(data, &encodedBuffer);
+
+    Mem       decodedMem    = alloc_alloc(g_allocScratch, usize_kibibyte, 1);
+    DynString decodedBuffer = dynstring_create_over(decodedMem);
+
+    ZlibError    err;
+    const String remaining = zlib_decode(dynstring_view(&encodedBuffer), &decodedBuffer, &err);
+
+    check_eq_int(err, ZlibError_None);
+    check_eq_string(remaining, string_empty);
+    check_eq_string(dynstring_view(&decodedBuffer), data);
+  }
 }
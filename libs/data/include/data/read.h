@@ -51,6 +51,10 @@ typedef String (*DataReader)(const DataReg*, String, Allocator*, DataMeta, Mem,
 /**
  * Read a data value from a json string.
  * NOTE: Data is left uninitialized in case of an error (does not require cleanup by the caller).
+ * NOTE: Json is the development / authoring path; shipped data should use the binary form
+ * ('data_read_bin()' / 'data_write_bin()'). The asset system does this automatically: json sources
+ * are converted to binary by the cache and the packer so only the first (development) load pays
+ * the json parse and validation cost.
  *
  * Returns the remaining input.
  * The result is written to the given data memory.
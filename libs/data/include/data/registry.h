@@ -25,6 +25,8 @@ typedef enum {
   DataFlags_NotEmpty       = 1 << 1,
   DataFlags_Intern         = 1 << 2, // Intern the string in the global string-table.
   DataFlags_ExternalMemory = 1 << 3, // Support external allocations on this memory type.
+                                     // Enables zero-copy binary reads: the blob is padded so the
+                                     // memory can be returned as a view into the (mapped) input.
   DataFlags_InlineField    = 1 << 4, // Inline in parent if this is the only field.
   DataFlags_Sort           = 1 << 5, // The container should remain sorted.
   DataFlags_StringRequired = 1 << 6, // String is required for a StringHash (even for non-dev).
@@ -1,4 +1,5 @@
 #include "core/diag.h"
+#include "core/init.h"
 #include "core/thread.h"
 #include "data/init.h"
 
@@ -12,7 +13,9 @@ void data_init(void) {
   if (!g_initalized) {
     g_initalized = true;
 
+    core_init_phase_begin(string_lit("data"));
     data_reg_global_init();
+    core_init_phase_end();
   }
 }
 
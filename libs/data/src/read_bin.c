@@ -8,6 +8,14 @@
 
 #include "registry.h"
 
+/**
+ * Values are copied out of the input into freshly allocated structures, with one exception:
+ * 'DataMem' fields flagged 'DataFlags_ExternalMemory' are written with alignment padding and are
+ * returned as views directly into the input when the input base is sufficiently aligned (for
+ * example a memory-mapped pack region; pack entries are aligned to 'data_type_mem_align_max').
+ * The caller is then responsible for keeping the input alive for the lifetime of the value.
+ */
+
 #define VOLO_DATA_VALIDATE_CHECKSUMS 0
 
 static const String g_dataBinMagic = string_static("VOLO");
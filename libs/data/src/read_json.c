@@ -907,8 +907,11 @@ String data_read_json(
   JsonDoc* doc         = json_create(g_allocHeap, 512);
   DynArray allocations = dynarray_create_t(g_allocHeap, Mem, 64);
 
+  // NOTE: String aliasing is safe as the document never outlives the input text.
+  const JsonReadFlags jsonFlags = JsonReadFlags_HashOnlyFieldNames | JsonReadFlags_AliasStrings;
+
   JsonResult   jsonRes;
-  const String rem = json_read(doc, input, JsonReadFlags_HashOnlyFieldNames, &jsonRes);
+  const String rem = json_read(doc, input, jsonFlags, &jsonRes);
   if (jsonRes.type != JsonResultType_Success) {
     *res = result_fail(
         DataReadError_Malformed,
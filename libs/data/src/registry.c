@@ -2,6 +2,7 @@
 #include "core/bits.h"
 #include "core/bitset.h"
 #include "core/diag.h"
+#include "core/thread.h"
 #include "data/registry.h"
 
 #include "registry.h"
@@ -214,6 +215,100 @@ usize data_meta_align(const DataReg* reg, const DataMeta meta) {
   diag_crash();
 }
 
+/**
+ * Reset the cached triviality of all declarations; used when a registration mutates a type (which
+ * can affect the triviality of any type that (indirectly) contains it).
+ * NOTE: Registration is not thread-safe so plain stores suffice here.
+ */
+static void data_reg_trivial_cache_reset(DataReg* reg) {
+  dynarray_for_t(&reg->types, DataDecl, decl) { decl->trivialCache = 0; }
+}
+
+/**
+ * Triviality of structs / unions requires walking the (potentially deeply nested) declarations;
+ * cache the answer on the declaration so the serialization walkers don't re-walk the type tree on
+ * every query. Atomics are used as queries can race from parallel loads; both sides compute the
+ * same value so the race is benign.
+ */
+static bool data_decl_trivial(const DataReg* reg, const DataDecl* decl) {
+  i32* cache  = (i32*)&decl->trivialCache;
+  i32  cached = thread_atomic_load_i32(cache);
+  if (!cached) {
+    cached = 1;
+    switch (decl->kind) {
+    case DataKind_Struct: {
+      dynarray_for_t(&decl->val_struct.fields, DataDeclField, fieldDecl) {
+        if (!data_meta_trivial(reg, fieldDecl->meta)) {
+          cached = -1;
+          break;
+        }
+      }
+    } break;
+    case DataKind_Union: {
+      if (data_union_name_type(&decl->val_union) == DataUnionNameType_String) {
+        cached = -1;
+        break;
+      }
+      dynarray_for_t(&decl->val_union.choices, DataDeclChoice, choice) {
+        const bool emptyChoice = choice->meta.type == 0;
+        if (!emptyChoice && !data_meta_trivial(reg, choice->meta)) {
+          cached = -1;
+          break;
+        }
+      }
+    } break;
+    default:
+      diag_crash();
+    }
+    thread_atomic_store_i32(cache, cached);
+  }
+  return cached > 0;
+}
+
+bool data_meta_trivial(const DataReg* reg, const DataMeta meta) {
+  switch (meta.container) {
+  case DataContainer_None:
+  case DataContainer_InlineArray:
+    break; // Determined by the underlying type.
+  case DataContainer_Pointer:
+  case DataContainer_HeapArray:
+  case DataContainer_DynArray:
+    return false; // Requires allocations.
+  }
+  const DataDecl* decl = data_decl(reg, meta.type);
+  switch (decl->kind) {
+  case DataKind_bool:
+  case DataKind_i8:
+  case DataKind_i16:
+  case DataKind_i32:
+  case DataKind_i64:
+  case DataKind_u8:
+  case DataKind_u16:
+  case DataKind_u32:
+  case DataKind_u64:
+  case DataKind_f16:
+  case DataKind_f32:
+  case DataKind_f64:
+  case DataKind_TimeDuration:
+  case DataKind_Angle:
+  case DataKind_Enum:
+  case DataKind_StringHash:
+  case DataKind_Opaque:
+    return true;
+  case DataKind_String:
+    return (meta.flags & DataFlags_Intern) != 0; // Interned strings are not owned.
+  case DataKind_DataMem:
+    return false;
+  case DataKind_Struct:
+  case DataKind_Union:
+    return data_decl_trivial(reg, decl);
+  case DataKind_Invalid:
+  case DataKind_Count:
+    break;
+  }
+  diag_crash();
+}
+
 DataType data_declare(DataReg* reg, const String name) {
   diag_assert_msg(name.size, "Type name cannot be empty");
   return data_type_declare(reg, name);
@@ -278,6 +373,8 @@ void data_reg_field(
    * For structs without holes we can skip the mem-set during binary data reading.
    */
   parentDecl->val_struct.hasHole = data_struct_has_hole(reg, parentDecl);
+
+  data_reg_trivial_cache_reset(reg);
 }
 
 DataType data_reg_union(
@@ -315,6 +412,8 @@ void data_reg_union_name(
 
   parentDecl->val_union.nameType   = nameType;
   parentDecl->val_union.nameOffset = nameOffset;
+
+  data_reg_trivial_cache_reset(reg);
 }
 
 void data_reg_choice(
@@ -346,6 +445,8 @@ void data_reg_choice(
       .offset = offset,
       .meta   = meta,
   };
+
+  data_reg_trivial_cache_reset(reg);
 }
 
 DataType data_reg_enum(DataReg* reg, const String name, const bool multi) {
@@ -47,9 +47,10 @@ typedef struct {
   DataId         id;
   DataKind       kind;
   usize          size, align;
-  String         comment;    // Optional.
-  DataNormalizer normalizer; // Optional.
-  CompareFunc    compare;    // Optional.
+  String         comment;      // Optional.
+  DataNormalizer normalizer;   // Optional.
+  CompareFunc    compare;      // Optional.
+  i32            trivialCache; // 0: unknown, 1: trivial, -1: non-trivial. Lazily computed.
   union {
     DataDeclStruct val_struct;
     DataDeclUnion  val_union;
@@ -70,6 +71,12 @@ void data_reg_global_teardown(void);
  */
 DataMeta data_meta_base(DataMeta);
 
+/**
+ * Check if values of the given meta are trivial: a bitwise copy clones them and destroying them
+ * requires no work (the value owns no allocations).
+ */
+bool data_meta_trivial(const DataReg*, DataMeta);
+
 /**
  * Lookup a declaration for a type.
  */
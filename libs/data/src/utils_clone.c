@@ -200,6 +200,11 @@ static void data_clone_heap_array(const CloneCtx* ctx) {
   HeapArray* newArray    = mem_as_t(ctx->clone, HeapArray);
   *newArray              = (HeapArray){.values = newArrayMem.ptr, .count = count};
 
+  if (data_meta_trivial(ctx->reg, data_meta_base(ctx->meta))) {
+    mem_cpy(newArrayMem, mem_create(originalArray->values, decl->size * count));
+    return;
+  }
+
   for (usize i = 0; i != count; ++i) {
     const CloneCtx elemCtx = {
         .reg      = ctx->reg,
@@ -221,6 +226,12 @@ static void data_clone_dynarray(const CloneCtx* ctx) {
 
   dynarray_resize(newArray, originalArray->size);
 
+  if (originalArray->size && data_meta_trivial(ctx->reg, data_meta_base(ctx->meta))) {
+    const usize count = originalArray->size;
+    mem_cpy(dynarray_at(newArray, 0, count), dynarray_at(originalArray, 0, count));
+    return;
+  }
+
   for (usize i = 0; i != originalArray->size; ++i) {
     const CloneCtx elemCtx = {
         .reg      = ctx->reg,
@@ -234,6 +245,10 @@ static void data_clone_dynarray(const CloneCtx* ctx) {
 }
 
 static void data_clone_internal(const CloneCtx* ctx) {
+  if (data_meta_trivial(ctx->reg, ctx->meta)) {
+    mem_cpy(ctx->clone, ctx->original); // Value owns no allocations; a bitwise copy clones it.
+    return;
+  }
   switch (ctx->meta.container) {
   case DataContainer_None:
     data_clone_single(ctx);
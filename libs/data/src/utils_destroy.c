@@ -12,76 +12,6 @@ typedef struct {
   Mem            data;
 } DestroyCtx;
 
-static bool data_destroy_needed(const DataReg*, DataMeta);
-
-static bool data_destroy_needed_single(const DataReg* reg, const DataMeta meta) {
-  const DataDecl* decl = data_decl(reg, meta.type);
-  switch (decl->kind) {
-  case DataKind_bool:
-  case DataKind_i8:
-  case DataKind_i16:
-  case DataKind_i32:
-  case DataKind_i64:
-  case DataKind_u8:
-  case DataKind_u16:
-  case DataKind_u32:
-  case DataKind_u64:
-  case DataKind_f16:
-  case DataKind_f32:
-  case DataKind_f64:
-  case DataKind_TimeDuration:
-  case DataKind_Angle:
-  case DataKind_Enum:
-  case DataKind_StringHash:
-  case DataKind_Opaque:
-    return false;
-  case DataKind_String:
-    return (meta.flags & DataFlags_Intern) == 0;
-  case DataKind_DataMem:
-    return true;
-  case DataKind_Struct: {
-    dynarray_for_t(&decl->val_struct.fields, DataDeclField, fieldDecl) {
-      if (data_destroy_needed(reg, fieldDecl->meta)) {
-        return true;
-      }
-    }
-    return false;
-  }
-  case DataKind_Union: {
-    if (data_union_name_type(&decl->val_union) == DataUnionNameType_String) {
-      return true;
-    }
-    dynarray_for_t(&decl->val_union.choices, DataDeclChoice, choice) {
-      const bool emptyChoice = choice->meta.type == 0;
-      if (emptyChoice) {
-        continue;
-      }
-      if (data_destroy_needed(reg, choice->meta)) {
-        return true;
-      }
-    }
-    return false;
-  }
-  case DataKind_Invalid:
-  case DataKind_Count:
-    break;
-  }
-  diag_crash();
-}
-
-static bool data_destroy_needed(const DataReg* reg, const DataMeta meta) {
-  switch (meta.container) {
-  case DataContainer_None:
-  case DataContainer_InlineArray:
-    return data_destroy_needed_single(reg, meta);
-  case DataContainer_Pointer:
-  case DataContainer_HeapArray:
-  case DataContainer_DynArray:
-    return true;
-  }
-  diag_crash();
-}
-
 static void data_destroy_internal(const DestroyCtx*);
 
 static void data_destroy_string(const DestroyCtx* ctx) {
@@ -204,8 +134,8 @@ static void data_destroy_inline_array(const DestroyCtx* ctx) {
     diag_crash_msg("Unexpected data-size for inline array");
   }
   const DataMeta baseMeta = data_meta_base(ctx->meta);
-  if (!data_destroy_needed(ctx->reg, baseMeta)) {
-    return;
+  if (data_meta_trivial(ctx->reg, baseMeta)) {
+    return; // Elements own no allocations.
   }
   const DataDecl* decl = data_decl(ctx->reg, ctx->meta.type);
   for (u16 i = 0; i != ctx->meta.fixedCount; ++i) {
@@ -226,7 +156,7 @@ static void data_destroy_heap_array(const DestroyCtx* ctx) {
     return;
   }
   const DataMeta baseMeta = data_meta_base(ctx->meta);
-  if (data_destroy_needed(ctx->reg, baseMeta)) {
+  if (!data_meta_trivial(ctx->reg, baseMeta)) {
     for (usize i = 0; i != array->count; ++i) {
       const DestroyCtx elemCtx = {
           .reg   = ctx->reg,
@@ -244,7 +174,7 @@ static void data_destroy_dynarray(const DestroyCtx* ctx) {
   DynArray* array = mem_as_t(ctx->data, DynArray);
 
   const DataMeta baseMeta = data_meta_base(ctx->meta);
-  if (data_destroy_needed(ctx->reg, baseMeta)) {
+  if (!data_meta_trivial(ctx->reg, baseMeta)) {
     for (usize i = 0; i != array->size; ++i) {
       const DestroyCtx elemCtx = {
           .reg   = ctx->reg,
@@ -260,6 +190,9 @@ static void data_destroy_dynarray(const DestroyCtx* ctx) {
 }
 
 static void data_destroy_internal(const DestroyCtx* ctx) {
+  if (data_meta_trivial(ctx->reg, ctx->meta)) {
+    return; // Value owns no allocations.
+  }
   switch (ctx->meta.container) {
   case DataContainer_None:
     data_destroy_single(ctx);
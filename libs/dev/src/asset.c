@@ -3,11 +3,15 @@
 #include "core/array.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
+#include "core/file.h"
+#include "core/path.h"
+#include "core/sentinel.h"
 #include "dev/asset.h"
 #include "dev/panel.h"
 #include "ecs/entity.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
+#include "log/logger.h"
 #include "trace/tracer.h"
 #include "ui/canvas.h"
 #include "ui/layout.h"
@@ -22,6 +26,7 @@
 
 static const String g_tooltipFilter = string_static("Filter assets by identifier or entity.\nSupports glob characters \a.b*\ar and \a.b?\ar (\a.b!\ar prefix to invert).");
 static const String g_tooltipReload = string_static("Request the asset to be reloaded.\nReload is delayed until all systems release the asset and reacquire it.");
+static const String g_tooltipSaveOrder = string_static("Save a load-order manifest (one asset-id per line, ordered by first load).\nCan be fed to the asset packer (\a.b--order\ar flag) to optimize the pack file layout.");
 
 // clang-format on
 
@@ -189,6 +194,63 @@ static void asset_info_query(DevAssetPanelComp* panelComp, EcsWorld* world) {
   trace_end();
 }
 
+typedef struct {
+  u32    order;
+  String id;
+} DevAssetOrderEntry;
+
+static i8 compare_asset_order(const void* a, const void* b) {
+  const DevAssetOrderEntry* entryA = a;
+  const DevAssetOrderEntry* entryB = b;
+
+  return compare_u32(&entryA->order, &entryB->order);
+}
+
+/**
+ * Save a load-order manifest: the identifiers of all loaded assets, one per line, ordered by their
+ * first load. Can be fed to the asset packer to optimize the pack file layout.
+ */
+static void asset_order_save(EcsWorld* world) {
+  DynArray entries = dynarray_create_t(g_allocHeap, DevAssetOrderEntry, 512);
+
+  EcsView* assetView = ecs_world_view_t(world, AssetView);
+  for (EcsIterator* itr = ecs_view_itr(assetView); ecs_view_walk(itr);) {
+    const AssetComp* assetComp = ecs_view_read_t(itr, AssetComp);
+    const u32        order     = asset_load_order(assetComp);
+    if (sentinel_check(order)) {
+      continue; // Asset has never been loaded.
+    }
+    *dynarray_push_t(&entries, DevAssetOrderEntry) = (DevAssetOrderEntry){
+        .order = order,
+        .id    = asset_id(assetComp),
+    };
+  }
+  dynarray_sort(&entries, compare_asset_order);
+
+  DynString manifest = dynstring_create(g_allocHeap, 16 * usize_kibibyte);
+  dynarray_for_t(&entries, DevAssetOrderEntry, entry) {
+    dynstring_append(&manifest, entry->id);
+    dynstring_append_char(&manifest, '\n');
+  }
+
+  const String     path    = path_build_scratch(string_lit("asset-order.txt"));
+  const FileResult fileRes = file_write_to_path_atomic(path, dynstring_view(&manifest));
+  if (fileRes == FileResult_Success) {
+    log_i(
+        "Saved asset load-order manifest",
+        log_param("path", fmt_path(path)),
+        log_param("entries", fmt_int(entries.size)));
+  } else {
+    log_e(
+        "Failed to save asset load-order manifest",
+        log_param("path", fmt_path(path)),
+        log_param("error", fmt_text(file_result_str(fileRes))));
+  }
+
+  dynstring_destroy(&manifest);
+  dynarray_destroy(&entries);
+}
+
 static UiColor asset_info_bg_color(const DevAssetInfo* asset) {
   switch (asset->status) {
   case DevAssetStatus_Idle:
@@ -209,7 +271,8 @@ static UiColor asset_info_bg_color(const DevAssetInfo* asset) {
   diag_crash();
 }
 
-static void asset_options_draw(UiCanvasComp* canvas, DevAssetPanelComp* panelComp) {
+static void
+asset_options_draw(UiCanvasComp* canvas, DevAssetPanelComp* panelComp, EcsWorld* world) {
   ui_layout_push(canvas);
   ui_style_push(canvas);
 
@@ -218,6 +281,7 @@ static void asset_options_draw(UiCanvasComp* canvas, DevAssetPanelComp* panelCom
   ui_table_add_column(&table, UiTableColumn_Fixed, 250);
   ui_table_add_column(&table, UiTableColumn_Fixed, 50);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Flexible, 0);
 
   ui_table_next_row(canvas, &table);
@@ -229,6 +293,10 @@ static void asset_options_draw(UiCanvasComp* canvas, DevAssetPanelComp* panelCom
   ui_label(canvas, string_lit("Sort:"));
   ui_table_next_column(canvas, &table);
   ui_select(canvas, (i32*)&panelComp->sortMode, g_sortModeNames, DevAssetSortMode_Count);
+  ui_table_next_column(canvas, &table);
+  if (ui_button(canvas, .label = string_lit("Save order"), .tooltip = g_tooltipSaveOrder)) {
+    asset_order_save(world);
+  }
 
   const String stats = fmt_write_scratch(
       "Count: {}, Loaded: {}",
@@ -260,7 +328,7 @@ static void asset_panel_draw(UiCanvasComp* canvas, DevAssetPanelComp* panelComp,
   ui_panel_begin(
       canvas, &panelComp->panel, .title = title, .topBarColor = ui_color(100, 0, 0, 192));
 
-  asset_options_draw(canvas, panelComp);
+  asset_options_draw(canvas, panelComp, world);
 
   ui_layout_grow(canvas, UiAlign_BottomCenter, ui_vector(0, -35), UiBase_Absolute, Ui_Y);
   ui_layout_container_push(canvas, UiClip_None, UiLayer_Normal);
@@ -293,16 +361,9 @@ static void asset_panel_draw(UiCanvasComp* canvas, DevAssetPanelComp* panelComp,
   ui_scrollview_begin(canvas, &panelComp->scrollview, UiLayer_Normal, height);
 
   ui_canvas_id_block_next(canvas); // Start the list of assets on its own id block.
-  for (u32 assetIdx = 0; assetIdx != numAssets; ++assetIdx) {
-    const DevAssetInfo*    asset = dynarray_at_t(&panelComp->assets, assetIdx, DevAssetInfo);
-    const f32              y     = ui_table_height(&table, assetIdx);
-    const UiScrollviewCull cull  = ui_scrollview_cull(&panelComp->scrollview, y, table.rowHeight);
-    if (cull == UiScrollviewCull_After) {
-      break;
-    }
-    if (cull == UiScrollviewCull_Before) {
-      continue;
-    }
+  const UiTableRowSpan visible = ui_table_visible_rows(&table, &panelComp->scrollview, numAssets);
+  for (u32 assetIdx = visible.begin; assetIdx != visible.end; ++assetIdx) {
+    const DevAssetInfo* asset = dynarray_at_t(&panelComp->assets, assetIdx, DevAssetInfo);
 
     ui_table_jump_row(canvas, &table, assetIdx);
     ui_table_draw_row_bg(canvas, &table, asset_info_bg_color(asset));
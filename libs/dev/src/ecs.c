@@ -47,6 +47,7 @@ typedef struct {
   EcsArchetypeId id;
   u32            entityCount, chunkCount, entitiesPerChunk;
   usize          size;
+  f32            occupancy; // Fraction of the allocated chunk capacity that is in use.
   BitSet         compMask;
   u32            compCount;
 } DevEcsArchetypeInfo;
@@ -58,7 +59,9 @@ typedef struct {
   u32            viewCount;
   i32            definedOrder; // Configured ordering constraint.
   u16            parallelCount;
+  u16            conflictCount; // Amount of systems this system can never run in parallel with.
   EcsSystemFlags flags : 16;
+  bool           critical; // System lies on the estimated critical path of the frame.
   TimeDuration   duration;
 } DevEcsSysInfo;
 
@@ -122,6 +125,7 @@ typedef enum {
   DevSysSortMode_Name,
   DevSysSortMode_Duration,
   DevSysSortMode_Order,
+  DevSysSortMode_Conflicts,
 
   DevSysSortMode_Count,
 } DevSysSortMode;
@@ -131,6 +135,7 @@ static const String g_sysSortModeNames[] = {
     string_static("Name"),
     string_static("Duration"),
     string_static("Order"),
+    string_static("Conflicts"),
 };
 ASSERT(array_elems(g_sysSortModeNames) == DevSysSortMode_Count, "Incorrect number of names");
 
@@ -142,6 +147,10 @@ ecs_comp_define(DevEcsPanelComp) {
   DevArchSortMode archSortMode;
   DevSysSortMode  sysSortMode;
   bool            freeze, hideEmptyArchetypes;
+  u32             compInfoVersion; // Structure version the component cache was built at.
+  StringHash      compInfoFilter;  // Name filter the component cache was built with.
+  u32             archInfoVersion; // Structure version the archetype cache was built at.
+  bool            archInfoHideEmpty;
   DynArray        components; // DevEcsCompInfo[]
   DynArray        views;      // DevEcsViewInfo[]
   DynArray        archetypes; // DevEcsArchetypeInfo[]
@@ -228,6 +237,13 @@ static i8 sys_compare_info_order(const void* a, const void* b) {
   return comp ? comp : compare_u32(&infoA->id, &infoB->id);
 }
 
+static i8 sys_compare_info_conflicts(const void* a, const void* b) {
+  const DevEcsSysInfo* infoA = a;
+  const DevEcsSysInfo* infoB = b;
+  const i8             comp  = compare_u16_reverse(&infoA->conflictCount, &infoB->conflictCount);
+  return comp ? comp : compare_u32(&infoA->id, &infoB->id);
+}
+
 static void ecs_dump_graph(const JobGraph* graph) {
   const String pathScratch = path_build_scratch(
       path_parent(g_pathExecutable),
@@ -255,22 +271,31 @@ static bool ecs_panel_filter(DevEcsPanelComp* panelComp, const String name) {
 }
 
 static void comp_info_query(DevEcsPanelComp* panelComp, EcsWorld* world) {
-  dynarray_clear(&panelComp->components);
+  // Only re-collect when the archetype structure (or the filter) changed; the stats are stable
+  // in between structural changes and collecting them walks all archetypes per component.
+  const u32        structureVersion = ecs_world_structure_version(world);
+  const StringHash filterHash       = string_hash(dynstring_view(&panelComp->nameFilter));
+  if (panelComp->compInfoVersion != structureVersion || panelComp->compInfoFilter != filterHash) {
+    panelComp->compInfoVersion = structureVersion;
+    panelComp->compInfoFilter  = filterHash;
 
-  const EcsDef* def = ecs_world_def(world);
-  for (EcsCompId id = 0; id != ecs_def_comp_count(def); ++id) {
-    if (!ecs_panel_filter(panelComp, ecs_def_comp_name(def, id))) {
-      continue;
-    }
+    dynarray_clear(&panelComp->components);
 
-    *dynarray_push_t(&panelComp->components, DevEcsCompInfo) = (DevEcsCompInfo){
-        .id            = id,
-        .name          = ecs_def_comp_name(def, id),
-        .size          = (u32)ecs_def_comp_size(def, id),
-        .align         = (u32)ecs_def_comp_align(def, id),
-        .numArchetypes = ecs_world_archetype_count_with_comp(world, id),
-        .numEntities   = ecs_world_entity_count_with_comp(world, id),
-    };
+    const EcsDef* def = ecs_world_def(world);
+    for (EcsCompId id = 0; id != ecs_def_comp_count(def); ++id) {
+      if (!ecs_panel_filter(panelComp, ecs_def_comp_name(def, id))) {
+        continue;
+      }
+
+      *dynarray_push_t(&panelComp->components, DevEcsCompInfo) = (DevEcsCompInfo){
+          .id            = id,
+          .name          = ecs_def_comp_name(def, id),
+          .size          = (u32)ecs_def_comp_size(def, id),
+          .align         = (u32)ecs_def_comp_align(def, id),
+          .numArchetypes = ecs_world_archetype_count_with_comp(world, id),
+          .numEntities   = ecs_world_entity_count_with_comp(world, id),
+      };
+    }
   }
 
   switch (panelComp->compSortMode) {
@@ -491,21 +516,33 @@ static void view_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp
 }
 
 static void arch_info_query(DevEcsPanelComp* panelComp, EcsWorld* world) {
-  if (!panelComp->freeze) {
+  // Only re-collect when the archetype structure changed; the stats are stable in between
+  // structural changes.
+  const u32  structureVersion = ecs_world_structure_version(world);
+  const bool outdated         = panelComp->archInfoVersion != structureVersion ||
+                        panelComp->archInfoHideEmpty != panelComp->hideEmptyArchetypes;
+  if (!panelComp->freeze && outdated) {
+    panelComp->archInfoVersion   = structureVersion;
+    panelComp->archInfoHideEmpty = panelComp->hideEmptyArchetypes;
+
     dynarray_clear(&panelComp->archetypes);
     for (EcsArchetypeId id = 0; id != ecs_world_archetype_count(world); ++id) {
-      if (panelComp->hideEmptyArchetypes && !ecs_world_archetype_entities(world, id)) {
+      const u32 entityCount = ecs_world_archetype_entities(world, id);
+      if (panelComp->hideEmptyArchetypes && !entityCount) {
         continue;
       }
-      const BitSet compMask = ecs_world_component_mask(world, id);
+      const u32    chunkCount = ecs_world_archetype_chunks(world, id);
+      const u32    perChunk   = ecs_world_archetype_entities_per_chunk(world, id);
+      const BitSet compMask   = ecs_world_component_mask(world, id);
       *dynarray_push_t(&panelComp->archetypes, DevEcsArchetypeInfo) = (DevEcsArchetypeInfo){
           .id               = id,
-          .entityCount      = ecs_world_archetype_entities(world, id),
-          .chunkCount       = ecs_world_archetype_chunks(world, id),
-          .entitiesPerChunk = ecs_world_archetype_entities_per_chunk(world, id),
+          .entityCount      = entityCount,
+          .chunkCount       = chunkCount,
+          .entitiesPerChunk = perChunk,
           .size             = ecs_world_archetype_size(world, id),
-          .compMask         = compMask,
-          .compCount        = (u32)bitset_count(compMask),
+          .occupancy = chunkCount ? (f32)entityCount / (f32)(chunkCount * perChunk) : 1.0f,
+          .compMask  = compMask,
+          .compCount = (u32)bitset_count(compMask),
       };
     }
   }
@@ -576,6 +613,7 @@ arch_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp, const EcsD
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Flexible, 0);
 
   ui_table_draw_header(
@@ -587,6 +625,9 @@ arch_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp, const EcsD
           {string_lit("Entities"), string_lit("Amount of entities in this archetype.")},
           {string_lit("Chunks"), string_lit("Amount of chunks in this archetype.")},
           {string_lit("Size"), string_lit("Total size of this archetype.")},
+          {string_lit("Occupancy"),
+           string_lit("Fraction of the allocated chunk capacity that is in use.\n"
+                      "Shown in orange when the archetype is fragmented.")},
           {string_lit("Entities per chunk"), string_lit("Amount of entities per chunk.")},
       });
 
@@ -625,6 +666,15 @@ arch_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp, const EcsD
     ui_table_next_column(canvas, &table);
     ui_label(canvas, fmt_write_scratch("{}", fmt_size(archInfo->size)));
     ui_table_next_column(canvas, &table);
+    ui_style_push(canvas);
+    if (archInfo->chunkCount > 1 && archInfo->occupancy < 0.5f) {
+      ui_style_color(canvas, ui_color_orange);
+    }
+    ui_label(
+        canvas,
+        fmt_write_scratch("{}%", fmt_float(archInfo->occupancy * 100.0f, .maxDecDigits = 0)));
+    ui_style_pop(canvas);
+    ui_table_next_column(canvas, &table);
     ui_label(canvas, fmt_write_scratch("{}", fmt_int(archInfo->entitiesPerChunk)));
   }
   ui_canvas_id_block_next(canvas);
@@ -651,7 +701,9 @@ static void sys_info_query(DevEcsPanelComp* panelComp, EcsWorld* world) {
           .views         = ecs_def_system_views(def, id).values,
           .viewCount     = (u32)ecs_def_system_views(def, id).count,
           .parallelCount = ecs_def_system_parallel(def, id),
+          .conflictCount = (u16)ecs_runner_system_conflicts(runner, id, null, 0),
           .flags         = ecs_def_system_flags(def, id),
+          .critical      = ecs_runner_system_critical(runner, id),
           .duration      = ecs_runner_duration_avg(runner, id),
       };
     }
@@ -670,6 +722,9 @@ static void sys_info_query(DevEcsPanelComp* panelComp, EcsWorld* world) {
   case DevSysSortMode_Order:
     dynarray_sort(&panelComp->systems, sys_compare_info_order);
     break;
+  case DevSysSortMode_Conflicts:
+    dynarray_sort(&panelComp->systems, sys_compare_info_conflicts);
+    break;
   case DevSysSortMode_Count:
     break;
   }
@@ -729,6 +784,21 @@ static String sys_views_tooltip_scratch(const EcsDef* ecsDef, const DevEcsSysInf
   return dynstring_view(&str);
 }
 
+static String sys_conflicts_tooltip_scratch(const EcsDef* ecsDef, const DevEcsSysInfo* sysInfo) {
+  const u32    systemCount = ecs_def_system_count(ecsDef);
+  EcsSystemId* conflicts   = alloc_array_t(g_allocScratch, EcsSystemId, systemCount);
+  const u32    count =
+      ecs_runner_system_conflicts(g_ecsRunningRunner, sysInfo->id, conflicts, systemCount);
+
+  DynString str = dynstring_create_over(alloc_alloc(g_allocScratch, 2 * usize_kibibyte, 1));
+  dynstring_append(&str, string_lit("Conflicting systems (can never run in parallel):\n"));
+  for (u32 i = 0; i != count; ++i) {
+    const EcsSystemId id = conflicts[i];
+    fmt_write(&str, "  [{}] {}\n", fmt_int(id), fmt_text(ecs_def_system_name(ecsDef, id)));
+  }
+  return dynstring_view(&str);
+}
+
 static UiColor sys_defined_order_color(const DevEcsSysInfo* sysInfo) {
   if (sysInfo->flags & EcsSystemFlags_ThreadAffinity) {
     return ui_color_teal;
@@ -751,6 +821,7 @@ sys_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp, const EcsDe
   ui_table_add_column(&table, UiTableColumn_Fixed, 75);
   ui_table_add_column(&table, UiTableColumn_Fixed, 75);
   ui_table_add_column(&table, UiTableColumn_Fixed, 75);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 75);
   ui_table_add_column(&table, UiTableColumn_Flexible, 0);
 
   ui_table_draw_header(
@@ -762,7 +833,13 @@ sys_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp, const EcsDe
           {string_lit("Order"), string_lit("Defined system order.")},
           {string_lit("Views"), string_lit("Amount of views the system accesses.")},
           {string_lit("Parallel"), string_lit("Amount of parallel tasks.")},
-          {string_lit("Duration"), string_lit("Last execution duration of this system.")},
+          {string_lit("Conflicts"),
+           string_lit("Amount of systems this system can never run in parallel with.")},
+          {string_lit("Duration"),
+           string_lit("Last execution duration of this system.\n"
+                      "Shown in orange when the system lies on the estimated critical path of the "
+                      "frame (reducing its duration, conflicts or order constraints shortens the "
+                      "frame).")},
       });
 
   const u32 numSystems = (u32)panelComp->systems.size;
@@ -812,7 +889,18 @@ sys_panel_tab_draw(UiCanvasComp* canvas, DevEcsPanelComp* panelComp, const EcsDe
     }
 
     ui_table_next_column(canvas, &table);
+    ui_label(
+        canvas,
+        fmt_write_scratch("{}", fmt_int(sysInfo->conflictCount)),
+        .tooltip = sys_conflicts_tooltip_scratch(ecsDef, sysInfo));
+
+    ui_table_next_column(canvas, &table);
+    ui_style_push(canvas);
+    if (sysInfo->critical) {
+      ui_style_color(canvas, ui_color_orange);
+    }
     ui_label(canvas, fmt_write_scratch("{}", fmt_duration(sysInfo->duration)));
+    ui_style_pop(canvas);
   }
   ui_canvas_id_block_next(canvas);
 
@@ -254,7 +254,7 @@ DevLogSink* dev_log_sink_create(void) {
   DevLogSink* sink = alloc_alloc_t(g_allocHeap, DevLogSink);
 
   *sink = (DevLogSink){
-      .api    = {.write = dev_log_sink_write, .destroy = dev_log_sink_destroy},
+      .api    = {.write = dev_log_sink_write, .destroy = dev_log_sink_destroy, .mask = LogMask_All},
       .buffer = alloc_alloc(g_allocHeap, log_tracker_buffer_size, alignof(DevLogEntry)).ptr,
   };
 
@@ -41,6 +41,7 @@ static const String g_tooltipSync          = string_static("Presentation sync mo
                                                             "- \a.bImmediate\ar: Don't wait for a vblank but immediately output the new image.\n"
                                                             "- \a.bSync\ar: Wait for the next vblank to output the new image.\n");
 static const String g_tooltipScale            = string_static("Render resolution scale.");
+static const String g_tooltipSharpen          = string_static("Sharpening strength; recovers detail when rendering below the output resolution.");
 static const String g_tooltipLimiter          = string_static("Frame frequency limiter (in hz).\n\a.bNote\ar: 0 disables the limiter.");
 static const String g_tooltipFrustumCulling   = string_static("Should objects be culled if their bounds are outside of the view frustum?");
 static const String g_tooltipAmbientMode      = string_static("Controls the ambient draw in the forward pass.\n\n"
@@ -639,6 +640,11 @@ static void rend_settings_tab_draw(
       .step    = 0.05f,
       .tooltip = g_tooltipScale);
 
+  ui_table_next_row(canvas, &table);
+  ui_label(canvas, string_lit("Sharpen"));
+  ui_table_next_column(canvas, &table);
+  ui_slider(canvas, &settings->sharpen, .max = 1.0f, .step = 0.05f, .tooltip = g_tooltipSharpen);
+
   ui_table_next_row(canvas, &table);
   ui_label(canvas, string_lit("Frustum culling"));
   ui_table_next_column(canvas, &table);
@@ -6,7 +6,9 @@
 #include "core/float.h"
 #include "core/format.h"
 #include "core/math.h"
+#include "core/sort.h"
 #include "core/stringtable.h"
+#include "core/thread.h"
 #include "core/version.h"
 #include "data/registry.h"
 #include "dev/hash.h"
@@ -101,6 +103,9 @@ ecs_comp_define(DevStatsGlobalComp) {
   usize fileMappingSize;
   u32   globalStringCount;
 
+  u64          mutexPrevContendedCount;
+  TimeDuration mutexPrevContendedDur;
+
   DevStatPlot* ecsFlushDurPlot; // In microseconds.
 };
 
@@ -239,6 +244,18 @@ static f32 dev_plot_avg(const DevStatPlot* plot) {
   return dev_plot_sum(plot) / (f32)stats_plot_size;
 }
 
+static f32 dev_plot_percentile(const DevStatPlot* plot, const f32 frac) {
+  f32*      sorted    = alloc_array_t(g_allocScratch, f32, stats_plot_size);
+  const Mem sortedMem = mem_create(sorted, sizeof(f32) * stats_plot_size);
+  mem_cpy(sortedMem, mem_create(plot->values, sizeof(f32) * stats_plot_size));
+  sort_quicksort_t(sorted, sorted + stats_plot_size, f32, compare_f32);
+  return sorted[(u32)math_round_nearest_f32(frac * (stats_plot_size - 1))];
+}
+
+static f32 dev_plot_p50(const DevStatPlot* plot) { return dev_plot_percentile(plot, 0.50f); }
+static f32 dev_plot_p95(const DevStatPlot* plot) { return dev_plot_percentile(plot, 0.95f); }
+static f32 dev_plot_p99(const DevStatPlot* plot) { return dev_plot_percentile(plot, 0.99f); }
+
 static TimeDuration dev_plot_max_dur(const DevStatPlot* plot) {
   return (TimeDuration)(dev_plot_max(plot) * (f64)time_microsecond);
 }
@@ -347,6 +364,9 @@ stats_draw_plot_tooltip(UiCanvasComp* c, const DevStatPlot* plot, const PlotValu
     APPEND_PLOT_VAL("Min", dev_plot_min);
     APPEND_PLOT_VAL("Max", dev_plot_max);
     APPEND_PLOT_VAL("Variance", dev_plot_var);
+    APPEND_PLOT_VAL("P50", dev_plot_p50);
+    APPEND_PLOT_VAL("P95", dev_plot_p95);
+    APPEND_PLOT_VAL("P99", dev_plot_p99);
   }
 
   const UiId id = ui_canvas_id_peek(c);
@@ -791,6 +811,12 @@ static void dev_stats_draw_interface(
     stats_draw_val_entry(c, string_lit("GPU (budget)"), fmt_write_scratch("{<8} / {}", fmt_size(rendStats->vramBudgetUsed), fmt_size(rendStats->vramBudgetTotal)));
     stats_draw_val_entry(c, string_lit("File"), fmt_write_scratch("handles: {<3} map: {}", fmt_int(statsGlobal->fileCount), fmt_size(statsGlobal->fileMappingSize)));
     stats_draw_val_entry(c, string_lit("DynLib"), fmt_write_scratch("handles: {<3}", fmt_int(statsGlobal->dynlibCount)));
+
+    const ThreadMutexStats mutexStats      = thread_mutex_stats_query();
+    const i64              mutexDelta      = (i64)(mutexStats.contendedCount - statsGlobal->mutexPrevContendedCount);
+    const TimeDuration     mutexDurDelta   = mutexStats.contendedDur - statsGlobal->mutexPrevContendedDur;
+    const FormatArg        mutexDeltaColor = mutexDelta > 0 ? fmt_ui_color(ui_color_yellow) : fmt_nop();
+    stats_draw_val_entry(c, string_lit("Mutex contention"), fmt_write_scratch("count:  {<7} {}delta: {} ({})\ar", fmt_int(mutexStats.contendedCount), mutexDeltaColor, fmt_int(mutexDelta), fmt_duration(mutexDurDelta)));
     stats_draw_val_entry(c, string_lit("StringTable"), fmt_write_scratch("global: {}", fmt_int(statsGlobal->globalStringCount)));
     stats_draw_val_entry(c, string_lit("Data"), fmt_write_scratch("types: {}", fmt_int(data_type_count(g_dataReg))));
   }
@@ -973,6 +999,10 @@ ecs_system_define(DevStatsUpdateSys) {
   statsGlobal->allocPrevPageCounter    = allocStats.pageCounter;
   statsGlobal->allocPrevHeapCounter    = allocStats.heapCounter;
   statsGlobal->allocPrevPersistCounter = allocStats.persistCounter;
+
+  const ThreadMutexStats mutexStats    = thread_mutex_stats_query();
+  statsGlobal->mutexPrevContendedCount = mutexStats.contendedCount;
+  statsGlobal->mutexPrevContendedDur   = mutexStats.contendedDur;
 }
 
 ecs_module_init(dev_stats_module) {
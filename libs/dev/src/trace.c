@@ -13,6 +13,7 @@
 #include "ecs/world.h"
 #include "jobs/forward.h"
 #include "trace/dump.h"
+#include "trace/sampler.h"
 #include "trace/sink_store.h"
 #include "trace/tracer.h"
 #include "ui/canvas.h"
@@ -30,7 +31,8 @@ static const String g_tooltipFreeze       = string_static("Freeze the data set (
 static const String g_tooltipRefresh      = string_static("Refresh the data set.");
 static const String g_tooltipTrigger      = string_static("Configure the trigger (auto freeze) settings.");
 static const String g_tooltipTriggerPick  = string_static("Trigger on '{}' event.");
-static const String g_tooltipTraceDump    = string_static("Dump performance trace data to disk (in the 'logs' directory).");
+static const String g_tooltipTraceDump    = string_static("Dump performance trace data and a summary report to disk (in the 'logs' directory).");
+static const String g_tooltipSampler      = string_static("Toggle the sampling cpu profiler.\nStopping the capture dumps the stacks to disk (in the 'logs' directory) in a flame-graph friendly format.");
 static const String g_messageNoStoreSink  = string_static("No store trace-sink found.\nNote: Check if the binary was compiled with the 'TRACE' option and not explicitly disabled.");
 
 // clang-format on
@@ -337,6 +339,7 @@ trace_options_draw(UiCanvasComp* c, DevTracePanelComp* panel, const TraceSink* s
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
   ui_table_add_column(&table, UiTableColumn_Fixed, 100);
+  ui_table_add_column(&table, UiTableColumn_Fixed, 100);
 
   ui_table_next_row(c, &table);
 
@@ -377,6 +380,27 @@ trace_options_draw(UiCanvasComp* c, DevTracePanelComp* panel, const TraceSink* s
   ui_table_next_column(c, &table);
   if (ui_button(c, .label = string_lit("Dump"), .tooltip = g_tooltipTraceDump)) {
     trace_dump_eventtrace_to_path_default(sinkStore);
+    trace_dump_report_to_path_default(sinkStore);
+  }
+
+  ui_table_next_column(c, &table);
+  const bool          samplerActive    = trace_sampler_active();
+  const bool          samplerSupported = trace_sampler_supported();
+  const UiWidgetFlags samplerFlags     = samplerSupported ? UiWidget_Default : UiWidget_Disabled;
+  const UiColor       samplerColor =
+      samplerActive ? ui_color(16, 192, 0, 192) : ui_color(32, 32, 32, 192);
+  if (ui_button(
+          c,
+          .label      = string_lit("Sampler"),
+          .tooltip    = g_tooltipSampler,
+          .flags      = samplerFlags,
+          .frameColor = samplerColor)) {
+    if (samplerActive) {
+      trace_dump_sampler_to_path_default();
+      trace_sampler_stop();
+    } else {
+      trace_sampler_start(time_millisecond);
+    }
   }
 
   ui_layout_pop(c);
@@ -109,6 +109,7 @@ i32 ecs_def_system_order(const EcsDef*, EcsSystemId);
 
 /**
  * Retrieve the configured parallel count of a system.
+ * NOTE: A count of 0 indicates an automatic (storage-chunk derived) parallel count.
  *
  * Pre-condition: EcsSystemId is a valid system-id registered to the given EcsDef.
  */
@@ -6,16 +6,17 @@
  * Forward header for the ecs library.
  */
 
-typedef struct sEcsDef      EcsDef;
-typedef struct sEcsDef      EcsDef;
-typedef struct sEcsIterator EcsIterator;
-typedef struct sEcsRunner   EcsRunner;
-typedef struct sEcsView     EcsView;
-typedef struct sEcsWorld    EcsWorld;
-typedef u16                 EcsCompId;
-typedef u16                 EcsModuleId;
-typedef u16                 EcsSystemId;
-typedef u16                 EcsSystemId;
-typedef u16                 EcsViewId;
-typedef u32                 EcsArchetypeId;
-typedef u64                 EcsEntityId;
+typedef struct sEcsDef           EcsDef;
+typedef struct sEcsDef           EcsDef;
+typedef struct sEcsIterator      EcsIterator;
+typedef struct sEcsRunner        EcsRunner;
+typedef struct sEcsView          EcsView;
+typedef struct sEcsWorld         EcsWorld;
+typedef struct sEcsWorldSnapshot EcsWorldSnapshot;
+typedef u16                      EcsCompId;
+typedef u16                      EcsModuleId;
+typedef u16                      EcsSystemId;
+typedef u16                      EcsSystemId;
+typedef u16                      EcsViewId;
+typedef u32                      EcsArchetypeId;
+typedef u64                      EcsEntityId;
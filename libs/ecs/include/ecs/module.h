@@ -50,6 +50,12 @@ typedef enum {
    */
   EcsSystemFlags_UnpredictableCost = 1 << 2,
 
+  /**
+   * This system is latency-critical (for example audio-buffer filling); its tasks are scheduled on
+   * the high-priority lane that job workers always drain first.
+   */
+  EcsSystemFlags_HighPriority = 1 << 3,
+
 } EcsSystemFlags;
 
 typedef enum {
@@ -184,6 +190,14 @@ typedef struct {
 #define ecs_access_maybe_read(_COMP_)   ecs_module_access_maybe_read(_builder, ecs_comp_id(_COMP_))
 #define ecs_access_maybe_write(_COMP_)  ecs_module_access_maybe_write(_builder, ecs_comp_id(_COMP_))
 
+/**
+ * Only iterate entities whose component was recently write-accessed (this tick or the previous
+ * tick). Tracking is at chunk granularity: iterating a chunk through a view with write access
+ * marks the written components of the whole chunk as changed, as does adding the component.
+ * NOTE: Only affects walking the view; jumping to a specific entity ignores this filter.
+ */
+#define ecs_access_changed(_COMP_)      ecs_module_access_changed(_builder, ecs_comp_id(_COMP_))
+
 /**
  * Define a system routine.
  * Should only be used inside compilation-units.
@@ -289,6 +303,28 @@ typedef struct {
 #define ecs_parallel(_SYSTEM_, _PARALLEL_COUNT_)                                                   \
   ecs_module_update_parallel(_builder, ecs_system_id(_SYSTEM_), (_PARALLEL_COUNT_))
 
+/**
+ * Special parallel count: the runner derives the slice count automatically from the amount of
+ * storage chunks in the system's views every time an execution plan is formulated. Useful for
+ * systems that iterate large (and varying) amounts of entities.
+ */
+#define ecs_parallel_auto 0
+
+/**
+ * Declare that the given (EcsEntityId) field of the component references a parent entity.
+ * The world maintains a reverse index over these references which can be queried using
+ * 'ecs_world_children_t()'; this avoids a full view scan to find the entities referencing a parent.
+ * NOTE: Can only be used inside a module-init function, after registering the component.
+ *
+ * Example usage:
+ * ```
+ * ecs_register_comp(AttachmentComp);
+ * ecs_relation(AttachmentComp, target);
+ * ```
+ */
+#define ecs_relation(_COMP_, _FIELD_)                                                              \
+  ecs_module_register_relation(_builder, ecs_comp_id(_COMP_), offsetof(_COMP_, _FIELD_))
+
 // clang-format on
 
 /**
@@ -309,11 +345,13 @@ EcsViewId   ecs_module_register_view(EcsModuleBuilder*, EcsViewId*, const EcsVie
 EcsSystemId ecs_module_register_system(EcsModuleBuilder*, EcsSystemId*, const EcsSystemConfig*);
 void        ecs_module_update_order(EcsModuleBuilder*, EcsSystemId, i32 order);
 void        ecs_module_update_parallel(EcsModuleBuilder*, EcsSystemId, u16 parallelCount);
+void        ecs_module_register_relation(EcsModuleBuilder*, EcsCompId, usize offset);
 
 void ecs_module_view_flags(EcsViewBuilder*, EcsViewFlags);
 void ecs_module_access_with(EcsViewBuilder*, EcsCompId);
 void ecs_module_access_without(EcsViewBuilder*, EcsCompId);
 void ecs_module_access_read(EcsViewBuilder*, EcsCompId);
 void ecs_module_access_write(EcsViewBuilder*, EcsCompId);
+void ecs_module_access_changed(EcsViewBuilder*, EcsCompId);
 void ecs_module_access_maybe_read(EcsViewBuilder*, EcsCompId);
 void ecs_module_access_maybe_write(EcsViewBuilder*, EcsCompId);
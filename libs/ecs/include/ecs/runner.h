@@ -52,6 +52,19 @@ const JobGraph* ecs_runner_graph(const EcsRunner*);
 EcsTaskSet      ecs_runner_task_set(const EcsRunner*, EcsSystemId);
 TimeDuration    ecs_runner_duration_avg(const EcsRunner*, EcsSystemId);
 
+/**
+ * Check if the given system lies on the estimated critical path (longest serial span) of the
+ * execution graph. Critical systems directly determine the frame duration: reducing their cost,
+ * their view conflicts or their order constraints shortens the frame.
+ */
+bool ecs_runner_system_critical(const EcsRunner*, EcsSystemId);
+
+/**
+ * Collect the systems that conflict with the given system (and thus can never run in parallel with
+ * it). Returns the total amount of conflicting systems, 'out' receives up to 'outMax' entries.
+ */
+u32 ecs_runner_system_conflicts(const EcsRunner*, EcsSystemId, EcsSystemId out[], u32 outMax);
+
 /**
  * Check if the given runner is currently running.
  */
@@ -66,6 +66,15 @@ EcsIterator* ecs_view_itr_reset(EcsIterator*); // Cannot be used with stepped it
  */
 EcsIterator* ecs_view_walk(EcsIterator*);
 
+/**
+ * Advance the iterator to the next entity in the given world snapshot.
+ * NOTE: On success it will return the same the iterator pointer, otherwise null.
+ * NOTE: Safe to be called concurrently with mutations on the live world.
+ *
+ * Pre-condition: view does not have write-access to any component.
+ */
+EcsIterator* ecs_view_walk_snapshot(EcsIterator*, const EcsWorldSnapshot*);
+
 /**
  * Jump to a specific entity in the view.
  * NOTE: Returns the same iterator pointer.
@@ -116,6 +116,27 @@ void* ecs_world_add(EcsWorld*, EcsEntityId, EcsCompId, Mem data);
 
 void ecs_world_remove(EcsWorld*, EcsEntityId, EcsCompId);
 
+typedef struct {
+  const EcsEntityId* values;
+  u32                count;
+} EcsWorldChildren;
+
+/**
+ * Retrieve the entities whose component references the given parent entity through its declared
+ * relation field (see 'ecs_relation()').
+ * The index is rebuilt during flush and immutable in between flushes: the returned slice is valid
+ * until the next flush and safe to read from (parallel) systems without declaring view access.
+ * NOTE: Modifications of the current frame (component additions / removals / reference writes)
+ * become visible after the next flush.
+ *
+ * Pre-condition: The component has a relation declared using 'ecs_relation()'.
+ * Pre-condition: !ecs_world_busy() || g_ecsRunningSystem
+ */
+#define ecs_world_children_t(_WORLD_, _ENTITY_, _TYPE_)                                            \
+  ecs_world_children((_WORLD_), (_ENTITY_), ecs_comp_id(_TYPE_))
+
+EcsWorldChildren ecs_world_children(const EcsWorld*, EcsEntityId parent, EcsCompId);
+
 /**
  * Retrieve the identifier of the archetype the given entity belongs to.
  * NOTE: Returns sentinel_u32 if the entity does not currently belong to an archetype (meaning it
@@ -138,6 +159,35 @@ BitSet ecs_world_component_mask(const EcsWorld* world, EcsArchetypeId);
  */
 void ecs_world_flush(EcsWorld*);
 
+/**
+ * Take a snapshot of all component data in the world.
+ * Cheap to take: chunks of component data are shared with the live world and only copied when the
+ * live world is about to modify them (copy-on-write). The snapshot can be read (using
+ * 'ecs_view_walk_snapshot()') concurrently with mutations on the live world, for example to render
+ * from while the next tick is being simulated.
+ * NOTE: Only a single snapshot can be active at a time.
+ * NOTE: Not valid to be called from inside systems.
+ * NOTE: Snapshots are read-only; restoring one wholesale into the live world is deliberately not
+ * supported. Component data is not plain-old-data (components own heap allocations and have
+ * registered destructors) and the snapshot does not capture the entity registry, so an image
+ * restore would resurrect stale pointers. Fast world reloads should instead go through the asset
+ * cache / pack file.
+ *
+ * Release using 'ecs_world_snapshot_release()'.
+ *
+ * Pre-condition: !ecs_world_busy()
+ */
+EcsWorldSnapshot* ecs_world_snapshot_take(EcsWorld*);
+
+/**
+ * Release a snapshot previously taken from this world.
+ * NOTE: Not valid to be called from inside systems.
+ *
+ * Pre-condition: snapshot was taken from the given world.
+ * Pre-condition: !ecs_world_busy()
+ */
+void ecs_world_snapshot_release(EcsWorld*, EcsWorldSnapshot*);
+
 typedef struct {
   u32 entityCount; // Amount of entities that exist in the world.
   u32 archetypeCount, archetypeEmptyCount;
@@ -158,3 +208,10 @@ u32           ecs_world_archetype_entities_per_chunk(const EcsWorld*, EcsArchety
 usize         ecs_world_archetype_size(const EcsWorld*, EcsArchetypeId);
 u32           ecs_world_archetype_chunks(const EcsWorld*, EcsArchetypeId);
 u32           ecs_world_entity_count_with_comp(const EcsWorld*, EcsCompId);
+
+/**
+ * Version that is bumped whenever the archetype structure changes (archetypes being created or
+ * entities entering, leaving or moving between archetypes).
+ * Can be used to cache archetype-level statistics without re-querying them every frame.
+ */
+u32 ecs_world_structure_version(const EcsWorld*);
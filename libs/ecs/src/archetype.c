@@ -1,6 +1,9 @@
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
+#include "core/math.h"
+#include "core/sort.h"
 
 #include "archetype.h"
 
@@ -17,42 +20,78 @@
  * | 1           | { health = 42 }            | { x: 2, y: -34 }             |
  * | 2           | { health = 1337 }          | { x: 1, y: 9 }               |
  * ```
+ * The tail of each chunk additionally holds a change-version stamp (u32) per component, used for
+ * chunk granularity change-detection.
+ *
+ * The component arrays are laid out in descending alignment order (component sizes are guaranteed
+ * to be multiples of their alignment) so no padding is needed between them; this packs tag-heavy
+ * archetypes tighter and thus fits more entities per chunk.
  */
 
 #define ecs_archetype_chunk_size (16 * usize_kibibyte)
-#define ecs_archetype_max_chunks 512
 
 typedef struct {
   u32 chunkIdx;
   u32 indexInChunk;
 } EcsArchetypeLoc;
 
+typedef struct {
+  u16 compIdx; // Index of the component in the archetype (mask order).
+  u16 size, align;
+} EcsArchetypeColumn;
+
+/**
+ * Order columns on descending alignment so they pack without any padding in-between.
+ * Ties are broken on the component index to keep the layout deterministic.
+ */
+static i8 ecs_archetype_compare_column(const void* a, const void* b) {
+  const EcsArchetypeColumn* colA = a;
+  const EcsArchetypeColumn* colB = b;
+  if (colA->align != colB->align) {
+    return colA->align > colB->align ? -1 : 1;
+  }
+  return compare_u16(&colA->compIdx, &colB->compIdx);
+}
+
 static u32 ecs_archetype_entities_per_chunk(const EcsDef* def, BitSet mask) {
   /**
-   * Calculate how much total array space each entity will take + how much padding there will need
-   * to be between the arrays to satisfy the component alignments.
+   * Calculate how much total array space each entity will take. Columns are laid out in descending
+   * alignment order so only the first one can need padding (after the entity-id array).
+   * NOTE: The chunk tail is reserved for the per-component change-version stamps.
    */
   usize entityDataSize = sizeof(EcsEntityId);
-  usize align          = alignof(EcsEntityId);
-  usize padding        = 0;
+  usize maxCompAlign   = alignof(EcsEntityId);
   bitset_for(mask, compId) {
-    const usize compSize  = ecs_def_comp_size(def, (EcsCompId)compId);
-    const usize compAlign = ecs_def_comp_align(def, (EcsCompId)compId);
-    padding += bits_padding(align, compAlign);
-    entityDataSize += compSize;
-    align = compAlign;
+    entityDataSize += ecs_def_comp_size(def, (EcsCompId)compId);
+    maxCompAlign = math_max(maxCompAlign, ecs_def_comp_align(def, (EcsCompId)compId));
   }
-  return (u32)((ecs_archetype_chunk_size - padding) / entityDataSize);
+  const usize padding      = maxCompAlign - alignof(EcsEntityId);
+  const usize versionsSize = sizeof(u32) * bitset_count(mask);
+  return (u32)((ecs_archetype_chunk_size - padding - versionsSize) / entityDataSize);
+}
+
+/**
+ * Retrieve the per-component change-version stamps stored at the tail of the given chunk.
+ */
+static u32* ecs_archetype_chunk_versions(const EcsArchetype* archetype, const u32 chunkIdx) {
+  const usize versionsOffset = ecs_archetype_chunk_size - sizeof(u32) * archetype->compCount;
+  return bits_ptr_offset(archetype->chunks[chunkIdx], versionsOffset);
 }
 
 static void* ecs_archetype_chunk_create(void) {
   return alloc_alloc(g_allocHeap, ecs_archetype_chunk_size, alignof(EcsEntityId)).ptr;
 }
 
-static void ecs_archetype_chunk_destroy(void* chunk) {
+void ecs_archetype_chunk_destroy(void* chunk) {
   alloc_free(g_allocHeap, mem_create(chunk, ecs_archetype_chunk_size));
 }
 
+void* ecs_archetype_chunk_clone(const void* chunk) {
+  void* res = ecs_archetype_chunk_create();
+  mem_cpy(mem_create(res, ecs_archetype_chunk_size), mem_create(chunk, ecs_archetype_chunk_size));
+  return res;
+}
+
 static EcsEntityId* ecs_archetype_entity_ptr(EcsArchetype* archetype, const u32 index) {
   const usize chunkIdx     = index / archetype->entitiesPerChunk;
   const usize indexInChunk = index - (chunkIdx * archetype->entitiesPerChunk);
@@ -143,18 +182,27 @@ EcsArchetype ecs_archetype_create(const EcsDef* def, BitSet mask) {
   u16* compOffsets = alloc_alloc(g_allocHeap, sizeof(u16) * compCount * 2, alignof(u16)).ptr;
   u16* compSizes   = compOffsets + compCount;
 
-  usize offset  = sizeof(EcsEntityId) * entitiesPerChunk;
-  usize compIdx = 0;
+  EcsArchetypeColumn* columns = alloc_array_t(g_allocHeap, EcsArchetypeColumn, compCount);
+  u16                 compIdx = 0;
   bitset_for(mask, compId) {
-    const usize compSize  = ecs_def_comp_size(def, (EcsCompId)compId);
-    const usize compAlign = ecs_def_comp_align(def, (EcsCompId)compId);
-    offset                = bits_align(offset, compAlign);
-    compOffsets[compIdx]  = (u16)offset;
-    compSizes[compIdx]    = (u16)compSize;
-    offset += compSize * entitiesPerChunk;
+    columns[compIdx] = (EcsArchetypeColumn){
+        .compIdx = compIdx,
+        .size    = (u16)ecs_def_comp_size(def, (EcsCompId)compId),
+        .align   = (u16)ecs_def_comp_align(def, (EcsCompId)compId),
+    };
     ++compIdx;
   }
-  diag_assert(offset <= ecs_archetype_chunk_size);
+  sort_quicksort_t(columns, columns + compCount, EcsArchetypeColumn, ecs_archetype_compare_column);
+
+  usize offset = sizeof(EcsEntityId) * entitiesPerChunk;
+  for (u16 i = 0; i != compCount; ++i) {
+    offset                          = bits_align(offset, columns[i].align);
+    compOffsets[columns[i].compIdx] = (u16)offset;
+    compSizes[columns[i].compIdx]   = columns[i].size;
+    offset += columns[i].size * entitiesPerChunk;
+  }
+  diag_assert(offset <= (ecs_archetype_chunk_size - sizeof(u32) * compCount));
+  alloc_free_array_t(g_allocHeap, columns, compCount);
 
   return (EcsArchetype){
       .mask                = alloc_dup(g_allocHeap, mask, ecs_comp_mask_align),
@@ -194,6 +242,10 @@ u32 ecs_archetype_add(EcsArchetype* archetype, const EcsEntityId id) {
       ecs_archetype_report_limit_reached(archetype);
     }
     archetype->chunks[archetype->chunkCount++] = ecs_archetype_chunk_create();
+
+    // Initialize the change-version stamps of the new chunk; zero means 'never written'.
+    u32* versions = ecs_archetype_chunk_versions(archetype, archetype->chunkCount - 1);
+    mem_set(mem_create(versions, sizeof(u32) * archetype->compCount), 0);
   }
   // TODO: Add check to detect overflowing a u32 entity-index.
   const u32 entityIdx                             = (u32)(archetype->entityCount++);
@@ -201,6 +253,39 @@ u32 ecs_archetype_add(EcsArchetype* archetype, const EcsEntityId id) {
   return entityIdx;
 }
 
+u32 ecs_archetype_add_batch(EcsArchetype* archetype, const EcsEntityId* ids, const u32 count) {
+  const u32 firstIndex = (u32)archetype->entityCount;
+
+  // Allocate chunks until there is capacity for the whole batch.
+  while (archetype->entityCount + count > archetype->chunkCount * archetype->entitiesPerChunk) {
+    if (UNLIKELY(archetype->chunkCount >= ecs_archetype_max_chunks)) {
+      ecs_archetype_report_limit_reached(archetype);
+    }
+    archetype->chunks[archetype->chunkCount++] = ecs_archetype_chunk_create();
+
+    // Initialize the change-version stamps of the new chunk; zero means 'never written'.
+    u32* versions = ecs_archetype_chunk_versions(archetype, archetype->chunkCount - 1);
+    mem_set(mem_create(versions, sizeof(u32) * archetype->compCount), 0);
+  }
+
+  // Copy the entity-ids into the chunks, one run per chunk.
+  u32 written = 0;
+  while (written != count) {
+    const EcsArchetypeLoc loc    = ecs_archetype_location(archetype, firstIndex + written);
+    const u32             space  = archetype->entitiesPerChunk - loc.indexInChunk;
+    const u32             runLen = math_min(count - written, space);
+
+    EcsEntityId* dst = ((EcsEntityId*)archetype->chunks[loc.chunkIdx]) + loc.indexInChunk;
+    mem_cpy(
+        mem_create(dst, sizeof(EcsEntityId) * runLen),
+        mem_create(ids + written, sizeof(EcsEntityId) * runLen));
+    written += runLen;
+  }
+
+  archetype->entityCount += count;
+  return firstIndex;
+}
+
 EcsEntityId ecs_archetype_remove(EcsArchetype* archetype, const u32 index) {
   const u32 lastIndex = (u32)archetype->entityCount - 1;
   if (index == lastIndex) {
@@ -277,6 +362,93 @@ void ecs_archetype_itr_jump(EcsArchetype* archetype, EcsIterator* itr, const u32
   ecs_archetype_itr_init_pointers(archetype, itr, ecs_archetype_location(archetype, index));
 }
 
+void ecs_archetype_itr_refresh(EcsArchetype* archetype, EcsIterator* itr, const u32 index) {
+  ecs_archetype_itr_init_pointers(archetype, itr, ecs_archetype_location(archetype, index));
+}
+
+void ecs_archetype_chunk_stamp(
+    EcsArchetype* archetype, const u32 chunkIdx, const BitSet mask, const u32 version) {
+  u32* versions = ecs_archetype_chunk_versions(archetype, chunkIdx);
+  bitset_for(mask, compId) {
+    if (LIKELY(ecs_comp_has(archetype->mask, (EcsCompId)compId))) {
+      versions[ecs_comp_index(archetype->mask, (EcsCompId)compId)] = version;
+    }
+  }
+}
+
+void ecs_archetype_stamp(
+    EcsArchetype* archetype, const u32 index, const BitSet mask, const u32 version) {
+  const EcsArchetypeLoc loc = ecs_archetype_location(archetype, index);
+  ecs_archetype_chunk_stamp(archetype, loc.chunkIdx, mask, version);
+}
+
+void ecs_archetype_stamp_range(
+    EcsArchetype* archetype,
+    const u32     index,
+    const u32     count,
+    const BitSet  mask,
+    const u32     version) {
+  diag_assert(count);
+  const u32 firstChunk = index / archetype->entitiesPerChunk;
+  const u32 lastChunk  = (index + count - 1) / archetype->entitiesPerChunk;
+  for (u32 chunkIdx = firstChunk; chunkIdx != lastChunk + 1; ++chunkIdx) {
+    ecs_archetype_chunk_stamp(archetype, chunkIdx, mask, version);
+  }
+}
+
+bool ecs_archetype_chunk_changed(
+    const EcsArchetype* archetype, const u32 chunkIdx, const BitSet mask, const u32 sinceVersion) {
+  const u32* versions = ecs_archetype_chunk_versions(archetype, chunkIdx);
+  bitset_for(mask, compId) {
+    if (LIKELY(ecs_comp_has(archetype->mask, (EcsCompId)compId))) {
+      if (versions[ecs_comp_index(archetype->mask, (EcsCompId)compId)] >= sinceVersion) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ecs_archetype_copy_across_batch(
+    const BitSet  mask,
+    EcsArchetype* dst,
+    const u32     dstIdx,
+    EcsArchetype* src,
+    const u32     srcIdx,
+    const u32     count) {
+
+  const u16* dstCompOffsets = dst->compOffsetsAndSizes;
+  const u16* dstCompSizes   = dst->compOffsetsAndSizes + dst->compCount;
+
+  const u16* srcCompOffsets = src->compOffsetsAndSizes;
+
+  // Split the batch into runs that do not cross a chunk boundary on either side.
+  u32 copied = 0;
+  while (copied != count) {
+    const EcsArchetypeLoc dstLoc   = ecs_archetype_location(dst, dstIdx + copied);
+    const EcsArchetypeLoc srcLoc   = ecs_archetype_location(src, srcIdx + copied);
+    const u32             dstSpace = dst->entitiesPerChunk - dstLoc.indexInChunk;
+    const u32             srcSpace = src->entitiesPerChunk - srcLoc.indexInChunk;
+    const u32             runLen   = math_min(count - copied, math_min(dstSpace, srcSpace));
+
+    bitset_for(mask, comp) {
+      const u32   dstCompIdx = ecs_comp_index(dst->mask, (EcsCompId)comp);
+      const u32   srcCompIdx = ecs_comp_index(src->mask, (EcsCompId)comp);
+      const usize compSize   = dstCompSizes[dstCompIdx];
+
+      u8* dstChunkData = bits_ptr_offset(dst->chunks[dstLoc.chunkIdx], dstCompOffsets[dstCompIdx]);
+      u8* srcChunkData = bits_ptr_offset(src->chunks[srcLoc.chunkIdx], srcCompOffsets[srcCompIdx]);
+
+      const usize runSize   = compSize * runLen;
+      const Mem   dstRunMem = mem_create(dstChunkData + compSize * dstLoc.indexInChunk, runSize);
+      const Mem   srcRunMem = mem_create(srcChunkData + compSize * srcLoc.indexInChunk, runSize);
+
+      mem_cpy(dstRunMem, srcRunMem);
+    }
+    copied += runLen;
+  }
+}
+
 void ecs_archetype_copy_across(
     const BitSet mask, EcsArchetype* dst, const u32 dstIdx, EcsArchetype* src, const u32 srcIdx) {
 
@@ -13,6 +13,8 @@
 // 64 bytes to fit in a single cacheline on x86.
 #define ecs_archetype_size 64
 
+#define ecs_archetype_max_chunks 512
+
 typedef struct {
   ALIGNAS(ecs_archetype_size) BitSet mask;
   u32    entitiesPerChunk;
@@ -32,8 +34,46 @@ usize        ecs_archetype_total_size(const EcsArchetype*);
 u32          ecs_archetype_add(EcsArchetype*, EcsEntityId);
 EcsEntityId  ecs_archetype_remove(EcsArchetype*, u32 index);
 
+/**
+ * Add a batch of entities at consecutive indices; returns the index of the first added entity.
+ */
+u32 ecs_archetype_add_batch(EcsArchetype*, const EcsEntityId* ids, u32 count);
+
 bool ecs_archetype_itr_walk(EcsArchetype*, EcsIterator*);
 void ecs_archetype_itr_jump(EcsArchetype*, EcsIterator*, u32 index);
 
+/**
+ * Re-initialize the iterator pointers at the given index without affecting the walk state.
+ * Useful after a chunk has been re-allocated (for example due to copy-on-write).
+ */
+void ecs_archetype_itr_refresh(EcsArchetype*, EcsIterator*, u32 index);
+
+/**
+ * Create / destroy raw archetype chunks, useful for sharing chunks with a storage snapshot.
+ */
+void* ecs_archetype_chunk_clone(const void* chunk);
+void  ecs_archetype_chunk_destroy(void* chunk);
+
 void ecs_archetype_copy_across(
     BitSet mask, EcsArchetype* dst, u32 dstIdx, EcsArchetype* src, u32 srcIdx);
+
+/**
+ * Copy the given components for a range of entities at consecutive indices in both archetypes.
+ * Performs a single copy per component per chunk instead of one per component per entity.
+ */
+void ecs_archetype_copy_across_batch(
+    BitSet mask, EcsArchetype* dst, u32 dstIdx, EcsArchetype* src, u32 srcIdx, u32 count);
+
+/**
+ * Stamp the change-versions of the given components, either for a whole chunk or for the chunk
+ * that contains the given entity index.
+ * NOTE: Components in the mask that are not present on the archetype are ignored.
+ */
+void ecs_archetype_chunk_stamp(EcsArchetype*, u32 chunkIdx, BitSet mask, u32 version);
+void ecs_archetype_stamp(EcsArchetype*, u32 index, BitSet mask, u32 version);
+void ecs_archetype_stamp_range(EcsArchetype*, u32 index, u32 count, BitSet mask, u32 version);
+
+/**
+ * Test if any of the given components in the chunk has been stamped at or after 'sinceVersion'.
+ */
+bool ecs_archetype_chunk_changed(const EcsArchetype*, u32 chunkIdx, BitSet mask, u32 sinceVersion);
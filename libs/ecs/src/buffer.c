@@ -2,19 +2,23 @@
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/math.h"
+#include "core/sort.h"
 #include "ecs/entity.h"
+#include "jobs/executor.h"
 
 #include "buffer.h"
 #include "comp.h"
 #include "def.h"
 
 /**
- * Modifications are stored per entity. Entity data is kept sorted so a binary-search can be
- * performed to find the data. At the time of writing this seems like a reasonable space / time
- * tradeoff, but in the future alternatives like hashed lookups could be explored.
+ * Modifications are recorded into per-worker segments, meaning concurrently recording systems only
+ * contend on their own segment lock (uncontended in the common case). At flush time the segments
+ * are collated into a single entity list (sorted on serial for determinism); the recorded
+ * component payloads stay in their segment chunks and are linked (not copied) into per-entity
+ * lists.
  *
- * Component additions are currently stored in a chunked memory allocator with pointers to the next
- * added component (for that same entity) to form an intrusive linked-list.
+ * Component additions are stored in chunked memory allocators with pointers to the next added
+ * component (for that same entity) to form an intrusive linked-list.
  *
  * Added component memory layout:
  * - EcsCompId (2 bytes)
@@ -43,10 +47,35 @@ typedef struct {
   EcsBufferCompData*   compHead; // Head of the linked-list of added components.
 } EcsBufferEntity;
 
-static i8 ecs_buffer_compare_entity(const void* a, const void* b) {
-  const u32 serialA = ecs_entity_id_serial(((const EcsBufferEntity*)a)->id);
-  const u32 serialB = ecs_entity_id_serial(((const EcsBufferEntity*)b)->id);
-  return serialA < serialB ? -1 : serialA > serialB ? 1 : 0;
+typedef enum {
+  EcsBufferOpType_CompAdd,
+  EcsBufferOpType_CompRemove,
+  EcsBufferOpType_EntityReset,
+  EcsBufferOpType_EntityDestroy,
+} EcsBufferOpType;
+
+typedef struct {
+  EcsEntityId        entity;
+  EcsBufferOpType    type;
+  EcsCompId          comp; // Only valid for 'CompAdd' / 'CompRemove' operations.
+  EcsBufferCompData* data; // Only valid for 'CompAdd' operations (null for empty components).
+} EcsBufferOp;
+
+static i8 ecs_buffer_compare_op(const void* a, const void* b) {
+  const EcsBufferOp* opA     = *(const EcsBufferOp* const*)a;
+  const EcsBufferOp* opB     = *(const EcsBufferOp* const*)b;
+  const u32          serialA = ecs_entity_id_serial(opA->entity);
+  const u32          serialB = ecs_entity_id_serial(opB->entity);
+  if (serialA != serialB) {
+    return serialA < serialB ? -1 : 1;
+  }
+  // Keep the recording order for modifications to the same entity within a segment.
+  return opA < opB ? -1 : opA > opB ? 1 : 0;
+}
+
+static EcsBufferSegment* ecs_buffer_segment(EcsBuffer* buffer) {
+  const u32 segmentIndex = g_jobsIsWorker ? (g_jobsWorkerId % ecs_buffer_segment_count) : 0;
+  return &buffer->segments[segmentIndex];
 }
 
 /**
@@ -67,19 +96,6 @@ static BitSet ecs_buffer_mask(EcsBuffer* buffer, const EcsBufferMaskId id) {
   return dynarray_at(&buffer->masks, id, 1);
 }
 
-static EcsBufferEntity* ecs_buffer_entity_get(EcsBuffer* buffer, const EcsEntityId id) {
-  EcsBufferEntity* result = dynarray_find_or_insert_sorted(
-      &buffer->entities, ecs_buffer_compare_entity, mem_struct(EcsBufferEntity, .id = id).ptr);
-
-  if (!result->id) {
-    result->id         = id;
-    result->addMask    = ecs_buffer_mask_add(buffer);
-    result->removeMask = ecs_buffer_mask_add(buffer);
-    result->compHead   = null;
-  }
-  return result;
-}
-
 /**
  * Calculate the required alignment for the 'EcsBufferCompData' header + component payload.
  */
@@ -108,7 +124,10 @@ static Mem ecs_buffer_compdata_payload(
 }
 
 static EcsBufferCompData* ecs_buffer_compdata_add(
-    EcsBuffer* buffer, const EcsCompId compId, const usize compSize, const usize compAlign) {
+    EcsBufferSegment* segment,
+    const EcsCompId   compId,
+    const usize       compSize,
+    const usize       compAlign) {
 
   /**
    * ComponentData layout:
@@ -121,7 +140,7 @@ static EcsBufferCompData* ecs_buffer_compdata_add(
   const usize padding = ecs_buffer_compdata_padding(compAlign);
   const usize size    = bits_align(sizeof(EcsBufferCompData) + padding + compSize, align);
 
-  Mem storage = alloc_alloc(buffer->compDataAllocator, size, align);
+  Mem storage = alloc_alloc(segment->compDataAllocator, size, align);
   diag_assert_msg(mem_valid(storage), "EcsBuffer size limit exceeded");
 
   EcsBufferCompData* res = mem_as_t(storage, EcsBufferCompData);
@@ -130,28 +149,41 @@ static EcsBufferCompData* ecs_buffer_compdata_add(
 }
 
 EcsBuffer ecs_buffer_create(Allocator* alloc, const EcsDef* def) {
-  return (EcsBuffer){
+  EcsBuffer buffer = {
       .def      = def,
       .masks    = dynarray_create(alloc, (u16)ecs_comp_mask_size(def), ecs_comp_mask_align, 256),
       .entities = dynarray_create_t(alloc, EcsBufferEntity, 256),
-      .compDataAllocator =
-          alloc_chunked_create(g_allocHeap, alloc_bump_create, ecs_buffer_compdata_chunk_size),
   };
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    buffer.segments[segmentIdx] = (EcsBufferSegment){
+        .ops = dynarray_create_t(alloc, EcsBufferOp, 64),
+        .compDataAllocator =
+            alloc_chunked_create(g_allocHeap, alloc_bump_create, ecs_buffer_compdata_chunk_size),
+    };
+  }
+  return buffer;
 }
 
 void ecs_buffer_destroy(EcsBuffer* buffer) {
   dynarray_destroy(&buffer->masks);
   dynarray_destroy(&buffer->entities);
-  alloc_chunked_destroy(buffer->compDataAllocator);
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    dynarray_destroy(&buffer->segments[segmentIdx].ops);
+    alloc_chunked_destroy(buffer->segments[segmentIdx].compDataAllocator);
+  }
 }
 
 void ecs_buffer_clear(EcsBuffer* buffer) {
   dynarray_clear(&buffer->masks);
   dynarray_clear(&buffer->entities);
-  alloc_reset(buffer->compDataAllocator);
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    dynarray_clear(&buffer->segments[segmentIdx].ops);
+    alloc_reset(buffer->segments[segmentIdx].compDataAllocator);
+  }
 }
 
 void ecs_buffer_queue_finalize_all(EcsBuffer* buffer, EcsFinalizer* finalizer) {
+  // Additions that have been collated into per-entity lists.
   for (usize i = 0; i != buffer->entities.size; ++i) {
     for (EcsBufferCompData* bufferItr = ecs_buffer_comp_begin(buffer, i); bufferItr;
          bufferItr                    = ecs_buffer_comp_next(bufferItr)) {
@@ -159,57 +191,155 @@ void ecs_buffer_queue_finalize_all(EcsBuffer* buffer, EcsFinalizer* finalizer) {
       ecs_finalizer_push(finalizer, bufferItr->id, compData);
     }
   }
+  // Additions still recorded in the segments (not yet collated).
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    dynarray_for_t(&buffer->segments[segmentIdx].ops, EcsBufferOp, op) {
+      if (op->type == EcsBufferOpType_CompAdd && op->data) {
+        ecs_finalizer_push(finalizer, op->comp, ecs_buffer_comp_data(buffer, op->data).ptr);
+      }
+    }
+  }
 }
 
 void ecs_buffer_reset_entity(EcsBuffer* buffer, const EcsEntityId entityId) {
-  EcsBufferEntity* entity = ecs_buffer_entity_get(buffer, entityId);
-  entity->flags |= EcsBufferEntityFlags_Reset;
+  EcsBufferSegment* segment = ecs_buffer_segment(buffer);
+  thread_spinlock_lock(&segment->lock);
+  {
+    *dynarray_push_t(&segment->ops, EcsBufferOp) = (EcsBufferOp){
+        .entity = entityId,
+        .type   = EcsBufferOpType_EntityReset,
+    };
+  }
+  thread_spinlock_unlock(&segment->lock);
 }
 
 void ecs_buffer_destroy_entity(EcsBuffer* buffer, const EcsEntityId entityId) {
-  EcsBufferEntity* entity = ecs_buffer_entity_get(buffer, entityId);
-  entity->flags |= EcsBufferEntityFlags_Destroy;
+  EcsBufferSegment* segment = ecs_buffer_segment(buffer);
+  thread_spinlock_lock(&segment->lock);
+  {
+    *dynarray_push_t(&segment->ops, EcsBufferOp) = (EcsBufferOp){
+        .entity = entityId,
+        .type   = EcsBufferOpType_EntityDestroy,
+    };
+  }
+  thread_spinlock_unlock(&segment->lock);
 }
 
 void* ecs_buffer_comp_add(
     EcsBuffer* buffer, const EcsEntityId entityId, const EcsCompId compId, const Mem data) {
 
-  EcsBufferEntity* entity   = ecs_buffer_entity_get(buffer, entityId);
-  BitSet           addMask  = ecs_buffer_mask(buffer, entity->addMask);
-  const usize      compSize = ecs_def_comp_size(buffer->def, compId);
+  const usize       compSize = ecs_def_comp_size(buffer->def, compId);
+  EcsBufferSegment* segment  = ecs_buffer_segment(buffer);
+
+  void* result = null;
+  thread_spinlock_lock(&segment->lock);
+  {
+    EcsBufferOp* op = dynarray_push_t(&segment->ops, EcsBufferOp);
+    *op             = (EcsBufferOp){
+                    .entity = entityId,
+                    .type   = EcsBufferOpType_CompAdd,
+                    .comp   = compId,
+    };
+    if (compSize) {
+      const usize compAlign = ecs_def_comp_align(buffer->def, compId);
+      op->data              = ecs_buffer_compdata_add(segment, compId, compSize, compAlign);
+      Mem payload           = ecs_buffer_compdata_payload(op->data, compSize, compAlign);
+      if (data.size) {
+        diag_assert_msg(
+            data.size == payload.size,
+            "Unexpected size {} for component {} (id: {})",
+            fmt_size(data.size),
+            fmt_text(ecs_def_comp_name(buffer->def, compId)),
+            fmt_int(compId));
+        mem_cpy(payload, data);
+      } else {
+        mem_set(payload, 0);
+      }
+      result = payload.ptr;
+    } else {
+      diag_assert(data.size == 0); // There is no need to store payload for empty components.
+    }
+  }
+  thread_spinlock_unlock(&segment->lock);
+  return result;
+}
 
-  bitset_set(addMask, compId);
-  if (!compSize) {
-    diag_assert(data.size == 0);
-    return null; // There is no need to store payload for empty components.
+void ecs_buffer_comp_remove(EcsBuffer* buffer, const EcsEntityId entityId, const EcsCompId compId) {
+  EcsBufferSegment* segment = ecs_buffer_segment(buffer);
+  thread_spinlock_lock(&segment->lock);
+  {
+    *dynarray_push_t(&segment->ops, EcsBufferOp) = (EcsBufferOp){
+        .entity = entityId,
+        .type   = EcsBufferOpType_CompRemove,
+        .comp   = compId,
+    };
   }
+  thread_spinlock_unlock(&segment->lock);
+}
 
-  // Find the last comp-data in the linked-list.
-  EcsBufferCompData** last = &entity->compHead;
-  for (; *last; last = &(*last)->next)
-    ;
+void ecs_buffer_collate(EcsBuffer* buffer) {
+  usize opCount = 0;
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    opCount += buffer->segments[segmentIdx].ops.size;
+  }
+  if (!opCount) {
+    return;
+  }
 
-  const usize compAlign = ecs_def_comp_align(buffer->def, compId);
-  *last                 = ecs_buffer_compdata_add(buffer, compId, compSize, compAlign);
-  Mem payload           = ecs_buffer_compdata_payload(*last, compSize, compAlign);
-  if (data.size) {
-    diag_assert_msg(
-        data.size == payload.size,
-        "Unexpected size {} for component {} (id: {})",
-        fmt_size(data.size),
-        fmt_text(ecs_def_comp_name(buffer->def, compId)),
-        fmt_int(compId));
-    mem_cpy(payload, data);
-  } else {
-    mem_set(payload, 0);
+  // Gather pointers to all recorded operations; the payloads stay in their segment chunks.
+  const usize sortMemSize = sizeof(EcsBufferOp*) * opCount;
+  const Mem   sortMem     = alloc_alloc(g_allocHeap, sortMemSize, alignof(EcsBufferOp*));
+  const EcsBufferOp** ops = sortMem.ptr;
+
+  usize opIndex = 0;
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    dynarray_for_t(&buffer->segments[segmentIdx].ops, EcsBufferOp, op) { ops[opIndex++] = op; }
   }
-  return payload.ptr;
-}
+  sort_quicksort_t(ops, ops + opCount, const EcsBufferOp*, ecs_buffer_compare_op);
 
-void ecs_buffer_comp_remove(EcsBuffer* buffer, const EcsEntityId entityId, const EcsCompId compId) {
-  EcsBufferEntity* entity     = ecs_buffer_entity_get(buffer, entityId);
-  BitSet           removeMask = ecs_buffer_mask(buffer, entity->removeMask);
-  bitset_set(removeMask, compId);
+  /**
+   * Operations are now grouped per entity; build the entity list by appending an entry per group
+   * (the sort guarantees the list ends up sorted on serial) and link the added component-data into
+   * the entity's list instead of copying the payloads.
+   */
+  EcsBufferEntity*    entity = null;
+  EcsBufferCompData** tail   = null;
+  for (opIndex = 0; opIndex != opCount; ++opIndex) {
+    const EcsBufferOp* op = ops[opIndex];
+    if (!entity || entity->id != op->entity) {
+      entity  = dynarray_push_t(&buffer->entities, EcsBufferEntity);
+      *entity = (EcsBufferEntity){
+           .id         = op->entity,
+           .addMask    = ecs_buffer_mask_add(buffer),
+           .removeMask = ecs_buffer_mask_add(buffer),
+      };
+      tail = &entity->compHead;
+    }
+    switch (op->type) {
+    case EcsBufferOpType_CompAdd:
+      bitset_set(ecs_buffer_mask(buffer, entity->addMask), op->comp);
+      if (op->data) {
+        *tail = op->data;
+        tail  = &op->data->next;
+      }
+      break;
+    case EcsBufferOpType_CompRemove:
+      bitset_set(ecs_buffer_mask(buffer, entity->removeMask), op->comp);
+      break;
+    case EcsBufferOpType_EntityReset:
+      entity->flags |= EcsBufferEntityFlags_Reset;
+      break;
+    case EcsBufferOpType_EntityDestroy:
+      entity->flags |= EcsBufferEntityFlags_Destroy;
+      break;
+    }
+  }
+  alloc_free(g_allocHeap, sortMem);
+
+  // The operations are now represented by the entity list; clear them to avoid collating twice.
+  for (u32 segmentIdx = 0; segmentIdx != ecs_buffer_segment_count; ++segmentIdx) {
+    dynarray_clear(&buffer->segments[segmentIdx].ops);
+  }
 }
 
 usize ecs_buffer_count(const EcsBuffer* buffer) { return buffer->entities.size; }
@@ -1,12 +1,19 @@
 #pragma once
 #include "core/bitset.h"
 #include "core/dynarray.h"
+#include "core/thread.h"
 #include "ecs/def.h"
 
 #include "finalizer.h"
 
+#define ecs_buffer_segment_count 8
+
 /**
  * Buffer for storing entity layout modifications to be applied at a later time.
+ *
+ * Modifications are recorded into per-worker segments (synchronized with a per-segment lock that is
+ * uncontended in the common case) and collated into a single sorted entity list at flush time.
+ * Collating, clearing and the per-entity accessors need to be externally synchronized.
  */
 
 typedef enum {
@@ -15,11 +22,18 @@ typedef enum {
   EcsBufferEntityFlags_Destroy = 1 << 1,
 } EcsBufferEntityFlags;
 
+typedef struct {
+  ALIGNAS(64) ThreadSpinLock lock;
+  DynArray   ops; // EcsBufferOp[] (in recording order).
+  Allocator* compDataAllocator;
+} EcsBufferSegment;
+
 typedef struct {
   const EcsDef* def;
   DynArray      masks;    // u8[bits_to_bytes(ecs_def_comp_count(def)) + 1][]
   DynArray      entities; // EcsBufferEntity[] (Sorted on the .id field).
-  Allocator*    compDataAllocator;
+
+  EcsBufferSegment segments[ecs_buffer_segment_count];
 } EcsBuffer;
 
 typedef struct sEcsBufferCompData EcsBufferCompData;
@@ -35,6 +49,13 @@ void  ecs_buffer_destroy_entity(EcsBuffer*, EcsEntityId);
 void* ecs_buffer_comp_add(EcsBuffer*, EcsEntityId, EcsCompId, Mem data);
 void  ecs_buffer_comp_remove(EcsBuffer*, EcsEntityId, EcsCompId);
 
+/**
+ * Collate the modifications recorded in the per-worker segments into a single sorted entity list.
+ * Links the recorded component-data into per-entity lists without copying the payloads.
+ * NOTE: Needs to be called before using the per-entity accessors below.
+ */
+void ecs_buffer_collate(EcsBuffer*);
+
 usize                ecs_buffer_count(const EcsBuffer*);
 EcsEntityId          ecs_buffer_entity(const EcsBuffer*, usize index);
 EcsBufferEntityFlags ecs_buffer_entity_flags(const EcsBuffer*, usize index);
@@ -105,6 +105,21 @@ MAYBE_UNUSED INLINE_HINT static EcsCompId ecs_comp_mask_eq(const BitSet a, const
   return true;
 }
 
+/**
+ * Compute a 64-bit signature of the mask: bit 'i' is set when any component with 'id % 64 == i' is
+ * included. If a mask's signature is not a subset of another mask's signature then the mask itself
+ * cannot be a subset either; useful as a cheap pre-filter before a full 'ecs_comp_mask_all_of()'.
+ * Pre-condition: bits_aligned(mask.size, sizeof(u64))
+ */
+MAYBE_UNUSED INLINE_HINT static u64 ecs_comp_mask_signature(const BitSet mask) {
+  u64        result    = 0;
+  const u64* dwordsEnd = bits_ptr_offset(mask.ptr, mask.size);
+  for (const u64* dword = mask.ptr; dword != dwordsEnd; ++dword) {
+    result |= *dword;
+  }
+  return result;
+}
+
 /**
  * Test if any of the components in the other mask also included in this mask.
  * Pre-condition: mask.size == other.size
@@ -1,5 +1,6 @@
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
 
 #include "comp.h"
@@ -26,29 +27,32 @@ static const EcsSystemDef* ecs_def_system(const EcsDef* def, const EcsSystemId i
   return dynarray_begin_t(&def->systems, EcsSystemDef) + id;
 }
 
+static EcsCompDef* ecs_def_comp_mutable(EcsDef* def, const EcsCompId id) {
+  diag_assert_msg(id < def->components.size, "Invalid component id '{}'", fmt_int(id));
+  return dynarray_begin_t(&def->components, EcsCompDef) + id;
+}
+
 static EcsSystemDef* ecs_def_system_mutable(EcsDef* def, const EcsSystemId id) {
   diag_assert_msg(id < def->systems.size, "Invalid system id '{}'", fmt_int(id));
   return dynarray_begin_t(&def->systems, EcsSystemDef) + id;
 }
 
-MAYBE_UNUSED static const EcsModuleDef*
-ecs_def_module_by_name(const EcsDef* def, const String name) {
-  dynarray_for_t(&def->modules, EcsModuleDef, module) {
-    if (string_eq(module->name, name)) {
-      return module;
-    }
-  }
-  return null;
-}
-
-MAYBE_UNUSED static const EcsCompDef* ecs_def_comp_by_name(const EcsDef* def, const String name) {
-  dynarray_for_t(&def->components, EcsCompDef, comp) {
-    if (string_eq(comp->name, name)) {
-      return comp;
-    }
+#ifndef VOLO_RELEASE
+/**
+ * Track registered names (by hash, kept sorted) so duplicate-name validation is a binary search
+ * instead of scanning all previously registered entries; with many modules those scans are
+ * quadratic and dominated the registration cost of development builds at startup.
+ * Returns false when the name was already registered.
+ */
+static bool ecs_def_name_add(DynArray* nameHashes, const String name) {
+  const StringHash hash = string_hash(name);
+  if (dynarray_search_binary(nameHashes, compare_stringhash, &hash)) {
+    return false; // Duplicate name.
   }
-  return null;
+  *dynarray_insert_sorted_t(nameHashes, StringHash, compare_stringhash, &hash) = hash;
+  return true;
 }
+#endif
 
 EcsDef* ecs_def_create(Allocator* alloc) {
   EcsDef* def = alloc_alloc_t(alloc, EcsDef);
@@ -59,6 +63,10 @@ EcsDef* ecs_def_create(Allocator* alloc) {
              .systems    = dynarray_create_t(alloc, EcsSystemDef, 128),
              .alloc      = alloc,
   };
+#ifndef VOLO_RELEASE
+  def->moduleNameHashes = dynarray_create_t(alloc, StringHash, 64);
+  def->compNameHashes   = dynarray_create_t(alloc, StringHash, 128);
+#endif
   return def;
 }
 
@@ -73,13 +81,22 @@ void ecs_def_destroy(EcsDef* def) {
   dynarray_destroy(&def->views);
   dynarray_destroy(&def->systems);
 
+#ifndef VOLO_RELEASE
+  dynarray_destroy(&def->moduleNameHashes);
+  dynarray_destroy(&def->compNameHashes);
+#endif
+
   alloc_free_t(def->alloc, def);
 }
 
 EcsModuleId ecs_def_register_module(
     EcsDef* def, const String name, const EcsModuleInit initRoutine, const void* initCtx) {
   diag_assert_msg(!(def->flags & EcsDefFlags_Frozen), "Unable to modify a frozen definition");
-  diag_assert_msg(!ecs_def_module_by_name(def, name), "Duplicate module name '{}'", fmt_text(name));
+
+#ifndef VOLO_RELEASE
+  const bool nameUnique = ecs_def_name_add(&def->moduleNameHashes, name);
+  diag_assert_msg(nameUnique, "Duplicate module name '{}'", fmt_text(name));
+#endif
 
   const EcsModuleId id = (EcsModuleId)def->modules.size;
   *dynarray_push_t(&def->modules, EcsModuleDef) =
@@ -157,8 +174,11 @@ bool ecs_def_system_has_access(const EcsDef* def, const EcsSystemId sysId, const
 EcsCompId ecs_def_register_comp(EcsDef* def, const EcsModuleId modId, const EcsCompConfig* cfg) {
 
   diag_assert_msg(!(def->flags & EcsDefFlags_Frozen), "Unable to modify a frozen definition");
-  diag_assert_msg(
-      !ecs_def_comp_by_name(def, cfg->name), "Duplicate component name '{}'", fmt_text(cfg->name));
+
+#ifndef VOLO_RELEASE
+  const bool nameUnique = ecs_def_name_add(&def->compNameHashes, cfg->name);
+  diag_assert_msg(nameUnique, "Duplicate component name '{}'", fmt_text(cfg->name));
+#endif
   diag_assert_msg(
       bits_ispow2(cfg->align),
       "Component alignment '{}' is not a power-of-two",
@@ -178,13 +198,14 @@ EcsCompId ecs_def_register_comp(EcsDef* def, const EcsModuleId modId, const EcsC
 
   EcsCompId id                                   = (EcsCompId)def->components.size;
   *dynarray_push_t(&def->components, EcsCompDef) = (EcsCompDef){
-      .moduleId      = modId,
-      .name          = cfg->name, // Name is always persistently allocated, no need to copy.
-      .size          = cfg->size,
-      .align         = cfg->align,
-      .destructor    = cfg->destructor,
-      .destructOrder = cfg->destructOrder,
-      .combinator    = cfg->combinator,
+      .moduleId       = modId,
+      .name           = cfg->name, // Name is always persistently allocated, no need to copy.
+      .size           = cfg->size,
+      .align          = cfg->align,
+      .destructor     = cfg->destructor,
+      .destructOrder  = cfg->destructOrder,
+      .combinator     = cfg->combinator,
+      .relationOffset = sentinel_usize,
   };
   return id;
 }
@@ -233,10 +254,21 @@ void ecs_def_update_order(EcsDef* def, const EcsSystemId system, const i32 order
 }
 
 void ecs_def_update_parallel(EcsDef* def, const EcsSystemId system, const u16 parallelCount) {
-  diag_assert_msg(parallelCount, "Parallel count of 0 is not supported");
+  // NOTE: A parallel count of 0 ('ecs_parallel_auto') indicates an automatic (storage-chunk
+  // derived) count.
   ecs_def_system_mutable(def, system)->parallelCount = parallelCount;
 }
 
+void ecs_def_update_relation(EcsDef* def, const EcsCompId comp, const usize offset) {
+  EcsCompDef* compDef = ecs_def_comp_mutable(def, comp);
+  diag_assert_msg(
+      offset + sizeof(EcsEntityId) <= compDef->size,
+      "Relation field at offset '{}' does not fit in component '{}'",
+      fmt_int(offset),
+      fmt_text(compDef->name));
+  compDef->relationOffset = offset;
+}
+
 EcsCompDestructor ecs_def_comp_destructor(const EcsDef* def, const EcsCompId id) {
   return ecs_def_comp(def, id)->destructor;
 }
@@ -249,6 +281,10 @@ EcsCompCombinator ecs_def_comp_combinator(const EcsDef* def, const EcsCompId id)
   return ecs_def_comp(def, id)->combinator;
 }
 
+usize ecs_def_comp_relation(const EcsDef* def, const EcsCompId id) {
+  return ecs_def_comp(def, id)->relationOffset;
+}
+
 void ecs_def_freeze(EcsDef* def) { def->flags |= EcsDefFlags_Frozen; }
 
 void ecs_def_unfreeze(EcsDef* def) { def->flags &= ~EcsDefFlags_Frozen; }
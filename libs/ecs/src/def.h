@@ -9,6 +9,7 @@ typedef struct {
   EcsCompDestructor destructor;
   i32               destructOrder;
   EcsCompCombinator combinator;
+  usize             relationOffset; // Offset of an EcsEntityId reference field, sentinel if none.
 } EcsCompDef;
 
 typedef struct {
@@ -39,6 +40,11 @@ struct sEcsDef {
   DynArray    systems;    // EcsSystemDef[]
   EcsDefFlags flags;
   Allocator*  alloc;
+
+#ifndef VOLO_RELEASE
+  DynArray moduleNameHashes; // StringHash[], sorted. Used for duplicate-name validation.
+  DynArray compNameHashes;   // StringHash[], sorted. Used for duplicate-name validation.
+#endif
 };
 
 EcsCompId   ecs_def_register_comp(EcsDef*, EcsModuleId, const EcsCompConfig*);
@@ -46,10 +52,12 @@ EcsViewId   ecs_def_register_view(EcsDef*, EcsModuleId, const EcsViewConfig*);
 EcsSystemId ecs_def_register_system(EcsDef*, EcsModuleId, const EcsSystemConfig*);
 void        ecs_def_update_order(EcsDef*, EcsSystemId, i32 order);
 void        ecs_def_update_parallel(EcsDef*, EcsSystemId, u16 parallelCount);
+void        ecs_def_update_relation(EcsDef*, EcsCompId, usize offset);
 
 EcsCompDestructor ecs_def_comp_destructor(const EcsDef*, EcsCompId);
 i32               ecs_def_comp_destruct_order(const EcsDef*, EcsCompId);
 EcsCompCombinator ecs_def_comp_combinator(const EcsDef*, EcsCompId);
+usize             ecs_def_comp_relation(const EcsDef*, EcsCompId);
 
 /**
  * Disallow any further modifications to this definition.
@@ -1,5 +1,6 @@
 #include "core/diag.h"
 #include "ecs/entity.h"
+#include "jobs/executor.h"
 
 #include "entity_allocator.h"
 
@@ -8,6 +9,34 @@
 
 ASSERT((ecs_starting_free_indices % 8) == 0, "ecs_starting_free_indices should be byte aligned");
 
+static EntityAllocatorShard* entity_allocator_shard(EntityAllocator* entityAllocator) {
+  const u32 shardIndex = g_jobsIsWorker ? (g_jobsWorkerId % entity_allocator_shard_count) : 0;
+  return &entityAllocator->shards[shardIndex];
+}
+
+/**
+ * Pull a batch of free indices from the central free-list into the given shard.
+ * Pre-condition: shard->lock is held by the current thread.
+ */
+static void entity_allocator_shard_refill(
+    EntityAllocator* entityAllocator, EntityAllocatorShard* shard) {
+  thread_spinlock_lock(&entityAllocator->lock);
+  {
+    while (shard->count != entity_allocator_shard_cache) {
+      const u64 index = dynbitset_next(&entityAllocator->freeIndices, 0);
+      if (sentinel_check(index)) {
+        // No existing free index found; mint a new one at the end.
+        shard->indices[shard->count++] = (u32)entityAllocator->totalIndices++;
+      } else {
+        // Existing index found: Mark it as taken.
+        dynbitset_clear(&entityAllocator->freeIndices, index);
+        shard->indices[shard->count++] = (u32)index;
+      }
+    }
+  }
+  thread_spinlock_unlock(&entityAllocator->lock);
+}
+
 EntityAllocator entity_allocator_create(Allocator* alloc) {
   // Start with 'ecs_starting_free_indices' amount of free indices.
   DynBitSet freeIndices = dynbitset_create(alloc, ecs_starting_free_indices);
@@ -24,25 +53,22 @@ void entity_allocator_destroy(EntityAllocator* entityAllocator) {
 }
 
 EcsEntityId entity_allocator_alloc(EntityAllocator* entityAllocator) {
-  u64 serial, index;
-  thread_spinlock_lock(&entityAllocator->lock);
+  const u64 serial = (u64)thread_atomic_add_i64(&entityAllocator->serialCounter, 1) + 1;
+
+  /**
+   * Take an index from the shard of the current worker; in the common case this only touches the
+   * (uncontended) shard lock, the central free-list is only locked to refill a whole batch.
+   */
+  EntityAllocatorShard* shard = entity_allocator_shard(entityAllocator);
+  u64                   index;
+  thread_spinlock_lock(&shard->lock);
   {
-    // Note: 'thread_spinlock_lock()' includes a general memory barrier, so any writes done by other
-    // 'entity_allocator_alloc' invocations on other threads are flushed.
-
-    serial = ++entityAllocator->serialCounter;
-
-    // Try to find a free index.
-    index = dynbitset_next(&entityAllocator->freeIndices, 0);
-    if (sentinel_check(index)) {
-      // No existing free index found, add one at the end.
-      index = entityAllocator->totalIndices++;
-    } else {
-      // Existing index found: Mark it as taken.
-      dynbitset_clear(&entityAllocator->freeIndices, index);
+    if (UNLIKELY(!shard->count)) {
+      entity_allocator_shard_refill(entityAllocator, shard);
     }
+    index = shard->indices[--shard->count];
   }
-  thread_spinlock_unlock(&entityAllocator->lock);
+  thread_spinlock_unlock(&shard->lock);
 
   diag_assert_msg(index < u32_max, "Entity indices exhausted");
   diag_assert_msg(serial < u32_max, "Entity serials exhausted");
@@ -64,6 +90,21 @@ void entity_allocator_free(EntityAllocator* entityAllocator, const EcsEntityId i
   thread_spinlock_unlock(&entityAllocator->lock);
 }
 
+void entity_allocator_rebalance(EntityAllocator* entityAllocator) {
+  for (u32 i = 0; i != entity_allocator_shard_count; ++i) {
+    EntityAllocatorShard* shard = &entityAllocator->shards[i];
+    thread_spinlock_lock(&shard->lock);
+    if (shard->count) {
+      thread_spinlock_lock(&entityAllocator->lock);
+      while (shard->count) {
+        dynbitset_set(&entityAllocator->freeIndices, shard->indices[--shard->count]);
+      }
+      thread_spinlock_unlock(&entityAllocator->lock);
+    }
+    thread_spinlock_unlock(&shard->lock);
+  }
+}
+
 u32 entity_allocator_count_active(const EntityAllocator* entityAllocator) {
   u32 result;
   thread_spinlock_lock((ThreadSpinLock*)&entityAllocator->lock);
@@ -72,5 +113,13 @@ u32 entity_allocator_count_active(const EntityAllocator* entityAllocator) {
     result                = (u32)(entityAllocator->totalIndices - totalFree);
   }
   thread_spinlock_unlock((ThreadSpinLock*)&entityAllocator->lock);
+
+  // Indices cached in the shards are not allocated; subtract them from the active count.
+  for (u32 i = 0; i != entity_allocator_shard_count; ++i) {
+    EntityAllocatorShard* shard = (EntityAllocatorShard*)&entityAllocator->shards[i];
+    thread_spinlock_lock(&shard->lock);
+    result -= shard->count;
+    thread_spinlock_unlock(&shard->lock);
+  }
   return result;
 }
@@ -3,11 +3,27 @@
 #include "core/thread.h"
 #include "ecs/forward.h"
 
+#define entity_allocator_shard_count 8
+#define entity_allocator_shard_cache 64
+
+/**
+ * Per-worker cache of free entity indices.
+ * Sharding the free-list means concurrently spawning systems only contend on their own shard lock
+ * (uncontended in the common case) instead of on the central free-list.
+ */
+typedef struct {
+  ALIGNAS(64) ThreadSpinLock lock;
+  u32 count;
+  u32 indices[entity_allocator_shard_cache];
+} EntityAllocatorShard;
+
 typedef struct {
-  ThreadSpinLock lock;
-  u64            serialCounter;
+  i64            serialCounter; // Updated atomically.
+  ThreadSpinLock lock;          // Guards 'freeIndices' and 'totalIndices'.
   DynBitSet      freeIndices;
   usize          totalIndices;
+
+  EntityAllocatorShard shards[entity_allocator_shard_count];
 } EntityAllocator;
 
 EntityAllocator entity_allocator_create(Allocator*);
@@ -24,6 +40,12 @@ EcsEntityId entity_allocator_alloc(EntityAllocator*);
  */
 void entity_allocator_free(EntityAllocator*, EcsEntityId);
 
+/**
+ * Return the cached free indices of all shards to the central free-list.
+ * Keeps the index space dense; meant to be called periodically (for example during a flush).
+ */
+void entity_allocator_rebalance(EntityAllocator*);
+
 /**
  * Count the amount of active (allocated and not yet freed) entities.
  * NOTE: Relatively expensive as it has to walk the entire freeIndices bitset.
@@ -7,7 +7,7 @@ EcsIterator* ecs_iterator_create(const Mem mem, const BitSet mask) {
 }
 
 EcsIterator* ecs_iterator_create_with_count(const Mem mem, const BitSet mask, const u16 compCount) {
-  diag_assert(mem.size >= (sizeof(EcsIterator) + compCount * sizeof(Mem)));
+  diag_assert_hot(mem.size >= (sizeof(EcsIterator) + compCount * sizeof(Mem)));
 
   EcsIterator* itr = mem_as_t(mem, EcsIterator);
 
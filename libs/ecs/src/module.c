@@ -116,6 +116,17 @@ void ecs_module_access_write(EcsViewBuilder* builder, const EcsCompId comp) {
   bitset_set(builder->accessWrite, comp);
 }
 
+void ecs_module_access_changed(EcsViewBuilder* builder, const EcsCompId comp) {
+  diag_assert_msg(!sentinel_check(comp), "Component has not been registered");
+  diag_assert_msg(
+      !ecs_comp_has(builder->filterWithout, comp),
+      "Unable to apply 'changed' access as component '{}' is already marked as 'without'",
+      fmt_text(ecs_def_comp_name(builder->def, comp)));
+
+  bitset_set(builder->filterWith, comp);
+  bitset_set(builder->filterChanged, comp);
+}
+
 void ecs_module_access_maybe_read(EcsViewBuilder* builder, const EcsCompId comp) {
   if (sentinel_check(comp)) {
     return; // Component has not been registered so can never be on an entity.
@@ -161,3 +172,8 @@ void ecs_module_update_parallel(
     EcsModuleBuilder* builder, const EcsSystemId system, const u16 parallelCount) {
   ecs_def_update_parallel(builder->def, system, parallelCount);
 }
+
+void ecs_module_register_relation(
+    EcsModuleBuilder* builder, const EcsCompId comp, const usize offset) {
+  ecs_def_update_relation(builder->def, comp, offset);
+}
@@ -14,7 +14,7 @@ typedef struct {
 struct sEcsViewBuilder {
   const EcsDef* def;
   EcsViewFlags  flags;
-  BitSet        filterWith, filterWithout;
+  BitSet        filterWith, filterWithout, filterChanged;
   BitSet        accessRead, accessWrite;
 };
 
@@ -0,0 +1,140 @@
+#include "core/diag.h"
+#include "core/sort.h"
+#include "ecs/entity.h"
+
+#include "def.h"
+#include "relation.h"
+
+/**
+ * Order pairs on their parent so the children of a single parent are contiguous.
+ * Ties are broken on the child id to keep the order deterministic (the sort is not stable).
+ */
+static i8 ecs_relation_compare_pair(const void* a, const void* b) {
+  const EcsRelationPair* pairA = a;
+  const EcsRelationPair* pairB = b;
+  if (pairA->parent != pairB->parent) {
+    return pairA->parent < pairB->parent ? -1 : 1;
+  }
+  return pairA->child < pairB->child ? -1 : pairA->child > pairB->child ? 1 : 0;
+}
+
+static i8 ecs_relation_compare_group(const void* a, const void* b) {
+  return compare_u64(
+      field_ptr(a, EcsRelationGroup, parent), field_ptr(b, EcsRelationGroup, parent));
+}
+
+static void ecs_relation_collect_archetype(
+    EcsRelationTable* table, EcsStorage* storage, const EcsArchetypeId id, const BitSet mask) {
+
+  EcsIterator* itr = ecs_iterator_stack(mask);
+  while (ecs_storage_itr_walk(storage, itr, id)) {
+    const Mem         comp   = ecs_iterator_access(itr, table->comp);
+    const EcsEntityId parent = *(const EcsEntityId*)((u8*)comp.ptr + table->offset);
+    if (!ecs_entity_valid(parent)) {
+      continue; // Reference is unset.
+    }
+    *dynarray_push_t(&table->pairs, EcsRelationPair) = (EcsRelationPair){
+        .parent = parent,
+        .child  = *itr->entity,
+    };
+  }
+}
+
+static void ecs_relation_rebuild_table(EcsRelationTable* table, EcsStorage* storage, BitSet mask) {
+  dynarray_clear(&table->pairs);
+  dynarray_clear(&table->groups);
+  dynarray_clear(&table->children);
+
+  bitset_clear_all(mask);
+  bitset_set(mask, table->comp);
+
+  // Collect the (parent, child) pairs from all archetypes that contain the relation component.
+  const u32 archetypeCount = ecs_storage_archetype_count(storage);
+  for (EcsArchetypeId archId = 0; archId != archetypeCount; ++archId) {
+    if (!ecs_comp_has(ecs_storage_archetype_mask(storage, archId), table->comp)) {
+      continue;
+    }
+    ecs_relation_collect_archetype(table, storage, archId, mask);
+  }
+
+  sort_quicksort_t(
+      dynarray_begin_t(&table->pairs, EcsRelationPair),
+      dynarray_end_t(&table->pairs, EcsRelationPair),
+      EcsRelationPair,
+      ecs_relation_compare_pair);
+
+  // Emit a group per parent with a contiguous slice of its children.
+  EcsRelationGroup* group = null;
+  dynarray_for_t(&table->pairs, EcsRelationPair, pair) {
+    if (!group || group->parent != pair->parent) {
+      group  = dynarray_push_t(&table->groups, EcsRelationGroup);
+      *group = (EcsRelationGroup){
+          .parent     = pair->parent,
+          .childIndex = (u32)table->children.size,
+      };
+    }
+    *dynarray_push_t(&table->children, EcsEntityId) = pair->child;
+    ++group->childCount;
+  }
+}
+
+EcsRelationIndex ecs_relation_index_create(Allocator* alloc, const EcsDef* def) {
+  EcsRelationIndex index = {
+      .tables = dynarray_create_t(alloc, EcsRelationTable, 0),
+  };
+  const u32 compCount = ecs_def_comp_count(def);
+  for (EcsCompId comp = 0; comp != compCount; ++comp) {
+    const usize offset = ecs_def_comp_relation(def, comp);
+    if (sentinel_check(offset)) {
+      continue; // Component has no relation declared.
+    }
+    *dynarray_push_t(&index.tables, EcsRelationTable) = (EcsRelationTable){
+        .comp     = comp,
+        .offset   = offset,
+        .pairs    = dynarray_create_t(alloc, EcsRelationPair, 64),
+        .groups   = dynarray_create_t(alloc, EcsRelationGroup, 64),
+        .children = dynarray_create_t(alloc, EcsEntityId, 64),
+    };
+  }
+  return index;
+}
+
+void ecs_relation_index_destroy(EcsRelationIndex* index) {
+  dynarray_for_t(&index->tables, EcsRelationTable, table) {
+    dynarray_destroy(&table->pairs);
+    dynarray_destroy(&table->groups);
+    dynarray_destroy(&table->children);
+  }
+  dynarray_destroy(&index->tables);
+}
+
+void ecs_relation_index_rebuild(EcsRelationIndex* index, EcsStorage* storage) {
+  if (!index->tables.size) {
+    return; // No relations declared in the definition.
+  }
+  const BitSet mask = ecs_comp_mask_stack(storage->def);
+  dynarray_for_t(&index->tables, EcsRelationTable, table) {
+    ecs_relation_rebuild_table(table, storage, mask);
+  }
+}
+
+EcsWorldChildren ecs_relation_index_query(
+    const EcsRelationIndex* index, const EcsCompId comp, const EcsEntityId parent) {
+  dynarray_for_t(&index->tables, EcsRelationTable, table) {
+    if (table->comp != comp) {
+      continue;
+    }
+    const EcsRelationGroup  target = {.parent = parent};
+    const EcsRelationGroup* group =
+        dynarray_search_binary((DynArray*)&table->groups, ecs_relation_compare_group, &target);
+    if (!group) {
+      return (EcsWorldChildren){0};
+    }
+    return (EcsWorldChildren){
+        .values = dynarray_at_t(&table->children, group->childIndex, EcsEntityId),
+        .count  = group->childCount,
+    };
+  }
+  diag_assert_fail("Component '{}' has no relation declared", fmt_int(comp));
+  return (EcsWorldChildren){0};
+}
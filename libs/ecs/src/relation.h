@@ -0,0 +1,41 @@
+#pragma once
+#include "core/dynarray.h"
+#include "ecs/def.h"
+#include "ecs/world.h"
+
+#include "storage.h"
+
+/**
+ * Reverse index for components with a declared relation field (see 'ecs_relation()').
+ * Stores per relation-component the children of each parent entity in a flat sorted layout: the
+ * children of a single parent are contiguous, allowing a cheap (binary-search) lookup and
+ * cache-friendly traversal of the result.
+ * NOTE: Rebuilt from storage during flush; immutable in between flushes.
+ */
+
+typedef struct {
+  EcsEntityId parent, child;
+} EcsRelationPair;
+
+typedef struct {
+  EcsEntityId parent;
+  u32         childIndex, childCount; // Slice into the 'children' array of the table.
+} EcsRelationGroup;
+
+typedef struct {
+  EcsCompId comp;
+  usize     offset;   // Byte offset of the (EcsEntityId) reference field in the component.
+  DynArray  pairs;    // EcsRelationPair[], scratch used during rebuilds (retained for reuse).
+  DynArray  groups;   // EcsRelationGroup[], sorted on the parent entity.
+  DynArray  children; // EcsEntityId[], child entities grouped per parent.
+} EcsRelationTable;
+
+typedef struct {
+  DynArray tables; // EcsRelationTable[], one per component with a declared relation.
+} EcsRelationIndex;
+
+EcsRelationIndex ecs_relation_index_create(Allocator*, const EcsDef*);
+void             ecs_relation_index_destroy(EcsRelationIndex*);
+void             ecs_relation_index_rebuild(EcsRelationIndex*, EcsStorage*);
+
+EcsWorldChildren ecs_relation_index_query(const EcsRelationIndex*, EcsCompId, EcsEntityId parent);
@@ -24,6 +24,10 @@
 
 static const f64 g_runnerInvAvgWindow = 1.0 / 15.0;
 
+// Limits for systems with an automatic ('ecs_parallel_auto') parallel count.
+#define runner_auto_par_max 16
+#define runner_auto_par_chunks_per_task 4
+
 typedef const EcsSystemDef* EcsSystemDefPtr;
 
 typedef enum {
@@ -54,9 +58,10 @@ typedef struct {
 } TaskContextSystem;
 
 typedef struct {
-  JobGraph*   graph;
-  EcsTaskSet* systemTasks; // EcsTaskSet[systemCount].
-  JobTaskId   metaTasks[EcsRunnerMetaTask_Count];
+  JobGraph*        graph;
+  EcsTaskSet*      systemTasks; // EcsTaskSet[systemCount].
+  EcsSystemDefPtr* sysOrder;    // EcsSystemDefPtr[systemCount], order of the last formulation.
+  JobTaskId        metaTasks[EcsRunnerMetaTask_Count];
 } RunnerPlan;
 
 typedef struct {
@@ -75,6 +80,7 @@ struct sEcsRunner {
   u32                planIndex, planIndexNext;
   RunnerPlan         plans[2];
   BitSet             sysConflicts; // bit[systemId, systemId], triangular matrix of sys conflicts.
+  BitSet             sysCritical;  // bit[systemId], systems on the estimated critical path.
   RunnerSystemStats* sysStats;     // RunnerSystemStats[systemCount].
   RunnerMetaStats    metaStats[EcsRunnerMetaTask_Count];
   u64                planCounter;
@@ -99,10 +105,42 @@ static void runner_avg_dur(TimeDuration* value, const TimeDuration new) {
   *value += (TimeDuration)((new - *value) * g_runnerInvAvgWindow);
 }
 
-static u32 runner_task_count_system(const EcsSystemDef* sysDef) {
+/**
+ * Compute the amount of parallel tasks for a system with an automatic parallel count.
+ * Derived from the amount of storage chunks in the system's views so the work is sliced
+ * per-archetype-chunk, re-evaluated every time a plan is formulated.
+ */
+static u32 runner_task_count_auto(const EcsRunner* runner, const EcsSystemDef* sysDef) {
+  const EcsView* viewStorage = ecs_world_view_storage_internal(runner->world);
+
+  u32 chunks = 0;
+  dynarray_for_t((DynArray*)&sysDef->viewIds, EcsViewId, viewId) {
+    chunks = math_max(chunks, ecs_view_chunks(&viewStorage[*viewId]));
+  }
+  const u32 tasks = chunks / runner_auto_par_chunks_per_task;
+  return (u32)math_clamp_i32((i32)tasks, 1, runner_auto_par_max);
+}
+
+static u32 runner_task_count_system(const EcsRunner* runner, const EcsSystemDef* sysDef) {
+  if (g_jobsWorkerCount == 1) {
+    return 1; // Parallel systems only makes sense if we have multiple workers.
+  }
+  if (!sysDef->parallelCount) {
+    return runner_task_count_auto(runner, sysDef);
+  }
+  return sysDef->parallelCount;
+}
+
+/**
+ * Maximum amount of tasks a system can use, regardless of the current storage chunk counts.
+ */
+static u32 runner_task_count_system_max(const EcsSystemDef* sysDef) {
   if (g_jobsWorkerCount == 1) {
     return 1; // Parallel systems only makes sense if we have multiple workers.
   }
+  if (!sysDef->parallelCount) {
+    return runner_auto_par_max;
+  }
   return sysDef->parallelCount;
 }
 
@@ -112,7 +150,7 @@ static u32 runner_task_count_total(const EcsDef* def) {
 
   u32 taskCount = EcsRunnerMetaTask_Count;
   for (const EcsSystemDef* sysDef = sysDefsBegin; sysDef != sysDefsEnd; ++sysDef) {
-    taskCount += runner_task_count_system(sysDef);
+    taskCount += runner_task_count_system_max(sysDef);
   }
   return taskCount;
 }
@@ -122,6 +160,9 @@ static JobTaskFlags runner_task_system_flags(const EcsSystemDef* systemDef) {
   if (systemDef->flags & EcsSystemFlags_ThreadAffinity) {
     flags |= JobTaskFlags_ThreadAffinity;
   }
+  if (systemDef->flags & EcsSystemFlags_HighPriority) {
+    flags |= JobTaskFlags_HighPriority;
+  }
   return flags;
 }
 
@@ -241,6 +282,38 @@ static u64 runner_estimate_plan(const RunnerEstimateContext* ctx) {
   return jobs_graph_task_span_cost(ctx->plan->graph, (JobsCostEstimator)runner_estimate_task, ctx);
 }
 
+/**
+ * Mark the systems whose tasks lie on the estimated critical path of the given plan.
+ * These systems directly determine the frame duration: reducing their cost (or the conflicts /
+ * order constraints that force them to run serially) shortens the frame.
+ */
+static void runner_critical_update(EcsRunner* runner, const u32 planIndex) {
+  if (!runner->sysCritical.size) {
+    return; // No systems registered.
+  }
+  const RunnerPlan*           plan   = &runner->plans[planIndex];
+  const RunnerEstimateContext estCtx = {.runner = runner, .plan = plan};
+
+  const u32    taskCount    = jobs_graph_task_count(plan->graph);
+  const BitSet taskCritical = mem_stack(bits_to_bytes(taskCount) + 1);
+  jobs_graph_task_span_path(
+      plan->graph, (JobsCostEstimator)runner_estimate_task, &estCtx, taskCritical);
+
+  const EcsDef* def         = ecs_world_def(runner->world);
+  const u32     systemCount = ecs_def_system_count(def);
+
+  bitset_clear_all(runner->sysCritical);
+  for (EcsSystemId sys = 0; sys != systemCount; ++sys) {
+    const EcsTaskSet tasks = plan->systemTasks[sys];
+    for (JobTaskId task = tasks.begin; task != tasks.end; ++task) {
+      if (bitset_test(taskCritical, task)) {
+        bitset_set(runner->sysCritical, sys);
+        break;
+      }
+    }
+  }
+}
+
 static EcsTaskSet runner_insert_replan(EcsRunner* runner, const u32 planIndex) {
   const RunnerPlan* plan = &runner->plans[planIndex];
   /**
@@ -282,7 +355,7 @@ static EcsTaskSet runner_insert_system(
     const EcsSystemDef* systemDef) {
   const RunnerPlan* plan = &runner->plans[planIndex];
 
-  const u32 parallelCount = runner_task_count_system(systemDef);
+  const u32 parallelCount = runner_task_count_system(runner, systemDef);
 
   JobTaskId firstTaskId = 0;
   for (u16 parIndex = 0; parIndex != parallelCount; ++parIndex) {
@@ -645,6 +718,7 @@ static void runner_plan_pick(EcsRunner* runner) {
   trace_end();
 
   runner->planEstSpan = (TimeDuration)bestSpan;
+  runner_critical_update(runner, bestIndex);
   if (bestIndex != runner->planIndex) {
     runner->planIndexNext = bestIndex;
     ++runner->planCounter;
@@ -653,6 +727,65 @@ static void runner_plan_pick(EcsRunner* runner) {
   }
 }
 
+/**
+ * Attempt to patch the previously formulated graph instead of rebuilding it.
+ * When the system order is unchanged the task layout and dependencies are identical, so only the
+ * per-task user contexts need to be rebound.
+ * Returns false when any task no longer matches (the graph has to be rebuilt in that case).
+ */
+static bool runner_plan_patch(
+    EcsRunner* runner, const u32 planIndex, const EcsSystemDefPtr* systems, const u32 systemCount) {
+  const EcsDef*     def  = ecs_world_def(runner->world);
+  const RunnerPlan* plan = &runner->plans[planIndex];
+
+  if (!jobs_graph_task_rebind(
+          plan->graph,
+          plan->metaTasks[EcsRunnerMetaTask_Replan],
+          string_lit("Replan"),
+          runner_task_replan,
+          mem_struct(TaskContextMeta, .runner = runner),
+          JobTaskFlags_BorrowName)) {
+    return false;
+  }
+  if (!jobs_graph_task_rebind(
+          plan->graph,
+          plan->metaTasks[EcsRunnerMetaTask_Flush],
+          string_lit("Flush"),
+          runner_task_flush,
+          mem_struct(TaskContextMeta, .runner = runner),
+          JobTaskFlags_BorrowName | JobTaskFlags_ThreadAffinity)) {
+    return false;
+  }
+  for (u32 i = 0; i != systemCount; ++i) {
+    const EcsSystemDef* sysDef        = systems[i];
+    const EcsSystemId   sysId         = ecs_def_system_id(def, sysDef);
+    const EcsTaskSet    sysTasks      = plan->systemTasks[sysId];
+    const u32           parallelCount = runner_task_count_system(runner, sysDef);
+    if ((u32)(sysTasks.end - sysTasks.begin) != parallelCount) {
+      return false;
+    }
+    for (u16 parIndex = 0; parIndex != parallelCount; ++parIndex) {
+      if (!jobs_graph_task_rebind(
+              plan->graph,
+              (JobTaskId)(sysTasks.begin + parIndex),
+              sysDef->name,
+              runner_task_system,
+              mem_struct(
+                  TaskContextSystem,
+                  .id       = sysId,
+                  .flags    = (u16)sysDef->flags,
+                  .parCount = (u16)parallelCount,
+                  .parIndex = parIndex,
+                  .runner   = runner,
+                  .routine  = sysDef->routine),
+              runner_task_system_flags(sysDef))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 static void runner_plan_formulate(EcsRunner* runner, const u32 planIndex, const bool shuffle) {
   const EcsDef* def  = ecs_world_def(runner->world);
   RunnerPlan*   plan = &runner->plans[planIndex];
@@ -675,6 +808,24 @@ static void runner_plan_formulate(EcsRunner* runner, const u32 planIndex, const
   sort_quicksort_t(systems, systems + systemCount, EcsSystemDefPtr, compare_system_entry);
 
   trace_end();
+
+  /**
+   * When the resulting system order is unchanged from the last formulation of this plan the graph
+   * is identical; patch the existing graph (rebind the task user contexts) instead of rebuilding.
+   */
+  const usize sysOrderSize = sizeof(EcsSystemDefPtr) * systemCount;
+  const bool  sameOrder =
+      jobs_graph_task_count(plan->graph) != 0 &&
+      (!systemCount || mem_eq(mem_create(plan->sysOrder, sysOrderSize), mem_create(systems, sysOrderSize)));
+  if (sameOrder) {
+    trace_begin("ecs_plan_patch", TraceColor_Blue);
+    const bool patched = runner_plan_patch(runner, planIndex, systems, systemCount);
+    trace_end();
+    if (patched) {
+      return;
+    }
+  }
+
   trace_begin("ecs_plan_build", TraceColor_Blue);
 
   // Insert the systems into the job-graph.
@@ -734,6 +885,11 @@ static void runner_plan_formulate(EcsRunner* runner, const u32 planIndex, const
   diag_assert(jobs_graph_reduce_dependencies(plan->graph) == 0); // Test for redundant dependencies.
 #endif
 
+  // Remember the formulated order so the next formulation can patch instead of rebuild.
+  if (systemCount) {
+    mem_cpy(mem_create(plan->sysOrder, sysOrderSize), mem_create(systems, sysOrderSize));
+  }
+
   trace_end();
 }
 
@@ -754,20 +910,30 @@ EcsRunner* ecs_runner_create(Allocator* alloc, EcsWorld* world, const EcsRunnerF
   if (systemCount) {
     runner->sysStats = alloc_array_t(alloc, RunnerSystemStats, systemCount);
     mem_set(mem_create(runner->sysStats, sizeof(RunnerSystemStats) * systemCount), 0);
+
+    runner->sysCritical = alloc_alloc(alloc, bits_to_bytes(systemCount) + 1, 1);
+    bitset_clear_all(runner->sysCritical);
   }
 
   array_for_t(runner->plans, RunnerPlan, plan) {
     plan->graph       = jobs_graph_create(alloc, string_lit("ecs_runner"), runner->taskCount);
     plan->systemTasks = systemCount ? alloc_array_t(alloc, EcsTaskSet, systemCount) : null;
+    plan->sysOrder    = systemCount ? alloc_array_t(alloc, EcsSystemDefPtr, systemCount) : null;
+    if (plan->sysOrder) {
+      mem_set(mem_create(plan->sysOrder, sizeof(EcsSystemDefPtr) * systemCount), 0);
+    }
   }
 
   runner_plan_formulate(runner, runner->planIndex, false /* shuffle */);
+  runner_critical_update(runner, runner->planIndex);
 
   // Allocate the runtime memory required to run the graph (reused for every run).
+  // NOTE: Sized for the maximum task count as systems with an automatic parallel count can use
+  // fewer tasks in any given formulation.
   // NOTE: +64 for bump allocator overhead.
   const JobGraph* graph = runner->plans[runner->planIndex].graph;
-  diag_assert(jobs_graph_task_count(graph) == runner->taskCount);
-  const usize jobMemSize = jobs_scheduler_mem_size(graph) + 64;
+  diag_assert(jobs_graph_task_count(graph) <= runner->taskCount);
+  const usize jobMemSize = jobs_scheduler_mem_size_max(runner->taskCount) + 64;
   runner->jobMem         = alloc_alloc(alloc, jobMemSize, jobs_scheduler_mem_align(graph));
 
   return runner;
@@ -784,8 +950,12 @@ void ecs_runner_destroy(EcsRunner* runner) {
     if (plan->systemTasks) {
       alloc_free_array_t(runner->alloc, plan->systemTasks, systemCount);
     }
+    if (plan->sysOrder) {
+      alloc_free_array_t(runner->alloc, plan->sysOrder, systemCount);
+    }
   }
   alloc_maybe_free(runner->alloc, runner->sysConflicts);
+  alloc_maybe_free(runner->alloc, runner->sysCritical);
   if (runner->sysStats) {
     alloc_free_array_t(runner->alloc, runner->sysStats, systemCount);
   }
@@ -816,6 +986,30 @@ TimeDuration ecs_runner_duration_avg(const EcsRunner* runner, const EcsSystemId
   return runner->sysStats[systemId].totalDurAvg;
 }
 
+bool ecs_runner_system_critical(const EcsRunner* runner, const EcsSystemId systemId) {
+  return runner->sysCritical.size && bitset_test(runner->sysCritical, systemId);
+}
+
+u32 ecs_runner_system_conflicts(
+    const EcsRunner* runner, const EcsSystemId systemId, EcsSystemId out[], const u32 outMax) {
+  const EcsDef* def         = ecs_world_def(runner->world);
+  const u32     systemCount = ecs_def_system_count(def);
+
+  u32 count = 0;
+  for (EcsSystemId other = 0; other != systemCount; ++other) {
+    if (other == systemId) {
+      continue;
+    }
+    if (runner_conflict_query(runner->sysConflicts, systemId, other)) {
+      if (count < outMax) {
+        out[count] = other;
+      }
+      ++count;
+    }
+  }
+  return count;
+}
+
 bool ecs_running(const EcsRunner* runner) {
   return (runner->flags & EcsRunnerPrivateFlags_Running) != 0;
 }
@@ -1,4 +1,7 @@
+#include "core/alloc.h"
+#include "core/bits.h"
 #include "core/diag.h"
+#include "core/sort.h"
 #include "ecs/entity.h"
 
 #include "archetype.h"
@@ -15,6 +18,13 @@ typedef struct {
   u32            archetypeIndex;
 } EcsEntityInfo;
 
+struct sEcsWorldSnapshot {
+  u32           version;        // Storage change-detection version at the time of taking.
+  u32           archetypeCount; // Count of archetypes that existed at the time of taking.
+  EcsArchetype* archetypes;     // EcsArchetype[archetypeCount]; shallow copies of the live ones.
+  BitSet        sharedChunks;   // Bit per potential chunk; set while shared with the live storage.
+};
+
 static void ecs_storage_entity_ensure(EcsStorage* storage, const u32 index) {
   if (UNLIKELY(index >= storage->entities.size)) {
     Mem entities = dynarray_push(&storage->entities, (index + 1) - storage->entities.size);
@@ -56,6 +66,34 @@ static EcsEntityInfo* ecs_storage_entity_info_ptr(EcsStorage* storage, const Ecs
   return ecs_storage_entity_info_ptr_unsafe(storage, id);
 }
 
+/**
+ * Copy-on-write barrier: must be invoked before writing to a chunk. If the chunk is shared with an
+ * active snapshot it is cloned and the live archetype is pointed at the clone (the snapshot keeps
+ * reading the original).
+ * Returns true if the chunk memory may have been re-allocated (by this thread or a concurrent one)
+ * since the snapshot was taken; any iterator pointers into it then need to be refreshed.
+ */
+static bool
+ecs_storage_chunk_cow(EcsStorage* storage, const EcsArchetypeId id, const u32 chunkIdx) {
+  if (LIKELY(!storage->snapshot)) {
+    return false;
+  }
+  EcsWorldSnapshot* snapshot = storage->snapshot;
+  if (id >= snapshot->archetypeCount || chunkIdx >= snapshot->archetypes[id].chunkCount) {
+    return false; // Chunk is not covered by the snapshot.
+  }
+  const usize bitIdx = (usize)id * ecs_archetype_max_chunks + chunkIdx;
+
+  thread_spinlock_lock(&storage->snapshotLock);
+  if (bitset_test(snapshot->sharedChunks, bitIdx)) {
+    EcsArchetype* archetype     = ecs_storage_archetype_ptr(storage, id);
+    archetype->chunks[chunkIdx] = ecs_archetype_chunk_clone(archetype->chunks[chunkIdx]);
+    bitset_clear(snapshot->sharedChunks, bitIdx);
+  }
+  thread_spinlock_unlock(&storage->snapshotLock);
+  return true;
+}
+
 static void ecs_storage_queue_finalize_itr(EcsFinalizer* finalizer, EcsIterator* itr) {
   EcsCompId compId = 0;
   for (u16 i = 0; i != itr->compCount; ++i, ++compId) {
@@ -80,11 +118,13 @@ EcsStorage ecs_storage_create(Allocator* alloc, const EcsDef* def) {
   diag_assert(alloc && def);
 
   EcsStorage storage = (EcsStorage){
-      .def             = def,
-      .entityAllocator = entity_allocator_create(alloc),
-      .entities        = dynarray_create_t(alloc, EcsEntityInfo, ecs_starting_entities_capacity),
-      .newEntities     = dynarray_create_t(alloc, EcsEntityId, 128),
-      .archetypes      = dynarray_create_t(alloc, EcsArchetype, 128),
+      .def              = def,
+      .entityAllocator  = entity_allocator_create(alloc),
+      .entities         = dynarray_create_t(alloc, EcsEntityInfo, ecs_starting_entities_capacity),
+      .newEntities      = dynarray_create_t(alloc, EcsEntityId, 128),
+      .archetypes       = dynarray_create_t(alloc, EcsArchetype, 128),
+      .version          = 2, // Start above 1 so that zeroed chunk stamps always test as clean.
+      .structureVersion = 1,
   };
 
   ecs_storage_entity_ensure(&storage, ecs_starting_entities_capacity);
@@ -92,6 +132,8 @@ EcsStorage ecs_storage_create(Allocator* alloc, const EcsDef* def) {
 }
 
 void ecs_storage_destroy(EcsStorage* storage) {
+  diag_assert_msg(!storage->snapshot, "Storage destroyed while a snapshot is still active");
+
   dynarray_for_t(&storage->archetypes, EcsArchetype, arch) { ecs_archetype_destroy(arch); }
   dynarray_destroy(&storage->archetypes);
 
@@ -109,6 +151,10 @@ void ecs_storage_queue_finalize(
 
   EcsArchetype* archetype = ecs_storage_archetype_ptr(storage, info->archetype);
   if (archetype) {
+    // The finalizers will mutate the component data; avoid writing to a snapshot chunk.
+    ecs_storage_chunk_cow(
+        storage, info->archetype, info->archetypeIndex / archetype->entitiesPerChunk);
+
     EcsIterator* itr = ecs_iterator_stack(mask);
     ecs_archetype_itr_jump(archetype, itr, info->archetypeIndex);
     ecs_storage_queue_finalize_itr(finalizer, itr);
@@ -177,17 +223,29 @@ EcsArchetypeId ecs_storage_entity_archetype(const EcsStorage* storage, const Ecs
 void ecs_storage_entity_move(
     EcsStorage* storage, const EcsEntityId id, const EcsArchetypeId newArchetypeId) {
 
-  EcsEntityInfo* info              = ecs_storage_entity_info_ptr_unsafe(storage, id);
-  EcsArchetype*  oldArchetype      = ecs_storage_archetype_ptr(storage, info->archetype);
-  const u32      oldArchetypeIndex = info->archetypeIndex;
-  EcsArchetype*  newArchetype      = ecs_storage_archetype_ptr(storage, newArchetypeId);
+  EcsEntityInfo*       info              = ecs_storage_entity_info_ptr_unsafe(storage, id);
+  const EcsArchetypeId oldArchetypeId    = info->archetype;
+  EcsArchetype*        oldArchetype      = ecs_storage_archetype_ptr(storage, oldArchetypeId);
+  const u32            oldArchetypeIndex = info->archetypeIndex;
+  EcsArchetype*        newArchetype      = ecs_storage_archetype_ptr(storage, newArchetypeId);
 
   if (newArchetype == oldArchetype) {
     return; // Same archetype; no need to move.
   }
+  ++storage->structureVersion;
 
   if (newArchetype) {
+    // Avoid writing the new entity into a chunk that is shared with a snapshot.
+    const u32 destChunkIdx = newArchetype->entityCount / newArchetype->entitiesPerChunk;
+    if (destChunkIdx < newArchetype->chunkCount) {
+      ecs_storage_chunk_cow(storage, newArchetypeId, destChunkIdx);
+    }
+
     const u32 newArchetypeIndex = ecs_archetype_add(newArchetype, id);
+
+    // Mark the destination chunk as changed; the entity is new to any view observing it there.
+    ecs_archetype_stamp(newArchetype, newArchetypeIndex, newArchetype->mask, storage->version);
+
     if (oldArchetype) {
       // Copy the components that both archetypes have in common.
       BitSet overlapping = ecs_comp_mask_stack(storage->def);
@@ -204,6 +262,10 @@ void ecs_storage_entity_move(
   }
 
   if (oldArchetype) {
+    // Removal fills the hole with the tail entity; avoid writing to a snapshot chunk.
+    ecs_storage_chunk_cow(
+        storage, oldArchetypeId, oldArchetypeIndex / oldArchetype->entitiesPerChunk);
+
     const EcsEntityId moved = ecs_archetype_remove(oldArchetype, oldArchetypeIndex);
     if (ecs_entity_valid(moved)) {
       ecs_storage_entity_info_ptr_unsafe(storage, moved)->archetypeIndex = oldArchetypeIndex;
@@ -211,16 +273,119 @@ void ecs_storage_entity_move(
   }
 }
 
+void ecs_storage_entity_move_batch(
+    EcsStorage*          storage,
+    const EcsArchetypeId oldArchetypeId,
+    const EcsArchetypeId newArchetypeId,
+    EcsEntityId*         ids,
+    const u32            count) {
+
+  diag_assert(count);
+  diag_assert(oldArchetypeId != newArchetypeId);
+
+  if (count == 1) {
+    ecs_storage_entity_move(storage, ids[0], newArchetypeId);
+    return;
+  }
+  ++storage->structureVersion;
+
+  EcsArchetype* oldArchetype = ecs_storage_archetype_ptr(storage, oldArchetypeId);
+  EcsArchetype* newArchetype = ecs_storage_archetype_ptr(storage, newArchetypeId);
+
+  /**
+   * Sort the batch on the current archetype index (the entity index in the key low bits makes the
+   * entity recoverable after sorting); this makes the component data copyable in contiguous runs
+   * and allows removing from the old archetype in descending order, where removals at the tail are
+   * free and interior removals never fix-up entities that are part of the batch.
+   */
+  u64* keys = null;
+  if (oldArchetype) {
+    keys = alloc_array_t(g_allocHeap, u64, count);
+    for (u32 i = 0; i != count; ++i) {
+      const EcsEntityInfo* info = ecs_storage_entity_info_ptr_unsafe(storage, ids[i]);
+      keys[i] = ((u64)info->archetypeIndex << 32u) | ecs_entity_id_index(ids[i]);
+    }
+    sort_radixsort_u64(keys, keys + count);
+
+    for (u32 i = 0; i != count; ++i) {
+      const u32            entityIndex = (u32)keys[i];
+      const EcsEntityInfo* info = dynarray_at_t(&storage->entities, entityIndex, EcsEntityInfo);
+      ids[i]                    = (EcsEntityId)(entityIndex | ((u64)info->serial << 32u));
+    }
+  }
+
+  u32 firstNewIndex = sentinel_u32;
+  if (newArchetype) {
+    // Avoid writing the new entities into chunks that are shared with a snapshot.
+    const u32 destEnd = newArchetype->entityCount + count;
+    for (u32 chunkIdx = newArchetype->entityCount / newArchetype->entitiesPerChunk;
+         chunkIdx != newArchetype->chunkCount &&
+         chunkIdx * newArchetype->entitiesPerChunk < destEnd;
+         ++chunkIdx) {
+      ecs_storage_chunk_cow(storage, newArchetypeId, chunkIdx);
+    }
+
+    firstNewIndex = ecs_archetype_add_batch(newArchetype, ids, count);
+
+    // Mark the destination chunks as changed; the entities are new to any view observing them.
+    ecs_archetype_stamp_range(
+        newArchetype, firstNewIndex, count, newArchetype->mask, storage->version);
+
+    if (oldArchetype) {
+      // Copy the components that both archetypes have in common.
+      BitSet overlapping = ecs_comp_mask_stack(storage->def);
+      mem_cpy(overlapping, oldArchetype->mask);
+      bitset_and(overlapping, newArchetype->mask);
+
+      for (u32 i = 0; i != count;) {
+        const u32 srcIdx = (u32)(keys[i] >> 32u);
+        u32       runLen = 1;
+        while ((i + runLen) != count && (u32)(keys[i + runLen] >> 32u) == (srcIdx + runLen)) {
+          ++runLen;
+        }
+        ecs_archetype_copy_across_batch(
+            overlapping, newArchetype, firstNewIndex + i, oldArchetype, srcIdx, runLen);
+        i += runLen;
+      }
+    }
+  }
+
+  for (u32 i = 0; i != count; ++i) {
+    EcsEntityInfo* info = ecs_storage_entity_info_ptr_unsafe(storage, ids[i]);
+    info->archetype     = newArchetypeId;
+    if (newArchetype) {
+      info->archetypeIndex = firstNewIndex + i;
+    }
+  }
+
+  if (oldArchetype) {
+    for (u32 i = count; i-- != 0;) {
+      const u32 srcIdx = (u32)(keys[i] >> 32u);
+      ecs_storage_chunk_cow(storage, oldArchetypeId, srcIdx / oldArchetype->entitiesPerChunk);
+      const EcsEntityId moved = ecs_archetype_remove(oldArchetype, srcIdx);
+      if (ecs_entity_valid(moved)) {
+        ecs_storage_entity_info_ptr_unsafe(storage, moved)->archetypeIndex = srcIdx;
+      }
+    }
+    alloc_free_array_t(g_allocHeap, keys, count);
+  }
+}
+
 void ecs_storage_entity_reset(EcsStorage* storage, const EcsEntityId id) {
   EcsEntityInfo* info = ecs_storage_entity_info_ptr(storage, id);
   diag_assert_msg(info, "Missing entity-info for entity '{}'", ecs_entity_fmt(id));
 
   EcsArchetype* archetype = ecs_storage_archetype_ptr(storage, info->archetype);
   if (archetype) {
+    // Removal fills the hole with the tail entity; avoid writing to a snapshot chunk.
+    ecs_storage_chunk_cow(
+        storage, info->archetype, info->archetypeIndex / archetype->entitiesPerChunk);
+
     const EcsEntityId moved = ecs_archetype_remove(archetype, info->archetypeIndex);
     if (ecs_entity_valid(moved)) {
       ecs_storage_entity_info_ptr_unsafe(storage, moved)->archetypeIndex = info->archetypeIndex;
     }
+    ++storage->structureVersion;
   }
 
   info->archetype = sentinel_u32;
@@ -232,10 +397,15 @@ void ecs_storage_entity_destroy(EcsStorage* storage, const EcsEntityId id) {
 
   EcsArchetype* archetype = ecs_storage_archetype_ptr(storage, info->archetype);
   if (archetype) {
+    // Removal fills the hole with the tail entity; avoid writing to a snapshot chunk.
+    ecs_storage_chunk_cow(
+        storage, info->archetype, info->archetypeIndex / archetype->entitiesPerChunk);
+
     const EcsEntityId moved = ecs_archetype_remove(archetype, info->archetypeIndex);
     if (ecs_entity_valid(moved)) {
       ecs_storage_entity_info_ptr_unsafe(storage, moved)->archetypeIndex = info->archetypeIndex;
     }
+    ++storage->structureVersion;
   }
 
   info->serial = 0;
@@ -315,6 +485,7 @@ EcsArchetypeId ecs_storage_archetype_create(EcsStorage* storage, const BitSet ma
 
   const EcsArchetypeId id                              = (EcsArchetypeId)storage->archetypes.size;
   *dynarray_push_t(&storage->archetypes, EcsArchetype) = ecs_archetype_create(storage->def, mask);
+  ++storage->structureVersion;
   return id;
 }
 
@@ -329,10 +500,127 @@ void ecs_storage_itr_jump(EcsStorage* storage, EcsIterator* itr, const EcsEntity
   ecs_archetype_itr_jump(archetype, itr, info->archetypeIndex);
 }
 
+void ecs_storage_itr_refresh_chunk(EcsStorage* storage, EcsIterator* itr, const EcsArchetypeId id) {
+  EcsArchetype* archetype = ecs_storage_archetype_ptr(storage, id);
+  ecs_archetype_itr_refresh(archetype, itr, itr->chunkIdx * archetype->entitiesPerChunk);
+}
+
+EcsWorldSnapshot* ecs_storage_snapshot_take(EcsStorage* storage) {
+  diag_assert_msg(!storage->snapshot, "Storage already has an active snapshot");
+
+  const u32         archetypeCount = (u32)storage->archetypes.size;
+  EcsWorldSnapshot* snapshot       = alloc_alloc_t(g_allocHeap, EcsWorldSnapshot);
+
+  *snapshot = (EcsWorldSnapshot){
+      .version        = storage->version,
+      .archetypeCount = archetypeCount,
+  };
+  if (archetypeCount) {
+    const usize chunkBits  = (usize)archetypeCount * ecs_archetype_max_chunks;
+    snapshot->archetypes   = alloc_array_t(g_allocHeap, EcsArchetype, archetypeCount);
+    snapshot->sharedChunks = alloc_alloc(g_allocHeap, bits_to_bytes(chunkBits), 1);
+    mem_set(snapshot->sharedChunks, 0);
+
+    for (EcsArchetypeId archId = 0; archId != archetypeCount; ++archId) {
+      const EcsArchetype* arch = ecs_storage_archetype_ptr(storage, archId);
+      EcsArchetype*       copy = &snapshot->archetypes[archId];
+
+      // Shallow copy; the (immutable) mask and component layout stay owned by the live archetype.
+      *copy = *arch;
+      if (arch->chunkCount) {
+        const usize chunksSize = sizeof(void*) * arch->chunkCount;
+        copy->chunks           = alloc_alloc(g_allocHeap, chunksSize, alignof(void*)).ptr;
+        mem_cpy(mem_create(copy->chunks, chunksSize), mem_create(arch->chunks, chunksSize));
+        for (u32 chunkIdx = 0; chunkIdx != arch->chunkCount; ++chunkIdx) {
+          bitset_set(snapshot->sharedChunks, (usize)archId * ecs_archetype_max_chunks + chunkIdx);
+        }
+      } else {
+        copy->chunks = null;
+      }
+    }
+  }
+  storage->snapshot = snapshot;
+  return snapshot;
+}
+
+void ecs_storage_snapshot_release(EcsStorage* storage, EcsWorldSnapshot* snapshot) {
+  diag_assert_msg(storage->snapshot == snapshot, "Snapshot does not belong to this storage");
+  storage->snapshot = null;
+
+  for (EcsArchetypeId archId = 0; archId != snapshot->archetypeCount; ++archId) {
+    EcsArchetype* copy = &snapshot->archetypes[archId];
+    for (u32 chunkIdx = 0; chunkIdx != copy->chunkCount; ++chunkIdx) {
+      const usize bitIdx = (usize)archId * ecs_archetype_max_chunks + chunkIdx;
+      if (!bitset_test(snapshot->sharedChunks, bitIdx)) {
+        // The live storage copied this chunk; the original is owned by the snapshot now.
+        ecs_archetype_chunk_destroy(copy->chunks[chunkIdx]);
+      }
+    }
+    if (copy->chunkCount) {
+      alloc_free(g_allocHeap, mem_create(copy->chunks, sizeof(void*) * copy->chunkCount));
+    }
+  }
+  if (snapshot->archetypeCount) {
+    alloc_free_array_t(g_allocHeap, snapshot->archetypes, snapshot->archetypeCount);
+    alloc_free(g_allocHeap, snapshot->sharedChunks);
+  }
+  alloc_free_t(g_allocHeap, snapshot);
+}
+
+u32 ecs_storage_snapshot_archetype_count(const EcsWorldSnapshot* snapshot) {
+  return snapshot->archetypeCount;
+}
+
+BitSet
+ecs_storage_snapshot_archetype_mask(const EcsWorldSnapshot* snapshot, const u32 archetypeIdx) {
+  return snapshot->archetypes[archetypeIdx].mask;
+}
+
+bool ecs_storage_snapshot_itr_walk(
+    const EcsWorldSnapshot* snapshot, EcsIterator* itr, const u32 archetypeIdx) {
+  return ecs_archetype_itr_walk((EcsArchetype*)&snapshot->archetypes[archetypeIdx], itr);
+}
+
+bool ecs_storage_snapshot_chunk_changed(
+    const EcsWorldSnapshot* snapshot, const u32 archetypeIdx, const u32 chunkIdx,
+    const BitSet mask) {
+  // NOTE: Also report stamps from the previous version as changed, matching the live behavior at
+  // the time the snapshot was taken.
+  const u32 sinceVersion = snapshot->version - 1;
+  return ecs_archetype_chunk_changed(
+      &snapshot->archetypes[archetypeIdx], chunkIdx, mask, sinceVersion);
+}
+
+void ecs_storage_version_bump(EcsStorage* storage) { ++storage->version; }
+
+u32 ecs_storage_structure_version(const EcsStorage* storage) { return storage->structureVersion; }
+
+bool ecs_storage_chunk_stamp(
+    EcsStorage* storage, const EcsArchetypeId id, const u32 chunkIdx, const BitSet mask) {
+  // The stamps live inside the chunk itself, so stamping is a chunk write as well.
+  const bool refresh = ecs_storage_chunk_cow(storage, id, chunkIdx);
+
+  EcsArchetype* archetype = ecs_storage_archetype_ptr(storage, id);
+  ecs_archetype_chunk_stamp(archetype, chunkIdx, mask, storage->version);
+  return refresh;
+}
+
+bool ecs_storage_chunk_changed(
+    const EcsStorage* storage, const EcsArchetypeId id, const u32 chunkIdx, const BitSet mask) {
+  // NOTE: Also report stamps from the previous version as changed, this guarantees systems that
+  // run before the writer in the tick still observe the change (albeit one tick late).
+  const u32 sinceVersion = storage->version - 1;
+  return ecs_archetype_chunk_changed(
+      ecs_storage_archetype_ptr(storage, id), chunkIdx, mask, sinceVersion);
+}
+
 void ecs_storage_flush_new_entities(EcsStorage* storage) {
   dynarray_for_t(&storage->newEntities, EcsEntityId, newEntityId) {
     ecs_storage_entity_ensure(storage, ecs_entity_id_index(*newEntityId));
     ecs_storage_entity_init(storage, *newEntityId);
   }
   dynarray_clear(&storage->newEntities);
+
+  // Return the per-worker cached indices to keep the entity index space dense.
+  entity_allocator_rebalance(&storage->entityAllocator);
 }
@@ -18,6 +18,12 @@ typedef struct {
   DynArray       newEntities; // EcsEntityId[].
 
   DynArray archetypes; // EcsArchetype[].
+
+  u32 version;          // Current change-detection version; bumped on every flush.
+  u32 structureVersion; // Bumped whenever the archetype structure changes.
+
+  ThreadSpinLock    snapshotLock; // Guards the chunk sharing state of the snapshot.
+  EcsWorldSnapshot* snapshot;     // Currently active snapshot (null if none).
 } EcsStorage;
 
 i8 ecs_compare_archetype(const void* a, const void* b);
@@ -38,6 +44,15 @@ void           ecs_storage_entity_move(EcsStorage*, EcsEntityId, EcsArchetypeId
 void           ecs_storage_entity_reset(EcsStorage*, EcsEntityId);
 void           ecs_storage_entity_destroy(EcsStorage*, EcsEntityId);
 
+/**
+ * Move a batch of entities that share the same current archetype to a new archetype.
+ * Performs the component copies as bulk per-chunk copies where possible.
+ * NOTE: The 'ids' array will be reordered (sorted on the current archetype index).
+ */
+void ecs_storage_entity_move_batch(
+    EcsStorage*, EcsArchetypeId oldArchetypeId, EcsArchetypeId newArchetypeId, EcsEntityId* ids,
+    u32 count);
+
 u32            ecs_storage_archetype_count(const EcsStorage*);
 u32            ecs_storage_archetype_count_empty(const EcsStorage*);
 u32            ecs_storage_archetype_count_with_comp(const EcsStorage*, EcsCompId);
@@ -55,6 +70,44 @@ EcsArchetypeId ecs_storage_archetype_create(EcsStorage*, BitSet mask);
 bool ecs_storage_itr_walk(EcsStorage*, EcsIterator*, EcsArchetypeId);
 void ecs_storage_itr_jump(EcsStorage*, EcsIterator*, EcsEntityId);
 
+/**
+ * Re-initialize the iterator pointers at the start of its current chunk.
+ * Needed after 'ecs_storage_chunk_stamp()' indicated the chunk may have been re-allocated.
+ */
+void ecs_storage_itr_refresh_chunk(EcsStorage*, EcsIterator*, EcsArchetypeId);
+
+/**
+ * Snapshot of all component data in the storage at chunk granularity.
+ * Chunks are shared with the live storage and copied when the live storage is about to write to
+ * them (copy-on-write); the snapshot data is thus immutable and can be read concurrently with
+ * mutations on the live storage.
+ */
+EcsWorldSnapshot* ecs_storage_snapshot_take(EcsStorage*);
+void              ecs_storage_snapshot_release(EcsStorage*, EcsWorldSnapshot*);
+
+u32    ecs_storage_snapshot_archetype_count(const EcsWorldSnapshot*);
+BitSet ecs_storage_snapshot_archetype_mask(const EcsWorldSnapshot*, u32 archetypeIdx);
+bool   ecs_storage_snapshot_itr_walk(const EcsWorldSnapshot*, EcsIterator*, u32 archetypeIdx);
+bool   ecs_storage_snapshot_chunk_changed(
+      const EcsWorldSnapshot*, u32 archetypeIdx, u32 chunkIdx, BitSet mask);
+
+/**
+ * Change-detection at chunk granularity.
+ * Stamping marks the given components of a chunk as changed at the current version; the changed
+ * query tests if any of the given components was stamped during this or the previous version.
+ * NOTE: Stamping doubles as the write-barrier for snapshots; when it returns true the chunk may
+ * have been re-allocated and any iterators into it need to be refreshed.
+ */
+void ecs_storage_version_bump(EcsStorage*);
+bool ecs_storage_chunk_stamp(EcsStorage*, EcsArchetypeId, u32 chunkIdx, BitSet mask);
+bool ecs_storage_chunk_changed(const EcsStorage*, EcsArchetypeId, u32 chunkIdx, BitSet mask);
+
+/**
+ * Version that is bumped whenever the archetype structure changes (archetypes being created or
+ * entities entering, leaving or moving between archetypes).
+ */
+u32 ecs_storage_structure_version(const EcsStorage*);
+
 /**
  * Flush any entities that where created since the last call.
  */
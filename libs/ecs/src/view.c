@@ -29,7 +29,7 @@ MAYBE_UNUSED static void ecs_view_validate_random_write(const EcsView* view, con
   (void)sysDef;
 
   diag_assert_msg(
-      sysDef->parallelCount <= 1,
+      sysDef->parallelCount == 1,
       "Parallel system '{}' creates a random-write iterator from view '{}', "
       "this is potentially unsafe",
       fmt_text(sysDef->name),
@@ -117,7 +117,23 @@ Next:
 
   const u16            archIdx = itr->archetypeIdx;
   const EcsArchetypeId id      = *(dynarray_begin_t(&view->archetypes, EcsArchetypeId) + archIdx);
+  const u32            prevChunkIdx = itr->chunkIdx;
   if (LIKELY(ecs_storage_itr_walk(view->storage, itr, id))) {
+    if (UNLIKELY(itr->chunkIdx != prevChunkIdx && (view->filterChanged || view->stampWrite))) {
+      // Entered a new chunk; apply change-detection at chunk granularity.
+      if (view->filterChanged &&
+          !ecs_storage_chunk_changed(
+              view->storage, id, itr->chunkIdx, ecs_view_mask(view, EcsViewMask_FilterChanged))) {
+        itr->chunkRemaining = 0; // Chunk is clean; skip the remaining entities in it.
+        goto Next;
+      }
+      if (view->stampWrite &&
+          ecs_storage_chunk_stamp(
+              view->storage, id, itr->chunkIdx, ecs_view_mask(view, EcsViewMask_AccessWrite))) {
+        // Chunk was re-allocated (copy-on-write for a snapshot); refresh the iterator pointers.
+        ecs_storage_itr_refresh_chunk(view->storage, itr, id);
+      }
+    }
 #ifndef VOLO_RELEASE
     if (UNLIKELY(view->flags & EcsViewFlags_Exclusive)) {
       ecs_view_exclusive_entity_track(view, *itr->entity);
@@ -134,6 +150,53 @@ Next:
   goto Next;
 }
 
+FLATTEN_HINT EcsIterator*
+ecs_view_walk_snapshot(EcsIterator* itr, const EcsWorldSnapshot* snapshot) {
+  EcsView* view = itr->context;
+
+  diag_assert_msg(
+      !view->stampWrite,
+      "View {} has write-access and thus cannot iterate a snapshot",
+      fmt_text(view->viewDef->name));
+
+  const u32 archetypeCount = ecs_storage_snapshot_archetype_count(snapshot);
+
+Next:
+  if (UNLIKELY(itr->archetypeIdx >= archetypeCount)) {
+    return null;
+  }
+
+  /**
+   * Match the archetype masks directly instead of using the view's tracked archetypes; the tracked
+   * set is mutated while the live world flushes, the snapshot archetype set is immutable.
+   */
+  if (!ecs_view_matches(view, ecs_storage_snapshot_archetype_mask(snapshot, itr->archetypeIdx))) {
+    ++itr->archetypeIdx;
+    goto Next;
+  }
+
+  const u32 prevChunkIdx = itr->chunkIdx;
+  if (LIKELY(ecs_storage_snapshot_itr_walk(snapshot, itr, itr->archetypeIdx))) {
+    if (UNLIKELY(itr->chunkIdx != prevChunkIdx && view->filterChanged)) {
+      // Entered a new chunk; apply change-detection at chunk granularity.
+      const BitSet changedMask = ecs_view_mask(view, EcsViewMask_FilterChanged);
+      if (!ecs_storage_snapshot_chunk_changed(
+              snapshot, itr->archetypeIdx, itr->chunkIdx, changedMask)) {
+        itr->chunkRemaining = 0; // Chunk is clean; skip the remaining entities in it.
+        goto Next;
+      }
+    }
+    return itr;
+  }
+
+  if (!itr->chunksLimitRemaining) {
+    return null; // No more chunks allowed to process.
+  }
+
+  ++itr->archetypeIdx;
+  goto Next;
+}
+
 FLATTEN_HINT EcsIterator* ecs_view_jump(EcsIterator* itr, const EcsEntityId entity) {
   diag_assert_msg(!ecs_iterator_is_stepped(itr), "Stepped iterators cannot be jumped");
 
@@ -151,6 +214,14 @@ FLATTEN_HINT EcsIterator* ecs_view_jump(EcsIterator* itr, const EcsEntityId enti
       ecs_entity_fmt(entity));
 
   ecs_storage_itr_jump(view->storage, itr, entity);
+  if (view->stampWrite) {
+    const EcsArchetypeId archId = ecs_storage_entity_archetype(view->storage, entity);
+    if (ecs_storage_chunk_stamp(
+            view->storage, archId, itr->chunkIdx, ecs_view_mask(view, EcsViewMask_AccessWrite))) {
+      // Chunk was re-allocated (copy-on-write for a snapshot); refresh the iterator pointers.
+      ecs_storage_itr_jump(view->storage, itr, entity);
+    }
+  }
   return itr;
 }
 
@@ -168,16 +239,24 @@ FLATTEN_HINT EcsIterator* ecs_view_maybe_jump(EcsIterator* itr, const EcsEntityI
     return null;
   }
   ecs_storage_itr_jump(view->storage, itr, entity);
+  if (view->stampWrite) {
+    const EcsArchetypeId archId = ecs_storage_entity_archetype(view->storage, entity);
+    if (ecs_storage_chunk_stamp(
+            view->storage, archId, itr->chunkIdx, ecs_view_mask(view, EcsViewMask_AccessWrite))) {
+      // Chunk was re-allocated (copy-on-write for a snapshot); refresh the iterator pointers.
+      ecs_storage_itr_jump(view->storage, itr, entity);
+    }
+  }
   return itr;
 }
 
 EcsEntityId ecs_view_entity(const EcsIterator* itr) {
-  diag_assert_msg(itr->entity, "Iterator has not been initialized");
+  diag_assert_hot_msg(itr->entity, "Iterator has not been initialized");
   return *itr->entity;
 }
 
 const void* ecs_view_read(const EcsIterator* itr, const EcsCompId comp) {
-  diag_assert_msg(itr->entity, "Iterator has not been initialized");
+  diag_assert_hot_msg(itr->entity, "Iterator has not been initialized");
 
   if (UNLIKELY(sentinel_check(comp))) {
     return null; // Unregistered component.
@@ -185,7 +264,7 @@ const void* ecs_view_read(const EcsIterator* itr, const EcsCompId comp) {
 
   MAYBE_UNUSED EcsView* view = itr->context;
 
-  diag_assert_msg(
+  diag_assert_hot_msg(
       ecs_comp_has(ecs_view_mask(view, EcsViewMask_AccessRead), comp),
       "View {} does not have read-access to component {}",
       fmt_text(view->viewDef->name),
@@ -195,7 +274,7 @@ const void* ecs_view_read(const EcsIterator* itr, const EcsCompId comp) {
 }
 
 void* ecs_view_write(const EcsIterator* itr, const EcsCompId comp) {
-  diag_assert_msg(itr->entity, "Iterator has not been initialized");
+  diag_assert_hot_msg(itr->entity, "Iterator has not been initialized");
 
   if (UNLIKELY(sentinel_check(comp))) {
     return null; // Unregistered component.
@@ -203,7 +282,7 @@ void* ecs_view_write(const EcsIterator* itr, const EcsCompId comp) {
 
   MAYBE_UNUSED EcsView* view = itr->context;
 
-  diag_assert_msg(
+  diag_assert_hot_msg(
       ecs_comp_has(ecs_view_mask(view, EcsViewMask_AccessWrite), comp),
       "View {} does not have write-access to component {}",
       fmt_text(view->viewDef->name),
@@ -232,7 +311,8 @@ EcsView ecs_view_create(
     Allocator* alloc, EcsStorage* storage, const EcsDef* def, const EcsViewDef* viewDef) {
   diag_assert(alloc && def);
 
-  const Mem masksMem = alloc_alloc(alloc, ecs_comp_mask_size(def) * 4, ecs_comp_mask_align);
+  const Mem masksMem =
+      alloc_alloc(alloc, ecs_comp_mask_size(def) * EcsViewMask_Count, ecs_comp_mask_align);
   mem_set(masksMem, 0);
 
   EcsView view = {
@@ -250,19 +330,23 @@ EcsView ecs_view_create(
       .def           = def,
       .filterWith    = ecs_view_mask(&view, EcsViewMask_FilterWith),
       .filterWithout = ecs_view_mask(&view, EcsViewMask_FilterWithout),
+      .filterChanged = ecs_view_mask(&view, EcsViewMask_FilterChanged),
       .accessRead    = ecs_view_mask(&view, EcsViewMask_AccessRead),
       .accessWrite   = ecs_view_mask(&view, EcsViewMask_AccessWrite),
   };
 
   viewDef->initRoutine(&viewBuilder);
 
-  view.compCount = ecs_comp_mask_count(ecs_view_mask(&view, EcsViewMask_AccessRead));
-  view.flags     = viewBuilder.flags;
+  view.compCount           = ecs_comp_mask_count(ecs_view_mask(&view, EcsViewMask_AccessRead));
+  view.flags               = viewBuilder.flags;
+  view.stampWrite          = bitset_any(ecs_view_mask(&view, EcsViewMask_AccessWrite));
+  view.filterChanged       = bitset_any(ecs_view_mask(&view, EcsViewMask_FilterChanged));
+  view.filterWithSignature = ecs_comp_mask_signature(ecs_view_mask(&view, EcsViewMask_FilterWith));
   return view;
 }
 
 void ecs_view_destroy(Allocator* alloc, const EcsDef* def, EcsView* view) {
-  alloc_free(alloc, mem_create(view->masks.ptr, ecs_comp_mask_size(def) * 4));
+  alloc_free(alloc, mem_create(view->masks.ptr, ecs_comp_mask_size(def) * EcsViewMask_Count));
   dynarray_destroy(&view->archetypes);
 #ifndef VOLO_RELEASE
   dynarray_destroy(&view->exclusiveEntities);
@@ -315,7 +399,11 @@ bool ecs_view_conflict(const EcsView* a, const EcsView* b) {
   return false; // No conflict.
 }
 
-bool ecs_view_maybe_track(EcsView* view, const EcsArchetypeId id, const BitSet mask) {
+bool ecs_view_maybe_track(
+    EcsView* view, const EcsArchetypeId id, const BitSet mask, const u64 maskSignature) {
+  if ((maskSignature & view->filterWithSignature) != view->filterWithSignature) {
+    return false; // Cheap signature reject: archetype is missing a required component.
+  }
   if (ecs_view_matches(view, mask)) {
     *dynarray_insert_sorted_t(&view->archetypes, EcsArchetypeId, ecs_compare_archetype, &id) = id;
     return true;
@@ -8,8 +8,11 @@
 typedef enum {
   EcsViewMask_FilterWith,
   EcsViewMask_FilterWithout,
+  EcsViewMask_FilterChanged,
   EcsViewMask_AccessRead,
   EcsViewMask_AccessWrite,
+
+  EcsViewMask_Count,
 } EcsViewMaskType;
 
 struct sEcsView {
@@ -17,9 +20,12 @@ struct sEcsView {
   const EcsViewDef* viewDef;
   EcsViewFlags      flags;
   u16               compCount;
+  bool              stampWrite;    // Stamp change-versions of written components while iterating.
+  bool              filterChanged; // Skip chunks whose filter-changed components are clean.
   EcsStorage*       storage;
   Mem               masks;
-  DynArray          archetypes; // EcsArchetypeId[] (NOTE: kept sorted)
+  u64               filterWithSignature; // Signature of the filter-with mask; used as pre-filter.
+  DynArray          archetypes;          // EcsArchetypeId[] (NOTE: kept sorted)
 #ifndef VOLO_RELEASE
   DynArray exclusiveEntities; // EcsEntityId[] (NOTE: kept sorted).
 #endif
@@ -29,4 +35,4 @@ EcsView ecs_view_create(Allocator*, EcsStorage*, const EcsDef*, const EcsViewDef
 void    ecs_view_destroy(Allocator*, const EcsDef*, EcsView*);
 BitSet  ecs_view_mask(const EcsView*, EcsViewMaskType);
 bool    ecs_view_conflict(const EcsView* a, const EcsView* b);
-bool    ecs_view_maybe_track(EcsView*, EcsArchetypeId, BitSet mask);
+bool    ecs_view_maybe_track(EcsView*, EcsArchetypeId, BitSet mask, u64 maskSignature);
@@ -1,5 +1,6 @@
 #include "core/alloc.h"
 #include "core/diag.h"
+#include "core/sort.h"
 #include "ecs/entity.h"
 #include "ecs/runner.h"
 #include "log/logger.h"
@@ -8,6 +9,7 @@
 #include "buffer.h"
 #include "def.h"
 #include "finalizer.h"
+#include "relation.h"
 #include "storage.h"
 #include "view.h"
 #include "world.h"
@@ -20,13 +22,12 @@ typedef enum {
 } EcsWorldFlags;
 
 struct sEcsWorld {
-  const EcsDef* def;
-  EcsFinalizer  finalizer;
-  EcsStorage    storage;
-  DynArray      views; // EcsView[].
-
-  ThreadSpinLock bufferLock;
-  EcsBuffer      buffer;
+  const EcsDef*    def;
+  EcsFinalizer     finalizer;
+  EcsStorage       storage;
+  DynArray         views; // EcsView[].
+  EcsBuffer        buffer;
+  EcsRelationIndex relations;
 
   EcsWorldFlags flags;
   EcsEntityId   globalEntity;
@@ -35,11 +36,35 @@ struct sEcsWorld {
   u32 lastFlushEntities;
 };
 
+typedef struct {
+  EcsArchetypeId oldArchetype, newArchetype;
+  EcsEntityId    entity;
+} EcsWorldMove;
+
+/**
+ * Order moves on their (source, destination) archetype pair so they can be batched per pair.
+ * Ties are broken on the entity id to keep the order deterministic (the sort is not stable).
+ */
+static i8 ecs_world_compare_move(const void* a, const void* b) {
+  const EcsWorldMove* moveA = a;
+  const EcsWorldMove* moveB = b;
+  if (moveA->oldArchetype != moveB->oldArchetype) {
+    return moveA->oldArchetype < moveB->oldArchetype ? -1 : 1;
+  }
+  if (moveA->newArchetype != moveB->newArchetype) {
+    return moveA->newArchetype < moveB->newArchetype ? -1 : 1;
+  }
+  return moveA->entity < moveB->entity ? -1 : moveA->entity > moveB->entity ? 1 : 0;
+}
+
 static usize
 ecs_world_archetype_track(EcsWorld* world, const EcsArchetypeId id, const BitSet mask) {
+  // Compute the mask signature once; views use it to cheaply reject non-matching archetypes.
+  const u64 maskSignature = ecs_comp_mask_signature(mask);
+
   usize trackingViews = 0;
   dynarray_for_t(&world->views, EcsView, view) {
-    if (ecs_view_maybe_track(view, id, mask)) {
+    if (ecs_view_maybe_track(view, id, mask, maskSignature)) {
       ++trackingViews;
     }
   }
@@ -92,6 +117,13 @@ static void ecs_world_apply_added_comps(
   EcsIterator* storageItr = ecs_iterator_stack(addedComps);
   ecs_storage_itr_jump(storage, storageItr, entity);
 
+  // Mark the added components as changed in the entity's chunk.
+  const EcsArchetypeId archId = ecs_storage_entity_archetype(storage, entity);
+  if (ecs_storage_chunk_stamp(storage, archId, storageItr->chunkIdx, addedComps)) {
+    // Chunk was re-allocated (copy-on-write for a snapshot); refresh the iterator pointers.
+    ecs_storage_itr_jump(storage, storageItr, entity);
+  }
+
   for (EcsBufferCompData* bufferItr = ecs_buffer_comp_begin(buffer, idx); bufferItr;
        bufferItr                    = ecs_buffer_comp_next(bufferItr)) {
 
@@ -191,7 +223,7 @@ static void ecs_world_validate_sys_parallel(const EcsWorld* world, const EcsSyst
 
 static void ecs_world_validate_init(const EcsWorld* world) {
   dynarray_for_t(&world->def->systems, EcsSystemDef, sysDef) {
-    if (sysDef->parallelCount > 1) {
+    if (sysDef->parallelCount != 1) {
       ecs_world_validate_sys_parallel(world, sysDef);
     }
   }
@@ -208,6 +240,7 @@ EcsWorld* ecs_world_create(Allocator* alloc, const EcsDef* def) {
                .storage   = ecs_storage_create(alloc, def),
                .views     = dynarray_create_t(alloc, EcsView, ecs_def_view_count(def)),
                .buffer    = ecs_buffer_create(alloc, def),
+               .relations = ecs_relation_index_create(alloc, def),
                .alloc     = alloc,
   };
   world->globalEntity = ecs_storage_entity_create(&world->storage);
@@ -245,6 +278,7 @@ void ecs_world_destroy(EcsWorld* world) {
 
   ecs_storage_destroy(&world->storage);
   ecs_buffer_destroy(&world->buffer);
+  ecs_relation_index_destroy(&world->relations);
 
   dynarray_for_t(&world->views, EcsView, view) { ecs_view_destroy(world->alloc, world->def, view); }
   dynarray_destroy(&world->views);
@@ -290,9 +324,7 @@ void ecs_world_entity_reset(EcsWorld* world, const EcsEntityId entity) {
       "Unable to enqueue reset of entity {}, reason: entity does not exist",
       ecs_entity_fmt(entity));
 
-  thread_spinlock_lock(&world->bufferLock);
   ecs_buffer_reset_entity(&world->buffer, entity);
-  thread_spinlock_unlock(&world->bufferLock);
 }
 
 void ecs_world_entity_destroy(EcsWorld* world, const EcsEntityId entity) {
@@ -305,9 +337,7 @@ void ecs_world_entity_destroy(EcsWorld* world, const EcsEntityId entity) {
       "Unable to enqueue destruction of entity {}, reason: entity does not exist",
       ecs_entity_fmt(entity));
 
-  thread_spinlock_lock(&world->bufferLock);
   ecs_buffer_destroy_entity(&world->buffer, entity);
-  thread_spinlock_unlock(&world->bufferLock);
 }
 
 bool ecs_world_exists(const EcsWorld* world, const EcsEntityId entity) {
@@ -346,10 +376,7 @@ void* ecs_world_add(
       fmt_text(ecs_def_comp_name(world->def, comp)),
       ecs_entity_fmt(entity));
 
-  thread_spinlock_lock(&world->bufferLock);
-  void* result = ecs_buffer_comp_add(&world->buffer, entity, comp, data);
-  thread_spinlock_unlock(&world->bufferLock);
-  return result;
+  return ecs_buffer_comp_add(&world->buffer, entity, comp, data);
 }
 
 void ecs_world_remove(EcsWorld* world, const EcsEntityId entity, const EcsCompId comp) {
@@ -369,9 +396,16 @@ void ecs_world_remove(EcsWorld* world, const EcsEntityId entity, const EcsCompId
       fmt_text(ecs_def_comp_name(world->def, comp)),
       ecs_entity_fmt(entity));
 
-  thread_spinlock_lock(&world->bufferLock);
   ecs_buffer_comp_remove(&world->buffer, entity, comp);
-  thread_spinlock_unlock(&world->bufferLock);
+}
+
+EcsWorldChildren
+ecs_world_children(const EcsWorld* world, const EcsEntityId parent, const EcsCompId comp) {
+  diag_assert(!ecs_world_busy(world) || g_ecsRunningSystem);
+  diag_assert_msg(ecs_entity_valid(parent), "{} is an invalid entity", ecs_entity_fmt(parent));
+  diag_assert_msg(!sentinel_check(comp), "Component has not been registered");
+
+  return ecs_relation_index_query(&world->relations, comp, parent);
 }
 
 EcsArchetypeId ecs_world_entity_archetype(const EcsWorld* world, const EcsEntityId entity) {
@@ -398,6 +432,20 @@ void ecs_world_flush(EcsWorld* world) {
   ecs_world_flush_internal(world);
 }
 
+EcsWorldSnapshot* ecs_world_snapshot_take(EcsWorld* world) {
+  diag_assert_msg(!g_ecsRunningSystem, "Snapshots cannot be taken from a system");
+  diag_assert(!ecs_world_busy(world));
+
+  return ecs_storage_snapshot_take(&world->storage);
+}
+
+void ecs_world_snapshot_release(EcsWorld* world, EcsWorldSnapshot* snapshot) {
+  diag_assert_msg(!g_ecsRunningSystem, "Snapshots cannot be released from a system");
+  diag_assert(!ecs_world_busy(world));
+
+  ecs_storage_snapshot_release(&world->storage, snapshot);
+}
+
 const EcsView* ecs_world_view_storage_internal(const EcsWorld* world) {
   return dynarray_begin_t(&world->views, EcsView);
 }
@@ -414,10 +462,18 @@ void ecs_world_busy_unset(EcsWorld* world) {
 
 void ecs_world_flush_internal(EcsWorld* world) {
 
+  // Age the change-detection stamps; modifications applied below count towards the new version.
+  ecs_storage_version_bump(&world->storage);
+
   trace_begin("ecs_flush_new", TraceColor_White);
   ecs_storage_flush_new_entities(&world->storage);
   trace_end();
 
+  // Collate the modifications recorded in the per-worker buffer segments into the entity list.
+  trace_begin("ecs_flush_collate", TraceColor_White);
+  ecs_buffer_collate(&world->buffer);
+  trace_end();
+
   BitSet      tmpMask     = ecs_comp_mask_stack(world->def);
   const usize bufferCount = ecs_buffer_count(&world->buffer);
 
@@ -445,31 +501,84 @@ void ecs_world_flush_internal(EcsWorld* world) {
 
   /**
    * Move entities to their new archetypes and apply the added components.
+   * Moves are grouped per (source, destination) archetype pair so they can be performed as bulk
+   * per-chunk copies instead of individual entity moves.
    */
   trace_begin("ecs_flush_move", TraceColor_White);
-  for (usize i = 0; i != bufferCount; ++i) {
-    const EcsEntityId          entity = ecs_buffer_entity(&world->buffer, i);
-    const EcsBufferEntityFlags flags  = ecs_buffer_entity_flags(&world->buffer, i);
+  if (bufferCount) {
+    EcsWorldMove*   moves         = alloc_array_t(g_allocHeap, EcsWorldMove, bufferCount);
+    EcsArchetypeId* oldArchetypes = alloc_array_t(g_allocHeap, EcsArchetypeId, bufferCount);
+    EcsEntityId*    moveEntities  = alloc_array_t(g_allocHeap, EcsEntityId, bufferCount);
+
+    usize moveCount = 0;
+    for (usize i = 0; i != bufferCount; ++i) {
+      const EcsEntityId          entity = ecs_buffer_entity(&world->buffer, i);
+      const EcsBufferEntityFlags flags  = ecs_buffer_entity_flags(&world->buffer, i);
+
+      if (flags & EcsBufferEntityFlags_Destroy) {
+        ecs_storage_entity_destroy(&world->storage, entity);
+        continue;
+      }
+      if (flags & EcsBufferEntityFlags_Reset) {
+        ecs_storage_entity_reset(&world->storage, entity);
+        continue;
+      }
+      const BitSet curCompMask = ecs_storage_entity_mask(&world->storage, entity);
+      oldArchetypes[i]         = ecs_storage_entity_archetype(&world->storage, entity);
+      ecs_world_new_comps_mask(&world->buffer, i, curCompMask, tmpMask);
+
+      const EcsArchetypeId newArchetype = ecs_world_archetype_find_or_create(world, tmpMask);
+      if (newArchetype != oldArchetypes[i]) {
+        moves[moveCount++] = (EcsWorldMove){
+            .oldArchetype = oldArchetypes[i],
+            .newArchetype = newArchetype,
+            .entity       = entity,
+        };
+      }
+    }
 
-    if (flags & EcsBufferEntityFlags_Destroy) {
-      ecs_storage_entity_destroy(&world->storage, entity);
-      continue;
+    sort_quicksort_t(moves, moves + moveCount, EcsWorldMove, ecs_world_compare_move);
+
+    for (usize i = 0; i != moveCount;) {
+      usize groupEnd = i + 1;
+      while (groupEnd != moveCount && moves[groupEnd].oldArchetype == moves[i].oldArchetype &&
+             moves[groupEnd].newArchetype == moves[i].newArchetype) {
+        ++groupEnd;
+      }
+      for (usize j = i; j != groupEnd; ++j) {
+        moveEntities[j - i] = moves[j].entity;
+      }
+      ecs_storage_entity_move_batch(
+          &world->storage,
+          moves[i].oldArchetype,
+          moves[i].newArchetype,
+          moveEntities,
+          (u32)(groupEnd - i));
+      i = groupEnd;
     }
-    if (flags & EcsBufferEntityFlags_Reset) {
-      ecs_storage_entity_reset(&world->storage, entity);
-      continue;
+
+    for (usize i = 0; i != bufferCount; ++i) {
+      const EcsBufferEntityFlags flags = ecs_buffer_entity_flags(&world->buffer, i);
+      if (flags & (EcsBufferEntityFlags_Reset | EcsBufferEntityFlags_Destroy)) {
+        continue;
+      }
+      const BitSet oldMask = ecs_storage_archetype_mask(&world->storage, oldArchetypes[i]);
+      ecs_world_apply_added_comps(&world->storage, &world->buffer, i, oldMask);
     }
-    const BitSet curCompMask = ecs_storage_entity_mask(&world->storage, entity);
-    ecs_world_new_comps_mask(&world->buffer, i, curCompMask, tmpMask);
 
-    const EcsArchetypeId newArchetype = ecs_world_archetype_find_or_create(world, tmpMask);
-    ecs_storage_entity_move(&world->storage, entity, newArchetype);
-    ecs_world_apply_added_comps(&world->storage, &world->buffer, i, curCompMask);
+    alloc_free_array_t(g_allocHeap, moves, bufferCount);
+    alloc_free_array_t(g_allocHeap, oldArchetypes, bufferCount);
+    alloc_free_array_t(g_allocHeap, moveEntities, bufferCount);
   }
   trace_end();
 
   ecs_buffer_clear(&world->buffer);
 
+  // Rebuild the relation reverse-index to reflect the new storage contents.
+  trace_begin("ecs_flush_relations", TraceColor_White);
+  ecs_relation_index_rebuild(&world->relations, &world->storage);
+  trace_end();
+
 #ifndef VOLO_RELEASE
   trace_begin("ecs_flush_validate", TraceColor_White);
   ecs_world_validate_exclusive_entities(world);
@@ -534,6 +643,10 @@ u32 ecs_world_archetype_chunks(const EcsWorld* world, const EcsArchetypeId arche
   return ecs_storage_archetype_chunks(&world->storage, archetypeId);
 }
 
+u32 ecs_world_structure_version(const EcsWorld* world) {
+  return ecs_storage_structure_version(&world->storage);
+}
+
 u32 ecs_world_entity_count_with_comp(const EcsWorld* world, const EcsCompId comp) {
   return ecs_storage_entity_count_with_comp(&world->storage, comp);
 }
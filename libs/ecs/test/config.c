@@ -7,6 +7,7 @@ void app_check_init(CheckDef* check) {
   register_spec(check, destruct);
   register_spec(check, entity);
   register_spec(check, graph);
+  register_spec(check, relation);
   register_spec(check, runner);
   register_spec(check, storage);
   register_spec(check, utils);
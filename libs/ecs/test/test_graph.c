@@ -42,6 +42,7 @@ ecs_system_define(GraphSys3) {}
 ecs_system_define(GraphSys4) {}
 ecs_system_define(GraphSys5) {}
 ecs_system_define(GraphSys6) {}
+ecs_system_define(GraphSys7) {}
 
 ecs_module_init(graph_test_module) {
   ecs_register_comp(GraphCompA);
@@ -73,6 +74,10 @@ ecs_module_init(graph_test_module) {
   ecs_register_system(GraphSys6, ecs_view_id(ReadABC));
   ecs_order(GraphSys6, 6);
   ecs_parallel(GraphSys6, 4);
+
+  ecs_register_system(GraphSys7, ecs_view_id(ReadABC));
+  ecs_order(GraphSys7, 7);
+  ecs_parallel(GraphSys7, ecs_parallel_auto);
 }
 
 spec(graph) {
@@ -147,6 +152,14 @@ spec(graph) {
     }
   }
 
+  it("creates a single task for automatic parallel systems on an empty world") {
+    const EcsTaskSet sys7Tasks     = ecs_runner_task_set(runner, ecs_system_id(GraphSys7));
+    const u32        sys7TaskCount = sys7Tasks.end - sys7Tasks.begin;
+
+    // With no entities there are no storage chunks to slice, so a single task suffices.
+    check_eq_int(sys7TaskCount, 1);
+  }
+
   teardown() {
     ecs_runner_destroy(runner);
     ecs_world_destroy(world);
@@ -0,0 +1,134 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "ecs/def.h"
+#include "ecs/world.h"
+
+ecs_comp_define(RelationAttachComp) {
+  u32         f1;
+  EcsEntityId target;
+};
+
+ecs_comp_define(RelationOtherComp) { EcsEntityId target; };
+
+ecs_module_init(relation_test_module) {
+  ecs_register_comp(RelationAttachComp);
+  ecs_relation(RelationAttachComp, target);
+
+  ecs_register_comp(RelationOtherComp);
+  ecs_relation(RelationOtherComp, target);
+}
+
+spec(relation) {
+
+  EcsDef*   def   = null;
+  EcsWorld* world = null;
+
+  setup() {
+    def = ecs_def_create(g_allocHeap);
+    ecs_register_module(def, relation_test_module);
+
+    world = ecs_world_create(g_allocHeap, def);
+  }
+
+  it("reports no children for an entity that is not referenced") {
+    const EcsEntityId entity = ecs_world_entity_create(world);
+    ecs_world_flush(world);
+
+    const EcsWorldChildren children = ecs_world_children_t(world, entity, RelationAttachComp);
+    check_eq_int(children.count, 0);
+  }
+
+  it("collects the entities that reference a parent") {
+    const EcsEntityId parent = ecs_world_entity_create(world);
+    const EcsEntityId childA = ecs_world_entity_create(world);
+    const EcsEntityId childB = ecs_world_entity_create(world);
+    const EcsEntityId other  = ecs_world_entity_create(world);
+
+    ecs_world_add_t(world, childA, RelationAttachComp, .target = parent);
+    ecs_world_add_t(world, childB, RelationAttachComp, .target = parent);
+    ecs_world_add_t(world, other, RelationAttachComp); // Unset reference; not indexed.
+
+    ecs_world_flush(world);
+
+    const EcsWorldChildren children = ecs_world_children_t(world, parent, RelationAttachComp);
+    check_require(children.count == 2);
+
+    // Children are sorted on their entity id.
+    check(children.values[0] == (childA < childB ? childA : childB));
+    check(children.values[1] == (childA < childB ? childB : childA));
+  }
+
+  it("indexes relations per component") {
+    const EcsEntityId parent = ecs_world_entity_create(world);
+    const EcsEntityId child  = ecs_world_entity_create(world);
+
+    ecs_world_add_t(world, child, RelationAttachComp, .target = parent);
+
+    ecs_world_flush(world);
+
+    check_eq_int(ecs_world_children_t(world, parent, RelationAttachComp).count, 1);
+    check_eq_int(ecs_world_children_t(world, parent, RelationOtherComp).count, 0);
+  }
+
+  it("reflects modifications after the next flush") {
+    const EcsEntityId parentA = ecs_world_entity_create(world);
+    const EcsEntityId parentB = ecs_world_entity_create(world);
+    const EcsEntityId child   = ecs_world_entity_create(world);
+
+    ecs_world_add_t(world, child, RelationAttachComp, .target = parentA);
+    ecs_world_flush(world);
+
+    check_eq_int(ecs_world_children_t(world, parentA, RelationAttachComp).count, 1);
+    check_eq_int(ecs_world_children_t(world, parentB, RelationAttachComp).count, 0);
+
+    ecs_world_remove_t(world, child, RelationAttachComp);
+    ecs_world_flush(world);
+
+    check_eq_int(ecs_world_children_t(world, parentA, RelationAttachComp).count, 0);
+
+    ecs_world_add_t(world, child, RelationAttachComp, .target = parentB);
+    ecs_world_flush(world);
+
+    check_eq_int(ecs_world_children_t(world, parentA, RelationAttachComp).count, 0);
+    check_eq_int(ecs_world_children_t(world, parentB, RelationAttachComp).count, 1);
+  }
+
+  it("removes children when their entity is destroyed") {
+    const EcsEntityId parent = ecs_world_entity_create(world);
+    const EcsEntityId child  = ecs_world_entity_create(world);
+
+    ecs_world_add_t(world, child, RelationAttachComp, .target = parent);
+    ecs_world_flush(world);
+
+    check_eq_int(ecs_world_children_t(world, parent, RelationAttachComp).count, 1);
+
+    ecs_world_entity_destroy(world, child);
+    ecs_world_flush(world);
+
+    check_eq_int(ecs_world_children_t(world, parent, RelationAttachComp).count, 0);
+  }
+
+  it("can index many children for a single parent") {
+    static const u32 g_childCount = 567;
+
+    const EcsEntityId parent = ecs_world_entity_create(world);
+    for (u32 i = 0; i != g_childCount; ++i) {
+      const EcsEntityId child = ecs_world_entity_create(world);
+      ecs_world_add_t(world, child, RelationAttachComp, .target = parent);
+    }
+    ecs_world_flush(world);
+
+    const EcsWorldChildren children = ecs_world_children_t(world, parent, RelationAttachComp);
+    check_require(children.count == g_childCount);
+
+    // Children are sorted on their entity id.
+    for (u32 i = 1; i != children.count; ++i) {
+      check(children.values[i - 1] < children.values[i]);
+    }
+  }
+
+  teardown() {
+    ecs_world_destroy(world);
+    ecs_def_destroy(def);
+  }
+}
@@ -19,6 +19,13 @@ ecs_view_define(ReadAB) {
 
 ecs_view_define(WriteC) { ecs_access_write(ViewCompC); }
 
+ecs_view_define(ReadC) { ecs_access_read(ViewCompC); }
+
+ecs_view_define(ReadChangedC) {
+  ecs_access_read(ViewCompC);
+  ecs_access_changed(ViewCompC);
+}
+
 ecs_view_define(ReadAMaybeC) {
   ecs_access_read(ViewCompA);
   ecs_access_maybe_read(ViewCompC);
@@ -44,6 +51,8 @@ ecs_module_init(view_test_module) {
 
   ecs_register_view(ReadAB);
   ecs_register_view(WriteC);
+  ecs_register_view(ReadC);
+  ecs_register_view(ReadChangedC);
   ecs_register_view(ReadAMaybeC);
   ecs_register_view(ReadMaybeAMaybeBMaybeC);
   ecs_register_view(ViewReadUnregistered);
@@ -106,6 +115,51 @@ spec(view) {
     check_eq_int(ecs_view_chunks(view), 2);
   }
 
+  it("can skip entities whose components have not recently changed") {
+    const EcsEntityId entity = ecs_world_entity_create(world);
+    ecs_world_add_t(world, entity, ViewCompC, .f1 = 42);
+    ecs_world_flush(world);
+
+    EcsView* changedView = ecs_world_view_t(world, ReadChangedC);
+    u32      count       = 0;
+
+    // The component addition counts as a change.
+    for (EcsIterator* itr = ecs_view_itr(changedView); ecs_view_walk(itr);) {
+      ++count;
+    }
+    check_eq_int(count, 1);
+
+    // Changes age out after two flushes without any write access.
+    ecs_world_flush(world);
+    ecs_world_flush(world);
+    count = 0;
+    for (EcsIterator* itr = ecs_view_itr(changedView); ecs_view_walk(itr);) {
+      ++count;
+    }
+    check_eq_int(count, 0);
+
+    // Iterating through a view with only read access does not count as a change.
+    for (EcsIterator* itr = ecs_view_itr(ecs_world_view_t(world, ReadC)); ecs_view_walk(itr);) {
+      check_eq_int(ecs_view_read_t(itr, ViewCompC)->f1, 42);
+    }
+    count = 0;
+    for (EcsIterator* itr = ecs_view_itr(changedView); ecs_view_walk(itr);) {
+      ++count;
+    }
+    check_eq_int(count, 0);
+
+    // Iterating through a view with write access does count as a change.
+    for (EcsIterator* itr = ecs_view_itr(ecs_world_view_t(world, WriteC)); ecs_view_walk(itr);) {
+      ecs_view_write_t(itr, ViewCompC)->f1 = 1337;
+    }
+    count = 0;
+    for (EcsIterator* itr = ecs_view_itr(changedView); ecs_view_walk(itr);) {
+      check_eq_int(ecs_view_read_t(itr, ViewCompC)->f1, 1337);
+      ++count;
+    }
+    check_eq_int(count, 1);
+  }
+
   it("can read component values on entities") {
     const EcsEntityId entity = ecs_world_entity_create(world);
 
@@ -439,6 +493,71 @@ spec(view) {
     dynbitset_destroy(&seenEntities);
   }
 
+  it("can iterate over entities in a world snapshot") {
+    const EcsEntityId entityA = ecs_world_entity_create(world);
+    const EcsEntityId entityB = ecs_world_entity_create(world);
+
+    ecs_world_add_t(world, entityA, ViewCompC, .f1 = 1);
+    ecs_world_add_t(world, entityB, ViewCompC, .f1 = 2);
+
+    ecs_world_flush(world);
+
+    EcsWorldSnapshot* snapshot = ecs_world_snapshot_take(world);
+
+    EcsView*     view = ecs_world_view_t(world, ReadC);
+    EcsIterator* itr  = ecs_view_itr(view);
+    check_require(ecs_view_walk_snapshot(itr, snapshot) && ecs_view_entity(itr) == entityA);
+    check_eq_int(ecs_view_read_t(itr, ViewCompC)->f1, 1);
+    check_require(ecs_view_walk_snapshot(itr, snapshot) && ecs_view_entity(itr) == entityB);
+    check_eq_int(ecs_view_read_t(itr, ViewCompC)->f1, 2);
+    check(!ecs_view_walk_snapshot(itr, snapshot));
+
+    ecs_world_snapshot_release(world, snapshot);
+  }
+
+  it("keeps observing the original data in a snapshot while the live world mutates") {
+    const EcsEntityId entityA = ecs_world_entity_create(world);
+    const EcsEntityId entityB = ecs_world_entity_create(world);
+
+    ecs_world_add_t(world, entityA, ViewCompC, .f1 = 1);
+    ecs_world_add_t(world, entityB, ViewCompC, .f1 = 2);
+
+    ecs_world_flush(world);
+
+    EcsWorldSnapshot* snapshot = ecs_world_snapshot_take(world);
+
+    // Mutate the live world; the written chunk is copied so the snapshot keeps the original.
+    for (EcsIterator* itr = ecs_view_itr(ecs_world_view_t(world, WriteC)); ecs_view_walk(itr);) {
+      ecs_view_write_t(itr, ViewCompC)->f1 *= 10;
+    }
+    ecs_world_entity_destroy(world, entityB);
+    ecs_world_flush(world);
+
+    // The live world observes the new values and the destroyed entity is gone.
+    EcsView*     readView = ecs_world_view_t(world, ReadC);
+    EcsIterator* liveItr  = ecs_view_itr(readView);
+    check_require(ecs_view_walk(liveItr) && ecs_view_entity(liveItr) == entityA);
+    check_eq_int(ecs_view_read_t(liveItr, ViewCompC)->f1, 10);
+    check(!ecs_view_walk(liveItr));
+
+    // The snapshot still observes the state from when it was taken.
+    EcsIterator* snapshotItr = ecs_view_itr(readView);
+    check_require(ecs_view_walk_snapshot(snapshotItr, snapshot));
+    check(ecs_view_entity(snapshotItr) == entityA);
+    check_eq_int(ecs_view_read_t(snapshotItr, ViewCompC)->f1, 1);
+    check_require(ecs_view_walk_snapshot(snapshotItr, snapshot));
+    check(ecs_view_entity(snapshotItr) == entityB);
+    check_eq_int(ecs_view_read_t(snapshotItr, ViewCompC)->f1, 2);
+    check(!ecs_view_walk_snapshot(snapshotItr, snapshot));
+
+    ecs_world_snapshot_release(world, snapshot);
+
+    // Releasing the snapshot does not affect the live world.
+    liveItr = ecs_view_itr(readView);
+    check_require(ecs_view_walk(liveItr) && ecs_view_entity(liveItr) == entityA);
+    check_eq_int(ecs_view_read_t(liveItr, ViewCompC)->f1, 10);
+  }
+
   teardown() {
     ecs_world_destroy(world);
     ecs_def_destroy(def);
@@ -542,6 +542,8 @@ typedef struct {
   GapWindowId       id;
   GapVector         params[GapParam_Count];
   GapVector         centerPos;
+  GapVector         cursorRaw; // Last cursor position as reported by X (so top-left based).
+  bool              cursorQueryPending;
   GapPalWindowFlags flags : 16;
   GapIcon           icon : 8;
   GapCursor         cursor : 8;
@@ -1692,6 +1694,7 @@ static GapVector pal_query_cursor_pos(GapPal* pal, const GapWindowId winId) {
         log_param("error", fmt_int(err->errorCode)));
     goto Return;
   }
+  window->cursorRaw = gap_vector(data->winX, data->winY);
 
   // Xcb uses top-left as opposed to bottom-left, so we have to remap the y coordinate.
   result = (GapVector){
@@ -2111,9 +2114,11 @@ void gap_pal_update(GapPal* pal) {
       const XcbFocusEvent* focusInMsg = (const void*)evt;
       pal_event_focus_gained(pal, focusInMsg->event);
 
-      if (pal_maybe_window(pal, focusInMsg->event)) {
+      GapPalWindow* window = pal_maybe_window(pal, focusInMsg->event);
+      if (window) {
         // Update the cursor as it was probably moved since we where focused last.
-        pal_event_cursor(pal, focusInMsg->event, pal_query_cursor_pos(pal, focusInMsg->event));
+        // NOTE: Deferred until after the event drain to avoid a round-trip per event.
+        window->cursorQueryPending = true;
       }
     } break;
 
@@ -2143,8 +2148,16 @@ void gap_pal_update(GapPal* pal) {
         pal_xcb_cursor_grab(&pal->xcb, configureMsg->window);
       }
 
-      // Update the cursor position.
-      pal_event_cursor(pal, configureMsg->window, pal_query_cursor_pos(pal, configureMsg->window));
+      // Recompute the (bottom-left based) cursor position for the new window size from the last
+      // position reported by X; avoids a synchronous pointer query per configure event.
+      GapPalWindow* window = pal_maybe_window(pal, configureMsg->window);
+      if (window) {
+        const GapVector cursorPos = {
+            .x = window->cursorRaw.x,
+            .y = newSize.height - window->cursorRaw.y,
+        };
+        pal_event_cursor(pal, configureMsg->window, cursorPos);
+      }
 
     } break;
 
@@ -2152,6 +2165,8 @@ void gap_pal_update(GapPal* pal) {
       const XcbMotionNotifyEvent* motionMsg = (const void*)evt;
       GapPalWindow*               window    = pal_maybe_window(pal, motionMsg->event);
       if (window) {
+        window->cursorRaw = gap_vector(motionMsg->eventX, motionMsg->eventY);
+
         // Xcb uses top-left as opposed to bottom-left, so we have to remap the y coordinate.
         const GapVector newPos = {
             motionMsg->eventX,
@@ -2305,6 +2320,14 @@ void gap_pal_update(GapPal* pal) {
       }
     }
   }
+
+  // Perform the deferred cursor queries; at most a single round-trip per window per update.
+  dynarray_for_t(&pal->windows, GapPalWindow, window) {
+    if (window->cursorQueryPending) {
+      window->cursorQueryPending = false;
+      pal_event_cursor(pal, window->id, pal_query_cursor_pos(pal, window->id));
+    }
+  }
 }
 
 void gap_pal_flush(GapPal* pal) {
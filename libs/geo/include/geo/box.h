@@ -67,6 +67,17 @@ void geo_box_corners3(const GeoBox*, GeoVector corners[PARAM_ARRAY_SIZE(8)]);
  */
 GeoBox geo_box_transform3(const GeoBox*, GeoVector offset, GeoQuat rotation, f32 scale);
 
+/**
+ * Construct a batch of transformed 3d boxes (one offset / rotation / scale per box).
+ */
+void geo_box_transform3_batch(
+    const GeoBox*    boxes,
+    const GeoVector* offsets,
+    const GeoQuat*   rotations,
+    const f32*       scales,
+    u32              cnt,
+    GeoBox*          out);
+
 /**
  * Calculate the bounding box of a sphere.
  */
@@ -136,3 +147,13 @@ bool geo_box_overlap_sphere(const GeoBox*, const GeoSphere*);
  * NOTE: Defines a partial frustum by its four side planes.
  */
 bool geo_box_overlap_frustum4_approx(const GeoBox*, const GeoPlane frustum[4]);
+
+/**
+ * Test a batch of boxes against a partial frustum given by four side planes.
+ * Bit 'i' in the output is set when box 'i' overlaps the frustum; other bits are cleared.
+ * Same conservative approximation as 'geo_box_overlap_frustum4_approx()'.
+ *
+ * Pre-condition: out can hold at least 'count' bits.
+ */
+void geo_box_overlap_frustum4_approx_batch(
+    const GeoBox* boxes, u32 count, const GeoPlane frustum[4], BitSet out);
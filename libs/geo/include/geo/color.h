@@ -128,6 +128,15 @@ GeoColor geo_color_with_alpha(GeoColor, f32 alpha);
 GeoColor geo_color_linear_to_srgb(GeoColor);
 GeoColor geo_color_srgb_to_linear(GeoColor);
 
+/**
+ * Apply the srgb encoding / decoding curve to an array of colors in place.
+ * Amortizes the conversion setup over the whole batch; prefer these when processing many colors
+ * (for example texture pixels).
+ * NOTE: Only defined for values within the 0 - 1 range.
+ */
+void geo_color_linear_to_srgb_batch(GeoColor*, u32 count);
+void geo_color_srgb_to_linear_batch(GeoColor*, u32 count);
+
 /**
  * Construct a color from HueSaturationValue.
  * NOTE: Both hue and saturation are normalized (in the 0-1 range).
@@ -147,6 +156,12 @@ GeoColor geo_color_quantize(GeoColor, u8 maxMantissaBits);
 void     geo_color_pack_f16(GeoColor, f16 out[PARAM_ARRAY_SIZE(4)]);
 GeoColor geo_color_unpack_f16(const f16[PARAM_ARRAY_SIZE(4)]);
 
+/**
+ * Pack an array of colors to 8 bit unsigned normalized values, 4 bytes per color.
+ * Values are clamped to the 0 - 1 range.
+ */
+void geo_color_pack_u8_batch(const GeoColor*, u32 count, u8* out);
+
 /**
  * Create a formatting argument for a color.
  * NOTE: _COL_ is expanded multiple times, so care must be taken when providing complex expressions.
@@ -54,6 +54,14 @@ GeoVector geo_matrix_transform(const GeoMatrix*, GeoVector);
 GeoVector geo_matrix_transform3(const GeoMatrix*, GeoVector);
 GeoVector geo_matrix_transform3_point(const GeoMatrix*, GeoVector);
 
+/**
+ * Transform a batch of vectors / points by the same matrix.
+ * NOTE: 'in' and 'out' are allowed to alias.
+ */
+void geo_matrix_transform_batch(const GeoMatrix*, const GeoVector* in, GeoVector* out, u32 cnt);
+void geo_matrix_transform3_point_batch(
+    const GeoMatrix*, const GeoVector* in, GeoVector* out, u32 cnt);
+
 /**
  * Return a new matrix that has the matrix's rows exchanged with its columns.
  */
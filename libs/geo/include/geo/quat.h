@@ -78,6 +78,12 @@ GeoQuat geo_quat_norm(GeoQuat);
 GeoQuat geo_quat_norm_or_ident(GeoQuat);
 GeoQuat geo_quat_norm_or_ident_exact(GeoQuat);
 
+/**
+ * Normalize a batch of quaternions in-place.
+ * Pre-condition: quaternions != 0
+ */
+void geo_quat_norm_batch(GeoQuat* quats, u32 cnt);
+
 /**
  * Calculate the dot product of two quaternions.
  */
@@ -52,8 +52,21 @@ void geo_query_insert_sphere(GeoQueryEnv*, GeoSphere, u64 userId, GeoQueryLayer)
 void geo_query_insert_capsule(GeoQueryEnv*, GeoCapsule, u64 userId, GeoQueryLayer);
 void geo_query_insert_box_rotated(GeoQueryEnv*, GeoBoxRotated, u64 userId, GeoQueryLayer);
 
+/**
+ * Update previously inserted (and built) shapes in-place.
+ * The affected nodes are refitted instead of requiring a full rebuild; once the tree quality has
+ * degraded too far the next 'geo_query_build()' call performs a full rebuild.
+ * Returns false when no shape of the same type with the given userId exists in the last build, in
+ * which case the shape needs to be inserted instead.
+ */
+bool geo_query_update_sphere(GeoQueryEnv*, GeoSphere, u64 userId, GeoQueryLayer);
+bool geo_query_update_capsule(GeoQueryEnv*, GeoCapsule, u64 userId, GeoQueryLayer);
+bool geo_query_update_box_rotated(GeoQueryEnv*, GeoBoxRotated, u64 userId, GeoQueryLayer);
+
 /**
  * Build the query using all the inserted shapes.
+ * NOTE: No-op when the shapes are unchanged since the last build or were updated in-place without
+ * degrading the tree quality too far.
  */
 void geo_query_build(GeoQueryEnv*);
 
@@ -72,6 +85,20 @@ typedef struct {
 bool geo_query_ray(
     const GeoQueryEnv*, const GeoRay*, f32 maxDist, const GeoQueryFilter*, GeoQueryRayHit* outHit);
 
+/**
+ * Query for hits along a batch of rays.
+ * Rays are traversed together in small packets which is considerably faster for coherent batches
+ * (for example line-of-sight checks from a single origin).
+ * NOTE: One hit is written per ray; rays that did not hit anything have a negative hit time.
+ */
+void geo_query_ray_batch(
+    const GeoQueryEnv*,
+    const GeoRay*         rays,
+    u32                   rayCount,
+    f32                   maxDist,
+    const GeoQueryFilter*,
+    GeoQueryRayHit*       outHits);
+
 /**
  * Query for a hit along the given ray with radius.
  * Returns true if a shape was hit otherwise false.
@@ -37,3 +37,20 @@ f32 geo_sphere_intersect_ray_info(const GeoSphere*, const GeoRay*, GeoVector* ou
 bool geo_sphere_overlap(const GeoSphere*, const GeoSphere*);
 bool geo_sphere_overlap_box(const GeoSphere*, const GeoBox*);
 bool geo_sphere_overlap_frustum(const GeoSphere*, const GeoVector[PARAM_ARRAY_SIZE(8)]);
+
+/**
+ * Test if the sphere overlaps a partial frustum given by four side planes.
+ * Conservative approximation, false positives are possible but false negatives are not.
+ * NOTE: Defines a partial frustum by its four side planes.
+ */
+bool geo_sphere_overlap_frustum4_approx(const GeoSphere*, const GeoPlane frustum[4]);
+
+/**
+ * Test a batch of spheres against a partial frustum given by four side planes.
+ * Bit 'i' in the output is set when sphere 'i' overlaps the frustum; other bits are cleared.
+ * Same conservative approximation as 'geo_sphere_overlap_frustum4_approx()'.
+ *
+ * Pre-condition: out can hold at least 'count' bits.
+ */
+void geo_sphere_overlap_frustum4_approx_batch(
+    const GeoSphere* spheres, u32 count, const GeoPlane frustum[4], BitSet out);
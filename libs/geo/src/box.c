@@ -1,4 +1,5 @@
 #include "core/array.h"
+#include "core/bitset.h"
 #include "core/float.h"
 #include "core/math.h"
 #include "geo/box.h"
@@ -177,8 +178,8 @@ void geo_box_corners3(const GeoBox* box, GeoVector corners[PARAM_ARRAY_SIZE(8)])
   corners[7] = geo_vector(box->max.x, box->min.y, box->max.z);
 }
 
-GeoBox
-geo_box_transform3(const GeoBox* box, const GeoVector pos, const GeoQuat rot, const f32 scale) {
+INLINE_HINT static GeoBox
+box_transform3(const GeoBox* box, const GeoVector pos, const GeoQuat rot, const f32 scale) {
 #ifdef VOLO_SIMD
   SimdVec       min      = simd_vec_broadcast(f32_max);
   SimdVec       max      = simd_vec_broadcast(f32_min);
@@ -222,6 +223,23 @@ geo_box_transform3(const GeoBox* box, const GeoVector pos, const GeoQuat rot, co
 #endif
 }
 
+GeoBox
+geo_box_transform3(const GeoBox* box, const GeoVector pos, const GeoQuat rot, const f32 scale) {
+  return box_transform3(box, pos, rot, scale);
+}
+
+void geo_box_transform3_batch(
+    const GeoBox*    boxes,
+    const GeoVector* offsets,
+    const GeoQuat*   rotations,
+    const f32*       scales,
+    const u32        count,
+    GeoBox*          out) {
+  for (u32 i = 0; i != count; ++i) {
+    out[i] = box_transform3(&boxes[i], offsets[i], rotations[i], scales[i]);
+  }
+}
+
 GeoBox geo_box_from_sphere(const GeoVector pos, const f32 radius) {
 #ifdef VOLO_SIMD
   const SimdVec vPos    = simd_vec_load(pos.comps);
@@ -558,6 +576,67 @@ bool geo_box_overlap_sphere(const GeoBox* box, const GeoSphere* sphere) {
   return distSqr <= (sphere->radius * sphere->radius);
 }
 
+void geo_box_overlap_frustum4_approx_batch(
+    const GeoBox* boxes, const u32 count, const GeoPlane frustum[4], const BitSet out) {
+  bitset_clear_all(out);
+#ifdef VOLO_SIMD
+  /**
+   * Transpose the planes so that each register holds one component of all four planes; this way
+   * each box is tested against all four planes at once.
+   */
+  ALIGNAS(16) f32 planesData[4][4];
+  for (u32 planeIdx = 0; planeIdx != 4; ++planeIdx) {
+    planesData[0][planeIdx] = frustum[planeIdx].normal.x;
+    planesData[1][planeIdx] = frustum[planeIdx].normal.y;
+    planesData[2][planeIdx] = frustum[planeIdx].normal.z;
+    planesData[3][planeIdx] = frustum[planeIdx].distance;
+  }
+  const SimdVec planesX = simd_vec_load(planesData[0]);
+  const SimdVec planesY = simd_vec_load(planesData[1]);
+  const SimdVec planesZ = simd_vec_load(planesData[2]);
+  const SimdVec planesD = simd_vec_load(planesData[3]);
+
+  // Per axis which planes have a positive normal (and thus should test against the box max).
+  const SimdVec posMaskX = simd_vec_greater(planesX, simd_vec_zero());
+  const SimdVec posMaskY = simd_vec_greater(planesY, simd_vec_zero());
+  const SimdVec posMaskZ = simd_vec_greater(planesZ, simd_vec_zero());
+
+  for (u32 i = 0; i != count; ++i) {
+    const SimdVec boxMin = simd_vec_load(boxes[i].min.comps);
+    const SimdVec boxMax = simd_vec_load(boxes[i].max.comps);
+    if (UNLIKELY(simd_vec_mask_u32(simd_vec_greater(boxMin, boxMax)) != 0b0000)) {
+      bitset_set(out, i); // Box is inverted; considered to always be overlapping.
+      continue;
+    }
+    const SimdVec minX = simd_vec_broadcast(boxes[i].min.x);
+    const SimdVec minY = simd_vec_broadcast(boxes[i].min.y);
+    const SimdVec minZ = simd_vec_broadcast(boxes[i].min.z);
+    const SimdVec maxX = simd_vec_broadcast(boxes[i].max.x);
+    const SimdVec maxY = simd_vec_broadcast(boxes[i].max.y);
+    const SimdVec maxZ = simd_vec_broadcast(boxes[i].max.z);
+
+    const SimdVec cornerX = simd_vec_select(minX, maxX, posMaskX);
+    const SimdVec cornerY = simd_vec_select(minY, maxY, posMaskY);
+    const SimdVec cornerZ = simd_vec_select(minZ, maxZ, posMaskZ);
+
+    const SimdVec dotX = simd_vec_mul(planesX, cornerX);
+    const SimdVec dotY = simd_vec_mul(planesY, cornerY);
+    const SimdVec dotZ = simd_vec_mul(planesZ, cornerZ);
+    const SimdVec dots = simd_vec_add(simd_vec_add(dotX, dotY), dotZ);
+
+    if (simd_vec_mask_u32(simd_vec_less(dots, planesD)) == 0b0000) {
+      bitset_set(out, i); // No plane rejects the box.
+    }
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    if (geo_box_overlap_frustum4_approx(&boxes[i], frustum)) {
+      bitset_set(out, i);
+    }
+  }
+#endif
+}
+
 bool geo_box_overlap_frustum4_approx(const GeoBox* box, const GeoPlane frustum[4]) {
 #ifdef VOLO_SIMD
   const SimdVec boxMin = simd_vec_load(box->min.comps);
@@ -271,6 +271,53 @@ GeoColor geo_color_srgb_to_linear(const GeoColor srgb) {
   };
 }
 
+void geo_color_linear_to_srgb_batch(GeoColor* colors, const u32 count) {
+/**
+ * Linear to srgb curve approximation, same curve as 'geo_color_linear_to_srgb'.
+ * Implementation based on: http://chilliant.blogspot.com/2012/08/srgb-approximations-for-hlsl.html
+ */
+#ifdef VOLO_SIMD
+  const SimdVec c1 = simd_vec_broadcast(0.585122381f);
+  const SimdVec c2 = simd_vec_broadcast(0.783140355f);
+  const SimdVec c3 = simd_vec_broadcast(0.368262736f);
+  for (u32 i = 0; i != count; ++i) {
+    const SimdVec vecLinear = simd_vec_load(colors[i].data);
+    const SimdVec s1        = simd_vec_sqrt(vecLinear);
+    const SimdVec s2        = simd_vec_sqrt(s1);
+    const SimdVec s3        = simd_vec_sqrt(s2);
+    const SimdVec srgb      = simd_vec_sub(
+        simd_vec_add(simd_vec_mul(s1, c1), simd_vec_mul(s2, c2)), simd_vec_mul(s3, c3));
+    simd_vec_store(simd_vec_copy_w(simd_vec_max(srgb, simd_vec_zero()), vecLinear), colors[i].data);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    colors[i] = geo_color_linear_to_srgb(colors[i]);
+  }
+#endif
+}
+
+void geo_color_srgb_to_linear_batch(GeoColor* colors, const u32 count) {
+/**
+ * Srgb to linear curve approximation (polynomial fit), inverse of the batch encode curve.
+ * Implementation based on: http://chilliant.blogspot.com/2012/08/srgb-approximations-for-hlsl.html
+ */
+#ifdef VOLO_SIMD
+  const SimdVec c1 = simd_vec_broadcast(0.305306011f);
+  const SimdVec c2 = simd_vec_broadcast(0.682171111f);
+  const SimdVec c3 = simd_vec_broadcast(0.012522878f);
+  for (u32 i = 0; i != count; ++i) {
+    const SimdVec srgb   = simd_vec_load(colors[i].data);
+    const SimdVec linear = simd_vec_mul(
+        srgb, simd_vec_add(simd_vec_mul(srgb, simd_vec_add(simd_vec_mul(srgb, c1), c2)), c3));
+    simd_vec_store(simd_vec_copy_w(simd_vec_max(linear, simd_vec_zero()), srgb), colors[i].data);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    colors[i] = geo_color_srgb_to_linear(colors[i]);
+  }
+#endif
+}
+
 GeoColor geo_color_from_hsv(const f32 hue, const f32 saturation, const f32 value, const f32 alpha) {
   diag_assert(hue >= 0.0f && hue <= 1.0f);
   diag_assert(saturation >= 0.0f && saturation <= 1.0f);
@@ -377,6 +424,34 @@ void geo_color_pack_f16(const GeoColor color, f16 out[PARAM_ARRAY_SIZE(4)]) {
 #endif
 }
 
+void geo_color_pack_u8_batch(const GeoColor* colors, const u32 count, u8* out) {
+  static const f32 g_u8MaxPlusOneRoundDown = 255.999f;
+  u32              i                       = 0;
+#ifdef VOLO_SIMD
+  const SimdVec scale = simd_vec_broadcast(g_u8MaxPlusOneRoundDown);
+  const SimdVec one   = simd_vec_broadcast(1.0f);
+  // Pack four colors per iteration into a single 16 byte store.
+  for (; (i + 4) <= count; i += 4, out += 16) {
+    SimdVec v[4];
+    for (u32 j = 0; j != 4; ++j) {
+      SimdVec vec = simd_vec_load(colors[i + j].data);
+      vec         = simd_vec_min(simd_vec_max(vec, simd_vec_zero()), one);
+      v[j]        = simd_vec_f32_to_i32(simd_vec_mul(vec, scale));
+    }
+    const SimdVec lo = simd_vec_pack_u32_to_u16(v[0], v[1]);
+    const SimdVec hi = simd_vec_pack_u32_to_u16(v[2], v[3]);
+    simd_vec_store_unaligned(simd_vec_pack_u16_to_u8(lo, hi), out);
+  }
+#endif
+  for (; i != count; ++i, out += 4) {
+    const GeoColor c = geo_color_clamp01(colors[i]);
+    out[0]           = (u8)(c.r * g_u8MaxPlusOneRoundDown);
+    out[1]           = (u8)(c.g * g_u8MaxPlusOneRoundDown);
+    out[2]           = (u8)(c.b * g_u8MaxPlusOneRoundDown);
+    out[3]           = (u8)(c.a * g_u8MaxPlusOneRoundDown);
+  }
+}
+
 GeoColor geo_color_unpack_f16(const f16 in[PARAM_ARRAY_SIZE(4)]) {
 #ifdef VOLO_SIMD
   if (g_f16cSupport) {
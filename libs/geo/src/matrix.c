@@ -134,6 +134,51 @@ GeoVector geo_matrix_transform3_point(const GeoMatrix* m, const GeoVector vec) {
   };
 }
 
+void geo_matrix_transform_batch(
+    const GeoMatrix* m, const GeoVector* in, GeoVector* out, const u32 count) {
+#ifdef VOLO_SIMD
+  const SimdVec col0 = simd_vec_load(m->columns[0].comps);
+  const SimdVec col1 = simd_vec_load(m->columns[1].comps);
+  const SimdVec col2 = simd_vec_load(m->columns[2].comps);
+  const SimdVec col3 = simd_vec_load(m->columns[3].comps);
+
+  for (u32 i = 0; i != count; ++i) {
+    const SimdVec vec = simd_vec_load(in[i].comps);
+    SimdVec       res = simd_vec_mul(col0, simd_vec_splat(vec, 0));
+    res               = simd_vec_add(simd_vec_mul(col1, simd_vec_splat(vec, 1)), res);
+    res               = simd_vec_add(simd_vec_mul(col2, simd_vec_splat(vec, 2)), res);
+    res               = simd_vec_add(simd_vec_mul(col3, simd_vec_splat(vec, 3)), res);
+    simd_vec_store(res, out[i].comps);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    out[i] = geo_matrix_transform(m, in[i]);
+  }
+#endif
+}
+
+void geo_matrix_transform3_point_batch(
+    const GeoMatrix* m, const GeoVector* in, GeoVector* out, const u32 count) {
+#ifdef VOLO_SIMD
+  const SimdVec col0 = simd_vec_load(m->columns[0].comps);
+  const SimdVec col1 = simd_vec_load(m->columns[1].comps);
+  const SimdVec col2 = simd_vec_load(m->columns[2].comps);
+  const SimdVec col3 = simd_vec_load(m->columns[3].comps);
+
+  for (u32 i = 0; i != count; ++i) {
+    const SimdVec vec = simd_vec_load(in[i].comps);
+    SimdVec       res = simd_vec_add(simd_vec_mul(col0, simd_vec_splat(vec, 0)), col3);
+    res               = simd_vec_add(simd_vec_mul(col1, simd_vec_splat(vec, 1)), res);
+    res               = simd_vec_add(simd_vec_mul(col2, simd_vec_splat(vec, 2)), res);
+    simd_vec_store(simd_vec_clear_w(res), out[i].comps);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    out[i] = geo_matrix_transform3_point(m, in[i]);
+  }
+#endif
+}
+
 GeoMatrix geo_matrix_transpose(const GeoMatrix* m) {
 #ifdef VOLO_SIMD
   const SimdVec col0 = simd_vec_load(m->columns[0].comps);
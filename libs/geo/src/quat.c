@@ -128,6 +128,36 @@ GeoQuat geo_quat_norm(const GeoQuat q) {
 #endif
 }
 
+void geo_quat_norm_batch(GeoQuat* quats, const u32 count) {
+#ifdef VOLO_SIMD
+  u32 i = 0;
+  // Normalize quaternions 4 at a time; the magnitudes are merged into a single vector so one
+  // reciprocal square-root serves all four.
+  for (; (i + 4) <= count; i += 4) {
+    const SimdVec q0 = simd_vec_load(quats[i + 0].comps);
+    const SimdVec q1 = simd_vec_load(quats[i + 1].comps);
+    const SimdVec q2 = simd_vec_load(quats[i + 2].comps);
+    const SimdVec q3 = simd_vec_load(quats[i + 3].comps);
+
+    const SimdVec magSqr = simd_vec_x_merge(
+        simd_vec_dot4(q0, q0), simd_vec_dot4(q1, q1), simd_vec_dot4(q2, q2), simd_vec_dot4(q3, q3));
+    const SimdVec magInv = simd_vec_rsqrt(magSqr);
+
+    simd_vec_store(simd_vec_mul(q0, simd_vec_splat(magInv, 0)), quats[i + 0].comps);
+    simd_vec_store(simd_vec_mul(q1, simd_vec_splat(magInv, 1)), quats[i + 1].comps);
+    simd_vec_store(simd_vec_mul(q2, simd_vec_splat(magInv, 2)), quats[i + 2].comps);
+    simd_vec_store(simd_vec_mul(q3, simd_vec_splat(magInv, 3)), quats[i + 3].comps);
+  }
+  for (; i != count; ++i) {
+    simd_vec_store(simd_quat_norm(simd_vec_load(quats[i].comps)), quats[i].comps);
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    quats[i] = geo_quat_norm(quats[i]);
+  }
+#endif
+}
+
 GeoQuat geo_quat_norm_or_ident(const GeoQuat q) {
 #ifdef VOLO_SIMD
   const SimdVec qVec   = simd_vec_load(q.comps);
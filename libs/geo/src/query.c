@@ -1,16 +1,30 @@
 #include "core/alloc.h"
 #include "core/array.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/float.h"
 #include "core/math.h"
+#include "core/sentinel.h"
 #include "core/thread.h"
 #include "geo/box_rotated.h"
 #include "geo/capsule.h"
 #include "geo/query.h"
 #include "geo/sphere.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
+
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
 
 #define geo_query_shape_align 16
 #define geo_query_bvh_node_divide_threshold 8
+#define geo_query_bvh_parallel_shape_threshold 1024
+#define geo_query_bvh_parallel_tasks_max 64
+#define geo_query_bvh_refit_degradation_max 0.25f
 
 ASSERT(alignof(GeoSphere) <= geo_query_shape_align, "Insufficient alignment");
 ASSERT(alignof(GeoCapsule) <= geo_query_shape_align, "Insufficient alignment");
@@ -31,7 +45,8 @@ typedef struct {
   u64*           userIds;
   GeoQueryLayer* layers;
   GeoBox*        bounds;
-  void*          data; // GeoSphere[] / GeoCapsule[] / GeoBoxRotated[]
+  u32*           leafNodes; // Bvh leaf-node per shape, filled during 'geo_query_build()'.
+  void*          data;      // GeoSphere[] / GeoCapsule[] / GeoBoxRotated[]
 } QueryPrim;
 
 typedef QueryPrim QueryPrimStorage[QueryPrimType_Count];
@@ -45,7 +60,8 @@ typedef QueryPrim QueryPrimStorage[QueryPrimType_Count];
 typedef struct {
   GeoBox        bounds;
   GeoQueryLayer layers;
-  u32           depth; // Only for debug purposes, could be removed if needed.
+  u32           depth;  // Only for debug purposes, could be removed if needed.
+  u32           parent; // Index of the parent node (the root is its own parent).
   u32           child, shapeCount;
 } QueryBvhNode;
 
@@ -55,10 +71,24 @@ typedef struct {
   u32           nodeCount, shapeCapacity;
 } QueryBvh;
 
+/**
+ * Lookup from shape user-id to shape handle, sorted on the user-id.
+ * NOTE: Rebuilt as part of 'geo_query_build()'.
+ */
+typedef struct {
+  u64 userId;
+  u32 shape; // QueryShape
+} QueryShapeMapEntry;
+
 struct sGeoQueryEnv {
   Allocator*       alloc;
   QueryBvh         bvh;
   QueryPrimStorage prims;
+  DynArray         shapeMap; // QueryShapeMapEntry[], sorted on userId.
+  bool             built;    // Bvh matches the current shapes.
+  bool             degraded; // Bvh quality dropped too far; needs a full rebuild.
+  f32              fitArea;  // Area of the root bounds at the last full build.
+  f32              refitGrowth;
   i32              stats[GeoQueryStat_Count];
 };
 
@@ -110,11 +140,12 @@ static usize prim_data_size(const QueryPrimType type) {
 static QueryPrim prim_create(const QueryPrimType type, const u32 capacity) {
   const usize dataSize = prim_data_size(type) * capacity;
   return (QueryPrim){
-      .capacity = capacity,
-      .userIds  = alloc_array_t(g_allocHeap, u64, capacity),
-      .layers   = alloc_array_t(g_allocHeap, GeoQueryLayer, capacity),
-      .bounds   = alloc_array_t(g_allocHeap, GeoBox, capacity),
-      .data     = alloc_alloc(g_allocHeap, dataSize, geo_query_shape_align).ptr,
+      .capacity  = capacity,
+      .userIds   = alloc_array_t(g_allocHeap, u64, capacity),
+      .layers    = alloc_array_t(g_allocHeap, GeoQueryLayer, capacity),
+      .bounds    = alloc_array_t(g_allocHeap, GeoBox, capacity),
+      .leafNodes = alloc_array_t(g_allocHeap, u32, capacity),
+      .data      = alloc_alloc(g_allocHeap, dataSize, geo_query_shape_align).ptr,
   };
 }
 
@@ -122,6 +153,7 @@ static void prim_destroy(QueryPrim* p, const QueryPrimType type) {
   alloc_free_array_t(g_allocHeap, p->userIds, p->capacity);
   alloc_free_array_t(g_allocHeap, p->layers, p->capacity);
   alloc_free_array_t(g_allocHeap, p->bounds, p->capacity);
+  alloc_free_array_t(g_allocHeap, p->leafNodes, p->capacity);
   alloc_free(g_allocHeap, mem_create(p->data, prim_data_size(type) * p->capacity));
 }
 
@@ -136,6 +168,7 @@ static void prim_copy(QueryPrim* dst, const QueryPrim* src, const QueryPrimType
   cpy_entry_field(userIds, sizeof(u64));
   cpy_entry_field(layers, sizeof(GeoQueryLayer));
   cpy_entry_field(bounds, sizeof(GeoBox));
+  cpy_entry_field(leafNodes, sizeof(u32));
   cpy_entry_field(data, prim_data_size(type));
 
   dst->count = src->count;
@@ -371,18 +404,27 @@ static u32 bvh_insert_root(QueryBvh* bvh, const QueryPrimStorage prims) {
 }
 
 /**
- * Insert a new child leaf-node with the specified shapes.
+ * Reserve two consecutive node indices.
+ * NOTE: Atomic as node-pairs can be reserved from multiple job workers during a parallel build;
+ * the nodes array is always big enough (two nodes per shape) so no re-allocation can occur.
+ * Returns the index of the first node, the second node is stored directly after it.
+ */
+static u32 bvh_node_reserve_pair(QueryBvh* bvh) {
+  return thread_atomic_add_u32(&bvh->nodeCount, 2);
+}
+
+/**
+ * Initialize a child leaf-node with the specified shapes.
  * NOTE: Shapes need to be consecutively stored.
- * Returns the node index.
  */
-static u32 bvh_insert(
+static void bvh_insert(
     QueryBvh*              bvh,
     const QueryPrimStorage prims,
+    const u32              index,
     const u32              depth,
     const u32              shapeBegin,
     const u32              shapeCount) {
-  const u32     index = bvh->nodeCount++;
-  QueryBvhNode* node  = &bvh->nodes[index];
+  QueryBvhNode* node = &bvh->nodes[index];
 
   *node = (QueryBvhNode){
       .bounds     = geo_box_inverted3(),
@@ -396,7 +438,6 @@ static u32 bvh_insert(
     node->layers |= shape_layer(shape, prims);
     node->bounds = geo_box_encapsulate_box(&node->bounds, shape_bounds(shape, prims));
   }
-  return index;
 }
 
 typedef struct {
@@ -456,12 +497,17 @@ static u32 bvh_partition(
 }
 
 /**
- * Subdivide the given leaf-node, if successful the node is no longer a leaf-node but contains a
- * tree of child nodes encompassing the same shapes as it did before subdividing.
+ * Split the given leaf-node into two child leaf-nodes that together contain the same shapes.
+ * Returns true if the node was split ('outChildren' contains the child node indices), or false if
+ * one of the partitions was empty in which case the node remains a leaf-node.
  */
-static void bvh_subdivide(QueryBvh* bvh, const QueryPrimStorage prims, const u32 nodeIdx) {
+static bool bvh_split(
+    QueryBvh*              bvh,
+    const QueryPrimStorage prims,
+    const u32              nodeIdx,
+    u32                    outChildren[PARAM_ARRAY_SIZE(2)]) {
   QueryBvhNode* node = &bvh->nodes[nodeIdx];
-  diag_assert(node->shapeCount); // Only leaf-nodes can be subdivided.
+  diag_assert(node->shapeCount); // Only leaf-nodes can be split.
 
   const QueryBvhPlane partitionPlane = bvh_split_pick(bvh, nodeIdx);
   const u32           partitionIndex = bvh_partition(bvh, prims, nodeIdx, &partitionPlane);
@@ -469,21 +515,177 @@ static void bvh_subdivide(QueryBvh* bvh, const QueryPrimStorage prims, const u32
   const u32 countA = partitionIndex - node->child;
   const u32 countB = node->shapeCount - countA;
   if (!countA || !countB) {
-    return; // One of the partitions is empty; abort the subdivide.
+    return false; // One of the partitions is empty; abort the split.
   }
 
-  const u32 childA = bvh_insert(bvh, prims, node->depth + 1, node->child, countA);
-  const u32 childB = bvh_insert(bvh, prims, node->depth + 1, partitionIndex, countB);
+  // Child nodes have to be stored consecutively; reserve both with a single bump.
+  const u32 childA = bvh_node_reserve_pair(bvh);
+  bvh_insert(bvh, prims, childA, node->depth + 1, node->child, countA);
+  bvh_insert(bvh, prims, childA + 1, node->depth + 1, partitionIndex, countB);
+  bvh->nodes[childA].parent     = nodeIdx;
+  bvh->nodes[childA + 1].parent = nodeIdx;
 
   node->child      = childA;
-  node->shapeCount = 0;              // Node is no longer a leaf-node.
-  diag_assert(childB == childA + 1); // Child nodes have to be stored consecutively.
+  node->shapeCount = 0; // Node is no longer a leaf-node.
+
+  outChildren[0] = childA;
+  outChildren[1] = childA + 1;
+  return true;
+}
+
+/**
+ * Subdivide the given leaf-node, if successful the node is no longer a leaf-node but contains a
+ * tree of child nodes encompassing the same shapes as it did before subdividing.
+ */
+static void bvh_subdivide(QueryBvh* bvh, const QueryPrimStorage prims, const u32 nodeIdx) {
+  u32 children[2];
+  if (!bvh_split(bvh, prims, nodeIdx, children)) {
+    return;
+  }
+  if (bvh_shape_count(bvh, children[0]) >= geo_query_bvh_node_divide_threshold) {
+    bvh_subdivide(bvh, prims, children[0]);
+  }
+  if (bvh_shape_count(bvh, children[1]) >= geo_query_bvh_node_divide_threshold) {
+    bvh_subdivide(bvh, prims, children[1]);
+  }
+}
+
+typedef struct {
+  QueryBvh*        bvh;
+  const QueryPrim* prims;
+  u32              nodeIdx;
+} BvhSubdivideCtx;
+
+static void bvh_subdivide_task(const void* context) {
+  const BvhSubdivideCtx* ctx = context;
+  bvh_subdivide(ctx->bvh, ctx->prims, ctx->nodeIdx);
+}
+
+/**
+ * Subdivide the given leaf-node using all available job workers.
+ * The top of the tree is split single-threaded until there are enough independent sub-trees to
+ * keep the workers busy; the sub-trees are then subdivided in parallel. This is safe as the shape
+ * ranges of sibling sub-trees are disjoint and node-pairs are reserved atomically.
+ */
+static void bvh_subdivide_parallel(QueryBvh* bvh, const QueryPrimStorage prims, const u32 nodeIdx) {
+  u32 frontier[geo_query_bvh_parallel_tasks_max];
+  u32 frontierCount         = 0;
+  frontier[frontierCount++] = nodeIdx;
+
+  const u32 frontierGoal = math_min((u32)g_jobsWorkerCount * 2, (u32)array_elems(frontier));
+  while (frontierCount < frontierGoal) {
+    // Find the splittable frontier leaf with the most shapes.
+    u32 best = frontierCount, bestShapes = 0;
+    for (u32 i = 0; i != frontierCount; ++i) {
+      const u32 shapes = bvh_shape_count(bvh, frontier[i]);
+      if (shapes >= geo_query_bvh_node_divide_threshold && shapes > bestShapes) {
+        best       = i;
+        bestShapes = shapes;
+      }
+    }
+    if (best == frontierCount) {
+      break; // No splittable leaves remaining.
+    }
+    u32 children[2];
+    if (bvh_split(bvh, prims, frontier[best], children)) {
+      frontier[best]            = children[0];
+      frontier[frontierCount++] = children[1];
+    } else {
+      frontier[best] = frontier[--frontierCount]; // Leaf cannot be split; remove it.
+    }
+  }
 
-  if (countA >= geo_query_bvh_node_divide_threshold) {
-    bvh_subdivide(bvh, prims, childA);
+  JobGraph* graph = jobs_graph_create(g_allocHeap, string_lit("geo_query_build"), frontierCount);
+  u32       taskCount = 0;
+  for (u32 i = 0; i != frontierCount; ++i) {
+    if (bvh_shape_count(bvh, frontier[i]) < geo_query_bvh_node_divide_threshold) {
+      continue; // Sub-tree is already small enough.
+    }
+    jobs_graph_add_task(
+        graph,
+        string_lit("subdivide"),
+        bvh_subdivide_task,
+        mem_struct(BvhSubdivideCtx, .bvh = bvh, .prims = prims, .nodeIdx = frontier[i]),
+        JobTaskFlags_None);
+    ++taskCount;
   }
-  if (countB >= geo_query_bvh_node_divide_threshold) {
-    bvh_subdivide(bvh, prims, childB);
+  if (taskCount) {
+    jobs_scheduler_wait_help(jobs_scheduler_run(graph, g_allocHeap));
+  }
+  jobs_graph_destroy(graph);
+}
+
+static f32 query_box_area(const GeoBox* box) {
+  const GeoVector size = geo_box_size(box);
+  return (size.x * size.y + size.y * size.z + size.z * size.x) * 2.0f;
+}
+
+/**
+ * Record which leaf-node contains each shape and rebuild the user-id lookup; needed to refit
+ * shapes that are updated in-place after building.
+ */
+static void query_build_finalize(GeoQueryEnv* env) {
+  const QueryBvh* bvh = &env->bvh;
+  for (u32 nodeIdx = 0; nodeIdx != bvh->nodeCount; ++nodeIdx) {
+    const QueryBvhNode* node = &bvh->nodes[nodeIdx];
+    for (u32 i = 0; i != node->shapeCount; ++i) {
+      const QueryShape shape = bvh_shape(bvh, node->child + i);
+      env->prims[shape_type(shape)].leafNodes[shape_index(shape)] = nodeIdx;
+    }
+  }
+  for (QueryPrimType primType = 0; primType != QueryPrimType_Count; ++primType) {
+    const QueryPrim* prim = &env->prims[primType];
+    for (u32 primIdx = 0; primIdx != prim->count; ++primIdx) {
+      *dynarray_push_t(&env->shapeMap, QueryShapeMapEntry) = (QueryShapeMapEntry){
+          .userId = prim->userIds[primIdx],
+          .shape  = shape_handle(primType, primIdx),
+      };
+    }
+  }
+  dynarray_sort(&env->shapeMap, compare_u64);
+
+  env->fitArea = query_box_area(&bvh->nodes[0].bounds);
+}
+
+static QueryShape query_shape_find(GeoQueryEnv* env, const u64 userId, const QueryPrimType type) {
+  if (!env->built) {
+    return sentinel_u32; // Lookup is only valid for the shapes of the last build.
+  }
+  const QueryShapeMapEntry* entry = dynarray_search_binary(&env->shapeMap, compare_u64, &userId);
+  if (!entry || shape_type(entry->shape) != type) {
+    return sentinel_u32;
+  }
+  return entry->shape;
+}
+
+/**
+ * Grow the bvh nodes that contain the given shape to fit its new bounds.
+ * NOTE: Node bounds (and layers) only ever grow during refitting which keeps them conservative but
+ * makes them less tight; a full rebuild is scheduled once the accumulated growth indicates that
+ * the tree quality has degraded too far.
+ */
+static void query_refit(GeoQueryEnv* env, const QueryShape shape) {
+  QueryBvh*           bvh    = &env->bvh;
+  const GeoBox*       bounds = shape_bounds(shape, env->prims);
+  const GeoQueryLayer layer  = shape_layer(shape, env->prims);
+
+  u32 nodeIdx = shape_prim(shape, env->prims)->leafNodes[shape_index(shape)];
+  for (;;) {
+    QueryBvhNode* node = &bvh->nodes[nodeIdx];
+    node->layers |= layer;
+    const GeoBox grown  = geo_box_encapsulate_box(&node->bounds, bounds);
+    const f32    growth = query_box_area(&grown) - query_box_area(&node->bounds);
+    if (growth > 0.0f) {
+      node->bounds = grown;
+      env->refitGrowth += growth;
+    }
+    if (!nodeIdx) {
+      break; // Reached the root.
+    }
+    nodeIdx = node->parent;
+  }
+  if (env->refitGrowth > env->fitArea * geo_query_bvh_refit_degradation_max) {
+    env->degraded = true; // Quality dropped too far; rebuild on the next 'geo_query_build()'.
   }
 }
 
@@ -585,6 +787,7 @@ GeoQueryEnv* geo_query_env_create(Allocator* alloc) {
       .prims[QueryPrimType_Sphere]     = prim_create(QueryPrimType_Sphere, 32),
       .prims[QueryPrimType_Capsule]    = prim_create(QueryPrimType_Capsule, 32),
       .prims[QueryPrimType_BoxRotated] = prim_create(QueryPrimType_BoxRotated, 32),
+      .shapeMap                        = dynarray_create_t(alloc, QueryShapeMapEntry, 64),
   };
 
   return env;
@@ -595,12 +798,14 @@ void geo_query_env_destroy(GeoQueryEnv* env) {
   for (QueryPrimType primType = 0; primType != QueryPrimType_Count; ++primType) {
     prim_destroy(&env->prims[primType], primType);
   }
+  dynarray_destroy(&env->shapeMap);
   alloc_free_t(env->alloc, env);
 }
 
 void geo_query_env_clear(GeoQueryEnv* env) {
   bvh_clear(&env->bvh);
   array_for_t(env->prims, QueryPrim, prim) { prim->count = 0; }
+  env->built = false;
 }
 
 void geo_query_insert_sphere(
@@ -615,6 +820,7 @@ void geo_query_insert_sphere(
   prim->bounds[prim->count]             = geo_box_from_sphere(sphere.point, sphere.radius);
   ((GeoSphere*)prim->data)[prim->count] = sphere;
   ++prim->count;
+  env->built = false;
 }
 
 void geo_query_insert_capsule(
@@ -630,6 +836,7 @@ void geo_query_insert_capsule(
   prim->bounds[prim->count]  = geo_box_from_capsule(capsule.line.a, capsule.line.b, capsule.radius);
   ((GeoCapsule*)prim->data)[prim->count] = capsule;
   ++prim->count;
+  env->built = false;
 }
 
 void geo_query_insert_box_rotated(
@@ -645,17 +852,102 @@ void geo_query_insert_box_rotated(
   prim->bounds[prim->count]                 = geo_box_from_rotated(&box.box, box.rotation);
   ((GeoBoxRotated*)prim->data)[prim->count] = box;
   ++prim->count;
+  env->built = false;
+}
+
+bool geo_query_update_sphere(
+    GeoQueryEnv* env, const GeoSphere sphere, const u64 userId, const GeoQueryLayer layer) {
+  query_validate_pos(sphere.point);
+  diag_assert_msg(layer, "Shape needs at least one layer");
+
+  const QueryShape shape = query_shape_find(env, userId, QueryPrimType_Sphere);
+  if (sentinel_check(shape)) {
+    return false; // Unknown shape; needs to be inserted instead.
+  }
+  QueryPrim* prim    = &env->prims[QueryPrimType_Sphere];
+  const u32  primIdx = shape_index(shape);
+
+  prim->layers[primIdx]             = layer;
+  prim->bounds[primIdx]             = geo_box_from_sphere(sphere.point, sphere.radius);
+  ((GeoSphere*)prim->data)[primIdx] = sphere;
+
+  query_refit(env, shape);
+  return true;
+}
+
+bool geo_query_update_capsule(
+    GeoQueryEnv* env, const GeoCapsule capsule, const u64 userId, const GeoQueryLayer layer) {
+  query_validate_pos(capsule.line.a);
+  query_validate_pos(capsule.line.b);
+  diag_assert_msg(layer, "Shape needs at least one layer");
+
+  const QueryShape shape = query_shape_find(env, userId, QueryPrimType_Capsule);
+  if (sentinel_check(shape)) {
+    return false; // Unknown shape; needs to be inserted instead.
+  }
+  QueryPrim* prim    = &env->prims[QueryPrimType_Capsule];
+  const u32  primIdx = shape_index(shape);
+
+  prim->layers[primIdx] = layer;
+  prim->bounds[primIdx] = geo_box_from_capsule(capsule.line.a, capsule.line.b, capsule.radius);
+  ((GeoCapsule*)prim->data)[primIdx] = capsule;
+
+  query_refit(env, shape);
+  return true;
+}
+
+bool geo_query_update_box_rotated(
+    GeoQueryEnv* env, const GeoBoxRotated box, const u64 userId, const GeoQueryLayer layer) {
+  query_validate_pos(box.box.min);
+  query_validate_pos(box.box.max);
+  diag_assert_msg(layer, "Shape needs at least one layer");
+
+  const QueryShape shape = query_shape_find(env, userId, QueryPrimType_BoxRotated);
+  if (sentinel_check(shape)) {
+    return false; // Unknown shape; needs to be inserted instead.
+  }
+  QueryPrim* prim    = &env->prims[QueryPrimType_BoxRotated];
+  const u32  primIdx = shape_index(shape);
+
+  prim->layers[primIdx]                = layer;
+  prim->bounds[primIdx]                = geo_box_from_rotated(&box.box, box.rotation);
+  ((GeoBoxRotated*)prim->data)[primIdx] = box;
+
+  query_refit(env, shape);
+  return true;
 }
 
 void geo_query_build(GeoQueryEnv* env) {
+  if (env->built && !env->degraded) {
+    return; // Bvh is still up-to-date; updated shapes were refitted in-place.
+  }
   bvh_clear(&env->bvh);
-  if (!shape_count(env->prims)) {
+  dynarray_clear(&env->shapeMap);
+  env->built       = true;
+  env->degraded    = false;
+  env->refitGrowth = 0.0f;
+
+  const u32 shapes = shape_count(env->prims);
+  if (!shapes) {
     return; // Query is empty.
   }
   const u32 rootIndex = bvh_insert_root(&env->bvh, env->prims);
   if (bvh_shape_count(&env->bvh, rootIndex) >= geo_query_bvh_node_divide_threshold) {
-    bvh_subdivide(&env->bvh, env->prims, rootIndex);
+    /**
+     * Subdivide using all job workers when the tree is big enough to be worth it. Waiting for the
+     * parallel build is not supported while this thread is itself executing a job task (for
+     * example when building from inside an ecs system); in that case fall back to the serial
+     * build.
+     */
+    const bool parallel = shapes >= geo_query_bvh_parallel_shape_threshold && g_jobsIsWorker &&
+                          !jobs_is_working() && g_jobsWorkerCount > 1;
+    if (parallel) {
+      bvh_subdivide_parallel(&env->bvh, env->prims, rootIndex);
+    } else {
+      bvh_subdivide(&env->bvh, env->prims, rootIndex);
+    }
   }
+  query_build_finalize(env);
 }
 
 bool geo_query_ray(
@@ -732,6 +1024,183 @@ bool geo_query_ray(
   return foundHit;
 }
 
+#ifdef VOLO_SIMD
+typedef struct {
+  SimdVec originX, originY, originZ; // Ray origins (one lane per ray).
+  SimdVec dirInvX, dirInvY, dirInvZ; // Reciprocal ray directions (one lane per ray).
+} QueryRayPacket;
+
+/**
+ * Test which rays of the packet intersect the node bounds within their current best hit time.
+ * Returns a mask with bit N set when ray (lane) N intersects.
+ */
+static u32 bvh_test_ray_packet(
+    const QueryBvh* bvh, const u32 nodeIdx, const QueryRayPacket* packet, const SimdVec bestT) {
+  const QueryBvhNode* node = &bvh->nodes[nodeIdx];
+
+  const SimdVec minX = simd_vec_broadcast(node->bounds.min.x);
+  const SimdVec minY = simd_vec_broadcast(node->bounds.min.y);
+  const SimdVec minZ = simd_vec_broadcast(node->bounds.min.z);
+  const SimdVec maxX = simd_vec_broadcast(node->bounds.max.x);
+  const SimdVec maxY = simd_vec_broadcast(node->bounds.max.y);
+  const SimdVec maxZ = simd_vec_broadcast(node->bounds.max.z);
+
+  const SimdVec t0x = simd_vec_mul(simd_vec_sub(minX, packet->originX), packet->dirInvX);
+  const SimdVec t1x = simd_vec_mul(simd_vec_sub(maxX, packet->originX), packet->dirInvX);
+  const SimdVec t0y = simd_vec_mul(simd_vec_sub(minY, packet->originY), packet->dirInvY);
+  const SimdVec t1y = simd_vec_mul(simd_vec_sub(maxY, packet->originY), packet->dirInvY);
+  const SimdVec t0z = simd_vec_mul(simd_vec_sub(minZ, packet->originZ), packet->dirInvZ);
+  const SimdVec t1z = simd_vec_mul(simd_vec_sub(maxZ, packet->originZ), packet->dirInvZ);
+
+  const SimdVec tMin = simd_vec_max(
+      simd_vec_max(simd_vec_min(t0x, t1x), simd_vec_min(t0y, t1y)), simd_vec_min(t0z, t1z));
+  const SimdVec tMax = simd_vec_min(
+      simd_vec_min(simd_vec_max(t0x, t1x), simd_vec_max(t0y, t1y)), simd_vec_max(t0z, t1z));
+
+  const SimdVec miss = simd_vec_or(
+      simd_vec_or(simd_vec_greater(tMin, tMax), simd_vec_less(tMax, simd_vec_zero())),
+      simd_vec_greater(tMin, bestT));
+  return ~simd_vec_mask_u32(miss) & 0b1111;
+}
+
+static void query_ray_packet(
+    const GeoQueryEnv*    env,
+    const GeoRay*         rays,
+    const u32             rayCount, // At most 4.
+    const f32             maxDist,
+    const GeoQueryFilter* filter,
+    GeoQueryRayHit*       outHits) {
+  const GeoRay* r[4];
+  for (u32 lane = 0; lane != 4; ++lane) {
+    r[lane] = &rays[math_min(lane, rayCount - 1)]; // Duplicate the last ray into unused lanes.
+  }
+  const SimdVec        eps    = simd_vec_broadcast(f32_epsilon);
+  const QueryRayPacket packet = {
+      .originX = simd_vec_set(r[0]->point.x, r[1]->point.x, r[2]->point.x, r[3]->point.x),
+      .originY = simd_vec_set(r[0]->point.y, r[1]->point.y, r[2]->point.y, r[3]->point.y),
+      .originZ = simd_vec_set(r[0]->point.z, r[1]->point.z, r[2]->point.z, r[3]->point.z),
+      .dirInvX = simd_vec_reciprocal(
+          simd_vec_add(simd_vec_set(r[0]->dir.x, r[1]->dir.x, r[2]->dir.x, r[3]->dir.x), eps)),
+      .dirInvY = simd_vec_reciprocal(
+          simd_vec_add(simd_vec_set(r[0]->dir.y, r[1]->dir.y, r[2]->dir.y, r[3]->dir.y), eps)),
+      .dirInvZ = simd_vec_reciprocal(
+          simd_vec_add(simd_vec_set(r[0]->dir.z, r[1]->dir.z, r[2]->dir.z, r[3]->dir.z), eps)),
+  };
+  const u32 laneMask = (1 << rayCount) - 1;
+
+  bool           found[4] = {false};
+  GeoQueryRayHit best[4];
+  f32            bestTime[4];
+  for (u32 lane = 0; lane != 4; ++lane) {
+    bestTime[lane] = maxDist;
+  }
+
+  u32 queueNodes[64];
+  u32 queueMasks[64];
+  u32 queueCount = 0;
+  if (env->bvh.nodeCount) {
+    const SimdVec bestT = simd_vec_set(bestTime[0], bestTime[1], bestTime[2], bestTime[3]);
+    const u32     mask  = bvh_test_ray_packet(&env->bvh, 0, &packet, bestT) & laneMask;
+    if (mask) {
+      queueNodes[queueCount] = 0; // Insert root node.
+      queueMasks[queueCount] = mask;
+      ++queueCount;
+    }
+  }
+  while (queueCount) {
+    --queueCount;
+    const QueryBvhNode* node = &env->bvh.nodes[queueNodes[queueCount]];
+    const u32           mask = queueMasks[queueCount];
+    if (!query_filter_layer(filter, node->layers)) {
+      continue; // Node does not contain any shapes that are included in the filter.
+    }
+    if (!node->shapeCount) {
+      // Parent node: Test both child nodes against the packet.
+      diag_assert((queueCount + 2) <= array_elems(queueNodes)); // Conservative check.
+      const SimdVec bestT = simd_vec_set(bestTime[0], bestTime[1], bestTime[2], bestTime[3]);
+      const u32 maskA = bvh_test_ray_packet(&env->bvh, node->child, &packet, bestT) & mask;
+      const u32 maskB = bvh_test_ray_packet(&env->bvh, node->child + 1, &packet, bestT) & mask;
+      if (maskA) {
+        queueNodes[queueCount] = node->child;
+        queueMasks[queueCount] = maskA;
+        ++queueCount;
+      }
+      if (maskB) {
+        queueNodes[queueCount] = node->child + 1;
+        queueMasks[queueCount] = maskB;
+        ++queueCount;
+      }
+      continue;
+    }
+    // Leaf node: Test all shapes in the node against the rays that reach it.
+    for (u32 i = 0; i != node->shapeCount; ++i) {
+      const QueryShape    shape       = bvh_shape(&env->bvh, node->child + i);
+      const GeoQueryLayer shapeLayer  = shape_layer(shape, env->prims);
+      const u64           shapeUserId = shape_user_id(shape, env->prims);
+      if (!query_filter_layer(filter, shapeLayer)) {
+        continue; // Shape layer not included in filter.
+      }
+      if (!query_filter_callback(filter, shapeUserId, shapeLayer)) {
+        continue; // Filtered out by the filter's callback.
+      }
+      for (u32 lane = 0; lane != 4; ++lane) {
+        if (!(mask & (1 << lane))) {
+          continue; // Ray does not reach this leaf.
+        }
+        GeoVector normal;
+        const f32 hitT = shape_intersect_ray(shape, env->prims, r[lane], &normal);
+        if (hitT < 0.0f || hitT >= bestTime[lane]) {
+          continue; // Miss or a better hit already found.
+        }
+        // New best hit for this ray.
+        bestTime[lane] = hitT;
+        best[lane]     = (GeoQueryRayHit){
+                .time   = hitT,
+                .userId = shapeUserId,
+                .normal = normal,
+                .layer  = shapeLayer,
+        };
+        found[lane] = true;
+      }
+    }
+  }
+  for (u32 lane = 0; lane != rayCount; ++lane) {
+    outHits[lane] = found[lane] ? best[lane] : (GeoQueryRayHit){.time = -1.0f};
+  }
+}
+#endif // VOLO_SIMD
+
+void geo_query_ray_batch(
+    const GeoQueryEnv*    env,
+    const GeoRay*         rays,
+    const u32             rayCount,
+    const f32             maxDist,
+    const GeoQueryFilter* filter,
+    GeoQueryRayHit*       outHits) {
+  diag_assert(filter);
+  diag_assert_msg(filter->layerMask, "Queries without any layers in the mask won't hit anything");
+  diag_assert_msg(maxDist >= 0.0f, "Maximum raycast distance has to be positive");
+  diag_assert_msg(maxDist <= 1e5f, "Maximum raycast distance ({}) exceeded", fmt_float(1e5f));
+
+#ifdef VOLO_SIMD
+  for (u32 rayIdx = 0; rayIdx != rayCount; ++rayIdx) {
+    query_validate_pos(rays[rayIdx].point);
+    query_validate_dir(rays[rayIdx].dir);
+  }
+  query_stat_add(env, GeoQueryStat_QueryRayCount, (i32)rayCount);
+  for (u32 rayIdx = 0; rayIdx < rayCount; rayIdx += 4) {
+    const u32 packetRays = math_min(rayCount - rayIdx, 4);
+    query_ray_packet(env, rays + rayIdx, packetRays, maxDist, filter, outHits + rayIdx);
+  }
+#else
+  for (u32 rayIdx = 0; rayIdx != rayCount; ++rayIdx) {
+    if (!geo_query_ray(env, &rays[rayIdx], maxDist, filter, &outHits[rayIdx])) {
+      outHits[rayIdx] = (GeoQueryRayHit){.time = -1.0f};
+    }
+  }
+#endif
+}
+
 bool geo_query_ray_fat(
     const GeoQueryEnv*    env,
     const GeoRay*         ray,
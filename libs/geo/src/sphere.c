@@ -1,4 +1,5 @@
 #include "core/array.h"
+#include "core/bitset.h"
 #include "core/diag.h"
 #include "core/float.h"
 #include "core/intrinsic.h"
@@ -111,3 +112,57 @@ bool geo_sphere_overlap_frustum(
   }
   return true;
 }
+
+bool geo_sphere_overlap_frustum4_approx(const GeoSphere* sphere, const GeoPlane frustum[4]) {
+  for (usize i = 0; i != 4; ++i) {
+    const f32 dist = geo_vector_dot(frustum[i].normal, sphere->point);
+    if ((dist + sphere->radius) < frustum[i].distance) {
+      return false; // Sphere is fully behind the plane.
+    }
+  }
+  return true;
+}
+
+void geo_sphere_overlap_frustum4_approx_batch(
+    const GeoSphere* spheres, const u32 count, const GeoPlane frustum[4], const BitSet out) {
+  bitset_clear_all(out);
+#ifdef VOLO_SIMD
+  /**
+   * Transpose the planes so that each register holds one component of all four planes; this way
+   * each sphere is tested against all four planes at once.
+   */
+  ALIGNAS(16) f32 planesData[4][4];
+  for (u32 planeIdx = 0; planeIdx != 4; ++planeIdx) {
+    planesData[0][planeIdx] = frustum[planeIdx].normal.x;
+    planesData[1][planeIdx] = frustum[planeIdx].normal.y;
+    planesData[2][planeIdx] = frustum[planeIdx].normal.z;
+    planesData[3][planeIdx] = frustum[planeIdx].distance;
+  }
+  const SimdVec planesX = simd_vec_load(planesData[0]);
+  const SimdVec planesY = simd_vec_load(planesData[1]);
+  const SimdVec planesZ = simd_vec_load(planesData[2]);
+  const SimdVec planesD = simd_vec_load(planesData[3]);
+
+  for (u32 i = 0; i != count; ++i) {
+    const SimdVec centerX = simd_vec_broadcast(spheres[i].point.x);
+    const SimdVec centerY = simd_vec_broadcast(spheres[i].point.y);
+    const SimdVec centerZ = simd_vec_broadcast(spheres[i].point.z);
+    const SimdVec radius  = simd_vec_broadcast(spheres[i].radius);
+
+    const SimdVec dotX = simd_vec_mul(planesX, centerX);
+    const SimdVec dotY = simd_vec_mul(planesY, centerY);
+    const SimdVec dotZ = simd_vec_mul(planesZ, centerZ);
+    const SimdVec dist = simd_vec_add(simd_vec_add(simd_vec_add(dotX, dotY), dotZ), radius);
+
+    if (simd_vec_mask_u32(simd_vec_less(dist, planesD)) == 0b0000) {
+      bitset_set(out, i); // No plane rejects the sphere.
+    }
+  }
+#else
+  for (u32 i = 0; i != count; ++i) {
+    if (geo_sphere_overlap_frustum4_approx(&spheres[i], frustum)) {
+      bitset_set(out, i);
+    }
+  }
+#endif
+}
@@ -1,5 +1,6 @@
 #include "check/spec.h"
 #include "core/array.h"
+#include "core/bitset.h"
 #include "core/math.h"
 #include "geo/box.h"
 #include "geo/quat.h"
@@ -153,6 +154,41 @@ spec(box) {
     check_eq_vector(transBox.max, geo_vector(4, 5, 1));
   }
 
+  it("can transform a batch of boxes") {
+    const GeoBox boxes[] = {
+        geo_box_from_sphere(geo_vector(1, 2, 3), 1),
+        geo_box_from_sphere(geo_vector(-4, 0, 2), 0.5f),
+        geo_box_from_sphere(geo_vector(0, 0, 0), 2),
+        geo_box_from_sphere(geo_vector(3, -1, 5), 1.5f),
+        geo_box_from_sphere(geo_vector(-2, 2, -2), 3),
+    };
+    const GeoVector offsets[] = {
+        geo_vector(2, 3, -1),
+        geo_vector(0, 0, 0),
+        geo_vector(-1, 5, 2),
+        geo_vector(4, -2, 0),
+        geo_vector(0, 1, 1),
+    };
+    const GeoQuat rotations[] = {
+        geo_quat_ident,
+        geo_quat_angle_axis(90 * math_deg_to_rad, geo_up),
+        geo_quat_angle_axis(45 * math_deg_to_rad, geo_right),
+        geo_quat_angle_axis(-30 * math_deg_to_rad, geo_forward),
+        geo_quat_angle_axis(180 * math_deg_to_rad, geo_up),
+    };
+    const f32 scales[] = {1.0f, 2.0f, 0.5f, 1.5f, 3.0f};
+    const u32 count    = array_elems(boxes);
+
+    GeoBox out[array_elems(boxes)];
+    geo_box_transform3_batch(boxes, offsets, rotations, scales, count, out);
+
+    for (u32 i = 0; i != count; ++i) {
+      const GeoBox expected = geo_box_transform3(&boxes[i], offsets[i], rotations[i], scales[i]);
+      check_eq_vector(out[i].min, expected.min);
+      check_eq_vector(out[i].max, expected.max);
+    }
+  }
+
   it("can compute the bounding box of a sphere") {
     {
       const GeoVector p      = {5, 0, 0};
@@ -340,4 +376,33 @@ spec(box) {
     // NOTE: Inverted boxes are considered to always be intersecting.
     check(geo_box_overlap_frustum4_approx(&inverted, frustum));
   }
+
+  it("can test a batch of boxes for approximate overlap with 4 frustum planes") {
+    const GeoPlane frustum[4] = {
+        {.normal = geo_right, .distance = -1.0f},
+        {.normal = geo_left, .distance = -2.0f},
+        {.normal = geo_down, .distance = -2.0f},
+        {.normal = geo_up, .distance = -1.0f},
+    };
+    const GeoBox boxes[] = {
+        geo_box_from_sphere(geo_vector(0, 0, 0), 0.5f),     // Inside.
+        geo_box_from_sphere(geo_vector(-2, 0, 0), 0.5f),    // Outside (left).
+        geo_box_from_sphere(geo_vector(-1, 0, 0), 0.5f),    // On the left edge.
+        geo_box_from_sphere(geo_vector(0, 3, 0), 0.5f),     // Outside (top).
+        geo_box_from_sphere(geo_vector(0, 0, -2), 0.5f),    // Behind (not culled by side planes).
+        geo_box_inverted3(),                                // Inverted; always intersecting.
+        geo_box_from_sphere(geo_vector(3, 0, 0), 0.5f),     // Outside (right).
+        geo_box_from_sphere(geo_vector(0, -2, 0), 0.5f),    // Outside (bottom).
+        geo_box_from_sphere(geo_vector(0, 2, 0), 0.5f),     // Inside.
+    };
+    const u32 count = array_elems(boxes);
+
+    u8           bitsStorage[2] = {0};
+    const BitSet bits           = bitset_from_array(bitsStorage);
+    geo_box_overlap_frustum4_approx_batch(boxes, count, frustum, bits);
+
+    for (u32 i = 0; i != count; ++i) {
+      check_eq_int(bitset_test(bits, i), geo_box_overlap_frustum4_approx(&boxes[i], frustum));
+    }
+  }
 }
@@ -1,5 +1,6 @@
 #include "check/spec.h"
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/float.h"
 #include "core/rng.h"
 #include "geo/color.h"
@@ -238,4 +239,52 @@ spec(color) {
     check_eq_float(c2.b, c1.b, 1e-2f);
     check_eq_float(c2.a, c1.a, 1e-2f);
   }
+
+  it("can apply the srgb curve to a batch of colors") {
+    Rng* rng = rng_create_xorwow(g_allocHeap, 1337);
+
+    GeoColor colors[7];
+    for (u32 i = 0; i != array_elems(colors); ++i) {
+      colors[i] = geo_color(
+          rng_sample_f32(rng), rng_sample_f32(rng), rng_sample_f32(rng), rng_sample_f32(rng));
+    }
+
+    GeoColor encoded[array_elems(colors)];
+    mem_cpy(mem_var(encoded), mem_var(colors));
+    geo_color_linear_to_srgb_batch(encoded, array_elems(encoded));
+
+    GeoColor decoded[array_elems(colors)];
+    mem_cpy(mem_var(decoded), mem_var(encoded));
+    geo_color_srgb_to_linear_batch(decoded, array_elems(decoded));
+
+    for (u32 i = 0; i != array_elems(colors); ++i) {
+      check_eq_float(encoded[i].a, colors[i].a, 1e-6f); // Alpha is passed through.
+      check_eq_float(decoded[i].r, colors[i].r, 1e-1f);
+      check_eq_float(decoded[i].g, colors[i].g, 1e-1f);
+      check_eq_float(decoded[i].b, colors[i].b, 1e-1f);
+    }
+
+    rng_destroy(rng);
+  }
+
+  it("can pack a batch of colors to bytes") {
+    const GeoColor colors[] = {
+        geo_color(0, 0.25f, 0.5f, 1),
+        geo_color(1, 0.75f, 0.1f, 0),
+        geo_color(-1, 2, 0.999f, 0.001f), // Out of range values are clamped.
+        geo_color(0.2f, 0.4f, 0.6f, 0.8f),
+        geo_color(0.42f, 0.1337f, 0, 1),
+    };
+
+    u8 packed[array_elems(colors) * 4];
+    geo_color_pack_u8_batch(colors, array_elems(colors), packed);
+
+    for (u32 i = 0; i != array_elems(colors); ++i) {
+      const GeoColor c = geo_color_clamp01(colors[i]);
+      check_eq_int(packed[i * 4 + 0], (u8)(c.r * 255.999f));
+      check_eq_int(packed[i * 4 + 1], (u8)(c.g * 255.999f));
+      check_eq_int(packed[i * 4 + 2], (u8)(c.b * 255.999f));
+      check_eq_int(packed[i * 4 + 3], (u8)(c.a * 255.999f));
+    }
+  }
 }
@@ -1,4 +1,5 @@
 #include "check/spec.h"
+#include "core/array.h"
 #include "core/math.h"
 #include "geo/matrix.h"
 
@@ -47,6 +48,52 @@ spec(matrix) {
     check_eq_vector(geo_matrix_transform3_point(&m, geo_vector(2, 1, 0)), geo_vector(2, -1, 3));
   }
 
+  it("produces the same results when transforming a batch of vectors") {
+    const GeoMatrix m = {
+        .columns = {
+            {1, 0, 0, 0},
+            {-1, -3, 0, 0},
+            {2, 1, 1, 0},
+            {1, 2, 3, 1},
+        }};
+    const GeoVector in[] = {
+        geo_vector(2, 1, 0, 1),
+        geo_vector(-1, 3, 2, 0),
+        geo_vector(0.5f, -2, 4, 1),
+        geo_vector(0, 0, 0, 1),
+        geo_vector(1, 1, 1, 1),
+    };
+    GeoVector out[array_elems(in)];
+    geo_matrix_transform_batch(&m, in, out, array_elems(in));
+
+    for (u32 i = 0; i != array_elems(in); ++i) {
+      check_eq_vector(out[i], geo_matrix_transform(&m, in[i]));
+    }
+  }
+
+  it("produces the same results when transforming a batch of points") {
+    const GeoMatrix m = {
+        .columns = {
+            {1, 0, 0, 0},
+            {-1, -3, 0, 0},
+            {2, 1, 1, 0},
+            {1, 2, 3, 0},
+        }};
+    const GeoVector in[] = {
+        geo_vector(2, 1, 0),
+        geo_vector(-1, 3, 2),
+        geo_vector(0.5f, -2, 4),
+        geo_vector(0, 0, 0),
+        geo_vector(1, 1, 1),
+    };
+    GeoVector out[array_elems(in)];
+    geo_matrix_transform3_point_batch(&m, in, out, array_elems(in));
+
+    for (u32 i = 0; i != array_elems(in); ++i) {
+      check_eq_vector(out[i], geo_matrix_transform3_point(&m, in[i]));
+    }
+  }
+
   it("exchanges the rows and columns when transposing") {
     const GeoMatrix m = {.columns = {{1, 4, 7}, {2, 5, 8}, {3, 6, 9}}};
     const GeoMatrix t = {.columns = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
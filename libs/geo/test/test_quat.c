@@ -108,6 +108,23 @@ spec(quat) {
     check_eq_float(geo_vector_mag(geo_vector(qn.x, qn.y, qn.z, qn.w)), 1, 1e-6);
   }
 
+  it("can normalize a batch of quaternions") {
+    GeoQuat quats[] = {
+        {1337, 42, -42, 5},
+        {1, 2, 3, 4},
+        {-4, 3, -2, 1},
+        {0.1f, 0.2f, 0.3f, 0.4f},
+        {5, -5, 5, -5},
+        {42, 0, 0, 1},
+    };
+    geo_quat_norm_batch(quats, array_elems(quats));
+
+    for (u32 i = 0; i != array_elems(quats); ++i) {
+      const GeoQuat qn = quats[i];
+      check_eq_float(geo_vector_mag(geo_vector(qn.x, qn.y, qn.z, qn.w)), 1, 1e-6);
+    }
+  }
+
   it("can normalize a quaternion (even if zero length)") {
     {
       const GeoQuat q  = {0};
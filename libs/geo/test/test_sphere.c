@@ -1,5 +1,7 @@
 #include "check/spec.h"
 #include "core/array.h"
+#include "core/bitset.h"
+#include "geo/plane.h"
 #include "geo/sphere.h"
 
 spec(sphere) {
@@ -85,4 +87,33 @@ spec(sphere) {
             &(GeoSphere){.point = {0, 0, .8f}, .radius = 0.6f}),
         "Sphere overlap check failed");
   }
+
+  it("can test a batch of spheres for approximate overlap with 4 frustum planes") {
+    const GeoPlane frustum[4] = {
+        {.normal = geo_right, .distance = -1.0f},
+        {.normal = geo_left, .distance = -2.0f},
+        {.normal = geo_down, .distance = -2.0f},
+        {.normal = geo_up, .distance = -1.0f},
+    };
+    const GeoSphere spheres[] = {
+        {.point = {0, 0, 0}, .radius = 0.5f},     // Inside.
+        {.point = {-3, 0, 0}, .radius = 0.5f},    // Outside (left).
+        {.point = {-1, 0, 0}, .radius = 0.5f},    // On the left edge.
+        {.point = {0, 3, 0}, .radius = 0.5f},     // Outside (top).
+        {.point = {0, 0, -2}, .radius = 0.5f},    // Behind (not culled by side planes).
+        {.point = {3, 0, 0}, .radius = 0.5f},     // Outside (right).
+        {.point = {0, -3, 0}, .radius = 0.5f},    // Outside (bottom).
+        {.point = {0, 2, 0}, .radius = 0.5f},     // Inside.
+        {.point = {1, 1, 5}, .radius = 0.5f},     // Inside (depth is not culled).
+    };
+    const u32 count = array_elems(spheres);
+
+    u8           bitsStorage[2] = {0};
+    const BitSet bits           = bitset_from_array(bitsStorage);
+    geo_sphere_overlap_frustum4_approx_batch(spheres, count, frustum, bits);
+
+    for (u32 i = 0; i != count; ++i) {
+      check_eq_int(bitset_test(bits, i), geo_sphere_overlap_frustum4_approx(&spheres[i], frustum));
+    }
+  }
 }
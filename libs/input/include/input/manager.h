@@ -62,6 +62,15 @@ TimeDuration    input_doubleclick_interval(const InputManagerComp*);
 bool   input_triggered(const InputManagerComp*, StringHash actionHash);
 String input_label(const InputManagerComp*, StringHash actionHash);
 
+/**
+ * Retrieve the (deduplicated) names of all actions that were triggered this tick.
+ * Cheaper than testing actions individually when consuming many actions; the list is rebuilt every
+ * tick so consumers observe each trigger exactly once.
+ * NOTE: Returned memory is valid until the next input update.
+ */
+const StringHash* input_triggered_data(const InputManagerComp*);
+u32               input_triggered_count(const InputManagerComp*);
+
 typedef struct {
   StringHash nameHash;
   String     label; // Memory valid for 1 frame.
@@ -17,6 +17,27 @@
 
 #define input_label_chunk_size (1 * usize_kibibyte)
 
+typedef struct {
+  StringHash actionName;
+  u16        actionBlockers;    // InputBlocker bits.
+  u8         type;              // AssetInputType.
+  u8         requiredModifiers; // InputModifier bits.
+  u8         illegalModifiers;  // InputModifier bits.
+} InputCompiledBinding;
+
+/**
+ * Input-map bindings flattened into a dense per-key table. Per-tick resolution then only visits
+ * keys that have bindings (and rejects inactive keys with a single state test) instead of
+ * re-evaluating every binding of every action.
+ */
+typedef struct {
+  EcsEntityId           asset;
+  const void*           source;   // Source binding array; detects asset reloads.
+  InputCompiledBinding* bindings; // Grouped per key, ranges given by 'keyBegin'.
+  u32                   bindingCount;
+  u16                   keyBegin[GapKey_Count + 1]; // Per key: first binding, end at the next key.
+} InputCompiledMap;
+
 ecs_comp_define(InputManagerComp) {
   EcsEntityId     activeWindow;
   InputBlocker    blockers : 16;
@@ -32,14 +53,26 @@ ecs_comp_define(InputManagerComp) {
 
   Allocator* infoAlloc;   // Allocator for transient info data (for example label strings).
   DynArray   actionInfos; // InputActionInfo[], sorted on the name.
+
+  InputCompiledMap compiledMaps[input_resource_max_maps];
 };
 
+static void input_compiled_map_clear(InputCompiledMap* compiled) {
+  if (compiled->bindings) {
+    alloc_free_array_t(g_allocHeap, compiled->bindings, compiled->bindingCount);
+  }
+  *compiled = (InputCompiledMap){0};
+}
+
 static void ecs_destruct_input_manager(void* data) {
   InputManagerComp* comp = data;
   dynarray_destroy(&comp->triggeredActions);
   dynarray_destroy(&comp->activeLayers);
   alloc_chunked_destroy(comp->infoAlloc);
   dynarray_destroy(&comp->actionInfos);
+  array_for_t(comp->compiledMaps, InputCompiledMap, compiled) {
+    input_compiled_map_clear(compiled);
+  }
 }
 
 static i8 input_compare_action_info(const void* a, const void* b) {
@@ -73,44 +106,86 @@ static const AssetInputMapComp* input_map_asset(EcsWorld* world, const EcsEntity
   return itr ? ecs_view_read_t(itr, AssetInputMapComp) : null;
 }
 
-static bool input_binding_satisfied(
-    const InputManagerComp* manager, const AssetInputBinding* binding, const GapWindowComp* win) {
-
-  // Check that all required modifiers are active.
-  if ((binding->requiredModifiers & manager->modifiers) != binding->requiredModifiers) {
-    return false;
+static void input_compiled_map_build(
+    InputCompiledMap* compiled, const EcsEntityId asset, const AssetInputMapComp* map) {
+  input_compiled_map_clear(compiled);
+  compiled->asset  = asset;
+  compiled->source = map->bindings.values;
+
+  // Count the bindings per key.
+  u16 keyCounts[GapKey_Count] = {0};
+  heap_array_for_t(map->actions, AssetInputAction, action) {
+    for (u16 i = 0; i != action->bindingCount; ++i) {
+      const AssetInputBinding* binding = &map->bindings.values[action->bindingIndex + i];
+      if (LIKELY(binding->key < GapKey_Count)) {
+        ++keyCounts[binding->key];
+        ++compiled->bindingCount;
+      }
+    }
   }
 
-  // Check that none of the illegal modifiers are active.
-  if (binding->illegalModifiers & manager->modifiers) {
-    return false;
+  // Compute the per-key ranges (prefix sum of the counts).
+  u16 cursor = 0;
+  for (u32 key = 0; key != GapKey_Count; ++key) {
+    compiled->keyBegin[key] = cursor;
+    cursor += keyCounts[key];
   }
+  compiled->keyBegin[GapKey_Count] = cursor;
 
-  // Check that the key is active.
-  switch (binding->type) {
-  case AssetInputType_Pressed:
-    return gap_window_key_pressed(win, binding->key);
-  case AssetInputType_Released:
-    return gap_window_key_released(win, binding->key);
-  case AssetInputType_Down:
-    return gap_window_key_down(win, binding->key);
+  if (!compiled->bindingCount) {
+    return;
+  }
+  compiled->bindings = alloc_array_t(g_allocHeap, InputCompiledBinding, compiled->bindingCount);
+
+  // Fill the per-key ranges; 'keyCounts' is reused as the per-key write cursor.
+  mem_set(array_mem(keyCounts), 0);
+  heap_array_for_t(map->actions, AssetInputAction, action) {
+    for (u16 i = 0; i != action->bindingCount; ++i) {
+      const AssetInputBinding* binding = &map->bindings.values[action->bindingIndex + i];
+      if (UNLIKELY(binding->key >= GapKey_Count)) {
+        continue;
+      }
+      const u16 slot           = compiled->keyBegin[binding->key] + keyCounts[binding->key]++;
+      compiled->bindings[slot] = (InputCompiledBinding){
+          .actionName        = action->name,
+          .actionBlockers    = (u16)action->blockers,
+          .type              = (u8)binding->type,
+          .requiredModifiers = (u8)binding->requiredModifiers,
+          .illegalModifiers  = (u8)binding->illegalModifiers,
+      };
+    }
   }
-  diag_crash();
 }
 
-static bool input_action_satisfied(
-    const InputManagerComp*  manager,
-    const AssetInputMapComp* map,
-    const AssetInputAction*  action,
-    const GapWindowComp*     win) {
-
-  for (usize i = 0; i != action->bindingCount; ++i) {
-    const AssetInputBinding* binding = &map->bindings.values[action->bindingIndex + i];
-    if (input_binding_satisfied(manager, binding, win)) {
-      return true;
+/**
+ * Retrieve the compiled table for the given input-map, (re)building it when the map was (re)loaded.
+ * NOTE: Returns null when the map asset is not currently loaded.
+ */
+static const InputCompiledMap* input_compiled_map_get(
+    InputManagerComp* manager, const EcsEntityId asset, const AssetInputMapComp* map) {
+  InputCompiledMap* slot     = null;
+  InputCompiledMap* freeSlot = null;
+  array_for_t(manager->compiledMaps, InputCompiledMap, compiled) {
+    if (compiled->asset == asset) {
+      slot = compiled;
+    } else if (!compiled->asset && !freeSlot) {
+      freeSlot = compiled;
     }
   }
-  return false;
+  if (!map) {
+    if (slot) {
+      input_compiled_map_clear(slot); // Map was unloaded; drop the stale table.
+    }
+    return null;
+  }
+  if (!slot) {
+    slot = freeSlot;
+    diag_assert(slot); // Cannot fail as there are as many slots as resource map slots.
+  }
+  if (slot->asset != asset || slot->source != map->bindings.values) {
+    input_compiled_map_build(slot, asset, map);
+  }
+  return slot;
 }
 
 static void input_refresh_active_window(EcsWorld* world, InputManagerComp* manager) {
@@ -190,15 +265,52 @@ static void input_update_cursor(InputManagerComp* manager, GapWindowComp* win) {
 }
 
 static void input_update_triggered(
-    InputManagerComp* manager, const AssetInputMapComp* map, GapWindowComp* win) {
+    InputManagerComp* manager, const InputCompiledMap* compiled, const GapWindowComp* win) {
 
-  for (usize i = 0; i != map->actions.count; ++i) {
-    const AssetInputAction* action = &map->actions.values[i];
-    if (manager->blockers & action->blockers) {
-      continue;
+  for (u32 key = 0; key != GapKey_Count; ++key) {
+    const u16 begin = compiled->keyBegin[key];
+    const u16 end   = compiled->keyBegin[key + 1];
+    if (begin == end) {
+      continue; // Key has no bindings.
+    }
+    const bool down     = gap_window_key_down(win, (GapKey)key);
+    const bool pressed  = gap_window_key_pressed(win, (GapKey)key);
+    const bool released = gap_window_key_released(win, (GapKey)key);
+    if (!down && !pressed && !released) {
+      continue; // Key is inactive; skip all its bindings.
     }
-    if (input_action_satisfied(manager, map, action, win)) {
-      *dynarray_push_t(&manager->triggeredActions, StringHash) = action->name;
+    for (u16 i = begin; i != end; ++i) {
+      const InputCompiledBinding* binding = &compiled->bindings[i];
+      if (manager->blockers & binding->actionBlockers) {
+        continue;
+      }
+      if ((binding->requiredModifiers & manager->modifiers) != binding->requiredModifiers) {
+        continue;
+      }
+      if (binding->illegalModifiers & manager->modifiers) {
+        continue;
+      }
+      bool satisfied;
+      switch ((AssetInputType)binding->type) {
+      case AssetInputType_Pressed:
+        satisfied = pressed;
+        break;
+      case AssetInputType_Released:
+        satisfied = released;
+        break;
+      case AssetInputType_Down:
+        satisfied = down;
+        break;
+      default:
+        diag_crash();
+      }
+      if (!satisfied) {
+        continue;
+      }
+      const StringHash name = binding->actionName;
+      if (!dynarray_search_linear(&manager->triggeredActions, compare_stringhash, &name)) {
+        *dynarray_push_t(&manager->triggeredActions, StringHash) = name;
+      }
     }
   }
 }
@@ -292,9 +404,10 @@ ecs_system_define(InputUpdateSys) {
   EcsEntityId mapAssets[input_resource_max_maps];
   u32         mapAssetCount = input_resource_maps(resource, mapAssets);
   for (u32 i = 0; i != mapAssetCount; ++i) {
-    const AssetInputMapComp* map = input_map_asset(world, mapAssets[i]);
+    const AssetInputMapComp* map      = input_map_asset(world, mapAssets[i]);
+    const InputCompiledMap*  compiled = input_compiled_map_get(manager, mapAssets[i], map);
     if (map && input_layer_active(manager, map->layer)) {
-      input_update_triggered(manager, map, win);
+      input_update_triggered(manager, compiled, win);
       input_update_action_info(manager, platform, map);
     }
   }
@@ -359,6 +472,14 @@ bool input_triggered(const InputManagerComp* manager, const StringHash actionHas
   return dynarray_search_linear(&manMut->triggeredActions, compare_stringhash, &actionHash) != null;
 }
 
+const StringHash* input_triggered_data(const InputManagerComp* manager) {
+  return dynarray_begin_t(&manager->triggeredActions, StringHash);
+}
+
+u32 input_triggered_count(const InputManagerComp* manager) {
+  return (u32)manager->triggeredActions.size;
+}
+
 String input_label(const InputManagerComp* manager, const StringHash actionHash) {
   InputManagerComp*      manMut = (InputManagerComp*)manager;
   const InputActionInfo  key    = {.nameHash = actionHash};
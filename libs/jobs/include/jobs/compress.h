@@ -0,0 +1,13 @@
+#pragma once
+#include "core/forward.h"
+
+/**
+ * Compress data by fanning chunks out over the job system.
+ * Each chunk is deflated independently and the resulting sub-streams are stitched into a single
+ * valid GZIP (RFC 1952) / ZLIB (RFC 1950) stream, so throughput scales with the worker count.
+ * NOTE: Falls back to single-threaded compression for small inputs.
+ * Pre-condition: g_jobsIsWorker == true
+ * Pre-condition: jobs_is_working() == false
+ */
+void jobs_compress_gzip(String input, DynString* out);
+void jobs_compress_zlib(String input, DynString* out);
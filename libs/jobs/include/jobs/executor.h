@@ -43,3 +43,29 @@ bool jobs_is_working(void);
  * Pre-condition: jobs_is_working() == true
  */
 Mem jobs_scratchpad(JobTaskId);
+
+/**
+ * Allocate temporary memory scoped to the currently executing job.
+ * Served from a per-job arena (lock-free atomic bump) and recycled when the job completes, so
+ * tasks can hold the memory across workers without involving the thread-local scratch allocator.
+ * NOTE: Returns invalid memory when the job arena is exhausted.
+ * Pre-condition: jobs_is_working() == true
+ */
+Mem jobs_alloc(usize size, usize align);
+
+/**
+ * Routine to test if a wait is over; should be cheap and free of side-effects as it is polled.
+ * 'ctx' is the pointer that was given to 'jobs_wait_help()'.
+ */
+typedef bool (*JobsWaitPredicate)(const void* ctx);
+
+/**
+ * Block until the given predicate returns true, helping with queued tasks while waiting.
+ * Allows tasks to wait mid-execution (for example on a gpu readback or asset readiness) without
+ * stalling the worker thread: other tasks are executed nested on this thread until the predicate
+ * is satisfied.
+ * NOTE: The predicate must be satisfied by another thread (or external agent); a task that waits
+ * on work that (transitively) depends on its own completion will deadlock.
+ * Pre-condition: g_jobsIsWorker == true
+ */
+void jobs_wait_help(JobsWaitPredicate, const void* ctx);
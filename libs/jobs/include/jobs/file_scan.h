@@ -0,0 +1,24 @@
+#pragma once
+#include "core/file_iterator.h"
+
+/**
+ * Handler invoked for every regular file found during a scan.
+ * NOTE: Invoked in parallel from multiple job workers; the handler must be thread-safe.
+ * NOTE: 'path' is relative to the scanned root and is only valid for the duration of the call,
+ * should NOT be stored (duplicate it if needed).
+ */
+typedef void (*JobsFileScanHandler)(void* ctx, String path);
+
+/**
+ * Recursively scan the given directory by fanning sub-directories out over the job system,
+ * invoking the handler for every regular file, so throughput scales with the worker count.
+ * NOTE: Order is non deterministic.
+ * NOTE: Falls back to a single-threaded scan when only one worker is available.
+ *
+ * Returns 'End' when the whole tree was scanned, otherwise the first error that was encountered
+ * (the scan still visits the remaining directories).
+ *
+ * Pre-condition: g_jobsIsWorker == true
+ * Pre-condition: jobs_is_working() == false
+ */
+FileIteratorResult jobs_file_scan(String rootPath, JobsFileScanHandler, void* ctx);
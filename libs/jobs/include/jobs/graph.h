@@ -23,6 +23,12 @@ typedef enum eJobTaskFlags {
    * NOTE: Care must be taken that the name has a longer lifetime then the graph.
    */
   JobTaskFlags_BorrowName = 1 << 1,
+
+  /**
+   * The task is latency-critical (for example audio-buffer filling); it is pushed to a dedicated
+   * high-priority lane that workers always drain before taking normal work.
+   */
+  JobTaskFlags_HighPriority = 1 << 2,
 } JobTaskFlags;
 
 /**
@@ -106,6 +112,19 @@ void jobs_graph_copy(JobGraph* dst, JobGraph* src);
  */
 JobTaskId jobs_graph_add_task(JobGraph*, String name, JobTaskRoutine, Mem ctx, JobTaskFlags);
 
+/**
+ * Attempt to rebind an existing task instead of rebuilding the graph.
+ * Validates that the task still matches the given name and flags and then patches the routine and
+ * the user context in place; dependencies registered on the task are preserved. This allows
+ * callers that schedule the same graph repeatedly to refresh the per-task user-data without paying
+ * for task allocation and dependency re-derivation.
+ * Returns false when the task does not match (the graph has to be rebuilt in that case).
+ *
+ * Pre-condition: JobGraph is not running at the moment.
+ * Pre-condition: ctx.size <= 32.
+ */
+bool jobs_graph_task_rebind(JobGraph*, JobTaskId, String name, JobTaskRoutine, Mem ctx, JobTaskFlags);
+
 /**
  * Register a dependency between two tasks. The child task will only be started after the parent
  * task has finished.
@@ -204,3 +223,12 @@ JobTaskChildItr jobs_graph_task_child_next(const JobGraph*, JobTaskChildItr);
  */
 u64 jobs_graph_task_span(const JobGraph*);
 u64 jobs_graph_task_span_cost(const JobGraph*, JobsCostEstimator, const void* userCtx);
+
+/**
+ * Calculate the job span and additionally mark the tasks that lie on the longest (aka 'critical')
+ * path in the given bit-set.
+ *
+ * Pre-condition: outTasks can hold at least 'jobs_graph_task_count()' bits.
+ */
+u64 jobs_graph_task_span_path(
+    const JobGraph*, JobsCostEstimator, const void* userCtx, BitSet outTasks);
@@ -7,6 +7,12 @@
  */
 typedef u64 JobId;
 
+/**
+ * Routine to invoke when a job (or set of jobs) completes.
+ * 'context' is a pointer to the memory that was given when registering the continuation.
+ */
+typedef void (*JobsContinuation)(const void* context);
+
 /**
  * Run a new job graph the given graph definition.
  * Returns a handle to the running job.
@@ -14,6 +20,24 @@ typedef u64 JobId;
  */
 JobId jobs_scheduler_run(JobGraph* graph, Allocator*);
 
+/**
+ * Register a continuation to run when the given job completes.
+ * Invoked on the worker that finishes the job, no thread is parked in between. When the job has
+ * already finished the continuation is invoked immediately on the calling thread.
+ * NOTE: 'ctx' is copied when registering the continuation.
+ * Pre-condition: ctx.size <= 48.
+ */
+void jobs_scheduler_continue(JobId, JobsContinuation, Mem ctx);
+
+/**
+ * Register a continuation to run when all of the given jobs have completed.
+ * Invoked once, on the worker that finishes the last job; jobs that have already finished count
+ * towards completion immediately.
+ * NOTE: 'ctx' is copied when registering the continuation.
+ * Pre-condition: ctx.size <= 48.
+ */
+void jobs_scheduler_continue_many(const JobId* jobs, u32 jobCount, JobsContinuation, Mem ctx);
+
 /**
  * Check if the given job has finished yet.
  */
@@ -39,3 +63,8 @@ void jobs_scheduler_wait_help(JobId);
  */
 usize jobs_scheduler_mem_size(const JobGraph*);
 usize jobs_scheduler_mem_align(const JobGraph*);
+
+/**
+ * Query the required memory size to run any job graph with at most the given amount of tasks.
+ */
+usize jobs_scheduler_mem_size_max(u32 taskCount);
@@ -0,0 +1,21 @@
+#pragma once
+#include "core/sort.h"
+
+/**
+ * Sort elements according to the given compare function.
+ * NOTE: The sort is non-stable, meaning order of equal elements is NOT preserved.
+ * Pre-condition: stride <= 128.
+ */
+#define jobs_sort_t(_BEGIN_, _END_, _TYPE_, _COMPARE_FUNC_)                                        \
+  jobs_sort((u8*)(_BEGIN_), (u8*)(_END_), sizeof(_TYPE_), (_COMPARE_FUNC_))
+
+/**
+ * Sort elements according to the given compare function by fanning sections out over the job
+ * system and merging the sorted sections, so throughput scales with the worker count.
+ * NOTE: The sort is non-stable, meaning order of equal elements is NOT preserved.
+ * NOTE: Falls back to a single-threaded quicksort for small collections.
+ * Pre-condition: stride <= 128.
+ * Pre-condition: g_jobsIsWorker == true
+ * Pre-condition: jobs_is_working() == false
+ */
+void jobs_sort(u8* begin, u8* end, u16 stride, CompareFunc);
@@ -23,6 +23,12 @@ void affqueue_destroy(Allocator* alloc, AffQueue* aq) {
   alloc_free_array_t(alloc, aq->items, affqueue_max_items);
 }
 
+u32 affqueue_size(const AffQueue* aq) {
+  const i64 bottom = aq->bottom;
+  const i64 top    = thread_atomic_load_i64((i64*)&aq->top);
+  return (u32)(top >= bottom ? top - bottom : 0);
+}
+
 void affqueue_push(AffQueue* aq, Job* job, const JobTaskId task) {
   const i64     idx  = thread_atomic_add_i64(&aq->top, 1);
   AffQueueItem* item = aq->items + item_wrap(idx);
@@ -49,3 +55,20 @@ WorkItem affqueue_pop(AffQueue* aq) {
   ++aq->bottom;
   return item->work;
 }
+
+u32 affqueue_pop_many(AffQueue* aq, WorkItem out[], const u32 capacity) {
+  const i64 bottom = aq->bottom; // No atomic load as its only written to from this thread.
+  const i64 top    = thread_atomic_load_i64(&aq->top);
+
+  u32 count = 0;
+  while (count != capacity && (bottom + count) != top) {
+    AffQueueItem* item            = aq->items + item_wrap(bottom + count);
+    i64           expectedHasData = true;
+    if (!thread_atomic_compare_exchange_i64(&item->hasData, &expectedHasData, false)) {
+      break; // Producer has claimed the slot but not published the item yet.
+    }
+    out[count++] = item->work;
+  }
+  aq->bottom = bottom + count;
+  return count;
+}
@@ -6,8 +6,10 @@
 /**
  * Affinity Queue, queue for tasks that can only be run on a specific thread.
  *
- * It is a multi-producer single-consumer FIFO queue where all threads can push work but only the
- * owning thread can pop.
+ * It is a lock-free multi-producer single-consumer FIFO ring where all threads can push work but
+ * only the owning thread can pop. Producers claim a slot with an atomic ticket and publish it with
+ * a per-slot flag; the consumer can dequeue published items in batches to amortize the atomic
+ * operations.
  */
 
 #define affqueue_max_items 256
@@ -25,6 +27,11 @@ typedef struct {
 AffQueue affqueue_create(Allocator*);
 void     affqueue_destroy(Allocator*, AffQueue*);
 
+/**
+ * Amount of items in the queue; only an indication as it can be raced by producers.
+ */
+u32 affqueue_size(const AffQueue*);
+
 /**
  * Push a new item to the queue.
  * NOTE: Can be called by any thread.
@@ -36,3 +43,11 @@ void affqueue_push(AffQueue*, Job*, JobTaskId);
  * NOTE: Can only be called by the owning thread.
  */
 WorkItem affqueue_pop(AffQueue*);
+
+/**
+ * Pop up to 'capacity' items from the queue in a FIFO manner.
+ * Stops at the first item that has not been published by its producer yet.
+ * Returns the amount of items written to the output array.
+ * NOTE: Can only be called by the owning thread.
+ */
+u32 affqueue_pop_many(AffQueue*, WorkItem out[], u32 capacity);
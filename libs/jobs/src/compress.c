@@ -0,0 +1,76 @@
+#include "core/alloc.h"
+#include "core/deflate.h"
+#include "core/dynstring.h"
+#include "core/gzip.h"
+#include "core/math.h"
+#include "core/zlib.h"
+#include "jobs/compress.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
+
+/**
+ * Size of the input chunks that are compressed in parallel.
+ * Bigger chunks compress slightly better (matches cannot cross chunk boundaries) while smaller
+ * chunks distribute better over the workers.
+ */
+#define compress_chunk_size (256 * usize_kibibyte)
+
+typedef struct {
+  String     input;
+  bool       last;
+  DynString* out;
+} CompressChunkData;
+
+static void compress_task_chunk(const void* ctx) {
+  const CompressChunkData* data = ctx;
+  deflate_encode_chunk(data->input, data->last, data->out);
+}
+
+/**
+ * Produce a deflate stream for the input by compressing chunks in parallel and concatenating the
+ * resulting (byte aligned) sub-streams.
+ */
+static void compress_run(const String input, DynString* out) {
+  const usize chunkCount = math_max(1, (input.size + compress_chunk_size - 1) / compress_chunk_size);
+  if (chunkCount == 1) {
+    deflate_encode(input, out);
+    return;
+  }
+
+  JobGraph*  graph     = jobs_graph_create(g_allocHeap, string_lit("Compress"), (u32)chunkCount);
+  DynString* chunkOuts = alloc_array_t(g_allocHeap, DynString, chunkCount);
+  for (usize i = 0; i != chunkCount; ++i) {
+    chunkOuts[i] = dynstring_create(g_allocHeap, compress_chunk_size / 2);
+
+    const usize  offset = i * compress_chunk_size;
+    const String chunk  = mem_slice(input, offset, math_min(compress_chunk_size, input.size - offset));
+    jobs_graph_add_task(
+        graph,
+        string_lit("CompressChunk"),
+        compress_task_chunk,
+        mem_struct(
+            CompressChunkData, .input = chunk, .last = i == (chunkCount - 1), .out = &chunkOuts[i]),
+        JobTaskFlags_None);
+  }
+
+  jobs_scheduler_wait_help(jobs_scheduler_run(graph, g_allocHeap));
+
+  for (usize i = 0; i != chunkCount; ++i) {
+    dynstring_append(out, dynstring_view(&chunkOuts[i]));
+    dynstring_destroy(&chunkOuts[i]);
+  }
+  alloc_free_array_t(g_allocHeap, chunkOuts, chunkCount);
+  jobs_graph_destroy(graph);
+}
+
+void jobs_compress_gzip(const String input, DynString* out) {
+  gzip_encode_header(out);
+  compress_run(input, out);
+  gzip_encode_trailer(input, out);
+}
+
+void jobs_compress_zlib(const String input, DynString* out) {
+  zlib_encode_header(out);
+  compress_run(input, out);
+  zlib_encode_trailer(input, out);
+}
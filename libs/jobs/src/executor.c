@@ -2,6 +2,7 @@
 #include "core/math.h"
 #include "core/rng.h"
 #include "core/thread.h"
+#include "core/time.h"
 #include "jobs/graph.h"
 #include "jobs/init.h"
 #include "trace/tracer.h"
@@ -18,6 +19,10 @@
 #define worker_min_count 1
 #define worker_max_count 4
 
+// Bounds for the (adaptive) amount of steal iterations a worker performs before parking.
+#define worker_spin_itrs_min 250
+#define worker_spin_itrs_max 2500
+
 // Maximum amount of root tasks in a job.
 #define job_max_root_tasks 1024
 
@@ -33,6 +38,8 @@ static ExecMode        g_mode = ExecMode_Running; // Change only while holding '
 static ThreadHandle    g_workerThreads[worker_max_count];
 static WorkQueue       g_workerQueues[worker_max_count];
 static i32             g_sleepingWorkers;
+static i32             g_wakeTokens; // Pending wake permits; parked workers consume one to wake.
+static i64             g_parkCounter, g_wakeCounter; // Stats, surfaced through trace.
 static ThreadMutex     g_mutex;
 static ThreadCondition g_wakeCondition;
 
@@ -53,25 +60,88 @@ THREAD_LOCAL bool        g_jobsIsWorker;
 THREAD_LOCAL JobTaskId   g_jobsTaskId;
 THREAD_LOCAL Job*        g_jobsCurrent;
 
-static void executor_wake_worker_all(void) {
-  thread_mutex_lock(g_mutex);
-  thread_cond_broadcast(g_wakeCondition);
-  thread_mutex_unlock(g_mutex);
+/**
+ * Attempt to consume a pending wake permit.
+ * Workers that are about to park (or got woken) consume a permit; workers without a permit go back
+ * to sleep, which throttles the amount of woken workers to the amount of runnable tasks.
+ */
+static bool executor_wake_token_take(void) {
+  i32 tokens = thread_atomic_load_i32(&g_wakeTokens);
+  while (tokens > 0) {
+    if (thread_atomic_compare_exchange_i32(&g_wakeTokens, &tokens, tokens - 1)) {
+      return true;
+    }
+  }
+  return false;
 }
 
-static void executor_wake_worker_single(void) {
+/**
+ * Wake (up to) the given amount of sleeping workers.
+ * Publishes a wake permit per woken worker so a signal that races with a worker that is about to
+ * park is not lost: the parking worker will consume the permit and skip the park instead.
+ */
+static void executor_wake_workers(u32 count) {
+  const i32 sleepingWorkers = thread_atomic_load_i32(&g_sleepingWorkers);
+  if (sleepingWorkers <= 0) {
+    return; // All workers are already awake.
+  }
+  count = math_min(count, (u32)sleepingWorkers);
   thread_mutex_lock(g_mutex);
-  thread_cond_signal(g_wakeCondition);
+  thread_atomic_add_i32(&g_wakeTokens, (i32)count);
+  thread_atomic_add_i64(&g_wakeCounter, (i64)count);
+  if (count >= (u32)sleepingWorkers) {
+    thread_cond_broadcast(g_wakeCondition);
+  } else {
+    for (u32 i = 0; i != count; ++i) {
+      thread_cond_signal(g_wakeCondition);
+    }
+  }
   thread_mutex_unlock(g_mutex);
 }
 
+static WorkQueueLane executor_task_lane(const JobTask* taskDef) {
+  return taskDef->flags & JobTaskFlags_HighPriority ? WorkQueueLane_High : WorkQueueLane_Normal;
+}
+
+// Amount of affinity items to dequeue at once; amortizes the queue's atomic operations.
+#define executor_affinity_batch_max 8
+
+static THREAD_LOCAL WorkItem g_affinityBatch[executor_affinity_batch_max];
+static THREAD_LOCAL u32      g_affinityBatchCount, g_affinityBatchIndex;
+
+/**
+ * Retrieve the next affinity work item, refilling the thread-local batch from the affinity-queue
+ * when its empty.
+ * NOTE: Should only be called by the 'g_affinityWorker'.
+ */
+static WorkItem executor_affinity_next(void) {
+  if (g_affinityBatchIndex == g_affinityBatchCount) {
+    g_affinityBatchIndex = 0;
+    g_affinityBatchCount =
+        affqueue_pop_many(&g_affinityQueue, g_affinityBatch, executor_affinity_batch_max);
+    if (g_affinityBatchCount == executor_affinity_batch_max) {
+      // Queue depth exceeds the batch size; surface it so affinity bottlenecks show up in traces.
+      trace_begin_msg(
+          "job_affinity_backlog",
+          TraceColor_Red,
+          "depth: {}",
+          fmt_int(g_affinityBatchCount + affqueue_size(&g_affinityQueue)));
+      trace_end();
+    }
+  }
+  if (g_affinityBatchIndex != g_affinityBatchCount) {
+    return g_affinityBatch[g_affinityBatchIndex++];
+  }
+  return (WorkItem){0};
+}
+
 static WorkItem executor_work_pop(const JobWorkerId wId) {
   if (wId == g_affinityWorker) {
     /**
      * This worker is the assigned 'Affinity worker' and thus we need to serve the affinity-queue
      * first before taking from our normal queue.
      */
-    const WorkItem affinityItem = affqueue_pop(&g_affinityQueue);
+    const WorkItem affinityItem = executor_affinity_next();
     if (workitem_valid(affinityItem)) {
       return affinityItem;
     }
@@ -82,7 +152,7 @@ static WorkItem executor_work_pop(const JobWorkerId wId) {
 static WorkItem executor_work_pop_for_job(const JobWorkerId wId, const JobId jobId) {
   if (wId == g_affinityWorker) {
     // This worker is the assigned 'Affinity worker', affinity work always takes precedence.
-    const WorkItem affinityItem = affqueue_pop(&g_affinityQueue);
+    const WorkItem affinityItem = executor_affinity_next();
     if (workitem_valid(affinityItem)) {
       return affinityItem;
     }
@@ -93,7 +163,8 @@ static WorkItem executor_work_pop_for_job(const JobWorkerId wId, const JobId job
       return item;
     }
     // Not for this job; push it back to the queue.
-    workqueue_push(&g_workerQueues[wId], item.job, item.task);
+    const JobTask* taskDef = jobs_graph_task_def(item.job->graph, item.task);
+    workqueue_push(&g_workerQueues[wId], executor_task_lane(taskDef), item.job, item.task);
   }
   return (WorkItem){0};
 }
@@ -124,7 +195,7 @@ static WorkItem executor_work_affinity_or_steal(const JobWorkerId wId) {
    * looking for work it also needs to check the affinity-queue.
    */
   if (wId == g_affinityWorker) {
-    const WorkItem affinityItem = affqueue_pop(&g_affinityQueue);
+    const WorkItem affinityItem = executor_affinity_next();
     if (workitem_valid(affinityItem)) {
       return affinityItem;
     }
@@ -133,15 +204,18 @@ static WorkItem executor_work_affinity_or_steal(const JobWorkerId wId) {
   return executor_work_steal(wId);
 }
 
-static WorkItem executor_work_steal_loop(const JobWorkerId wId) {
+static WorkItem executor_work_steal_loop(const JobWorkerId wId, u32* spinItrs) {
   /**
    * Attempt to steal work from any other worker, try for some iterations before giving up.
+   * The iteration budget adapts to the workload: spinning that pays off (bursty workloads where new
+   * work arrives quickly) grows the budget, spinning that expires (idle periods) shrinks it so we
+   * don't burn cpu while there is nothing to do.
    */
-  static const usize g_maxIterations = 2500;
-  for (usize itr = 0; itr != g_maxIterations; ++itr) {
+  for (u32 itr = 0; itr != *spinItrs; ++itr) {
 
     WorkItem stolenItem = executor_work_affinity_or_steal(wId);
     if (workitem_valid(stolenItem)) {
+      *spinItrs = math_min(*spinItrs * 2, worker_spin_itrs_max);
       return stolenItem;
     }
 
@@ -153,6 +227,7 @@ static WorkItem executor_work_steal_loop(const JobWorkerId wId) {
     }
   }
   // No work found; time to go to sleep.
+  *spinItrs = math_max(*spinItrs / 2, worker_spin_itrs_min);
   return (WorkItem){0};
 }
 
@@ -206,7 +281,8 @@ static void executor_perform_work(const JobWorkerId wId, const WorkItem item) {
           affqueue_push(&g_affinityQueue, item.job, childTasks[i]);
           ++tasksPushedAffinity;
         } else {
-          workqueue_push(&g_workerQueues[wId], item.job, childTasks[i]);
+          workqueue_push(
+              &g_workerQueues[wId], executor_task_lane(childTaskDef), item.job, childTasks[i]);
         }
         ++tasksPushed;
       }
@@ -214,12 +290,13 @@ static void executor_perform_work(const JobWorkerId wId, const WorkItem item) {
     const bool requireAffinityWorker = tasksPushedAffinity && wId != g_affinityWorker;
     const bool needHelp              = tasksPushed > 1 || requireAffinityWorker;
     if (needHelp) {
-      if (thread_atomic_load_i32(&g_sleepingWorkers)) {
-        if (tasksPushed > 2 || requireAffinityWorker) {
-          executor_wake_worker_all();
-        } else {
-          executor_wake_worker_single();
-        }
+      if (requireAffinityWorker) {
+        // The affinity-worker specifically has to wake up; we cannot pick which worker a signal
+        // wakes so wake them all.
+        executor_wake_workers(g_jobsWorkerCount);
+      } else {
+        // Wake (at most) one worker per runnable task, this worker picks up one task itself.
+        executor_wake_workers(tasksPushed - 1);
       }
       if (tasksPushed >= g_jobsWorkerCount) {
         // Allot of work is available; wake the helpers (main-thread) if they are sleeping.
@@ -246,7 +323,12 @@ static void executor_worker_thread(void* data) {
   g_jobsWorkerId = wId;
   g_jobsIsWorker = true;
 
-  WorkItem work = (WorkItem){0};
+  // Keep workers off the efficiency cpus of hybrid machines; workers execute the latency critical
+  // work so efficiency cpus are left for the OS and background threads. No-op when not hybrid.
+  thread_pin(ThreadPin_Performance);
+
+  u32      spinItrs = worker_spin_itrs_max;
+  WorkItem work     = (WorkItem){0};
   while (LIKELY(g_mode == ExecMode_Running)) {
     // Perform work if we found some on the previous iteration.
     if (workitem_valid(work)) {
@@ -260,7 +342,7 @@ static void executor_worker_thread(void* data) {
     }
 
     // No work on our own queue; attempt to steal some.
-    work = executor_work_steal_loop(wId);
+    work = executor_work_steal_loop(wId, &spinItrs);
     if (workitem_valid(work)) {
       continue; // Perform the work on the next iteration.
     }
@@ -270,10 +352,22 @@ static void executor_worker_thread(void* data) {
     thread_atomic_add_i32(&g_sleepingWorkers, 1);
     work = executor_work_affinity_or_steal(wId); // One last attempt before sleeping.
     if (!workitem_valid(work) && LIKELY(g_mode == ExecMode_Running)) {
-      // We don't have any work to perform and we are not cancelled; sleep until woken.
-      trace_begin("job_sleep", TraceColor_Gray);
-      thread_cond_wait(g_wakeCondition, g_mutex);
-      trace_end();
+      if (executor_wake_token_take()) {
+        // A wake raced with us while parking; consume the permit and rescan instead of sleeping.
+      } else {
+        // We don't have any work to perform and we are not cancelled; sleep until woken.
+        MAYBE_UNUSED const i64 parkIndex = thread_atomic_add_i64(&g_parkCounter, 1);
+        trace_begin_msg(
+            "job_sleep",
+            TraceColor_Gray,
+            "parks: {} wakes: {}",
+            fmt_int(parkIndex + 1),
+            fmt_int(thread_atomic_load_i64(&g_wakeCounter)));
+        while (LIKELY(g_mode == ExecMode_Running) && !executor_wake_token_take()) {
+          thread_cond_wait(g_wakeCondition, g_mutex);
+        }
+        trace_end();
+      }
     }
     thread_atomic_sub_i32(&g_sleepingWorkers, 1);
     thread_mutex_unlock(g_mutex);
@@ -284,6 +378,11 @@ static u16 executor_worker_count_desired(const JobsConfig* cfg) {
   if (cfg->workerCount) {
     return cfg->workerCount;
   }
+  if (g_threadTopology.efficiencyCount) {
+    // On hybrid machines only use the performance cpus; the efficiency cpus are left for the OS
+    // and background threads (the workers are pinned to the performance cpus as well).
+    return g_threadTopology.performanceCount;
+  }
   // Amounts of cores reserved for OS and other applications on the system.
   const u16 reservedCoreCount = 1;
   return g_threadCoreCount - reservedCoreCount;
@@ -315,6 +414,7 @@ void executor_init(const JobsConfig* cfg) {
   g_jobsWorkerId = 0;
   g_jobsIsWorker = true;
   thread_prioritize(ThreadPriority_High); // NOTE: Can fail due to insufficient perms.
+  thread_pin(ThreadPin_Performance);      // No-op on machines without efficiency cpus.
 
   // Start threads for the other workers.
   for (JobWorkerId i = 1; i != g_jobsWorkerCount; ++i) {
@@ -397,11 +497,16 @@ void executor_run(Job* job) {
   // Start all normal root tasks.
   const JobWorkerId wId = g_jobsWorkerId;
   for (u32 i = 0; i != tasksNormalCount; ++i) {
-    workqueue_push(&g_workerQueues[wId], job, tasksNormal[i]);
+    const JobTask* taskDef = jobs_graph_task_def(job->graph, tasksNormal[i]);
+    workqueue_push(&g_workerQueues[wId], executor_task_lane(taskDef), job, tasksNormal[i]);
   }
 
-  if (thread_atomic_load_i32(&g_sleepingWorkers)) {
-    executor_wake_worker_all();
+  if (tasksAffinityCount) {
+    // The affinity-worker specifically has to wake up; wake all workers.
+    executor_wake_workers(g_jobsWorkerCount);
+  } else {
+    // Wake (at most) one worker per runnable root task.
+    executor_wake_workers(tasksNormalCount);
   }
 }
 
@@ -440,8 +545,52 @@ bool executor_help_job(const JobId jobId) {
 
 bool jobs_is_working(void) { return g_jobsCurrent != null; }
 
+void jobs_wait_help(const JobsWaitPredicate predicate, const void* ctx) {
+  diag_assert_msg(g_jobsIsWorker, "Only job-workers can help out");
+
+  if (predicate(ctx)) {
+    return; // Already satisfied; no need to wait.
+  }
+  trace_begin("job_wait", TraceColor_Gray);
+
+  /**
+   * Execute other queued tasks (nested on this thread) while the predicate is not satisfied; the
+   * executor save/restores the task state around nested work so the waiting task resumes cleanly.
+   * When no work is available we yield our timeslice for a while and then fall back to short
+   * sleeps; we cannot park on a condition as the predicate is satisfied by an external agent that
+   * does not signal the executor.
+   */
+  enum { MaxYields = 100 };
+  const JobWorkerId wId       = g_jobsWorkerId;
+  u32               yieldsRem = MaxYields;
+  while (!predicate(ctx)) {
+    WorkItem work = executor_work_pop(wId);
+    if (!workitem_valid(work)) {
+      work = executor_work_affinity_or_steal(wId);
+    }
+    if (workitem_valid(work)) {
+      executor_perform_work(wId, work);
+      yieldsRem = MaxYields;
+      continue;
+    }
+    if (yieldsRem--) {
+      thread_yield();
+      continue;
+    }
+    thread_sleep(time_microseconds(100));
+    yieldsRem = MaxYields;
+  }
+
+  trace_end();
+}
+
 Mem jobs_scratchpad(const JobTaskId task) {
   diag_assert_msg(g_jobsCurrent, "No active job");
   diag_assert(task < jobs_graph_task_count(g_jobsCurrent->graph));
   return array_mem(g_jobsCurrent->taskData[task].scratchpad);
 }
+
+Mem jobs_alloc(const usize size, const usize align) {
+  diag_assert_msg(g_jobsCurrent, "No active job");
+  return job_arena_alloc(g_jobsCurrent, size, align);
+}
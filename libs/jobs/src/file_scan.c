@@ -0,0 +1,134 @@
+#include "core/alloc.h"
+#include "core/dynarray.h"
+#include "core/dynstring.h"
+#include "core/path.h"
+#include "core/thread.h"
+#include "jobs/executor.h"
+#include "jobs/file_scan.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
+
+typedef struct {
+  ThreadSpinLock      queueLock;
+  DynArray            queue;       // String[] (directory paths relative to the root, heap owned).
+  i64                 pendingDirs; // Directories queued or currently being iterated.
+  i64                 firstError;  // FileIteratorResult, 'End' when no error was encountered.
+  String              rootPath;
+  JobsFileScanHandler handler;
+  void*               ctx;
+} JobsFileScan;
+
+typedef struct {
+  JobsFileScan* scan;
+} FileScanTaskData;
+
+static void file_scan_push(JobsFileScan* scan, const String dir) {
+  const String dirDup = string_dup(g_allocHeap, dir);
+  thread_atomic_add_i64(&scan->pendingDirs, 1);
+  thread_spinlock_lock(&scan->queueLock);
+  *dynarray_push_t(&scan->queue, String) = dirDup;
+  thread_spinlock_unlock(&scan->queueLock);
+}
+
+static bool file_scan_pop(JobsFileScan* scan, String* out) {
+  bool res = false;
+  thread_spinlock_lock(&scan->queueLock);
+  if (scan->queue.size) {
+    *out = *dynarray_at_t(&scan->queue, scan->queue.size - 1, String);
+    dynarray_remove(&scan->queue, scan->queue.size - 1, 1);
+    res = true;
+  }
+  thread_spinlock_unlock(&scan->queueLock);
+  return res;
+}
+
+static void file_scan_error(JobsFileScan* scan, const FileIteratorResult itrResult) {
+  i64 expected = FileIteratorResult_End; // Only the first error is reported.
+  thread_atomic_compare_exchange_i64(&scan->firstError, &expected, itrResult);
+}
+
+static void file_scan_dir(JobsFileScan* scan, const String dir) {
+  Allocator* alloc      = alloc_bump_create_stack(768);
+  DynString  pathBuffer = dynstring_create(alloc, 512);
+
+  // Open a file iterator for the absolute path starting from the root-path.
+  path_append(&pathBuffer, scan->rootPath);
+  if (!string_is_empty(dir)) {
+    path_append(&pathBuffer, dir);
+  }
+  FileIterator* itr = file_iterator_create(alloc, dynstring_view(&pathBuffer));
+
+  FileIteratorEntry  entry;
+  FileIteratorResult itrResult;
+  while ((itrResult = file_iterator_next(itr, &entry)) == FileIteratorResult_Found) {
+    // Construct a file path relative to the root-path.
+    dynstring_clear(&pathBuffer);
+    if (!string_is_empty(dir)) {
+      path_append(&pathBuffer, dir);
+    }
+    path_append(&pathBuffer, entry.name);
+    const String path = dynstring_view(&pathBuffer);
+
+    switch (entry.type) {
+    case FileType_Regular:
+      scan->handler(scan->ctx, path);
+      break;
+    case FileType_Directory:
+      file_scan_push(scan, path);
+      break;
+    case FileType_None:
+    case FileType_Unknown:
+      break;
+    }
+  }
+  file_iterator_destroy(itr);
+
+  if (UNLIKELY(itrResult != FileIteratorResult_End)) {
+    file_scan_error(scan, itrResult);
+  }
+}
+
+static void file_scan_task(const void* ctx) {
+  JobsFileScan* scan = ((const FileScanTaskData*)ctx)->scan;
+  for (;;) {
+    String dir;
+    if (file_scan_pop(scan, &dir)) {
+      file_scan_dir(scan, dir);
+      string_maybe_free(g_allocHeap, dir); // NOTE: The seeded root entry is an empty string.
+      thread_atomic_sub_i64(&scan->pendingDirs, 1);
+      continue;
+    }
+    if (!thread_atomic_load_i64(&scan->pendingDirs)) {
+      break; // The whole tree has been visited.
+    }
+    thread_yield(); // Another worker is still iterating and can discover more sub-directories.
+  }
+}
+
+FileIteratorResult jobs_file_scan(const String rootPath, JobsFileScanHandler handler, void* ctx) {
+  JobsFileScan scan = {
+      .queue       = dynarray_create_t(g_allocHeap, String, 64),
+      .pendingDirs = 1,
+      .firstError  = FileIteratorResult_End,
+      .rootPath    = rootPath,
+      .handler     = handler,
+      .ctx         = ctx,
+  };
+  *dynarray_push_t(&scan.queue, String) = string_empty; // Seed with the root directory.
+
+  const FileScanTaskData taskData = {.scan = &scan};
+  if (g_jobsWorkerCount <= 1) {
+    file_scan_task(&taskData);
+  } else {
+    JobGraph* graph = jobs_graph_create(g_allocHeap, string_lit("FileScan"), g_jobsWorkerCount);
+    for (u16 i = 0; i != g_jobsWorkerCount; ++i) {
+      jobs_graph_add_task(
+          graph, string_lit("FileScanWorker"), file_scan_task, mem_var(taskData), JobTaskFlags_None);
+    }
+    jobs_scheduler_wait_help(jobs_scheduler_run(graph, g_allocHeap));
+    jobs_graph_destroy(graph);
+  }
+
+  dynarray_destroy(&scan.queue);
+  return (FileIteratorResult)scan.firstError;
+}
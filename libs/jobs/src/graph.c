@@ -250,7 +250,10 @@ static void jobs_graph_topologically_insert(
  * Calculate the longest (aka 'critical') path through the graph.
  */
 static u64 jobs_graph_longestpath(
-    const JobGraph* graph, const JobsCostEstimator costEstimator, const void* userCtx) {
+    const JobGraph*         graph,
+    const JobsCostEstimator costEstimator,
+    const void*             userCtx,
+    const BitSet            outPathTasks) {
   /**
    * First flatten the graph into a topologically sorted set of tasks, then starting from the leaves
    * start summing all the costs.
@@ -276,7 +279,8 @@ static u64 jobs_graph_longestpath(
    * Initialize to 'sentinel_u64' when the task has a parent or its cost when its a root task.
    */
 
-  u64* costs = mem_stack(sizeof(u64) * graph->tasks.size).ptr;
+  u64*       costs = mem_stack(sizeof(u64) * graph->tasks.size).ptr;
+  JobTaskId* preds = mem_stack(sizeof(JobTaskId) * graph->tasks.size).ptr;
   for (JobTaskId taskId = 0; taskId != graph->tasks.size; ++taskId) {
     if (jobs_graph_task_has_parent(graph, taskId)) {
       costs[taskId] = sentinel_u64;
@@ -284,28 +288,45 @@ static u64 jobs_graph_longestpath(
       costs[taskId] = costEstimator(userCtx, taskId);
       diag_assert_msg(costs[taskId], "Task cost cannot be zero");
     }
+    preds[taskId] = sentinel_u16;
   }
 
-  u64 maxCost = 0;
+  u64       maxCost = 0;
+  JobTaskId maxTask = sentinel_u16;
   for (u32 i = sortedTasksCount; i-- != 0;) {
     const JobTaskId taskId      = sortedTasks[i];
     const u64       currentCost = costs[taskId];
 
     if (!sentinel_check(currentCost)) {
-      maxCost = math_max(maxCost, currentCost);
+      if (currentCost > maxCost) {
+        maxCost = currentCost;
+        maxTask = taskId;
+      }
       jobs_graph_for_task_child(graph, taskId, child) {
         const u64 childSelfCost = costEstimator(userCtx, child.task);
         diag_assert_msg(childSelfCost, "Task cost cannot be zero");
 
         u64* childCost = &costs[child.task];
         if (sentinel_check(*childCost) || *childCost < (currentCost + childSelfCost)) {
-          *childCost = currentCost + childSelfCost;
+          *childCost        = currentCost + childSelfCost;
+          preds[child.task] = taskId;
+        }
+        if (*childCost > maxCost) {
+          maxCost = *childCost;
+          maxTask = child.task;
         }
-        maxCost = math_max(maxCost, *childCost);
       }
     }
   }
 
+  // Optionally walk the predecessors back from the most expensive task to mark the longest path.
+  if (outPathTasks.size) {
+    mem_set(outPathTasks, 0);
+    for (JobTaskId taskId = maxTask; !sentinel_check(taskId); taskId = preds[taskId]) {
+      jobs_bit_set(outPathTasks, taskId);
+    }
+  }
+
   return maxCost;
 }
 
@@ -391,6 +412,29 @@ JobTaskId jobs_graph_add_task(
   return id;
 }
 
+bool jobs_graph_task_rebind(
+    JobGraph*            graph,
+    const JobTaskId      id,
+    const String         name,
+    const JobTaskRoutine routine,
+    const Mem            ctx,
+    const JobTaskFlags   flags) {
+  if (UNLIKELY(id >= graph->tasks.size)) {
+    return false; // Task does not exist.
+  }
+  JobTask* task = (JobTask*)bits_ptr_offset(graph->tasks.data.ptr, 64 * id);
+  if (task->flags != flags || !string_eq(task->name, name)) {
+    return false; // Task does not match; graph shape has changed and needs to be rebuilt.
+  }
+  task->routine = routine;
+  if (flags & JobTaskFlags_BorrowName) {
+    task->name = name; // Borrowed names can be refreshed; the caller owns the memory.
+  }
+  const Mem taskStorageCtx = mem_create(bits_ptr_offset(task, sizeof(JobTask)), ctx.size);
+  mem_cpy(taskStorageCtx, ctx);
+  return true;
+}
+
 void jobs_graph_task_depend(JobGraph* graph, const JobTaskId parent, const JobTaskId child) {
   diag_assert(parent != child);
   diag_assert(parent < graph->tasks.size);
@@ -498,10 +542,18 @@ JobTaskChildItr jobs_graph_task_child_next(const JobGraph* graph, const JobTaskC
 }
 
 u64 jobs_graph_task_span(const JobGraph* graph) {
-  return jobs_graph_longestpath(graph, jobs_task_cost_estimator_one, null);
+  return jobs_graph_longestpath(graph, jobs_task_cost_estimator_one, null, mem_empty);
 }
 
 u64 jobs_graph_task_span_cost(
     const JobGraph* graph, const JobsCostEstimator estimator, const void* userCtx) {
-  return jobs_graph_longestpath(graph, estimator, userCtx);
+  return jobs_graph_longestpath(graph, estimator, userCtx, mem_empty);
+}
+
+u64 jobs_graph_task_span_path(
+    const JobGraph*         graph,
+    const JobsCostEstimator estimator,
+    const void*             userCtx,
+    const BitSet            outTasks) {
+  return jobs_graph_longestpath(graph, estimator, userCtx, outTasks);
 }
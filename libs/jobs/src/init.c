@@ -1,4 +1,5 @@
 #include "core/diag.h"
+#include "core/init.h"
 #include "core/thread.h"
 #include "jobs/init.h"
 
@@ -12,8 +13,10 @@ void jobs_init(const JobsConfig* cfg) {
   if (!g_initalized) {
     g_initalized = true;
 
+    core_init_phase_begin(string_lit("jobs"));
     scheduler_init();
     executor_init(cfg);
+    core_init_phase_end();
   }
 }
 
@@ -1,10 +1,16 @@
 #include "core/alloc.h"
+#include "core/bits.h"
+#include "core/thread.h"
 #include "jobs/graph.h"
 
 #include "job.h"
 
 usize job_mem_req_size(const JobGraph* graph) {
-  return sizeof(Job) + sizeof(JobTaskData) * jobs_graph_task_count(graph);
+  return job_mem_req_size_tasks(jobs_graph_task_count(graph));
+}
+
+usize job_mem_req_size_tasks(const u32 taskCount) {
+  return sizeof(Job) + sizeof(JobTaskData) * taskCount + job_arena_size;
 }
 
 usize job_mem_req_align(const JobGraph* graph) {
@@ -22,6 +28,7 @@ Job* job_create(Allocator* alloc, const JobId id, const JobGraph* graph) {
   data->graph        = graph;
   data->jobAlloc     = alloc;
   data->dependencies = (i64)jobs_graph_task_leaf_count(graph);
+  data->arenaOffset  = 0;
 
   // Initialize per-task data.
   jobs_graph_for_task(graph, taskId) {
@@ -34,3 +41,23 @@ Job* job_create(Allocator* alloc, const JobId id, const JobGraph* graph) {
 void job_destroy(Job* job) {
   alloc_free(job->jobAlloc, mem_create(job, job_mem_req_size(job->graph)));
 }
+
+static u8* job_arena_begin(Job* job) {
+  return (u8*)job + sizeof(Job) + sizeof(JobTaskData) * jobs_graph_task_count(job->graph);
+}
+
+Mem job_arena_alloc(Job* job, const usize size, const usize align) {
+  u8* arenaBegin = job_arena_begin(job);
+  i64 offset     = thread_atomic_load_i64(&job->arenaOffset);
+  for (;;) {
+    const i64 alignedOffset = (i64)bits_align((u64)offset, align);
+    const i64 newOffset     = alignedOffset + (i64)size;
+    if (UNLIKELY(newOffset > (i64)job_arena_size)) {
+      return mem_create(null, size); // Arena exhausted.
+    }
+    if (thread_atomic_compare_exchange_i64(&job->arenaOffset, &offset, newOffset)) {
+      return mem_create(arenaBegin + alignedOffset, size);
+    }
+    // Lost the race against another worker; retry with the updated offset.
+  }
+}
@@ -5,6 +5,9 @@
 // Padded to 64 bytes to avoid false-sharing of cachelines.
 #define job_align 64
 
+// Size of the per-job arena for temporary task allocations.
+#define job_arena_size (16 * usize_kibibyte)
+
 typedef u64 JobId;
 
 /**
@@ -25,13 +28,21 @@ typedef struct {
   const JobGraph* graph;
   Allocator*      jobAlloc;
   i64             dependencies; // Remaining dependencies (leaf tasks).
-  JobTaskData     taskData[];   // Allocated after this struct.
+  i64             arenaOffset;  // Bump offset into the job arena, updated atomically.
+  JobTaskData     taskData[];   // Allocated after this struct (arena memory follows the taskData).
 } Job;
 
 ASSERT(sizeof(Job) == job_align, "Invalid Job size");
 
 usize job_mem_req_size(const JobGraph*);
+usize job_mem_req_size_tasks(u32 taskCount);
 usize job_mem_req_align(const JobGraph*);
 
 Job* job_create(Allocator*, const JobId id, const JobGraph*);
 void job_destroy(Job*);
+
+/**
+ * Allocate temporary memory from the job arena; automatically recycled when the job completes.
+ * NOTE: Lock-free, safe to call from any task of the job on any worker.
+ */
+Mem job_arena_alloc(Job*, usize size, usize align);
@@ -10,12 +10,31 @@
 #include "init.h"
 #include "job.h"
 
+#define jobs_continuation_max_ctx 48
+
 typedef Job* JobPtr;
 
+typedef struct {
+  JobId            job;
+  JobsContinuation routine;
+  u8               ctx[jobs_continuation_max_ctx];
+} JobContinuation;
+
+/**
+ * Shared state for a continuation that waits on multiple jobs; heap allocated and freed when the
+ * last job completes.
+ */
+typedef struct {
+  i64              remaining;
+  JobsContinuation routine;
+  u8               ctx[jobs_continuation_max_ctx];
+} JobContinuationMany;
+
 static i64             g_jobIdCounter;
 static ThreadMutex     g_jobMutex;
 static ThreadCondition g_jobCondition;
-static DynArray        g_runningJobs; // Job*[]. Only access while holding 'g_jobMutex'.
+static DynArray        g_runningJobs;   // Job*[]. Only access while holding 'g_jobMutex'.
+static DynArray        g_continuations; // JobContinuation[]. Only access while holding 'g_jobMutex'.
 static i32             g_sleepingHelpers;
 
 static bool jobs_scheduler_is_finished_locked(const JobId job) {
@@ -28,16 +47,18 @@ static bool jobs_scheduler_is_finished_locked(const JobId job) {
 }
 
 void scheduler_init(void) {
-  g_jobIdCounter = 0;
-  g_jobMutex     = thread_mutex_create(g_allocHeap);
-  g_jobCondition = thread_cond_create(g_allocHeap);
-  g_runningJobs  = dynarray_create_t(g_allocHeap, Job*, 32);
+  g_jobIdCounter  = 0;
+  g_jobMutex      = thread_mutex_create(g_allocHeap);
+  g_jobCondition  = thread_cond_create(g_allocHeap);
+  g_runningJobs   = dynarray_create_t(g_allocHeap, Job*, 32);
+  g_continuations = dynarray_create_t(g_allocHeap, JobContinuation, 8);
 }
 
 void scheduler_teardown(void) {
   thread_mutex_destroy(g_jobMutex);
   thread_cond_destroy(g_jobCondition);
   dynarray_destroy(&g_runningJobs);
+  dynarray_destroy(&g_continuations);
 }
 
 JobId jobs_scheduler_run(JobGraph* graph, Allocator* alloc) {
@@ -65,6 +86,60 @@ JobId jobs_scheduler_run(JobGraph* graph, Allocator* alloc) {
   return id;
 }
 
+void jobs_scheduler_continue(const JobId job, const JobsContinuation routine, const Mem ctx) {
+  diag_assert_msg(
+      ctx.size <= jobs_continuation_max_ctx,
+      "Continuation context size {} exceeds the maximum of {}",
+      fmt_size(ctx.size),
+      fmt_int(jobs_continuation_max_ctx));
+
+  thread_mutex_lock(g_jobMutex);
+  const bool finished = jobs_scheduler_is_finished_locked(job);
+  if (!finished) {
+    JobContinuation* cont = dynarray_push_t(&g_continuations, JobContinuation);
+    cont->job             = job;
+    cont->routine         = routine;
+    mem_cpy(mem_create(cont->ctx, jobs_continuation_max_ctx), ctx);
+  }
+  thread_mutex_unlock(g_jobMutex);
+
+  if (finished) {
+    routine(ctx.ptr); // Job already finished; invoke the continuation immediately.
+  }
+}
+
+static void jobs_continuation_many_routine(const void* ctx) {
+  JobContinuationMany* data = *(JobContinuationMany* const*)ctx;
+  if (thread_atomic_sub_i64(&data->remaining, 1) == 1) {
+    // Last job completed; invoke the user continuation.
+    data->routine(data->ctx);
+    alloc_free_t(g_allocHeap, data);
+  }
+}
+
+void jobs_scheduler_continue_many(
+    const JobId* jobs, const u32 jobCount, const JobsContinuation routine, const Mem ctx) {
+  diag_assert_msg(
+      ctx.size <= jobs_continuation_max_ctx,
+      "Continuation context size {} exceeds the maximum of {}",
+      fmt_size(ctx.size),
+      fmt_int(jobs_continuation_max_ctx));
+
+  if (UNLIKELY(!jobCount)) {
+    routine(ctx.ptr); // Empty set; invoke the continuation immediately.
+    return;
+  }
+
+  JobContinuationMany* data = alloc_alloc_t(g_allocHeap, JobContinuationMany);
+  data->remaining           = jobCount;
+  data->routine             = routine;
+  mem_cpy(mem_create(data->ctx, jobs_continuation_max_ctx), ctx);
+
+  for (u32 i = 0; i != jobCount; ++i) {
+    jobs_scheduler_continue(jobs[i], jobs_continuation_many_routine, mem_var(data));
+  }
+}
+
 bool jobs_scheduler_is_finished(const JobId job) {
   bool finished = true;
   thread_mutex_lock(g_jobMutex);
@@ -168,6 +243,8 @@ void jobs_scheduler_wake_helpers(void) {
  * Internal api to notify the scheduler that a job has finished.
  */
 void jobs_scheduler_finish(Job* job) {
+  const JobId id = job->id;
+
   thread_mutex_lock(g_jobMutex);
   {
     // Cleanup job data.
@@ -184,7 +261,34 @@ void jobs_scheduler_finish(Job* job) {
   }
   thread_mutex_unlock(g_jobMutex);
   thread_cond_broadcast(g_jobCondition);
+
+  /**
+   * Invoke any continuations registered for this job.
+   * NOTE: Extracted (and invoked) one at a time as the continuation itself is free to call back
+   * into the scheduler (for example to start new jobs or register more continuations).
+   */
+  for (;;) {
+    JobContinuation cont;
+    bool            found = false;
+    thread_mutex_lock(g_jobMutex);
+    for (usize i = 0; i != g_continuations.size; ++i) {
+      JobContinuation* itr = dynarray_at_t(&g_continuations, i, JobContinuation);
+      if (itr->job == id) {
+        cont  = *itr;
+        found = true;
+        dynarray_remove(&g_continuations, i, 1);
+        break;
+      }
+    }
+    thread_mutex_unlock(g_jobMutex);
+    if (!found) {
+      break;
+    }
+    cont.routine(cont.ctx);
+  }
 }
 
 usize jobs_scheduler_mem_size(const JobGraph* graph) { return job_mem_req_size(graph); }
+
+usize jobs_scheduler_mem_size_max(const u32 taskCount) { return job_mem_req_size_tasks(taskCount); }
 usize jobs_scheduler_mem_align(const JobGraph* graph) { return job_mem_req_align(graph); }
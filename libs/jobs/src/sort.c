@@ -0,0 +1,157 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "jobs/executor.h"
+#include "jobs/graph.h"
+#include "jobs/scheduler.h"
+#include "jobs/sort.h"
+
+/**
+ * Below this element count the scheduling overhead outweighs the parallelism gain and a plain
+ * single-threaded quicksort is used instead.
+ */
+#define jobs_sort_parallel_elems_min 4096
+
+/**
+ * Minimum number of elements per sorted section.
+ */
+#define jobs_sort_section_elems_min 1024
+
+/**
+ * Maximum number of sections the input is split into (needs to be a power of two).
+ */
+#define jobs_sort_sections_max 64
+
+typedef struct {
+  u8*         begin;
+  u8*         end;
+  u16         stride;
+  CompareFunc compare;
+} SortSectionData;
+
+typedef struct {
+  const u8*   aBegin; // Start of the first (sorted) input run.
+  const u8*   aEnd;   // End of the first input run, start of the second.
+  const u8*   bEnd;   // End of the second (sorted) input run.
+  u8*         dst;
+  u16         stride;
+  CompareFunc compare;
+} SortMergeData;
+
+static void sort_task_section(const void* ctx) {
+  const SortSectionData* data = ctx;
+  sort_quicksort(data->begin, data->end, data->stride, data->compare);
+}
+
+static void sort_task_merge(const void* ctx) {
+  const SortMergeData* data   = *(const SortMergeData* const*)ctx;
+  const u16            stride = data->stride;
+  const u8*            a      = data->aBegin;
+  const u8*            b      = data->aEnd;
+  u8*                  dst    = data->dst;
+
+  while (a != data->aEnd && b != data->bEnd) {
+    if (data->compare(b, a) < 0) {
+      mem_cpy(mem_create(dst, stride), mem_create(b, stride));
+      b += stride;
+    } else {
+      mem_cpy(mem_create(dst, stride), mem_create(a, stride));
+      a += stride;
+    }
+    dst += stride;
+  }
+  if (a != data->aEnd) {
+    mem_cpy(mem_create(dst, (usize)(data->aEnd - a)), mem_create(a, (usize)(data->aEnd - a)));
+  }
+  if (b != data->bEnd) {
+    mem_cpy(mem_create(dst, (usize)(data->bEnd - b)), mem_create(b, (usize)(data->bEnd - b)));
+  }
+}
+
+void jobs_sort(u8* begin, u8* end, const u16 stride, CompareFunc compare) {
+  diag_assert(stride <= 128);
+
+  const usize count = (usize)(end - begin) / stride;
+  if (count < jobs_sort_parallel_elems_min || g_jobsWorkerCount <= 1) {
+    sort_quicksort(begin, end, stride, compare);
+    return;
+  }
+
+  // Pick a power-of-two section count based on the worker count.
+  u32 sections = 1;
+  while (sections < g_jobsWorkerCount && sections != jobs_sort_sections_max) {
+    sections *= 2;
+  }
+  while (sections > 1 && count / sections < jobs_sort_section_elems_min) {
+    sections /= 2;
+  }
+  if (sections == 1) {
+    sort_quicksort(begin, end, stride, compare);
+    return;
+  }
+
+  const usize sectionElems = count / sections;
+  const Mem   tmpMem       = alloc_alloc(g_allocHeap, count * stride, 16);
+  JobGraph*   graph        = jobs_graph_create(g_allocHeap, string_lit("Sort"), sections * 2);
+
+  // Boundary of section 'i' in elements; the last section absorbs the division remainder.
+  usize bounds[jobs_sort_sections_max + 1];
+  for (u32 i = 0; i != sections; ++i) {
+    bounds[i] = i * sectionElems;
+  }
+  bounds[sections] = count;
+
+  // Sort each section in parallel (in-place in the caller's buffer).
+  JobTaskId taskIds[jobs_sort_sections_max];
+  for (u32 i = 0; i != sections; ++i) {
+    taskIds[i] = jobs_graph_add_task(
+        graph,
+        string_lit("SortSection"),
+        sort_task_section,
+        mem_struct(
+            SortSectionData,
+            .begin   = begin + bounds[i] * stride,
+            .end     = begin + bounds[i + 1] * stride,
+            .stride  = stride,
+            .compare = compare),
+        JobTaskFlags_None);
+  }
+
+  // Merge pairs of sorted runs in rounds, ping-ponging between the caller's buffer and the
+  // temporary buffer.
+  // NOTE: Merge data lives on our stack until the wait below; the task context (limited to the
+  // space in the task slot) only receives a pointer.
+  SortMergeData mergeData[jobs_sort_sections_max];
+  u32           mergeCount = 0;
+
+  u8* src = begin;
+  u8* dst = tmpMem.ptr;
+  for (u32 width = 1; width != sections; width *= 2) {
+    for (u32 i = 0; i != sections; i += width * 2) {
+      mergeData[mergeCount] = (SortMergeData){
+          .aBegin  = src + bounds[i] * stride,
+          .aEnd    = src + bounds[i + width] * stride,
+          .bEnd    = src + bounds[i + width * 2] * stride,
+          .dst     = dst + bounds[i] * stride,
+          .stride  = stride,
+          .compare = compare,
+      };
+      const SortMergeData* mergePtr  = &mergeData[mergeCount++];
+      const JobTaskId      mergeTask = jobs_graph_add_task(
+          graph, string_lit("SortMerge"), sort_task_merge, mem_var(mergePtr), JobTaskFlags_None);
+      jobs_graph_task_depend(graph, taskIds[i], mergeTask);
+      jobs_graph_task_depend(graph, taskIds[i + width], mergeTask);
+      taskIds[i] = mergeTask;
+    }
+    u8* swapTmp = src;
+    src         = dst;
+    dst         = swapTmp;
+  }
+
+  jobs_scheduler_wait_help(jobs_scheduler_run(graph, g_allocHeap));
+
+  if (src != begin) {
+    mem_cpy(mem_create(begin, count * stride), mem_create(src, count * stride));
+  }
+  alloc_free(g_allocHeap, tmpMem);
+  jobs_graph_destroy(graph);
+}
@@ -9,78 +9,108 @@
 ASSERT(!(workqueue_max_items & (workqueue_max_items - 1u)), "Max size has to be a power-of-two");
 
 /**
- * Amount of items in the queue, only an indication as it can be raced by the mutating apis.
+ * Amount of items in the lane, only an indication as it can be raced by the mutating apis.
  */
-MAYBE_UNUSED INLINE_HINT static usize workqueue_size(const WorkQueue* wq) {
-  const i64 bottom = wq->bottom;
-  const i64 top    = wq->top;
+MAYBE_UNUSED INLINE_HINT static usize worklane_size(const WorkLane* lane) {
+  const i64 bottom = lane->bottom;
+  const i64 top    = lane->top;
   return (usize)(bottom >= top ? bottom - top : 0);
 }
 
-WorkQueue workqueue_create(Allocator* alloc) {
-  return (WorkQueue){
-      .bottom = 0,
-      .top    = 0,
-      .items  = alloc_array_t(alloc, WorkItem, workqueue_max_items),
-  };
-}
-
-void workqueue_destroy(Allocator* alloc, WorkQueue* wq) {
-  alloc_free_array_t(alloc, wq->items, workqueue_max_items);
-}
-
-void workqueue_push(WorkQueue* wq, Job* job, const JobTaskId task) {
+static void worklane_push(WorkLane* lane, Job* job, const JobTaskId task) {
   diag_assert_msg(
-      workqueue_size(wq) < workqueue_max_items,
+      worklane_size(lane) < workqueue_max_items,
       "Maximum number of work-queue items ({}) has been exceeded",
       fmt_int(workqueue_max_items));
 
-  const i64 idx             = wq->bottom; // No atomic load as its only written to from this thread.
-  wq->items[item_wrap(idx)] = (WorkItem){
+  const i64 idx = lane->bottom; // No atomic load as its only written to from this thread.
+  lane->items[item_wrap(idx)] = (WorkItem){
       .job  = job,
       .task = task,
   };
-  thread_atomic_store_i64(&wq->bottom, idx + 1);
+  thread_atomic_store_i64(&lane->bottom, idx + 1);
 }
 
-WorkItem workqueue_pop(WorkQueue* wq) {
-  const i64 idx = wq->bottom - 1; // No atomic load as its only written to from this thread.
-  thread_atomic_store_i64(&wq->bottom, idx);
+static WorkItem worklane_pop(WorkLane* lane) {
+  const i64 idx = lane->bottom - 1; // No atomic load as its only written to from this thread.
+  thread_atomic_store_i64(&lane->bottom, idx);
 
-  i64 topIdx = wq->top;
+  i64 topIdx = lane->top;
   if (topIdx > idx) {
-    wq->bottom = idx + 1;
-    return (WorkItem){0}; // Queue was already empty.
+    lane->bottom = idx + 1;
+    return (WorkItem){0}; // Lane was already empty.
   }
 
-  WorkItem item = wq->items[item_wrap(idx)];
+  WorkItem item = lane->items[item_wrap(idx)];
   if (idx != topIdx) {
     return item; // More then one item left; we can just return the item.
   }
 
   // Last item; attempt to claim it.
-  if (!thread_atomic_compare_exchange_i64(&wq->top, &topIdx, topIdx + 1)) {
+  if (!thread_atomic_compare_exchange_i64(&lane->top, &topIdx, topIdx + 1)) {
     item = (WorkItem){0}; // Another thread stole it.
   }
 
-  wq->bottom = idx + 1;
+  lane->bottom = idx + 1;
   return item;
 }
 
-WorkItem workqueue_steal(WorkQueue* wq) {
-  i64       idx       = thread_atomic_load_i64(&wq->top);
-  const i64 bottomIdx = thread_atomic_load_i64(&wq->bottom);
+static WorkItem worklane_steal(WorkLane* lane) {
+  i64       idx       = thread_atomic_load_i64(&lane->top);
+  const i64 bottomIdx = thread_atomic_load_i64(&lane->bottom);
 
   if (idx >= bottomIdx) {
-    return (WorkItem){0}; // Queue was already empty.
+    return (WorkItem){0}; // Lane was already empty.
   }
 
-  WorkItem item = wq->items[item_wrap(idx)];
+  WorkItem item = lane->items[item_wrap(idx)];
 
   // Attempt to claim the item.
-  if (!thread_atomic_compare_exchange_i64(&wq->top, &idx, idx + 1)) {
+  if (!thread_atomic_compare_exchange_i64(&lane->top, &idx, idx + 1)) {
     return (WorkItem){0}; // A pop or another steal got it before us.
   }
 
   return item;
 }
+
+WorkQueue workqueue_create(Allocator* alloc) {
+  WorkQueue wq;
+  for (u32 lane = 0; lane != WorkQueueLane_Count; ++lane) {
+    wq.lanes[lane] = (WorkLane){
+        .bottom = 0,
+        .top    = 0,
+        .items  = alloc_array_t(alloc, WorkItem, workqueue_max_items),
+    };
+  }
+  return wq;
+}
+
+void workqueue_destroy(Allocator* alloc, WorkQueue* wq) {
+  for (u32 lane = 0; lane != WorkQueueLane_Count; ++lane) {
+    alloc_free_array_t(alloc, wq->lanes[lane].items, workqueue_max_items);
+  }
+}
+
+void workqueue_push(WorkQueue* wq, const WorkQueueLane lane, Job* job, const JobTaskId task) {
+  worklane_push(&wq->lanes[lane], job, task);
+}
+
+WorkItem workqueue_pop(WorkQueue* wq) {
+  for (u32 lane = 0; lane != WorkQueueLane_Count; ++lane) {
+    const WorkItem item = worklane_pop(&wq->lanes[lane]);
+    if (workitem_valid(item)) {
+      return item;
+    }
+  }
+  return (WorkItem){0};
+}
+
+WorkItem workqueue_steal(WorkQueue* wq) {
+  for (u32 lane = 0; lane != WorkQueueLane_Count; ++lane) {
+    const WorkItem item = worklane_steal(&wq->lanes[lane]);
+    if (workitem_valid(item)) {
+      return item;
+    }
+  }
+  return (WorkItem){0};
+}
@@ -9,6 +9,9 @@
  * The owner thread can push and pop from the LIFO end of the queue while other threads can steal
  * from the FIFO end.
  *
+ * Consists of two lanes: a high-priority lane for latency-critical work (for example audio-buffer
+ * filling) that is always drained first, and a normal lane for everything else.
+ *
  * References:
  * - https://fzn.fr/readings/ppopp13.pdf
  * - https://github.com/taskflow/work-stealing-queue
@@ -16,28 +19,39 @@
 
 #define workqueue_max_items 2048
 
+typedef enum {
+  WorkQueueLane_High,   // Latency-critical work; always drained before the normal lane.
+  WorkQueueLane_Normal, // Regular work.
+
+  WorkQueueLane_Count,
+} WorkQueueLane;
+
 typedef struct {
   i64       top, bottom;
   WorkItem* items;
+} WorkLane;
+
+typedef struct {
+  WorkLane lanes[WorkQueueLane_Count];
 } WorkQueue;
 
 WorkQueue workqueue_create(Allocator*);
 void      workqueue_destroy(Allocator*, WorkQueue*);
 
 /**
- * Push a new item to the queue.
+ * Push a new item to the given lane of the queue.
  * NOTE: Can only be called by the owning thread.
  */
-void workqueue_push(WorkQueue*, Job*, JobTaskId);
+void workqueue_push(WorkQueue*, WorkQueueLane, Job*, JobTaskId);
 
 /**
- * Pop an item from the queue in a LIFO manner.
+ * Pop an item from the queue in a LIFO manner, draining the high-priority lane first.
  * NOTE: Can only be called by the owning thread.
  */
 WorkItem workqueue_pop(WorkQueue*);
 
 /**
- * Pop an item from the queue in a FIFO manner.
+ * Pop an item from the queue in a FIFO manner, draining the high-priority lane first.
  * NOTE: Can be called by any thread.
  */
 WorkItem workqueue_steal(WorkQueue*);
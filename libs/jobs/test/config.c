@@ -1,10 +1,13 @@
 #include "app/check.h"
 
 void app_check_init(CheckDef* check) {
+  register_spec(check, compress);
   register_spec(check, dot);
   register_spec(check, executor);
+  register_spec(check, file_scan);
   register_spec(check, graph);
   register_spec(check, scheduler);
+  register_spec(check, sort);
 }
 
 void app_check_teardown(void) {}
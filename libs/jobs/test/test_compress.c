@@ -0,0 +1,67 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/dynstring.h"
+#include "core/gzip.h"
+#include "core/rng.h"
+#include "core/zlib.h"
+#include "jobs/compress.h"
+
+/**
+ * Input size that spans multiple compression chunks, to exercise the parallel stitching.
+ */
+#define test_compress_input_size (640 * usize_kibibyte)
+
+static void test_compress_fill_input(DynString* str) {
+  Rng* rng = rng_create_xorwow(g_allocHeap, 42);
+  for (usize i = 0; i != test_compress_input_size; ++i) {
+    // Mix compressible and incompressible data.
+    const u8 val = (i / usize_kibibyte) % 2 ? (u8)rng_sample_u32(rng) : (u8)'a';
+    dynstring_append_char(str, val);
+  }
+  rng_destroy(rng);
+}
+
+spec(compress) {
+
+  it("can round-trip a multi-chunk gzip stream") {
+    DynString inputBuffer = dynstring_create(g_allocHeap, test_compress_input_size);
+    test_compress_fill_input(&inputBuffer);
+
+    DynString encodedBuffer = dynstring_create(g_allocHeap, test_compress_input_size);
+    jobs_compress_gzip(dynstring_view(&inputBuffer), &encodedBuffer);
+
+    DynString decodedBuffer = dynstring_create(g_allocHeap, test_compress_input_size);
+
+    GzipError    err;
+    const String remaining = gzip_decode(dynstring_view(&encodedBuffer), null, &decodedBuffer, &err);
+
+    check_eq_int(err, GzipError_None);
+    check_eq_int(remaining.size, 0);
+    check(mem_eq(dynstring_view(&decodedBuffer), dynstring_view(&inputBuffer)));
+
+    dynstring_destroy(&decodedBuffer);
+    dynstring_destroy(&encodedBuffer);
+    dynstring_destroy(&inputBuffer);
+  }
+
+  it("can round-trip a multi-chunk zlib stream") {
+    DynString inputBuffer = dynstring_create(g_allocHeap, test_compress_input_size);
+    test_compress_fill_input(&inputBuffer);
+
+    DynString encodedBuffer = dynstring_create(g_allocHeap, test_compress_input_size);
+    jobs_compress_zlib(dynstring_view(&inputBuffer), &encodedBuffer);
+
+    DynString decodedBuffer = dynstring_create(g_allocHeap, test_compress_input_size);
+
+    ZlibError    err;
+    const String remaining = zlib_decode(dynstring_view(&encodedBuffer), &decodedBuffer, &err);
+
+    check_eq_int(err, ZlibError_None);
+    check_eq_int(remaining.size, 0);
+    check(mem_eq(dynstring_view(&decodedBuffer), dynstring_view(&inputBuffer)));
+
+    dynstring_destroy(&decodedBuffer);
+    dynstring_destroy(&encodedBuffer);
+    dynstring_destroy(&inputBuffer);
+  }
+}
@@ -4,6 +4,7 @@
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/thread.h"
+#include "jobs/executor.h"
 #include "jobs/graph.h"
 #include "jobs/scheduler.h"
 
@@ -47,6 +48,32 @@ static void test_task_sum(const void* ctx) {
   data->values[data->idxA] += data->values[data->idxB];
 }
 
+static void test_task_job_alloc(const void* ctx) {
+  const TestExecutorCounterData* data = ctx;
+
+  const Mem mem = jobs_alloc(64, 16);
+  diag_assert_msg(mem_valid(mem), "Job arena allocation failed");
+  mem_set(mem, 0xFF); // Verify the memory is writable.
+
+  thread_atomic_add_i64(data->counter, 1);
+}
+
+typedef struct {
+  i64* counter;
+  i64  target;
+} TestExecutorWaitData;
+
+static bool test_wait_counter_reached(const void* ctx) {
+  const TestExecutorWaitData* data = ctx;
+  return thread_atomic_load_i64(data->counter) >= data->target;
+}
+
+static void test_task_wait_for_counter(const void* ctx) {
+  const TestExecutorWaitData* data = ctx;
+  jobs_wait_help(test_wait_counter_reached, data);
+  thread_atomic_add_i64(data->counter, 1);
+}
+
 static void test_task_require_affinity(const void* ctx) {
   /**
    * HACK: This test modifies the context data in the graph, this works in practice but violates the
@@ -125,6 +152,28 @@ spec(executor) {
     jobs_graph_destroy(jobGraph);
   }
 
+  it("can execute a mix of normal and high-priority tasks") {
+    static const usize g_numTasks = 1000;
+
+    JobGraph* jobGraph = jobs_graph_create(g_allocHeap, string_lit("TestJob"), 1);
+
+    i64 counter = 0;
+    for (usize i = 0; i != g_numTasks; ++i) {
+      const JobTaskFlags flags = i % 4 ? task_flags : JobTaskFlags_HighPriority;
+      jobs_graph_add_task(
+          jobGraph,
+          string_lit("Increment"),
+          test_task_increment_counter_atomic,
+          mem_struct(TestExecutorCounterData, .counter = &counter),
+          flags);
+    }
+
+    jobs_scheduler_wait_help(jobs_scheduler_run(jobGraph, g_allocPage));
+    check_eq_int((usize)counter, g_numTasks);
+
+    jobs_graph_destroy(jobGraph);
+  }
+
   it("can execute a set of parallel tasks") {
     static const usize g_numTasks = 1000;
 
@@ -149,6 +198,31 @@ spec(executor) {
     jobs_graph_destroy(jobGraph);
   }
 
+  it("can allocate job-scoped memory from parallel tasks") {
+    static const usize g_numTasks = 64;
+
+    JobGraph* jobGraph = jobs_graph_create(g_allocHeap, string_lit("TestJob"), 1);
+
+    i64 counter = 0;
+    for (usize i = 0; i != g_numTasks; ++i) {
+      jobs_graph_add_task(
+          jobGraph,
+          string_lit("JobAlloc"),
+          test_task_job_alloc,
+          mem_struct(TestExecutorCounterData, .counter = &counter),
+          task_flags);
+    }
+
+    jobs_scheduler_wait_help(jobs_scheduler_run(jobGraph, g_allocPage));
+    check_eq_int((usize)counter, g_numTasks);
+
+    // The arena is recycled between runs, so a second run succeeds as well.
+    jobs_scheduler_wait_help(jobs_scheduler_run(jobGraph, g_allocPage));
+    check_eq_int((usize)counter, g_numTasks * 2);
+
+    jobs_graph_destroy(jobGraph);
+  }
+
   it("can compute a parallel sum of integers") {
     i64   data[1024 * 2];
     usize dataCount = array_elems(data);
@@ -217,6 +291,36 @@ spec(executor) {
     jobs_graph_destroy(graph);
   }
 
+  it("can wait inside a task while helping with other tasks") {
+    static const usize g_numTasks = 100;
+
+    JobGraph* jobGraph = jobs_graph_create(g_allocHeap, string_lit("TestJob"), 1);
+
+    // The waiter blocks until all increment tasks have run; because the wait helps with queued
+    // tasks this finishes even on a single worker.
+    i64 counter = 0;
+    jobs_graph_add_task(
+        jobGraph,
+        string_lit("Wait"),
+        test_task_wait_for_counter,
+        mem_struct(TestExecutorWaitData, .counter = &counter, .target = (i64)g_numTasks),
+        task_flags);
+
+    for (usize i = 0; i != g_numTasks; ++i) {
+      jobs_graph_add_task(
+          jobGraph,
+          string_lit("Increment"),
+          test_task_increment_counter_atomic,
+          mem_struct(TestExecutorCounterData, .counter = &counter),
+          task_flags);
+    }
+
+    jobs_scheduler_wait_help(jobs_scheduler_run(jobGraph, g_allocPage));
+    check_eq_int((usize)counter, g_numTasks + 1);
+
+    jobs_graph_destroy(jobGraph);
+  }
+
   it("executes a parallel set affinity tasks always on the same thread") {
     static const usize g_numTasks = 100;
 
@@ -0,0 +1,84 @@
+#include "check/spec.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/file.h"
+#include "core/path.h"
+#include "core/rng.h"
+#include "core/thread.h"
+#include "jobs/file_scan.h"
+
+typedef struct {
+  i64 fileCount;
+  i64 totalPathSize;
+} TestFileScanData;
+
+static void test_file_scan_handler(void* ctx, const String path) {
+  TestFileScanData* data = ctx;
+  thread_atomic_add_i64(&data->fileCount, 1);
+  thread_atomic_add_i64(&data->totalPathSize, (i64)path.size);
+}
+
+spec(file_scan) {
+
+  String dirPath;
+
+  setup() {
+    const String dirName = path_name_random_scratch(g_rng, string_lit("volo"), string_empty);
+    dirPath              = path_build_scratch(g_pathTempDir, dirName);
+
+    const FileResult res = file_create_dir_sync(dirPath);
+    if (res != FileResult_Success) {
+      diag_crash_msg(
+          "file_scan: Failed to setup test directory ({})", fmt_text(file_result_str(res)));
+    }
+  }
+
+  it("finds zero files in an empty directory") {
+    TestFileScanData data = {0};
+    check_eq_int(jobs_file_scan(dirPath, test_file_scan_handler, &data), FileIteratorResult_End);
+    check_eq_int(data.fileCount, 0);
+  }
+
+  it("finds all files in a directory tree") {
+    static const String g_filePaths[] = {
+        string_static("a.txt"),
+        string_static("sub1/b.txt"),
+        string_static("sub1/deep/c.txt"),
+        string_static("sub2/d.txt"),
+    };
+    check_eq_int(
+        file_create_dir_sync(path_build_scratch(dirPath, string_lit("sub1/deep"))),
+        FileResult_Success);
+    check_eq_int(
+        file_create_dir_sync(path_build_scratch(dirPath, string_lit("sub2"))), FileResult_Success);
+
+    i64 expectedPathSize = 0;
+    array_for_t(g_filePaths, String, path) {
+      const String absPath = path_build_scratch(dirPath, *path);
+      check_eq_int(file_write_to_path_sync(absPath, *path), FileResult_Success);
+      expectedPathSize += (i64)path->size;
+    }
+
+    TestFileScanData data = {0};
+    check_eq_int(jobs_file_scan(dirPath, test_file_scan_handler, &data), FileIteratorResult_End);
+    check_eq_int(data.fileCount, array_elems(g_filePaths));
+    check_eq_int(data.totalPathSize, expectedPathSize);
+
+    array_for_t(g_filePaths, String, path) {
+      check_eq_int(file_delete_sync(path_build_scratch(dirPath, *path)), FileResult_Success);
+    }
+    file_delete_dir_sync(path_build_scratch(dirPath, string_lit("sub1/deep")));
+    file_delete_dir_sync(path_build_scratch(dirPath, string_lit("sub1")));
+    file_delete_dir_sync(path_build_scratch(dirPath, string_lit("sub2")));
+  }
+
+  it("fails when scanning a directory that does not exist") {
+    TestFileScanData data = {0};
+    check_eq_int(
+        jobs_file_scan(string_lit("does-not-exist-42"), test_file_scan_handler, &data),
+        FileIteratorResult_DirectoryDoesNotExist);
+    check_eq_int(data.fileCount, 0);
+  }
+
+  teardown() { file_delete_dir_sync(dirPath); }
+}
@@ -1,9 +1,15 @@
 #include "check/spec.h"
 #include "core/alloc.h"
+#include "core/bitset.h"
 #include "jobs/graph.h"
 
 #define task_flags JobTaskFlags_None
 
+static u64 test_graph_cost_estimator(const void* userCtx, const JobTaskId taskId) {
+  const u64* costs = userCtx;
+  return costs[taskId];
+}
+
 spec(graph) {
 
   JobGraph* graph = null;
@@ -52,6 +58,30 @@ spec(graph) {
     jobs_graph_destroy(graphCopy);
   }
 
+  it("supports rebinding an existing task") {
+    const u32       ctxA = 42;
+    const JobTaskId a = jobs_graph_add_task(graph, string_lit("A"), null, mem_var(ctxA), task_flags);
+    const JobTaskId b = jobs_graph_add_task(graph, string_lit("B"), null, mem_empty, task_flags);
+
+    // Setup B to depend on A.
+    jobs_graph_task_depend(graph, a, b);
+
+    // Rebind A with a new user context.
+    const u32 ctxANew = 1337;
+    check(jobs_graph_task_rebind(graph, a, string_lit("A"), null, mem_var(ctxANew), task_flags));
+
+    // The user context is updated while the dependencies are preserved.
+    check_eq_int(*(const u32*)jobs_graph_task_ctx(graph, a).ptr, ctxANew);
+    check(jobs_graph_task_has_parent(graph, b));
+    check(jobs_graph_task_has_child(graph, a));
+
+    // Rebinding fails when the task does not match.
+    check(!jobs_graph_task_rebind(graph, a, string_lit("C"), null, mem_var(ctxANew), task_flags));
+    check(!jobs_graph_task_rebind(
+        graph, a, string_lit("A"), null, mem_var(ctxANew), JobTaskFlags_ThreadAffinity));
+    check(!jobs_graph_task_rebind(graph, 99, string_lit("A"), null, mem_var(ctxANew), task_flags));
+  }
+
   it("supports registering dependencies between tasks") {
     const JobTaskId a = jobs_graph_add_task(graph, string_lit("A"), null, mem_empty, task_flags);
     const JobTaskId b = jobs_graph_add_task(graph, string_lit("B"), null, mem_empty, task_flags);
@@ -282,6 +312,30 @@ spec(graph) {
     check_eq_int(jobs_graph_task_span(graph), 1); // Span of this graph is still 1.
   }
 
+  it("can collect the tasks on the longest path") {
+    const JobTaskId a = jobs_graph_add_task(graph, string_lit("A"), null, mem_empty, task_flags);
+    const JobTaskId b = jobs_graph_add_task(graph, string_lit("B"), null, mem_empty, task_flags);
+    const JobTaskId c = jobs_graph_add_task(graph, string_lit("C"), null, mem_empty, task_flags);
+    const JobTaskId d = jobs_graph_add_task(graph, string_lit("D"), null, mem_empty, task_flags);
+
+    // Diamond graph: A -> (B, C) -> D, with an expensive C.
+    jobs_graph_task_depend(graph, a, b);
+    jobs_graph_task_depend(graph, a, c);
+    jobs_graph_task_depend(graph, b, d);
+    jobs_graph_task_depend(graph, c, d);
+
+    const u64    costs[]   = {1, 1, 10, 1};
+    const BitSet pathTasks = mem_stack(1);
+    const u64    span =
+        jobs_graph_task_span_path(graph, test_graph_cost_estimator, costs, pathTasks);
+
+    check_eq_int(span, 12); // A (1) + C (10) + D (1).
+    check(bitset_test(pathTasks, a));
+    check(!bitset_test(pathTasks, b));
+    check(bitset_test(pathTasks, c));
+    check(bitset_test(pathTasks, d));
+  }
+
   it("can detect cycles") {
     const JobTaskId a = jobs_graph_add_task(graph, string_lit("A"), null, mem_empty, task_flags);
     const JobTaskId b = jobs_graph_add_task(graph, string_lit("B"), null, mem_empty, task_flags);
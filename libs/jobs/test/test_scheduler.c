@@ -1,12 +1,22 @@
 #include "check/spec.h"
 #include "core/alloc.h"
 #include "core/dynarray.h"
+#include "core/thread.h"
 #include "jobs/scheduler.h"
 
 #define task_flags JobTaskFlags_None
 
 static void test_task_nop(MAYBE_UNUSED const void* ctx) {}
 
+typedef struct {
+  i64* counter;
+} TestSchedulerContinuationData;
+
+static void test_continuation_increment(const void* ctx) {
+  const TestSchedulerContinuationData* data = ctx;
+  thread_atomic_add_i64(data->counter, 1);
+}
+
 spec(scheduler) {
 
   it("can run a single-task job-graph") {
@@ -42,4 +52,71 @@ spec(scheduler) {
     dynarray_destroy(&jobIds);
     jobs_graph_destroy(jobGraph);
   }
+
+  it("runs a continuation when a job completes") {
+    JobGraph* jobGraph = jobs_graph_create(g_allocHeap, string_lit("TestJob"), 1);
+    jobs_graph_add_task(jobGraph, string_lit("TestTask"), test_task_nop, mem_empty, task_flags);
+
+    i64 counter = 0;
+
+    const JobId id = jobs_scheduler_run(jobGraph, g_allocPage);
+    jobs_scheduler_continue(
+        id,
+        test_continuation_increment,
+        mem_struct(TestSchedulerContinuationData, .counter = &counter));
+
+    jobs_scheduler_wait_help(id);
+    while (!thread_atomic_load_i64(&counter)) {
+      thread_yield(); // Continuation runs on the worker that finished the job; wait for it.
+    }
+    check_eq_int(counter, 1);
+
+    jobs_graph_destroy(jobGraph);
+  }
+
+  it("invokes a continuation immediately for a finished job") {
+    JobGraph* jobGraph = jobs_graph_create(g_allocHeap, string_lit("TestJob"), 1);
+    jobs_graph_add_task(jobGraph, string_lit("TestTask"), test_task_nop, mem_empty, task_flags);
+
+    const JobId id = jobs_scheduler_run(jobGraph, g_allocPage);
+    jobs_scheduler_wait_help(id);
+
+    i64 counter = 0;
+    jobs_scheduler_continue(
+        id,
+        test_continuation_increment,
+        mem_struct(TestSchedulerContinuationData, .counter = &counter));
+    check_eq_int(counter, 1);
+
+    jobs_graph_destroy(jobGraph);
+  }
+
+  it("runs a continuation when a set of jobs completes") {
+    static const u32 g_numJobs = 8;
+
+    JobGraph* jobGraph = jobs_graph_create(g_allocHeap, string_lit("TestJob"), 1);
+    jobs_graph_add_task(jobGraph, string_lit("TestTask"), test_task_nop, mem_empty, task_flags);
+
+    JobId ids[8];
+    for (u32 i = 0; i != g_numJobs; ++i) {
+      ids[i] = jobs_scheduler_run(jobGraph, g_allocPage);
+    }
+
+    i64 counter = 0;
+    jobs_scheduler_continue_many(
+        ids,
+        g_numJobs,
+        test_continuation_increment,
+        mem_struct(TestSchedulerContinuationData, .counter = &counter));
+
+    for (u32 i = 0; i != g_numJobs; ++i) {
+      jobs_scheduler_wait_help(ids[i]);
+    }
+    while (!thread_atomic_load_i64(&counter)) {
+      thread_yield(); // Continuation runs on the worker that finished the last job; wait for it.
+    }
+    check_eq_int(counter, 1);
+
+    jobs_graph_destroy(jobGraph);
+  }
 }
@@ -0,0 +1,45 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/rng.h"
+#include "jobs/sort.h"
+
+spec(sort) {
+
+  it("can sort a collection below the parallel threshold") {
+    enum { ElemCount = 512 };
+    u32* values = alloc_array_t(g_allocScratch, u32, ElemCount);
+    for (u32 i = 0; i != ElemCount; ++i) {
+      values[i] = rng_sample_u32(g_rng);
+    }
+    jobs_sort_t(values, values + ElemCount, u32, compare_u32);
+
+    for (u32 i = 1; i != ElemCount; ++i) {
+      check(values[i - 1] <= values[i]);
+    }
+  }
+
+  it("can sort a large collection in parallel") {
+    enum { ElemCount = 100 * 1000 };
+    u64* values = alloc_array_t(g_allocHeap, u64, ElemCount);
+
+    Rng* rng = rng_create_xorwow(g_allocHeap, 42);
+    u64  sum = 0;
+    for (u32 i = 0; i != ElemCount; ++i) {
+      sum += values[i] = rng_sample_u32(rng);
+    }
+    rng_destroy(rng);
+
+    jobs_sort_t(values, values + ElemCount, u64, compare_u64);
+
+    u64 sortedSum = 0;
+    for (u32 i = 0; i != ElemCount; ++i) {
+      sortedSum += values[i];
+      if (i) {
+        check(values[i - 1] <= values[i]);
+      }
+    }
+    check_eq_int(sortedSum, sum); // Verify no elements were lost or duplicated.
+
+    alloc_free_array_t(g_allocHeap, values, ElemCount);
+  }
+}
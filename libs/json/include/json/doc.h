@@ -128,6 +128,14 @@ JsonVal json_add_object(JsonDoc*);
  */
 JsonVal json_add_string(JsonDoc*, String);
 
+/**
+ * Add a new string to the document without copying the string data.
+ * Can be used as an optimization when the string memory is known to stay valid for the lifetime of
+ * the document (for example strings in an input text that outlives the document).
+ * Pre-condition: string.length < u32_max
+ */
+JsonVal json_add_string_view(JsonDoc*, String);
+
 /**
  * Add a hash-only string.
  * Hash-only strings can be used as an optimization when the value of a string is not needed.
@@ -42,6 +42,8 @@ typedef struct {
 typedef enum {
   JsonReadFlags_None               = 0,
   JsonReadFlags_HashOnlyFieldNames = 1 << 0, // Do not store object field names as strings.
+  JsonReadFlags_AliasStrings       = 1 << 1, // Alias strings in the input text where possible
+                                             // (input must stay valid for the document lifetime).
 } JsonReadFlags;
 
 /**
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/file.h"
 #include "core/string.h"
 #include "json/forward.h"
 
@@ -40,6 +41,11 @@ typedef struct {
       .newline               = string_lit("\n"),                                                   \
       __VA_ARGS__})
 
+/**
+ * Sink that receives the json output, invoked repeatedly with consecutive chunks of the document.
+ */
+typedef void (*JsonWriteSink)(void* ctx, String chunk);
+
 /**
  * Write a json value.
  * Aims for compatiblity with rfc7159 json (https://datatracker.ietf.org/doc/html/rfc7159).
@@ -47,3 +53,19 @@ typedef struct {
  * Pre-condition: JsonVal is valid in the given document.
  */
 void json_write(DynString*, const JsonDoc*, JsonVal, const JsonWriteOpts*);
+
+/**
+ * Write a json value to the given sink in fixed-size chunks.
+ * Runs free of allocations; useful for streaming large documents without growing a string.
+ *
+ * Pre-condition: JsonVal is valid in the given document.
+ */
+void json_write_sink(JsonWriteSink, void* ctx, const JsonDoc*, JsonVal, const JsonWriteOpts*);
+
+/**
+ * Write a json value directly to the given file in fixed-size chunks.
+ * Runs free of allocations; returns the first write error (if any).
+ *
+ * Pre-condition: JsonVal is valid in the given document.
+ */
+FileResult json_write_file(File*, const JsonDoc*, JsonVal, const JsonWriteOpts*);
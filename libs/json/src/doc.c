@@ -5,6 +5,14 @@
 #include "core/dynarray.h"
 #include "json/doc.h"
 
+/**
+ * Document storage.
+ * Values are stored in a single contiguous array (cache friendly to traverse) and string data is
+ * duplicated into a chunked bump allocator, making document teardown a release of the backing
+ * chunks instead of per-value frees. Exception are big strings (>= 'json_str_big_threshold') which
+ * get individual heap allocations tracked in a linked list.
+ */
+
 #define json_str_small_chunk_size (16 * usize_kibibyte)
 #define json_str_big_threshold (1 * usize_kibibyte)
 
@@ -74,20 +82,12 @@ static String json_bigstring_add(JsonDoc* doc, const String data) {
   }
 
   JsonBigStr* node = mem_as_t(allocMem, JsonBigStr);
-  *node            = (JsonBigStr){.size = data.size};
+  *node            = (JsonBigStr){.next = doc->bigStrs, .size = data.size};
+  doc->bigStrs     = node;
 
   const Mem nodeData = mem_create(node->data, data.size);
   mem_cpy(nodeData, data);
 
-  if (doc->bigStrs) {
-    JsonBigStr* tail = doc->bigStrs;
-    for (; tail->next; tail = tail->next)
-      ;
-    tail->next = node;
-  } else {
-    doc->bigStrs = node;
-  }
-
   return nodeData;
 }
 
@@ -175,6 +175,23 @@ JsonVal json_add_string(JsonDoc* doc, const String string) {
       });
 }
 
+JsonVal json_add_string_view(JsonDoc* doc, const String string) {
+  diag_assert(string.size < u32_max);
+
+  return json_add_data(
+      doc,
+      (JsonValData){
+          .typeAndParent = JsonType_String,
+          .next          = sentinel_u32,
+          .val_string =
+              {
+                  .data   = string.ptr,
+                  .length = (u32)string.size,
+                  .hash   = string_hash(string),
+              },
+      });
+}
+
 JsonVal json_add_string_hash(JsonDoc* doc, const StringHash stringHash) {
   return json_add_data(
       doc,
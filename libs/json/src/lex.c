@@ -195,7 +195,36 @@ static String json_lex_null(String str, JsonToken* out) {
   return json_consume_chars(str, 1);
 }
 
+INLINE_HINT static String json_lex_whitespace(String str) {
+#ifdef VOLO_SIMD
+  /**
+   * Skip whole blocks of whitespace at a time; the remaining (less then block sized) whitespace is
+   * consumed byte-wise by the caller.
+   */
+  const SimdVec spaceVec   = simd_vec_broadcast_u8(' ');
+  const SimdVec newlineVec = simd_vec_broadcast_u8('\n');
+  const SimdVec returnVec  = simd_vec_broadcast_u8('\r');
+  const SimdVec tabVec     = simd_vec_broadcast_u8('\t');
+  while (str.size >= 16) {
+    const SimdVec charsVec = simd_vec_load_unaligned(str.ptr);
+
+    SimdVec wsVec = simd_vec_eq_u8(charsVec, spaceVec);
+    wsVec         = simd_vec_or(wsVec, simd_vec_eq_u8(charsVec, newlineVec));
+    wsVec         = simd_vec_or(wsVec, simd_vec_eq_u8(charsVec, returnVec));
+    wsVec         = simd_vec_or(wsVec, simd_vec_eq_u8(charsVec, tabVec));
+
+    const u32 wsMask = simd_vec_mask_u8(wsVec);
+    if (wsMask != 0xFFFF) {
+      return json_consume_chars(str, intrinsic_ctz_32(~wsMask));
+    }
+    str = json_consume_chars(str, 16);
+  }
+#endif
+  return str;
+}
+
 String json_lex(String str, JsonToken* out) {
+  str = json_lex_whitespace(str);
   while (!string_is_empty(str)) {
     switch (*string_begin(str)) {
     case '[':
@@ -11,6 +11,7 @@
 typedef struct {
   JsonDoc*      doc;
   JsonReadFlags flags;
+  String        source;
   u32           depth;
 } JsonReadState;
 
@@ -45,6 +46,20 @@ String json_error_str(const JsonError error) {
   return g_errorStrs[error];
 }
 
+static JsonVal json_read_add_string(JsonReadState* state, const String str) {
+  if (state->flags & JsonReadFlags_AliasStrings && !string_is_empty(str)) {
+    /**
+     * Strings without escape sequences are lexed as views into the input text and can be stored
+     * without copying; strings that needed un-escaping live in transient storage and are copied.
+     */
+    const u8* strBegin = string_begin(str);
+    if (strBegin >= string_begin(state->source) && strBegin < string_end(state->source)) {
+      return json_add_string_view(state->doc, str);
+    }
+  }
+  return json_add_string(state->doc, str);
+}
+
 static String json_read_internal(JsonReadState*, String, JsonResult*);
 static String json_read_with_start_token(JsonReadState*, String, JsonToken, JsonResult*);
 
@@ -117,7 +132,7 @@ static String json_read_object(JsonReadState* state, String input, JsonResult* r
 #endif
       fieldName = json_add_string_hash(state->doc, fieldNameHash);
     } else {
-      fieldName = json_add_string(state->doc, token.val_string);
+      fieldName = json_read_add_string(state, token.val_string);
     }
 
     // Read separator (colon).
@@ -184,7 +199,7 @@ static String json_read_with_start_token(
     *res = json_err(JsonError_UnexpectedToken);
     break;
   case JsonTokenType_String:
-    *res = json_success(json_add_string(state->doc, startToken.val_string));
+    *res = json_success(json_read_add_string(state, startToken.val_string));
     break;
   case JsonTokenType_Number:
     *res = json_success(json_add_number(state->doc, startToken.val_number));
@@ -218,8 +233,9 @@ static String json_read_internal(JsonReadState* state, String input, JsonResult*
 
 String json_read(JsonDoc* doc, const String input, const JsonReadFlags flags, JsonResult* res) {
   JsonReadState state = {
-      .doc   = doc,
-      .flags = flags,
+      .doc    = doc,
+      .flags  = flags,
+      .source = input,
   };
   return json_read_internal(&state, input, res);
 }
@@ -1,5 +1,6 @@
 #include "core/diag.h"
 #include "core/dynstring.h"
+#include "core/file.h"
 #include "core/format.h"
 #include "core/unicode.h"
 #include "json/doc.h"
@@ -8,39 +9,72 @@
 #define json_compact_array_max_elems 4
 #define json_compact_object_max_fields 4
 
+#define json_write_buffer_size (4 * usize_kibibyte)
+#define json_write_number_size_max 64
+
 typedef struct {
   const JsonDoc*       doc;
   const JsonWriteOpts* opts;
   u32                  indent;
+  DynString            buffer; // Fixed-capacity chunk buffer; flushed to the sink when full.
+  JsonWriteSink        sink;
+  void*                sinkCtx;
 } JsonWriteState;
 
-static void json_state_write_string(JsonWriteState*, DynString*, String);
-static void json_state_write(JsonWriteState*, DynString*, JsonVal);
+static void json_state_write_string(JsonWriteState*, String);
+static void json_state_write(JsonWriteState*, JsonVal);
+
+static void json_state_flush(JsonWriteState* s) {
+  if (s->buffer.size) {
+    s->sink(s->sinkCtx, dynstring_view(&s->buffer));
+    dynstring_clear(&s->buffer);
+  }
+}
+
+/**
+ * Ensure the chunk buffer has space for at least 'size' more bytes.
+ * Pre-condition: size <= json_write_buffer_size.
+ */
+INLINE_HINT static void json_state_reserve(JsonWriteState* s, const usize size) {
+  if (UNLIKELY((s->buffer.data.size - s->buffer.size) < size)) {
+    json_state_flush(s);
+  }
+}
 
-static void json_state_write_separator(JsonWriteState* s, const JsonWriteMode m, DynString* str) {
+INLINE_HINT static void json_state_out(JsonWriteState* s, const String text) {
+  json_state_reserve(s, text.size);
+  dynstring_append(&s->buffer, text);
+}
+
+INLINE_HINT static void json_state_out_char(JsonWriteState* s, const u8 c) {
+  json_state_reserve(s, 1);
+  dynstring_append_char(&s->buffer, c);
+}
+
+static void json_state_write_separator(JsonWriteState* s, const JsonWriteMode m) {
   switch (m) {
   case JsonWriteMode_Minimal:
     break;
   case JsonWriteMode_Compact:
-    dynstring_append_char(str, ' ');
+    json_state_out_char(s, ' ');
     break;
   case JsonWriteMode_Verbose:
-    dynstring_append(str, s->opts->newline);
+    json_state_out(s, s->opts->newline);
     for (usize i = 0; i != s->indent; ++i) {
-      dynstring_append(str, s->opts->indent);
+      json_state_out(s, s->opts->indent);
     }
     break;
   }
 }
 
-static void json_state_write_indent(JsonWriteState* s, const JsonWriteMode m, DynString* str) {
+static void json_state_write_indent(JsonWriteState* s, const JsonWriteMode m) {
   ++s->indent;
-  json_state_write_separator(s, m, str);
+  json_state_write_separator(s, m);
 }
 
-static void json_state_write_outdent(JsonWriteState* s, const JsonWriteMode m, DynString* str) {
+static void json_state_write_outdent(JsonWriteState* s, const JsonWriteMode m) {
   --s->indent;
-  json_state_write_separator(s, m, str);
+  json_state_write_separator(s, m);
 }
 
 static bool json_state_array_is_compact(JsonWriteState* s, const JsonVal val) {
@@ -56,11 +90,11 @@ static bool json_state_array_is_compact(JsonWriteState* s, const JsonVal val) {
   return true;
 }
 
-static void json_state_write_array(JsonWriteState* s, DynString* str, const JsonVal val) {
-  dynstring_append_char(str, '[');
+static void json_state_write_array(JsonWriteState* s, const JsonVal val) {
+  json_state_out_char(s, '[');
 
   if (json_elem_count(s->doc, val) == 0) {
-    dynstring_append_char(str, ']');
+    json_state_out_char(s, ']');
     return;
   }
 
@@ -77,20 +111,20 @@ static void json_state_write_array(JsonWriteState* s, DynString* str, const Json
     break;
   }
 
-  json_state_write_indent(s, mode, str);
+  json_state_write_indent(s, mode);
 
   bool first = true;
   json_for_elems(s->doc, val, elem) {
     if (!first) {
-      dynstring_append_char(str, ',');
-      json_state_write_separator(s, mode, str);
+      json_state_out_char(s, ',');
+      json_state_write_separator(s, mode);
     }
     first = false;
-    json_state_write(s, str, elem);
+    json_state_write(s, elem);
   }
 
-  json_state_write_outdent(s, mode, str);
-  dynstring_append_char(str, ']');
+  json_state_write_outdent(s, mode);
+  json_state_out_char(s, ']');
 }
 
 static bool json_state_object_is_compact(JsonWriteState* s, const JsonVal val) {
@@ -106,11 +140,11 @@ static bool json_state_object_is_compact(JsonWriteState* s, const JsonVal val) {
   return true;
 }
 
-static void json_state_write_object(JsonWriteState* s, DynString* str, const JsonVal val) {
-  dynstring_append_char(str, '{');
+static void json_state_write_object(JsonWriteState* s, const JsonVal val) {
+  json_state_out_char(s, '{');
 
   if (json_field_count(s->doc, val) == 0) {
-    dynstring_append_char(str, '}');
+    json_state_out_char(s, '}');
     return;
   }
 
@@ -127,77 +161,76 @@ static void json_state_write_object(JsonWriteState* s, DynString* str, const Jso
     break;
   }
 
-  json_state_write_indent(s, mode, str);
+  json_state_write_indent(s, mode);
 
   bool first = true;
   json_for_fields(s->doc, val, field) {
     if (!first) {
-      dynstring_append_char(str, ',');
-      json_state_write_separator(s, mode, str);
+      json_state_out_char(s, ',');
+      json_state_write_separator(s, mode);
     }
     first = false;
 
-    json_state_write_string(s, str, json_string(s->doc, field.name));
+    json_state_write_string(s, json_string(s->doc, field.name));
 
     const bool pretty = s->opts->mode != JsonWriteMode_Minimal;
-    dynstring_append(str, pretty ? string_lit(": ") : string_lit(":"));
+    json_state_out(s, pretty ? string_lit(": ") : string_lit(":"));
 
-    json_state_write(s, str, field.value);
+    json_state_write(s, field.value);
   }
 
-  json_state_write_outdent(s, mode, str);
-  dynstring_append_char(str, '}');
+  json_state_write_outdent(s, mode);
+  json_state_out_char(s, '}');
 }
 
-static void json_state_write_string(JsonWriteState* s, DynString* str, const String val) {
-  (void)s;
-
-  dynstring_append_char(str, '"');
+static void json_state_write_string(JsonWriteState* s, const String val) {
+  json_state_out_char(s, '"');
   mem_for_u8(val, itr) {
     switch (*itr) {
     case Unicode_Escape:
-      dynstring_append(str, string_lit("\\"));
+      json_state_out(s, string_lit("\\"));
       break;
     case '"':
-      dynstring_append(str, string_lit("\\\""));
+      json_state_out(s, string_lit("\\\""));
       break;
     case '\\':
-      dynstring_append(str, string_lit("\\\\"));
+      json_state_out(s, string_lit("\\\\"));
       break;
     case '\b':
-      dynstring_append(str, string_lit("\\b"));
+      json_state_out(s, string_lit("\\b"));
       break;
     case '\f':
-      dynstring_append(str, string_lit("\\f"));
+      json_state_out(s, string_lit("\\f"));
       break;
     case '\n':
-      dynstring_append(str, string_lit("\\n"));
+      json_state_out(s, string_lit("\\n"));
       break;
     case '\r':
-      dynstring_append(str, string_lit("\\r"));
+      json_state_out(s, string_lit("\\r"));
       break;
     case '\t':
-      dynstring_append(str, string_lit("\\t"));
+      json_state_out(s, string_lit("\\t"));
       break;
     case '$':
       if (s->opts->flags & JsonWriteFlags_EscapeDollarSign) {
-        dynstring_append(str, string_lit("\\$"));
+        json_state_out(s, string_lit("\\$"));
       } else {
-        dynstring_append_char(str, '$');
+        json_state_out_char(s, '$');
       }
       break;
     default:
-      dynstring_append_char(str, *itr);
+      json_state_out_char(s, *itr);
       break;
     }
   }
-  dynstring_append_char(str, '"');
+  json_state_out_char(s, '"');
 }
 
-static void json_state_write_number(JsonWriteState* s, DynString* str, const f64 val) {
-  (void)s;
+static void json_state_write_number(JsonWriteState* s, const f64 val) {
+  // Format directly into the chunk buffer; reserving up-front avoids any allocation.
+  json_state_reserve(s, json_write_number_size_max);
   format_write_f64(
-      str,
+      &s->buffer,
       val,
       &format_opts_float(
               .maxDecDigits    = s->opts->numberMaxDecDigits,
@@ -205,35 +238,31 @@ static void json_state_write_number(JsonWriteState* s, DynString* str, const f64
               .expThresholdNeg = s->opts->numberExpThresholdNeg));
 }
 
-static void json_state_write_bool(JsonWriteState* s, DynString* str, const bool val) {
-  (void)s;
-  dynstring_append(str, val ? string_lit("true") : string_lit("false"));
+static void json_state_write_bool(JsonWriteState* s, const bool val) {
+  json_state_out(s, val ? string_lit("true") : string_lit("false"));
 }
 
-static void json_state_write_null(JsonWriteState* s, DynString* str) {
-  (void)s;
-  dynstring_append(str, string_lit("null"));
-}
+static void json_state_write_null(JsonWriteState* s) { json_state_out(s, string_lit("null")); }
 
-static void json_state_write(JsonWriteState* s, DynString* str, const JsonVal val) {
+static void json_state_write(JsonWriteState* s, const JsonVal val) {
   switch (json_type(s->doc, val)) {
   case JsonType_Array:
-    json_state_write_array(s, str, val);
+    json_state_write_array(s, val);
     return;
   case JsonType_Object:
-    json_state_write_object(s, str, val);
+    json_state_write_object(s, val);
     return;
   case JsonType_String:
-    json_state_write_string(s, str, json_string(s->doc, val));
+    json_state_write_string(s, json_string(s->doc, val));
     return;
   case JsonType_Number:
-    json_state_write_number(s, str, json_number(s->doc, val));
+    json_state_write_number(s, json_number(s->doc, val));
     return;
   case JsonType_Bool:
-    json_state_write_bool(s, str, json_bool(s->doc, val));
+    json_state_write_bool(s, json_bool(s->doc, val));
     return;
   case JsonType_Null:
-    json_state_write_null(s, str);
+    json_state_write_null(s);
     return;
   case JsonType_Count:
     break;
@@ -241,11 +270,48 @@ static void json_state_write(JsonWriteState* s, DynString* str, const JsonVal va
   diag_crash();
 }
 
-void json_write(DynString* str, const JsonDoc* doc, const JsonVal val, const JsonWriteOpts* opts) {
+void json_write_sink(
+    const JsonWriteSink  sink,
+    void*                ctx,
+    const JsonDoc*       doc,
+    const JsonVal        val,
+    const JsonWriteOpts* opts) {
+  u8             bufferMem[json_write_buffer_size];
   JsonWriteState state = {
-      .doc    = doc,
-      .opts   = opts,
-      .indent = 0,
+      .doc     = doc,
+      .opts    = opts,
+      .indent  = 0,
+      .buffer  = dynstring_create_over(mem_var(bufferMem)),
+      .sink    = sink,
+      .sinkCtx = ctx,
   };
-  json_state_write(&state, str, val);
+  json_state_write(&state, val);
+  json_state_flush(&state);
+}
+
+static void json_write_dynstring_sink(void* ctx, const String chunk) {
+  dynstring_append((DynString*)ctx, chunk);
+}
+
+void json_write(DynString* str, const JsonDoc* doc, const JsonVal val, const JsonWriteOpts* opts) {
+  json_write_sink(json_write_dynstring_sink, str, doc, val, opts);
+}
+
+typedef struct {
+  File*      file;
+  FileResult result;
+} JsonWriteFileCtx;
+
+static void json_write_file_sink(void* ctx, const String chunk) {
+  JsonWriteFileCtx* fileCtx = ctx;
+  if (fileCtx->result == FileResult_Success) {
+    fileCtx->result = file_write_sync(fileCtx->file, chunk);
+  }
+}
+
+FileResult
+json_write_file(File* file, const JsonDoc* doc, const JsonVal val, const JsonWriteOpts* opts) {
+  JsonWriteFileCtx ctx = {.file = file, .result = FileResult_Success};
+  json_write_sink(json_write_file_sink, &ctx, doc, val, opts);
+  return ctx.result;
 }
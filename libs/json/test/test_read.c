@@ -169,6 +169,24 @@ spec(read) {
     }
   }
 
+  it("can alias strings in the input text") {
+    const String input = string_lit("[\"this-is-a-long-string-value\", \"esc\\taped\"]");
+
+    JsonResult   res;
+    const String rem = json_read(doc, input, JsonReadFlags_AliasStrings, &res);
+
+    check(string_is_empty(rem));
+    check_require(res.type == JsonResultType_Success);
+
+    // Plain strings are stored as views into the input text.
+    const String aliased = json_string(doc, json_elem(doc, res.val, 0));
+    check_eq_string(aliased, string_lit("this-is-a-long-string-value"));
+    check(aliased.ptr >= string_begin(input) && aliased.ptr < string_end(input));
+
+    // Strings with escape sequences are copied into the document.
+    check_eq_string(json_string(doc, json_elem(doc, res.val, 1)), string_lit("esc\taped"));
+  }
+
   it("can read booleans") {
     struct {
       String input;
@@ -7,6 +7,10 @@
 #include "json/doc.h"
 #include "json/write.h"
 
+static void test_write_collect_sink(void* ctx, const String chunk) {
+  dynstring_append((DynString*)ctx, chunk);
+}
+
 spec(write) {
 
   JsonDoc*  doc    = null;
@@ -240,6 +244,21 @@ spec(write) {
                    "}"));
   }
 
+  it("can write to a sink in chunks") {
+    const JsonVal val = json_add_array(doc);
+    for (u32 i = 0; i != 1024; ++i) {
+      json_add_elem(doc, val, json_add_string_lit(doc, "A reasonably long element string"));
+    }
+    DynString reference = dynstring_create(g_allocPage, usize_kibibyte * 64);
+    json_write(&reference, doc, val, &json_write_opts());
+
+    // Stream the same document through the sink api; the output has to match exactly.
+    json_write_sink(test_write_collect_sink, &buffer, doc, val, &json_write_opts());
+    check_eq_string(dynstring_view(&buffer), dynstring_view(&reference));
+
+    dynstring_destroy(&reference);
+  }
+
   teardown() {
     json_destroy(doc);
     dynstring_destroy(&buffer);
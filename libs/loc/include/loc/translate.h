@@ -22,3 +22,11 @@
  * NOTE: Returned string is valid until the end of the frame.
  */
 String loc_translate(StringHash key);
+
+/**
+ * Retrieve the localized strings for the given keys; the translation source is only locked once
+ * for the whole batch, prefer this over 'loc_translate' when resolving many keys at once.
+ * NOTE: Outputs an empty string for keys that cannot be found.
+ * NOTE: Output strings are valid until the end of the frame.
+ */
+void loc_translate_batch(const StringHash* keys, String* out, u32 count);
@@ -1,4 +1,4 @@
-#include "core/search.h"
+#include "core/alloc.h"
 #include "core/string.h"
 #include "core/thread.h"
 #include "ecs/entity.h"
@@ -6,53 +6,109 @@
 
 #include "translate.h"
 
-static ThreadSpinLock         g_locTranslateLock;
-static EcsEntityId            g_locTranslateAsset;
-static const AssetLocaleText* g_locTranslateEntries;
-static usize                  g_locTranslateEntryCount;
+static ThreadSpinLock   g_locTranslateLock;
+static EcsEntityId      g_locTranslateAsset;
+static AssetLocaleText* g_locTranslateEntries; // Eytzinger (breadth-first) layout.
+static usize            g_locTranslateEntryCount;
+
+/**
+ * Copy the sorted entries into an Eytzinger (breadth-first) layout: the tree root at index 0 and
+ * the children of node 'k' at '2k + 1' and '2k + 2'. Lookups then walk a single implicit-tree path
+ * (one probe per level, no collision chains) and the top levels are shared between all keys, which
+ * keeps them cache-hot.
+ */
+static usize loc_translate_layout_build(
+    const AssetLocaleText* sorted,
+    usize                  i,
+    AssetLocaleText*       out,
+    const usize            count,
+    const usize            k) {
+  if (k < count) {
+    i      = loc_translate_layout_build(sorted, i, out, count, k * 2 + 1);
+    out[k] = sorted[i++];
+    i      = loc_translate_layout_build(sorted, i, out, count, k * 2 + 2);
+  }
+  return i;
+}
+
+/**
+ * Pre-condition: Caller has locked 'g_locTranslateLock'.
+ */
+static String loc_translate_lookup(const StringHash key) {
+  const AssetLocaleText* entries = g_locTranslateEntries;
+  for (usize k = 0; k < g_locTranslateEntryCount; /* in-loop */) {
+    if (entries[k].key == key) {
+      return entries[k].value;
+    }
+    k = k * 2 + (entries[k].key < key ? 2 : 1);
+  }
+  return string_empty;
+}
 
 void loc_translate_source_set(const EcsEntityId localeAsset, const AssetLocaleComp* localeComp) {
+  /**
+   * NOTE: Its important to copy the entries instead of storing a pointer to the localeComp as the
+   * ECS component pointers are not stable across frames. The entry values do stay valid as they
+   * point into the component's (stable) heap allocations.
+   */
+  const usize      count   = localeComp->textEntries.count;
+  AssetLocaleText* entries = null;
+  if (count) {
+    entries = alloc_array_t(g_allocHeap, AssetLocaleText, count);
+    loc_translate_layout_build(localeComp->textEntries.values, 0, entries, count, 0);
+  }
+
+  AssetLocaleText* prevEntries;
+  usize            prevEntryCount;
   thread_spinlock_lock(&g_locTranslateLock);
   {
-    /**
-     * NOTE: Its important to store the entry pointers instead of storing a pointer to the
-     * localeComp as the ECS component pointers are not stable across frames.
-     */
+    prevEntries    = g_locTranslateEntries;
+    prevEntryCount = g_locTranslateEntryCount;
+
     g_locTranslateAsset      = localeAsset;
-    g_locTranslateEntries    = localeComp->textEntries.values;
-    g_locTranslateEntryCount = localeComp->textEntries.count;
+    g_locTranslateEntries    = entries;
+    g_locTranslateEntryCount = count;
   }
   thread_spinlock_unlock(&g_locTranslateLock);
+
+  if (prevEntries) {
+    alloc_free_array_t(g_allocHeap, prevEntries, prevEntryCount);
+  }
 }
 
 void loc_translate_source_unset(const EcsEntityId localeAsset) {
+  AssetLocaleText* prevEntries    = null;
+  usize            prevEntryCount = 0;
   thread_spinlock_lock(&g_locTranslateLock);
   {
     if (g_locTranslateAsset == localeAsset) {
+      prevEntries    = g_locTranslateEntries;
+      prevEntryCount = g_locTranslateEntryCount;
+
       g_locTranslateAsset      = ecs_entity_invalid;
       g_locTranslateEntries    = null;
       g_locTranslateEntryCount = 0;
     }
   }
   thread_spinlock_unlock(&g_locTranslateLock);
+
+  if (prevEntries) {
+    alloc_free_array_t(g_allocHeap, prevEntries, prevEntryCount);
+  }
 }
 
 String loc_translate(const StringHash key) {
-  const AssetLocaleText tgt = {.key = key};
+  String result;
+  thread_spinlock_lock(&g_locTranslateLock);
+  { result = loc_translate_lookup(key); }
+  thread_spinlock_unlock(&g_locTranslateLock);
+  return result;
+}
 
-  String result = string_empty;
+void loc_translate_batch(const StringHash* keys, String* out, const u32 count) {
   thread_spinlock_lock(&g_locTranslateLock);
-  {
-    const AssetLocaleText* entry = search_binary_t(
-        g_locTranslateEntries,
-        g_locTranslateEntries + g_locTranslateEntryCount,
-        AssetLocaleText,
-        asset_locale_text_compare,
-        &tgt);
-    if (LIKELY(entry)) {
-      result = entry->value;
-    }
+  for (u32 i = 0; i != count; ++i) {
+    out[i] = loc_translate_lookup(keys[i]);
   }
   thread_spinlock_unlock(&g_locTranslateLock);
-  return result;
 }
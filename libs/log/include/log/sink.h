@@ -14,4 +14,10 @@ struct sLogSink {
    * NOTE: Can be 'null' when the sink doesn't need special destruction logic.
    */
   void (*destroy)(LogSink*);
+
+  /**
+   * Mask of the levels this sink is interested in ('LogMask_All' to receive everything).
+   * The logger skips formatting of messages that no sink is interested in.
+   */
+  LogMask mask;
 };
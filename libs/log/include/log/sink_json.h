@@ -4,6 +4,7 @@
 typedef enum {
   LogSinkJsonFlags_None        = 0,
   LogSinkJsonFlags_DestroyFile = 1 << 0,
+  LogSinkJsonFlags_Async       = 1 << 1, // Write from a flusher thread instead of the log callsite.
 } LogSinkJsonFlags;
 
 /**
@@ -4,6 +4,7 @@
 typedef enum {
   LogSinkPrettyFlags_None        = 0,
   LogSinkPrettyFlags_DestroyFile = 1 << 0,
+  LogSinkPrettyFlags_Async = 1 << 1, // Write from a flusher thread instead of the log callsite.
 
   LogSinkPrettyFlags_Default = LogSinkPrettyFlags_None,
 } LogSinkPrettyFlags;
@@ -1,4 +1,5 @@
 #include "core/diag.h"
+#include "core/init.h"
 #include "core/thread.h"
 #include "log/init.h"
 
@@ -12,7 +13,9 @@ void log_init(void) {
   if (!g_initalized) {
     g_initalized = true;
 
+    core_init_phase_begin(string_lit("log"));
     log_global_logger_init();
+    core_init_phase_end();
   }
 }
 
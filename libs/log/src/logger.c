@@ -12,6 +12,7 @@
 struct sLogger {
   LogSink*       sinks[log_sinks_max];
   u32            sinkCount;
+  LogMask        mask; // Union of the masks of all sinks.
   ThreadSpinLock sinksLock;
   Allocator*     alloc;
 };
@@ -89,6 +90,7 @@ void log_add_sink(Logger* logger, LogSink* sink) {
   }
 
   logger->sinks[logger->sinkCount++] = sink;
+  logger->mask |= sink->mask;
 
   thread_spinlock_unlock(&logger->sinksLock);
 }
@@ -97,6 +99,10 @@ void log_append(Logger* logger, LogLevel lvl, SourceLoc loc, String str, const L
   diag_assert_msg(logger, "Logger not initialized");
   diag_assert_msg(!string_is_empty(str), "An empty message cannot logged");
 
+  if (!log_mask_enabled(logger->mask, lvl)) {
+    return; // No sink is interested in this level; avoid the formatting work.
+  }
+
   const String   message   = log_format_text_scratch(str, params);
   const TimeReal timestamp = time_real_clock();
 
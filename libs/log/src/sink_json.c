@@ -11,6 +11,7 @@
 #include "log/sink_json.h"
 
 #include "logger.h"
+#include "writer.h"
 
 #define log_sink_buffer_size (16 * usize_kibibyte)
 
@@ -18,6 +19,7 @@ typedef struct {
   LogSink          api;
   Allocator*       alloc;
   File*            file;
+  LogWriter*       writer; // Only valid when using the Async flag.
   LogMask          mask;
   LogSinkJsonFlags flags;
 } LogSinkJson;
@@ -80,7 +82,11 @@ static void log_sink_json_write(
 
   json_write(&str, doc, root, &json_write_opts(.mode = JsonWriteMode_Minimal));
   dynstring_append_char(&str, '\n');
-  file_write_sync(jsonSink->file, dynstring_view(&str));
+  if (jsonSink->writer) {
+    log_writer_write(jsonSink->writer, dynstring_view(&str));
+  } else {
+    file_write_sync(jsonSink->file, dynstring_view(&str));
+  }
 
   dynstring_destroy(&str);
   json_destroy(doc);
@@ -88,6 +94,9 @@ static void log_sink_json_write(
 
 static void log_sink_json_destroy(LogSink* sink) {
   LogSinkJson* jsonSink = (LogSinkJson*)sink;
+  if (jsonSink->writer) {
+    log_writer_destroy(jsonSink->writer); // Flushes all pending output.
+  }
   if (jsonSink->flags & LogSinkJsonFlags_DestroyFile) {
     file_destroy(jsonSink->file);
   }
@@ -99,12 +108,15 @@ log_sink_json(Allocator* alloc, File* file, const LogMask mask, const LogSinkJso
   LogSinkJson* sink = alloc_alloc_t(alloc, LogSinkJson);
 
   *sink = (LogSinkJson){
-      .api   = {.write = log_sink_json_write, .destroy = log_sink_json_destroy},
+      .api   = {.write = log_sink_json_write, .destroy = log_sink_json_destroy, .mask = mask},
       .alloc = alloc,
       .file  = file,
       .mask  = mask,
       .flags = flags,
   };
+  if (flags & LogSinkJsonFlags_Async) {
+    sink->writer = log_writer_create(alloc, file);
+  }
 
   return (LogSink*)sink;
 }
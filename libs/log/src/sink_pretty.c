@@ -9,6 +9,7 @@
 #include "log/sink_pretty.h"
 
 #include "logger.h"
+#include "writer.h"
 
 #define log_sink_buffer_size (16 * usize_kibibyte)
 
@@ -16,6 +17,7 @@ typedef struct {
   LogSink            api;
   Allocator*         alloc;
   File*              file;
+  LogWriter*         writer; // Only valid when using the Async flag.
   LogMask            mask;
   bool               style;
   LogSinkPrettyFlags flags;
@@ -98,12 +100,19 @@ static void log_sink_pretty_write(
     fmt_write(&str, "{}\n", arg_style_reset(prettySink));
   }
 
-  file_write_sync(prettySink->file, dynstring_view(&str));
+  if (prettySink->writer) {
+    log_writer_write(prettySink->writer, dynstring_view(&str));
+  } else {
+    file_write_sync(prettySink->file, dynstring_view(&str));
+  }
   dynstring_destroy(&str);
 }
 
 static void log_sink_pretty_destroy(LogSink* sink) {
   LogSinkPretty* prettySink = (LogSinkPretty*)sink;
+  if (prettySink->writer) {
+    log_writer_destroy(prettySink->writer); // Flushes all pending output.
+  }
   if (prettySink->flags & LogSinkPrettyFlags_DestroyFile) {
     file_destroy(prettySink->file);
   }
@@ -115,7 +124,8 @@ log_sink_pretty(Allocator* alloc, File* file, const LogMask mask, const LogSinkP
   LogSinkPretty* sink = alloc_alloc_t(alloc, LogSinkPretty);
 
   *sink = (LogSinkPretty){
-      .api      = {.write = log_sink_pretty_write, .destroy = log_sink_pretty_destroy},
+      .api =
+          {.write = log_sink_pretty_write, .destroy = log_sink_pretty_destroy, .mask = mask},
       .alloc    = alloc,
       .file     = file,
       .mask     = mask,
@@ -123,6 +133,9 @@ log_sink_pretty(Allocator* alloc, File* file, const LogMask mask, const LogSinkP
       .flags    = flags,
       .timezone = time_zone_current(),
   };
+  if (flags & LogSinkPrettyFlags_Async) {
+    sink->writer = log_writer_create(alloc, file);
+  }
 
   return (LogSink*)sink;
 }
@@ -0,0 +1,87 @@
+#include "core/alloc.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/thread.h"
+
+#include "writer.h"
+
+#define log_writer_pending_max (256 * usize_kibibyte)
+
+struct sLogWriter {
+  Allocator*      alloc;
+  File*           file;
+  ThreadMutex     mutex;
+  ThreadCondition wakeCondition;  // Signaled when new data is pending or shutdown is requested.
+  ThreadCondition spaceCondition; // Signaled when buffer space becomes available.
+  ThreadHandle    thread;
+  bool            shutdown;
+  DynString       pending; // Guarded by 'mutex'.
+};
+
+static void log_writer_thread(void* data) {
+  LogWriter* writer = data;
+  DynString  buffer = dynstring_create(g_allocHeap, log_writer_pending_max);
+  bool       active = true;
+  while (active) {
+    thread_mutex_lock(writer->mutex);
+    while (!writer->pending.size && !writer->shutdown) {
+      thread_cond_wait(writer->wakeCondition, writer->mutex);
+    }
+    dynstring_append(&buffer, dynstring_view(&writer->pending));
+    dynstring_clear(&writer->pending);
+    active = !writer->shutdown;
+    thread_cond_broadcast(writer->spaceCondition);
+    thread_mutex_unlock(writer->mutex);
+
+    if (buffer.size) {
+      file_write_sync(writer->file, dynstring_view(&buffer));
+      dynstring_clear(&buffer);
+    }
+  }
+  dynstring_destroy(&buffer);
+}
+
+LogWriter* log_writer_create(Allocator* alloc, File* file) {
+  LogWriter* writer = alloc_alloc_t(alloc, LogWriter);
+
+  *writer = (LogWriter){
+      .alloc          = alloc,
+      .file           = file,
+      .mutex          = thread_mutex_create(alloc),
+      .wakeCondition  = thread_cond_create(alloc),
+      .spaceCondition = thread_cond_create(alloc),
+      .pending        = dynstring_create(g_allocHeap, usize_kibibyte * 16),
+  };
+
+  const String         threadName = string_lit("volo_log_writer");
+  const ThreadPriority threadPrio = ThreadPriority_Low;
+  writer->thread                  = thread_start(log_writer_thread, writer, threadName, threadPrio);
+
+  return writer;
+}
+
+void log_writer_destroy(LogWriter* writer) {
+  thread_mutex_lock(writer->mutex);
+  writer->shutdown = true;
+  thread_cond_signal(writer->wakeCondition);
+  thread_mutex_unlock(writer->mutex);
+  thread_join(writer->thread); // Flusher drains the pending output before exiting.
+
+  thread_mutex_destroy(writer->mutex);
+  thread_cond_destroy(writer->wakeCondition);
+  thread_cond_destroy(writer->spaceCondition);
+  dynstring_destroy(&writer->pending);
+  alloc_free_t(writer->alloc, writer);
+}
+
+void log_writer_write(LogWriter* writer, const String data) {
+  thread_mutex_lock(writer->mutex);
+  // Apply back-pressure when the flusher cannot keep up; bounds the pending memory.
+  // NOTE: Data bigger then the maximum is accepted when the buffer is empty.
+  while (writer->pending.size && (writer->pending.size + data.size) > log_writer_pending_max) {
+    thread_cond_wait(writer->spaceCondition, writer->mutex);
+  }
+  dynstring_append(&writer->pending, data);
+  thread_cond_signal(writer->wakeCondition);
+  thread_mutex_unlock(writer->mutex);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "core/forward.h"
+
+/**
+ * Asynchronous file writer.
+ * Producers enqueue formatted output which a dedicated flusher thread writes to the file, keeping
+ * the file io out of the logging threads.
+ */
+typedef struct sLogWriter LogWriter;
+
+/**
+ * Create an asynchronous writer for the given file.
+ * Should be cleaned up using 'log_writer_destroy()'.
+ * NOTE: Does not take ownership of the file.
+ */
+LogWriter* log_writer_create(Allocator*, File*);
+
+/**
+ * Destroy the given writer; flushes all pending output and joins the flusher thread.
+ */
+void log_writer_destroy(LogWriter*);
+
+/**
+ * Enqueue data to be written to the file.
+ * NOTE: When the pending buffer is full the calling thread blocks until the flusher catches up.
+ * NOTE: Can be called from multiple threads in parallel.
+ */
+void log_writer_write(LogWriter*, String data);
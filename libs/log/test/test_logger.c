@@ -45,7 +45,7 @@ spec(logger) {
     startTime = time_real_clock();
     logger    = log_create(g_allocHeap);
     sink      = (SinkTest){
-             .api      = (LogSink){.write = log_sink_test_write},
+             .api      = (LogSink){.write = log_sink_test_write, .mask = LogMask_All},
              .messages = dynarray_create_t(g_allocHeap, SinkTestMsg, 8),
     };
     log_add_sink(logger, (LogSink*)&sink);
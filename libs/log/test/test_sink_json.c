@@ -93,6 +93,31 @@ spec(sink_json) {
         string_lit("Hello42World"));
   }
 
+  it("supports asynchronous writing") {
+    Logger* asyncLogger = log_create(g_allocHeap);
+    File*   asyncFile;
+    file_temp(g_allocHeap, &asyncFile);
+
+    const LogSinkJsonFlags flags = LogSinkJsonFlags_Async;
+    log_add_sink(asyncLogger, log_sink_json(g_allocHeap, asyncFile, LogMask_All, flags));
+
+    log(asyncLogger, LogLevel_Info, "Hello Async");
+    log_destroy(asyncLogger); // Flushes all pending output.
+
+    file_seek_sync(asyncFile, 0);
+    file_read_to_end_sync(asyncFile, &buffer);
+
+    JsonResult result;
+    json_read(jsonDoc, dynstring_view(&buffer), JsonReadFlags_None, &result);
+    check_eq_int(result.type, JsonResultType_Success);
+
+    check_eq_string(
+        json_string(jsonDoc, json_field_lit(jsonDoc, result.val, "message")),
+        string_lit("Hello Async"));
+
+    file_destroy(asyncFile);
+  }
+
   it("ignores messages which do not match the mask") {
     log(logger, LogLevel_Error, "Hello World");
 
@@ -62,6 +62,21 @@ NetResult net_interfaces(NetAddr out[], u32* count, NetInterfaceQueryFlags);
  */
 NetResult net_resolve_sync(String host, NetAddr out[], u32* count);
 
+/**
+ * Resolve a host-name to addresses through an in-process cache.
+ * Cached addresses are served for a fixed interval (the platform resolvers do not expose the
+ * record TTLs) and are refreshed in the background when they are aging; only a cold cache pays the
+ * full resolver cost.
+ * NOTE: Provide the max amount to query in 'count'; will be replaced with the result count.
+ */
+NetResult net_resolve_cached(String host, NetAddr out[], u32* count);
+
+/**
+ * Queue a background resolve for the given host-name (unless its already freshly cached), so a
+ * later 'net_resolve_cached()' call can be served from the cache.
+ */
+void net_resolve_prefetch(String host);
+
 /**
  * Write the textual representation of the given ip.
  */
@@ -5,14 +5,16 @@
  * Forward header for the net library.
  */
 
-typedef enum eNetDir        NetDir;
-typedef enum eNetHttpFlags  NetHttpFlags;
-typedef enum eNetResult     NetResult;
-typedef struct sNetAddr     NetAddr;
-typedef struct sNetEndpoint NetEndpoint;
-typedef struct sNetHttp     NetHttp;
-typedef struct sNetHttpAuth NetHttpAuth;
-typedef struct sNetHttpEtag NetHttpEtag;
-typedef struct sNetSocket   NetSocket;
-typedef struct sNetStats    NetStats;
-typedef struct sNetTls      NetTls;
+typedef enum eNetDir         NetDir;
+typedef enum eNetHttpFlags   NetHttpFlags;
+typedef enum eNetResult      NetResult;
+typedef struct sNetAddr      NetAddr;
+typedef struct sNetEndpoint  NetEndpoint;
+typedef struct sNetHttp      NetHttp;
+typedef struct sNetHttpAuth  NetHttpAuth;
+typedef struct sNetHttpEtag  NetHttpEtag;
+typedef struct sNetRest      NetRest;
+typedef struct sNetSocket    NetSocket;
+typedef struct sNetStats     NetStats;
+typedef struct sNetTelemetry NetTelemetry;
+typedef struct sNetTls       NetTls;
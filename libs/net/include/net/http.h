@@ -66,6 +66,39 @@ NetResult net_http_head_sync(NetHttp*, String uri, const NetHttpAuth*, NetHttpEt
  */
 NetResult net_http_get_sync(NetHttp*, String uri, const NetHttpAuth*, NetHttpEtag*, DynString* out);
 
+/**
+ * Sink that http response body bytes are handed to as they arrive from the socket.
+ * Implementations embed this struct and can thus retrieve their own state from the sink pointer.
+ */
+typedef struct sNetHttpSink {
+  void (*write)(struct sNetHttpSink*, String data);
+} NetHttpSink;
+
+/**
+ * Synchonously perform a 'GET' request and stream the response body to the given sink.
+ * Body bytes are written to the sink as they arrive (in multiple calls) so the full body is never
+ * buffered in memory; useful for large downloads that go to a file for example.
+ * NOTE: Compressed bodies (gzip / deflate content-encoding) cannot be streamed as the decoder is
+ * one-shot; those are buffered, decoded and then written to the sink in a single call.
+ */
+NetResult
+net_http_get_sink_sync(NetHttp*, String uri, const NetHttpAuth*, NetHttpEtag*, NetHttpSink*);
+
+/**
+ * Synchonously perform a 'POST' request with the given body.
+ * Optional contentType / contentEncoding (pass empty to omit) are sent as the corresponding header
+ * fields; the caller is responsible for encoding the body to match the given content-encoding.
+ * NOTE: Response body is written to the output DynString.
+ */
+NetResult net_http_post_sync(
+    NetHttp*,
+    String uri,
+    const NetHttpAuth*,
+    String contentType,
+    String contentEncoding,
+    String body,
+    DynString* out);
+
 /**
  * Synchonously shutdown the Http connection.
  */
@@ -5,6 +5,9 @@ typedef u32 NetRestId;
 
 /**
  * Rest (REpresentational State Transfer) session.
+ * Requests are processed asynchronously by a pool of worker threads; workers keep their http
+ * connection open across requests (keep-alive) so repeated requests to the same host amortize the
+ * connection setup cost.
  */
 typedef struct sNetRest NetRest;
 
@@ -26,6 +29,20 @@ void net_rest_destroy(NetRest*);
 NetRestId net_rest_head(NetRest*, String host, String uri, const NetHttpAuth*, const NetHttpEtag*);
 NetRestId net_rest_get(NetRest*, String host, String uri, const NetHttpAuth*, const NetHttpEtag*);
 
+/**
+ * Start a new rest POST request; the body (and meta fields) are copied and can be released by the
+ * caller immediately. See 'net_http_post_sync()' for the contentType / contentEncoding semantics.
+ * NOTE: Requests need to be released using 'net_rest_release()'.
+ */
+NetRestId net_rest_post(
+    NetRest*,
+    String host,
+    String uri,
+    const NetHttpAuth*,
+    String contentType,
+    String contentEncoding,
+    String body);
+
 /**
  * Query request status.
  */
@@ -29,6 +29,14 @@ NetResult net_socket_status(const NetSocket*);
  */
 const NetEndpoint* net_socket_remote(const NetSocket*);
 
+/**
+ * Wait for the socket to become ready in the specified direction (in: data available to read,
+ * out: buffer space available to write).
+ * Returns 'NetResult_TryAgain' when the timeout expires before the socket becomes ready; a
+ * negative timeout waits indefinitely.
+ */
+NetResult net_socket_wait(NetSocket*, NetDir, TimeDuration timeout);
+
 /**
  * Synchronously write to the socket.
  */
@@ -7,6 +7,7 @@
 typedef struct sNetStats {
   u64 totalResolves, totalConnects;
   u64 totalBytesRead, totalBytesWrite;
+  u64 totalTlsSessions, totalTlsResumes;
 } NetStats;
 
 NetStats net_stats_query(void);
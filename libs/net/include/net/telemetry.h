@@ -0,0 +1,53 @@
+#pragma once
+#include "net/forward.h"
+
+/**
+ * Telemetry batcher.
+ * Accumulates small events and posts them to a rest endpoint in gzip-compressed batches, so many
+ * events share a single http request instead of each paying the full request overhead.
+ *
+ * Events are buffered until either enough data has accumulated or a flush interval has elapsed;
+ * batches are posted asynchronously by the rest session's worker threads. When the endpoint cannot
+ * keep up (all batch slots in-flight and the buffer at capacity) new events are dropped.
+ */
+typedef struct sNetTelemetry NetTelemetry;
+
+/**
+ * Create a telemetry batcher that posts batches to the given host / uri.
+ * The rest session has to out-live the telemetry batcher.
+ * Should be cleaned up using 'net_telemetry_destroy()'.
+ */
+NetTelemetry*
+net_telemetry_create(Allocator*, NetRest*, String host, String uri, const NetHttpAuth*);
+
+/**
+ * Destroy the given telemetry batcher.
+ * In-flight batches are waited on; pending events that have not been posted yet are discarded,
+ * call 'net_telemetry_flush()' before destroying to post them.
+ */
+void net_telemetry_destroy(NetTelemetry*);
+
+/**
+ * Queue a single telemetry event (arbitrary payload; a newline is appended as separator).
+ * Returns false when the event was dropped due to backpressure.
+ * NOTE: Thread-safe, can be called from any thread.
+ */
+bool net_telemetry_push(NetTelemetry*, String event);
+
+/**
+ * Post a batch when enough data has accumulated or the flush interval has elapsed; call
+ * periodically (for example once per frame). Also retires finished batches.
+ * NOTE: Api is not thread-safe, should be called from a single thread.
+ */
+void net_telemetry_update(NetTelemetry*);
+
+/**
+ * Post all pending events regardless of the batching thresholds.
+ * NOTE: Api is not thread-safe, should be called from a single thread.
+ */
+void net_telemetry_flush(NetTelemetry*);
+
+/**
+ * Query the total amount of events that were dropped due to backpressure.
+ */
+u64 net_telemetry_dropped(const NetTelemetry*);
@@ -172,7 +172,7 @@ static void http_request_header(
   fmt_write(out, "Accept: */*\r\n");
   fmt_write(out, "Accept-Encoding: gzip, deflate\r\n");
   fmt_write(out, "User-Agent: volo/1.0.0\r\n");
-  fmt_write(out, "\r\n");
+  // NOTE: Callers terminate the header (with an empty line) after appending any extra fields.
 }
 
 static void http_write_sync(NetHttp* http, const String data) {
@@ -357,6 +357,11 @@ static NetHttpView http_read_body(NetHttp* http, const NetHttpResponse* resp) {
   return http_set_err(http, NetResult_HttpUnsupportedTransferEncoding), http_view_empty();
 }
 
+/**
+ * Decode the response body content-encoding (gzip and deflate are supported, negotiated through
+ * the 'Accept-Encoding' request header). Decoding happens once the full body has been received;
+ * the inflate decoder is one-shot and cannot be suspended at arbitrary input boundaries.
+ */
 static void http_read_decode_body(
     NetHttp* http, const NetHttpResponse* resp, const NetHttpView body, DynString* out) {
 
@@ -429,6 +434,101 @@ Clear:
   mem_set(array_mem(out->data), 0);
 }
 
+/**
+ * Erase already consumed body bytes (everything after the given offset) from the read-buffer, so
+ * the buffered memory stays bounded to a single socket read while streaming a body to a sink.
+ * NOTE: Views into the buffer before the given offset (for example header fields) stay valid.
+ */
+static void http_read_compact(NetHttp* http, const usize offset) {
+  diag_assert(http->readCursor >= offset);
+  if (http->readCursor > offset) {
+    dynstring_erase_chars(&http->readBuffer, offset, http->readCursor - offset);
+    http->readCursor = offset;
+  }
+}
+
+/**
+ * Stream (a part of) the response body to the given sink, writing bytes out as they arrive from
+ * the socket instead of accumulating them in the read-buffer.
+ */
+static void http_read_stream_sized(NetHttp* http, const usize size, NetHttpSink* sink) {
+  const usize compactOffset = http->readCursor;
+  usize       remaining     = size;
+  while (remaining && http->status == NetResult_Success) {
+    const NetHttpView data = http_view_remaining(http);
+    if (!data.size) {
+      http_read_sync(http);
+      continue;
+    }
+    const usize take = math_min(data.size, remaining);
+    sink->write(sink, string_slice(http_view_str(http, data), 0, take));
+    http->readCursor += take;
+    remaining -= take;
+    http_read_compact(http, compactOffset);
+  }
+}
+
+static void http_read_body_sink(NetHttp* http, const NetHttpResponse* resp, NetHttpSink* sink) {
+  /**
+   * Compressed bodies cannot be streamed (the inflate decoder is one-shot, see
+   * 'http_read_decode_body()'); buffer, decode and hand the result to the sink in a single write.
+   */
+  const String identityStr     = string_lit("identity");
+  const bool   identityContent = !resp->contentEncoding.size ||
+                               http_view_eq_loose(http, resp->contentEncoding, identityStr);
+  if (!identityContent) {
+    const NetHttpView body = http_read_body(http, resp);
+    if (body.size && http->status == NetResult_Success) {
+      DynString decodeBuffer = dynstring_create(http->alloc, 64 * usize_kibibyte);
+      http_read_decode_body(http, resp, body, &decodeBuffer);
+      if (http->status == NetResult_Success) {
+        sink->write(sink, dynstring_view(&decodeBuffer));
+      }
+      dynstring_destroy(&decodeBuffer);
+    }
+    return;
+  }
+  const bool identityTransfer = !resp->transferEncoding.size ||
+                                http_view_eq_loose(http, resp->transferEncoding, identityStr);
+  if (identityTransfer) {
+    http_read_stream_sized(http, resp->contentLength, sink);
+    return;
+  }
+  if (http_view_eq_loose(http, resp->transferEncoding, string_lit("chunked"))) {
+    const usize compactOffset = http->readCursor;
+    for (;;) {
+      const u64 chunkSize = http_read_integer(http, 16 /* base */);
+      if (sentinel_check(chunkSize)) {
+        http_set_err(http, NetResult_HttpMalformedChunk);
+        return;
+      }
+      if (!chunkSize) {
+        // End of chunked data; skip over chunk comment and potentially trailing headers.
+        http_read_until(http, string_lit("\r\n\r\n"));
+        http_read_compact(http, compactOffset);
+        return;
+      }
+      http_read_until(http, string_lit("\r\n")); // Skip over chunk comment.
+      if (http->status != NetResult_Success) {
+        http_set_err(http, NetResult_HttpMalformedChunk);
+        return;
+      }
+      http_read_compact(http, compactOffset);
+      http_read_stream_sized(http, chunkSize, sink);
+      if (!http_read_match(http, string_lit("\r\n"))) {
+        http_set_err(http, NetResult_HttpMalformedChunk);
+        return;
+      }
+      http_read_compact(http, compactOffset);
+      if (http->status != NetResult_Success) {
+        return;
+      }
+    }
+    UNREACHABLE
+  }
+  http_set_err(http, NetResult_HttpUnsupportedTransferEncoding);
+}
+
 static void http_read_end(NetHttp* http) {
   if (http->readBuffer.size != http->readCursor) {
     http_set_err(http, NetResult_HttpUnexpectedData);
@@ -452,7 +552,7 @@ NetHttp* net_http_connect_sync(Allocator* alloc, const String host, const NetHtt
   NetAddr hostAddrs[32];
   u32     hostAddrCount = array_elems(hostAddrs);
 
-  http->status = net_resolve_sync(host, hostAddrs, &hostAddrCount);
+  http->status = net_resolve_cached(host, hostAddrs, &hostAddrCount);
   if (http->status != NetResult_Success) {
     const TimeDuration resolveDur = time_steady_duration(resolveStart, time_steady_clock());
     log_w(
@@ -543,6 +643,7 @@ net_http_head_sync(NetHttp* http, const String uri, const NetHttpAuth* auth, Net
 
   DynString headerBuffer = dynstring_create(g_allocScratch, 4 * usize_kibibyte);
   http_request_header(http, string_lit("HEAD"), uriOrRoot, auth, etag, &headerBuffer);
+  fmt_write(&headerBuffer, "\r\n");
 
   log_d(
       "Http: Sending HEAD",
@@ -590,16 +691,14 @@ net_http_head_sync(NetHttp* http, const String uri, const NetHttpAuth* auth, Net
   return http->status ? http->status : http_status_result(resp.status);
 }
 
-NetResult net_http_get_sync(
-    NetHttp* http, const String uri, const NetHttpAuth* auth, NetHttpEtag* etag, DynString* out) {
-  if (http->status != NetResult_Success) {
-    return http->status;
-  }
+static NetHttpResponse http_get_request_sync(
+    NetHttp* http, const String uri, const NetHttpAuth* auth, NetHttpEtag* etag) {
   const TimeSteady startTime = time_steady_clock();
   const String     uriOrRoot = string_is_empty(uri) ? string_lit("/") : uri;
 
   DynString headerBuffer = dynstring_create(g_allocScratch, 4 * usize_kibibyte);
   http_request_header(http, string_lit("GET"), uriOrRoot, auth, etag, &headerBuffer);
+  fmt_write(&headerBuffer, "\r\n");
 
   log_d(
       "Http: Sending GET",
@@ -608,13 +707,13 @@ NetResult net_http_get_sync(
 
   http_write_sync(http, dynstring_view(&headerBuffer));
   if (http->status != NetResult_Success) {
-    return http->status;
+    return (NetHttpResponse){0};
   }
 
   const NetHttpResponse resp    = http_read_response(http);
   const TimeDuration    respDur = time_steady_duration(startTime, time_steady_clock());
   if (http->status != NetResult_Success) {
-    return http->status;
+    return resp;
   }
 
 #ifndef VOLO_RELEASE
@@ -646,6 +745,19 @@ NetResult net_http_get_sync(
   if (etag) {
     http_read_decode_etag(http, &resp, etag);
   }
+  return resp;
+}
+
+NetResult net_http_get_sync(
+    NetHttp* http, const String uri, const NetHttpAuth* auth, NetHttpEtag* etag, DynString* out) {
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+  const TimeSteady      startTime = time_steady_clock();
+  const NetHttpResponse resp      = http_get_request_sync(http, uri, auth, etag);
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
 
   const NetHttpView  body    = http_read_body(http, &resp);
   const TimeDuration bodyDur = time_steady_duration(startTime, time_steady_clock());
@@ -666,6 +778,127 @@ NetResult net_http_get_sync(
   return http->status ? http->status : http_status_result(resp.status);
 }
 
+NetResult net_http_get_sink_sync(
+    NetHttp*           http,
+    const String       uri,
+    const NetHttpAuth* auth,
+    NetHttpEtag*       etag,
+    NetHttpSink*       sink) {
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+  const TimeSteady      startTime = time_steady_clock();
+  const NetHttpResponse resp      = http_get_request_sync(http, uri, auth, etag);
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+
+  http_read_body_sink(http, &resp, sink);
+  const TimeDuration bodyDur = time_steady_duration(startTime, time_steady_clock());
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+  (void)bodyDur;
+  log_d("Http: Received GET body", log_param("duration", fmt_duration(bodyDur)));
+
+  http_read_end(http); // Releases reading resources, do not access response data after this.
+  return http->status ? http->status : http_status_result(resp.status);
+}
+
+static NetHttpResponse net_http_post_request_sync(
+    NetHttp*           http,
+    const String       uri,
+    const NetHttpAuth* auth,
+    const String       contentType,
+    const String       contentEncoding,
+    const String       body) {
+  const TimeSteady startTime = time_steady_clock();
+  const String     uriOrRoot = string_is_empty(uri) ? string_lit("/") : uri;
+
+  DynString headerBuffer = dynstring_create(g_allocScratch, 4 * usize_kibibyte);
+  http_request_header(http, string_lit("POST"), uriOrRoot, auth, null /* etag */, &headerBuffer);
+  if (!string_is_empty(contentType)) {
+    fmt_write(&headerBuffer, "Content-Type: {}\r\n", fmt_text(contentType));
+  }
+  if (!string_is_empty(contentEncoding)) {
+    fmt_write(&headerBuffer, "Content-Encoding: {}\r\n", fmt_text(contentEncoding));
+  }
+  fmt_write(&headerBuffer, "Content-Length: {}\r\n", fmt_int(body.size));
+  fmt_write(&headerBuffer, "\r\n");
+
+  log_d(
+      "Http: Sending POST",
+      log_param("host", fmt_text(http->host)),
+      log_param("uri", fmt_text(uriOrRoot)),
+      log_param("size", fmt_size(body.size)));
+
+  http_write_sync(http, dynstring_view(&headerBuffer));
+  if (http->status != NetResult_Success) {
+    return (NetHttpResponse){0};
+  }
+  http_write_sync(http, body);
+  if (http->status != NetResult_Success) {
+    return (NetHttpResponse){0};
+  }
+
+  const NetHttpResponse resp    = http_read_response(http);
+  const TimeDuration    respDur = time_steady_duration(startTime, time_steady_clock());
+  if (http->status != NetResult_Success) {
+    return resp;
+  }
+
+#ifndef VOLO_RELEASE
+  {
+    const String lReason = http_view_str_trim_or(http, resp.reason, string_lit("unknown"));
+    const String lType   = http_view_str_trim_or(http, resp.contentType, string_lit("unknown"));
+    const String lServer = http_view_str_trim_or(http, resp.server, string_lit("unknown"));
+    const String lVia    = http_view_str_trim_or(http, resp.via, string_lit("unknown"));
+    log_d(
+        "Http: Received POST response",
+        log_param("status", fmt_int(resp.status)),
+        log_param("reason", fmt_text(lReason)),
+        log_param("duration", fmt_duration(respDur)),
+        log_param("content-type", fmt_text(lType)),
+        log_param("server", fmt_text(lServer)),
+        log_param("via", fmt_text(lVia)));
+  }
+#else
+  (void)respDur;
+#endif
+
+  return resp;
+}
+
+NetResult net_http_post_sync(
+    NetHttp*           http,
+    const String       uri,
+    const NetHttpAuth* auth,
+    const String       contentType,
+    const String       contentEncoding,
+    const String       body,
+    DynString*         out) {
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+  const NetHttpResponse resp =
+      net_http_post_request_sync(http, uri, auth, contentType, contentEncoding, body);
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+
+  const NetHttpView respBody = http_read_body(http, &resp);
+  if (http->status != NetResult_Success) {
+    return http->status;
+  }
+
+  if (respBody.size && http->status == NetResult_Success) {
+    http_read_decode_body(http, &resp, respBody, out);
+  }
+
+  http_read_end(http); // Releases reading resources, do not access response data after this.
+  return http->status ? http->status : http_status_result(resp.status);
+}
+
 NetResult net_http_shutdown_sync(NetHttp* http) {
   log_d("Http: Shutdown");
 
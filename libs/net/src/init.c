@@ -1,8 +1,10 @@
 #include "core/diag.h"
+#include "core/init.h"
 #include "core/thread.h"
 #include "net/init.h"
 
 #include "pal.h"
+#include "resolve.h"
 #include "tls.h"
 
 static bool g_initalized;
@@ -13,8 +15,11 @@ void net_init(void) {
   if (!g_initalized) {
     g_initalized = true;
 
+    core_init_phase_begin(string_lit("net"));
     net_pal_init();
-    net_tls_init();
+    net_resolve_init();
+    // NOTE: The tls subsystem is initialized lazily on first use (see 'net_tls_init_lazy').
+    core_init_phase_end();
   }
 }
 
@@ -24,7 +29,9 @@ void net_teardown(void) {
   if (g_initalized) {
     g_initalized = false;
 
+    net_resolve_teardown();
     net_pal_teardown();
-    net_tls_teardown();
+    net_tls_teardown(); // NOTE: Safe even when the lazy tls init never ran.
+    g_netTlsLazyInitDone = false;
   }
 }
@@ -4,6 +4,7 @@
 #include "core/dynstring.h"
 #include "core/string.h"
 #include "core/thread.h"
+#include "core/time.h"
 #include "net/addr.h"
 #include "net/result.h"
 #include "net/socket.h"
@@ -16,6 +17,7 @@
 #include <net/if.h>
 #include <netdb.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -186,6 +188,43 @@ NetResult net_socket_status(const NetSocket* s) {
 
 const NetEndpoint* net_socket_remote(const NetSocket* s) { return &s->remoteEndpoint; }
 
+NetResult net_socket_wait(NetSocket* s, const NetDir dir, const TimeDuration timeout) {
+  if (s->status != NetResult_Success) {
+    return s->status;
+  }
+  if ((s->closedMask & dir) == dir) {
+    return NetResult_ConnectionClosed;
+  }
+  diag_assert(s->handle >= 0);
+
+  struct pollfd pollFd = {.fd = s->handle};
+  if (dir & NetDir_In) {
+    pollFd.events |= POLLIN;
+  }
+  if (dir & NetDir_Out) {
+    pollFd.events |= POLLOUT;
+  }
+  const int timeoutMillis = timeout < 0 ? -1 : (int)(timeout / time_millisecond);
+  for (;;) {
+    const int res = poll(&pollFd, 1, timeoutMillis);
+    if (res > 0) {
+      if (pollFd.revents & (POLLERR | POLLNVAL)) {
+        return s->status = NetResult_UnknownError;
+      }
+      // NOTE: A hangup also counts as ready; the following read will observe the close.
+      return NetResult_Success;
+    }
+    if (res == 0) {
+      return NetResult_TryAgain; // Timeout expired.
+    }
+    switch (errno) {
+    case EINTR:
+      continue; // Retry on interrupt.
+    }
+    return s->status = net_pal_socket_error(errno);
+  }
+}
+
 NetResult net_socket_write_sync(NetSocket* s, const String data) {
   if (s->status != NetResult_Success) {
     return s->status;
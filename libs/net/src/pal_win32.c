@@ -4,6 +4,7 @@
 #include "core/dynlib.h"
 #include "core/dynstring.h"
 #include "core/thread.h"
+#include "core/time.h"
 #include "core/winutils.h"
 #include "log/logger.h"
 #include "net/addr.h"
@@ -30,6 +31,7 @@ typedef struct {
   int    (SYS_DECL* connect)(SOCKET, const void* addr, int addrLen);
   int    (SYS_DECL* send)(SOCKET, const void* buf, int len, int flags);
   int    (SYS_DECL* recv)(SOCKET, void* buf, int len, int flags);
+  int    (SYS_DECL* WSAPoll)(WSAPOLLFD* fdArray, ULONG fds, INT timeout);
   int    (SYS_DECL* shutdown)(SOCKET, int how);
   int    (SYS_DECL* GetAddrInfoW)(const wchar_t* nodeName, const wchar_t* serviceName, const ADDRINFOW* hints, ADDRINFOW** out);
   void   (SYS_DECL* FreeAddrInfoW)(ADDRINFOW*);
@@ -72,6 +74,7 @@ static bool net_ws_init(NetWinSock* ws, Allocator* alloc) {
   WS_LOAD_SYM(connect);
   WS_LOAD_SYM(send);
   WS_LOAD_SYM(recv);
+  WS_LOAD_SYM(WSAPoll);
   WS_LOAD_SYM(shutdown);
   WS_LOAD_SYM(GetAddrInfoW);
   WS_LOAD_SYM(FreeAddrInfoW);
@@ -320,6 +323,37 @@ NetResult net_socket_status(const NetSocket* s) {
 
 const NetEndpoint* net_socket_remote(const NetSocket* s) { return &s->remoteEndpoint; }
 
+NetResult net_socket_wait(NetSocket* s, const NetDir dir, const TimeDuration timeout) {
+  if (s->status != NetResult_Success) {
+    return s->status;
+  }
+  if ((s->closedMask & dir) == dir) {
+    return NetResult_ConnectionClosed;
+  }
+  diag_assert(s->handle != INVALID_SOCKET);
+
+  WSAPOLLFD pollFd = {.fd = s->handle};
+  if (dir & NetDir_In) {
+    pollFd.events |= POLLRDNORM;
+  }
+  if (dir & NetDir_Out) {
+    pollFd.events |= POLLWRNORM;
+  }
+  const INT timeoutMillis = timeout < 0 ? -1 : (INT)(timeout / time_millisecond);
+  const int res           = g_netWsLib.WSAPoll(&pollFd, 1, timeoutMillis);
+  if (res > 0) {
+    if (pollFd.revents & (POLLERR | POLLNVAL)) {
+      return s->status = NetResult_UnknownError;
+    }
+    // NOTE: A hangup also counts as ready; the following read will observe the close.
+    return NetResult_Success;
+  }
+  if (res == 0) {
+    return NetResult_TryAgain; // Timeout expired.
+  }
+  return s->status = net_pal_socket_error();
+}
+
 NetResult net_socket_write_sync(NetSocket* s, const String data) {
   if (s->status != NetResult_Success) {
     return s->status;
@@ -0,0 +1,240 @@
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/math.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "net/addr.h"
+#include "net/result.h"
+
+#include "resolve.h"
+
+/**
+ * In-process resolution cache.
+ *
+ * Resolved addresses are cached for a fixed interval; the platform resolvers do not expose the
+ * record TTLs so a conservative fixed interval is used instead. Entries past half their interval
+ * are refreshed in the background (by a lazily started low-priority thread) while the cached
+ * addresses keep being served, so repeated connects to the same host do not stall on the resolver.
+ */
+
+#define net_resolve_cache_max 64
+#define net_resolve_queue_max 16
+#define net_resolve_addrs_max 8
+#define net_resolve_cache_interval time_minutes(5)
+#define net_resolve_refresh_age (net_resolve_cache_interval / 2)
+
+typedef struct {
+  StringHash hostHash;
+  String     host; // Duplicated in the heap; needed for background refreshes.
+  u32        addrCount;
+  NetAddr    addrs[net_resolve_addrs_max];
+  TimeSteady resolveTime;
+  bool       refreshPending; // Entry is queued for a background refresh.
+} NetResolveEntry;
+
+static bool            g_resolveInitialized;
+static ThreadMutex     g_resolveMutex;
+static ThreadCondition g_resolveWakeCondition;
+static NetResolveEntry g_resolveEntries[net_resolve_cache_max];
+static u32             g_resolveEntryCount;
+static u32             g_resolveQueue[net_resolve_queue_max]; // Entry indices to refresh.
+static u32             g_resolveQueueCount;
+static ThreadHandle    g_resolveThread;
+static bool            g_resolveThreadStarted;
+static bool            g_resolveShutdown;
+
+static void resolve_thread(void*);
+
+/**
+ * Find the cache entry for the given host, or null when its not cached.
+ * Pre-condition: g_resolveMutex is held.
+ */
+static NetResolveEntry* resolve_entry_find(const StringHash hostHash) {
+  for (u32 i = 0; i != g_resolveEntryCount; ++i) {
+    if (g_resolveEntries[i].hostHash == hostHash) {
+      return &g_resolveEntries[i];
+    }
+  }
+  return null;
+}
+
+/**
+ * Acquire a cache entry for the given host, evicting the oldest entry when the cache is full.
+ * Pre-condition: g_resolveMutex is held.
+ */
+static NetResolveEntry* resolve_entry_acquire(const StringHash hostHash, const String host) {
+  NetResolveEntry* entry = resolve_entry_find(hostHash);
+  if (entry) {
+    return entry;
+  }
+  if (g_resolveEntryCount != net_resolve_cache_max) {
+    entry = &g_resolveEntries[g_resolveEntryCount++];
+  } else {
+    // Cache is full; evict the oldest entry (skipping entries that are queued for refresh as the
+    // refresh queue refers to entries by index).
+    for (u32 i = 0; i != g_resolveEntryCount; ++i) {
+      if (g_resolveEntries[i].refreshPending) {
+        continue;
+      }
+      if (!entry || g_resolveEntries[i].resolveTime < entry->resolveTime) {
+        entry = &g_resolveEntries[i];
+      }
+    }
+    diag_assert(entry); // Cannot fail: the refresh queue is smaller then the cache.
+    string_maybe_free(g_allocHeap, entry->host);
+  }
+  *entry = (NetResolveEntry){
+      .hostHash = hostHash,
+      .host     = string_dup(g_allocHeap, host),
+  };
+  return entry;
+}
+
+/**
+ * Queue the given entry for a background refresh.
+ * Pre-condition: g_resolveMutex is held.
+ */
+static void resolve_entry_queue_refresh(NetResolveEntry* entry) {
+  if (entry->refreshPending || g_resolveQueueCount == net_resolve_queue_max) {
+    return; // Already queued (or the queue is full; will be retried on a later lookup).
+  }
+  entry->refreshPending                 = true;
+  g_resolveQueue[g_resolveQueueCount++] = (u32)(entry - g_resolveEntries);
+  if (!g_resolveThreadStarted) {
+    g_resolveThreadStarted = true;
+    g_resolveThread =
+        thread_start(resolve_thread, null, string_lit("volo_resolve"), ThreadPriority_Low);
+  }
+  thread_cond_signal(g_resolveWakeCondition);
+}
+
+static void resolve_thread(void* data) {
+  (void)data;
+  thread_mutex_lock(g_resolveMutex);
+  while (!g_resolveShutdown) {
+    if (!g_resolveQueueCount) {
+      thread_cond_wait(g_resolveWakeCondition, g_resolveMutex);
+      continue;
+    }
+    NetResolveEntry* entry    = &g_resolveEntries[g_resolveQueue[--g_resolveQueueCount]];
+    const StringHash hostHash = entry->hostHash;
+    const String     host     = string_dup(g_allocScratch, entry->host);
+    thread_mutex_unlock(g_resolveMutex);
+
+    NetAddr         addrs[net_resolve_addrs_max];
+    u32             addrCount = array_elems(addrs);
+    const NetResult result    = net_resolve_sync(host, addrs, &addrCount);
+
+    thread_mutex_lock(g_resolveMutex);
+    if (entry->hostHash == hostHash) { // Guard against the entry being evicted in the meantime.
+      if (result == NetResult_Success && addrCount) {
+        entry->addrCount = addrCount;
+        mem_cpy(array_mem(entry->addrs), array_mem(addrs));
+      } else {
+        // Refresh failed; keep serving the stale addresses and retry after another interval.
+        log_d(
+            "Net: Background resolve failed",
+            log_param("error", fmt_text(net_result_str(result))),
+            log_param("host", fmt_text(host)));
+      }
+      entry->resolveTime    = time_steady_clock();
+      entry->refreshPending = false;
+    }
+  }
+  thread_mutex_unlock(g_resolveMutex);
+}
+
+void net_resolve_init(void) {
+  g_resolveMutex         = thread_mutex_create(g_allocPersist);
+  g_resolveWakeCondition = thread_cond_create(g_allocPersist);
+  g_resolveInitialized   = true;
+}
+
+void net_resolve_teardown(void) {
+  g_resolveInitialized = false;
+
+  thread_mutex_lock(g_resolveMutex);
+  g_resolveShutdown = true;
+  thread_cond_broadcast(g_resolveWakeCondition);
+  thread_mutex_unlock(g_resolveMutex);
+
+  if (g_resolveThreadStarted) {
+    thread_join(g_resolveThread);
+    g_resolveThreadStarted = false;
+  }
+  for (u32 i = 0; i != g_resolveEntryCount; ++i) {
+    string_maybe_free(g_allocHeap, g_resolveEntries[i].host);
+  }
+  g_resolveEntryCount = 0;
+  g_resolveQueueCount = 0;
+  g_resolveShutdown   = false;
+
+  thread_mutex_destroy(g_resolveMutex);
+  thread_cond_destroy(g_resolveWakeCondition);
+}
+
+NetResult net_resolve_cached(const String host, NetAddr out[], u32* count) {
+  if (UNLIKELY(!g_resolveInitialized)) {
+    diag_crash_msg("Network subsystem not initialized");
+  }
+  const u32 countMax = *count;
+  if (UNLIKELY(string_is_empty(host))) {
+    *count = 0;
+    return NetResult_InvalidHost;
+  }
+  const StringHash hostHash = string_hash(host);
+  const TimeSteady now      = time_steady_clock();
+
+  thread_mutex_lock(g_resolveMutex);
+  NetResolveEntry* entry = resolve_entry_find(hostHash);
+  if (entry && entry->addrCount && (now - entry->resolveTime) < net_resolve_cache_interval) {
+    *count = math_min(countMax, entry->addrCount);
+    mem_cpy(
+        mem_create(out, sizeof(NetAddr) * *count),
+        mem_create(entry->addrs, sizeof(NetAddr) * *count));
+    if ((now - entry->resolveTime) >= net_resolve_refresh_age) {
+      resolve_entry_queue_refresh(entry); // Entry is aging; refresh it in the background.
+    }
+    thread_mutex_unlock(g_resolveMutex);
+    return NetResult_Success;
+  }
+  thread_mutex_unlock(g_resolveMutex);
+
+  // Not cached (or expired); resolve synchronously.
+  *count                 = countMax;
+  const NetResult result = net_resolve_sync(host, out, count);
+  if (result != NetResult_Success || !*count) {
+    return result; // NOTE: Failures are not cached; the next lookup retries.
+  }
+
+  thread_mutex_lock(g_resolveMutex);
+  entry              = resolve_entry_acquire(hostHash, host);
+  entry->addrCount   = math_min(*count, (u32)net_resolve_addrs_max);
+  entry->resolveTime = now;
+  mem_cpy(array_mem(entry->addrs), mem_create(out, sizeof(NetAddr) * entry->addrCount));
+  thread_mutex_unlock(g_resolveMutex);
+
+  return result;
+}
+
+void net_resolve_prefetch(const String host) {
+  if (UNLIKELY(!g_resolveInitialized)) {
+    diag_crash_msg("Network subsystem not initialized");
+  }
+  if (UNLIKELY(string_is_empty(host))) {
+    return;
+  }
+  const StringHash hostHash = string_hash(host);
+  const TimeSteady now      = time_steady_clock();
+
+  thread_mutex_lock(g_resolveMutex);
+  NetResolveEntry* entry = resolve_entry_find(hostHash);
+  if (entry && entry->addrCount && (now - entry->resolveTime) < net_resolve_refresh_age) {
+    thread_mutex_unlock(g_resolveMutex);
+    return; // Entry is still fresh.
+  }
+  resolve_entry_queue_refresh(resolve_entry_acquire(hostHash, host));
+  thread_mutex_unlock(g_resolveMutex);
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void net_resolve_init(void);
+void net_resolve_teardown(void);
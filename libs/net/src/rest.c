@@ -5,10 +5,24 @@
 #include "core/math.h"
 #include "core/thread.h"
 #include "core/time.h"
+#include "net/addr.h"
 #include "net/http.h"
 #include "net/rest.h"
 #include "net/result.h"
 
+/**
+ * Rest session: a pool of low-priority worker threads that process queued requests. Workers keep
+ * their http connection open across requests (keep-alive) and prefer work for the host they are
+ * already connected to, so batches of requests to the same host amortize the tcp (+ tls) setup.
+ */
+
+enum { rest_max_tries = 3 };
+
+static const TimeDuration g_restRetryDelay[rest_max_tries] = {
+    [1] = time_milliseconds(500),
+    [2] = time_second,
+};
+
 typedef enum {
   NetRestState_Idle,
   NetRestState_Acquired,
@@ -20,6 +34,7 @@ typedef enum {
 typedef enum {
   NetRestType_Head, // Http HEAD request.
   NetRestType_Get,  // Http GET request.
+  NetRestType_Post, // Http POST request.
 } NetRestType;
 
 typedef struct {
@@ -27,9 +42,13 @@ typedef struct {
   NetRestType  type;
   NetResult    result;
   u16          generation;
+  u16          tryIndex;
+  TimeSteady   retryTime; // Timestamp before which the request should not be (re)tried.
   String       host, uri;
   NetHttpAuth  auth;
   NetHttpEtag  etag;
+  String       contentType, contentEncoding; // Only used for POST requests.
+  String       body;                         // Only used for POST requests.
   DynString    buffer;
 } NetRestRequest;
 
@@ -104,21 +123,25 @@ static NetRestId rest_request_acquire(NetRest* rest) {
   return rest_id_invalid();
 }
 
-static NetRestRequest* rest_worker_take_any(NetRest* rest) {
+static NetRestRequest* rest_worker_take_any(NetRest* rest, const TimeSteady now) {
   for (u16 i = 0; i != rest->requestCount; ++i) {
     NetRestRequest* req = &rest->requests[i];
     if (rest_request_state_transition(req, NetRestState_Ready, NetRestState_Busy)) {
-      return req;
+      if (req->retryTime <= now) {
+        return req;
+      }
+      rest_request_state_store(req, NetRestState_Ready); // Not due for retry yet.
     }
   }
   return null; // No work found.
 }
 
-static NetRestRequest* rest_worker_take_for_host(NetRest* rest, const String host) {
+static NetRestRequest*
+rest_worker_take_for_host(NetRest* rest, const String host, const TimeSteady now) {
   for (u16 i = 0; i != rest->requestCount; ++i) {
     NetRestRequest* req = &rest->requests[i];
     if (rest_request_state_transition(req, NetRestState_Ready, NetRestState_Busy)) {
-      if (string_eq(req->host, host)) {
+      if (req->retryTime <= now && string_eq(req->host, host)) {
         return req;
       }
       rest_request_state_store(req, NetRestState_Ready);
@@ -127,6 +150,25 @@ static NetRestRequest* rest_worker_take_for_host(NetRest* rest, const String hos
   return null; // No work found.
 }
 
+/**
+ * Compute how long a worker can sleep before deferred work (a pending retry) needs attention.
+ * Returns 0 when there is no deferred work.
+ */
+static TimeDuration rest_worker_sleep_max(NetRest* rest, const TimeSteady now) {
+  TimeDuration res = 0;
+  for (u16 i = 0; i != rest->requestCount; ++i) {
+    NetRestRequest* req = &rest->requests[i];
+    if (rest_request_state_load(req) != NetRestState_Ready) {
+      continue;
+    }
+    const TimeDuration wait = math_max(time_millisecond, req->retryTime - now);
+    if (!res || wait < res) {
+      res = wait;
+    }
+  }
+  return res;
+}
+
 static bool rest_worker_should_retry(const NetResult result) {
   switch (result) {
   // Valid results.
@@ -159,32 +201,23 @@ static bool rest_worker_should_retry(const NetResult result) {
 static void rest_worker_thread(void* data) {
   NetRest* rest = data;
 
-  enum { MaxTries = 3 };
-  const TimeDuration retrySleep[MaxTries] = {
-      [1] = time_milliseconds(500),
-      [2] = time_second,
-  };
-
-  NetHttp*     con            = null;
-  TimeDuration conLastReqTime = 0;
+  NetHttp*   con            = null;
+  TimeSteady conLastReqTime = 0;
 
   while (!rest->workerShutdown) {
-    NetRestRequest* req         = null;
-    u32             reqTryIndex = 0;
+    const TimeSteady now = time_steady_clock();
+
+    NetRestRequest* req = null;
     if (con) {
-      req = rest_worker_take_for_host(rest, net_http_remote_name(con));
+      req = rest_worker_take_for_host(rest, net_http_remote_name(con), now);
     }
     if (!req) {
-      req = rest_worker_take_any(rest);
+      req = rest_worker_take_any(rest, now);
     }
     if (!req) {
       goto Sleep;
     }
 
-  Retry:
-    if (rest->workerShutdown) {
-      break;
-    }
     if (con && net_http_status(con) != NetResult_Success) {
       net_http_shutdown_sync(con);
       net_http_destroy(con);
@@ -195,14 +228,6 @@ static void rest_worker_thread(void* data) {
       net_http_destroy(con);
       con = null;
     }
-    if (retrySleep[reqTryIndex]) {
-      // TODO: Instead of sleeping the worker we should put the request back and process it after
-      // the retry time has expired. That way other requests are not blocked.
-      thread_sleep(retrySleep[reqTryIndex]);
-    }
-    if (rest->workerShutdown) {
-      break;
-    }
     if (!con) {
       con = net_http_connect_sync(g_allocHeap, req->host, rest->httpFlags);
     }
@@ -215,11 +240,25 @@ static void rest_worker_thread(void* data) {
     case NetRestType_Get:
       req->result = net_http_get_sync(con, req->uri, &req->auth, &req->etag, &req->buffer);
       break;
+    case NetRestType_Post:
+      req->result = net_http_post_sync(
+          con,
+          req->uri,
+          &req->auth,
+          req->contentType,
+          req->contentEncoding,
+          req->body,
+          &req->buffer);
+      break;
     }
 
-    if (rest_worker_should_retry(req->result) && reqTryIndex < (MaxTries - 1)) {
-      ++reqTryIndex;
-      goto Retry;
+    if (rest_worker_should_retry(req->result) && req->tryIndex < (rest_max_tries - 1)) {
+      // Defer the retry instead of sleeping the worker; this way other requests are not blocked
+      // while the retry delay expires.
+      ++req->tryIndex;
+      req->retryTime = time_steady_clock() + g_restRetryDelay[req->tryIndex];
+      rest_request_state_store(req, NetRestState_Ready);
+      continue;
     }
     rest_request_state_store(req, NetRestState_Finished);
     continue; // Process the next request.
@@ -233,8 +272,13 @@ static void rest_worker_thread(void* data) {
     }
     thread_mutex_lock(rest->workerMutex);
     if (!rest->workerShutdown) {
+      TimeDuration waitMax = rest_worker_sleep_max(rest, time_steady_clock());
       if (con) {
-        thread_cond_wait_timeout(rest->workerWakeCondition, rest->workerMutex, time_seconds(10));
+        // Periodically wake up to close the connection when it stays inactive.
+        waitMax = waitMax ? math_min(waitMax, time_seconds(10)) : time_seconds(10);
+      }
+      if (waitMax) {
+        thread_cond_wait_timeout(rest->workerWakeCondition, rest->workerMutex, waitMax);
       } else {
         thread_cond_wait(rest->workerWakeCondition, rest->workerMutex);
       }
@@ -307,6 +351,9 @@ void net_rest_destroy(NetRest* rest) {
     string_maybe_free(g_allocHeap, req->host);
     string_maybe_free(g_allocHeap, req->uri);
     net_http_auth_free(&req->auth, g_allocHeap);
+    string_maybe_free(g_allocHeap, req->contentType);
+    string_maybe_free(g_allocHeap, req->contentEncoding);
+    string_maybe_free(g_allocHeap, req->body);
     dynstring_destroy(&req->buffer);
   }
   alloc_free_array_t(rest->alloc, rest->requests, rest->requestCount);
@@ -322,6 +369,9 @@ NetRestId net_rest_head(
     const NetHttpEtag* etag) {
   diag_assert(!string_is_empty(host));
 
+  // Begin resolving the host in the background while the request waits for a worker.
+  net_resolve_prefetch(host);
+
   const NetRestId id = rest_request_acquire(rest);
   if (!rest_id_valid(id)) {
     return id; // No free request slots.
@@ -329,11 +379,13 @@ NetRestId net_rest_head(
   NetRestRequest* req = rest_request_get(rest, id);
   diag_assert(req);
 
-  req->type = NetRestType_Head;
-  req->host = string_maybe_dup(g_allocHeap, host);
-  req->uri  = string_maybe_dup(g_allocHeap, uri);
-  req->auth = auth ? net_http_auth_clone(auth, g_allocHeap) : (NetHttpAuth){0};
-  req->etag = etag ? *etag : (NetHttpEtag){0};
+  req->type      = NetRestType_Head;
+  req->tryIndex  = 0;
+  req->retryTime = 0;
+  req->host      = string_maybe_dup(g_allocHeap, host);
+  req->uri       = string_maybe_dup(g_allocHeap, uri);
+  req->auth      = auth ? net_http_auth_clone(auth, g_allocHeap) : (NetHttpAuth){0};
+  req->etag      = etag ? *etag : (NetHttpEtag){0};
 
   rest_request_state_store(req, NetRestState_Ready);
   rest_wake_worker_single(rest);
@@ -349,6 +401,43 @@ NetRestId net_rest_get(
     const NetHttpEtag* etag) {
   diag_assert(!string_is_empty(host));
 
+  // Begin resolving the host in the background while the request waits for a worker.
+  net_resolve_prefetch(host);
+
+  const NetRestId id = rest_request_acquire(rest);
+  if (!rest_id_valid(id)) {
+    return id; // No free request slots.
+  }
+  NetRestRequest* req = rest_request_get(rest, id);
+  diag_assert(req);
+
+  req->type      = NetRestType_Get;
+  req->tryIndex  = 0;
+  req->retryTime = 0;
+  req->host      = string_maybe_dup(g_allocHeap, host);
+  req->uri       = string_maybe_dup(g_allocHeap, uri);
+  req->auth      = auth ? net_http_auth_clone(auth, g_allocHeap) : (NetHttpAuth){0};
+  req->etag      = etag ? *etag : (NetHttpEtag){0};
+
+  rest_request_state_store(req, NetRestState_Ready);
+  rest_wake_worker_single(rest);
+
+  return id;
+}
+
+NetRestId net_rest_post(
+    NetRest*           rest,
+    const String       host,
+    const String       uri,
+    const NetHttpAuth* auth,
+    const String       contentType,
+    const String       contentEncoding,
+    const String       body) {
+  diag_assert(!string_is_empty(host));
+
+  // Begin resolving the host in the background while the request waits for a worker.
+  net_resolve_prefetch(host);
+
   const NetRestId id = rest_request_acquire(rest);
   if (!rest_id_valid(id)) {
     return id; // No free request slots.
@@ -356,11 +445,16 @@ NetRestId net_rest_get(
   NetRestRequest* req = rest_request_get(rest, id);
   diag_assert(req);
 
-  req->type = NetRestType_Get;
-  req->host = string_maybe_dup(g_allocHeap, host);
-  req->uri  = string_maybe_dup(g_allocHeap, uri);
-  req->auth = auth ? net_http_auth_clone(auth, g_allocHeap) : (NetHttpAuth){0};
-  req->etag = etag ? *etag : (NetHttpEtag){0};
+  req->type            = NetRestType_Post;
+  req->tryIndex        = 0;
+  req->retryTime       = 0;
+  req->host            = string_maybe_dup(g_allocHeap, host);
+  req->uri             = string_maybe_dup(g_allocHeap, uri);
+  req->auth            = auth ? net_http_auth_clone(auth, g_allocHeap) : (NetHttpAuth){0};
+  req->etag            = (NetHttpEtag){0};
+  req->contentType     = string_maybe_dup(g_allocHeap, contentType);
+  req->contentEncoding = string_maybe_dup(g_allocHeap, contentEncoding);
+  req->body            = string_maybe_dup(g_allocHeap, body);
 
   rest_request_state_store(req, NetRestState_Ready);
   rest_wake_worker_single(rest);
@@ -422,14 +516,20 @@ bool net_rest_release(NetRest* rest, const NetRestId id) {
   string_maybe_free(g_allocHeap, req->host);
   string_maybe_free(g_allocHeap, req->uri);
   net_http_auth_free(&req->auth, g_allocHeap);
+  string_maybe_free(g_allocHeap, req->contentType);
+  string_maybe_free(g_allocHeap, req->contentEncoding);
+  string_maybe_free(g_allocHeap, req->body);
   dynstring_release(&req->buffer); // NOTE: Its debatable if we should clear or release here.
 
   // Cleanup (not needed for correctness but makes debugging easier).
-  req->result = NetResult_Success;
-  req->host   = string_empty;
-  req->uri    = string_empty;
-  req->auth   = (NetHttpAuth){0};
-  req->etag   = (NetHttpEtag){0};
+  req->result          = NetResult_Success;
+  req->host            = string_empty;
+  req->uri             = string_empty;
+  req->auth            = (NetHttpAuth){0};
+  req->etag            = (NetHttpEtag){0};
+  req->contentType     = string_empty;
+  req->contentEncoding = string_empty;
+  req->body            = string_empty;
 
   // Mark the request as available for reuse.
   rest_request_state_store(req, NetRestState_Idle);
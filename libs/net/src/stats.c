@@ -1,12 +1,15 @@
 #include "net/stats.h"
 
 #include "pal.h"
+#include "tls.h"
 
 NetStats net_stats_query(void) {
   return (NetStats){
-      .totalResolves   = net_pal_total_resolves(),
-      .totalConnects   = net_pal_total_connects(),
-      .totalBytesRead  = net_pal_total_bytes_read(),
-      .totalBytesWrite = net_pal_total_bytes_write(),
+      .totalResolves    = net_pal_total_resolves(),
+      .totalConnects    = net_pal_total_connects(),
+      .totalBytesRead   = net_pal_total_bytes_read(),
+      .totalBytesWrite  = net_pal_total_bytes_write(),
+      .totalTlsSessions = net_tls_total_sessions(),
+      .totalTlsResumes  = net_tls_total_resumes(),
   };
 }
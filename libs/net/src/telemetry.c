@@ -0,0 +1,207 @@
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/gzip.h"
+#include "core/thread.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "net/http.h"
+#include "net/rest.h"
+#include "net/result.h"
+#include "net/telemetry.h"
+
+/**
+ * Telemetry batcher: events from any thread accumulate in a spinlock guarded buffer (pushes are a
+ * single small copy so contention stays low), batches are gzip-compressed and handed to the rest
+ * session whose worker threads post them in the background.
+ */
+
+#define net_telemetry_batch_size_trigger (16 * usize_kibibyte)
+#define net_telemetry_buffer_size_max (256 * usize_kibibyte)
+#define net_telemetry_flush_interval time_seconds(5)
+#define net_telemetry_batches_max 4 // Maximum amount of in-flight batch requests.
+
+static const String g_telemetryContentType     = string_static("application/octet-stream");
+static const String g_telemetryContentEncoding = string_static("gzip");
+
+typedef struct sNetTelemetry {
+  Allocator*  alloc;
+  NetRest*    rest;
+  String      host, uri;
+  NetHttpAuth auth;
+
+  ThreadSpinLock bufferLock;
+  DynString      buffer;      // Pending events; guarded by bufferLock.
+  u32            bufferCount; // Amount of pending events; guarded by bufferLock.
+  u64            dropped;     // Total events dropped; guarded by bufferLock.
+
+  TimeSteady lastFlushTime;
+  DynString  flushBuffer;    // Events of the batch currently being posted.
+  DynString  compressBuffer; // Gzip-compressed version of the flush-buffer.
+
+  NetRestId batches[net_telemetry_batches_max]; // In-flight batch requests.
+  u32       batchCount;
+} NetTelemetry;
+
+static void telemetry_batch_retire(NetTelemetry* tele) {
+  for (u32 i = tele->batchCount; i-- != 0;) {
+    if (!net_rest_done(tele->rest, tele->batches[i])) {
+      continue;
+    }
+    const NetResult result = net_rest_result(tele->rest, tele->batches[i]);
+    if (result != NetResult_Success) {
+      log_w(
+          "Telemetry: Failed to post batch",
+          log_param("error", fmt_text(net_result_str(result))),
+          log_param("host", fmt_text(tele->host)),
+          log_param("uri", fmt_text(tele->uri)));
+    }
+    net_rest_release(tele->rest, tele->batches[i]);
+    tele->batches[i] = tele->batches[--tele->batchCount];
+  }
+}
+
+static void telemetry_flush_internal(NetTelemetry* tele) {
+  telemetry_batch_retire(tele);
+  if (tele->batchCount == net_telemetry_batches_max) {
+    return; // Too many batches in-flight; leave the events buffered for a later flush.
+  }
+
+  // Take the pending events; the buffers are swapped so pushes are not blocked while compressing.
+  u32 eventCount;
+  thread_spinlock_lock(&tele->bufferLock);
+  {
+    const DynString tmp = tele->buffer;
+    tele->buffer        = tele->flushBuffer;
+    tele->flushBuffer   = tmp;
+    eventCount          = tele->bufferCount;
+    tele->bufferCount   = 0;
+  }
+  thread_spinlock_unlock(&tele->bufferLock);
+
+  if (!eventCount) {
+    return; // Nothing to post.
+  }
+
+  dynstring_clear(&tele->compressBuffer);
+  gzip_encode(dynstring_view(&tele->flushBuffer), &tele->compressBuffer);
+
+  const NetRestId id = net_rest_post(
+      tele->rest,
+      tele->host,
+      tele->uri,
+      &tele->auth,
+      g_telemetryContentType,
+      g_telemetryContentEncoding,
+      dynstring_view(&tele->compressBuffer));
+
+  if (sentinel_check(id)) {
+    // No free request slots in the rest session; drop the batch.
+    thread_spinlock_lock(&tele->bufferLock);
+    tele->dropped += eventCount;
+    thread_spinlock_unlock(&tele->bufferLock);
+  } else {
+    tele->batches[tele->batchCount++] = id;
+  }
+
+  tele->lastFlushTime = time_steady_clock();
+  dynstring_clear(&tele->flushBuffer);
+}
+
+NetTelemetry* net_telemetry_create(
+    Allocator* alloc, NetRest* rest, const String host, const String uri, const NetHttpAuth* auth) {
+  diag_assert(!string_is_empty(host));
+
+  NetTelemetry* tele = alloc_alloc_t(alloc, NetTelemetry);
+
+  *tele = (NetTelemetry){
+      .alloc = alloc,
+      .rest  = rest,
+      .host  = string_maybe_dup(alloc, host),
+      .uri   = string_maybe_dup(alloc, uri),
+      .auth  = auth ? net_http_auth_clone(auth, alloc) : (NetHttpAuth){0},
+
+      .buffer         = dynstring_create(g_allocHeap, 0),
+      .flushBuffer    = dynstring_create(g_allocHeap, 0),
+      .compressBuffer = dynstring_create(g_allocHeap, 0),
+      .lastFlushTime  = time_steady_clock(),
+  };
+
+  return tele;
+}
+
+void net_telemetry_destroy(NetTelemetry* tele) {
+  // Wait for the in-flight batches to finish.
+  while (tele->batchCount) {
+    telemetry_batch_retire(tele);
+    if (tele->batchCount) {
+      thread_sleep(time_milliseconds(10));
+    }
+  }
+
+  if (tele->bufferCount) {
+    log_d(
+        "Telemetry: Discarding unflushed events",
+        log_param("count", fmt_int(tele->bufferCount)),
+        log_param("host", fmt_text(tele->host)));
+  }
+  if (tele->dropped) {
+    log_w(
+        "Telemetry: Events were dropped due to backpressure",
+        log_param("dropped", fmt_int(tele->dropped)),
+        log_param("host", fmt_text(tele->host)));
+  }
+
+  string_maybe_free(tele->alloc, tele->host);
+  string_maybe_free(tele->alloc, tele->uri);
+  net_http_auth_free(&tele->auth, tele->alloc);
+  dynstring_destroy(&tele->buffer);
+  dynstring_destroy(&tele->flushBuffer);
+  dynstring_destroy(&tele->compressBuffer);
+  alloc_free_t(tele->alloc, tele);
+}
+
+bool net_telemetry_push(NetTelemetry* tele, const String event) {
+  diag_assert(!string_is_empty(event));
+
+  bool accepted = false;
+  thread_spinlock_lock(&tele->bufferLock);
+  if (tele->buffer.size + event.size + 1 <= net_telemetry_buffer_size_max) {
+    dynstring_append(&tele->buffer, event);
+    dynstring_append_char(&tele->buffer, '\n');
+    ++tele->bufferCount;
+    accepted = true;
+  } else {
+    ++tele->dropped; // Buffer at capacity; the endpoint cannot keep up.
+  }
+  thread_spinlock_unlock(&tele->bufferLock);
+  return accepted;
+}
+
+void net_telemetry_update(NetTelemetry* tele) {
+  telemetry_batch_retire(tele);
+
+  thread_spinlock_lock(&tele->bufferLock);
+  const usize bufferSize = tele->buffer.size;
+  thread_spinlock_unlock(&tele->bufferLock);
+
+  if (!bufferSize) {
+    return; // Nothing pending.
+  }
+  const TimeDuration sinceFlush = time_steady_duration(tele->lastFlushTime, time_steady_clock());
+  if (bufferSize >= net_telemetry_batch_size_trigger ||
+      sinceFlush >= net_telemetry_flush_interval) {
+    telemetry_flush_internal(tele);
+  }
+}
+
+void net_telemetry_flush(NetTelemetry* tele) { telemetry_flush_internal(tele); }
+
+u64 net_telemetry_dropped(const NetTelemetry* tele) {
+  NetTelemetry* teleMutable = (NetTelemetry*)tele;
+  thread_spinlock_lock(&teleMutable->bufferLock);
+  const u64 result = tele->dropped;
+  thread_spinlock_unlock(&teleMutable->bufferLock);
+  return result;
+}
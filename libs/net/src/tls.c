@@ -1,3 +1,19 @@
+#include "core/thread.h"
+
+#include "tls.h"
+
+static ThreadSpinLock g_netTlsInitLock;
+bool                  g_netTlsLazyInitDone;
+
+void net_tls_init_lazy(void) {
+  thread_spinlock_lock(&g_netTlsInitLock);
+  if (!g_netTlsLazyInitDone) {
+    g_netTlsLazyInitDone = true;
+    net_tls_init();
+  }
+  thread_spinlock_unlock(&g_netTlsInitLock);
+}
+
 #if defined(VOLO_LINUX)
 #include "tls_openssl.c"
 #elif defined(VOLO_WIN32)
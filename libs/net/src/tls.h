@@ -1,4 +1,16 @@
 #pragma once
+#include "core/forward.h"
 
 void net_tls_init(void);
 void net_tls_teardown(void);
+
+/**
+ * Initialize the tls subsystem on first use (instead of eagerly at startup); loading the tls
+ * library and creating the client context is relatively expensive and many invocations never use
+ * tls. Called automatically by 'net_tls_create'.
+ */
+void        net_tls_init_lazy(void);
+extern bool g_netTlsLazyInitDone;
+
+u64 net_tls_total_sessions(void);
+u64 net_tls_total_resumes(void);
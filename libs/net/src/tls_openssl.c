@@ -1,9 +1,11 @@
 #include "core/alloc.h"
+#include "core/array.h"
 #include "core/diag.h"
 #include "core/dynlib.h"
 #include "core/dynstring.h"
 #include "core/env.h"
 #include "core/path.h"
+#include "core/thread.h"
 #include "log/logger.h"
 #include "net/result.h"
 #include "net/socket.h"
@@ -20,21 +22,30 @@
  */
 
 #define net_tls_openssl_names_max 4
+#define net_tls_openssl_session_cache_max 16
 
 #define SSL_VERIFY_NONE 0x00
 #define SSL_VERIFY_PEER 0x01
 #define SSL_CTRL_MODE 33
+#define SSL_CTRL_SET_SESS_CACHE_MODE 44
 #define SSL_CTRL_SET_TLSEXT_HOSTNAME 55
 #define SSL_MODE_ENABLE_PARTIAL_WRITE 0x00000001U
+#define SSL_SESS_CACHE_CLIENT 0x0001
 #define SSL_ERROR_WANT_READ 2
 #define SSL_ERROR_WANT_WRITE 3
 #define SSL_ERROR_ZERO_RETURN 6
 
-typedef struct sSSL        SSL;
-typedef struct sSSL_METHOD SSL_METHOD;
-typedef struct sSSL_CTX    SSL_CTX;
-typedef struct sBIO        BIO;
-typedef struct sBIO_METHOD BIO_METHOD;
+typedef struct sSSL         SSL;
+typedef struct sSSL_METHOD  SSL_METHOD;
+typedef struct sSSL_CTX     SSL_CTX;
+typedef struct sSSL_SESSION SSL_SESSION;
+typedef struct sBIO         BIO;
+typedef struct sBIO_METHOD  BIO_METHOD;
+
+typedef struct {
+  StringHash   hostHash;
+  SSL_SESSION* session;
+} NetOpenSslCachedSession;
 
 typedef struct {
   DynLib* lib;
@@ -56,6 +67,10 @@ typedef struct {
   int               (SYS_DECL* SSL_read_ex)(SSL*, void *buf, usize num, usize *readBytes);
   int               (SYS_DECL* SSL_write_ex)(SSL*, const void *buf, usize num, usize *written);
   int               (SYS_DECL* SSL_get_error)(const SSL*, int ret);
+  SSL_SESSION*      (SYS_DECL* SSL_get1_session)(SSL*);
+  int               (SYS_DECL* SSL_set_session)(SSL*, SSL_SESSION*);
+  int               (SYS_DECL* SSL_session_reused)(const SSL*);
+  void              (SYS_DECL* SSL_SESSION_free)(SSL_SESSION*);
   BIO_METHOD*       (SYS_DECL* BIO_s_mem)(void);
   BIO*              (SYS_DECL* BIO_new)(const BIO_METHOD*);
   void              (SYS_DECL* BIO_free_all)(BIO*);
@@ -64,6 +79,11 @@ typedef struct {
   // clang-format on
 
   SSL_CTX* clientContext;
+
+  // Per-host cache of established sessions, used to resume handshakes on reconnects.
+  ThreadMutex             sessionCacheMutex;
+  NetOpenSslCachedSession sessionCache[net_tls_openssl_session_cache_max];
+  u32                     sessionCacheNextEvict;
 } NetOpenSsl;
 
 static const char* to_null_term_scratch(const String str) {
@@ -109,6 +129,54 @@ static void net_openssl_handle_errors(NetOpenSsl* ssl) {
   }
 }
 
+/**
+ * Take a cached session for the given host out of the cache (ownership moves to the caller).
+ * NOTE: Sessions are single use; Tls 1.3 tickets should not be redeemed more then once.
+ */
+static SSL_SESSION* net_openssl_session_take(NetOpenSsl* ssl, const StringHash hostHash) {
+  SSL_SESSION* res = null;
+  thread_mutex_lock(ssl->sessionCacheMutex);
+  for (u32 i = 0; i != array_elems(ssl->sessionCache); ++i) {
+    if (ssl->sessionCache[i].hostHash == hostHash && ssl->sessionCache[i].session) {
+      res                  = ssl->sessionCache[i].session;
+      ssl->sessionCache[i] = (NetOpenSslCachedSession){0};
+      break;
+    }
+  }
+  thread_mutex_unlock(ssl->sessionCacheMutex);
+  return res;
+}
+
+/**
+ * Store an established session for the given host (ownership moves to the cache).
+ * Prefers replacing an entry for the same host, then an empty slot, otherwise evicts round-robin.
+ */
+static void
+net_openssl_session_store(NetOpenSsl* ssl, const StringHash hostHash, SSL_SESSION* session) {
+  SSL_SESSION* evicted = null;
+  thread_mutex_lock(ssl->sessionCacheMutex);
+  u32 slot = sentinel_u32;
+  for (u32 i = 0; i != array_elems(ssl->sessionCache); ++i) {
+    if (ssl->sessionCache[i].hostHash == hostHash && ssl->sessionCache[i].session) {
+      slot = i;
+      break;
+    }
+    if (sentinel_check(slot) && !ssl->sessionCache[i].session) {
+      slot = i;
+    }
+  }
+  if (sentinel_check(slot)) {
+    slot = ssl->sessionCacheNextEvict++ % array_elems(ssl->sessionCache);
+  }
+  evicted                 = ssl->sessionCache[slot].session;
+  ssl->sessionCache[slot] = (NetOpenSslCachedSession){.hostHash = hostHash, .session = session};
+  thread_mutex_unlock(ssl->sessionCacheMutex);
+
+  if (evicted) {
+    ssl->SSL_SESSION_free(evicted);
+  }
+}
+
 static bool net_openssl_init(NetOpenSsl* ssl, Allocator* alloc) {
   String    libNames[net_tls_openssl_names_max];
   const u32 libNameCount = net_openssl_lib_names(libNames);
@@ -146,6 +214,10 @@ static bool net_openssl_init(NetOpenSsl* ssl, Allocator* alloc) {
   OPENSSL_LOAD_SYM(SSL_read_ex);
   OPENSSL_LOAD_SYM(SSL_write_ex);
   OPENSSL_LOAD_SYM(SSL_get_error);
+  OPENSSL_LOAD_SYM(SSL_get1_session);
+  OPENSSL_LOAD_SYM(SSL_set_session);
+  OPENSSL_LOAD_SYM(SSL_session_reused);
+  OPENSSL_LOAD_SYM(SSL_SESSION_free);
   OPENSSL_LOAD_SYM(BIO_s_mem);
   OPENSSL_LOAD_SYM(BIO_new);
   OPENSSL_LOAD_SYM(BIO_free_all);
@@ -162,6 +234,11 @@ static bool net_openssl_init(NetOpenSsl* ssl, Allocator* alloc) {
   }
   ssl->SSL_CTX_ctrl(ssl->clientContext, SSL_CTRL_MODE, SSL_MODE_ENABLE_PARTIAL_WRITE, null);
 
+  // Enable client session caching; needed for OpenSSL to track (ticket based) resumable sessions.
+  ssl->SSL_CTX_ctrl(ssl->clientContext, SSL_CTRL_SET_SESS_CACHE_MODE, SSL_SESS_CACHE_CLIENT, null);
+
+  ssl->sessionCacheMutex = thread_mutex_create(alloc);
+
   log_i("OpenSSL library loaded", log_param("path", fmt_path(dynlib_path(ssl->lib))));
 
 #undef OPENSSL_LOAD_SYM
@@ -170,6 +247,7 @@ static bool net_openssl_init(NetOpenSsl* ssl, Allocator* alloc) {
 
 static NetOpenSsl g_netOpenSsl;
 static bool       g_netOpenSslReady;
+static i64        g_netTlsTotalSessions, g_netTlsTotalResumes;
 
 void net_tls_init(void) {
   diag_assert(!g_netOpenSslReady);
@@ -177,6 +255,14 @@ void net_tls_init(void) {
 }
 
 void net_tls_teardown(void) {
+  for (u32 i = 0; i != array_elems(g_netOpenSsl.sessionCache); ++i) {
+    if (g_netOpenSsl.sessionCache[i].session) {
+      g_netOpenSsl.SSL_SESSION_free(g_netOpenSsl.sessionCache[i].session);
+    }
+  }
+  if (g_netOpenSsl.sessionCacheMutex) {
+    thread_mutex_destroy(g_netOpenSsl.sessionCacheMutex);
+  }
   if (g_netOpenSsl.clientContext) {
     g_netOpenSsl.SSL_CTX_free(g_netOpenSsl.clientContext);
   }
@@ -187,9 +273,13 @@ void net_tls_teardown(void) {
   g_netOpenSslReady = false;
 }
 
+u64 net_tls_total_sessions(void) { return (u64)thread_atomic_load_i64(&g_netTlsTotalSessions); }
+u64 net_tls_total_resumes(void) { return (u64)thread_atomic_load_i64(&g_netTlsTotalResumes); }
+
 typedef struct sNetTls {
   Allocator* alloc;
   NetResult  status;
+  StringHash hostHash; // Key into the session cache, 0 when no host-name was provided.
   SSL*       session;
   BIO*       input;
   BIO*       output;
@@ -234,6 +324,8 @@ static NetResult net_tls_write_output_sync(NetTls* tls, NetSocket* socket) {
 }
 
 NetTls* net_tls_create(Allocator* alloc, const String host, const NetTlsFlags flags) {
+  net_tls_init_lazy();
+
   NetTls* tls = alloc_alloc_t(alloc, NetTls);
 
   *tls = (NetTls){.alloc = alloc, .readBuffer = dynstring_create(g_allocHeap, usize_kibibyte * 16)};
@@ -250,11 +342,23 @@ NetTls* net_tls_create(Allocator* alloc, const String host, const NetTlsFlags fl
   }
   g_netOpenSsl.SSL_set_connect_state(tls->session); // Client mode.
 
+  thread_atomic_add_i64(&g_netTlsTotalSessions, 1);
+
   // SNI (Server Name Indication) host-name.
   if (!string_is_empty(host)) {
     const char* hostStr  = to_null_term_scratch(host);
     const long  nameType = 0; // See RFC3546
     g_netOpenSsl.SSL_ctrl(tls->session, SSL_CTRL_SET_TLSEXT_HOSTNAME, nameType, (void*)hostStr);
+    tls->hostHash = string_hash(host);
+  }
+
+  // Attempt to resume a previously established session to this host; avoids a full handshake.
+  if (tls->hostHash) {
+    SSL_SESSION* cachedSession = net_openssl_session_take(&g_netOpenSsl, tls->hostHash);
+    if (cachedSession) {
+      g_netOpenSsl.SSL_set_session(tls->session, cachedSession);
+      g_netOpenSsl.SSL_SESSION_free(cachedSession); // 'SSL_set_session' takes its own reference.
+    }
   }
 
   // Configure certificate verification.
@@ -296,6 +400,16 @@ NetTls* net_tls_create(Allocator* alloc, const String host, const NetTlsFlags fl
 
 void net_tls_destroy(NetTls* tls) {
   if (tls->session) {
+    if (g_netOpenSsl.SSL_session_reused(tls->session)) {
+      thread_atomic_add_i64(&g_netTlsTotalResumes, 1);
+    }
+    if (tls->hostHash && (tls->status == NetResult_Success || tls->status == NetResult_TlsClosed)) {
+      // Save the session so future connections to this host can resume the handshake.
+      SSL_SESSION* session = g_netOpenSsl.SSL_get1_session(tls->session);
+      if (session) {
+        net_openssl_session_store(&g_netOpenSsl, tls->hostHash, session);
+      }
+    }
     g_netOpenSsl.SSL_free(tls->session);
   }
   dynstring_destroy(&tls->readBuffer);
@@ -5,6 +5,7 @@
 #include "core/dynlib.h"
 #include "core/dynstring.h"
 #include "core/math.h"
+#include "core/thread.h"
 #include "core/winutils.h"
 #include "log/logger.h"
 #include "net/result.h"
@@ -117,6 +118,7 @@ static bool net_schannel_init(NetSChannel* schannel, Allocator* alloc) {
 
 static NetSChannel g_netSChannel;
 static bool        g_netSChannelReady;
+static i64         g_netTlsTotalSessions;
 
 void net_tls_init(void) {
   diag_assert(!g_netSChannelReady);
@@ -135,6 +137,11 @@ void net_tls_teardown(void) {
   g_netSChannelReady = false;
 }
 
+u64 net_tls_total_sessions(void) { return (u64)thread_atomic_load_i64(&g_netTlsTotalSessions); }
+
+// NOTE: SChannel resumes sessions internally (per credentials handle); resumes are not tracked.
+u64 net_tls_total_resumes(void) { return 0; }
+
 typedef struct sNetTls {
   Allocator*                alloc;
   String                    host;
@@ -266,6 +273,8 @@ Success:
 }
 
 NetTls* net_tls_create(Allocator* alloc, const String host, const NetTlsFlags flags) {
+  net_tls_init_lazy();
+
   NetTls* tls = alloc_alloc_t(alloc, NetTls);
 
   *tls = (NetTls){
@@ -278,6 +287,7 @@ NetTls* net_tls_create(Allocator* alloc, const String host, const NetTlsFlags fl
     tls->status = NetResult_TlsUnavailable;
     return tls;
   }
+  thread_atomic_add_i64(&g_netTlsTotalSessions, 1);
   // NOTE: Connect will be performed on the first read / write.
   return tls;
 }
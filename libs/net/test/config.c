@@ -7,6 +7,7 @@ void app_check_init(CheckDef* check) {
   register_spec(check, addr);
   register_spec(check, http);
   register_spec(check, socket);
+  register_spec(check, telemetry);
 }
 
 void app_check_teardown(void) { net_teardown(); }
@@ -0,0 +1,36 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/array.h"
+#include "net/http.h"
+#include "net/rest.h"
+#include "net/telemetry.h"
+
+spec(telemetry) {
+
+  NetRest*      rest;
+  NetTelemetry* telemetry;
+
+  setup() {
+    rest      = net_rest_create(g_allocHeap, 1, 2, NetHttpFlags_None);
+    telemetry = net_telemetry_create(
+        g_allocHeap, rest, string_lit("localhost"), string_lit("/telemetry"), null /* auth */);
+  }
+
+  it("accepts events while the buffer has capacity") {
+    check(net_telemetry_push(telemetry, string_lit("test-event-a")));
+    check(net_telemetry_push(telemetry, string_lit("test-event-b")));
+    check_eq_int(net_telemetry_dropped(telemetry), 0);
+  }
+
+  it("drops events when the buffer is at capacity") {
+    u8 eventData[4096] = {0};
+    while (net_telemetry_push(telemetry, array_mem(eventData)))
+      ;
+    check(net_telemetry_dropped(telemetry) != 0);
+  }
+
+  teardown() {
+    net_telemetry_destroy(telemetry);
+    net_rest_destroy(rest);
+  }
+}
@@ -33,3 +33,4 @@ typedef enum eRendTonemapper    RendTonemapper;
 typedef struct sRendReport      RendReport;
 typedef struct sRendReportEntry RendReportEntry;
 typedef struct sRendTagFilter   RendTagFilter;
+typedef u32                     RendObjectInstance;
@@ -10,6 +10,7 @@ typedef enum eRendObjectFlags {
   RendObjectFlags_NoInstanceFiltering = 1 << 2, // NOTE: Does not support sorting.
   RendObjectFlags_SortBackToFront     = 1 << 3,
   RendObjectFlags_SortFrontToBack     = 1 << 4,
+  RendObjectFlags_Persistent          = 1 << 5, // Instances persist; managed through handles.
 
   RendObjectFlags_Sorted = RendObjectFlags_SortBackToFront | RendObjectFlags_SortFrontToBack,
 } RendObjectFlags;
@@ -81,6 +82,9 @@ Mem rend_object_set_data(RendObjectComp*, usize size);
 
 /**
  * Add a new instance to the given object.
+ * The instance layout is declared by the caller and decoded by the graphic's shader (std140), so
+ * keep it as small as possible: the full instance stream is re-uploaded every frame. Prefer
+ * position + quaternion + scale over matrices and quantized / packed fields over full floats.
  * NOTE: Invalidates pointers from previous calls to this api.
  * NOTE: All instances need to use the same data-size.
  * NOTE: Tags and bounds are used to filter the object per camera.
@@ -91,3 +95,30 @@ Mem rend_object_set_data(RendObjectComp*, usize size);
   ((_TYPE_*)rend_object_add_instance((_OBJ_), sizeof(_TYPE_), (_TAGS_), (_AABB_)).ptr)
 
 Mem rend_object_add_instance(RendObjectComp*, usize size, RendTags, GeoBox aabb);
+
+/**
+ * Add a persistent instance to the given object.
+ * Persistent instances (requires 'RendObjectFlags_Persistent') survive across frames and are
+ * addressed through stable handles; instances that are not updated keep their previous data, which
+ * (combined with change detection) avoids re-processing unchanged (for example static) geometry.
+ * Use 'rend_object_instance_update()' to write the instance data after adding.
+ * NOTE: Same data-size requirements as 'rend_object_add_instance()'.
+ */
+RendObjectInstance rend_object_instance_add(RendObjectComp*, usize size, RendTags, GeoBox aabb);
+
+/**
+ * Update a persistent instance; returns the instance memory for the caller to write into.
+ * NOTE: Invalidates pointers from previous calls to this api.
+ * NOTE: Returned pointer is always at least 16bit aligned, stronger alignment cannot be guaranteed.
+ * Pre-condition: Handle is valid (obtained from 'rend_object_instance_add()' and not removed).
+ */
+#define rend_object_instance_update_t(_OBJ_, _HANDLE_, _TYPE_, _TAGS_, _AABB_)                     \
+  ((_TYPE_*)rend_object_instance_update((_OBJ_), (_HANDLE_), (_TAGS_), (_AABB_)).ptr)
+
+Mem rend_object_instance_update(RendObjectComp*, RendObjectInstance, RendTags, GeoBox aabb);
+
+/**
+ * Remove a previously added persistent instance.
+ * Pre-condition: Handle is valid (obtained from 'rend_object_instance_add()' and not removed).
+ */
+void rend_object_instance_remove(RendObjectComp*, RendObjectInstance);
@@ -12,6 +12,8 @@ typedef enum eRendFlags {
   RendFlags_2D                   = 1 << 4, // Disable 3d rendering.
   RendFlags_DebugCamera          = 1 << 5,
   RendFlags_DebugShadow          = 1 << 6,
+  RendFlags_Lods                 = 1 << 7, // Use simplified meshes for distant objects.
+  RendFlags_ShadowCache          = 1 << 8, // Reuse the shadow map while the casters are unchanged.
 
   RendFlags_DebugOverlay = RendFlags_DebugShadow,
 } RendFlags;
@@ -73,6 +75,7 @@ ecs_comp_extern_public(RendSettingsComp) {
   f32                  aoAngle, aoRadius, aoRadiusPower, aoPower, aoResolutionScale;
   GeoVector*           aoKernel; // GeoVector[rend_ao_kernel_size];
   f32                  grayscaleFrac;
+  f32                  sharpen; // Sharpening strength; recovers detail when upscaling.
   EcsEntityId          debugViewerResource; // Resource entity to visualize for debug purposes.
   f32                  debugViewerLod;      // Level-of-detail to use for the debug-viewer.
   f32                  debugViewerLayer;    // Layer to show in the debug-viewer.
@@ -85,7 +88,9 @@ typedef enum eRendGlobalFlags {
   RendGlobalFlags_Verbose          = 1 << 2,
   RendGlobalFlags_DebugGpu         = 1 << 3,
   RendGlobalFlags_DebugLight       = 1 << 4,
-  RendGlobalFlags_DebugLightFreeze = 1 << 5
+  RendGlobalFlags_DebugLightFreeze = 1 << 5,
+  RendGlobalFlags_Prewarm          = 1 << 6, // Compile all graphic pipelines at startup.
+  RendGlobalFlags_Governor         = 1 << 7, // Auto adjust quality to hold the target frame time.
 } RendGlobalFlags;
 
 ecs_comp_extern_public(RendSettingsGlobalComp) {
@@ -373,6 +373,11 @@ void rend_builder_draw_mesh(RendBuilder* b, const RvkMesh* mesh) {
   b->draw->drawMesh = mesh;
 }
 
+void rend_builder_draw_lod(RendBuilder* b, const u16 lodIndex) {
+  diag_assert_msg(b->draw, "RendBuilder: Draw not active");
+  b->draw->lodIndex = lodIndex;
+}
+
 void rend_builder_draw_image(RendBuilder* b, RvkImage* img) {
   diag_assert_msg(b->draw, "RendBuilder: Draw not active");
   diag_assert_msg(sentinel_check(b->draw->drawImageIndex), "RendBuilder: Draw-image already set");
@@ -402,10 +407,54 @@ void rend_builder_draw_sampler(RendBuilder* b, const RvkSamplerSpec samplerSpec)
   b->draw->drawSampler = samplerSpec;
 }
 
+/**
+ * Find an earlier draw that the given draw can be merged into; draws are compatible when they
+ * would bind the exact same state (and thus only differ in their instances).
+ */
+static RvkPassDraw* builder_draw_merge_target(RendBuilder* b, const RvkPassDraw* draw) {
+  if (draw->drawData) {
+    return null; // Per-draw data is unique to each draw.
+  }
+  for (u32 i = 0; i != (u32)b->drawList.size - 1; ++i) {
+    RvkPassDraw* other = dynarray_at_t(&b->drawList, i, RvkPassDraw);
+    if (other->graphic != draw->graphic || other->drawMesh != draw->drawMesh) {
+      continue;
+    }
+    if (other->drawData || other->drawImageIndex != draw->drawImageIndex) {
+      continue;
+    }
+    if (!mem_eq(mem_var(other->drawSampler), mem_var(draw->drawSampler))) {
+      continue;
+    }
+    if (other->lodIndex != draw->lodIndex || other->instDataStride != draw->instDataStride) {
+      continue;
+    }
+    if (other->vertexCountOverride != draw->vertexCountOverride) {
+      continue;
+    }
+    return other;
+  }
+  return null;
+}
+
 void rend_builder_draw_flush(RendBuilder* b) {
   diag_assert_msg(b->draw, "RendBuilder: Draw not active");
   if (!b->draw->instCount) {
     dynarray_remove(&b->drawList, b->drawList.size - 1, 1);
+    b->draw = null;
+    return;
+  }
+  /**
+   * Merge the draw into an earlier compatible one (same graphic and bind state) so that objects
+   * that could not be combined game-side still end up in a single draw.
+   */
+  RvkPassDraw* mergeTarget = builder_draw_merge_target(b, b->draw);
+  if (mergeTarget) {
+    if (b->draw->instData) {
+      rvk_job_uniform_join(rvk_canvas_job(b->canvas), mergeTarget->instData, b->draw->instData);
+    }
+    mergeTarget->instCount += b->draw->instCount;
+    dynarray_remove(&b->drawList, b->drawList.size - 1, 1);
   }
   b->draw = null;
 }
@@ -59,6 +59,7 @@ u32  rend_builder_draw_instances_batch_size(RendBuilder*, u32 dataStride);
 Mem  rend_builder_draw_instances(RendBuilder*, u32 dataStride, u32 count);
 void rend_builder_draw_vertex_count(RendBuilder*, u32 vertexCount);
 void rend_builder_draw_mesh(RendBuilder*, const RvkMesh*);
+void rend_builder_draw_lod(RendBuilder*, u16 lodIndex);
 void rend_builder_draw_image(RendBuilder*, RvkImage*);
 void rend_builder_draw_image_frozen(RendBuilder*, const RvkImage*);
 void rend_builder_draw_sampler(RendBuilder*, RvkSamplerSpec);
@@ -0,0 +1,213 @@
+#include "core/array.h"
+#include "core/math.h"
+#include "core/time.h"
+#include "ecs/view.h"
+#include "ecs/world.h"
+#include "log/logger.h"
+#include "rend/register.h"
+#include "rend/settings.h"
+#include "rend/stats.h"
+#include "trace/tracer.h"
+
+#include "limiter.h"
+
+/**
+ * Budget governor: automatically adjusts quality settings to hold a target frame time, so a single
+ * configuration can ship on wildly varied hardware without hand-tuning per machine.
+ *
+ * Decisions are driven by the existing timing sources (gpu execution time from the canvas
+ * stats and the cpu frame time minus the time spent pacing in the limiter) and are damped with
+ * hysteresis: quality only steps down after a sustained overshoot, only steps back up after a long
+ * stretch of headroom, and every change is followed by a cooldown to let the timings settle.
+ */
+
+#define rend_governor_headroom 0.92f    // Fraction of the target the frame has to fit in.
+#define rend_governor_raise_frac 0.6f   // Fraction of the target below which quality can raise.
+#define rend_governor_lower_frames 30   // Over-budget frames before lowering quality.
+#define rend_governor_raise_frames 600  // Under-budget frames before raising quality.
+#define rend_governor_lower_cooldown 60 // Frames to wait after a change before the next one.
+#define rend_governor_raise_cooldown 300
+#define rend_governor_shadow_resolution_min 256
+
+// Flag-gated passes that the governor is allowed to disable.
+#define rend_governor_flags_mask                                                                   \
+  (RendFlags_AmbientOcclusion | RendFlags_AmbientOcclusionBlur | RendFlags_Shadows)
+
+typedef struct {
+  f32       resolutionScaleMul; // Applied on top of the baseline resolution-scale.
+  f32       shadowResolutionMul;
+  RendFlags disableFlags;
+} RendGovernorStep;
+
+static const RendGovernorStep g_governorSteps[] = {
+    {.resolutionScaleMul = 1.0f, .shadowResolutionMul = 1.0f},
+    {.resolutionScaleMul = 0.85f, .shadowResolutionMul = 1.0f},
+    {.resolutionScaleMul = 0.75f,
+     .shadowResolutionMul = 0.5f,
+     .disableFlags        = RendFlags_AmbientOcclusionBlur},
+    {.resolutionScaleMul = 0.6f,
+     .shadowResolutionMul = 0.5f,
+     .disableFlags        = RendFlags_AmbientOcclusionBlur | RendFlags_AmbientOcclusion},
+    {.resolutionScaleMul = 0.5f,
+     .shadowResolutionMul = 0.25f,
+     .disableFlags =
+         RendFlags_AmbientOcclusionBlur | RendFlags_AmbientOcclusion | RendFlags_Shadows},
+};
+
+#define rend_governor_step_max ((u32)array_elems(g_governorSteps) - 1)
+
+ecs_comp_define(RendGovernorComp) {
+  u32        step;        // Index into the quality step ladder, 0 is the user baseline.
+  u32        overBudget;  // Consecutive frames over budget.
+  u32        underBudget; // Consecutive frames comfortably under budget.
+  u32        cooldown;    // Frames to wait before the next adjustment.
+  TimeSteady lastTime;    // Timestamp of the previous governor update.
+
+  // Baseline (user configured) values of the governed settings.
+  f32       baseResolutionScale;
+  u16       baseShadowResolution;
+  RendFlags baseFlags;
+};
+
+ecs_view_define(GlobalView) {
+  ecs_access_read(RendSettingsGlobalComp);
+  ecs_access_maybe_read(RendLimiterComp);
+}
+
+ecs_view_define(WindowView) {
+  ecs_access_write(RendSettingsComp);
+  ecs_access_read(RendStatsComp);
+  ecs_access_maybe_write(RendGovernorComp);
+}
+
+static void governor_apply(const RendGovernorComp* gov, RendSettingsComp* s) {
+  const RendGovernorStep* step = &g_governorSteps[gov->step];
+
+  const u32 shadowRes = (u32)((f32)gov->baseShadowResolution * step->shadowResolutionMul);
+
+  s->resolutionScale  = gov->baseResolutionScale * step->resolutionScaleMul;
+  s->shadowResolution = (u16)math_max(shadowRes, rend_governor_shadow_resolution_min);
+  s->flags = (s->flags | (gov->baseFlags & rend_governor_flags_mask)) & ~step->disableFlags;
+}
+
+static void governor_report(
+    const RendGovernorComp* gov, const TimeDuration cost, const TimeDuration target) {
+  // Make the decision visible in performance traces as a zero-length event.
+  trace_begin_msg("rend_governor", TraceColor_Red, "governor_step_{}", fmt_int(gov->step));
+  trace_end();
+
+  log_i(
+      "Governor: Quality adjusted",
+      log_param("step", fmt_int(gov->step)),
+      log_param("frame-cost", fmt_duration(cost)),
+      log_param("frame-target", fmt_duration(target)),
+      log_param("resolution-scale-mul", fmt_float(g_governorSteps[gov->step].resolutionScaleMul)));
+}
+
+/**
+ * Compute the frame time the governor should hold: the explicit limiter frequency when one is
+ * configured, otherwise the display refresh interval, with a 60hz fallback.
+ */
+static TimeDuration
+governor_target(const RendSettingsGlobalComp* settingsGlobal, const RendStatsComp* stats) {
+  if (settingsGlobal->limiterFreq) {
+    return time_second / settingsGlobal->limiterFreq;
+  }
+  if (stats->swapchainRefreshDuration) {
+    return stats->swapchainRefreshDuration;
+  }
+  return time_second / 60;
+}
+
+ecs_system_define(RendGovernorSys) {
+  EcsView*     globalView = ecs_world_view_t(world, GlobalView);
+  EcsIterator* globalItr  = ecs_view_maybe_at(globalView, ecs_world_global(world));
+  if (UNLIKELY(!globalItr)) {
+    return;
+  }
+  const RendSettingsGlobalComp* settingsGlobal = ecs_view_read_t(globalItr, RendSettingsGlobalComp);
+  const RendLimiterComp*        limiter        = ecs_view_read_t(globalItr, RendLimiterComp);
+  const bool                    active = (settingsGlobal->flags & RendGlobalFlags_Governor) != 0;
+
+  const TimeSteady now = time_steady_clock();
+
+  EcsView* windowView = ecs_world_view_t(world, WindowView);
+  for (EcsIterator* itr = ecs_view_itr(windowView); ecs_view_walk(itr);) {
+    RendSettingsComp*    settings = ecs_view_write_t(itr, RendSettingsComp);
+    const RendStatsComp* stats    = ecs_view_read_t(itr, RendStatsComp);
+    RendGovernorComp*    gov      = ecs_view_write_t(itr, RendGovernorComp);
+
+    if (!active) {
+      if (gov && gov->step) {
+        gov->step = 0;
+        governor_apply(gov, settings); // Restore the user baseline.
+      }
+      continue;
+    }
+    if (!gov) {
+      gov = ecs_world_add_t(world, ecs_view_entity(itr), RendGovernorComp, .lastTime = now);
+      continue;
+    }
+    const TimeDuration frameDur = time_steady_duration(gov->lastTime, now);
+    gov->lastTime               = now;
+    if (frameDur <= 0 || frameDur > time_second) {
+      continue; // Process was likely paused; skip this sample.
+    }
+
+    // While at the baseline step track the user configured values, so external changes (for
+    // example from the settings ui) are picked up as the new baseline.
+    if (!gov->step) {
+      gov->baseResolutionScale  = settings->resolutionScale;
+      gov->baseShadowResolution = settings->shadowResolution;
+      gov->baseFlags            = settings->flags & rend_governor_flags_mask;
+    }
+
+    const TimeDuration target = governor_target(settingsGlobal, stats);
+
+    // Cpu cost: the frame time excluding time spent pacing (limiter, vsync) or blocked on the gpu.
+    TimeDuration cpuCost = frameDur - stats->presentWaitDur - stats->waitForGpuDur;
+    if (limiter) {
+      cpuCost -= limiter->sleepDur;
+    }
+    const TimeDuration cost = math_max(stats->gpuExecDur, cpuCost);
+
+    if (gov->cooldown) {
+      --gov->cooldown;
+      continue;
+    }
+
+    if (cost > (TimeDuration)((f64)target * rend_governor_headroom)) {
+      gov->underBudget = 0;
+      if (++gov->overBudget >= rend_governor_lower_frames && gov->step < rend_governor_step_max) {
+        ++gov->step;
+        governor_apply(gov, settings);
+        governor_report(gov, cost, target);
+        gov->overBudget = 0;
+        gov->cooldown   = rend_governor_lower_cooldown;
+      }
+      continue;
+    }
+
+    gov->overBudget = 0;
+    if (cost < (TimeDuration)((f64)target * rend_governor_raise_frac)) {
+      if (++gov->underBudget >= rend_governor_raise_frames && gov->step) {
+        --gov->step;
+        governor_apply(gov, settings);
+        governor_report(gov, cost, target);
+        gov->underBudget = 0;
+        gov->cooldown    = rend_governor_raise_cooldown;
+      }
+    } else {
+      gov->underBudget = 0; // In between the thresholds; hold the current step.
+    }
+  }
+}
+
+ecs_module_init(rend_governor_module) {
+  ecs_register_comp(RendGovernorComp);
+
+  ecs_register_view(GlobalView);
+  ecs_register_view(WindowView);
+
+  ecs_register_system(RendGovernorSys, ecs_view_id(GlobalView), ecs_view_id(WindowView));
+}
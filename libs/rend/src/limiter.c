@@ -1,3 +1,4 @@
+#include "core/math.h"
 #include "core/thread.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
@@ -9,6 +10,12 @@
 #include "limiter.h"
 #include "painter.h"
 
+/**
+ * Duration to spin-wait before the deadline. 'thread_sleep()' regularly wakes up (far) later than
+ * requested, so the last fraction of the wait is done with a precise spin.
+ */
+#define rend_limiter_spin_dur time_microseconds(250)
+
 ecs_comp_define(RendLimiterComp);
 
 ecs_view_define(GlobalView) {
@@ -32,6 +39,46 @@ static bool rend_wait_for_present(EcsWorld* world) {
   return anyWaited;
 }
 
+/**
+ * Retrieve the time of the newest presentation that was shown to the user on any painter.
+ * NOTE: Returns 0 if no presentation engine reports present timing.
+ */
+static TimeSteady rend_last_present_time(EcsWorld* world) {
+  EcsView* painterView = ecs_world_view_t(world, PainterView);
+
+  TimeSteady lastPresentTime = 0;
+  for (EcsIterator* itr = ecs_view_itr(painterView); ecs_view_walk(itr);) {
+    const RendPainterComp* painter = ecs_view_read_t(itr, RendPainterComp);
+    lastPresentTime = math_max(lastPresentTime, rvk_canvas_last_present_time(painter->canvas));
+  }
+  return lastPresentTime;
+}
+
+/**
+ * Wait until the given deadline; sleeps for the bulk of the wait and spins for the last fraction
+ * of a millisecond for precise timing.
+ */
+static void rend_wait_until(RendLimiterComp* limiter, const TimeSteady deadline) {
+  const TimeSteady   start = time_steady_clock();
+  const TimeDuration sleepDur =
+      time_steady_duration(start, deadline) - rend_limiter_spin_dur - limiter->sleepOverhead;
+  if (sleepDur > 0) {
+    thread_sleep(sleepDur);
+
+    /**
+     * Moving average of the additional time a 'thread_sleep()' takes to avoid waking up late.
+     * NOTE: Skip very large delta's as the game's process was most likely paused.
+     */
+    const TimeDuration sleptDur = time_steady_duration(start, time_steady_clock());
+    if (LIKELY(sleptDur < time_second)) {
+      limiter->sleepOverhead = (sleptDur - sleepDur + limiter->sleepOverhead * 99) / 100;
+    }
+  }
+  while (time_steady_clock() < deadline) {
+    thread_yield();
+  }
+}
+
 static bool rend_can_throttle(EcsWorld* world) {
   EcsView* painterView = ecs_world_view_t(world, PainterView);
 
@@ -53,7 +100,7 @@ ecs_system_define(RendFrameLimiterSys) {
   RendLimiterComp*              limiter        = ecs_view_write_t(globalItr, RendLimiterComp);
   if (UNLIKELY(!limiter)) {
     limiter = ecs_world_add_t(
-        world, ecs_world_global(world), RendLimiterComp, .previousTime = time_steady_clock());
+        world, ecs_world_global(world), RendLimiterComp, .nextDeadline = time_steady_clock());
   }
 
   u16 limiterFreq = settingsGlobal->limiterFreq;
@@ -78,27 +125,31 @@ ecs_system_define(RendFrameLimiterSys) {
     // Apply a small bias to favor waiting on vsync instead of the cpu limiter.
     targetDuration -= time_microseconds(500);
   }
-  const TimeSteady   start   = time_steady_clock();
-  const TimeDuration elapsed = time_steady_duration(limiter->previousTime, start);
-
-  limiter->sleepDur = targetDuration - elapsed;
-  if (limiter->sleepDur > limiter->sleepOverhead) {
-    limiter->sleepDur -= limiter->sleepOverhead;
+  const TimeSteady start = time_steady_clock();
+
+  /**
+   * Predict the deadline for the next frame. Advancing the previous deadline (instead of
+   * measuring from the current time) avoids accumulating drift, and anchoring on the last
+   * observed present keeps the pacing in phase with the display under compositor jitter.
+   */
+  TimeSteady       deadline        = limiter->nextDeadline + targetDuration;
+  const TimeSteady lastPresentTime = rend_last_present_time(world);
+  if (lastPresentTime) {
+    deadline = math_max(deadline, lastPresentTime + targetDuration);
+  }
+  if (deadline < start) {
+    deadline = start; // Running behind; skip ahead instead of bursting catch-up frames.
+  }
 
+  limiter->sleepDur = time_steady_duration(start, deadline);
+  if (limiter->sleepDur > 0) {
     trace_begin("limiter_sleep", TraceColor_Gray);
-    thread_sleep(limiter->sleepDur);
+    rend_wait_until(limiter, deadline);
     trace_end();
-
-    /**
-     * Moving average of the additional time a 'thread_sleep()' takes to avoid waking up late.
-     * NOTE: Skip very large delta's as the game's process was most likely paused.
-     */
-    const TimeDuration sinceStart = time_steady_duration(start, time_steady_clock());
-    if (LIKELY(sinceStart < time_second)) {
-      limiter->sleepOverhead = (sinceStart - limiter->sleepDur + limiter->sleepOverhead * 99) / 100;
-    }
+  } else {
+    limiter->sleepDur = 0;
   }
-  limiter->previousTime = time_steady_clock();
+  limiter->nextDeadline = deadline;
 }
 
 ecs_module_init(rend_limiter_module) {
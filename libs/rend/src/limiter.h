@@ -4,6 +4,6 @@
 
 ecs_comp_extern_public(RendLimiterComp) {
   TimeDuration sleepDur;
-  TimeSteady   previousTime;
+  TimeSteady   nextDeadline; // Predicted time at which the next frame should start.
   TimeDuration sleepOverhead;
 };
@@ -1,6 +1,8 @@
 #include "core/alloc.h"
 #include "core/bits.h"
+#include "core/bitset.h"
 #include "core/diag.h"
+#include "core/float.h"
 #include "core/math.h"
 #include "core/sort.h"
 #include "ecs/entity.h"
@@ -22,12 +24,19 @@
 
 #define rend_min_align 16
 #define rend_max_res_requests 16
+#define rend_lod_levels_max 4
+#define rend_lod_dist_mul 30.0f
 
 typedef struct {
   u16 instIndex;
   u16 viewDist; // Not linear.
 } RendObjectSortKey;
 
+typedef struct {
+  u16 instIndex;  // Index of the next free slot when part of the free-list.
+  u16 generation; // Incremented on each slot re-use to detect stale handles.
+} RendObjectSlot;
+
 ecs_comp_define(RendObjectComp) {
   EcsEntityId resources[RendObjectRes_Count];
   EcsEntityId cameraFilter;
@@ -41,9 +50,15 @@ ecs_comp_define(RendObjectComp) {
 
   u32 dataSize;     // Size of the 'per draw' data.
   u32 instDataSize; // Size of the 'per instance' data.
+  u32 instVersion;  // Incremented on every instance change; used for change detection.
+
+  u16 slotCount;
+  u16 slotFreeHead; // Head of the free slot list, sentinel_u16 when the list is empty.
 
   Mem dataMem;
   Mem instDataMem, instTagsMem, instAabbMem;
+  Mem instSlotMem;    // RendObjectSlot[slotCount], only used for persistent objects.
+  Mem instSlotIdxMem; // u16[instCount], maps an instance back to its slot.
 };
 
 /**
@@ -66,12 +81,17 @@ static void ecs_destruct_object(void* data) {
   alloc_maybe_free(g_allocHeap, comp->instDataMem);
   alloc_maybe_free(g_allocHeap, comp->instTagsMem);
   alloc_maybe_free(g_allocHeap, comp->instAabbMem);
+  alloc_maybe_free(g_allocHeap, comp->instSlotMem);
+  alloc_maybe_free(g_allocHeap, comp->instSlotIdxMem);
 }
 
 static void ecs_combine_object(void* dataA, void* dataB) {
   RendObjectComp* objA = dataA;
   RendObjectComp* objB = dataB;
   diag_assert_msg(objA->flags == objB->flags, "Only objects with the same flags can be combined");
+  diag_assert_msg(
+      !(objA->flags & RendObjectFlags_Persistent),
+      "Persistent objects cannot be combined (would invalidate instance handles)");
   diag_assert_msg(
       objA->instDataSize == objB->instDataSize,
       "Only objects with the same instance-data stride can be combined");
@@ -152,7 +172,7 @@ ecs_system_define(RendClearObjectsSys) {
   EcsView* objView = ecs_world_view_t(world, ObjectWriteView);
   for (EcsIterator* itr = ecs_view_itr(objView); ecs_view_walk(itr);) {
     RendObjectComp* obj = ecs_view_write_t(itr, RendObjectComp);
-    if (!(obj->flags & RendObjectFlags_NoAutoClear)) {
+    if (!(obj->flags & (RendObjectFlags_NoAutoClear | RendObjectFlags_Persistent))) {
       rend_object_clear(obj);
     }
   }
@@ -205,7 +225,12 @@ rend_object_create(EcsWorld* world, const EcsEntityId entity, const RendObjectFl
   diag_assert_msg(noFiltering ? !isSorted : true, "NoInstanceFiltering incompatible with sorting");
 
   return ecs_world_add_t(
-      world, entity, RendObjectComp, .flags = flags, .alphaTexIndex = sentinel_u8);
+      world,
+      entity,
+      RendObjectComp,
+      .flags         = flags,
+      .alphaTexIndex = sentinel_u8,
+      .slotFreeHead  = sentinel_u16);
 }
 
 RendObjectFlags rend_object_flags(const RendObjectComp* obj) { return obj->flags; }
@@ -218,6 +243,29 @@ u32      rend_object_instance_count(const RendObjectComp* obj) { return obj->ins
 u32      rend_object_data_size(const RendObjectComp* obj) { return obj->dataSize; }
 u32      rend_object_data_inst_size(const RendObjectComp* obj) { return obj->instDataSize; }
 RendTags rend_object_tag_mask(const RendObjectComp* obj) { return obj->tagMask; }
+
+u32 rend_object_instance_hash(const RendObjectComp* obj) {
+  u32 hash = bits_hash_32_val(obj->instCount);
+  if (obj->flags & RendObjectFlags_Persistent) {
+    // Persistent instances only change through the handle apis; hashing a version counter (instead
+    // of the full instance data) makes change detection cheap for big (mostly static) objects.
+    return bits_hash_32_combine(hash, bits_hash_32_val(obj->instVersion));
+  }
+  if (!obj->instCount) {
+    return hash;
+  }
+  if (obj->instDataSize) {
+    const Mem data = mem_slice(obj->instDataMem, 0, (usize)obj->instDataSize * obj->instCount);
+    hash           = bits_hash_32_combine(hash, bits_hash_32(data));
+  }
+  if (!(obj->flags & RendObjectFlags_NoInstanceFiltering)) {
+    const Mem tags  = mem_slice(obj->instTagsMem, 0, sizeof(RendTags) * obj->instCount);
+    const Mem aabbs = mem_slice(obj->instAabbMem, 0, sizeof(GeoBox) * obj->instCount);
+    hash            = bits_hash_32_combine(hash, bits_hash_32(tags));
+    hash            = bits_hash_32_combine(hash, bits_hash_32(aabbs));
+  }
+  return hash;
+}
 u8       rend_object_alpha_tex_index(const RendObjectComp* obj) { return obj->alphaTexIndex; }
 
 static i8 rend_object_compare_back_to_front(const void* a, const void* b) {
@@ -303,6 +351,31 @@ NO_INLINE_HINT static void rend_instances_push_sorted(
   }
 }
 
+/**
+ * Select a mesh level-of-detail for the object based on the nearest visible instance
+ * (conservative). Every level halves the threshold distance and the first threshold scales with
+ * the instance size so that big objects keep their detail for longer.
+ */
+static u16 rend_object_lod(const RendObjectComp* obj, const RendView* view, const BitSet visible) {
+  f32 distSqrMin = f32_max;
+  f32 radiusMax  = 0.0f;
+  bitset_for(visible, instIdx) {
+    const GeoBox*   aabb = &((const GeoBox*)obj->instAabbMem.ptr)[instIdx];
+    const GeoVector size = geo_box_size(aabb);
+    distSqrMin           = math_min(distSqrMin, rend_view_dist_sqr(view, aabb));
+    radiusMax = math_max(radiusMax, math_max(size.x, math_max(size.y, size.z)) * 0.5f);
+  }
+  if (UNLIKELY(radiusMax <= 0.0f)) {
+    return 0; // Degenerate instance bounds; keep full detail.
+  }
+  u16 level   = 0;
+  f32 lodDist = radiusMax * rend_lod_dist_mul;
+  for (; level != rend_lod_levels_max && distSqrMin > (lodDist * lodDist); lodDist *= 2.0f) {
+    ++level;
+  }
+  return level;
+}
+
 void rend_object_draw(
     const RendObjectComp*   obj,
     const RendView*         view,
@@ -327,7 +400,6 @@ void rend_object_draw(
   }
 
   RendObjectSortKey* sortKeys = null;
-  BitSet             filter   = mem_empty;
 
   if (obj->flags & RendObjectFlags_Sorted) {
     const usize requiredSortMem = obj->instCount * sizeof(RendObjectSortKey);
@@ -341,34 +413,42 @@ void rend_object_draw(
     }
   }
 
-  if (!sortKeys) {
-    filter = alloc_alloc(g_allocScratch, bits_to_bytes(obj->instCount) + 1, 1);
-    bitset_clear_all(filter);
-  }
-
-  u32 filteredInstCount = 0;
-  for (u32 i = 0; i != obj->instCount; ++i) {
-    const RendTags instTags = ((RendTags*)obj->instTagsMem.ptr)[i];
-    const GeoBox*  instAabb = &((GeoBox*)obj->instAabbMem.ptr)[i];
-    if (!rend_view_visible(view, instTags, instAabb, settings)) {
-      continue;
-    }
-    const u32 outputIndex = filteredInstCount++;
-    if (sortKeys) {
-      sortKeys[outputIndex] = (RendObjectSortKey){
+  // Cull all instances up-front using the batched (vectorized) visibility test.
+  const BitSet visibility = alloc_alloc(g_allocScratch, bits_to_bytes(obj->instCount) + 1, 1);
+  rend_view_visible_batch(
+      view,
+      (const RendTags*)obj->instTagsMem.ptr,
+      (const GeoBox*)obj->instAabbMem.ptr,
+      obj->instCount,
+      settings,
+      visibility);
+
+  u32 filteredInstCount;
+  if (sortKeys) {
+    filteredInstCount = 0;
+    for (u32 i = 0; i != obj->instCount; ++i) {
+      if (!bitset_test(visibility, i)) {
+        continue;
+      }
+      const GeoBox* instAabb        = &((GeoBox*)obj->instAabbMem.ptr)[i];
+      sortKeys[filteredInstCount++] = (RendObjectSortKey){
           .instIndex = (u16)i,
           .viewDist  = rend_view_sort_dist(view, instAabb),
       };
-    } else {
-      bitset_set(filter, i);
     }
+  } else {
+    filteredInstCount = (u32)bitset_count(visibility);
+  }
+
+  if (filteredInstCount && settings->flags & RendFlags_Lods) {
+    rend_builder_draw_lod(b, rend_object_lod(obj, view, visibility));
   }
 
   if (filteredInstCount) {
     if (sortKeys) {
       rend_instances_push_sorted(obj, b, sortKeys, filteredInstCount);
     } else {
-      rend_instances_push_filtered(obj, b, filter, filteredInstCount);
+      rend_instances_push_filtered(obj, b, visibility, filteredInstCount);
     }
   }
 }
@@ -394,6 +474,18 @@ void rend_object_clear(RendObjectComp* obj) {
   obj->instCount    = 0;
   obj->instDataSize = 0;
   obj->tagMask      = 0;
+
+  if (obj->flags & RendObjectFlags_Persistent) {
+    // Release all slots (bumping their generation so outstanding handles become stale).
+    RendObjectSlot* slots = obj->instSlotMem.ptr;
+    obj->slotFreeHead     = sentinel_u16;
+    for (u16 i = 0; i != obj->slotCount; ++i) {
+      ++slots[i].generation; // NOTE: Allowed to wrap.
+      slots[i].instIndex = obj->slotFreeHead;
+      obj->slotFreeHead  = i;
+    }
+    ++obj->instVersion;
+  }
 }
 
 Mem rend_object_set_data(RendObjectComp* obj, const usize size) {
@@ -402,7 +494,7 @@ Mem rend_object_set_data(RendObjectComp* obj, const usize size) {
   return obj->dataMem;
 }
 
-Mem rend_object_add_instance(
+static u32 rend_object_inst_push(
     RendObjectComp* obj, const usize size, const RendTags tags, const GeoBox aabb) {
 
   if (UNLIKELY(!obj->instDataSize)) {
@@ -410,14 +502,11 @@ Mem rend_object_add_instance(
   }
   diag_assert_msg(size <= obj->instDataSize, "Object instance-data size mismatch");
 
-  /**
-   * Add a new instance and return instance memory for the caller to write into.
-   */
-
   const u32 instIndex = obj->instCount++;
   buf_ensure(&obj->instDataMem, obj->instCount * obj->instDataSize, rend_min_align);
 
   obj->tagMask |= tags;
+  ++obj->instVersion;
 
   if (!(obj->flags & RendObjectFlags_NoInstanceFiltering)) {
     buf_ensure(&obj->instTagsMem, obj->instCount * sizeof(RendTags), 1);
@@ -427,5 +516,99 @@ Mem rend_object_add_instance(
     ((GeoBox*)obj->instAabbMem.ptr)[instIndex]   = aabb;
   }
 
+  return instIndex;
+}
+
+Mem rend_object_add_instance(
+    RendObjectComp* obj, const usize size, const RendTags tags, const GeoBox aabb) {
+  diag_assert_msg(
+      !(obj->flags & RendObjectFlags_Persistent),
+      "Persistent object instances have to be added through 'rend_object_instance_add()'");
+
+  /**
+   * Add a new instance and return instance memory for the caller to write into.
+   */
+  const u32 instIndex = rend_object_inst_push(obj, size, tags, aabb);
   return rend_object_inst_data(obj, instIndex);
 }
+
+static RendObjectSlot* rend_object_slot(RendObjectComp* obj, const RendObjectInstance handle) {
+  const u16 slotIndex = (u16)handle;
+  diag_assert_msg(obj->flags & RendObjectFlags_Persistent, "Object is not persistent");
+  diag_assert_msg(slotIndex < obj->slotCount, "Invalid object instance handle");
+
+  RendObjectSlot* slot = &((RendObjectSlot*)obj->instSlotMem.ptr)[slotIndex];
+  diag_assert_msg(slot->generation == (u16)(handle >> 16), "Stale object instance handle");
+  return slot;
+}
+
+RendObjectInstance rend_object_instance_add(
+    RendObjectComp* obj, const usize size, const RendTags tags, const GeoBox aabb) {
+  diag_assert_msg(obj->flags & RendObjectFlags_Persistent, "Object is not persistent");
+  diag_assert_msg(obj->instCount < u16_max, "Object persistent instance count exceeds maximum");
+
+  const u32 instIndex = rend_object_inst_push(obj, size, tags, aabb);
+
+  // Acquire a slot; either by re-using a previously released one or by appending a new one.
+  u16 slotIndex;
+  if (!sentinel_check(obj->slotFreeHead)) {
+    slotIndex         = obj->slotFreeHead;
+    obj->slotFreeHead = ((RendObjectSlot*)obj->instSlotMem.ptr)[slotIndex].instIndex;
+  } else {
+    slotIndex = obj->slotCount++;
+    buf_ensure(&obj->instSlotMem, obj->slotCount * sizeof(RendObjectSlot), alignof(RendObjectSlot));
+    ((RendObjectSlot*)obj->instSlotMem.ptr)[slotIndex].generation = 0;
+  }
+  RendObjectSlot* slot = &((RendObjectSlot*)obj->instSlotMem.ptr)[slotIndex];
+  slot->instIndex      = (u16)instIndex;
+
+  buf_ensure(&obj->instSlotIdxMem, obj->instCount * sizeof(u16), alignof(u16));
+  ((u16*)obj->instSlotIdxMem.ptr)[instIndex] = slotIndex;
+
+  return (RendObjectInstance)slotIndex | ((RendObjectInstance)slot->generation << 16);
+}
+
+Mem rend_object_instance_update(
+    RendObjectComp* obj, const RendObjectInstance handle, const RendTags tags, const GeoBox aabb) {
+  const RendObjectSlot* slot = rend_object_slot(obj, handle);
+
+  obj->tagMask |= tags;
+  ++obj->instVersion;
+
+  if (!(obj->flags & RendObjectFlags_NoInstanceFiltering)) {
+    ((RendTags*)obj->instTagsMem.ptr)[slot->instIndex] = tags;
+    ((GeoBox*)obj->instAabbMem.ptr)[slot->instIndex]   = aabb;
+  }
+
+  return rend_object_inst_data(obj, slot->instIndex);
+}
+
+void rend_object_instance_remove(RendObjectComp* obj, const RendObjectInstance handle) {
+  RendObjectSlot* slot        = rend_object_slot(obj, handle);
+  const u16       instIndex   = slot->instIndex;
+  const u16       lastIndex   = (u16)(obj->instCount - 1);
+  u16*            slotIndices = (u16*)obj->instSlotIdxMem.ptr;
+
+  if (instIndex != lastIndex) {
+    // Swap the last instance into the removed spot and re-point its slot.
+    const Mem dst = rend_object_inst_data(obj, instIndex);
+    const Mem src = rend_object_inst_data(obj, lastIndex);
+    rend_object_memcpy(dst.ptr, src.ptr, obj->instDataSize);
+
+    if (!(obj->flags & RendObjectFlags_NoInstanceFiltering)) {
+      ((RendTags*)obj->instTagsMem.ptr)[instIndex] = ((RendTags*)obj->instTagsMem.ptr)[lastIndex];
+      ((GeoBox*)obj->instAabbMem.ptr)[instIndex]   = ((GeoBox*)obj->instAabbMem.ptr)[lastIndex];
+    }
+
+    const u16 movedSlotIndex = slotIndices[lastIndex];
+    ((RendObjectSlot*)obj->instSlotMem.ptr)[movedSlotIndex].instIndex = instIndex;
+    slotIndices[instIndex]                                            = movedSlotIndex;
+  }
+  --obj->instCount;
+  ++obj->instVersion;
+
+  // Release the slot; bumping its generation makes any outstanding handles stale.
+  ++slot->generation; // NOTE: Allowed to wrap.
+  slot->instIndex   = obj->slotFreeHead;
+  obj->slotFreeHead = (u16)handle;
+}
@@ -8,3 +8,8 @@ ecs_comp_extern(RendSettingsComp);
 
 void rend_object_draw(
     const RendObjectComp*, const RendView*, const RendSettingsComp*, RendBuilder*);
+
+/**
+ * Hash of the object's current instances; can be used to detect changes between frames.
+ */
+u32 rend_object_instance_hash(const RendObjectComp*);
@@ -317,6 +317,37 @@ static void painter_push_shadow(RendPaintContext* ctx, EcsView* objView, EcsView
   }
 }
 
+/**
+ * Hash of all the state that determines the shadow map contents; used to detect whether a cached
+ * shadow map from a previous frame is still valid.
+ */
+static u32 painter_shadow_hash(
+    EcsView* objView, EcsView* resView, const GeoMatrix* trans, const GeoMatrix* proj) {
+  struct {
+    GeoMatrix trans, proj;
+  } matrices = {*trans, *proj};
+
+  u32 hash = bits_hash_32(mem_var(matrices));
+
+  EcsIterator* resourceItr = ecs_view_itr(resView);
+  for (EcsIterator* objItr = ecs_view_itr(objView); ecs_view_walk(objItr);) {
+    const RendObjectComp* obj = ecs_view_read_t(objItr, RendObjectComp);
+    if (!rend_object_instance_count(obj)) {
+      continue; // Object has no instances.
+    }
+    const EcsEntityId graphicRes = rend_object_resource(obj, RendObjectRes_GraphicShadow);
+    if (!graphicRes) {
+      continue; // Object has no shadow graphic.
+    }
+    if (!painter_get_graphic(resourceItr, graphicRes)) {
+      continue; // Shadow graphic is not loaded.
+    }
+    hash = bits_hash_32_combine(hash, bits_hash_32_val(ecs_entity_id_index(graphicRes)));
+    hash = bits_hash_32_combine(hash, rend_object_instance_hash(obj));
+  }
+  return hash;
+}
+
 static void painter_push_ambient(RendPaintContext* ctx, const GeoColor radiance) {
   typedef enum {
     AmbientFlags_AmbientOcclusion     = 1 << 0,
@@ -373,12 +404,13 @@ static void painter_push_tonemapping(RendPaintContext* ctx) {
     f32 exposure;
     u32 mode;
     f32 grayscaleFrac;
-    f32 unused;
+    f32 sharpen;
   } data;
 
   data.exposure      = ctx->set->exposure;
   data.mode          = ctx->set->tonemapper;
   data.grayscaleFrac = ctx->set->grayscaleFrac;
+  data.sharpen       = ctx->set->sharpen;
 
   painter_push_simple(ctx, RvkRepositoryId_TonemapperGraphic, mem_var(data));
 }
@@ -557,6 +589,16 @@ static bool rend_canvas_paint_2d(
   return true;
 }
 
+/**
+ * Compose the 3d frame; the pass order and dependencies are spelled out explicitly here instead of
+ * being derived by a render-graph:
+ * - Execution order: fixed (geometry, shadow, ambient-occlusion, forward, post).
+ * - Dead passes: skipped through the settings flags (shadow / ao) and the shadow cache.
+ * - Barriers: image usage is declared on the builder per pass and coalesced into a single
+ *   transition batch when the pass begins (see rvk_pass_begin).
+ * - Transient memory: attachments are acquired from a pool and released as soon as no later pass
+ *   reads them; the pool recycles them within the frame and frees them when unused (attach.c).
+ */
 static bool rend_canvas_paint_3d(
     EcsWorld*                     world,
     RendPainterComp*              painter,
@@ -608,15 +650,39 @@ static bool rend_canvas_paint_3d(
   }
 
   // Shadow pass.
-  const bool    shadActive = (set->flags & RendFlags_Shadows) && rend_light_has_shadow(light);
-  const RvkSize shadSize   = shadActive ? rvk_size_square(set->shadowResolution) : rvk_size_one;
-  RvkPass*      shadPass   = platform->passes[AssetGraphicPass_Shadow];
-  RvkImage*     shadDepth  = rend_builder_attach_acquire_depth(b, shadPass, shadSize);
-  if (shadActive) {
+  const bool       shadActive = (set->flags & RendFlags_Shadows) && rend_light_has_shadow(light);
+  const RvkSize    shadSize  = shadActive ? rvk_size_square(set->shadowResolution) : rvk_size_one;
+  RvkPass*         shadPass  = platform->passes[AssetGraphicPass_Shadow];
+  const GeoMatrix* shadTrans = shadActive ? rend_light_shadow_trans(light) : null;
+  const GeoMatrix* shadProj  = shadActive ? rend_light_shadow_proj(light) : null;
+  const bool       shadCache = shadActive && (set->flags & RendFlags_ShadowCache) != 0;
+
+  // Release the retained shadow map when caching is disabled or the resolution changed.
+  if (painter->shadowCache &&
+      (!shadCache || !rvk_size_equal(painter->shadowCache->size, shadSize))) {
+    rend_builder_attach_release(b, painter->shadowCache);
+    painter->shadowCache = null;
+  }
+
+  bool      shadRender = shadActive;
+  RvkImage* shadDepth;
+  if (shadCache) {
+    const u32 shadHash = painter_shadow_hash(objView, resView, shadTrans, shadProj);
+    if (painter->shadowCache && painter->shadowCacheHash == shadHash) {
+      shadRender = false; // Cached shadow map is still valid; skip re-rendering the casters.
+    }
+    if (!painter->shadowCache) {
+      painter->shadowCache = rend_builder_attach_acquire_depth(b, shadPass, shadSize);
+    }
+    painter->shadowCacheHash = shadHash;
+    shadDepth                = painter->shadowCache;
+  } else {
+    shadDepth = rend_builder_attach_acquire_depth(b, shadPass, shadSize);
+  }
+
+  if (shadRender) {
     rend_builder_pass_push(b, shadPass);
 
-    const GeoMatrix*    shadTrans  = rend_light_shadow_trans(light);
-    const GeoMatrix*    shadProj   = rend_light_shadow_proj(light);
     const RendTagFilter shadFilter = {.required = RendTags_ShadowCaster, .illegal = 0};
     const RendView   shadView = painter_view_3d_create(shadTrans, shadProj, camEntity, shadFilter);
     RendPaintContext ctx      = painter_context(b, set, setGlobal, shadView);
@@ -625,7 +691,7 @@ static bool rend_canvas_paint_3d(
     painter_push_shadow(&ctx, objView, resView);
 
     rend_builder_pass_flush(b);
-  } else {
+  } else if (!shadActive) {
     rend_builder_img_clear_depth(b, shadDepth, 0);
   }
 
@@ -725,7 +791,9 @@ static bool rend_canvas_paint_3d(
   }
 
   rend_builder_attach_release(b, fwdColor);
-  rend_builder_attach_release(b, shadDepth);
+  if (shadDepth != painter->shadowCache) {
+    rend_builder_attach_release(b, shadDepth);
+  }
 
   rend_builder_canvas_flush(b, presentFrequency);
   return true;
@@ -4,6 +4,10 @@
 
 #include "forward.h"
 
-ecs_comp_extern_public(RendPainterComp) { RvkCanvas* canvas; };
+ecs_comp_extern_public(RendPainterComp) {
+  RvkCanvas* canvas;
+  RvkImage*  shadowCache; // Retained shadow map; valid while 'shadowCacheHash' is unchanged.
+  u32        shadowCacheHash;
+};
 
 void rend_painter_teardown(EcsWorld* world, EcsEntityId entity);
@@ -4,6 +4,7 @@
 void rend_register(EcsDef* def, const RendRegisterContext* ctx) {
   ecs_register_module_ctx(def, rend_camera_module, ctx);
   ecs_register_module_ctx(def, rend_error_module, ctx);
+  ecs_register_module_ctx(def, rend_governor_module, ctx);
   ecs_register_module_ctx(def, rend_light_module, ctx);
   ecs_register_module_ctx(def, rend_limiter_module, ctx);
   ecs_register_module_ctx(def, rend_object_module, ctx);
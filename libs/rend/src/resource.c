@@ -12,6 +12,7 @@
 #include "log/logger.h"
 #include "rend/register.h"
 #include "rend/report.h"
+#include "rend/settings.h"
 #include "rvk/device.h"
 #include "rvk/graphic.h"
 #include "rvk/mesh.h"
@@ -31,6 +32,11 @@
  */
 #define rend_res_unload_delay 500
 
+/**
+ * Pattern of graphic assets to prewarm at startup.
+ */
+static const String g_rendResPrewarmPattern = string_static("graphics/*.graphic");
+
 typedef struct {
   RvkRepositoryId repoId;
   String          assetId;
@@ -273,6 +279,39 @@ ecs_system_define(RendGlobalResourceUpdateSys) {
   }
 }
 
+ecs_comp_define(RendResPrewarmedComp);
+
+ecs_view_define(ResPrewarmView) {
+  ecs_access_read(RendSettingsGlobalComp);
+  ecs_access_write(AssetManagerComp);
+  ecs_access_without(RendResPrewarmedComp);
+}
+
+/**
+ * Request all graphic assets at startup so their pipelines are compiled (and the pipeline cache is
+ * warmed) before first use, instead of stalling a frame during gameplay.
+ */
+ecs_system_define(RendResPrewarmSys) {
+  if (ecs_world_has_t(world, ecs_world_global(world), RendResetComp)) {
+    return; // Renderer is in the process of being reset.
+  }
+  EcsIterator* itr = ecs_view_first(ecs_world_view_t(world, ResPrewarmView));
+  if (!itr) {
+    return;
+  }
+  const RendSettingsGlobalComp* settings = ecs_view_read_t(itr, RendSettingsGlobalComp);
+  if (settings->flags & RendGlobalFlags_Prewarm) {
+    AssetManagerComp* assetManager = ecs_view_write_t(itr, AssetManagerComp);
+    EcsEntityId       assets[asset_query_max_results];
+    const u32         assetCount = asset_query(world, assetManager, g_rendResPrewarmPattern, assets);
+    for (u32 i = 0; i != assetCount; ++i) {
+      rend_res_request_internal(world, assets[i], RendResFlags_None);
+    }
+    log_i("Prewarming render resources", log_param("count", fmt_int(assetCount)));
+  }
+  ecs_world_add_empty_t(world, ecs_view_entity(itr), RendResPrewarmedComp);
+}
+
 ecs_view_define(ResLoadView) {
   ecs_access_without(RendResFinishedComp);
   ecs_access_read(AssetComp);
@@ -787,6 +826,7 @@ ecs_module_init(rend_resource_module) {
   ecs_register_comp(RendResUnloadComp, .combinator = ecs_combine_resource_unload);
   ecs_register_comp_empty(RendResGlobalInitializedComp);
   ecs_register_comp_empty(RendResGlobalComp);
+  ecs_register_comp_empty(RendResPrewarmedComp);
 
   ecs_register_view(PlatReadView);
   ecs_register_view(ResWriteView);
@@ -799,6 +839,8 @@ ecs_module_init(rend_resource_module) {
       ecs_register_view(GlobalResourceInitView),
       ecs_register_view(GlobalResourceRequestView));
 
+  ecs_register_system(RendResPrewarmSys, ecs_register_view(ResPrewarmView));
+
   ecs_register_system(
       RendResLoadSys,
       ecs_view_id(PlatReadView),
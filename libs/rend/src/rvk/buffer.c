@@ -12,6 +12,8 @@ static RvkMemLoc rvk_buffer_type_loc(const RvkBufferType type) {
     return RvkMemLoc_Dev;
   case RvkBufferType_HostUniform:
   case RvkBufferType_HostTransfer:
+  case RvkBufferType_HostIndirect:
+  case RvkBufferType_HostReadback:
     return RvkMemLoc_Host;
   case RvkBufferType_Count:
     break;
@@ -29,6 +31,10 @@ static VkBufferUsageFlags rvk_buffer_usage_flags(const RvkBufferType type) {
     return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
   case RvkBufferType_HostTransfer:
     return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  case RvkBufferType_HostIndirect:
+    return VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+  case RvkBufferType_HostReadback:
+    return VK_BUFFER_USAGE_TRANSFER_DST_BIT;
   case RvkBufferType_Count:
     break;
   }
@@ -109,6 +115,8 @@ String rvk_buffer_type_str(const RvkBufferType type) {
       string_static("DeviceStorage"),
       string_static("HostUniform"),
       string_static("HostTransfer"),
+      string_static("HostIndirect"),
+      string_static("HostReadback"),
   };
   ASSERT(array_elems(g_names) == RvkBufferType_Count, "Incorrect number of buffer-type names");
   return g_names[type];
@@ -144,6 +152,13 @@ void rvk_buffer_flush_batch(const RvkBufferFlush flushes[], const u32 count) {
   rvk_mem_flush_batch(memFlushes, count);
 }
 
+void rvk_buffer_invalidate(const RvkBuffer* buffer, const u64 offset, const u64 size) {
+  diag_assert(rvk_buffer_type_loc(buffer->type) == RvkMemLoc_Host);
+
+  // TODO: Refactor the underlying memory-pool to use 64 bit size and offsets.
+  rvk_mem_invalidate(buffer->mem, (u32)offset, (u32)size);
+}
+
 void rvk_buffer_upload(RvkBuffer* buffer, const Mem data, const u64 offset) {
   diag_assert(data.size + offset <= buffer->size);
   diag_assert(rvk_buffer_type_loc(buffer->type) == RvkMemLoc_Host);
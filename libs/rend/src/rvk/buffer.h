@@ -9,6 +9,8 @@ typedef enum {
   RvkBufferType_DeviceStorage,
   RvkBufferType_HostUniform,
   RvkBufferType_HostTransfer,
+  RvkBufferType_HostIndirect,
+  RvkBufferType_HostReadback,
 
   RvkBufferType_Count,
 } RvkBufferType;
@@ -39,6 +41,12 @@ typedef struct {
 void rvk_buffer_flush(const RvkBuffer*, u64 offset, u64 size);
 void rvk_buffer_flush_batch(const RvkBufferFlush[], u32 count);
 
+/**
+ * Make device writes to the buffer visible to the cpu.
+ * NOTE: Requires the buffer to be host-visible.
+ */
+void rvk_buffer_invalidate(const RvkBuffer*, u64 offset, u64 size);
+
 /**
  * Copies the given data to the buffer.
  * NOTE: Requires the buffer to be host-visible.
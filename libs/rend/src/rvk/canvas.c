@@ -192,7 +192,16 @@ static void rvk_canvas_push_traces_gpu(const RvkCanvasFrame* frame, const RvkJob
         RvkPassStatsInvoc stats;
         rvk_pass_stats_invoc(pass, passFrame, invocIdx, &stats);
 
-        trace_custom_begin_msg("gpu", "pass", TraceColor_Green, "pass-{}", fmt_text(passName));
+        trace_custom_begin_msg(
+            "gpu",
+            "pass",
+            TraceColor_Green,
+            "pass-{} [draws: {}, inst: {}, vert: {}, frag: {}]",
+            fmt_text(passName),
+            fmt_int(stats.draws),
+            fmt_int(stats.instances),
+            fmt_int(stats.shadersVert),
+            fmt_int(stats.shadersFrag));
         const TimeDuration dur = time_steady_duration(stats.gpuTimeBegin, stats.gpuTimeEnd);
         trace_custom_end("gpu", stats.gpuTimeBegin, dur);
       }
@@ -337,6 +346,10 @@ bool rvk_canvas_swapchain_can_throttle(const RvkCanvas* canvas) {
   return rvk_swapchain_can_throttle(canvas->swapchain);
 }
 
+TimeSteady rvk_canvas_last_present_time(const RvkCanvas* canvas) {
+  return rvk_swapchain_last_present_time(canvas->swapchain);
+}
+
 RvkImage* rvk_canvas_swapchain_image(RvkCanvas* canvas) {
   diag_assert_msg(canvas->flags & RvkCanvasFlags_Active, "Canvas not active");
 
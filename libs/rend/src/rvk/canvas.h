@@ -47,6 +47,12 @@ void        rvk_canvas_phase_output(RvkCanvas*);
 void      rvk_canvas_swapchain_stats(const RvkCanvas*, RvkSwapchainStats* out);
 RvkSize   rvk_canvas_swapchain_size(const RvkCanvas*);
 bool      rvk_canvas_swapchain_can_throttle(const RvkCanvas*);
+
+/**
+ * Retrieve the time at which the newest observed presentation was shown to the user.
+ * NOTE: Returns 0 if the presentation engine does not report present timing.
+ */
+TimeSteady rvk_canvas_last_present_time(const RvkCanvas*);
 RvkImage* rvk_canvas_swapchain_image(RvkCanvas*); // NOTE: Can return null if acquire failed.
 
 void rvk_canvas_end(RvkCanvas*, u16 presentFrequency);
@@ -22,6 +22,11 @@ typedef struct {
   VkDescriptorSetLayout vkLayout;
 } RvkDescLayout;
 
+typedef struct {
+  u32              layoutsHash;
+  VkPipelineLayout vkPipelineLayout;
+} RvkPipelineLayout;
+
 struct sRvkDescChunk {
   RvkDescPool*     pool;
   RvkDescChunk*    next;
@@ -34,7 +39,8 @@ struct sRvkDescChunk {
 struct sRvkDescPool {
   RvkDevice*    dev;
   ThreadMutex   layoutLock;
-  DynArray      layouts; // RvkDescLayout[], kept sorted on the metaHash.
+  DynArray      layouts;         // RvkDescLayout[], kept sorted on the metaHash.
+  DynArray      pipelineLayouts; // RvkPipelineLayout[], kept sorted on the layoutsHash.
   ThreadMutex   chunkLock;
   RvkDescChunk* chunkHead;
   RvkDescChunk* chunkTail;
@@ -49,6 +55,11 @@ static i8 rvk_desc_compare_layout(const void* a, const void* b) {
   return compare_u32(field_ptr(a, RvkDescLayout, metaHash), field_ptr(b, RvkDescLayout, metaHash));
 }
 
+static i8 rvk_desc_compare_pipeline_layout(const void* a, const void* b) {
+  return compare_u32(
+      field_ptr(a, RvkPipelineLayout, layoutsHash), field_ptr(b, RvkPipelineLayout, layoutsHash));
+}
+
 static BitSet rvk_desc_chunk_mask(const RvkDescChunk* chunk) {
   return bitset_from_array(chunk->freeSets);
 }
@@ -227,10 +238,11 @@ RvkDescPool* rvk_desc_pool_create(RvkDevice* dev) {
   RvkDescPool* pool = alloc_alloc_t(g_allocHeap, RvkDescPool);
 
   *pool = (RvkDescPool){
-      .dev        = dev,
-      .layoutLock = thread_mutex_create(g_allocHeap),
-      .layouts    = dynarray_create_t(g_allocHeap, RvkDescLayout, 64),
-      .chunkLock  = thread_mutex_create(g_allocHeap),
+      .dev             = dev,
+      .layoutLock      = thread_mutex_create(g_allocHeap),
+      .layouts         = dynarray_create_t(g_allocHeap, RvkDescLayout, 64),
+      .pipelineLayouts = dynarray_create_t(g_allocHeap, RvkPipelineLayout, 16),
+      .chunkLock       = thread_mutex_create(g_allocHeap),
   };
 
   return pool;
@@ -249,6 +261,10 @@ void rvk_desc_pool_destroy(RvkDescPool* pool) {
   // Destroy all layouts.
   RvkDevice* dev = pool->dev;
   thread_mutex_destroy(pool->layoutLock);
+  dynarray_for_t(&pool->pipelineLayouts, RvkPipelineLayout, layout) {
+    rvk_call(dev, destroyPipelineLayout, dev->vkDev, layout->vkPipelineLayout, &dev->vkAlloc);
+  }
+  dynarray_destroy(&pool->pipelineLayouts);
   dynarray_for_t(&pool->layouts, RvkDescLayout, layout) {
     rvk_call(dev, destroyDescriptorSetLayout, dev->vkDev, layout->vkLayout, &dev->vkAlloc);
   }
@@ -324,6 +340,51 @@ VkDescriptorSetLayout rvk_desc_vklayout(RvkDescPool* pool, const RvkDescMeta* me
   return result;
 }
 
+VkPipelineLayout rvk_desc_pipeline_vklayout(
+    RvkDescPool* pool, const VkDescriptorSetLayout setLayouts[], const u32 setLayoutCount) {
+  const Mem setLayoutsMem = mem_create(setLayouts, sizeof(VkDescriptorSetLayout) * setLayoutCount);
+  const u32 hash          = bits_hash_32(setLayoutsMem);
+
+  thread_mutex_lock(pool->layoutLock);
+
+  // Find an existing pipeline-layout with the same set-layouts or create a new one.
+  RvkPipelineLayout* tgt    = mem_struct(RvkPipelineLayout, .layoutsHash = hash).ptr;
+  RvkPipelineLayout* layout = dynarray_find_or_insert_sorted(
+      &pool->pipelineLayouts, rvk_desc_compare_pipeline_layout, tgt);
+
+  if (layout->layoutsHash != hash) {
+    const VkPipelineLayoutCreateInfo layoutInfo = {
+        .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = setLayoutCount,
+        .pSetLayouts    = setLayouts,
+    };
+    VkPipelineLayout vkPipelineLayout;
+    rvk_call_checked(
+        pool->dev,
+        createPipelineLayout,
+        pool->dev->vkDev,
+        &layoutInfo,
+        &pool->dev->vkAlloc,
+        &vkPipelineLayout);
+
+    *layout = (RvkPipelineLayout){
+        .layoutsHash      = hash,
+        .vkPipelineLayout = vkPipelineLayout,
+    };
+
+#if defined(VOLO_RVK_DESC_LOGGING)
+    log_d(
+        "Vulkan pipeline layout created",
+        log_param("set-layouts", fmt_int(setLayoutCount)),
+        log_param("layouts-hash", fmt_int(hash)));
+#endif
+  }
+
+  const VkPipelineLayout result = layout->vkPipelineLayout;
+  thread_mutex_unlock(pool->layoutLock);
+  return result;
+}
+
 RvkDescSet rvk_desc_alloc(RvkDescPool* pool, const RvkDescMeta* meta) {
   RvkDescSet result = {0};
   const u32  hash   = rvk_desc_meta_hash(meta);
@@ -553,6 +614,105 @@ void rvk_desc_set_clear_batch(const RvkDescSet sets[], const usize count) {
   rvk_call(dev, updateDescriptorSets, dev->vkDev, writesCount, writes, 0, null);
 }
 
+RvkDescBindless rvk_desc_bindless_create(RvkDescPool* pool, const u32 count) {
+  RvkDevice* dev = pool->dev;
+  diag_assert_msg(dev->flags & RvkDeviceFlags_SupportBindless, "Device does not support bindless");
+
+  const VkDescriptorBindingFlagsEXT bindingFlags =
+      VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+      VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT |
+      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+      VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT;
+  const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsInfo = {
+      .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT,
+      .bindingCount  = 1,
+      .pBindingFlags = &bindingFlags,
+  };
+  const VkDescriptorSetLayoutBinding binding = {
+      .binding         = 0,
+      .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .descriptorCount = count,
+      .stageFlags      = VK_SHADER_STAGE_ALL_GRAPHICS,
+  };
+  const VkDescriptorSetLayoutCreateInfo layoutInfo = {
+      .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+      .pNext        = &bindingFlagsInfo,
+      .flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT,
+      .bindingCount = 1,
+      .pBindings    = &binding,
+  };
+  VkDescriptorSetLayout vkLayout;
+  rvk_call_checked(
+      dev, createDescriptorSetLayout, dev->vkDev, &layoutInfo, &dev->vkAlloc, &vkLayout);
+
+  const VkDescriptorPoolSize poolSize = {
+      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .descriptorCount = count,
+  };
+  const VkDescriptorPoolCreateInfo poolInfo = {
+      .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+      .flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT,
+      .poolSizeCount = 1,
+      .pPoolSizes    = &poolSize,
+      .maxSets       = 1,
+  };
+  VkDescriptorPool vkPool;
+  rvk_call_checked(dev, createDescriptorPool, dev->vkDev, &poolInfo, &dev->vkAlloc, &vkPool);
+
+  const VkDescriptorSetVariableDescriptorCountAllocateInfoEXT countInfo = {
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT,
+      .descriptorSetCount = 1,
+      .pDescriptorCounts  = &count,
+  };
+  const VkDescriptorSetAllocateInfo allocInfo = {
+      .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+      .pNext              = &countInfo,
+      .descriptorPool     = vkPool,
+      .descriptorSetCount = 1,
+      .pSetLayouts        = &vkLayout,
+  };
+  VkDescriptorSet vkSet;
+  rvk_call_checked(dev, allocateDescriptorSets, dev->vkDev, &allocInfo, &vkSet);
+
+  return (RvkDescBindless){.vkLayout = vkLayout, .vkPool = vkPool, .vkSet = vkSet, .count = count};
+}
+
+void rvk_desc_bindless_destroy(RvkDescPool* pool, RvkDescBindless* bindless) {
+  RvkDevice* dev = pool->dev;
+  rvk_call(dev, destroyDescriptorPool, dev->vkDev, bindless->vkPool, &dev->vkAlloc);
+  rvk_call(dev, destroyDescriptorSetLayout, dev->vkDev, bindless->vkLayout, &dev->vkAlloc);
+  *bindless = (RvkDescBindless){0};
+}
+
+void rvk_desc_bindless_update(
+    RvkDescPool*           pool,
+    const RvkDescBindless* bindless,
+    const u32              index,
+    const RvkImage*        image,
+    const RvkSamplerSpec   spec) {
+
+  diag_assert(index < bindless->count);
+  diag_assert(image->caps & RvkImageCapability_Sampled);
+
+  RvkDevice* dev = pool->dev;
+
+  const VkDescriptorImageInfo imageInfo = {
+      .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      .imageView   = image->vkImageView,
+      .sampler     = rvk_sampler_get(dev->samplerPool, spec),
+  };
+  const VkWriteDescriptorSet write = {
+      .sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+      .dstSet          = bindless->vkSet,
+      .dstBinding      = 0,
+      .dstArrayElement = index,
+      .descriptorType  = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .descriptorCount = 1,
+      .pImageInfo      = &imageInfo,
+  };
+  rvk_call(dev, updateDescriptorSets, dev->vkDev, 1, &write, 0, null);
+}
+
 void rvk_desc_update_buffer(
     RvkDescUpdateBatch* batch,
     const RvkDescSet    set,
@@ -40,6 +40,13 @@ u16          rvk_desc_pool_layouts(const RvkDescPool*);
 
 bool                  rvk_desc_empty(const RvkDescMeta*);
 VkDescriptorSetLayout rvk_desc_vklayout(RvkDescPool*, const RvkDescMeta*);
+
+/**
+ * Retrieve a pipeline-layout for the given combination of descriptor-set layouts.
+ * Identical combinations share a single pipeline-layout; the pool owns the returned object.
+ */
+VkPipelineLayout rvk_desc_pipeline_vklayout(
+    RvkDescPool*, const VkDescriptorSetLayout setLayouts[], u32 setLayoutCount);
 RvkDescSet            rvk_desc_alloc(RvkDescPool*, const RvkDescMeta*);
 void                  rvk_desc_free(RvkDescSet);
 void                  rvk_desc_free_batch(const RvkDescSet[], usize count); // NOTE: Same pool only.
@@ -56,6 +63,24 @@ void                  rvk_desc_set_name(RvkDescSet, String dbgName);
 void rvk_desc_set_clear(RvkDescSet);
 void rvk_desc_set_clear_batch(const RvkDescSet[], usize count); // NOTE: Same pool only.
 
+/**
+ * Bindless descriptor-set: a single large, partially-bound array of combined-image-samplers that
+ * can be updated after binding. Texture indices into the array can flow through per-instance data,
+ * avoiding a descriptor-set rebind per texture switch.
+ * Pre-condition: Device has 'RvkDeviceFlags_SupportBindless'.
+ */
+typedef struct sRvkDescBindless {
+  VkDescriptorSetLayout vkLayout;
+  VkDescriptorPool      vkPool;
+  VkDescriptorSet       vkSet;
+  u32                   count;
+} RvkDescBindless;
+
+RvkDescBindless rvk_desc_bindless_create(RvkDescPool*, u32 count);
+void            rvk_desc_bindless_destroy(RvkDescPool*, RvkDescBindless*);
+void            rvk_desc_bindless_update(
+               RvkDescPool*, const RvkDescBindless*, u32 index, const RvkImage*, RvkSamplerSpec);
+
 typedef enum {
   RvkDescUpdateType_Buffer,
   RvkDescUpdateType_Sampler,
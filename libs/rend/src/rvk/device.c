@@ -12,6 +12,7 @@
 #include "lib.h"
 #include "mem.h"
 #include "pcache.h"
+#include "readback.h"
 #include "repository.h"
 #include "sampler.h"
 #include "transfer.h"
@@ -125,6 +126,13 @@ static void rvk_config_present_wait(RvkDevice* d, VkPhysicalDevicePresentWait2Fe
   }
 }
 
+static void
+rvk_config_timeline_semaphore(RvkDevice* d, VkPhysicalDeviceTimelineSemaphoreFeatures* f) {
+  if (f->timelineSemaphore) {
+    d->flags |= RvkDeviceFlags_SupportTimelineSemaphore;
+  }
+}
+
 static void rvk_config_present_timing(RvkDevice* d, VkPhysicalDevicePresentTimingFeaturesEXT* f) {
   if (f->presentTiming) {
     d->flags |= RvkDeviceFlags_SupportPresentTiming;
@@ -146,6 +154,28 @@ static void rvk_config_executable_properties(
   }
 }
 
+static void
+rvk_config_descriptor_indexing(RvkDevice* d, VkPhysicalDeviceDescriptorIndexingFeaturesEXT* f) {
+  const bool support = f->shaderSampledImageArrayNonUniformIndexing && f->runtimeDescriptorArray &&
+                       f->descriptorBindingPartiallyBound &&
+                       f->descriptorBindingSampledImageUpdateAfterBind &&
+                       f->descriptorBindingVariableDescriptorCount &&
+                       f->descriptorBindingUpdateUnusedWhilePending;
+  *f = (VkPhysicalDeviceDescriptorIndexingFeaturesEXT){
+      .sType = f->sType,
+      .pNext = f->pNext,
+  };
+  if (support) {
+    f->shaderSampledImageArrayNonUniformIndexing    = true;
+    f->runtimeDescriptorArray                       = true;
+    f->descriptorBindingPartiallyBound              = true;
+    f->descriptorBindingSampledImageUpdateAfterBind = true;
+    f->descriptorBindingVariableDescriptorCount     = true;
+    f->descriptorBindingUpdateUnusedWhilePending    = true;
+    d->flags |= RvkDeviceFlags_SupportBindless;
+  }
+}
+
 static void rvk_config_16bit_storage(RvkDevice* d, VkPhysicalDevice16BitStorageFeatures* f) {
   (void)d;
   f->storageBuffer16BitAccess           = true; // Required.
@@ -176,6 +206,11 @@ static void rvk_config_features(RvkDevice* d, VkPhysicalDeviceFeatures* f) {
     result.depthClamp = true;
     d->flags |= RvkDeviceFlags_SupportDepthClamp;
   }
+  if (f->multiDrawIndirect && f->drawIndirectFirstInstance) {
+    result.multiDrawIndirect         = true;
+    result.drawIndirectFirstInstance = true;
+    d->flags |= RvkDeviceFlags_SupportMultiDrawIndirect;
+  }
   *f = result;
 }
 
@@ -206,23 +241,54 @@ static u32 rvk_pick_transfer_queue(RvkLib* lib, VkPhysicalDevice vkPhysDev) {
   VkQueueFamilyProperties* arr = alloc_array_t(g_allocScratch, VkQueueFamilyProperties, count);
   rvk_call(lib, getPhysicalDeviceQueueFamilyProperties, vkPhysDev, &count, arr);
 
+  /**
+   * Graphics queues also support transfer operations, so we look for a separate family that can
+   * transfer without interfering with rendering: ideally a dedicated transfer-only family,
+   * otherwise any transfer-capable family (for example a compute family) that is not the graphics
+   * family. When no such family exists we fall back to using the graphics queue for transfer.
+   */
+  u32 bestQueue = sentinel_u32;
+  i32 bestScore = -1;
   for (u32 i = 0; i != count; ++i) {
-    /**
-     * Graphics queues also support transfer operations, so we try to find a queue that exclusively
-     * does transferring otherwise fall back to using the graphics queue for transfer.
-     */
     const bool hasTransfer = (arr[i].queueFlags & VK_QUEUE_TRANSFER_BIT) != 0;
     const bool hasGraphics = (arr[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
     const bool hasCompute  = (arr[i].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
-    if (hasTransfer && !hasGraphics && !hasCompute) {
-      return i;
+    if (hasGraphics) {
+      continue; // Rendering happens on the graphics family; no gain in transferring there.
+    }
+    if (!hasTransfer && !hasCompute) {
+      continue; // NOTE: Compute queues support transfer even without the transfer bit.
+    }
+    const i32 score = (hasTransfer && !hasCompute) ? 2 : 1; // Prefer a dedicated transfer family.
+    if (score > bestScore) {
+      bestScore = score;
+      bestQueue = i;
     }
   }
+  return bestQueue;
 
 NoTransferQueue:
   return sentinel_u32;
 }
 
+/**
+ * Create the timeline semaphore used to track submissions on the graphics queue; a single
+ * monotonically increasing counter that every submission signals (avoids per-frame fence churn).
+ */
+static VkSemaphore rvk_timeline_semaphore_create(RvkDevice* dev) {
+  const VkSemaphoreTypeCreateInfo typeInfo = {
+      .sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+      .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+  };
+  const VkSemaphoreCreateInfo semaphoreInfo = {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+      .pNext = &typeInfo,
+  };
+  VkSemaphore result;
+  rvk_call_checked(dev, createSemaphore, dev->vkDev, &semaphoreInfo, &dev->vkAlloc, &result);
+  return result;
+}
+
 static VkPhysicalDevice rvk_pick_physical_device(RvkLib* lib) {
   VkPhysicalDevice vkPhysDevs[32];
   u32              vkPhysDevsCount = array_elems(vkPhysDevs);
@@ -371,6 +437,24 @@ static VkDevice rvk_device_create_internal(RvkLib* lib, RvkDevice* dev) {
     extsToEnable[extsToEnableCount++] = VK_EXT_robustness2;
   }
 
+  VkPhysicalDeviceDescriptorIndexingFeaturesEXT featureDescriptorIndexing = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+      .pNext = nextFeature,
+  };
+  if (rvk_has_ext(supportedExts, string_from_null_term(VK_EXT_descriptor_indexing))) {
+    nextFeature                       = &featureDescriptorIndexing;
+    extsToEnable[extsToEnableCount++] = VK_EXT_descriptor_indexing;
+  }
+
+  VkPhysicalDeviceTimelineSemaphoreFeatures featureTimelineSemaphore = {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+      .pNext = nextFeature,
+  };
+  if (rvk_has_ext(supportedExts, string_from_null_term(VK_KHR_timeline_semaphore))) {
+    nextFeature                       = &featureTimelineSemaphore;
+    extsToEnable[extsToEnableCount++] = VK_KHR_timeline_semaphore;
+  }
+
   VkPhysicalDevicePresentId2FeaturesKHR featurePresentId = {
       .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_2_FEATURES_KHR,
       .pNext = nextFeature,
@@ -420,6 +504,8 @@ static VkDevice rvk_device_create_internal(RvkLib* lib, RvkDevice* dev) {
   rvk_call(lib, getPhysicalDeviceFeatures2, dev->vkPhysDev, &featureBase);
 
   rvk_config_robustness2(dev, &featureRobustness);
+  rvk_config_descriptor_indexing(dev, &featureDescriptorIndexing);
+  rvk_config_timeline_semaphore(dev, &featureTimelineSemaphore);
   rvk_config_present_id(dev, &featurePresentId);
   rvk_config_present_wait(dev, &featurePresentWait);
   rvk_config_present_timing(dev, &featurePresentTiming);
@@ -519,6 +605,10 @@ RvkDevice* rvk_device_create(RvkLib* lib) {
   if (!sentinel_check(dev->transferQueueIndex)) {
     rvk_call(dev, getDeviceQueue, dev->vkDev, dev->transferQueueIndex, 0, &dev->vkTransferQueue);
   }
+  if (dev->flags & RvkDeviceFlags_SupportTimelineSemaphore) {
+    dev->vkGraphicsTimeline = rvk_timeline_semaphore_create(dev);
+    rvk_debug_name_semaphore(dev, dev->vkGraphicsTimeline, "graphics_timeline");
+  }
 
   dev->depthFormat              = rvk_pick_depthformat(dev);
   dev->preferredSwapchainFormat = VK_FORMAT_B8G8R8A8_SRGB;
@@ -537,6 +627,7 @@ RvkDevice* rvk_device_create(RvkLib* lib) {
   dev->descPool        = rvk_desc_pool_create(dev);
   dev->samplerPool     = rvk_sampler_pool_create(dev);
   dev->transferer      = rvk_transferer_create(dev);
+  dev->readbacker      = rvk_readbacker_create(dev);
   dev->repository      = rvk_repository_create();
 
   log_i(
@@ -547,7 +638,8 @@ RvkDevice* rvk_device_create(RvkLib* lib) {
       log_param("depth-format", fmt_text(vkFormatStr(dev->depthFormat))),
       log_param("null-descriptor", fmt_bool(dev->flags & RvkDeviceFlags_SupportNullDescriptor)),
       log_param("present-id", fmt_bool(dev->flags & RvkDeviceFlags_SupportPresentId)),
-      log_param("present-wait", fmt_bool(dev->flags & RvkDeviceFlags_SupportPresentWait)));
+      log_param("present-wait", fmt_bool(dev->flags & RvkDeviceFlags_SupportPresentWait)),
+      log_param("timeline", fmt_bool(dev->flags & RvkDeviceFlags_SupportTimelineSemaphore)));
 
   return dev;
 }
@@ -560,10 +652,14 @@ void rvk_device_destroy(RvkDevice* dev) {
   rvk_call(dev, destroyPipelineCache, dev->vkDev, dev->vkPipelineCache, &dev->vkAlloc);
 
   rvk_repository_destroy(dev->repository);
+  rvk_readbacker_destroy(dev->readbacker);
   rvk_transferer_destroy(dev->transferer);
   rvk_sampler_pool_destroy(dev->samplerPool);
   rvk_desc_pool_destroy(dev->descPool);
   rvk_mem_pool_destroy(dev->memPool);
+  if (dev->vkGraphicsTimeline) {
+    rvk_call(dev, destroySemaphore, dev->vkDev, dev->vkGraphicsTimeline, &dev->vkAlloc);
+  }
   rvk_call(dev, destroyDevice, dev->vkDev, &dev->vkAlloc);
 
   string_maybe_free(g_allocHeap, dev->driverName);
@@ -610,6 +706,9 @@ void rvk_device_update(RvkDevice* dev) {
 
   // Submit any pending transfers.
   rvk_transfer_flush(dev->transferer);
+
+  // Submit any pending readbacks and retire finished ones.
+  rvk_readback_flush(dev->readbacker);
 }
 
 void rvk_device_wait_idle(const RvkDevice* dev) {
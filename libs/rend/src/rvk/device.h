@@ -22,6 +22,9 @@ typedef enum {
   RvkDeviceFlags_SupportExecutableInfo       = 1 << 13,
   RvkDeviceFlags_SupportDriverProperties     = 1 << 14,
   RvkDeviceFlags_SupportCalibratedTimestamps = 1 << 15,
+  RvkDeviceFlags_SupportMultiDrawIndirect    = 1 << 16,
+  RvkDeviceFlags_SupportBindless             = 1 << 17,
+  RvkDeviceFlags_SupportTimelineSemaphore    = 1 << 18,
 } RvkDeviceFlags;
 
 typedef struct sRvkDevice {
@@ -38,11 +41,14 @@ typedef struct sRvkDevice {
   u32                              graphicsQueueIndex;
   u32                              transferQueueIndex; // sentinel_u32 if unavailable.
   VkQueue                          vkGraphicsQueue, vkTransferQueue;
+  VkSemaphore                      vkGraphicsTimeline;    // If 'SupportTimelineSemaphore' is set.
+  u64                              graphicsTimelineValue; // Guarded by 'queueSubmitMutex'.
   VkPipelineCache                  vkPipelineCache;
   RvkMemPool*                      memPool;
   RvkDescPool*                     descPool;
   RvkSamplerPool*                  samplerPool;
   RvkTransferer*                   transferer;
+  RvkReadbacker*                   readbacker;
   RvkRepository*                   repository;
   u64    memBudgetTotal, memBudgetUsed; // Only available if 'SupportMemoryBudget' flag is set.
   String driverName;                    // Only available if 'SupportDriverProperties' flag is set.
@@ -30,6 +30,7 @@ typedef struct sRvkLib             RvkLib;
 typedef struct sRvkMemPool         RvkMemPool;
 typedef struct sRvkMesh            RvkMesh;
 typedef struct sRvkPass            RvkPass;
+typedef struct sRvkReadbacker      RvkReadbacker;
 typedef struct sRvkRepository      RvkRepository;
 typedef struct sRvkSamplerPool     RvkSamplerPool;
 typedef struct sRvkSamplerSpec     RvkSamplerSpec;
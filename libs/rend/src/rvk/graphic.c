@@ -194,19 +194,16 @@ rvk_pipeline_layout_create(const RvkGraphic* graphic, RvkDevice* dev, const RvkP
       rvk_desc_set_vklayout(graphic->graphicDescSet),
       rvk_desc_vklayout(dev->descPool, &instanceDescMeta),
   };
-  const VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
-      .sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-      .setLayoutCount = array_elems(descriptorLayouts),
-      .pSetLayouts    = descriptorLayouts,
-  };
-  VkPipelineLayout result;
-  rvk_call_checked(
-      dev, createPipelineLayout, dev->vkDev, &pipelineLayoutInfo, &dev->vkAlloc, &result);
-  return result;
+  // NOTE: Pipeline-layouts are shared between graphics with the same set-layouts.
+  return rvk_desc_pipeline_vklayout(
+      dev->descPool, descriptorLayouts, array_elems(descriptorLayouts));
 }
 
 static VkPipelineShaderStageCreateInfo rvk_pipeline_shader(
-    const RvkShader* shader, const AssetGraphicOverride* overrides, const usize overrideCount) {
+    const RvkShader*            shader,
+    RvkDevice*                  dev,
+    const AssetGraphicOverride* overrides,
+    const usize                 overrideCount) {
   VkSpecializationInfo* specialization = alloc_alloc_t(g_allocScratch, VkSpecializationInfo);
 
   *specialization = rvk_shader_specialize_scratch(shader, overrides, overrideCount);
@@ -214,7 +211,7 @@ static VkPipelineShaderStageCreateInfo rvk_pipeline_shader(
   return (VkPipelineShaderStageCreateInfo){
       .sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
       .stage               = shader->vkStage,
-      .module              = shader->vkModule,
+      .module              = rvk_shader_module(shader, dev),
       .pName               = rvk_to_null_term_scratch(shader->entryPoint),
       .pSpecializationInfo = specialization,
   };
@@ -588,7 +585,7 @@ static VkPipeline rvk_pipeline_create(
       graphic->flags |= RvkGraphicFlags_MayDiscard;
     }
 
-    shaderStages[shaderStageCount++] = rvk_pipeline_shader(shader, overrides, overrideCount);
+    shaderStages[shaderStageCount++] = rvk_pipeline_shader(shader, dev, overrides, overrideCount);
   }
 
   const VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
@@ -918,9 +915,7 @@ void rvk_graphic_destroy(RvkGraphic* graphic, RvkDevice* dev) {
   if (graphic->vkPipeline) {
     rvk_call(dev, destroyPipeline, dev->vkDev, graphic->vkPipeline, &dev->vkAlloc);
   }
-  if (graphic->vkPipelineLayout) {
-    rvk_call(dev, destroyPipelineLayout, dev->vkDev, graphic->vkPipelineLayout, &dev->vkAlloc);
-  }
+  // NOTE: The pipeline-layout is owned by the descriptor pool and shared between graphics.
   if (rvk_desc_valid(graphic->graphicDescSet)) {
     rvk_desc_free(graphic->graphicDescSet);
   }
@@ -1123,7 +1118,6 @@ bool rvk_graphic_finalize(
         fmt_write_scratch("{}", fmt_duration(dur)));
   }
 
-  rvk_debug_name_pipeline_layout(dev, gra->vkPipelineLayout, "{}", fmt_text(gra->dbgName));
   rvk_debug_name_pipeline(dev, gra->vkPipeline, "{}", fmt_text(gra->dbgName));
   return true;
 }
@@ -584,7 +584,7 @@ void rvk_image_transition_batch(
     const RvkImageTransition transitions[],
     const u32                count,
     VkCommandBuffer          vkCmdBuf) {
-  VkImageMemoryBarrier barriers[16];
+  VkImageMemoryBarrier barriers[rvk_image_transition_batch_max];
   u32                  barrierCount = 0;
   diag_assert(count <= array_elems(barriers));
 
@@ -80,6 +80,8 @@ void rvk_image_assert_phase(const RvkImage*, RvkImagePhase);
 
 void rvk_image_freeze(RvkImage*);
 
+#define rvk_image_transition_batch_max 32
+
 typedef struct {
   RvkImage*     img;
   RvkImagePhase phase;
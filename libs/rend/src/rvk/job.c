@@ -5,6 +5,7 @@
 #include "core/thread.h"
 #include "geo/color.h"
 
+#include "buffer.h"
 #include "device.h"
 #include "image.h"
 #include "job.h"
@@ -13,6 +14,8 @@
 #include "stopwatch.h"
 #include "uniform.h"
 
+#define rvk_job_indirect_buffer_size (64 * usize_kibibyte)
+
 typedef enum {
   RvkJob_Active = 1 << 0,
 } RvkJobFlags;
@@ -28,7 +31,11 @@ struct sRvkJob {
   RvkStopwatch*    stopwatch;
   RvkStatRecorder* statrecorder;
 
-  VkFence         fenceJobDone;
+  RvkBuffer indirectBuffer;
+  u32       indirectOffset;
+
+  u64             timelineDoneValue; // Graphics timeline value at which this job is done.
+  VkFence         fenceJobDone;      // Fallback when timeline semaphores are unsupported.
   VkCommandPool   vkCmdPool;
   VkCommandBuffer vkCmdBuffers[RvkJobPhase_Count];
 
@@ -100,22 +107,51 @@ static void rvk_job_submit(
 
   diag_assert(job->phase == RvkJobPhase_Output);
 
+  RvkDevice* dev         = job->dev;
+  const bool useTimeline = (dev->flags & RvkDeviceFlags_SupportTimelineSemaphore) != 0;
+
   const VkPipelineStageFlags waitForTargetStageMask =
       VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
-  const VkSubmitInfo info = {
-      .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-      .waitSemaphoreCount   = waitForTarget ? 1 : 0,
-      .pWaitSemaphores      = &waitForTarget,
-      .pWaitDstStageMask    = &waitForTargetStageMask,
-      .commandBufferCount   = 1,
-      .pCommandBuffers      = &job->vkCmdBuffers[job->phase],
-      .signalSemaphoreCount = signalCount,
-      .pSignalSemaphores    = signals,
+  VkSemaphore signalSemaphores[4];
+  u64         signalValues[4];
+  u32         signalSemaphoreCount = 0;
+  diag_assert(signalCount + 1 <= array_elems(signalSemaphores));
+  for (u32 i = 0; i != signalCount; ++i) {
+    signalValues[signalSemaphoreCount]       = 0; // Ignored for binary semaphores.
+    signalSemaphores[signalSemaphoreCount++] = signals[i];
+  }
+
+  VkTimelineSemaphoreSubmitInfo timelineInfo = {
+      .sType                  = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+      .pSignalSemaphoreValues = signalValues,
   };
-  thread_mutex_lock(job->dev->queueSubmitMutex);
-  rvk_call_checked(job->dev, queueSubmit, job->dev->vkGraphicsQueue, 1, &info, job->fenceJobDone);
-  thread_mutex_unlock(job->dev->queueSubmitMutex);
+  VkSubmitInfo info = {
+      .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+      .waitSemaphoreCount = waitForTarget ? 1 : 0,
+      .pWaitSemaphores    = &waitForTarget,
+      .pWaitDstStageMask  = &waitForTargetStageMask,
+      .commandBufferCount = 1,
+      .pCommandBuffers    = &job->vkCmdBuffers[job->phase],
+      .pSignalSemaphores  = signalSemaphores,
+  };
+
+  thread_mutex_lock(dev->queueSubmitMutex);
+  if (useTimeline) {
+    // Take a ticket on the graphics queue timeline; the job is done when the line reaches it.
+    job->timelineDoneValue = ++dev->graphicsTimelineValue;
+
+    signalValues[signalSemaphoreCount]       = job->timelineDoneValue;
+    signalSemaphores[signalSemaphoreCount++] = dev->vkGraphicsTimeline;
+
+    timelineInfo.signalSemaphoreValueCount = signalSemaphoreCount;
+    info.pNext                             = &timelineInfo;
+  }
+  info.signalSemaphoreCount = signalSemaphoreCount;
+
+  const VkFence doneFence = useTimeline ? null : job->fenceJobDone;
+  rvk_call_checked(dev, queueSubmit, dev->vkGraphicsQueue, 1, &info, doneFence);
+  thread_mutex_unlock(dev->queueSubmitMutex);
 }
 
 static void rvk_job_phase_begin(RvkJob* job) {
@@ -155,14 +191,23 @@ RvkJob* rvk_job_create(RvkDevice* dev, const u32 jobId) {
   VkCommandPool vkCmdPool = rvk_commandpool_create(dev, dev->graphicsQueueIndex);
   rvk_debug_name_cmdpool(dev, vkCmdPool, "job_{}", fmt_int(jobId));
 
+  const RvkBuffer indirectBuffer =
+      rvk_buffer_create(dev, rvk_job_indirect_buffer_size, RvkBufferType_HostIndirect);
+  rvk_debug_name_buffer(dev, indirectBuffer.vkBuffer, "indirect_{}", fmt_int(jobId));
+
   *job = (RvkJob){
-      .dev          = dev,
-      .uniformPool  = rvk_uniform_pool_create(dev),
-      .jobId        = jobId,
-      .fenceJobDone = rvk_fence_create(dev, true),
-      .vkCmdPool    = vkCmdPool,
+      .dev            = dev,
+      .uniformPool    = rvk_uniform_pool_create(dev),
+      .jobId          = jobId,
+      .vkCmdPool      = vkCmdPool,
+      .indirectBuffer = indirectBuffer,
   };
 
+  if (!(dev->flags & RvkDeviceFlags_SupportTimelineSemaphore)) {
+    job->fenceJobDone = rvk_fence_create(dev, true);
+    rvk_debug_name_fence(dev, job->fenceJobDone, "job_{}", fmt_int(jobId));
+  }
+
   if (dev->flags & RvkDeviceFlags_RecordStats) {
     job->stopwatch    = rvk_stopwatch_create(dev);
     job->statrecorder = rvk_statrecorder_create(dev);
@@ -170,8 +215,6 @@ RvkJob* rvk_job_create(RvkDevice* dev, const u32 jobId) {
 
   rvk_commandbuffer_create_batch(dev, vkCmdPool, job->vkCmdBuffers, RvkJobPhase_Count);
 
-  rvk_debug_name_fence(dev, job->fenceJobDone, "job_{}", fmt_int(jobId));
-
   return job;
 }
 
@@ -179,6 +222,7 @@ void rvk_job_destroy(RvkJob* job) {
   rvk_job_wait_for_done(job);
 
   rvk_uniform_pool_destroy(job->uniformPool);
+  rvk_buffer_destroy(&job->indirectBuffer, job->dev);
   if (job->stopwatch) {
     rvk_stopwatch_destroy(job->stopwatch);
   }
@@ -188,13 +232,20 @@ void rvk_job_destroy(RvkJob* job) {
 
   RvkDevice* dev = job->dev;
   rvk_call(dev, destroyCommandPool, dev->vkDev, job->vkCmdPool, &dev->vkAlloc);
-  rvk_call(dev, destroyFence, dev->vkDev, job->fenceJobDone, &dev->vkAlloc);
+  if (job->fenceJobDone) {
+    rvk_call(dev, destroyFence, dev->vkDev, job->fenceJobDone, &dev->vkAlloc);
+  }
 
   alloc_free_t(g_allocHeap, job);
 }
 
 bool rvk_job_is_done(const RvkJob* job) {
-  RvkDevice*     dev         = job->dev;
+  RvkDevice* dev = job->dev;
+  if (dev->flags & RvkDeviceFlags_SupportTimelineSemaphore) {
+    u64 value;
+    rvk_call_checked(dev, getSemaphoreCounterValueKHR, dev->vkDev, dev->vkGraphicsTimeline, &value);
+    return value >= job->timelineDoneValue;
+  }
   const VkResult fenceStatus = rvk_call(dev, getFenceStatus, dev->vkDev, job->fenceJobDone);
   return fenceStatus == VK_SUCCESS;
 }
@@ -202,7 +253,18 @@ bool rvk_job_is_done(const RvkJob* job) {
 void rvk_job_wait_for_done(const RvkJob* job) {
   const TimeSteady waitStart = time_steady_clock();
 
-  rvk_call_checked(job->dev, waitForFences, job->dev->vkDev, 1, &job->fenceJobDone, true, u64_max);
+  RvkDevice* dev = job->dev;
+  if (dev->flags & RvkDeviceFlags_SupportTimelineSemaphore) {
+    const VkSemaphoreWaitInfo waitInfo = {
+        .sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .semaphoreCount = 1,
+        .pSemaphores    = &dev->vkGraphicsTimeline,
+        .pValues        = &job->timelineDoneValue,
+    };
+    rvk_call_checked(dev, waitSemaphoresKHR, dev->vkDev, &waitInfo, u64_max);
+  } else {
+    rvk_call_checked(dev, waitForFences, dev->vkDev, 1, &job->fenceJobDone, true, u64_max);
+  }
 
   ((RvkJob*)job)->cpuWaitDur += time_steady_duration(waitStart, time_steady_clock());
 }
@@ -243,9 +305,10 @@ void rvk_job_begin(RvkJob* job, const RvkJobPhase firstPhase) {
   diag_assert_msg(!(job->flags & RvkJob_Active), "job already active");
 
   job->flags |= RvkJob_Active;
-  job->phase      = firstPhase;
-  job->cpuWaitDur = 0;
-  job->copyCount  = 0;
+  job->phase          = firstPhase;
+  job->cpuWaitDur     = 0;
+  job->copyCount      = 0;
+  job->indirectOffset = 0;
 
   rvk_uniform_reset(job->uniformPool);
   rvk_commandpool_reset(job->dev, job->vkCmdPool);
@@ -315,6 +378,24 @@ rvk_job_uniform_push_next(RvkJob* job, const RvkUniformHandle head, const usize
   return rvk_uniform_push_next(job->uniformPool, head, size);
 }
 
+void rvk_job_uniform_join(RvkJob* job, const RvkUniformHandle head, const RvkUniformHandle other) {
+  rvk_uniform_join(job->uniformPool, head, other);
+}
+
+const RvkBuffer* rvk_job_indirect_buffer(const RvkJob* job) { return &job->indirectBuffer; }
+
+u32 rvk_job_indirect_push(RvkJob* job, const Mem commands) {
+  diag_assert_msg(job->flags & RvkJob_Active, "job not active");
+
+  const u32 offset = job->indirectOffset;
+  if (UNLIKELY(offset + commands.size > job->indirectBuffer.size)) {
+    return sentinel_u32; // Indirect buffer is full.
+  }
+  rvk_buffer_upload(&job->indirectBuffer, commands, offset);
+  job->indirectOffset += (u32)commands.size;
+  return offset;
+}
+
 void rvk_job_img_clear_color(RvkJob* job, RvkImage* img, const GeoColor color) {
   diag_assert_msg(job->flags & RvkJob_Active, "job not active");
 
@@ -445,7 +526,9 @@ void rvk_job_end(
   rvk_job_phase_end(job);
   rvk_uniform_flush(job->uniformPool);
 
-  rvk_call_checked(job->dev, resetFences, job->dev->vkDev, 1, &job->fenceJobDone);
+  if (job->fenceJobDone) {
+    rvk_call_checked(job->dev, resetFences, job->dev->vkDev, 1, &job->fenceJobDone);
+  }
   rvk_job_submit(job, waitForTarget, signals, signalCount);
 
   job->flags &= ~RvkJob_Active;
@@ -52,6 +52,14 @@ VkCommandBuffer  rvk_job_cmdbuffer(RvkJob*);
 Mem              rvk_job_uniform_map(RvkJob*, RvkUniformHandle);
 RvkUniformHandle rvk_job_uniform_push(RvkJob*, usize size);
 RvkUniformHandle rvk_job_uniform_push_next(RvkJob*, RvkUniformHandle head, usize size);
+void             rvk_job_uniform_join(RvkJob*, RvkUniformHandle head, RvkUniformHandle other);
+
+/**
+ * Push commands (for example 'VkDrawIndexedIndirectCommand's) to the job's indirect buffer.
+ * Returns the byte offset of the commands in the buffer (or sentinel_u32 when the buffer is full).
+ */
+const RvkBuffer* rvk_job_indirect_buffer(const RvkJob*);
+u32              rvk_job_indirect_push(RvkJob*, Mem commands);
 
 void rvk_job_img_clear_color(RvkJob*, RvkImage*, GeoColor);
 void rvk_job_img_clear_depth(RvkJob*, RvkImage*, f32 depth);
@@ -45,6 +45,7 @@ typedef struct {
 
 void rvk_mem_flush(RvkMem mem, u32 offset, u32 size);
 void rvk_mem_flush_batch(const RvkMemFlush[], u32 count); // NOTE: Have to be from the same pool.
+void rvk_mem_invalidate(RvkMem mem, u32 offset, u32 size); // Make device writes cpu visible.
 
 u64 rvk_mem_occupied(const RvkMemPool*, RvkMemLoc);
 u64 rvk_mem_reserved(const RvkMemPool*, RvkMemLoc);
@@ -3,6 +3,7 @@
 #include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
+#include "core/sentinel.h"
 #include "core/thread.h"
 
 #include "device.h"
@@ -12,8 +13,10 @@
 /**
  * Device memory pool.
  *
- * Uses a simple block-allocation strategy on top of big chunks allocated from the Vulkan driver.
- * Does not do any defragging at the moment so will get fragmented over time.
+ * Uses a best-fit block-allocation strategy on top of big chunks allocated from the Vulkan driver.
+ * Allocations cannot be moved once bound (Vulkan resources bind their memory exactly once), instead
+ * fragmentation is kept low by always picking the tightest fitting free block (keeping big blocks
+ * intact for big allocations) and by releasing chunks that become empty.
  */
 
 #define VOLO_RVK_MEM_DEBUG 0
@@ -84,8 +87,9 @@ static VkMemoryPropertyFlagBits rvk_mem_props(const RvkMemLoc loc) {
 
 /**
  * Find a memory-type that is allowed by the mask and that satisfies the requested properties.
+ * Returns sentinel_u32 if no matching memory-type exists.
  */
-static u32 rvk_mem_type(RvkMemPool* pool, const VkMemoryPropertyFlags props, const u32 mask) {
+static u32 rvk_mem_type_find(RvkMemPool* pool, const VkMemoryPropertyFlags props, const u32 mask) {
   for (u32 i = 0; i < pool->vkDevMemProps.memoryTypeCount; i++) {
     const bool isAllowed     = (mask & (1 << i)) != 0;
     const bool hasProperties = (pool->vkDevMemProps.memoryTypes[i].propertyFlags & props) == props;
@@ -93,7 +97,32 @@ static u32 rvk_mem_type(RvkMemPool* pool, const VkMemoryPropertyFlags props, con
       return i;
     }
   }
-  diag_crash_msg("Vulkan device has no memory type that satisfies required properties");
+  return sentinel_u32;
+}
+
+static u32 rvk_mem_type(RvkMemPool* pool, const RvkMemLoc loc, const u32 mask) {
+  if (loc == RvkMemLoc_Host) {
+    /**
+     * Prefer coherent host memory; writes to it become visible to the device without needing an
+     * explicit flush every frame.
+     */
+    const VkMemoryPropertyFlags coherentProps =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    const u32 coherentType = rvk_mem_type_find(pool, coherentProps, mask);
+    if (!sentinel_check(coherentType)) {
+      return coherentType;
+    }
+  }
+  const u32 type = rvk_mem_type_find(pool, rvk_mem_props(loc), mask);
+  if (UNLIKELY(sentinel_check(type))) {
+    diag_crash_msg("Vulkan device has no memory type that satisfies required properties");
+  }
+  return type;
+}
+
+static bool rvk_mem_type_coherent(const RvkMemPool* pool, const u32 memType) {
+  const VkMemoryPropertyFlags props = pool->vkDevMemProps.memoryTypes[memType].propertyFlags;
+  return (props & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
 }
 
 MAYBE_UNUSED static u32 rvk_mem_end_offset(const RvkMem mem) { return mem.offset + mem.size; }
@@ -237,65 +266,94 @@ static void rvk_mem_chunk_destroy(RvkMemChunk* chunk) {
 #endif
 }
 
-static RvkMem rvk_mem_chunk_alloc(RvkMemChunk* chunk, const u32 size, const u32 align) {
-#if VOLO_RVK_MEM_DEBUG
-  const u32 dbgFreeSize = rvk_mem_chunk_size_free(chunk);
-#endif
-
-  // Find a block that can fit the requested size.
+/**
+ * Find the best (meaning tightest) fitting free block for the requested size.
+ * Returns the block index (or sentinel_usize when no block in the chunk can fit it) and writes the
+ * amount of bytes that would be left over in the block to 'outWaste'.
+ */
+static usize rvk_mem_chunk_block_best_fit(
+    const RvkMemChunk* chunk, const u32 size, const u32 align, u32* outWaste) {
+  usize bestIdx   = sentinel_usize;
+  u32   bestWaste = u32_max;
   for (usize i = 0; i != chunk->freeBlocks.size; ++i) {
-    RvkMem*   block         = dynarray_at_t(&chunk->freeBlocks, i, RvkMem);
-    const u32 offset        = block->offset;
-    const u32 padding       = bits_padding_32(offset, align);
-    const u32 paddedSize    = size + padding;
-    const i32 remainingSize = (i32)block->size - (i32)paddedSize;
-
-    if (remainingSize < 0) {
+    const RvkMem* block      = dynarray_at_t(&chunk->freeBlocks, i, RvkMem);
+    const u32     padding    = bits_padding_32(block->offset, align);
+    const u32     paddedSize = size + padding;
+    if (paddedSize > block->size) {
       continue; // Doesn't fit in this block.
     }
-
-    // Either shrink the block to 'remove' the space, or remove the block entirely.
-    if (remainingSize > 0) {
-      block->offset += paddedSize;
-      block->size = (u32)remainingSize;
-    } else {
-      dynarray_remove(&chunk->freeBlocks, i, 1);
+    const u32 waste = block->size - paddedSize;
+    if (waste < bestWaste) {
+      bestIdx   = i;
+      bestWaste = waste;
+      if (!waste) {
+        break; // Perfect fit.
+      }
     }
+  }
+  *outWaste = bestWaste;
+  return bestIdx;
+}
 
-    if (padding) {
-      // Add the lost padding space as a new block.
-      *dynarray_insert_t(&chunk->freeBlocks, i, RvkMem) = (RvkMem){
-          .offset = offset,
-          .size   = padding,
-      };
-    }
+static RvkMem rvk_mem_chunk_alloc_at(
+    RvkMemChunk* chunk, const usize blockIdx, const u32 size, const u32 align) {
+#if VOLO_RVK_MEM_DEBUG
+  const u32 dbgFreeSize = rvk_mem_chunk_size_free(chunk);
+#endif
+
+  RvkMem*   block         = dynarray_at_t(&chunk->freeBlocks, blockIdx, RvkMem);
+  const u32 offset        = block->offset;
+  const u32 padding       = bits_padding_32(offset, align);
+  const u32 paddedSize    = size + padding;
+  const u32 remainingSize = block->size - paddedSize;
+  diag_assert(paddedSize <= block->size);
+
+  // Either shrink the block to 'remove' the space, or remove the block entirely.
+  if (remainingSize) {
+    block->offset += paddedSize;
+    block->size = remainingSize;
+  } else {
+    dynarray_remove(&chunk->freeBlocks, blockIdx, 1);
+  }
+
+  if (padding) {
+    // Add the lost padding space as a new block.
+    *dynarray_insert_t(&chunk->freeBlocks, blockIdx, RvkMem) = (RvkMem){
+        .offset = offset,
+        .size   = padding,
+    };
+  }
 
 #if VOLO_RVK_MEM_DEBUG
-    if (UNLIKELY(dbgFreeSize - rvk_mem_chunk_size_free(chunk) != size)) {
-      diag_crash_msg(
-          "Memory-pool corrupt after allocate (size: {}, chunk: {}, pre-alloc: {}, post-alloc: {})",
-          fmt_int(size),
-          fmt_int(chunk->id),
-          fmt_int(remainingSize),
-          fmt_int(dbgFreeSize),
-          fmt_int(rvk_mem_chunk_size_free(chunk)));
-    }
-    rvk_mem_assert_block_sorting(chunk);
+  if (UNLIKELY(dbgFreeSize - rvk_mem_chunk_size_free(chunk) != size)) {
+    diag_crash_msg(
+        "Memory-pool corrupt after allocate (size: {}, chunk: {}, pre-alloc: {}, post-alloc: {})",
+        fmt_int(size),
+        fmt_int(chunk->id),
+        fmt_int(dbgFreeSize),
+        fmt_int(rvk_mem_chunk_size_free(chunk)));
+  }
+  rvk_mem_assert_block_sorting(chunk);
 #endif
 
 #if VOLO_RVK_MEM_LOGGING
-    log_d(
-        "Vulkan memory block allocated",
-        log_param("size", fmt_size(size)),
-        log_param("align", fmt_int(align)),
-        log_param("chunk", fmt_int(chunk->id)));
+  log_d(
+      "Vulkan memory block allocated",
+      log_param("size", fmt_size(size)),
+      log_param("align", fmt_int(align)),
+      log_param("chunk", fmt_int(chunk->id)));
 #endif
 
-    return (RvkMem){.chunk = chunk, .offset = offset + padding, .size = size};
-  }
+  return (RvkMem){.chunk = chunk, .offset = offset + padding, .size = size};
+}
 
-  // No block can fit the requested size.
-  return (RvkMem){0};
+static RvkMem rvk_mem_chunk_alloc(RvkMemChunk* chunk, const u32 size, const u32 align) {
+  u32         waste;
+  const usize blockIdx = rvk_mem_chunk_block_best_fit(chunk, size, align, &waste);
+  if (sentinel_check(blockIdx)) {
+    return (RvkMem){0}; // No block can fit the requested size.
+  }
+  return rvk_mem_chunk_alloc_at(chunk, blockIdx, size, align);
 }
 
 static void rvk_mem_chunk_free(RvkMemChunk* chunk, const RvkMem mem) {
@@ -406,19 +464,30 @@ RvkMem rvk_mem_alloc(
   RvkMem result = {0};
   thread_mutex_lock(pool->lock);
 
-  // Attempt to allocate from an existing chunk.
-  for (RvkMemChunk* chunk = pool->chunkHead; chunk; chunk = chunk->next) {
+  // Attempt to allocate from the existing chunk with the tightest fitting free block; keeping big
+  // blocks intact for big allocations reduces fragmentation over long sessions.
+  RvkMemChunk* bestChunk    = null;
+  usize        bestBlockIdx = sentinel_usize;
+  u32          bestWaste    = u32_max;
+  for (RvkMemChunk* chunk = pool->chunkHead; chunk && bestWaste; chunk = chunk->next) {
     if (chunk->loc == loc && chunk->access == access && mask & (1 << chunk->memType)) {
-      result = rvk_mem_chunk_alloc(chunk, size, align);
-      if (rvk_mem_valid(result)) {
-        goto Done;
+      u32         waste;
+      const usize blockIdx = rvk_mem_chunk_block_best_fit(chunk, size, align, &waste);
+      if (!sentinel_check(blockIdx) && waste < bestWaste) {
+        bestChunk    = chunk;
+        bestBlockIdx = blockIdx;
+        bestWaste    = waste;
       }
     }
   }
+  if (bestChunk) {
+    result = rvk_mem_chunk_alloc_at(bestChunk, bestBlockIdx, size, align);
+    goto Done;
+  }
 
   // No existing chunk has space; create a new chunk.
   const u32        chunkSize = size > rvk_mem_chunk_size ? size : (u32)rvk_mem_chunk_size;
-  const u32        memType   = rvk_mem_type(pool, rvk_mem_props(loc), mask);
+  const u32        memType   = rvk_mem_type(pool, loc, mask);
   const RvkChunkId chunkId   = pool->nextChunkId++;
   RvkMemChunk*     chunk     = rvk_mem_chunk_create(pool, chunkId, loc, access, chunkSize, memType);
   result                     = rvk_mem_chunk_alloc(chunk, size, align);
@@ -501,7 +570,8 @@ void rvk_mem_flush_batch(const RvkMemFlush flushes[], const u32 count) {
   const RvkMemPool* pool           = flushes[0].mem.chunk->pool;
   const u32         flushAlignment = (u32)pool->vkDevLimits.nonCoherentAtomSize;
 
-  VkMappedMemoryRange* ranges = mem_stack(sizeof(VkMappedMemoryRange) * count).ptr;
+  VkMappedMemoryRange* ranges     = mem_stack(sizeof(VkMappedMemoryRange) * count).ptr;
+  u32                  rangeCount = 0;
   for (u32 i = 0; i != count; ++i) {
     const RvkMemFlush* flush = &flushes[i];
     diag_assert(rvk_mem_valid(flush->mem));
@@ -510,6 +580,10 @@ void rvk_mem_flush_batch(const RvkMemFlush flushes[], const u32 count) {
     diag_assert(chunk->map); // Only mapped memory can be flushed.
     diag_assert(chunk->pool == pool);
 
+    if (rvk_mem_type_coherent(pool, chunk->memType)) {
+      continue; // Coherent memory does not require explicit flushing.
+    }
+
     const u32 chunkOffset = flush->mem.offset + flush->offset;
     diag_assert(chunkOffset + flush->size <= flush->mem.offset + flush->mem.size);
 
@@ -523,14 +597,52 @@ void rvk_mem_flush_batch(const RvkMemFlush flushes[], const u32 count) {
       paddedSize = chunk->size - chunkOffset;
     }
 
-    ranges[i] = (VkMappedMemoryRange){
+    ranges[rangeCount++] = (VkMappedMemoryRange){
         .sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
         .memory = chunk->vkMem,
         .offset = alignedOffset,
         .size   = paddedSize,
     };
   }
-  rvk_call_checked(pool->dev, flushMappedMemoryRanges, pool->dev->vkDev, count, ranges);
+  if (rangeCount) {
+    rvk_call_checked(pool->dev, flushMappedMemoryRanges, pool->dev->vkDev, rangeCount, ranges);
+  }
+}
+
+void rvk_mem_invalidate(const RvkMem mem, const u32 offset, const u32 size) {
+  diag_assert(rvk_mem_valid(mem));
+
+  const RvkMemChunk* chunk = mem.chunk;
+  diag_assert(chunk->map); // Only mapped memory can be invalidated.
+
+  const RvkMemPool* pool = chunk->pool;
+  if (rvk_mem_type_coherent(pool, chunk->memType)) {
+    return; // Coherent memory does not require explicit invalidation.
+  }
+  const u32 alignment   = (u32)pool->vkDevLimits.nonCoherentAtomSize;
+  const u32 chunkOffset = mem.offset + offset;
+  diag_assert(chunkOffset + size <= mem.offset + mem.size);
+
+  // Align the offset to be a multiple of 'alignment'.
+  const u32 alignedOffset = chunkOffset / alignment * alignment;
+  diag_assert(chunkOffset >= alignedOffset && chunkOffset - alignedOffset < alignment);
+
+  // Pad the size to be aligned (or until the end of the chunk).
+  u32 paddedSize = bits_align(size, alignment);
+  if (chunkOffset + paddedSize > chunk->size) {
+    paddedSize = chunk->size - chunkOffset;
+  }
+
+  const VkMappedMemoryRange ranges[] = {
+      {
+          .sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+          .memory = chunk->vkMem,
+          .offset = alignedOffset,
+          .size   = paddedSize,
+      },
+  };
+  rvk_call_checked(
+      pool->dev, invalidateMappedMemoryRanges, pool->dev->vkDev, array_elems(ranges), ranges);
 }
 
 u64 rvk_mem_occupied(const RvkMemPool* pool, const RvkMemLoc loc) {
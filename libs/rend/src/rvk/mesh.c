@@ -1,4 +1,5 @@
 #include "core/diag.h"
+#include "core/math.h"
 #include "log/logger.h"
 
 #include "device.h"
@@ -17,8 +18,15 @@ RvkMesh* rvk_mesh_create(RvkDevice* dev, const AssetMeshComp* asset, const Strin
   *mesh = (RvkMesh){
       .vertexCount = asset->vertexCount,
       .indexCount  = asset->indexCount,
+      .lodCount    = asset->lodCount,
       .bounds      = asset->bounds,
   };
+  for (u32 i = 0; i != asset->lodCount; ++i) {
+    mesh->lods[i] = (RvkMeshLod){
+        .indexOffset = asset->lods[i].indexOffset,
+        .indexCount  = asset->lods[i].indexCount,
+    };
+  }
 
   const Mem vertexMem = data_mem(asset->vertexData);
   const Mem indexMem  = data_mem(asset->indexData);
@@ -81,3 +89,11 @@ void rvk_mesh_bind(const RvkMesh* mesh, const RvkDevice* dev, VkCommandBuffer vk
 
   rvk_call(dev, cmdBindIndexBuffer, vkCmdBuf, mesh->indexBuffer.vkBuffer, 0, indexType);
 }
+
+RvkMeshLod rvk_mesh_lod(const RvkMesh* mesh, const u16 lodIndex) {
+  if (!lodIndex || !mesh->lodCount) {
+    return (RvkMeshLod){.indexCount = mesh->indexCount}; // Full detail.
+  }
+  const u16 level = math_min(lodIndex, (u16)mesh->lodCount);
+  return mesh->lods[level - 1];
+}
@@ -5,8 +5,14 @@
 #include "forward.h"
 #include "transfer.h"
 
+typedef struct sRvkMeshLod {
+  u32 indexOffset, indexCount;
+} RvkMeshLod;
+
 typedef struct sRvkMesh {
   u32           vertexCount, indexCount;
+  u32           lodCount; // Amount of simplified levels, finest first.
+  RvkMeshLod    lods[asset_mesh_lods_max];
   RvkBuffer     vertexBuffer, indexBuffer;
   RvkTransferId vertexTransfer, indexTransfer;
   GeoBox        bounds;
@@ -16,3 +22,9 @@ RvkMesh* rvk_mesh_create(RvkDevice*, const AssetMeshComp*, String dbgName);
 void     rvk_mesh_destroy(RvkMesh*, RvkDevice*);
 bool     rvk_mesh_is_ready(const RvkMesh*, const RvkDevice*);
 void     rvk_mesh_bind(const RvkMesh*, const RvkDevice*, VkCommandBuffer);
+
+/**
+ * Retrieve the index range for the given level-of-detail.
+ * NOTE: Clamped to the available levels; level 0 (or meshes without lods) is full detail.
+ */
+RvkMeshLod rvk_mesh_lod(const RvkMesh*, u16 lodIndex);
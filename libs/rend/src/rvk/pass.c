@@ -22,6 +22,12 @@
 
 #define pass_instance_count_max 2048
 #define pass_attachment_max (rvk_pass_attach_color_max + 1)
+#define pass_transition_max                                                                        \
+  (pass_attachment_max + rvk_pass_global_image_max + rvk_pass_draw_image_max)
+
+ASSERT(
+    pass_transition_max <= rvk_image_transition_batch_max,
+    "Pass setup transitions have to fit in a single transition batch");
 
 typedef enum {
   RvkPassFlags_Active     = 1 << 0,
@@ -30,6 +36,7 @@ typedef enum {
 
 typedef struct {
   VkCommandBuffer vkCmdBuf;
+  VkCommandBuffer vkDrawBuf; // Secondary buffer the pass contents are recorded into.
   VkFramebuffer   vkFrameBuffer;
 
   RvkSize size;
@@ -59,6 +66,7 @@ typedef struct {
   RvkUniformPool*   uniformPool;
   RvkStopwatch*     stopwatch;    // NOTE: Potentially null depending on device setup.
   RvkStatRecorder*  statrecorder; // NOTE: Potentially null depending on device setup.
+  VkCommandPool     vkCmdPool;    // Owns the secondary draw buffers; one pool per pass-frame.
 
   DynArray descSetsVolatile; // RvkDescSet[], allocated on-demand and automatically freed next init.
   DynArray invocations;      // RvkPassInvoc[]
@@ -410,7 +418,46 @@ rvk_pass_vkrenderpass_begin(RvkPass* pass, RvkPassInvoc* invoc, const RvkPassSet
       .pClearValues             = clearValues,
   };
   rvk_call(
-      pass->dev, cmdBeginRenderPass, invoc->vkCmdBuf, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+      pass->dev,
+      cmdBeginRenderPass,
+      invoc->vkCmdBuf,
+      &renderPassInfo,
+      VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+}
+
+/**
+ * Allocate and begin a secondary command buffer for recording the pass contents. Because each
+ * pass-frame owns its own command pool the contents of different passes can be recorded
+ * concurrently, only the render-pass begin / end on the primary buffer has to happen in order.
+ */
+static VkCommandBuffer
+rvk_pass_drawbuffer_begin(RvkPass* pass, RvkPassFrame* frame, RvkPassInvoc* invoc) {
+  RvkDevice* dev = pass->dev;
+
+  const VkCommandBufferAllocateInfo allocInfo = {
+      .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .commandPool        = frame->vkCmdPool,
+      .level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+      .commandBufferCount = 1,
+  };
+  VkCommandBuffer result;
+  rvk_call_checked(dev, allocateCommandBuffers, dev->vkDev, &allocInfo, &result);
+
+  const VkCommandBufferInheritanceInfo inheritanceInfo = {
+      .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+      .renderPass         = pass->vkRendPass,
+      .subpass            = 0,
+      .framebuffer        = invoc->vkFrameBuffer,
+      .pipelineStatistics = frame->statrecorder ? rvk_statrecorder_vkstats : 0,
+  };
+  const VkCommandBufferBeginInfo beginInfo = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+               VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+      .pInheritanceInfo = &inheritanceInfo,
+  };
+  rvk_call_checked(dev, beginCommandBuffer, result, &beginInfo);
+  return result;
 }
 
 static RvkDescSet
@@ -518,7 +565,7 @@ static void rvk_pass_bind_draw(
   rvk_desc_group_bind(&pass->descGroup, RvkGraphicSet_Draw, descSet);
 
   if (mesh) {
-    rvk_mesh_bind(mesh, pass->dev, invoc->vkCmdBuf);
+    rvk_mesh_bind(mesh, pass->dev, invoc->vkDrawBuf);
   }
 }
 
@@ -556,12 +603,26 @@ static RvkPassHandle rvk_pass_frame_find_available(RvkPass* pass) {
   return sentinel_u8;
 }
 
+static VkCommandPool rvk_pass_cmdpool_create(RvkPass* pass) {
+  RvkDevice* dev = pass->dev;
+
+  const VkCommandPoolCreateInfo createInfo = {
+      .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+      .queueFamilyIndex = dev->graphicsQueueIndex,
+      .flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+  };
+  VkCommandPool result;
+  rvk_call_checked(dev, createCommandPool, dev->vkDev, &createInfo, &dev->vkAlloc, &result);
+  return result;
+}
+
 static RvkPassHandle rvk_pass_frame_create(RvkPass* pass) {
   const RvkPassHandle frameHandle = (RvkPassHandle)pass->frames.size;
   RvkPassFrame*       frame       = dynarray_push_t(&pass->frames, RvkPassFrame);
 
   *frame = (RvkPassFrame){
       .state            = RvkPassFrameState_Available,
+      .vkCmdPool        = rvk_pass_cmdpool_create(pass),
       .descSetsVolatile = dynarray_create_t(g_allocHeap, RvkDescSet, 8),
       .invocations      = dynarray_create_t(g_allocHeap, RvkPassInvoc, 1),
   };
@@ -580,6 +641,9 @@ static void rvk_pass_frame_reset(RvkPass* pass, RvkPassFrame* frame) {
   }
   dynarray_clear(&frame->invocations);
 
+  // Reclaim the secondary draw buffers.
+  rvk_call_checked(dev, resetCommandPool, dev->vkDev, frame->vkCmdPool, 0);
+
   // Cleanup volatile descriptor sets.
   const usize volatileSets = frame->descSetsVolatile.size;
   rvk_desc_free_batch(dynarray_begin_t(&frame->descSetsVolatile, RvkDescSet), volatileSets);
@@ -597,6 +661,8 @@ static void rvk_pass_frame_destroy(RvkPass* pass, RvkPassFrame* frame) {
   }
   dynarray_destroy(&frame->invocations);
 
+  rvk_call(dev, destroyCommandPool, dev->vkDev, frame->vkCmdPool, &dev->vkAlloc);
+
   // Cleanup volatile descriptor sets.
   const usize volatileSets = frame->descSetsVolatile.size;
   rvk_desc_free_batch(dynarray_begin_t(&frame->descSetsVolatile, RvkDescSet), volatileSets);
@@ -810,13 +876,26 @@ void rvk_pass_stats_invoc(
   diag_assert_msg(frame->state == RvkPassFrameState_Reserved, "Pass frame already released");
   diag_assert_msg(invocIdx < frame->invocations.size, "Invalid invocation");
 
+  RvkPassInvoc* invoc = dynarray_at_t(&frame->invocations, invocIdx, RvkPassInvoc);
+
+  out->draws     = invoc->drawCount;
+  out->instances = invoc->instanceCount;
   if (frame->stopwatch) {
-    RvkPassInvoc* invoc = dynarray_at_t(&frame->invocations, invocIdx, RvkPassInvoc);
-    out->gpuTimeBegin   = rvk_stopwatch_query(frame->stopwatch, invoc->timeRecBegin);
-    out->gpuTimeEnd     = rvk_stopwatch_query(frame->stopwatch, invoc->timeRecEnd);
+    out->gpuTimeBegin = rvk_stopwatch_query(frame->stopwatch, invoc->timeRecBegin);
+    out->gpuTimeEnd   = rvk_stopwatch_query(frame->stopwatch, invoc->timeRecEnd);
   } else {
     out->gpuTimeBegin = out->gpuTimeEnd = 0;
   }
+  if (frame->statrecorder) {
+    const RvkStatRecorder* r   = frame->statrecorder;
+    const RvkStatRecord    rec = invoc->statsRecord;
+    out->vertices              = rvk_statrecorder_query(r, rec, RvkStat_InputAssemblyVertices);
+    out->primitives            = rvk_statrecorder_query(r, rec, RvkStat_InputAssemblyPrimitives);
+    out->shadersVert           = rvk_statrecorder_query(r, rec, RvkStat_ShaderInvocationsVert);
+    out->shadersFrag           = rvk_statrecorder_query(r, rec, RvkStat_ShaderInvocationsFrag);
+  } else {
+    out->vertices = out->primitives = out->shadersVert = out->shadersFrag = 0;
+  }
 }
 
 u32 rvk_pass_batch_size(RvkPass* pass, const u32 instanceDataSize) {
@@ -849,7 +928,7 @@ void rvk_pass_begin(RvkPass* pass, const RvkPassSetup* setup) {
    * - Per-draw images to ShaderRead.
    */
   {
-    RvkImageTransition transitions[16];
+    RvkImageTransition transitions[pass_transition_max];
     u32                transitionCount = 0;
     for (u32 i = 0; i != rvk_pass_attach_color_max; ++i) {
       if (!setup->attachColors[i]) {
@@ -885,8 +964,8 @@ void rvk_pass_begin(RvkPass* pass, const RvkPassSetup* setup) {
     rvk_image_transition_batch(pass->dev, transitions, transitionCount, invoc->vkCmdBuf);
   }
 
-  rvk_pass_vkrenderpass_begin(pass, invoc, setup);
-
+  // NOTE: Queries / timestamps have to be recorded outside of the render-pass on the primary
+  // buffer as the render-pass contents are recorded into secondary buffers.
   if (frame->statrecorder) {
     invoc->statsRecord = rvk_statrecorder_start(frame->statrecorder, invoc->vkCmdBuf);
   }
@@ -896,12 +975,72 @@ void rvk_pass_begin(RvkPass* pass, const RvkPassSetup* setup) {
   rvk_debug_label_begin(
       pass->dev, invoc->vkCmdBuf, geo_color_blue, "pass_{}", fmt_text(pass->config->name));
 
-  rvk_pass_viewport_set(pass->dev, invoc->vkCmdBuf, invoc->size);
-  rvk_pass_scissor_set(pass->dev, invoc->vkCmdBuf, invoc->size);
+  rvk_pass_vkrenderpass_begin(pass, invoc, setup);
+
+  invoc->vkDrawBuf = rvk_pass_drawbuffer_begin(pass, frame, invoc);
+
+  rvk_pass_viewport_set(pass->dev, invoc->vkDrawBuf, invoc->size);
+  rvk_pass_scissor_set(pass->dev, invoc->vkDrawBuf, invoc->size);
 
   rvk_pass_bind_global(pass, frame, invoc, setup);
 }
 
+/**
+ * Submit the draw as a single indirect multi-draw instead of one direct draw per instance batch.
+ * Only usable when no descriptors need to be re-bound between the batches (so no per-batch
+ * instance data); the batches are offset through the command's 'firstInstance' instead.
+ * Returns false when the job's indirect buffer is full; the caller should fall back to direct
+ * draws in that case.
+ */
+static bool rvk_pass_draw_indirect(
+    RvkPass*           pass,
+    RvkPassFrame*      frame,
+    RvkPassInvoc*      invoc,
+    const RvkGraphic*  gra,
+    const RvkPassDraw* draw,
+    const u32          instBatchSize) {
+
+  const RvkMesh*   mesh = draw->drawMesh ? draw->drawMesh : gra->mesh;
+  const RvkMeshLod lod  = rvk_mesh_lod(mesh, draw->lodIndex);
+  const u32 batchCount  = (draw->instCount + instBatchSize - 1) / instBatchSize;
+
+  VkDrawIndexedIndirectCommand* cmds =
+      alloc_array_t(g_allocScratch, VkDrawIndexedIndirectCommand, batchCount);
+
+  for (u32 batchIdx = 0, instIdx = 0; batchIdx != batchCount; ++batchIdx) {
+    const u32 instCount = math_min(draw->instCount - instIdx, instBatchSize);
+    cmds[batchIdx]      = (VkDrawIndexedIndirectCommand){
+             .indexCount    = lod.indexCount,
+             .firstIndex    = lod.indexOffset,
+             .instanceCount = instCount,
+             .firstInstance = instIdx,
+    };
+    instIdx += instCount;
+  }
+
+  const Mem cmdMem = mem_create(cmds, sizeof(VkDrawIndexedIndirectCommand) * batchCount);
+  const u32 offset = rvk_job_indirect_push(frame->job, cmdMem);
+  if (UNLIKELY(sentinel_check(offset))) {
+    return false;
+  }
+
+  rvk_desc_update_flush(&pass->descUpdates);
+  rvk_desc_group_flush(&pass->descGroup, invoc->vkDrawBuf, gra->vkPipelineLayout);
+
+  const VkBuffer indirectBuffer = rvk_job_indirect_buffer(frame->job)->vkBuffer;
+  rvk_call(
+      pass->dev,
+      cmdDrawIndexedIndirect,
+      invoc->vkDrawBuf,
+      indirectBuffer,
+      offset,
+      batchCount,
+      sizeof(VkDrawIndexedIndirectCommand));
+
+  invoc->instanceCount += draw->instCount;
+  return true;
+}
+
 void rvk_pass_draw(
     RvkPass* pass, const RvkPassSetup* setup, const RvkPassDraw draws[], const u32 count) {
   RvkPassFrame* frame = rvk_pass_frame_require_active(pass);
@@ -950,7 +1089,7 @@ void rvk_pass_draw(
 
     ++invoc->drawCount;
     rvk_debug_label_begin(
-        pass->dev, invoc->vkCmdBuf, geo_color_green, "draw_{}", fmt_text(gra->dbgName));
+        pass->dev, invoc->vkDrawBuf, geo_color_green, "draw_{}", fmt_text(gra->dbgName));
 
     if (gra->flags & RvkGraphicFlags_RequireDrawSet) {
       const RvkMesh* drawMesh = draw->drawMesh;
@@ -958,29 +1097,43 @@ void rvk_pass_draw(
           pass, frame, invoc, setup, gra, draw->drawData, drawMesh, drawImg, draw->drawSampler);
     }
 
-    rvk_graphic_bind(gra, pass->dev, pass, &pass->descGroup, invoc->vkCmdBuf);
+    rvk_graphic_bind(gra, pass->dev, pass, &pass->descGroup, invoc->vkDrawBuf);
 
     const bool instReqData   = (gra->flags & RvkGraphicFlags_RequireInstanceSet) != 0;
     const u32  instBatchSize = rvk_pass_batch_size(pass, instReqData ? draw->instDataStride : 0);
+
+    /**
+     * Without per-batch instance data no descriptors change between the batches, which allows
+     * collapsing them into a single indirect multi-draw.
+     */
+    const bool indirectSupport = (pass->dev->flags & RvkDeviceFlags_SupportMultiDrawIndirect) != 0;
+    if (!instReqData && indirectSupport && draw->instCount > instBatchSize &&
+        (draw->drawMesh || gra->mesh)) {
+      if (rvk_pass_draw_indirect(pass, frame, invoc, gra, draw, instBatchSize)) {
+        rvk_debug_label_end(pass->dev, invoc->vkDrawBuf);
+        continue;
+      }
+    }
+
     RvkUniformHandle instBatchData = draw->instData;
 
     for (u32 remInstCount = draw->instCount; remInstCount != 0;) {
-      const u32 instCount = math_min(remInstCount, instBatchSize);
+      u32 instCount = math_min(remInstCount, instBatchSize);
 
       if (instReqData) {
-#ifndef VOLO_RELEASE
-        {
-          const u32 dataSizeActual   = rvk_uniform_size(frame->uniformPool, instBatchData);
-          const u32 dataSizeExpected = instCount * draw->instDataStride;
-          diag_assert_msg(
-              dataSizeActual == dataSizeExpected,
-              "Draw batch (count: {}, stride: {}) data-size invalid, expected: {} actual: {}",
-              fmt_int(instCount),
-              fmt_int(draw->instDataStride),
-              fmt_int(dataSizeExpected),
-              fmt_int(dataSizeActual));
-        }
-#endif
+        /**
+         * The uniform data is authoritative for the batch size: merged draws (see rend builder)
+         * can have partially filled batches in the middle of the chain.
+         */
+        const u32 dataSize = rvk_uniform_size(frame->uniformPool, instBatchData);
+        instCount          = dataSize / draw->instDataStride;
+        diag_assert_msg(
+            instCount && instCount <= math_min(remInstCount, instBatchSize) &&
+                (dataSize % draw->instDataStride) == 0,
+            "Draw batch data-size (stride: {}, remaining: {}) invalid: {}",
+            fmt_int(draw->instDataStride),
+            fmt_int(remInstCount),
+            fmt_int(dataSize));
 
         rvk_uniform_dynamic_bind(
             frame->uniformPool,
@@ -993,16 +1146,25 @@ void rvk_pass_draw(
       }
 
       rvk_desc_update_flush(&pass->descUpdates);
-      rvk_desc_group_flush(&pass->descGroup, invoc->vkCmdBuf, gra->vkPipelineLayout);
+      rvk_desc_group_flush(&pass->descGroup, invoc->vkDrawBuf, gra->vkPipelineLayout);
 
       if (draw->drawMesh || gra->mesh) {
-        const u32 idxCount = draw->drawMesh ? draw->drawMesh->indexCount : gra->mesh->indexCount;
-        rvk_call(pass->dev, cmdDrawIndexed, invoc->vkCmdBuf, idxCount, instCount, 0, 0, 0);
+        const RvkMesh*   mesh = draw->drawMesh ? draw->drawMesh : gra->mesh;
+        const RvkMeshLod lod  = rvk_mesh_lod(mesh, draw->lodIndex);
+        rvk_call(
+            pass->dev,
+            cmdDrawIndexed,
+            invoc->vkDrawBuf,
+            lod.indexCount,
+            instCount,
+            lod.indexOffset,
+            0,
+            0);
       } else {
         const u32 vertexCount =
             draw->vertexCountOverride ? draw->vertexCountOverride : gra->vertexCount;
         if (LIKELY(vertexCount)) {
-          rvk_call(pass->dev, cmdDraw, invoc->vkCmdBuf, vertexCount, instCount, 0, 0);
+          rvk_call(pass->dev, cmdDraw, invoc->vkDrawBuf, vertexCount, instCount, 0, 0);
         }
       }
 
@@ -1010,7 +1172,7 @@ void rvk_pass_draw(
       remInstCount -= instCount;
     }
 
-    rvk_debug_label_end(pass->dev, invoc->vkCmdBuf);
+    rvk_debug_label_end(pass->dev, invoc->vkDrawBuf);
   }
 }
 
@@ -1020,6 +1182,12 @@ void rvk_pass_end(RvkPass* pass, const RvkPassSetup* setup) {
 
   pass->flags &= ~RvkPassFlags_Active;
 
+  // Finish the secondary draw buffer and execute it as the render-pass contents.
+  rvk_call_checked(pass->dev, endCommandBuffer, invoc->vkDrawBuf);
+  rvk_call(pass->dev, cmdExecuteCommands, invoc->vkCmdBuf, 1, &invoc->vkDrawBuf);
+
+  rvk_call(pass->dev, cmdEndRenderPass, invoc->vkCmdBuf);
+
   if (frame->statrecorder) {
     rvk_statrecorder_stop(frame->statrecorder, invoc->statsRecord, invoc->vkCmdBuf);
   }
@@ -1028,8 +1196,6 @@ void rvk_pass_end(RvkPass* pass, const RvkPassSetup* setup) {
     invoc->timeRecEnd = rvk_stopwatch_mark(frame->stopwatch, invoc->vkCmdBuf);
   }
 
-  rvk_call(pass->dev, cmdEndRenderPass, invoc->vkCmdBuf);
-
   if (setup->attachDepth && pass->config->attachDepth != RvkPassDepth_Stored) {
     // When we're not storing the depth, the image's contents become undefined.
     rvk_image_transition_external(setup->attachDepth, RvkImagePhase_Undefined);
@@ -73,6 +73,7 @@ typedef struct sRvkPassDraw {
   RvkUniformHandle  instData;       // Chained uniform data for each batch.
   RvkSamplerSpec    drawSampler;    // Sampler specification for a per-draw image.
   u16               drawImageIndex; // Per-draw image to use.
+  u16               lodIndex;       // Mesh level-of-detail, clamped to the available levels.
   u16               instDataStride;
   u32               instCount;
   u32               vertexCountOverride;
@@ -88,6 +89,10 @@ typedef struct {
 
 typedef struct {
   TimeSteady gpuTimeBegin, gpuTimeEnd;
+  u16        draws;
+  u32        instances;
+  u64        vertices, primitives;
+  u64        shadersVert, shadersFrag;
 } RvkPassStatsInvoc;
 
 RvkPass* rvk_pass_create(RvkDevice*, const RvkPassConfig* /* Needs to be persistently allocated */);
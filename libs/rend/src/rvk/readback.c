@@ -0,0 +1,321 @@
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/math.h"
+#include "core/thread.h"
+#include "geo/color.h"
+#include "log/logger.h"
+
+#include "buffer.h"
+#include "device.h"
+#include "image.h"
+#include "lib.h"
+#include "readback.h"
+
+// #define VOLO_RVK_READBACK_LOGGING
+
+#define rvk_readback_buffer_size_min (1 * usize_mebibyte)
+
+#define rvk_readback_index(_READBACK_ID_) ((u32)((_READBACK_ID_) >> 0))
+#define rvk_readback_serial(_READBACK_ID_) ((u32)((_READBACK_ID_) >> 32))
+
+typedef enum {
+  RvkReadbackState_Idle,
+  RvkReadbackState_Rec,
+  RvkReadbackState_Busy,
+  RvkReadbackState_Ready,
+} RvkReadbackState;
+
+typedef struct {
+  RvkBuffer        hostBuffer;
+  VkCommandBuffer  vkCmdBuffer;
+  VkFence          finishedFence;
+  u64              dataSize;
+  RvkReadbackState state;
+  u32              serial;
+} RvkReadbackBuffer;
+
+struct sRvkReadbacker {
+  RvkDevice*    dev;
+  ThreadMutex   mutex;
+  VkCommandPool vkCmdPool;
+  DynArray      buffers; // RvkReadbackBuffer[]
+};
+
+static VkCommandPool rvk_commandpool_create(RvkDevice* dev, const u32 queueIndex) {
+  const VkCommandPoolCreateInfo createInfo = {
+      .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+      .queueFamilyIndex = queueIndex,
+      .flags =
+          VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+  };
+  VkCommandPool result;
+  rvk_call_checked(dev, createCommandPool, dev->vkDev, &createInfo, &dev->vkAlloc, &result);
+  return result;
+}
+
+static VkCommandBuffer rvk_commandbuffer_create(RvkDevice* dev, VkCommandPool vkCmdPool) {
+  const VkCommandBufferAllocateInfo allocInfo = {
+      .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .commandPool        = vkCmdPool,
+      .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+      .commandBufferCount = 1,
+  };
+  VkCommandBuffer result;
+  rvk_call_checked(dev, allocateCommandBuffers, dev->vkDev, &allocInfo, &result);
+  return result;
+}
+
+static bool rvk_fence_signaled(RvkDevice* dev, VkFence fence) {
+  return rvk_call(dev, getFenceStatus, dev->vkDev, fence) == VK_SUCCESS;
+}
+
+static VkFence rvk_fence_create(RvkDevice* dev, const bool initialState) {
+  const VkFenceCreateInfo fenceInfo = {
+      .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+      .flags = initialState ? VK_FENCE_CREATE_SIGNALED_BIT : 0,
+  };
+  VkFence result;
+  rvk_call_checked(dev, createFence, dev->vkDev, &fenceInfo, &dev->vkAlloc, &result);
+  return result;
+}
+
+static RvkReadbackBuffer* rvk_readback_buffer_create(RvkReadbacker* read, const u64 size) {
+  RvkReadbackBuffer* buffer = dynarray_push_t(&read->buffers, RvkReadbackBuffer);
+
+  *buffer = (RvkReadbackBuffer){
+      .hostBuffer    = rvk_buffer_create(read->dev, size, RvkBufferType_HostReadback),
+      .vkCmdBuffer   = rvk_commandbuffer_create(read->dev, read->vkCmdPool),
+      .finishedFence = rvk_fence_create(read->dev, true),
+  };
+
+#if defined(VOLO_RVK_READBACK_LOGGING)
+  log_d("Vulkan readback buffer created", log_param("size", fmt_size(size)));
+#endif
+  return buffer;
+}
+
+static RvkReadbackBuffer* rvk_readback_get(RvkReadbacker* read, const u64 size) {
+  // Find the smallest idle buffer that would fit this readback.
+  RvkReadbackBuffer* bestBuffer = null;
+  u64                bestSize   = u64_max;
+  dynarray_for_t(&read->buffers, RvkReadbackBuffer, buffer) {
+    const bool idle = buffer->state == RvkReadbackState_Idle;
+    if (idle && buffer->hostBuffer.size < bestSize && buffer->hostBuffer.size >= size) {
+      bestBuffer = buffer;
+      bestSize   = buffer->hostBuffer.size;
+    }
+  }
+  if (bestBuffer) {
+    return bestBuffer;
+  }
+  // Create a new buffer.
+  return rvk_readback_buffer_create(read, math_max(rvk_readback_buffer_size_min, size));
+}
+
+static RvkReadbackId rvk_readback_id(RvkReadbacker* read, RvkReadbackBuffer* buffer) {
+  const u64 idx = buffer - dynarray_begin_t(&read->buffers, RvkReadbackBuffer);
+  return (RvkReadbackId)(idx | ((u64)buffer->serial << u32_lit(32)));
+}
+
+static void rvk_readback_begin(RvkReadbacker* read, RvkReadbackBuffer* buffer) {
+  diag_assert(buffer->state == RvkReadbackState_Idle);
+  diag_assert(rvk_fence_signaled(read->dev, buffer->finishedFence));
+
+  buffer->state    = RvkReadbackState_Rec;
+  buffer->dataSize = 0;
+  ++buffer->serial;
+
+  RvkDevice* dev = read->dev;
+
+  rvk_call_checked(dev, resetFences, dev->vkDev, 1, &buffer->finishedFence);
+
+  const VkCommandBufferBeginInfo beginInfo = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+  };
+  rvk_call_checked(dev, beginCommandBuffer, buffer->vkCmdBuffer, &beginInfo);
+  rvk_debug_label_begin(dev, buffer->vkCmdBuffer, geo_color_teal, "readback");
+}
+
+static void rvk_readback_submit(RvkReadbacker* read, RvkReadbackBuffer* buffer) {
+  diag_assert(buffer->state == RvkReadbackState_Rec);
+
+  RvkDevice* dev = read->dev;
+
+  rvk_debug_label_end(dev, buffer->vkCmdBuffer);
+  rvk_call(dev, endCommandBuffer, buffer->vkCmdBuffer);
+
+  buffer->state = RvkReadbackState_Busy;
+
+  thread_mutex_lock(dev->queueSubmitMutex);
+
+  const VkSubmitInfo submitInfos[] = {
+      {
+          .sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+          .commandBufferCount = 1,
+          .pCommandBuffers    = &buffer->vkCmdBuffer,
+      },
+  };
+  rvk_call_checked(
+      dev,
+      queueSubmit,
+      dev->vkGraphicsQueue,
+      array_elems(submitInfos),
+      submitInfos,
+      buffer->finishedFence);
+
+  thread_mutex_unlock(dev->queueSubmitMutex);
+}
+
+RvkReadbacker* rvk_readbacker_create(RvkDevice* dev) {
+  RvkReadbacker* readbacker = alloc_alloc_t(g_allocHeap, RvkReadbacker);
+
+  *readbacker = (RvkReadbacker){
+      .dev       = dev,
+      .mutex     = thread_mutex_create(g_allocHeap),
+      .vkCmdPool = rvk_commandpool_create(dev, dev->graphicsQueueIndex),
+      .buffers   = dynarray_create_t(g_allocHeap, RvkReadbackBuffer, 4),
+  };
+  rvk_debug_name_cmdpool(dev, readbacker->vkCmdPool, "readbacker");
+
+  return readbacker;
+}
+
+void rvk_readbacker_destroy(RvkReadbacker* readbacker) {
+  RvkDevice* dev = readbacker->dev;
+  dynarray_for_t(&readbacker->buffers, RvkReadbackBuffer, buffer) {
+    rvk_buffer_destroy(&buffer->hostBuffer, dev);
+    rvk_call(dev, destroyFence, dev->vkDev, buffer->finishedFence, &dev->vkAlloc);
+  }
+
+  rvk_call(dev, destroyCommandPool, dev->vkDev, readbacker->vkCmdPool, &dev->vkAlloc);
+  thread_mutex_destroy(readbacker->mutex);
+  dynarray_destroy(&readbacker->buffers);
+
+  alloc_free_t(g_allocHeap, readbacker);
+}
+
+RvkReadbackId rvk_readback_image(RvkReadbacker* read, RvkImage* src) {
+  diag_assert_msg(!vkFormatCompressed4x4(src->vkFormat), "Compressed images cannot be read back");
+  diag_assert_msg(src->type != RvkImageType_DepthAttachment, "Depth images cannot be read back");
+
+  const u64 size =
+      (u64)src->size.width * src->size.height * vkFormatByteSize(src->vkFormat) * src->layers;
+
+  thread_mutex_lock(read->mutex);
+
+  RvkReadbackBuffer* buffer = rvk_readback_get(read, size);
+  rvk_readback_begin(read, buffer);
+  buffer->dataSize = size;
+
+  rvk_image_transition(read->dev, src, RvkImagePhase_TransferSource, buffer->vkCmdBuffer);
+
+  const VkBufferImageCopy copyRegions[] = {
+      {
+          .imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+          .imageSubresource.layerCount = src->layers,
+          .imageExtent.width           = src->size.width,
+          .imageExtent.height          = src->size.height,
+          .imageExtent.depth           = 1,
+      },
+  };
+  rvk_call(
+      read->dev,
+      cmdCopyImageToBuffer,
+      buffer->vkCmdBuffer,
+      src->vkImage,
+      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      buffer->hostBuffer.vkBuffer,
+      array_elems(copyRegions),
+      copyRegions);
+
+  const RvkReadbackId id = rvk_readback_id(read, buffer);
+
+#if defined(VOLO_RVK_READBACK_LOGGING)
+  log_d(
+      "Vulkan readback queued",
+      log_param("id", fmt_int(id)),
+      log_param("buffer-idx", fmt_int(rvk_readback_index(id))),
+      log_param("size", fmt_size(size)));
+#endif
+
+  thread_mutex_unlock(read->mutex);
+  return id;
+}
+
+RvkReadbackStatus rvk_readback_poll(const RvkReadbacker* read, const RvkReadbackId id) {
+  thread_mutex_lock(read->mutex);
+
+  const u32                idx    = rvk_readback_index(id);
+  const RvkReadbackBuffer* buffer = dynarray_at_t(&read->buffers, idx, RvkReadbackBuffer);
+
+  RvkReadbackStatus result = RvkReadbackStatus_Busy;
+  if (buffer->serial != rvk_readback_serial(id) || buffer->state == RvkReadbackState_Idle) {
+    result = RvkReadbackStatus_Expired;
+  } else if (buffer->state == RvkReadbackState_Ready) {
+    result = RvkReadbackStatus_Ready;
+  }
+
+  thread_mutex_unlock(read->mutex);
+  return result;
+}
+
+Mem rvk_readback_data(RvkReadbacker* read, const RvkReadbackId id) {
+  thread_mutex_lock(read->mutex);
+
+  const u32          idx    = rvk_readback_index(id);
+  RvkReadbackBuffer* buffer = dynarray_at_t(&read->buffers, idx, RvkReadbackBuffer);
+
+  diag_assert_msg(buffer->serial == rvk_readback_serial(id), "Readback has expired");
+  diag_assert_msg(buffer->state == RvkReadbackState_Ready, "Readback is not ready");
+
+  const Mem result = mem_slice(rvk_buffer_map(&buffer->hostBuffer, 0), 0, buffer->dataSize);
+
+  thread_mutex_unlock(read->mutex);
+  return result;
+}
+
+void rvk_readback_release(RvkReadbacker* read, const RvkReadbackId id) {
+  thread_mutex_lock(read->mutex);
+
+  const u32          idx    = rvk_readback_index(id);
+  RvkReadbackBuffer* buffer = dynarray_at_t(&read->buffers, idx, RvkReadbackBuffer);
+
+  if (buffer->serial == rvk_readback_serial(id) && buffer->state == RvkReadbackState_Ready) {
+    buffer->state = RvkReadbackState_Idle;
+  }
+
+  thread_mutex_unlock(read->mutex);
+}
+
+void rvk_readback_flush(RvkReadbacker* read) {
+  thread_mutex_lock(read->mutex);
+  dynarray_for_t(&read->buffers, RvkReadbackBuffer, buffer) {
+    switch (buffer->state) {
+    case RvkReadbackState_Idle:
+    case RvkReadbackState_Ready:
+      break;
+    case RvkReadbackState_Busy:
+      if (rvk_fence_signaled(read->dev, buffer->finishedFence)) {
+        // Make the gpu writes visible to the cpu.
+        rvk_buffer_invalidate(&buffer->hostBuffer, 0, buffer->dataSize);
+        buffer->state = RvkReadbackState_Ready;
+
+#if defined(VOLO_RVK_READBACK_LOGGING)
+        log_d("Vulkan readback finished", log_param("id", fmt_int(rvk_readback_id(read, buffer))));
+#endif
+      }
+      break;
+    case RvkReadbackState_Rec:
+      rvk_readback_submit(read, buffer);
+
+#if defined(VOLO_RVK_READBACK_LOGGING)
+      log_d("Vulkan readback submitted", log_param("id", fmt_int(rvk_readback_id(read, buffer))));
+#endif
+      break;
+    }
+  }
+  thread_mutex_unlock(read->mutex);
+}
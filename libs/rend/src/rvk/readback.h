@@ -0,0 +1,42 @@
+#pragma once
+#include "core/memory.h"
+
+#include "forward.h"
+#include "vulkan_api.h"
+
+/**
+ * Readbacker for downloading data from the GPU to the CPU without stalling the device.
+ * Completed readbacks stay resident until released and become available a flush after the GPU has
+ * finished writing them; expect results to be delivered a few frames after requesting them.
+ * NOTE: Api is thread-safe.
+ */
+typedef struct sRvkReadbacker RvkReadbacker;
+
+typedef enum {
+  RvkReadbackStatus_Busy,
+  RvkReadbackStatus_Ready,
+  RvkReadbackStatus_Expired, // Readback was released (or its buffer was reused).
+} RvkReadbackStatus;
+
+typedef u64 RvkReadbackId;
+
+RvkReadbacker* rvk_readbacker_create(RvkDevice*);
+void           rvk_readbacker_destroy(RvkReadbacker*);
+
+/**
+ * Request a readback of the given (uncompressed color) image, mip 0 only.
+ * NOTE: Records a transition of the image to the 'TransferSource' phase.
+ */
+RvkReadbackId rvk_readback_image(RvkReadbacker*, RvkImage* src);
+
+RvkReadbackStatus rvk_readback_poll(const RvkReadbacker*, RvkReadbackId);
+
+/**
+ * Retrieve the data of a completed readback.
+ * NOTE: Memory stays valid until the readback is released.
+ * Pre-condition: rvk_readback_poll() == RvkReadbackStatus_Ready.
+ */
+Mem  rvk_readback_data(RvkReadbacker*, RvkReadbackId);
+void rvk_readback_release(RvkReadbacker*, RvkReadbackId);
+
+void rvk_readback_flush(RvkReadbacker*); // Executes a queueSubmit.
@@ -3,6 +3,7 @@
 #include "core/diag.h"
 #include "core/dynstring.h"
 #include "core/math.h"
+#include "core/thread.h"
 #include "log/logger.h"
 #include "rend/report.h"
 
@@ -13,11 +14,11 @@
 
 #define VOLO_RVK_SHADER_LOGGING 0
 
-static VkShaderModule rvk_shader_module_create(RvkDevice* dev, const AssetShaderComp* asset) {
+static VkShaderModule rvk_shader_module_create(RvkDevice* dev, const Mem spvCode) {
   const VkShaderModuleCreateInfo createInfo = {
       .sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-      .codeSize = asset->data.size,
-      .pCode    = (const u32*)asset->data.ptr,
+      .codeSize = spvCode.size,
+      .pCode    = (const u32*)spvCode.ptr,
   };
   VkShaderModule result;
   rvk_call_checked(dev, createShaderModule, dev->vkDev, &createInfo, &dev->vkAlloc, &result);
@@ -135,7 +136,7 @@ RvkShader* rvk_shader_create(
   RvkShader* shader = alloc_alloc_t(g_allocHeap, RvkShader);
 
   *shader = (RvkShader){
-      .vkModule          = rvk_shader_module_create(dev, asset),
+      .spvCode           = alloc_dup(g_allocHeap, data_mem(asset->data), sizeof(u32)),
       .vkStage           = rvk_shader_stage(asset->kind),
       .flags             = rvk_shader_flags(asset),
       .killSpecConstMask = asset->killSpecConstMask,
@@ -150,8 +151,6 @@ RvkShader* rvk_shader_create(
     log_e("Non-fragment shader uses kill", log_param("shader", fmt_text(dbgName)));
   }
 
-  rvk_debug_name_shader(dev, shader->vkModule, "{}", fmt_text(dbgName));
-
   // Copy the specialization bindings.
   if (asset->specs.count) {
     shader->specs.values = alloc_array_t(g_allocHeap, AssetShaderSpec, asset->specs.count);
@@ -236,7 +235,12 @@ RvkShader* rvk_shader_create(
 }
 
 void rvk_shader_destroy(RvkShader* shader, RvkDevice* dev) {
-  rvk_call(dev, destroyShaderModule, dev->vkDev, shader->vkModule, &dev->vkAlloc);
+  if (shader->vkModule) {
+    rvk_call(dev, destroyShaderModule, dev->vkDev, shader->vkModule, &dev->vkAlloc);
+  }
+  if (mem_valid(shader->spvCode)) {
+    alloc_free(g_allocHeap, shader->spvCode);
+  }
   string_free(g_allocHeap, shader->dbgName);
   string_free(g_allocHeap, shader->entryPoint);
 
@@ -251,6 +255,23 @@ void rvk_shader_destroy(RvkShader* shader, RvkDevice* dev) {
   alloc_free_t(g_allocHeap, shader);
 }
 
+VkShaderModule rvk_shader_module(const RvkShader* shader, RvkDevice* dev) {
+  // NOTE: The following cast is questionable but safe as the module is guarded by its own lock.
+  RvkShader* shaderMutable = (RvkShader*)shader;
+
+  thread_spinlock_lock(&shaderMutable->moduleLock);
+  if (!shaderMutable->vkModule) {
+    shaderMutable->vkModule = rvk_shader_module_create(dev, shaderMutable->spvCode);
+    rvk_debug_name_shader(dev, shaderMutable->vkModule, "{}", fmt_text(shader->dbgName));
+
+    alloc_free(g_allocHeap, shaderMutable->spvCode);
+    shaderMutable->spvCode = mem_empty;
+  }
+  thread_spinlock_unlock(&shaderMutable->moduleLock);
+
+  return shaderMutable->vkModule;
+}
+
 bool rvk_shader_set_used(const RvkShader* shader, const u32 set) {
   if (UNLIKELY(set >= rvk_shader_desc_max)) {
     return false;
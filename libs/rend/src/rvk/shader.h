@@ -14,7 +14,9 @@ typedef enum {
 
 typedef struct sRvkShader {
   VkShaderStageFlagBits vkStage;
-  VkShaderModule        vkModule;
+  ThreadSpinLock        moduleLock;
+  VkShaderModule        vkModule; // Lazily created on first use, guarded by 'moduleLock'.
+  Mem                   spvCode;  // Spir-V code, freed once the module has been created.
   String                dbgName;
   String                entryPoint;
 
@@ -32,6 +34,12 @@ typedef struct sRvkShader {
 RvkShader* rvk_shader_create(RvkDevice*, const AssetShaderComp*, RendReport*, String dbgName);
 void       rvk_shader_destroy(RvkShader*, RvkDevice*);
 
+/**
+ * Retrieve the Vulkan module for this shader; the module is created lazily on first pipeline use.
+ * NOTE: Thread-safe.
+ */
+VkShaderModule rvk_shader_module(const RvkShader*, RvkDevice*);
+
 bool rvk_shader_set_used(const RvkShader*, u32 set);
 bool rvk_shader_may_kill(
     const RvkShader*, const AssetGraphicOverride* overrides, usize overrideCount);
@@ -33,10 +33,7 @@ static VkQueryPool rvk_querypool_create(RvkDevice* dev) {
       .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
       .queryType          = VK_QUERY_TYPE_PIPELINE_STATISTICS,
       .queryCount         = rvk_statrecorder_queries_max,
-      .pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
-                            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
-                            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
-                            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT,
+      .pipelineStatistics = rvk_statrecorder_vkstats,
   };
 
   diag_assert(bitset_count(bitset_from_var(createInfo.pipelineStatistics)) == RvkStat_Count);
@@ -4,6 +4,17 @@
 #include "forward.h"
 #include "vulkan_api.h"
 
+/**
+ * Pipeline statistics that are tracked by the recorder.
+ * NOTE: Secondary command buffers that execute while a capture is active need to declare these in
+ * their inheritance info.
+ */
+#define rvk_statrecorder_vkstats                                                                   \
+  (VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |                                       \
+   VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |                                     \
+   VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |                                     \
+   VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT)
+
 /**
  * Tracked pipeline statistic.
  */
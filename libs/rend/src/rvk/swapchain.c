@@ -2,6 +2,7 @@
 #include "core/array.h"
 #include "core/bits.h"
 #include "core/diag.h"
+#include "core/math.h"
 #include "core/time.h"
 #include "gap/native.h"
 #include "log/logger.h"
@@ -21,6 +22,13 @@
 
 #define swapchain_images_max 5
 #define swapchain_presentmode_desired_max 8
+#define swapchain_retired_max 3
+
+/**
+ * How many frames to present on a new swapchain before destroying a retired one; by then all
+ * frames that were recorded against the retired swapchain have left the gpu.
+ */
+#define swapchain_retired_frame_delay 3
 
 /**
  * What present stage to measure when using present timings.
@@ -55,6 +63,16 @@ typedef struct {
   bool                     presentAtRelative;
 } RvkSurfaceCaps;
 
+/**
+ * Swapchain that has been replaced but whose resources can still be referenced by the gpu.
+ */
+typedef struct {
+  VkSwapchainKHR vkSwap;
+  u64            retireFrameIdx; // Last frame enqueued when the swapchain was retired.
+  u32            imgCount;
+  RvkImage       imgs[swapchain_images_max];
+} RvkSwapchainRetired;
+
 struct sRvkSwapchain {
   RvkLib*            lib;
   RvkDevice*         dev;
@@ -68,6 +86,9 @@ struct sRvkSwapchain {
   RvkImage           imgs[swapchain_images_max];
   VkSemaphore        semaphores[swapchain_images_max]; // Semaphore to signal presentation.
 
+  RvkSwapchainRetired retired[swapchain_retired_max];
+  u32                 retiredCount;
+
   TimeDuration lastAcquireDur, lastPresentEnqueueDur, lastPresentWaitDur;
   u64          originFrameIdx; // Identifier of the last frame before recreating the swapchain.
   u64          lastFrameIdx;
@@ -81,6 +102,7 @@ struct sRvkSwapchain {
   // NOTE: Data is kept until the next 'rvk_swapchain_enqueue_present()'.
   RvkSwapchainPresent pastPresents[8];
   u32                 pastPresentCount;
+  TimeSteady          lastPresentTime; // Newest observed present dequeue, 0 if unavailable.
 };
 
 static VkSemaphore rvk_semaphore_create(RvkDevice* dev) {
@@ -464,19 +486,62 @@ static void rvk_swapchain_query_past_presents(RvkSwapchain* swap) {
         .dequeueTime = (TimeSteady)timings[i].pPresentStages[0].time,
         .duration    = swap->timingRefreshDuration,
     };
+    const TimeSteady dequeueTime = (TimeSteady)timings[i].pPresentStages[0].time;
+    swap->lastPresentTime        = math_max(swap->lastPresentTime, dequeueTime);
   }
 }
 
-static bool rvk_swapchain_init(RvkSwapchain* swap, const RendSettingsComp* settings, RvkSize size) {
-  if (!size.width || !size.height) {
-    swap->size = size;
-    return false;
+/**
+ * Destroy retired swapchains that the gpu can no longer be referencing (enough frames have been
+ * presented on their replacement since they were retired).
+ */
+static void rvk_swapchain_retired_flush(RvkSwapchain* swap, const bool force) {
+  for (u32 i = swap->retiredCount; i-- != 0;) {
+    RvkSwapchainRetired* retired = &swap->retired[i];
+    if (!force && swap->lastFrameIdx < (retired->retireFrameIdx + swapchain_retired_frame_delay)) {
+      continue; // Frames recorded against the retired swapchain can still be in flight.
+    }
+    for (u32 imgIdx = 0; imgIdx != retired->imgCount; ++imgIdx) {
+      rvk_image_destroy(&retired->imgs[imgIdx], swap->dev);
+    }
+    rvk_call(
+        swap->dev, destroySwapchainKHR, swap->dev->vkDev, retired->vkSwap, &swap->dev->vkAlloc);
+
+    log_d("Vulkan retired swapchain destroyed", log_param("frame", fmt_int(swap->lastFrameIdx)));
+
+    swap->retired[i] = swap->retired[--swap->retiredCount];
+  }
+}
+
+/**
+ * Retire the current swapchain; it stays alive (and is passed as 'oldSwapchain' during creation of
+ * its replacement) until the gpu is done with it, so recreation does not stall on a device sync.
+ */
+static void rvk_swapchain_retire(RvkSwapchain* swap) {
+  diag_assert(swap->vkSwap);
+  if (swap->retiredCount == swapchain_retired_max) {
+    // Too many retired swapchains; fall back to a full device sync to destroy them.
+    rvk_device_wait_idle(swap->dev);
+    rvk_swapchain_retired_flush(swap, true /* force */);
   }
+  RvkSwapchainRetired* retired = &swap->retired[swap->retiredCount++];
+
+  retired->vkSwap         = swap->vkSwap;
+  retired->retireFrameIdx = swap->lastFrameIdx;
+  retired->imgCount       = swap->imgCount;
+  mem_cpy(array_mem(retired->imgs), array_mem(swap->imgs));
 
   for (u32 i = 0; i != swap->imgCount; ++i) {
-    rvk_image_destroy(&swap->imgs[i], swap->dev);
     swap->imgs[i] = (RvkImage){0};
   }
+  swap->imgCount = 0;
+}
+
+static bool rvk_swapchain_init(RvkSwapchain* swap, const RendSettingsComp* settings, RvkSize size) {
+  if (!size.width || !size.height) {
+    swap->size = size;
+    return false;
+  }
 
   const VkDevice         vkDev    = swap->dev->vkDev;
   VkAllocationCallbacks* vkAlloc  = &swap->dev->vkAlloc;
@@ -487,6 +552,9 @@ static bool rvk_swapchain_init(RvkSwapchain* swap, const RendSettingsComp* setti
       rvk_pick_presentmode(swap->lib, swap->dev, settings, swap->vkSurf);
 
   const VkSwapchainKHR oldSwapchain = swap->vkSwap;
+  if (oldSwapchain) {
+    rvk_swapchain_retire(swap);
+  }
 
   VkSwapchainCreateFlagBitsKHR swapchainFlags = 0;
   if (surfCaps.presentId) {
@@ -519,9 +587,6 @@ static bool rvk_swapchain_init(RvkSwapchain* swap, const RendSettingsComp* setti
   };
 
   rvk_call_checked(swap->dev, createSwapchainKHR, vkDev, &createInfo, vkAlloc, &swap->vkSwap);
-  if (oldSwapchain) {
-    rvk_call(swap->dev, destroySwapchainKHR, vkDev, oldSwapchain, &swap->dev->vkAlloc);
-  }
 
   rvk_call_checked(swap->dev, getSwapchainImagesKHR, vkDev, swap->vkSwap, &swap->imgCount, null);
   if (UNLIKELY(swap->imgCount > swapchain_images_max)) {
@@ -630,6 +695,9 @@ RvkSwapchain* rvk_swapchain_create(RvkLib* lib, RvkDevice* dev, const GapWindowC
 }
 
 void rvk_swapchain_destroy(RvkSwapchain* swap) {
+  // NOTE: Callers are expected to have synchronized with the device before destroying.
+  rvk_swapchain_retired_flush(swap, true /* force */);
+
   for (u32 i = 0; i != swapchain_images_max; ++i) {
     if (swap->imgs[i].vkImageView) {
       rvk_image_destroy(&swap->imgs[i], swap->dev);
@@ -693,15 +761,14 @@ bool rvk_swapchain_prepare(
   const bool changedSize    = !rvk_size_equal(size, swap->size);
   const bool changedPresent = swap->syncMode != settings->syncMode;
 
+  rvk_swapchain_retired_flush(swap, false /* force */);
+
   if (!swap->vkSwap || outOfDate || changedSize || changedPresent) {
     /**
-     * Synchronize swapchain (re)creation by waiting for all rendering to be done. This a very
-     * crude way of synchronizing and causes stalls when resizing the window. In the future we can
-     * consider keeping the old swapchain alive during recreation and only destroy it after all
-     * rendering to it was finished.
+     * The old swapchain (if any) is retired instead of destroyed: it is kept alive (and handed to
+     * 'oldSwapchain' during creation) until the frames recorded against it have left the gpu, so
+     * window-mode and resolution transitions do not stall on a full device sync.
      */
-    rvk_device_wait_idle(swap->dev);
-
     if (!rvk_swapchain_init(swap, settings, size)) {
       return false;
     }
@@ -831,6 +898,10 @@ RvkSwapchainPresentHistory rvk_swapchain_past_presents(const RvkSwapchain* swap)
   };
 }
 
+TimeSteady rvk_swapchain_last_present_time(const RvkSwapchain* swap) {
+  return swap->lastPresentTime;
+}
+
 void rvk_swapchain_wait_for_present(const RvkSwapchain* swap, const u32 numBehind) {
   if (numBehind >= (swap->lastFrameIdx - swap->originFrameIdx)) {
     /**
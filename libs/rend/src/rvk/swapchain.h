@@ -63,6 +63,12 @@ bool rvk_swapchain_enqueue_present(RvkSwapchain*, RvkSwapchainIdx, u64 frameIdx,
  */
 RvkSwapchainPresentHistory rvk_swapchain_past_presents(const RvkSwapchain*);
 
+/**
+ * Retrieve the time at which the newest observed presentation was shown to the user.
+ * NOTE: Returns 0 if the presentation engine does not report present timing.
+ */
+TimeSteady rvk_swapchain_last_present_time(const RvkSwapchain*);
+
 /**
  * Wait for a previously enqueued presentation to be shown to the user.
  * The 'numBehind' argument controls which presentation to wait for:
@@ -1,4 +1,6 @@
+#include "core/array.h"
 #include "core/diag.h"
+#include "core/math.h"
 #include "log/logger.h"
 
 #include "desc.h"
@@ -9,6 +11,38 @@
 
 #define VOLO_RVK_TEXTURE_LOGGING 0
 
+/**
+ * Minimum width / height a texture has to keep when skipping high-detail mips.
+ */
+#define rvk_texture_mip_skip_min_size 128
+
+/**
+ * Amount of high-detail mips to skip uploading based on how much of the device's memory budget is
+ * in use. Skipping into the authored mip chain keeps a complete (coarser) chain resident, trading
+ * texture detail for staying within the available video memory.
+ */
+static u8 rvk_texture_mip_skip(const RvkDevice* dev, const AssetTextureComp* asset) {
+  if (!(dev->flags & RvkDeviceFlags_SupportMemoryBudget) || !dev->memBudgetTotal) {
+    return 0; // Memory budget unknown.
+  }
+  if (asset->mipsData < 2 || asset->mipsData != asset->mipsMax) {
+    return 0; // No complete authored mip chain to skip into.
+  }
+  static const f32 g_budgetThresholds[] = {0.8f, 0.9f, 0.95f};
+
+  const f32 budgetFrac = (f32)dev->memBudgetUsed / (f32)dev->memBudgetTotal;
+
+  u8 skip = 0;
+  while (skip != array_elems(g_budgetThresholds) && budgetFrac > g_budgetThresholds[skip]) {
+    ++skip;
+  }
+  while (skip && ((asset->width >> skip) < rvk_texture_mip_skip_min_size ||
+                  (asset->height >> skip) < rvk_texture_mip_skip_min_size)) {
+    --skip;
+  }
+  return math_min(skip, (u8)(asset->mipsData - 1));
+}
+
 static VkFormat rvk_texture_format(const AssetTextureComp* asset) {
   const bool srgb = (asset->flags & AssetTextureFlags_Srgb) != 0;
   switch (asset->format) {
@@ -49,9 +83,10 @@ RvkTexture* rvk_texture_create(RvkDevice* dev, const AssetTextureComp* asset, St
 
   RvkTexture* tex = alloc_alloc_t(g_allocHeap, RvkTexture);
 
-  const RvkSize  size       = rvk_size(asset->width, asset->height);
+  const u8       mipSkip    = rvk_texture_mip_skip(dev, asset);
+  const RvkSize  size       = rvk_size(asset->width >> mipSkip, asset->height >> mipSkip);
   const u8       layers     = (u8)asset->layers;
-  const u8       mipLevels  = (u8)asset->mipsMax;
+  const u8       mipLevels  = (u8)(asset->mipsMax - mipSkip);
   const VkFormat vkFmt      = rvk_texture_format(asset);
   const bool     compressed = vkFormatCompressed4x4(vkFmt);
   (void)compressed;
@@ -77,10 +112,18 @@ RvkTexture* rvk_texture_create(RvkDevice* dev, const AssetTextureComp* asset, St
     tex->image = rvk_image_create_source_color(dev, vkFmt, size, mipLevels, imgFlags);
   }
 
-  const Mem transferData = asset_texture_data(asset);
-  const u32 transferMips = asset->mipsData;
+  const Mem transferData = asset_texture_data_mip(asset, mipSkip);
+  const u32 transferMips = asset->mipsData - mipSkip;
   tex->pixelTransfer = rvk_transfer_image(dev->transferer, &tex->image, transferData, transferMips);
 
+  if (mipSkip) {
+    log_d(
+        "Vulkan texture mips skipped",
+        log_param("name", fmt_text(dbgName)),
+        log_param("skip", fmt_int(mipSkip)),
+        log_param("size", rvk_size_fmt(tex->image.size)));
+  }
+
   rvk_debug_name_img(dev, tex->image.vkImage, "{}", fmt_text(dbgName));
   rvk_debug_name_img_view(dev, tex->image.vkImageView, "{}", fmt_text(dbgName));
 
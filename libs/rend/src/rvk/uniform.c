@@ -207,6 +207,14 @@ rvk_uniform_push_next(RvkUniformPool* uni, const RvkUniformHandle head, const us
   return dataHandle;
 }
 
+void rvk_uniform_join(
+    RvkUniformPool* uni, const RvkUniformHandle head, const RvkUniformHandle other) {
+  RvkUniformEntry* tail = rvk_uniform_entry_mut(uni, head);
+  for (; tail->next; tail = rvk_uniform_entry_mut(uni, tail->next))
+    ;
+  tail->next = other;
+}
+
 void rvk_uniform_attach(
     RvkUniformPool*        uni,
     const RvkUniformHandle handle,
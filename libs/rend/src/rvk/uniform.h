@@ -20,6 +20,7 @@ void             rvk_uniform_reset(RvkUniformPool*);
 Mem              rvk_uniform_map(RvkUniformPool*, RvkUniformHandle);
 RvkUniformHandle rvk_uniform_push(RvkUniformPool*, usize size);
 RvkUniformHandle rvk_uniform_push_next(RvkUniformPool*, RvkUniformHandle head, usize size);
+void             rvk_uniform_join(RvkUniformPool*, RvkUniformHandle head, RvkUniformHandle other);
 
 void rvk_uniform_attach(
     RvkUniformPool*, RvkUniformHandle, RvkDescUpdateBatch*, RvkDescSet, u32 binding);
@@ -1010,6 +1010,8 @@ VkResult vkLoadDevice(VkDevice dev, const VkInterfaceInstance* src, VkInterfaceD
   out->getPipelineExecutablePropertiesKHR = (Symbol)src->getDeviceProcAddr(dev, "vkGetPipelineExecutablePropertiesKHR");
   out->getPipelineExecutableStatisticsKHR = (Symbol)src->getDeviceProcAddr(dev, "vkGetPipelineExecutableStatisticsKHR");
   out->getPipelineExecutableInternalRepresentationsKHR = (Symbol)src->getDeviceProcAddr(dev, "vkGetPipelineExecutableInternalRepresentationsKHR");
+  out->getSemaphoreCounterValueKHR = (Symbol)src->getDeviceProcAddr(dev, "vkGetSemaphoreCounterValueKHR");
+  out->waitSemaphoresKHR = (Symbol)src->getDeviceProcAddr(dev, "vkWaitSemaphoresKHR");
   out->waitForPresent2KHR = (Symbol)src->getDeviceProcAddr(dev, "vkWaitForPresent2KHR");
   out->createSwapchainKHR = (Symbol)src->getDeviceProcAddr(dev, "vkCreateSwapchainKHR");
   out->destroySwapchainKHR = (Symbol)src->getDeviceProcAddr(dev, "vkDestroySwapchainKHR");
@@ -47,6 +47,7 @@
 
 #define VK_EXT_calibrated_timestamps "VK_EXT_calibrated_timestamps"
 #define VK_EXT_debug_utils "VK_EXT_debug_utils"
+#define VK_EXT_descriptor_indexing "VK_EXT_descriptor_indexing"
 #define VK_EXT_memory_budget "VK_EXT_memory_budget"
 #define VK_EXT_present_timing "VK_EXT_present_timing"
 #define VK_EXT_robustness2 "VK_EXT_robustness2"
@@ -59,6 +60,7 @@
 #define VK_KHR_present_wait2 "VK_KHR_present_wait2"
 #define VK_KHR_surface "VK_KHR_surface"
 #define VK_KHR_swapchain "VK_KHR_swapchain"
+#define VK_KHR_timeline_semaphore "VK_KHR_timeline_semaphore"
 #define VK_KHR_win32_surface "VK_KHR_win32_surface"
 #define VK_KHR_xcb_surface "VK_KHR_xcb_surface"
 
@@ -258,10 +260,18 @@ typedef enum {
   VK_STRUCTURE_TYPE_SAMPLER_YCBCR_CONVERSION_IMAGE_FORMAT_PROPERTIES = 1000156005,
   VK_STRUCTURE_TYPE_BIND_BUFFER_MEMORY_INFO = 1000157000,
   VK_STRUCTURE_TYPE_BIND_IMAGE_MEMORY_INFO = 1000157001,
+  VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT = 1000161000,
+  VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT = 1000161001,
+  VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT = 1000161002,
+  VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO_EXT = 1000161003,
   VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MAINTENANCE_3_PROPERTIES = 1000168000,
   VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_SUPPORT = 1000168001,
   VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_KHR = 1000184000,
   VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES = 1000196000,
+  VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES = 1000207000,
+  VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO = 1000207002,
+  VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO = 1000207003,
+  VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO = 1000207004,
   VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_TIMING_FEATURES_EXT = 1000208000,
   VK_STRUCTURE_TYPE_SWAPCHAIN_TIMING_PROPERTIES_EXT = 1000208001,
   VK_STRUCTURE_TYPE_SWAPCHAIN_TIME_DOMAIN_PROPERTIES_EXT = 1000208002,
@@ -1263,6 +1273,48 @@ typedef struct VkSemaphoreCreateInfo {
   VkSemaphoreCreateFlags flags;
 } VkSemaphoreCreateInfo;
 
+typedef enum {
+  VK_SEMAPHORE_TYPE_BINARY = 0,
+  VK_SEMAPHORE_TYPE_TIMELINE = 1,
+} VkSemaphoreType;
+
+typedef struct VkSemaphoreTypeCreateInfo {
+  VkStructureType sType;
+  const void* pNext;
+  VkSemaphoreType semaphoreType;
+  u64 initialValue;
+} VkSemaphoreTypeCreateInfo;
+
+typedef struct VkTimelineSemaphoreSubmitInfo {
+  VkStructureType sType;
+  const void* pNext;
+  u32 waitSemaphoreValueCount;
+  const u64* pWaitSemaphoreValues;
+  u32 signalSemaphoreValueCount;
+  const u64* pSignalSemaphoreValues;
+} VkTimelineSemaphoreSubmitInfo;
+
+typedef enum {
+  VK_SEMAPHORE_WAIT_ANY_BIT = 1,
+} VkSemaphoreWaitFlagBits;
+
+typedef VkFlags VkSemaphoreWaitFlags;
+
+typedef struct VkSemaphoreWaitInfo {
+  VkStructureType sType;
+  const void* pNext;
+  VkSemaphoreWaitFlags flags;
+  u32 semaphoreCount;
+  const VkSemaphore* pSemaphores;
+  const u64* pValues;
+} VkSemaphoreWaitInfo;
+
+typedef struct VkPhysicalDeviceTimelineSemaphoreFeatures {
+  VkStructureType sType;
+  void* pNext;
+  VkBool32 timelineSemaphore;
+} VkPhysicalDeviceTimelineSemaphoreFeatures;
+
 typedef struct VkQueryPool_T* VkQueryPool;
 
 typedef VkFlags VkQueryPoolCreateFlags;
@@ -2197,6 +2249,7 @@ typedef struct VkDescriptorPool_T* VkDescriptorPool;
 
 typedef enum {
   VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT = 1,
+  VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT = 2,
 } VkDescriptorPoolCreateFlagBits;
 
 typedef VkFlags VkDescriptorPoolCreateFlags;
@@ -2247,8 +2300,35 @@ typedef struct VkDescriptorSetLayoutBinding {
   const VkSampler* pImmutableSamplers;
 } VkDescriptorSetLayoutBinding;
 
+typedef enum {
+  VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT = 2,
+} VkDescriptorSetLayoutCreateFlagBits;
+
 typedef VkFlags VkDescriptorSetLayoutCreateFlags;
 
+typedef enum {
+  VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT = 1,
+  VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT = 2,
+  VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT = 4,
+  VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT_EXT = 8,
+} VkDescriptorBindingFlagBitsEXT;
+
+typedef VkFlags VkDescriptorBindingFlagsEXT;
+
+typedef struct VkDescriptorSetLayoutBindingFlagsCreateInfoEXT {
+  VkStructureType sType;
+  const void* pNext;
+  u32 bindingCount;
+  const VkDescriptorBindingFlagsEXT* pBindingFlags;
+} VkDescriptorSetLayoutBindingFlagsCreateInfoEXT;
+
+typedef struct VkDescriptorSetVariableDescriptorCountAllocateInfoEXT {
+  VkStructureType sType;
+  const void* pNext;
+  u32 descriptorSetCount;
+  const u32* pDescriptorCounts;
+} VkDescriptorSetVariableDescriptorCountAllocateInfoEXT;
+
 typedef struct VkDescriptorSetLayoutCreateInfo {
   VkStructureType sType;
   const void* pNext;
@@ -3178,6 +3258,31 @@ typedef enum {
   VK_PAST_PRESENTATION_TIMING_ALLOW_OUT_OF_ORDER_RESULTS_BIT_EXT = 2,
 } VkPastPresentationTimingFlagBitsEXT;
 
+typedef struct VkPhysicalDeviceDescriptorIndexingFeaturesEXT {
+  VkStructureType sType;
+  void* pNext;
+  VkBool32 shaderInputAttachmentArrayDynamicIndexing;
+  VkBool32 shaderUniformTexelBufferArrayDynamicIndexing;
+  VkBool32 shaderStorageTexelBufferArrayDynamicIndexing;
+  VkBool32 shaderUniformBufferArrayNonUniformIndexing;
+  VkBool32 shaderSampledImageArrayNonUniformIndexing;
+  VkBool32 shaderStorageBufferArrayNonUniformIndexing;
+  VkBool32 shaderStorageImageArrayNonUniformIndexing;
+  VkBool32 shaderInputAttachmentArrayNonUniformIndexing;
+  VkBool32 shaderUniformTexelBufferArrayNonUniformIndexing;
+  VkBool32 shaderStorageTexelBufferArrayNonUniformIndexing;
+  VkBool32 descriptorBindingUniformBufferUpdateAfterBind;
+  VkBool32 descriptorBindingSampledImageUpdateAfterBind;
+  VkBool32 descriptorBindingStorageImageUpdateAfterBind;
+  VkBool32 descriptorBindingStorageBufferUpdateAfterBind;
+  VkBool32 descriptorBindingUniformTexelBufferUpdateAfterBind;
+  VkBool32 descriptorBindingStorageTexelBufferUpdateAfterBind;
+  VkBool32 descriptorBindingUpdateUnusedWhilePending;
+  VkBool32 descriptorBindingPartiallyBound;
+  VkBool32 descriptorBindingVariableDescriptorCount;
+  VkBool32 runtimeDescriptorArray;
+} VkPhysicalDeviceDescriptorIndexingFeaturesEXT;
+
 typedef struct VkPhysicalDeviceRobustness2FeaturesKHR {
   VkStructureType sType;
   void* pNext;
@@ -3800,6 +3905,8 @@ typedef struct VkInterfaceDevice {
   VkResult (SYS_DECL* getPipelineExecutablePropertiesKHR)(VkDevice device, const VkPipelineInfoKHR* pPipelineInfo, u32* pExecutableCount, VkPipelineExecutablePropertiesKHR* pProperties);
   VkResult (SYS_DECL* getPipelineExecutableStatisticsKHR)(VkDevice device, const VkPipelineExecutableInfoKHR* pExecutableInfo, u32* pStatisticCount, VkPipelineExecutableStatisticKHR* pStatistics);
   VkResult (SYS_DECL* getPipelineExecutableInternalRepresentationsKHR)(VkDevice device, const VkPipelineExecutableInfoKHR* pExecutableInfo, u32* pInternalRepresentationCount, VkPipelineExecutableInternalRepresentationKHR* pInternalRepresentations);
+  VkResult (SYS_DECL* getSemaphoreCounterValueKHR)(VkDevice device, VkSemaphore semaphore, u64* pValue);
+  VkResult (SYS_DECL* waitSemaphoresKHR)(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, u64 timeout);
   VkResult (SYS_DECL* waitForPresent2KHR)(VkDevice device, VkSwapchainKHR swapchain, const VkPresentWait2InfoKHR* pPresentWait2Info);
   VkResult (SYS_DECL* createSwapchainKHR)(VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain);
   void (SYS_DECL* destroySwapchainKHR)(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks* pAllocator);
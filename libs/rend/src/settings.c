@@ -44,7 +44,9 @@ void rend_settings_to_default(RendSettingsComp* s) {
   // clang-format off
   s->flags = RendFlags_FrustumCulling       |
              RendFlags_AmbientOcclusion     |
-             RendFlags_AmbientOcclusionBlur;
+             RendFlags_AmbientOcclusionBlur |
+             RendFlags_Lods                 |
+             RendFlags_ShadowCache;
 
   // clang-format on
   s->syncMode            = RendSyncMode_VSync;
@@ -60,6 +62,7 @@ void rend_settings_to_default(RendSettingsComp* s) {
   s->aoResolutionScale   = 0.75f;
   s->shadowResolution    = 2048;
   s->grayscaleFrac       = 0.0f;
+  s->sharpen             = 0.0f;
   s->debugViewerResource = 0;
   s->debugViewerLod      = 0.0f;
   s->debugViewerFlags    = 0;
@@ -68,7 +71,7 @@ void rend_settings_to_default(RendSettingsComp* s) {
 }
 
 void rend_settings_global_to_default(RendSettingsGlobalComp* s, const bool devSupport) {
-  s->flags       = 0;
+  s->flags       = RendGlobalFlags_Prewarm;
   s->limiterFreq = 0;
 
   if (devSupport) {
@@ -1,3 +1,4 @@
+#include "core/bitset.h"
 #include "core/forward.h"
 #include "core/math.h"
 #include "rend/settings.h"
@@ -57,3 +58,24 @@ bool rend_view_visible(
   }
   return geo_box_overlap_frustum4_approx(objAabb, view->frustum);
 }
+
+void rend_view_visible_batch(
+    const RendView*         view,
+    const RendTags*         objTags,
+    const GeoBox*           objAabbs,
+    const u32               count,
+    const RendSettingsComp* settings,
+    const BitSet            out) {
+
+  if (LIKELY(settings->flags & RendFlags_FrustumCulling)) {
+    geo_box_overlap_frustum4_approx_batch(objAabbs, count, view->frustum, out);
+  } else {
+    bitset_clear_all(out);
+    bitset_set_all(out, count);
+  }
+  for (u32 i = 0; i != count; ++i) {
+    if (!rend_view_tag_filter(view->filter, objTags[i])) {
+      bitset_clear(out, i);
+    }
+  }
+}
@@ -30,3 +30,17 @@ u16 rend_view_sort_dist(const RendView*, const GeoBox* objAabb);
  */
 bool rend_view_visible(
     const RendView*, RendTags objTags, const GeoBox* objAabb, const RendSettingsComp*);
+
+/**
+ * Check visibility for a batch of objects; bit 'i' in the output is set when object 'i' is visible.
+ * Uses a vectorized frustum test that culls each object against all frustum planes at once.
+ *
+ * Pre-condition: out can hold at least 'count' bits.
+ */
+void rend_view_visible_batch(
+    const RendView*,
+    const RendTags* objTags,
+    const GeoBox*   objAabbs,
+    u32             count,
+    const RendSettingsComp*,
+    BitSet out);
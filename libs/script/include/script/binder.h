@@ -102,6 +102,8 @@ ScriptBinderSlot script_binder_next(const ScriptBinder*, ScriptBinderSlot);
 
 /**
  * Execute a bound function.
+ * NOTE: Slots index the function table directly; resolve names up-front using
+ * 'script_binder_slot_lookup()' instead of per execution.
  * Pre-condition: Binder has been finalized.
  */
 ScriptVal script_binder_exec(const ScriptBinder*, ScriptBinderSlot, void* ctx, ScriptBinderCall*);
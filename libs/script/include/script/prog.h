@@ -28,6 +28,8 @@
  * NOTE: Multi-byte operation data is encoded as little-endian.
  * NOTE: There is no alignment requirement for operation data.
  * NOTE: Instruction values are 2 byte offsets from the start of the code memory.
+ * NOTE: Extern-func values are binder slots (resolved from names during read), meaning extern
+ * calls dispatch through a single table index without any name lookup at evaluation time.
  */
 typedef enum eScriptOp {
   ScriptOp_Fail              = 0,  // [       ] (       ) -> ( ) Terminate the execution.
@@ -92,7 +94,7 @@ typedef struct sScriptProgram {
 } ScriptProgram;
 
 typedef struct {
-  u32         executedOps;
+  u32         checkpoints; // Amount of executed jumps / extern calls, used for the execution limit.
   ScriptPanic panic;
   ScriptVal   val;
 } ScriptProgResult;
@@ -107,6 +109,24 @@ void script_prog_clear(ScriptProgram*, Allocator*);
 ScriptProgResult
 script_prog_eval(const ScriptProgram*, ScriptMem*, const ScriptBinder*, void* bindCtx);
 
+typedef struct sScriptProgEvalCtx {
+  ScriptMem* mem;
+  void*      bindCtx;
+} ScriptProgEvalCtx;
+
+/**
+ * Evaluate the program once per context, writing one result per context.
+ * Useful for running the same program over many entities in a single session, amortizing the
+ * evaluation setup over the whole batch.
+ * Pre-condition: script_prog_validate(program, binder).
+ */
+void script_prog_eval_batch(
+    const ScriptProgram*,
+    const ScriptBinder*,
+    const ScriptProgEvalCtx* ctxs,
+    u32                      count,
+    ScriptProgResult*        outResults);
+
 /**
  * Validate the given program.
  */
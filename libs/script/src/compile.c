@@ -419,6 +419,16 @@ compile_intr_binary(Context* ctx, const Target tgt, const ScriptOp op, const Scr
   if ((err = compile_expr(ctx, target_reg(tgt.reg), args[0]))) {
     return err;
   }
+  if (expr_is_var_load(ctx, args[1])) {
+    /**
+     * Fast path for a variable as the right-hand side; binary ops only read their source register
+     * so the variable register can be used directly, skipping a temporary register and a move.
+     */
+    const ScriptExprVarLoad* varLoadData = &expr_data(ctx->doc, args[1])->var_load;
+    diag_assert(!sentinel_check(ctx->varRegisters[varLoadData->var]));
+    emit_binary(ctx, op, tgt.reg, ctx->varRegisters[varLoadData->var]);
+    return err;
+  }
   const RegId tmpReg = reg_alloc(ctx);
   if (sentinel_check(tmpReg)) {
     err = ScriptCompileError_TooManyRegisters;
@@ -1,4 +1,5 @@
 #include "core/array.h"
+#include "core/bits.h"
 #include "core/diag.h"
 #include "script/eval.h"
 #include "script/intrinsic.h"
@@ -229,6 +230,251 @@ static ScriptExpr opt_static_mem_access(void* ctx, ScriptDoc* d, const ScriptExp
   return e; // Not optimizable.
 }
 
+#define opt_hoist_vars_max 4
+
+ASSERT(script_var_count <= 32, "Hoist pass tracks variables in a 32 bit mask");
+
+typedef struct {
+  u32 usedVarMask; // Bitmask of variable-ids used anywhere in the script.
+} OptHoistContext;
+
+typedef struct {
+  u32  storedVarMask; // Bitmask of variable-ids stored anywhere in the loop.
+  bool anyMemWrite;   // Loop writes memory (externs are assumed to write memory).
+} OptHoistLoopEffects;
+
+static void opt_hoist_collect_used_vars(void* ctx, const ScriptDoc* d, const ScriptExpr e) {
+  u32* usedVarMask = ctx;
+  switch (script_expr_kind(d, e)) {
+  case ScriptExprKind_VarLoad:
+    *usedVarMask |= 1u << expr_data(d, e)->var_load.var;
+    return;
+  case ScriptExprKind_VarStore:
+    *usedVarMask |= 1u << expr_data(d, e)->var_store.var;
+    return;
+  default:
+    return;
+  }
+}
+
+static void opt_hoist_collect_effects(void* ctx, const ScriptDoc* d, const ScriptExpr e) {
+  OptHoistLoopEffects* fx = ctx;
+  switch (script_expr_kind(d, e)) {
+  case ScriptExprKind_VarStore:
+    fx->storedVarMask |= 1u << expr_data(d, e)->var_store.var;
+    return;
+  case ScriptExprKind_MemStore:
+  case ScriptExprKind_Extern:
+    fx->anyMemWrite = true;
+    return;
+  case ScriptExprKind_Intrinsic:
+    if (expr_data(d, e)->intrinsic.intrinsic == ScriptIntrinsic_MemStoreDynamic) {
+      fx->anyMemWrite = true;
+    }
+    return;
+  default:
+    return;
+  }
+}
+
+/**
+ * Test if the expression is guaranteed to produce the same value on every loop iteration and is
+ * free to evaluate speculatively (no side-effects and no possibility of panicking).
+ */
+static bool
+opt_hoist_invariant(const ScriptDoc* d, const ScriptExpr e, const OptHoistLoopEffects* fx) {
+  switch (script_expr_kind(d, e)) {
+  case ScriptExprKind_Value:
+    return true;
+  case ScriptExprKind_VarLoad:
+    return (fx->storedVarMask & (1u << expr_data(d, e)->var_load.var)) == 0;
+  case ScriptExprKind_MemLoad:
+    return !fx->anyMemWrite;
+  case ScriptExprKind_Intrinsic: {
+    const ScriptExprIntrinsic* data = &expr_data(d, e)->intrinsic;
+    if (!script_intrinsic_deterministic(data->intrinsic)) {
+      return false;
+    }
+    if (data->intrinsic == ScriptIntrinsic_Loop) {
+      return false; // Loops are not worth (and not always safe) to evaluate speculatively.
+    }
+    const u32 argCount = script_intrinsic_arg_count(data->intrinsic);
+    for (u32 i = 0; i != argCount; ++i) {
+      if (!opt_hoist_invariant(d, expr_set_data(d, data->argSet)[i], fx)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default:
+    return false; // Stores, externs and blocks are never hoisted.
+  }
+}
+
+static void opt_hoist_has_dyn_input_visitor(void* ctx, const ScriptDoc* d, const ScriptExpr e) {
+  bool*                hasDynInput = ctx;
+  const ScriptExprKind kind        = script_expr_kind(d, e);
+  if (kind == ScriptExprKind_VarLoad || kind == ScriptExprKind_MemLoad) {
+    *hasDynInput = true;
+  }
+}
+
+typedef struct {
+  const OptHoistLoopEffects* fx;
+  ScriptExpr                 candidates[opt_hoist_vars_max];
+  u32                        candidateCount;
+} OptHoistFindContext;
+
+/**
+ * Find the maximal invariant sub-expressions; when an expression qualifies its children are not
+ * visited separately as they are hoisted along with their parent.
+ */
+static void opt_hoist_find(OptHoistFindContext* ctx, const ScriptDoc* d, const ScriptExpr e) {
+  if (ctx->candidateCount == opt_hoist_vars_max) {
+    return; // Candidate storage exhausted.
+  }
+  if (script_expr_kind(d, e) == ScriptExprKind_Intrinsic && opt_hoist_invariant(d, e, ctx->fx)) {
+    // NOTE: Purely static expressions are already folded to values by the static-eval pass.
+    bool hasDynInput = false;
+    script_expr_visit(d, e, &hasDynInput, opt_hoist_has_dyn_input_visitor);
+    if (hasDynInput) {
+      for (u32 i = 0; i != ctx->candidateCount; ++i) {
+        if (ctx->candidates[i] == e) {
+          return; // Already collected (shared sub-expression).
+        }
+      }
+      ctx->candidates[ctx->candidateCount++] = e;
+      return;
+    }
+  }
+  const ScriptExprData data = *expr_data(d, e); // Copy as the doc can grow during iteration.
+  switch (script_expr_kind(d, e)) {
+  case ScriptExprKind_VarStore:
+    opt_hoist_find(ctx, d, data.var_store.val);
+    return;
+  case ScriptExprKind_MemStore:
+    opt_hoist_find(ctx, d, data.mem_store.val);
+    return;
+  case ScriptExprKind_Intrinsic: {
+    const u32 argCount = script_intrinsic_arg_count(data.intrinsic.intrinsic);
+    for (u32 i = 0; i != argCount; ++i) {
+      opt_hoist_find(ctx, d, expr_set_data(d, data.intrinsic.argSet)[i]);
+    }
+    return;
+  }
+  case ScriptExprKind_Block:
+    for (u32 i = 0; i != data.block.exprCount; ++i) {
+      opt_hoist_find(ctx, d, expr_set_data(d, data.block.exprSet)[i]);
+    }
+    return;
+  case ScriptExprKind_Extern:
+    for (u32 i = 0; i != data.extern_.argCount; ++i) {
+      opt_hoist_find(ctx, d, expr_set_data(d, data.extern_.argSet)[i]);
+    }
+    return;
+  default:
+    return;
+  }
+}
+
+typedef struct {
+  const ScriptExpr*  candidates;
+  const ScriptVarId* vars;
+  u32                count;
+} OptHoistReplaceContext;
+
+static ScriptExpr opt_hoist_replace_rewriter(void* ctx, ScriptDoc* d, const ScriptExpr e) {
+  const OptHoistReplaceContext* replaceCtx = ctx;
+  for (u32 i = 0; i != replaceCtx->count; ++i) {
+    if (replaceCtx->candidates[i] == e) {
+      return script_add_anon_var_load(d, 0 /* scope */, replaceCtx->vars[i]);
+    }
+  }
+  return e; // Not a hoisted expression.
+}
+
+/**
+ * Hoist loop-invariant expressions out of loops.
+ * Invariant sub-expressions of the condition, increment and body are evaluated once into a free
+ * variable before the loop instead of on every iteration. Shared (common) sub-expressions collapse
+ * onto the same variable as the document de-duplicates identical expressions.
+ * Example: 'for(var i; i < $a * 2; i += 1) {}' ->
+ *          'var h = $a * 2; for(var i; i < h; i += 1) {}'.
+ */
+static ScriptExpr opt_hoist_rewriter(void* ctx, ScriptDoc* d, const ScriptExpr e) {
+  OptHoistContext* hoistCtx = ctx;
+  if (!script_expr_is_intrinsic(d, e, ScriptIntrinsic_Loop)) {
+    return e;
+  }
+  const u32 argCount = script_intrinsic_arg_count(ScriptIntrinsic_Loop);
+  ScriptExpr args[4];
+  diag_assert(argCount == array_elems(args));
+  mem_cpy(array_mem(args), mem_create(expr_set_data(d, expr_data(d, e)->intrinsic.argSet), sizeof(args)));
+
+  // Process nested loops first; hoisting them to this loop's pre-header is not supported.
+  bool anyArgRewritten = false;
+  for (u32 i = 0; i != argCount; ++i) {
+    const ScriptExpr newArg = script_expr_rewrite(d, args[i], ctx, opt_hoist_rewriter);
+    anyArgRewritten |= newArg != args[i];
+    args[i] = newArg;
+  }
+
+  OptHoistLoopEffects fx = {0};
+  for (u32 i = 0; i != argCount; ++i) {
+    script_expr_visit(d, args[i], &fx, opt_hoist_collect_effects);
+  }
+
+  // Find invariant candidates; the setup expression (arg 0) already runs only once.
+  OptHoistFindContext findCtx = {.fx = &fx};
+  for (u32 i = 1; i != argCount; ++i) {
+    opt_hoist_find(&findCtx, d, args[i]);
+  }
+
+  // Assign a free variable to each candidate.
+  ScriptVarId vars[opt_hoist_vars_max];
+  u32         hoistCount = 0;
+  for (u32 i = 0; i != findCtx.candidateCount; ++i) {
+    const u32 freeVarMask = ~hoistCtx->usedVarMask & (u32)((u64_lit(1) << script_var_count) - 1);
+    if (!freeVarMask) {
+      break; // All variables are in use.
+    }
+    vars[hoistCount] = (ScriptVarId)bits_ctz_32(freeVarMask);
+    hoistCtx->usedVarMask |= 1u << vars[hoistCount];
+    ++hoistCount;
+  }
+  if (!hoistCount) {
+    if (anyArgRewritten) {
+      return script_add_intrinsic(d, script_expr_range(d, e), ScriptIntrinsic_Loop, args);
+    }
+    return e; // Nothing to hoist.
+  }
+
+  const OptHoistReplaceContext replaceCtx = {
+      .candidates = findCtx.candidates,
+      .vars       = vars,
+      .count      = hoistCount,
+  };
+  for (u32 i = 1; i != argCount; ++i) {
+    args[i] = script_expr_rewrite(d, args[i], (void*)&replaceCtx, opt_hoist_replace_rewriter);
+  }
+
+  // Wrap the loop in a block that evaluates the hoisted expressions up-front.
+  const ScriptRange range = script_expr_range(d, e);
+  ScriptExpr        blockExprs[opt_hoist_vars_max + 1];
+  for (u32 i = 0; i != hoistCount; ++i) {
+    blockExprs[i] = script_add_anon_var_store(d, 0 /* scope */, vars[i], findCtx.candidates[i]);
+  }
+  blockExprs[hoistCount] = script_add_intrinsic(d, range, ScriptIntrinsic_Loop, args);
+  return script_add_block(d, range, blockExprs, hoistCount + 1);
+}
+
+static ScriptExpr opt_hoist(ScriptDoc* d, const ScriptExpr e) {
+  OptHoistContext hoistCtx = {0};
+  script_expr_visit(d, e, &hoistCtx.usedVarMask, opt_hoist_collect_used_vars);
+
+  return script_expr_rewrite(d, e, &hoistCtx, opt_hoist_rewriter);
+}
+
 /**
  * Shake any expressions without side-effects where the value is not used.
  * Example: '0; 1; 42' -> '42'
@@ -266,6 +512,7 @@ ScriptExpr script_optimize(ScriptDoc* d, ScriptExpr e) {
   e = script_expr_rewrite(d, e, null, opt_static_flow_rewriter);
   e = script_expr_rewrite(d, e, null, opt_static_eval_rewriter);
   e = script_expr_rewrite(d, e, null, opt_static_mem_access);
+  e = opt_hoist(d, e);
   e = script_expr_rewrite(d, e, null, opt_shake_rewriter);
   return e;
 }
@@ -10,7 +10,7 @@
 #include "panic.h"
 #include "val.h"
 
-#define script_prog_ops_max 25000
+#define script_prog_checkpoints_max 25000
 
 // clang-format off
 #define VM_VISIT_OP_SIMPLE                                                       \
@@ -124,10 +124,8 @@ void script_prog_clear(ScriptProgram* prog, Allocator* alloc) {
   }
 }
 
-ScriptProgResult script_prog_eval(
-    const ScriptProgram* prog, ScriptMem* m, const ScriptBinder* binder, void* bindCtx) {
-
-  diag_assert(prog->binderHash == (binder ? script_binder_hash(binder) : 0));
+static ScriptProgResult
+prog_eval(const ScriptProgram* prog, ScriptMem* m, const ScriptBinder* binder, void* bindCtx) {
 
   ScriptPanicHandler panicHandler;
   const u8* volatile panicHandlerIp; // Forced to live on the stack.
@@ -140,10 +138,72 @@ ScriptProgResult script_prog_eval(
 
   // clang-format off
 
-#define VM_NEXT(_OP_SIZE_) { ip += (_OP_SIZE_); goto Dispatch; }
-#define VM_JUMP(_INSTRUCTION_) { ip = ipBegin + (_INSTRUCTION_); goto Dispatch; }
-#define VM_RETURN(_VALUE_) return (ScriptProgResult){ .val = (_VALUE_), .executedOps = counter }
-#define VM_PANIC(_PANIC_) return (ScriptProgResult){ .panic = (_PANIC_), .executedOps = counter }
+#define VM_NEXT(_OP_SIZE_) { ip += (_OP_SIZE_); VM_DISPATCH(); }
+#define VM_JUMP(_INSTRUCTION_) { VM_CHECKPOINT(); ip = ipBegin + (_INSTRUCTION_); VM_DISPATCH(); }
+#define VM_RETURN(_VALUE_) return (ScriptProgResult){ .val = (_VALUE_), .checkpoints = counter }
+#define VM_PANIC(_PANIC_) return (ScriptProgResult){ .panic = (_PANIC_), .checkpoints = counter }
+
+/**
+ * Charge the execution limit. Only ops that can close a cycle (jumps and extern calls) are charged;
+ * between checkpoints the instruction pointer moves strictly forward through a bounded instruction
+ * stream, so runaway execution always reaches a checkpoint. This keeps the limit bookkeeping out
+ * of the per-op dispatch.
+ */
+#define VM_CHECKPOINT()                                                                            \
+  if (UNLIKELY(counter++ == script_prog_checkpoints_max)) {                                        \
+    VM_PANIC(((ScriptPanic){                                                                       \
+        ScriptPanic_ExecutionLimitExceeded, .range = prog_loc_from_ip(prog, ip)}));                \
+  }
+
+#if defined(VOLO_CLANG) || defined(VOLO_GCC)
+  /**
+   * Threaded dispatch: every op jumps directly to the handler of the next op instead of going
+   * through a central switch. This gives the branch-predictor one indirect branch per op (instead
+   * of a single shared one) which significantly reduces mispredictions on real-world programs.
+   */
+#define VM_OP(_OP_) VmOp_##_OP_:
+#define VM_DISPATCH() { goto *vmTargets[ip[0]]; }
+
+#define VM_OP_SIMPLE_ZERO(_OP_, _FUNC_)       [ScriptOp_##_OP_] = &&VmOp_##_OP_,
+#define VM_OP_SIMPLE_UNARY(_OP_, _FUNC_)      [ScriptOp_##_OP_] = &&VmOp_##_OP_,
+#define VM_OP_SIMPLE_BINARY(_OP_, _FUNC_)     [ScriptOp_##_OP_] = &&VmOp_##_OP_,
+#define VM_OP_SIMPLE_TERNARY(_OP_, _FUNC_)    [ScriptOp_##_OP_] = &&VmOp_##_OP_,
+#define VM_OP_SIMPLE_QUATERNARY(_OP_, _FUNC_) [ScriptOp_##_OP_] = &&VmOp_##_OP_,
+
+  // NOTE: Execution of unknown ops is undefined; 'script_prog_validate()' rejects them up-front.
+  static const void* const vmTargets[] = {
+    [ScriptOp_Fail]          = &&VmOp_Fail,
+    [ScriptOp_Assert]        = &&VmOp_Assert,
+    [ScriptOp_Return]        = &&VmOp_Return,
+    [ScriptOp_ReturnNull]    = &&VmOp_ReturnNull,
+    [ScriptOp_Move]          = &&VmOp_Move,
+    [ScriptOp_Jump]          = &&VmOp_Jump,
+    [ScriptOp_JumpIfTruthy]  = &&VmOp_JumpIfTruthy,
+    [ScriptOp_JumpIfFalsy]   = &&VmOp_JumpIfFalsy,
+    [ScriptOp_JumpIfNonNull] = &&VmOp_JumpIfNonNull,
+    [ScriptOp_Value]         = &&VmOp_Value,
+    [ScriptOp_ValueNull]     = &&VmOp_ValueNull,
+    [ScriptOp_ValueBool]     = &&VmOp_ValueBool,
+    [ScriptOp_ValueSmallInt] = &&VmOp_ValueSmallInt,
+    [ScriptOp_MemLoad]       = &&VmOp_MemLoad,
+    [ScriptOp_MemStore]      = &&VmOp_MemStore,
+    [ScriptOp_MemLoadDyn]    = &&VmOp_MemLoadDyn,
+    [ScriptOp_MemStoreDyn]   = &&VmOp_MemStoreDyn,
+    [ScriptOp_Extern]        = &&VmOp_Extern,
+
+    VM_VISIT_OP_SIMPLE
+  };
+
+#undef VM_OP_SIMPLE_QUATERNARY
+#undef VM_OP_SIMPLE_TERNARY
+#undef VM_OP_SIMPLE_BINARY
+#undef VM_OP_SIMPLE_UNARY
+#undef VM_OP_SIMPLE_ZERO
+
+#else // !(defined(VOLO_CLANG) || defined(VOLO_GCC))
+#define VM_OP(_OP_) case ScriptOp_##_OP_:
+#define VM_DISPATCH() goto Dispatch;
+#endif
 
   if (UNLIKELY(setjmp(panicHandler.anchor))) {
     /**
@@ -154,69 +214,70 @@ ScriptProgResult script_prog_eval(
     VM_PANIC(panicHandler.result);
   }
 
+#if defined(VOLO_CLANG) || defined(VOLO_GCC)
+  VM_DISPATCH();
+#else
 Dispatch:
-  if (UNLIKELY(counter++ == script_prog_ops_max)) {
-    VM_PANIC(((ScriptPanic){ScriptPanic_ExecutionLimitExceeded, .range = prog_loc_from_ip(prog, ip)}));
-  }
   switch ((ScriptOp)ip[0]) {
-  case ScriptOp_Fail:
+#endif
+  VM_OP(Fail)
     VM_PANIC(((ScriptPanic){ScriptPanic_ExecutionFailed, .range = prog_loc_from_ip(prog, ip)}));
-  case ScriptOp_Assert:
+  VM_OP(Assert)
     if (UNLIKELY(script_falsy(regs[ip[1]]))) {
       VM_PANIC(((ScriptPanic){ScriptPanic_AssertionFailed, .range = prog_loc_from_ip(prog, ip)}));
     }
     regs[ip[1]] = val_null();
     VM_NEXT(2);
-  case ScriptOp_Return:
+  VM_OP(Return)
     VM_RETURN(regs[ip[1]]);
-  case ScriptOp_ReturnNull:
+  VM_OP(ReturnNull)
     VM_RETURN(val_null());
-  case ScriptOp_Move:
+  VM_OP(Move)
     regs[ip[1]] = regs[ip[2]];
     VM_NEXT(3);
-  case ScriptOp_Jump:
+  VM_OP(Jump)
     VM_JUMP(prog_read_u16(&ip[1]));
-  case ScriptOp_JumpIfTruthy:
+  VM_OP(JumpIfTruthy)
     if (script_truthy(regs[ip[1]])) {
       VM_JUMP(prog_read_u16(&ip[2]));
     }
     VM_NEXT(4);
-  case ScriptOp_JumpIfFalsy:
+  VM_OP(JumpIfFalsy)
     if (script_falsy(regs[ip[1]])) {
       VM_JUMP(prog_read_u16(&ip[2]));
     }
     VM_NEXT(4);
-  case ScriptOp_JumpIfNonNull:
+  VM_OP(JumpIfNonNull)
     if (script_non_null(regs[ip[1]])) {
       VM_JUMP(prog_read_u16(&ip[2]));
     }
     VM_NEXT(4);
-  case ScriptOp_Value:
+  VM_OP(Value)
     regs[ip[1]] = prog->literals.values[ip[2]];
     VM_NEXT(3);
-  case ScriptOp_ValueNull:
+  VM_OP(ValueNull)
     regs[ip[1]] = val_null();
     VM_NEXT(2);
-  case ScriptOp_ValueBool:
+  VM_OP(ValueBool)
     regs[ip[1]] = val_bool(ip[2] != 0);
     VM_NEXT(3);
-  case ScriptOp_ValueSmallInt:
+  VM_OP(ValueSmallInt)
     regs[ip[1]] = val_num(ip[2]);
     VM_NEXT(3);
-  case ScriptOp_MemLoad:
+  VM_OP(MemLoad)
     regs[ip[1]] = script_mem_load(m, prog_read_u32(&ip[2]));
     VM_NEXT(6);
-  case ScriptOp_MemStore:
+  VM_OP(MemStore)
     script_mem_store(m, prog_read_u32(&ip[2]), regs[ip[1]]);
     VM_NEXT(6);
-  case ScriptOp_MemLoadDyn:
+  VM_OP(MemLoadDyn)
     if(val_type(regs[ip[1]]) == ScriptType_Str) {
       regs[ip[1]] = script_mem_load(m, val_as_str(regs[ip[1]]));
     } else {
       regs[ip[1]] = val_null();
     }
     VM_NEXT(2);
-  case ScriptOp_MemStoreDyn:
+  VM_OP(MemStoreDyn)
     if(val_type(regs[ip[1]]) == ScriptType_Str) {
       script_mem_store(m, val_as_str(regs[ip[1]]), regs[ip[2]]);
       regs[ip[1]] = regs[ip[2]];
@@ -224,7 +285,8 @@ Dispatch:
       regs[ip[1]] = val_null();
     }
     VM_NEXT(3);
-  case ScriptOp_Extern: {
+  VM_OP(Extern) {
+    VM_CHECKPOINT();
     ScriptBinderCall call = {
       .args         = &regs[ip[4]],
       .argCount     = ip[5],
@@ -236,23 +298,23 @@ Dispatch:
     VM_NEXT(6);
   }
 #define VM_OP_SIMPLE_ZERO(_OP_, _FUNC_)                                                            \
-  case ScriptOp_##_OP_:                                                                            \
+  VM_OP(_OP_)                                                                                      \
     regs[ip[1]] = _FUNC_();                                                                        \
     VM_NEXT(2)
 #define VM_OP_SIMPLE_UNARY(_OP_, _FUNC_)                                                           \
-  case ScriptOp_##_OP_:                                                                            \
+  VM_OP(_OP_)                                                                                      \
     regs[ip[1]] = _FUNC_(regs[ip[1]]);                                                             \
     VM_NEXT(2)
 #define VM_OP_SIMPLE_BINARY(_OP_, _FUNC_)                                                          \
-  case ScriptOp_##_OP_:                                                                            \
+  VM_OP(_OP_)                                                                                      \
     regs[ip[1]] = _FUNC_(regs[ip[1]], regs[ip[2]]);                                                \
     VM_NEXT(3)
 #define VM_OP_SIMPLE_TERNARY(_OP_, _FUNC_)                                                         \
-  case ScriptOp_##_OP_:                                                                            \
+  VM_OP(_OP_)                                                                                      \
     regs[ip[1]] = _FUNC_(regs[ip[1]], regs[ip[2]], regs[ip[3]]);                                   \
     VM_NEXT(4)
 #define VM_OP_SIMPLE_QUATERNARY(_OP_, _FUNC_)                                                      \
-  case ScriptOp_##_OP_:                                                                            \
+  VM_OP(_OP_)                                                                                      \
     regs[ip[1]] = _FUNC_(regs[ip[1]], regs[ip[2]], regs[ip[3]], regs[ip[4]]);                      \
     VM_NEXT(5)
 
@@ -263,14 +325,37 @@ Dispatch:
 #undef VM_OP_SIMPLE_BINARY
 #undef VM_OP_SIMPLE_UNARY
 #undef VM_OP_SIMPLE_ZERO
+#if !defined(VOLO_CLANG) && !defined(VOLO_GCC)
   }
   UNREACHABLE
+#endif
   // clang-format on
 
 #undef VM_NEXT
 #undef VM_JUMP
 #undef VM_PANIC
 #undef VM_RETURN
+#undef VM_CHECKPOINT
+#undef VM_DISPATCH
+#undef VM_OP
+}
+
+ScriptProgResult script_prog_eval(
+    const ScriptProgram* prog, ScriptMem* m, const ScriptBinder* binder, void* bindCtx) {
+  diag_assert(prog->binderHash == (binder ? script_binder_hash(binder) : 0));
+  return prog_eval(prog, m, binder, bindCtx);
+}
+
+void script_prog_eval_batch(
+    const ScriptProgram*     prog,
+    const ScriptBinder*      binder,
+    const ScriptProgEvalCtx* ctxs,
+    const u32                count,
+    ScriptProgResult*        outResults) {
+  diag_assert(prog->binderHash == (binder ? script_binder_hash(binder) : 0));
+  for (u32 i = 0; i != count; ++i) {
+    outResults[i] = prog_eval(prog, ctxs[i].mem, binder, ctxs[i].bindCtx);
+  }
 }
 
 bool script_prog_validate(const ScriptProgram* prog, const ScriptBinder* binder) {
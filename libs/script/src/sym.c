@@ -52,12 +52,19 @@ typedef struct {
   } data;
 } ScriptSymData;
 
+typedef struct {
+  u64       key; // Symbol kind + kind-specific payload, see 'sym_lookup_key_for'.
+  ScriptSym sym;
+} ScriptSymLookupEntry;
+
 struct sScriptSymBag {
   Allocator*    alloc;
   Allocator*    allocTransient;
   ScriptSymMask mask;
   DynArray      symbols;    // ScriptSymData[]
   DynArray      references; // ScriptSymRef[], kept sorted on 'sym'.
+  DynArray      lookup;     // ScriptSymLookupEntry[], sorted on 'key'. See 'sym_lookup_update'.
+  bool          lookupReady;
 };
 
 static i8 sym_compare_ref(const void* a, const void* b) {
@@ -66,12 +73,19 @@ static i8 sym_compare_ref(const void* a, const void* b) {
   return compare_u16(&entryA->sym, &entryB->sym);
 }
 
+static i8 sym_compare_lookup(const void* a, const void* b) {
+  const ScriptSymLookupEntry* entryA = a;
+  const ScriptSymLookupEntry* entryB = b;
+  return compare_u64(&entryA->key, &entryB->key);
+}
+
 static ScriptSym sym_push(ScriptSymBag* bag, ScriptSymData* data) {
   const ScriptSym id = (ScriptSym)bag->symbols.size;
   if (UNLIKELY(id == script_syms_max)) {
     return script_sym_sentinel;
   }
   *dynarray_push_t(&bag->symbols, ScriptSymData) = *data;
+  bag->lookupReady                               = false;
   return id;
 }
 
@@ -99,84 +113,94 @@ INLINE_HINT static bool sym_in_valid_range(const ScriptSymData* sym, const Scrip
   return script_range_contains(sym->validRange, pos);
 }
 
-static ScriptSym sym_find_value(const ScriptSymBag* b, const ScriptVal v) {
-  for (ScriptSym id = 0; id != b->symbols.size; ++id) {
-    const ScriptSymData* sym = sym_data(b, id);
-    switch (sym->kind) {
-    case ScriptSymKind_BuiltinConstant:
-      if (script_val_equal(sym->data.builtinConst.value, v)) {
-        return id;
-      }
-      break;
-    default:
-      break;
-    }
+static u64 sym_lookup_key(const ScriptSymKind kind, const u64 payload) {
+  return (u64)kind << 56 | payload;
+}
+
+static u64 sym_lookup_key_for(const ScriptSymData* sym) {
+  switch (sym->kind) {
+  case ScriptSymKind_BuiltinConstant:
+    return sym_lookup_key(sym->kind, script_hash(sym->data.builtinConst.value));
+  case ScriptSymKind_BuiltinFunction:
+    return sym_lookup_key(sym->kind, sym->data.builtinFunc.intr);
+  case ScriptSymKind_ExternFunction:
+    return sym_lookup_key(sym->kind, sym->data.externFunc.binderSlot);
+  case ScriptSymKind_Variable:
+    return sym_lookup_key(sym->kind, (u64)sym->data.var.scope << 8 | sym->data.var.slot);
+  case ScriptSymKind_MemoryKey:
+    return sym_lookup_key(sym->kind, sym->data.memKey.key);
+  default:
+    return sentinel_u64; // Kind is not indexed.
   }
-  return script_sym_sentinel;
 }
 
-static ScriptSym sym_find_intr(const ScriptSymBag* b, const ScriptIntrinsic intr) {
-  for (ScriptSym id = 0; id != b->symbols.size; ++id) {
-    const ScriptSymData* sym = sym_data(b, id);
-    switch (sym->kind) {
-    case ScriptSymKind_BuiltinFunction:
-      if (sym->data.builtinFunc.intr == intr) {
-        return id;
-      }
-      break;
-    default:
-      break;
+/**
+ * (Re)build the sorted lookup index over the symbols, making the find apis a binary search instead
+ * of a scan over all symbols. Finalized lazily on the first find after a push.
+ */
+static void sym_lookup_update(const ScriptSymBag* constBag) {
+  ScriptSymBag* bag = (ScriptSymBag*)constBag;
+  if (bag->lookupReady) {
+    return;
+  }
+  dynarray_clear(&bag->lookup);
+  for (ScriptSym id = 0; id != bag->symbols.size; ++id) {
+    const u64 key = sym_lookup_key_for(sym_data(bag, id));
+    if (sentinel_check(key)) {
+      continue;
     }
+    *dynarray_push_t(&bag->lookup, ScriptSymLookupEntry) = (ScriptSymLookupEntry){key, id};
   }
-  return script_sym_sentinel;
+  dynarray_sort(&bag->lookup, sym_compare_lookup);
+  bag->lookupReady = true;
 }
 
-static ScriptSym sym_find_binder_slot(const ScriptSymBag* b, const ScriptBinderSlot slot) {
-  for (ScriptSym id = 0; id != b->symbols.size; ++id) {
-    const ScriptSymData* sym = sym_data(b, id);
-    switch (sym->kind) {
-    case ScriptSymKind_ExternFunction:
-      if (sym->data.externFunc.binderSlot == slot) {
-        return id;
-      }
-      break;
-    default:
-      break;
+static ScriptSym sym_lookup_find(const ScriptSymBag* b, const u64 key) {
+  sym_lookup_update(b);
+  const ScriptSymLookupEntry  tgt = {.key = key};
+  const ScriptSymLookupEntry* res =
+      dynarray_search_binary((DynArray*)&b->lookup, sym_compare_lookup, &tgt);
+  return res ? res->sym : script_sym_sentinel;
+}
+
+static ScriptSym sym_find_value(const ScriptSymBag* b, const ScriptVal v) {
+  sym_lookup_update(b);
+  const u64                   key   = sym_lookup_key(ScriptSymKind_BuiltinConstant, script_hash(v));
+  const ScriptSymLookupEntry  tgt   = {.key = key};
+  const ScriptSymLookupEntry* begin = dynarray_begin_t((DynArray*)&b->lookup, ScriptSymLookupEntry);
+  const ScriptSymLookupEntry* end   = dynarray_end_t((DynArray*)&b->lookup, ScriptSymLookupEntry);
+
+  const ScriptSymLookupEntry* res =
+      search_binary_t(begin, end, ScriptSymLookupEntry, sym_compare_lookup, &tgt);
+  if (!res) {
+    return script_sym_sentinel;
+  }
+  // Value symbols are keyed on the value hash; walk the run of equal keys to handle collisions.
+  while (res != begin && (res - 1)->key == key) {
+    --res;
+  }
+  for (; res != end && res->key == key; ++res) {
+    if (script_val_equal(sym_data(b, res->sym)->data.builtinConst.value, v)) {
+      return res->sym;
     }
   }
   return script_sym_sentinel;
 }
 
+static ScriptSym sym_find_intr(const ScriptSymBag* b, const ScriptIntrinsic intr) {
+  return sym_lookup_find(b, sym_lookup_key(ScriptSymKind_BuiltinFunction, intr));
+}
+
+static ScriptSym sym_find_binder_slot(const ScriptSymBag* b, const ScriptBinderSlot slot) {
+  return sym_lookup_find(b, sym_lookup_key(ScriptSymKind_ExternFunction, slot));
+}
+
 static ScriptSym sym_find_var(const ScriptSymBag* b, const ScriptVarId v, const ScriptScopeId s) {
-  for (ScriptSym id = 0; id != b->symbols.size; ++id) {
-    const ScriptSymData* sym = sym_data(b, id);
-    switch (sym->kind) {
-    case ScriptSymKind_Variable:
-      if (sym->data.var.slot == v && sym->data.var.scope == s) {
-        return id;
-      }
-      break;
-    default:
-      break;
-    }
-  }
-  return script_sym_sentinel;
+  return sym_lookup_find(b, sym_lookup_key(ScriptSymKind_Variable, (u64)s << 8 | v));
 }
 
 static ScriptSym sym_find_mem_key(const ScriptSymBag* b, const StringHash memKey) {
-  for (ScriptSym id = 0; id != b->symbols.size; ++id) {
-    const ScriptSymData* sym = sym_data(b, id);
-    switch (sym->kind) {
-    case ScriptSymKind_MemoryKey:
-      if (sym->data.memKey.key == memKey) {
-        return id;
-      }
-      break;
-    default:
-      break;
-    }
-  }
-  return script_sym_sentinel;
+  return sym_lookup_find(b, sym_lookup_key(ScriptSymKind_MemoryKey, memKey));
 }
 
 ScriptSymBag* script_sym_bag_create(Allocator* alloc, const ScriptSymMask mask) {
@@ -188,6 +212,7 @@ ScriptSymBag* script_sym_bag_create(Allocator* alloc, const ScriptSymMask mask)
       .mask           = mask,
       .symbols        = dynarray_create_t(alloc, ScriptSymData, 128),
       .references     = dynarray_create_t(alloc, ScriptSymRef, 128),
+      .lookup         = dynarray_create_t(alloc, ScriptSymLookupEntry, 128),
   };
 
   return bag;
@@ -196,6 +221,7 @@ ScriptSymBag* script_sym_bag_create(Allocator* alloc, const ScriptSymMask mask)
 void script_sym_bag_destroy(ScriptSymBag* bag) {
   dynarray_destroy(&bag->symbols);
   dynarray_destroy(&bag->references);
+  dynarray_destroy(&bag->lookup);
   alloc_chunked_destroy(bag->allocTransient);
   alloc_free_t(bag->alloc, bag);
 }
@@ -203,6 +229,8 @@ void script_sym_bag_destroy(ScriptSymBag* bag) {
 void script_sym_bag_clear(ScriptSymBag* bag) {
   dynarray_clear(&bag->symbols);
   dynarray_clear(&bag->references);
+  dynarray_clear(&bag->lookup);
+  bag->lookupReady = false;
   alloc_reset(bag->allocTransient);
 }
 
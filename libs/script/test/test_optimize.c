@@ -57,6 +57,47 @@ spec(optimize) {
                 "  [value: 42]"),
         },
 
+        // Hoist loop-invariant expressions.
+        {
+            string_static("for(var i = 0; i < $a * 2; i += 1) {}"),
+            string_static(
+                "[block]\n"
+                "  [var-store: 1]\n"
+                "    [intrinsic: mul]\n"
+                "      [mem-load: $3645546703]\n"
+                "      [value: 2]\n"
+                "  [intrinsic: loop]\n"
+                "    [var-store: 0]\n"
+                "      [value: 0]\n"
+                "    [intrinsic: less]\n"
+                "      [var-load: 0]\n"
+                "      [var-load: 1]\n"
+                "    [var-store: 0]\n"
+                "      [intrinsic: add]\n"
+                "        [var-load: 0]\n"
+                "        [value: 1]\n"
+                "    [value: null]"),
+        },
+        {
+            // NOTE: Not hoistable; the loop writes memory.
+            string_static("for(var i = 0; i < $a * 2; i += 1) { $b = i }"),
+            string_static(
+                "[intrinsic: loop]\n"
+                "  [var-store: 0]\n"
+                "    [value: 0]\n"
+                "  [intrinsic: less]\n"
+                "    [var-load: 0]\n"
+                "    [intrinsic: mul]\n"
+                "      [mem-load: $3645546703]\n"
+                "      [value: 2]\n"
+                "  [var-store: 0]\n"
+                "    [intrinsic: add]\n"
+                "      [var-load: 0]\n"
+                "      [value: 1]\n"
+                "  [mem-store: $1612769824]\n"
+                "    [var-load: 0]"),
+        },
+
         // Shake non-observed expressions.
         {
             string_static("0; 1; 42"),
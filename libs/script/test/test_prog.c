@@ -298,6 +298,38 @@ spec(prog) {
     }
   }
 
+  it("can evaluate a program over a batch of contexts") {
+    const String input = string_lit("$counter = ($counter ?? 0) + 1");
+
+    const ScriptExpr expr = script_read(doc, binder, input, stringtableNull, diagsNull, symsNull);
+    check_require(!sentinel_check(expr));
+
+    script_prog_clear(&prog, g_allocHeap);
+    check_require(!script_compile(doc, null, expr, g_allocHeap, &prog));
+    check_require(script_prog_validate(&prog, binder));
+
+    ScriptMem memA = script_mem_create();
+    ScriptMem memB = script_mem_create();
+    script_mem_store(&memB, string_hash_lit("counter"), script_num(41));
+
+    const ScriptProgEvalCtx ctxs[] = {
+        {.mem = &memA, .bindCtx = bindCtxNull},
+        {.mem = &memB, .bindCtx = bindCtxNull},
+    };
+    ScriptProgResult results[array_elems(ctxs)];
+    script_prog_eval_batch(&prog, binder, ctxs, array_elems(ctxs), results);
+
+    check(!results[0].panic.kind);
+    check(!results[1].panic.kind);
+    check(script_val_equal(results[0].val, script_num(1)));
+    check(script_val_equal(results[1].val, script_num(42)));
+    check(script_val_equal(script_mem_load(&memA, string_hash_lit("counter")), script_num(1)));
+    check(script_val_equal(script_mem_load(&memB, string_hash_lit("counter")), script_num(42)));
+
+    script_mem_destroy(&memA);
+    script_mem_destroy(&memB);
+  }
+
   teardown() {
     script_destroy(doc);
     script_prog_destroy(&prog, g_allocHeap);
@@ -8,9 +8,11 @@
 
 ecs_comp_extern(SndMixerComp);
 
-typedef enum eSndChannel       SndChannel;
-typedef enum eSndResult        SndResult;
-typedef struct sSndBuffer      SndBuffer;
-typedef struct sSndBufferFrame SndBufferFrame;
-typedef struct sSndBufferView  SndBufferView;
-typedef u32                    SndObjectId;
+typedef enum eSndChannel         SndChannel;
+typedef enum eSndResult          SndResult;
+typedef struct sSndBuffer        SndBuffer;
+typedef struct sSndBufferFrame   SndBufferFrame;
+typedef struct sSndBufferView    SndBufferView;
+typedef struct sSndListener      SndListener;
+typedef struct sSndSpatialParams SndSpatialParams;
+typedef u32                      SndObjectId;
@@ -2,11 +2,12 @@
 #include "ecs/def.h"
 
 enum {
-  SndOrder_Cleanup     = -100,
-  SndOrder_Update      = 900,
-  SndOrder_RenderBegin = 1000,
-  SndOrder_RenderFill  = 1001,
-  SndOrder_RenderEnd   = 1002,
+  SndOrder_Cleanup      = -100,
+  SndOrder_Update       = 900,
+  SndOrder_RenderBegin  = 1000,
+  SndOrder_StreamDecode = 1001,
+  SndOrder_RenderFill   = 1002,
+  SndOrder_RenderEnd    = 1003,
 };
 
 /**
@@ -0,0 +1,43 @@
+#pragma once
+#include "geo/query.h"
+#include "geo/vector.h"
+#include "snd/channel.h"
+
+/**
+ * Utilities to compute spatial mixing parameters (attenuation / panning) for positional sounds.
+ */
+
+typedef struct sSndListener {
+  GeoVector position;
+  GeoVector right; // Unit vector to the listener's right; used for panning.
+} SndListener;
+
+typedef struct sSndSpatialParams {
+  f32 gain[SndChannel_Count];
+} SndSpatialParams;
+
+/**
+ * Compute the mixing parameters for a batch of emitters.
+ * Gain falls off linearly to zero at 'maxDistance' and is panned (constant power) based on the
+ * direction to the emitter; feed the resulting gains to 'snd_object_set_gain()'.
+ */
+void snd_spatial_batch(
+    const SndListener*,
+    f32               maxDistance,
+    const GeoVector*  positions,
+    u32               count,
+    SndSpatialParams* out);
+
+/**
+ * Variant of 'snd_spatial_batch()' that additionally casts an occlusion ray from the listener to
+ * each (in range) emitter; emitters behind geometry get their gain damped.
+ * Rays are cast in packets through 'geo_query_ray_batch()'.
+ */
+void snd_spatial_batch_occluded(
+    const SndListener*,
+    f32 maxDistance,
+    const GeoQueryEnv*,
+    const GeoQueryFilter*,
+    const GeoVector*  positions,
+    u32               count,
+    SndSpatialParams* out);
@@ -1,48 +1,200 @@
 #include "core/alloc.h"
 #include "core/bits.h"
-#include "core/complex.h"
 #include "core/diag.h"
 #include "core/math.h"
 #include "core/time.h"
 #include "snd/buffer.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
+#define snd_fft_count_max 8192
+
+/**
+ * Reorder the values into bit-reversed index order so the fft butterflies can run in-place.
+ */
+static void snd_fft_shuffle(f32* re, f32* im, const u32 count) {
+  for (u32 i = 1, j = 0; i != count; ++i) {
+    u32 bit = count >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j |= bit;
+    if (i < j) {
+      const f32 tmpRe = re[i];
+      const f32 tmpIm = im[i];
+      re[i]           = re[j];
+      im[i]           = im[j];
+      re[j]           = tmpRe;
+      im[j]           = tmpIm;
+    }
+  }
+}
+
+/**
+ * Single radix-2 stage over pairs of adjacent values (twiddle factor 1).
+ * Used when the total amount of stages is odd; the remaining stages are all radix-4.
+ */
+static void snd_fft_radix2(f32* re, f32* im, const u32 count) {
+  for (u32 i = 0; i != count; i += 2) {
+    const f32 tRe = re[i + 1];
+    const f32 tIm = im[i + 1];
+    re[i + 1]     = re[i] - tRe;
+    im[i + 1]     = im[i] - tIm;
+    re[i] += tRe;
+    im[i] += tIm;
+  }
+}
+
 /**
  * Fast-Fourier-Transform.
- * More info: https://en.wikipedia.org/wiki/Fast_Fourier_transform
+ * Iterative mixed-radix Cooley-Tukey implementation over planar (de-interleaved) real / imaginary
+ * arrays: radix-4 stages (each the fusion of two radix-2 stages) so the butterflies touch
+ * contiguous runs of values and can be vectorized.
+ * More info: https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm
  * Pre-condition: bits_ispow2(count).
- * Pre-condition: count <= 8192.
+ * Pre-condition: count <= snd_fft_count_max.
  */
-static void snd_fft(Complex buffer[], const u32 count) {
+static void snd_fft(f32* re, f32* im, const u32 count) {
   diag_assert(bits_ispow2(count));
-
-  /**
-   * Basic (recursive) Cooley-Tukey FFT implementation.
-   * More info: https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm
-   */
+  diag_assert(count <= snd_fft_count_max);
 
   if (count < 2) {
-    return; // Recursion done.
+    return;
   }
+  snd_fft_shuffle(re, im, count);
 
-  // Split even and odd indices into their own buffers.
-  const u32 countHalf  = count / 2;
-  Complex*  bufferEven = alloc_array_t(g_allocScratch, Complex, countHalf);
-  Complex*  bufferOdd  = alloc_array_t(g_allocScratch, Complex, countHalf);
-  for (u32 i = 0; i != countHalf; ++i) {
-    bufferEven[i] = buffer[i * 2];
-    bufferOdd[i]  = buffer[i * 2 + 1];
+  // Precompute the twiddle factors e^(-2pi*i*k / count) for k in [0, count / 2).
+  f32* twRe = alloc_array_t(g_allocScratch, f32, count / 2);
+  f32* twIm = alloc_array_t(g_allocScratch, f32, count / 2);
+  for (u32 k = 0; k != count / 2; ++k) {
+    const f64 angle = -2.0 * math_pi_f64 * k / count;
+    twRe[k]         = (f32)math_cos_f64(angle);
+    twIm[k]         = (f32)math_sin_f64(angle);
   }
 
-  // Process both halves.
-  snd_fft(bufferEven, countHalf);
-  snd_fft(bufferOdd, countHalf);
+  u32 span = 1;
+  if (bits_ctz_32(count) & 1) {
+    snd_fft_radix2(re, im, count);
+    span = 2;
+  }
+  if (count < 4) {
+    return; // Too small for any radix-4 stage.
+  }
 
-  // Compute the Discrete-Fourier-Transform.
-  for (u32 i = 0; i != countHalf; ++i) {
-    const Complex exp     = complex_exp(complex(0, -2.0 * math_pi_f64 * i / count));
-    const Complex t       = complex_mul(exp, bufferOdd[i]);
-    buffer[i]             = complex_add(bufferEven[i], t);
-    buffer[countHalf + i] = complex_sub(bufferEven[i], t);
+  // Scratch buffers to hold the twiddle factors of a single stage contiguously.
+  f32* stgRe = alloc_array_t(g_allocScratch, f32, count / 4);
+  f32* stgIm = alloc_array_t(g_allocScratch, f32, count / 4);
+
+  for (; span * 4 <= count; span *= 4) {
+    const u32 len    = span * 4;    // Length of each radix-4 block in this stage.
+    const u32 stride = count / len; // Twiddle table stride for this stage.
+
+    // Gather this stage's twiddle factors (e^(-2pi*i*j / len) for j in [0, span)) contiguously.
+    for (u32 j = 0; j != span; ++j) {
+      stgRe[j] = twRe[j * stride];
+      stgIm[j] = twIm[j * stride];
+    }
+
+    for (u32 b = 0; b != count; b += len) {
+      f32* re0 = re + b;
+      f32* im0 = im + b;
+      f32* re1 = re0 + span;
+      f32* im1 = im0 + span;
+      f32* re2 = re1 + span;
+      f32* im2 = im1 + span;
+      f32* re3 = re2 + span;
+      f32* im3 = im2 + span;
+
+      u32 j = 0;
+#ifdef VOLO_SIMD
+      for (; j + 4 <= span; j += 4) {
+        const SimdVec wRe = simd_vec_load_unaligned(stgRe + j);
+        const SimdVec wIm = simd_vec_load_unaligned(stgIm + j);
+
+        // Derive the second twiddle w2 = w^2 by complex squaring.
+        const SimdVec wCross = simd_vec_mul(wRe, wIm);
+        const SimdVec w2Re   = simd_vec_sub(simd_vec_mul(wRe, wRe), simd_vec_mul(wIm, wIm));
+        const SimdVec w2Im   = simd_vec_add(wCross, wCross);
+
+        const SimdVec x0Re = simd_vec_load_unaligned(re0 + j);
+        const SimdVec x0Im = simd_vec_load_unaligned(im0 + j);
+        const SimdVec x1Re = simd_vec_load_unaligned(re1 + j);
+        const SimdVec x1Im = simd_vec_load_unaligned(im1 + j);
+        const SimdVec x2Re = simd_vec_load_unaligned(re2 + j);
+        const SimdVec x2Im = simd_vec_load_unaligned(im2 + j);
+        const SimdVec x3Re = simd_vec_load_unaligned(re3 + j);
+        const SimdVec x3Im = simd_vec_load_unaligned(im3 + j);
+
+        // First half of the butterfly: two radix-2 butterflies with twiddle w2.
+        const SimdVec t0Re = simd_vec_sub(simd_vec_mul(w2Re, x1Re), simd_vec_mul(w2Im, x1Im));
+        const SimdVec t0Im = simd_vec_add(simd_vec_mul(w2Re, x1Im), simd_vec_mul(w2Im, x1Re));
+        const SimdVec t1Re = simd_vec_sub(simd_vec_mul(w2Re, x3Re), simd_vec_mul(w2Im, x3Im));
+        const SimdVec t1Im = simd_vec_add(simd_vec_mul(w2Re, x3Im), simd_vec_mul(w2Im, x3Re));
+        const SimdVec a0Re = simd_vec_add(x0Re, t0Re);
+        const SimdVec a0Im = simd_vec_add(x0Im, t0Im);
+        const SimdVec a1Re = simd_vec_sub(x0Re, t0Re);
+        const SimdVec a1Im = simd_vec_sub(x0Im, t0Im);
+        const SimdVec a2Re = simd_vec_add(x2Re, t1Re);
+        const SimdVec a2Im = simd_vec_add(x2Im, t1Im);
+        const SimdVec a3Re = simd_vec_sub(x2Re, t1Re);
+        const SimdVec a3Im = simd_vec_sub(x2Im, t1Im);
+
+        // Second half: radix-2 butterflies with twiddles w and -i*w.
+        const SimdVec u0Re = simd_vec_sub(simd_vec_mul(wRe, a2Re), simd_vec_mul(wIm, a2Im));
+        const SimdVec u0Im = simd_vec_add(simd_vec_mul(wRe, a2Im), simd_vec_mul(wIm, a2Re));
+        const SimdVec u1Re = simd_vec_add(simd_vec_mul(wIm, a3Re), simd_vec_mul(wRe, a3Im));
+        const SimdVec u1Im = simd_vec_sub(simd_vec_mul(wIm, a3Im), simd_vec_mul(wRe, a3Re));
+
+        simd_vec_store_unaligned(simd_vec_add(a0Re, u0Re), re0 + j);
+        simd_vec_store_unaligned(simd_vec_add(a0Im, u0Im), im0 + j);
+        simd_vec_store_unaligned(simd_vec_add(a1Re, u1Re), re1 + j);
+        simd_vec_store_unaligned(simd_vec_add(a1Im, u1Im), im1 + j);
+        simd_vec_store_unaligned(simd_vec_sub(a0Re, u0Re), re2 + j);
+        simd_vec_store_unaligned(simd_vec_sub(a0Im, u0Im), im2 + j);
+        simd_vec_store_unaligned(simd_vec_sub(a1Re, u1Re), re3 + j);
+        simd_vec_store_unaligned(simd_vec_sub(a1Im, u1Im), im3 + j);
+      }
+#endif
+      for (; j != span; ++j) {
+        const f32 wRe = stgRe[j];
+        const f32 wIm = stgIm[j];
+
+        // Derive the second twiddle w2 = w^2 by complex squaring.
+        const f32 w2Re = wRe * wRe - wIm * wIm;
+        const f32 w2Im = 2.0f * wRe * wIm;
+
+        // First half of the butterfly: two radix-2 butterflies with twiddle w2.
+        const f32 t0Re = w2Re * re1[j] - w2Im * im1[j];
+        const f32 t0Im = w2Re * im1[j] + w2Im * re1[j];
+        const f32 t1Re = w2Re * re3[j] - w2Im * im3[j];
+        const f32 t1Im = w2Re * im3[j] + w2Im * re3[j];
+        const f32 a0Re = re0[j] + t0Re;
+        const f32 a0Im = im0[j] + t0Im;
+        const f32 a1Re = re0[j] - t0Re;
+        const f32 a1Im = im0[j] - t0Im;
+        const f32 a2Re = re2[j] + t1Re;
+        const f32 a2Im = im2[j] + t1Im;
+        const f32 a3Re = re2[j] - t1Re;
+        const f32 a3Im = im2[j] - t1Im;
+
+        // Second half: radix-2 butterflies with twiddles w and -i*w.
+        const f32 u0Re = wRe * a2Re - wIm * a2Im;
+        const f32 u0Im = wRe * a2Im + wIm * a2Re;
+        const f32 u1Re = wIm * a3Re + wRe * a3Im;
+        const f32 u1Im = wIm * a3Im - wRe * a3Re;
+
+        re0[j] = a0Re + u0Re;
+        im0[j] = a0Im + u0Im;
+        re1[j] = a1Re + u1Re;
+        im1[j] = a1Im + u1Im;
+        re2[j] = a0Re - u0Re;
+        im2[j] = a0Im - u0Im;
+        re3[j] = a1Re - u1Re;
+        im3[j] = a1Im - u1Im;
+      }
+    }
   }
 }
 
@@ -121,29 +273,36 @@ f32 snd_buffer_magnitude_rms(const SndBufferView view, const SndChannel channel)
 
 void snd_buffer_spectrum(const SndBufferView view, const SndChannel channel, f32 outMagnitudes[]) {
   diag_assert(bits_ispow2(view.frameCount));
-  diag_assert(view.frameCount <= 8192);
+  diag_assert(view.frameCount <= snd_fft_count_max);
 
-  Complex* buffer = mem_stack(view.frameCount * sizeof(Complex)).ptr;
+  f32* re = mem_stack(view.frameCount * sizeof(f32)).ptr;
+  f32* im = mem_stack(view.frameCount * sizeof(f32)).ptr;
 
-  // Initialize the fft buffer.
+  // De-interleave the requested channel into the fft buffers.
   for (u32 frame = 0; frame != view.frameCount; ++frame) {
-    const f32 sample = view.frames[frame].samples[channel];
-    buffer[frame]    = complex(sample, 0);
+    re[frame] = view.frames[frame].samples[channel];
   }
+  mem_set(mem_create(im, view.frameCount * sizeof(f32)), 0);
 
   // Perform the fast-fourier-transform.
-  snd_fft(buffer, view.frameCount);
+  snd_fft(re, im, view.frameCount);
 
   // Extract the output.
   // More info: http://howthefouriertransformworks.com/understanding-the-output-of-an-fft/
   const u32 outputCount = view.frameCount / 2;
   const f32 normFactor  = 1.0f / (f32)outputCount;
-  for (u32 i = 0; i != outputCount; ++i) {
-    const Complex val = buffer[i];
+  u32       i           = 0;
+#ifdef VOLO_SIMD
+  const SimdVec norm = simd_vec_broadcast(normFactor);
+  for (; i + 4 <= outputCount; i += 4) {
+    const SimdVec vRe    = simd_vec_load_unaligned(re + i);
+    const SimdVec vIm    = simd_vec_load_unaligned(im + i);
+    const SimdVec sqrMag = simd_vec_add(simd_vec_mul(vRe, vRe), simd_vec_mul(vIm, vIm));
+    simd_vec_store_unaligned(simd_vec_mul(simd_vec_sqrt(sqrMag), norm), outMagnitudes + i);
+  }
+#endif
+  for (; i != outputCount; ++i) {
     // Use pythagoras to compute magnitude from the amplitudes of the cosine and sine waves.
-    outMagnitudes[i] = (f32)math_sqrt_f64(val.real * val.real + val.imaginary * val.imaginary);
-
-    // Normalize the magnitude.
-    outMagnitudes[i] *= normFactor;
+    outMagnitudes[i] = math_sqrt_f32(re[i] * re[i] + im[i] * im[i]) * normFactor;
   }
 }
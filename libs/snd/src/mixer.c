@@ -2,11 +2,13 @@
 #include "asset/register.h"
 #include "asset/sound.h"
 #include "core/bits.h"
+#include "core/compare.h"
 #include "core/diag.h"
 #include "core/dynarray.h"
 #include "core/float.h"
 #include "core/math.h"
 #include "core/rng.h"
+#include "core/sort.h"
 #include "ecs/entity.h"
 #include "ecs/view.h"
 #include "ecs/world.h"
@@ -22,6 +24,17 @@
 #include "core/simd.h"
 #endif
 
+/**
+ * Threading model.
+ *
+ * There is no separate audio callback thread: the device is written synchronously from the render
+ * systems ('SndMixerRenderBeginSys' till 'SndMixerRenderEndSys') and all mixer mutations (gain,
+ * object play / stop) happen through systems with write access to SndMixerComp, so the ecs
+ * scheduler serializes them against the render without any locks on the hot path. Device underruns
+ * therefore come from scheduling latency (a long frame delaying the render systems), which is
+ * mitigated by the render-fill system running at high priority and the startup warmup ticks.
+ */
+
 #define snd_mixer_objects_max 512
 ASSERT(snd_mixer_objects_max < u16_max, "Sound objects need to indexable with a 16 bit integer");
 
@@ -32,6 +45,15 @@ ASSERT(
     "Sound buffers should be cache-line aligned");
 
 #define snd_mixer_buffer_count 2
+#define snd_mixer_stream_tasks 4
+#define snd_mixer_stream_ring_frames (1 << 15)
+#define snd_mixer_stream_ahead_frames (snd_mixer_stream_ring_frames / 2)
+
+ASSERT(
+    (snd_mixer_stream_ring_frames & (snd_mixer_stream_ring_frames - 1)) == 0,
+    "Stream ring frame-count needs to be a power-of-two");
+
+#define snd_mixer_audible_max 64
 #define snd_mixer_gain_adjust_per_frame 0.00025f
 #define snd_mixer_pitch_adjust_per_frame 0.00025f
 #define snd_mixer_pitch_min 0.1f
@@ -53,6 +75,8 @@ typedef enum {
   SndObjectFlags_Looping      = 1 << 1,
   SndObjectFlags_RandomCursor = 1 << 2,
   SndObjectFlags_DelayedSetup = 1 << 3,
+  SndObjectFlags_Stream       = 1 << 4, // Frames are decoded on demand into a ring of samples.
+  SndObjectFlags_Virtual      = 1 << 5, // Outside the audible set this render; not mixed.
 } SndObjectFlags;
 
 typedef enum {
@@ -74,6 +98,16 @@ typedef struct {
   u32            frameCount, frameRate;
   const f32*     samples; // f32[frameCount * frameChannels], Interleaved (LRLRLR).
   f64            cursor;  // In frames.
+
+  /**
+   * Streamed objects (SndObjectFlags_Stream) do not have all their samples resident; instead the
+   * 'samples' pointer is a ring that frames are decoded into ahead of the cursor. Ring slots are
+   * addressed with monotonic frame indices (so unaffected by the cursor wrapping when looping).
+   */
+  f32* streamRing; // f32[snd_mixer_stream_ring_frames * SndChannel_Count], owned by the object.
+  u64  streamPos;  // Next monotonic frame to decode.
+  u64  streamBase; // Monotonic frame index the cursor is relative to; raised on cursor wrap.
+
   ALIGNAS(16) f32 paramActual[SndObjectParam_Count];
   ALIGNAS(16) f32 paramSetting[SndObjectParam_Count];
 } SndObject;
@@ -108,12 +142,28 @@ ecs_comp_define(SndMixerComp) {
   SndBufferFrame* bufferFrames; // SndBufferFrame[snd_frame_count_max][snd_mixer_buffer_count].
 };
 
+static f32* snd_object_stream_ring_alloc(void) {
+  const usize sampleCount = snd_mixer_stream_ring_frames * SndChannel_Count;
+  const Mem   ringMem     = alloc_alloc(g_allocHeap, sizeof(f32) * sampleCount, alignof(f32));
+  mem_set(ringMem, 0); // Zero the ring to avoid playing garbage before the first decode.
+  return ringMem.ptr;
+}
+
+static void snd_object_stream_ring_free(f32* ring) {
+  alloc_free_array_t(g_allocHeap, ring, snd_mixer_stream_ring_frames * SndChannel_Count);
+}
+
 static void ecs_destruct_mixer_comp(void* data) {
   SndMixerComp* m = data;
   if (m->device) {
     snd_device_destroy(m->device);
   }
 
+  for (u32 i = 0; i != snd_mixer_objects_max; ++i) {
+    if (m->objects[i].streamRing) {
+      snd_object_stream_ring_free(m->objects[i].streamRing);
+    }
+  }
   alloc_free_array_t(g_allocHeap, m->objects, snd_mixer_objects_max);
   alloc_free_array_t(g_allocHeap, m->objectNames, snd_mixer_objects_max);
   alloc_free_array_t(g_allocHeap, m->objectAssets, snd_mixer_objects_max);
@@ -188,10 +238,13 @@ static SndBuffer snd_mixer_buffer(SndMixerComp* m, const u32 index, const u32 fr
 
 ecs_view_define(AssetView) {
   ecs_access_read(AssetComp);
-  ecs_access_read(AssetSoundComp);
+  ecs_access_maybe_read(AssetSoundComp);
+  ecs_access_maybe_read(AssetSoundStreamComp);
   ecs_access_with(AssetLoadedComp);
 }
 
+ecs_view_define(StreamAssetView) { ecs_access_read(AssetSoundStreamComp); }
+
 ecs_view_define(MixerView) {
   /**
    * Mark the view as allowing parallel writes to SndMixerComp, reason is we fill multiple
@@ -278,32 +331,45 @@ ecs_system_define(SndMixerUpdateSys) {
         }
         m->objectNames[i] = asset_id(asset);
 
-        const AssetSoundComp* soundAsset = ecs_view_read_t(assetItr, AssetSoundComp);
-        obj->frameChannels               = soundAsset->frameChannels;
-        obj->frameCount                  = soundAsset->frameCount;
-        obj->frameRate                   = soundAsset->frameRate;
-        obj->samples                     = soundAsset->sampleData.ptr;
-        obj->phase                       = SndObjectPhase_Playing;
-
-        if (obj->flags & SndObjectFlags_RandomCursor) {
-          obj->cursor = rng_sample_range(g_rng, 0.0, (f64)obj->frameCount);
+        const AssetSoundComp*       soundAsset  = ecs_view_read_t(assetItr, AssetSoundComp);
+        const AssetSoundStreamComp* streamAsset = ecs_view_read_t(assetItr, AssetSoundStreamComp);
+        if (UNLIKELY(!soundAsset && !streamAsset)) {
+          log_e("Acquired asset was not a sound");
+          obj->phase = SndObjectPhase_Cleanup;
+          // Fallthrough.
+        } else {
+          if (soundAsset) {
+            obj->frameChannels = soundAsset->frameChannels;
+            obj->frameCount    = soundAsset->frameCount;
+            obj->frameRate     = soundAsset->frameRate;
+            obj->samples       = soundAsset->sampleData.ptr;
+          } else {
+            obj->flags |= SndObjectFlags_Stream;
+            obj->frameChannels = asset_sound_stream_channels(streamAsset);
+            obj->frameCount    = asset_sound_stream_frame_count(streamAsset);
+            obj->frameRate     = asset_sound_stream_frame_rate(streamAsset);
+            obj->streamRing    = snd_object_stream_ring_alloc();
+            obj->samples       = obj->streamRing;
+          }
+          obj->phase = SndObjectPhase_Playing;
+
+          if (obj->flags & SndObjectFlags_RandomCursor) {
+            obj->cursor = rng_sample_range(g_rng, 0.0, (f64)obj->frameCount);
+          }
+
+          if (!(obj->flags & SndObjectFlags_Looping)) {
+            // Start playing at the desired gain (as opposed to looping sounds which will fade-in).
+            obj->paramActual[SndObjectParam_GainLeft] = obj->paramSetting[SndObjectParam_GainLeft];
+            obj->paramActual[SndObjectParam_GainRight] =
+                obj->paramSetting[SndObjectParam_GainRight];
+          }
+
+          continue; // Ready for playback.
         }
-
-        if (!(obj->flags & SndObjectFlags_Looping)) {
-          // Start playing at the desired gain (as opposed to looping sounds which will fade-in).
-          obj->paramActual[SndObjectParam_GainLeft]  = obj->paramSetting[SndObjectParam_GainLeft];
-          obj->paramActual[SndObjectParam_GainRight] = obj->paramSetting[SndObjectParam_GainRight];
-        }
-
-        continue; // Ready for playback.
       } else if (UNLIKELY(ecs_world_has_t(world, m->objectAssets[i], AssetFailedComp))) {
         log_e("Failed to acquire sound asset");
         obj->phase = SndObjectPhase_Cleanup;
         // Fallthrough.
-      } else if (UNLIKELY(ecs_world_has_t(world, m->objectAssets[i], AssetLoadedComp))) {
-        log_e("Acquired asset was not a sound");
-        obj->phase = SndObjectPhase_Cleanup;
-        // Fallthrough.
       } else {
         continue; // Wait for the asset to load (or to fail).
       }
@@ -311,6 +377,9 @@ ecs_system_define(SndMixerUpdateSys) {
       if (LIKELY(m->objectAssets[i] && snd_asset_valid(world, m->objectAssets[i]))) {
         asset_release(world, m->objectAssets[i]);
       }
+      if (obj->streamRing) {
+        snd_object_stream_ring_free(obj->streamRing);
+      }
       snd_object_release(m, obj);
       *obj                 = (SndObject){.generation = obj->generation};
       m->objectNames[i]    = string_empty;
@@ -330,11 +399,20 @@ INLINE_HINT static void snd_object_sample(
    * curve better, like Hermite interpolation), but for down-sampling this ignores the aliasing that
    * occurs with frequencies that we cannot represent.
    */
-  const u32 edgeA  = math_min(obj->frameCount - 2, (u32)frame);
-  const u32 edgeB  = edgeA + 1;
-  const f32 frac   = (f32)(frame - edgeA);
-  const u32 indexA = edgeA * obj->frameChannels;
-  const u32 indexB = edgeB * obj->frameChannels;
+  const u32 edgeA = math_min(obj->frameCount - 2, (u32)frame);
+  const u32 edgeB = edgeA + 1;
+  const f32 frac  = (f32)(frame - edgeA);
+
+  u32 indexA, indexB;
+  if (obj->flags & SndObjectFlags_Stream) {
+    // Streamed objects sample from a ring addressed with monotonic frame indices.
+    const u64 ringMask = snd_mixer_stream_ring_frames - 1;
+    indexA             = (u32)((obj->streamBase + edgeA) & ringMask) * obj->frameChannels;
+    indexB             = (u32)((obj->streamBase + edgeB) & ringMask) * obj->frameChannels;
+  } else {
+    indexA = edgeA * obj->frameChannels;
+    indexB = edgeB * obj->frameChannels;
+  }
 
   // Left channel.
   {
@@ -362,9 +440,106 @@ INLINE_HINT static SimdVec snd_object_param_blend(
 }
 #endif
 
+/**
+ * Check if the object can be rendered with the direct (vectorizable) path: all parameters have
+ * converged to their targets, no resampling or pitching is needed and the cursor is on a whole
+ * frame, making the render a plain interleaved stereo add with constant gains. In practice this
+ * covers the bulk of the playing objects; sounds only take the generic path while ramping.
+ */
+static bool snd_object_render_direct_usable(const SndObject* obj, const SndBuffer out) {
+  if (obj->frameChannels != SndChannel_Count) {
+    return false; // Mono objects need channel duplication; handled by the generic path.
+  }
+  if (obj->frameRate != out.frameRate) {
+    return false; // Needs resampling.
+  }
+  if (obj->paramActual[SndObjectParam_Pitch] != 1.0f ||
+      obj->paramSetting[SndObjectParam_Pitch] != 1.0f) {
+    return false; // Needs resampling (or is still ramping towards the target pitch).
+  }
+  if (obj->paramActual[SndObjectParam_GainLeft] != obj->paramSetting[SndObjectParam_GainLeft]) {
+    return false; // Gain is still ramping.
+  }
+  if (obj->paramActual[SndObjectParam_GainRight] != obj->paramSetting[SndObjectParam_GainRight]) {
+    return false; // Gain is still ramping.
+  }
+  if ((f64)(u64)obj->cursor != obj->cursor) {
+    return false; // Cursor is not on a whole frame (for example due to a random start cursor).
+  }
+  return true;
+}
+
+/**
+ * Add a run of contiguous interleaved stereo frames onto the output with constant gains.
+ */
+static void snd_object_render_direct_mix(
+    const f32* restrict src,
+    SndBufferFrame* restrict dst,
+    const u32 frameCount,
+    const f32 gainLeft,
+    const f32 gainRight) {
+  f32* restrict out     = (f32* restrict)dst;
+  const u32 sampleCount = frameCount * SndChannel_Count;
+
+  u32 i = 0;
+#ifdef VOLO_SIMD
+  // Process two frames (four samples) at a time.
+  const SimdVec gain = simd_vec_set(gainLeft, gainRight, gainLeft, gainRight);
+  for (; (i + 4) <= sampleCount; i += 4) {
+    const SimdVec val   = simd_vec_mul(simd_vec_load_unaligned(src + i), gain);
+    const SimdVec accum = simd_vec_add(simd_vec_load_unaligned(out + i), val);
+    simd_vec_store_unaligned(accum, out + i);
+  }
+#endif
+  for (; i != sampleCount; i += SndChannel_Count) {
+    out[i + SndChannel_Left] += src[i + SndChannel_Left] * gainLeft;
+    out[i + SndChannel_Right] += src[i + SndChannel_Right] * gainRight;
+  }
+}
+
+static bool snd_object_render_direct(SndObject* obj, const SndBuffer out) {
+  const f32 gainLeft  = obj->paramActual[SndObjectParam_GainLeft];
+  const f32 gainRight = obj->paramActual[SndObjectParam_GainRight];
+
+  u32 frame = 0;
+  while (frame != out.frameCount) {
+    const u32 cursorFrame = (u32)obj->cursor;
+    u32       run         = math_min(out.frameCount - frame, obj->frameCount - cursorFrame);
+
+    u32 srcFrame;
+    if (obj->flags & SndObjectFlags_Stream) {
+      // Streamed objects sample from a ring addressed with monotonic frame indices.
+      const u64 ringMask = snd_mixer_stream_ring_frames - 1;
+      srcFrame           = (u32)((obj->streamBase + cursorFrame) & ringMask);
+      run                = math_min(run, snd_mixer_stream_ring_frames - srcFrame);
+    } else {
+      srcFrame = cursorFrame;
+    }
+
+    snd_object_render_direct_mix(
+        obj->samples + srcFrame * SndChannel_Count, out.frames + frame, run, gainLeft, gainRight);
+
+    frame += run;
+    obj->cursor += run;
+    if (obj->cursor >= obj->frameCount) {
+      if (obj->flags & SndObjectFlags_Looping) {
+        obj->cursor -= obj->frameCount;
+        obj->streamBase += obj->frameCount; // Keep the monotonic stream position consistent.
+      } else {
+        return false; // Finished playing.
+      }
+    }
+  }
+  return true; // Still playing.
+}
+
 static bool snd_object_render(SndObject* obj, SndBuffer out) {
   diag_assert(obj->phase == SndObjectPhase_Playing);
 
+  if (snd_object_render_direct_usable(obj, out)) {
+    return snd_object_render_direct(obj, out);
+  }
+
   const f64  advancePerFrame = obj->frameRate / (f64)out.frameRate;
   const bool pitchTooLow     = obj->paramSetting[SndObjectParam_Pitch] <= snd_mixer_pitch_min;
 
@@ -425,6 +600,7 @@ static bool snd_object_render(SndObject* obj, SndBuffer out) {
     if (UNLIKELY(obj->cursor >= obj->frameCount)) {
       if (obj->flags & SndObjectFlags_Looping) {
         obj->cursor -= obj->frameCount;
+        obj->streamBase += obj->frameCount; // Keep the monotonic stream position consistent.
       } else {
         return false; // Finished playing.
       }
@@ -483,6 +659,8 @@ static bool snd_object_skip(SndObject* obj, const TimeDuration dur) {
 
   if (obj->cursor >= obj->frameCount) {
     if (obj->flags & SndObjectFlags_Looping) {
+      // Keep the monotonic stream position consistent with the cursor wrapping.
+      obj->streamBase += (u64)(obj->cursor / obj->frameCount) * obj->frameCount;
       obj->cursor = math_mod_f64(obj->cursor, (f64)obj->frameCount);
     } else {
       return false; // Finished playing.
@@ -492,6 +670,75 @@ static bool snd_object_skip(SndObject* obj, const TimeDuration dur) {
   return true; // Still playing.
 }
 
+/**
+ * Decode frames into the stream ring up to the look-ahead distance in front of the cursor.
+ * Ring slots are addressed with monotonic frame indices so the decode target can wrap both the
+ * asset (when looping) and the ring without ambiguity.
+ */
+static void snd_object_stream_decode(SndObject* obj, const AssetSoundStreamComp* streamAsset) {
+  diag_assert(obj->flags & SndObjectFlags_Stream);
+
+  const u64 cursor = obj->streamBase + (u64)obj->cursor;
+  if (UNLIKELY(obj->streamPos < cursor)) {
+    obj->streamPos = cursor; // Decoding fell behind (eg the device skipped); resume at the cursor.
+  }
+  u64 target = cursor + snd_mixer_stream_ahead_frames;
+  if (!(obj->flags & SndObjectFlags_Looping)) {
+    target = math_min(target, obj->frameCount);
+  }
+  while (obj->streamPos < target) {
+    const u32 frame = (u32)(obj->streamPos % obj->frameCount);
+    const u32 slot  = (u32)(obj->streamPos & (snd_mixer_stream_ring_frames - 1));
+    u32       count = (u32)(target - obj->streamPos);
+    count           = math_min(count, obj->frameCount - frame);
+    count           = math_min(count, snd_mixer_stream_ring_frames - slot);
+    asset_sound_stream_read(streamAsset, frame, count, obj->streamRing + slot * obj->frameChannels);
+    obj->streamPos += count;
+  }
+}
+
+typedef struct {
+  u16 objIndex;
+  f32 gain;
+} SndMixerAudibleEntry;
+
+static i8 snd_mixer_audible_compare(const void* a, const void* b) {
+  return compare_f32_reverse(
+      field_ptr(a, SndMixerAudibleEntry, gain), field_ptr(b, SndMixerAudibleEntry, gain));
+}
+
+/**
+ * Select which objects are mixed this render: rank the playing objects on their gain and mark
+ * everything outside the top 'snd_mixer_audible_max' as virtual. Virtual objects advance their
+ * cursor (and keep ramping their parameters) without being mixed, so they resume seamlessly when
+ * they re-enter the audible set. This bounds the mixing cost when many sounds overlap.
+ */
+static void snd_mixer_select_audible(SndMixerComp* m) {
+  SndMixerAudibleEntry entries[snd_mixer_objects_max];
+  u32                  entryCount = 0;
+
+  for (u32 i = 0; i != snd_mixer_objects_max; ++i) {
+    SndObject* obj = &m->objects[i];
+    obj->flags &= ~SndObjectFlags_Virtual;
+    if (obj->phase != SndObjectPhase_Playing) {
+      continue;
+    }
+    const f32 gainLeft  = obj->paramActual[SndObjectParam_GainLeft];
+    const f32 gainRight = obj->paramActual[SndObjectParam_GainRight];
+
+    entries[entryCount].objIndex = (u16)i;
+    entries[entryCount].gain     = math_max(gainLeft, gainRight);
+    ++entryCount;
+  }
+  if (entryCount <= snd_mixer_audible_max) {
+    return; // All playing objects fit in the audible set.
+  }
+  sort_quicksort_t(entries, entries + entryCount, SndMixerAudibleEntry, snd_mixer_audible_compare);
+  for (u32 i = snd_mixer_audible_max; i != entryCount; ++i) {
+    m->objects[entries[i].objIndex].flags |= SndObjectFlags_Virtual;
+  }
+}
+
 static bool snd_object_is_muted(const SndObject* obj) {
   const bool pitchTooLow = obj->paramSetting[SndObjectParam_Pitch] <= snd_mixer_pitch_min;
   const f32  gainMult    = pitchTooLow ? 0.0f : 1.0f;
@@ -641,6 +888,8 @@ ecs_system_define(SndMixerRenderBeginSys) {
     }
   }
 
+  snd_mixer_select_audible(m);
+
   /**
    * Clear all the sound buffers.
    * NOTE: Clear all buffers here as the amount of parallelism of the filling stage could vary.
@@ -651,6 +900,37 @@ ecs_system_define(SndMixerRenderBeginSys) {
   }
 }
 
+ecs_system_define(SndMixerStreamDecodeSys) {
+  SndMixerComp* m = snd_mixer_get(world);
+  if (!m) {
+    return;
+  }
+
+  /**
+   * Decode frames for streamed objects ahead of their cursor.
+   *
+   * This system runs as multiple parallel tasks but does have write access to SndMixerComp, this
+   * means care must be taken that tasks do not touch the same data; each task decodes a disjoint
+   * set of objects.
+   *
+   * Here be dragons!
+   */
+
+  EcsView*     assetView = ecs_world_view_t(world, StreamAssetView);
+  EcsIterator* assetItr  = ecs_view_itr(assetView);
+
+  for (u32 i = parIndex; i < snd_mixer_objects_max; i += parCount) {
+    SndObject* obj = &m->objects[i];
+    if (obj->phase != SndObjectPhase_Playing || !(obj->flags & SndObjectFlags_Stream)) {
+      continue;
+    }
+    if (!ecs_view_maybe_jump(assetItr, m->objectAssets[i])) {
+      continue; // Asset no longer accessible; keep playing the already decoded frames.
+    }
+    snd_object_stream_decode(obj, ecs_view_read_t(assetItr, AssetSoundStreamComp));
+  }
+}
+
 static u32 snd_mixer_fill_objects_per_task(const u32 taskCount) {
   return math_max(1, (u32)math_round_nearest_f32(snd_mixer_objects_max / (f32)taskCount));
 }
@@ -694,6 +974,11 @@ ecs_system_define(SndMixerRenderFillSys) {
       if (!snd_object_skip(obj, soundBufferDur)) {
         goto FinishedPlaying;
       }
+    } else if (obj->flags & SndObjectFlags_Virtual) {
+      // Outside the audible set; advance without mixing so it can resume later.
+      if (!snd_object_skip(obj, soundBufferDur)) {
+        goto FinishedPlaying;
+      }
     } else {
       if (!snd_object_render(obj, soundBuffer)) {
         goto FinishedPlaying;
@@ -728,17 +1013,24 @@ ecs_module_init(snd_mixer_module) {
   ecs_register_comp(SndMixerComp, .destructor = ecs_destruct_mixer_comp);
 
   ecs_register_view(AssetView);
+  ecs_register_view(StreamAssetView);
   ecs_register_view(MixerView);
 
   ecs_register_system(SndMixerUpdateSys, ecs_view_id(MixerView), ecs_view_id(AssetView));
   ecs_register_system(SndMixerRenderBeginSys, ecs_view_id(MixerView));
-  ecs_register_system(SndMixerRenderFillSys, ecs_view_id(MixerView));
+  ecs_register_system(
+      SndMixerStreamDecodeSys, ecs_view_id(MixerView), ecs_view_id(StreamAssetView));
+  // High-priority: the render buffers have to be filled before the device period deadline.
+  ecs_register_system_with_flags(
+      SndMixerRenderFillSys, EcsSystemFlags_HighPriority, ecs_view_id(MixerView));
   ecs_register_system(SndMixerRenderEndSys, ecs_view_id(MixerView));
 
+  ecs_parallel(SndMixerStreamDecodeSys, snd_mixer_stream_tasks);
   ecs_parallel(SndMixerRenderFillSys, snd_mixer_buffer_count);
 
   ecs_order(SndMixerUpdateSys, SndOrder_Update);
   ecs_order(SndMixerRenderBeginSys, SndOrder_RenderBegin);
+  ecs_order(SndMixerStreamDecodeSys, SndOrder_StreamDecode);
   ecs_order(SndMixerRenderFillSys, SndOrder_RenderFill);
   ecs_order(SndMixerRenderEndSys, SndOrder_RenderEnd);
 }
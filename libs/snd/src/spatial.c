@@ -0,0 +1,103 @@
+#include "core/float.h"
+#include "core/intrinsic.h"
+#include "core/math.h"
+#include "geo/ray.h"
+#include "snd/spatial.h"
+
+#define snd_spatial_ray_packet_size 64
+#define snd_spatial_occluded_gain_mul 0.35f // Gain multiplier for occluded emitters.
+
+static SndSpatialParams
+snd_spatial_single(const SndListener* listener, const f32 maxDistance, const GeoVector pos) {
+  const GeoVector toEmitter = geo_vector_sub(pos, listener->position);
+  const f32       dist      = geo_vector_mag(toEmitter);
+  const f32       gain      = 1.0f - math_min(dist / maxDistance, 1.0f);
+
+  f32 pan = 0.0f; // -1: fully left, +1: fully right.
+  if (dist > f32_epsilon) {
+    pan = geo_vector_dot(toEmitter, listener->right) / dist;
+  }
+  // Constant power panning; the combined output power stays equal across the pan range.
+  return (SndSpatialParams){
+      .gain[SndChannel_Left]  = gain * intrinsic_sqrt_f32((1.0f - pan) * 0.5f),
+      .gain[SndChannel_Right] = gain * intrinsic_sqrt_f32((1.0f + pan) * 0.5f),
+  };
+}
+
+void snd_spatial_batch(
+    const SndListener* listener,
+    const f32          maxDistance,
+    const GeoVector*   positions,
+    const u32          count,
+    SndSpatialParams*  out) {
+  for (u32 i = 0; i != count; ++i) {
+    out[i] = snd_spatial_single(listener, maxDistance, positions[i]);
+  }
+}
+
+static void snd_spatial_occlusion_apply(
+    const GeoQueryEnv*    env,
+    const GeoQueryFilter* filter,
+    const f32             maxDistance,
+    const GeoRay*         rays,
+    const f32*            rayDists,
+    const u32*            rayIndices,
+    const u32             rayCount,
+    SndSpatialParams*     out) {
+  GeoQueryRayHit hits[snd_spatial_ray_packet_size];
+  geo_query_ray_batch(env, rays, rayCount, maxDistance, filter, hits);
+
+  for (u32 i = 0; i != rayCount; ++i) {
+    if (hits[i].time >= 0.0f && hits[i].time < rayDists[i]) {
+      SndSpatialParams* params = &out[rayIndices[i]];
+      params->gain[SndChannel_Left] *= snd_spatial_occluded_gain_mul;
+      params->gain[SndChannel_Right] *= snd_spatial_occluded_gain_mul;
+    }
+  }
+}
+
+void snd_spatial_batch_occluded(
+    const SndListener*    listener,
+    const f32             maxDistance,
+    const GeoQueryEnv*    env,
+    const GeoQueryFilter* filter,
+    const GeoVector*      positions,
+    const u32             count,
+    SndSpatialParams*     out) {
+  snd_spatial_batch(listener, maxDistance, positions, count, out);
+
+  /**
+   * Cast listener -> emitter rays in packets; packets of rays sharing an origin traverse the
+   * query structure together which is considerably faster then separate casts.
+   */
+  GeoRay rays[snd_spatial_ray_packet_size];
+  f32    rayDists[snd_spatial_ray_packet_size];
+  u32    rayIndices[snd_spatial_ray_packet_size];
+  u32    rayCount = 0;
+
+  for (u32 i = 0; i != count; ++i) {
+    if (out[i].gain[SndChannel_Left] <= f32_epsilon &&
+        out[i].gain[SndChannel_Right] <= f32_epsilon) {
+      continue; // Out of range (or fully attenuated); no need to cast a ray.
+    }
+    const GeoVector toEmitter = geo_vector_sub(positions[i], listener->position);
+    const f32       dist      = geo_vector_mag(toEmitter);
+    if (dist <= f32_epsilon) {
+      continue; // Emitter is at the listener; never occluded.
+    }
+    rays[rayCount].point = listener->position;
+    rays[rayCount].dir   = geo_vector_div(toEmitter, dist);
+    rayDists[rayCount]   = dist;
+    rayIndices[rayCount] = i;
+
+    if (++rayCount == snd_spatial_ray_packet_size) {
+      snd_spatial_occlusion_apply(
+          env, filter, maxDistance, rays, rayDists, rayIndices, rayCount, out);
+      rayCount = 0;
+    }
+  }
+  if (rayCount) {
+    snd_spatial_occlusion_apply(
+        env, filter, maxDistance, rays, rayDists, rayIndices, rayCount, out);
+  }
+}
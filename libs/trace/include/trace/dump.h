@@ -21,3 +21,73 @@
 void trace_dump_eventtrace(const TraceSink* storeSink, DynString* out);
 bool trace_dump_eventtrace_to_path(const TraceSink* storeSink, String path);
 bool trace_dump_eventtrace_to_path_default(const TraceSink* storeSink);
+
+/**
+ * Dump all the events from the store in a compact binary format.
+ *
+ * Layout (all integers little-endian):
+ * - Header: magic 'VOTR' followed by a u32 version.
+ * - Records until the end of the data, each starting with a u8 type:
+ *   - Stream (1): u32 stream-id, u8 name-length, name bytes.
+ *     Emitted before the first event of each stream.
+ *   - Id (2): u8 id-index, u8 name-length, name bytes.
+ *     Emitted before the first event with each id.
+ *   - Event (3): u32 stream-id, u8 id-index, u8 stack-depth, u8 color, u64 time-start
+ *     (nano-seconds since the start of the process steady clock), u32 duration (nano-seconds),
+ *     u8 message-length, message bytes.
+ *
+ * NOTE: Events are written out of chronological order, sort on time-start when order matters.
+ * NOTE: 'storeSink' has to be created from the 'trace_sink_store()' api.
+ */
+void trace_dump_bin(const TraceSink* storeSink, DynString* out);
+bool trace_dump_bin_to_path(const TraceSink* storeSink, String path);
+bool trace_dump_bin_to_path_default(const TraceSink* storeSink);
+
+/**
+ * Dump a compact plain-text analysis report of the events in the store, so the highlights of a
+ * capture can be read without loading the raw trace into a viewer.
+ *
+ * The report contains:
+ * - Top spans by self-time (span duration excluding time spent in child spans).
+ * - Per-stream breakdown of busy, wait and untracked time (gray events, for example 'job_sleep'
+ *   and 'job_wait', count as waiting by convention).
+ *
+ * NOTE: 'storeSink' has to be created from the 'trace_sink_store()' api.
+ */
+void trace_dump_report(const TraceSink* storeSink, DynString* out);
+bool trace_dump_report_to_path(const TraceSink* storeSink, String path);
+bool trace_dump_report_to_path_default(const TraceSink* storeSink);
+
+/**
+ * Continuously written trace dumps: flushes the binary dump (see 'trace_dump_bin()') to a small
+ * ring of files ('<pathPrefix>-<index>.votrace') at a fixed interval, so a capture of the recent
+ * past is always available on disk (for example for post-incident analysis) without paying the
+ * dump cost at the moment of interest. Files are written through a memory mapping so the flush
+ * does not block on disk io.
+ *
+ * Call 'trace_dump_ring_update()' periodically (for example once per frame); it only flushes once
+ * the configured interval has elapsed. Returns true when a flush happened and succeeded.
+ *
+ * NOTE: 'storeSink' has to be created from the 'trace_sink_store()' api.
+ * Should be cleaned up using 'trace_dump_ring_destroy()'.
+ */
+typedef struct sTraceDumpRing TraceDumpRing;
+
+TraceDumpRing* trace_dump_ring_create(Allocator*, String pathPrefix, u32 fileCount, TimeDuration);
+void           trace_dump_ring_destroy(TraceDumpRing*);
+bool           trace_dump_ring_update(TraceDumpRing*, const TraceSink* storeSink);
+bool           trace_dump_ring_flush(TraceDumpRing*, const TraceSink* storeSink);
+
+/**
+ * Dump the aggregated cpu-sampler stacks (see 'trace/sampler.h') in the collapsed-stack format.
+ *
+ * One line per unique stack: the frames root-to-leaf separated by semicolons, followed by a space
+ * and the sample count. This is the input format of common flame-graph tools:
+ * - FlameGraph: https://github.com/brendangregg/FlameGraph (flamegraph.pl my_dump.stacks)
+ * - Speedscope: https://www.speedscope.app/
+ *
+ * NOTE: Requires debug information for pretty frame names, without it relative addresses are used.
+ */
+void trace_dump_sampler(DynString* out);
+bool trace_dump_sampler_to_path(String path);
+bool trace_dump_sampler_to_path_default(void);
@@ -0,0 +1,53 @@
+#pragma once
+#include "core/symbol.h"
+
+/**
+ * Sampling cpu profiler.
+ *
+ * Periodically captures the stack of the cpu-consuming threads using a profiling timer and
+ * aggregates the captured stacks into a fixed-size table. Unlike the trace events this finds
+ * hot-spots in code that was never instrumented, at the cost of statistical (instead of exact)
+ * results.
+ *
+ * NOTE: There is a single global sampler; only one capture can be active at a time.
+ * NOTE: Support is platform dependent, check 'trace_sampler_supported()' before starting.
+ */
+
+typedef struct sTraceSamplerEntry {
+  SymbolStack stack;
+  u64         count; // Amount of samples attributed to this stack.
+} TraceSamplerEntry;
+
+/**
+ * Check if cpu sampling is supported on this platform.
+ */
+bool trace_sampler_supported(void);
+
+/**
+ * Check if a capture is currently active.
+ */
+bool trace_sampler_active(void);
+
+/**
+ * Start capturing samples at the given (cpu-time) interval.
+ * Discards the samples of any previous capture.
+ * NOTE: Is a no-op when sampling is not supported or a capture is already active.
+ */
+void trace_sampler_start(TimeDuration interval);
+
+/**
+ * Stop the active capture.
+ * The aggregated samples remain available for querying until the next capture is started.
+ */
+void trace_sampler_stop(void);
+
+/**
+ * Total amount of samples recorded in the current capture.
+ */
+u64 trace_sampler_count(void);
+
+/**
+ * Query the aggregated samples, returns the amount of entries written to the output.
+ * Entries are sorted on their sample-count (highest first).
+ */
+u32 trace_sampler_query(TraceSamplerEntry* out, u32 outMax);
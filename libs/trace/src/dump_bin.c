@@ -0,0 +1,167 @@
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/path.h"
+#include "log/logger.h"
+#include "trace/dump.h"
+#include "trace/sink_store.h"
+
+#define trace_max_streams 64
+
+/**
+ * Dump all trace events in a compact binary format, see 'trace/dump.h' for the layout.
+ *
+ * The format is designed to be cheap enough to write that traces can be dumped in production, the
+ * per-event cost is a fixed 19 bytes plus the message payload (instead of the roughly 150 bytes
+ * per event of the eye-readable EventTrace format).
+ */
+
+static const String g_traceBinMagic   = string_static("VOTR");
+static const u32    g_traceBinVersion = 1;
+
+/**
+ * Version history:
+ * 1: Initial version.
+ */
+
+typedef enum {
+  TraceBinRecord_Stream = 1,
+  TraceBinRecord_Id     = 2,
+  TraceBinRecord_Event  = 3,
+} TraceBinRecord;
+
+typedef struct {
+  DynString* out;
+  i32        streams[trace_max_streams]; // Array of stream-ids that have been added.
+  u64        idMask[4];                  // Bitmask of event-ids that have been added.
+} DumpBinCtx;
+
+static void dump_bin_push_u8(DumpBinCtx* ctx, const u8 val) {
+  mem_write_u8(dynstring_push(ctx->out, sizeof(u8)), val);
+}
+
+static void dump_bin_push_u32(DumpBinCtx* ctx, const u32 val) {
+  mem_write_le_u32(dynstring_push(ctx->out, sizeof(u32)), val);
+}
+
+static void dump_bin_push_u64(DumpBinCtx* ctx, const u64 val) {
+  mem_write_le_u64(dynstring_push(ctx->out, sizeof(u64)), val);
+}
+
+static void dump_bin_push_str(DumpBinCtx* ctx, const String str) {
+  diag_assert(str.size <= u8_max);
+  dump_bin_push_u8(ctx, (u8)str.size);
+  dynstring_append(ctx->out, str);
+}
+
+static void dump_bin_init(DumpBinCtx* ctx) {
+  dynstring_append(ctx->out, g_traceBinMagic);
+  dump_bin_push_u32(ctx, g_traceBinVersion);
+}
+
+static bool dump_bin_register_stream(DumpBinCtx* ctx, const i32 streamId) {
+  diag_assert(streamId >= 0);
+
+  // Check if the stream has been registered before.
+  for (u32 i = 0; i != trace_max_streams; ++i) {
+    if (ctx->streams[i] == streamId) {
+      return false;
+    }
+  }
+
+  // Register the stream.
+  for (u32 i = 0; i != trace_max_streams; ++i) {
+    if (ctx->streams[i] < 0) {
+      ctx->streams[i] = streamId;
+      return true;
+    }
+  }
+
+  diag_crash_msg("trace: Maximum stream-count exceeded");
+}
+
+static void dump_bin_visitor(
+    const TraceSink*       sink,
+    void*                  userCtx,
+    const i32              streamId,
+    const String           streamName,
+    const TraceStoreEvent* evt) {
+  DumpBinCtx* ctx = userCtx;
+
+  if (dump_bin_register_stream(ctx, streamId)) {
+    dump_bin_push_u8(ctx, TraceBinRecord_Stream);
+    dump_bin_push_u32(ctx, (u32)streamId);
+    dump_bin_push_str(ctx, streamName);
+  }
+
+  if (!(ctx->idMask[evt->id / 64] & (u64_lit(1) << (evt->id % 64)))) {
+    ctx->idMask[evt->id / 64] |= u64_lit(1) << (evt->id % 64);
+    dump_bin_push_u8(ctx, TraceBinRecord_Id);
+    dump_bin_push_u8(ctx, evt->id);
+    dump_bin_push_str(ctx, trace_sink_store_id(sink, evt->id));
+  }
+
+  dump_bin_push_u8(ctx, TraceBinRecord_Event);
+  dump_bin_push_u32(ctx, (u32)streamId);
+  dump_bin_push_u8(ctx, evt->id);
+  dump_bin_push_u8(ctx, evt->stackDepth);
+  dump_bin_push_u8(ctx, evt->color);
+  dump_bin_push_u64(ctx, (u64)evt->timeStart);
+  dump_bin_push_u32(ctx, evt->timeDur);
+  dump_bin_push_str(ctx, mem_create(evt->msgData, evt->msgLength));
+}
+
+void trace_dump_bin(const TraceSink* storeSink, DynString* out) {
+  DumpBinCtx ctx = {.out = out};
+  mem_set(array_mem(ctx.streams), 0xFF);
+
+  dump_bin_init(&ctx);
+  trace_sink_store_visit(storeSink, dump_bin_visitor, &ctx);
+}
+
+bool trace_dump_bin_to_path(const TraceSink* storeSink, const String path) {
+  if (UNLIKELY(!path.size || path.size > 1024)) {
+    diag_crash_msg("trace: dump path length invalid");
+  }
+  /**
+   * Copy the path to the stack before writing the events to avoid potential issues when the path
+   * was allocated in scratch memory and we use scratch memory during the writing.
+   */
+  const Mem pathCopy = mem_stack(path.size);
+  mem_cpy(pathCopy, path);
+
+  DynString dynString = dynstring_create(g_allocHeap, 64 * usize_kibibyte);
+
+  trace_dump_bin(storeSink, &dynString);
+
+  const FileResult res = file_write_to_path_atomic(pathCopy, dynstring_view(&dynString));
+
+  dynstring_destroy(&dynString);
+
+  if (UNLIKELY(res != FileResult_Success)) {
+    log_e(
+        "Failed to dump binary trace data",
+        log_param("error", fmt_text(file_result_str(res))),
+        log_param("path", fmt_path(pathCopy)),
+        log_param("size", fmt_size(dynString.size)));
+    return false;
+  }
+
+  log_i(
+      "Dumped binary trace data",
+      log_param("path", fmt_path(pathCopy)),
+      log_param("size", fmt_size(dynString.size)));
+
+  return true;
+}
+
+bool trace_dump_bin_to_path_default(const TraceSink* storeSink) {
+  const String pathScratch = path_build_scratch(
+      path_parent(g_pathExecutable),
+      string_lit("logs"),
+      path_name_timestamp_scratch(path_stem(g_pathExecutable), string_lit("votrace")));
+
+  return trace_dump_bin_to_path(storeSink, pathScratch);
+}
@@ -0,0 +1,307 @@
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/compare.h"
+#include "core/diag.h"
+#include "core/dynarray.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/math.h"
+#include "core/path.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "trace/dump.h"
+#include "trace/sink_store.h"
+#include "trace/tracer.h"
+
+#define trace_report_streams_max 64
+#define trace_report_ids_max 256
+#define trace_report_top_spans 15
+
+/**
+ * Analysis report over the stored trace events, see 'trace/dump.h' for the report contents.
+ *
+ * Self-time of an event is its duration minus the duration of its child events; events are matched
+ * to their parents by sorting them chronologically per stream and tracking the last open event at
+ * each stack depth. Gray events count as waiting by convention (for example 'job_sleep' and
+ * 'job_wait'), their self-time is reported as wait-time for the stream.
+ */
+
+typedef struct {
+  TimeSteady timeStart;
+  u32        timeDur;
+  u8         id;
+  u8         stackDepth;
+  u8         color;
+  u8         streamIdx;
+} ReportEvent;
+
+typedef struct {
+  i32        id;
+  String     name;
+  TimeSteady timeBegin, timeEnd;
+  u64        rootDur; // Summed duration of root (depth 0) events.
+  u64        waitDur; // Summed self-duration of wait (gray) events.
+  u32        eventCount;
+} ReportStream;
+
+typedef struct {
+  u64 totalDur; // Summed event duration.
+  u64 selfDur;  // Summed event duration excluding child events.
+  u64 maxDur;
+  u32 count;
+} ReportIdStats;
+
+typedef struct {
+  DynArray     events; // ReportEvent[]
+  ReportStream streams[trace_report_streams_max];
+  u32          streamCount;
+} ReportCtx;
+
+static u8 report_stream_idx(ReportCtx* ctx, const i32 streamId, const String streamName) {
+  for (u32 i = 0; i != ctx->streamCount; ++i) {
+    if (ctx->streams[i].id == streamId) {
+      return (u8)i;
+    }
+  }
+  if (UNLIKELY(ctx->streamCount == trace_report_streams_max)) {
+    diag_crash_msg("trace: Maximum stream-count exceeded");
+  }
+  ctx->streams[ctx->streamCount] = (ReportStream){
+      .id   = streamId,
+      .name = string_dup(g_allocScratch, streamName),
+  };
+  return (u8)ctx->streamCount++;
+}
+
+static void report_visitor(
+    const TraceSink*       sink,
+    void*                  userCtx,
+    const i32              streamId,
+    const String           streamName,
+    const TraceStoreEvent* evt) {
+  (void)sink;
+  ReportCtx* ctx = userCtx;
+
+  *dynarray_push_t(&ctx->events, ReportEvent) = (ReportEvent){
+      .timeStart  = evt->timeStart,
+      .timeDur    = evt->timeDur,
+      .id         = evt->id,
+      .stackDepth = evt->stackDepth,
+      .color      = evt->color,
+      .streamIdx  = report_stream_idx(ctx, streamId, streamName),
+  };
+}
+
+static i8 report_event_compare(const void* a, const void* b) {
+  const ReportEvent* evtA = a;
+  const ReportEvent* evtB = b;
+  if (evtA->streamIdx != evtB->streamIdx) {
+    return evtA->streamIdx < evtB->streamIdx ? -1 : 1;
+  }
+  if (evtA->timeStart != evtB->timeStart) {
+    return evtA->timeStart < evtB->timeStart ? -1 : 1;
+  }
+  return compare_u8(&evtA->stackDepth, &evtB->stackDepth);
+}
+
+/**
+ * Compute the self-time (duration minus child durations) of every event.
+ * Pre-condition: events are sorted by stream and chronologically within each stream.
+ */
+static void report_compute_self(const ReportEvent* events, const u32 count, i64* outSelf) {
+  u32 openAtDepth[u8_max + 1]; // Event index + 1 of the last open event at each depth, 0 if none.
+  u8  lastStream = 0;
+  mem_set(array_mem(openAtDepth), 0);
+
+  for (u32 i = 0; i != count; ++i) {
+    const ReportEvent* evt = &events[i];
+    if (evt->streamIdx != lastStream) {
+      lastStream = evt->streamIdx;
+      mem_set(array_mem(openAtDepth), 0);
+    }
+    outSelf[i] = (i64)evt->timeDur;
+    if (evt->stackDepth) {
+      const u32 parentIdx = openAtDepth[evt->stackDepth - 1];
+      if (parentIdx) {
+        const ReportEvent* parent = &events[parentIdx - 1];
+        if (parent->timeStart + (TimeSteady)parent->timeDur >= evt->timeStart) {
+          outSelf[parentIdx - 1] -= (i64)evt->timeDur;
+        }
+      }
+    }
+    openAtDepth[evt->stackDepth] = i + 1;
+  }
+}
+
+static void report_write_spans(
+    DynString* out, const TraceSink* sink, const ReportIdStats ids[trace_report_ids_max]) {
+  fmt_write(out, "Top spans by self-time:\n");
+  fmt_write(out, "  {>10} {>10} {>8} {>10}  name\n",
+      fmt_text_lit("self"),
+      fmt_text_lit("total"),
+      fmt_text_lit("count"),
+      fmt_text_lit("max"));
+
+  bool written[trace_report_ids_max] = {false};
+  for (u32 line = 0; line != trace_report_top_spans; ++line) {
+    u32 bestId   = 0;
+    u64 bestSelf = 0;
+    for (u32 id = 0; id != trace_report_ids_max; ++id) {
+      if (!written[id] && ids[id].count && ids[id].selfDur >= bestSelf) {
+        bestId   = id;
+        bestSelf = ids[id].selfDur;
+      }
+    }
+    if (!ids[bestId].count || written[bestId]) {
+      break; // No more spans to report.
+    }
+    written[bestId] = true;
+    fmt_write(
+        out,
+        "  {>10} {>10} {>8} {>10}  {}\n",
+        fmt_duration((TimeDuration)ids[bestId].selfDur),
+        fmt_duration((TimeDuration)ids[bestId].totalDur),
+        fmt_int(ids[bestId].count),
+        fmt_duration((TimeDuration)ids[bestId].maxDur),
+        fmt_text(trace_sink_store_id(sink, (u8)bestId)));
+  }
+}
+
+static void report_write_streams(DynString* out, const ReportCtx* ctx) {
+  fmt_write(out, "Streams:\n");
+  fmt_write(out, "  {>10} {>10} {>10} {>8}  name\n",
+      fmt_text_lit("busy"),
+      fmt_text_lit("wait"),
+      fmt_text_lit("untracked"),
+      fmt_text_lit("events"));
+
+  for (u32 i = 0; i != ctx->streamCount; ++i) {
+    const ReportStream* stream = &ctx->streams[i];
+    if (!stream->eventCount) {
+      continue;
+    }
+    const u64 span      = (u64)time_steady_duration(stream->timeBegin, stream->timeEnd);
+    const u64 busy      = stream->rootDur - math_min(stream->waitDur, stream->rootDur);
+    const u64 untracked = span - math_min(stream->rootDur, span);
+    fmt_write(
+        out,
+        "  {>10} {>10} {>10} {>8}  {}\n",
+        fmt_duration((TimeDuration)busy),
+        fmt_duration((TimeDuration)stream->waitDur),
+        fmt_duration((TimeDuration)untracked),
+        fmt_int(stream->eventCount),
+        fmt_text(stream->name));
+  }
+}
+
+void trace_dump_report(const TraceSink* storeSink, DynString* out) {
+  ReportCtx ctx = {
+      .events = dynarray_create_t(g_allocHeap, ReportEvent, 4096),
+  };
+  trace_sink_store_visit(storeSink, report_visitor, &ctx);
+  dynarray_sort(&ctx.events, report_event_compare);
+
+  const u32          eventCount = (u32)ctx.events.size;
+  const ReportEvent* events     = dynarray_begin_t(&ctx.events, ReportEvent);
+
+  i64* self = alloc_array_t(g_allocHeap, i64, math_max(eventCount, 1));
+  report_compute_self(events, eventCount, self);
+
+  ReportIdStats ids[trace_report_ids_max] = {0};
+  u32           idCount                   = 0;
+  for (u32 i = 0; i != eventCount; ++i) {
+    const ReportEvent* evt     = &events[i];
+    const u64          selfDur = (u64)math_max(self[i], 0);
+
+    ReportIdStats* idStats = &ids[evt->id];
+    idCount += !idStats->count;
+    idStats->totalDur += evt->timeDur;
+    idStats->selfDur += selfDur;
+    idStats->maxDur = math_max(idStats->maxDur, evt->timeDur);
+    ++idStats->count;
+
+    ReportStream*    stream = &ctx.streams[evt->streamIdx];
+    const TimeSteady evtEnd = evt->timeStart + (TimeSteady)evt->timeDur;
+    if (!stream->eventCount) {
+      stream->timeBegin = evt->timeStart;
+      stream->timeEnd   = evtEnd;
+    } else {
+      stream->timeBegin = math_min(stream->timeBegin, evt->timeStart);
+      stream->timeEnd   = math_max(stream->timeEnd, evtEnd);
+    }
+    ++stream->eventCount;
+    if (!evt->stackDepth) {
+      stream->rootDur += evt->timeDur;
+    }
+    if (evt->color == TraceColor_Gray) {
+      stream->waitDur += selfDur;
+    }
+  }
+
+  TimeSteady rangeBegin = 0, rangeEnd = 0;
+  for (u32 i = 0; i != ctx.streamCount; ++i) {
+    if (!ctx.streams[i].eventCount) {
+      continue;
+    }
+    if (!rangeEnd || ctx.streams[i].timeBegin < rangeBegin) {
+      rangeBegin = ctx.streams[i].timeBegin;
+    }
+    rangeEnd = math_max(rangeEnd, ctx.streams[i].timeEnd);
+  }
+
+  fmt_write(
+      out,
+      "Trace report: {} events, {} spans, {} streams, {} range\n\n",
+      fmt_int(eventCount),
+      fmt_int(idCount),
+      fmt_int(ctx.streamCount),
+      fmt_duration(time_steady_duration(rangeBegin, rangeEnd)));
+  report_write_spans(out, storeSink, ids);
+  fmt_write(out, "\n");
+  report_write_streams(out, &ctx);
+
+  alloc_free_array_t(g_allocHeap, self, math_max(eventCount, 1));
+  dynarray_destroy(&ctx.events);
+}
+
+bool trace_dump_report_to_path(const TraceSink* storeSink, const String path) {
+  if (UNLIKELY(!path.size || path.size > 1024)) {
+    diag_crash_msg("trace: dump path length invalid");
+  }
+  /**
+   * Copy the path to the stack before writing the report to avoid potential issues when the path
+   * was allocated in scratch memory and we use scratch memory during the writing.
+   */
+  const Mem pathCopy = mem_stack(path.size);
+  mem_cpy(pathCopy, path);
+
+  DynString dynString = dynstring_create(g_allocHeap, 16 * usize_kibibyte);
+
+  trace_dump_report(storeSink, &dynString);
+
+  const FileResult res = file_write_to_path_atomic(pathCopy, dynstring_view(&dynString));
+
+  dynstring_destroy(&dynString);
+
+  if (UNLIKELY(res != FileResult_Success)) {
+    log_e(
+        "Failed to dump trace report",
+        log_param("error", fmt_text(file_result_str(res))),
+        log_param("path", fmt_path(pathCopy)));
+    return false;
+  }
+
+  log_i("Dumped trace report", log_param("path", fmt_path(pathCopy)));
+
+  return true;
+}
+
+bool trace_dump_report_to_path_default(const TraceSink* storeSink) {
+  const String pathScratch = path_build_scratch(
+      path_parent(g_pathExecutable),
+      string_lit("logs"),
+      path_name_timestamp_scratch(path_stem(g_pathExecutable), string_lit("report")));
+
+  return trace_dump_report_to_path(storeSink, pathScratch);
+}
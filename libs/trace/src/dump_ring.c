@@ -0,0 +1,106 @@
+#include "core/alloc.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/time.h"
+#include "log/logger.h"
+#include "trace/dump.h"
+
+/**
+ * Continuously written trace dumps.
+ *
+ * The binary dump (see 'trace_dump_bin()') is flushed to a small ring of files at a fixed
+ * interval, so a capture of the recent past is always available on disk (for example for
+ * post-incident analysis) without paying the dump cost at the moment of interest.
+ *
+ * Files are written through a memory mapping: the file is resized to the dump size, mapped,
+ * filled, and unmapped again; the kernel writes the dirty pages back in the background so the
+ * flush itself never blocks on disk io.
+ */
+
+typedef struct sTraceDumpRing {
+  Allocator*   alloc;
+  String       pathPrefix;
+  u32          fileCount, fileNext;
+  TimeDuration interval;
+  TimeSteady   timeLastFlush;
+  DynString    buffer; // Reused buffer the dump is written into before being copied to the file.
+} TraceDumpRing;
+
+static String dump_ring_path_scratch(const TraceDumpRing* ring, const u32 index) {
+  return fmt_write_scratch("{}-{}.votrace", fmt_text(ring->pathPrefix), fmt_int(index));
+}
+
+TraceDumpRing* trace_dump_ring_create(
+    Allocator*         alloc,
+    const String       pathPrefix,
+    const u32          fileCount,
+    const TimeDuration interval) {
+  diag_assert(fileCount);
+
+  TraceDumpRing* ring = alloc_alloc_t(alloc, TraceDumpRing);
+
+  *ring = (TraceDumpRing){
+      .alloc         = alloc,
+      .pathPrefix    = string_dup(alloc, pathPrefix),
+      .fileCount     = fileCount,
+      .interval      = interval,
+      .timeLastFlush = time_steady_clock(),
+      .buffer        = dynstring_create(alloc, 64 * usize_kibibyte),
+  };
+  return ring;
+}
+
+void trace_dump_ring_destroy(TraceDumpRing* ring) {
+  string_free(ring->alloc, ring->pathPrefix);
+  dynstring_destroy(&ring->buffer);
+  alloc_free_t(ring->alloc, ring);
+}
+
+bool trace_dump_ring_flush(TraceDumpRing* ring, const TraceSink* storeSink) {
+  dynstring_clear(&ring->buffer);
+  trace_dump_bin(storeSink, &ring->buffer);
+
+  const String path = dump_ring_path_scratch(ring, ring->fileNext);
+  ring->fileNext    = (ring->fileNext + 1) % ring->fileCount;
+
+  bool       success = false;
+  File*      file    = null;
+  FileResult fileRes;
+
+  const FileAccessFlags access = FileAccess_Read | FileAccess_Write;
+  if ((fileRes = file_create(g_allocHeap, path, FileMode_Create, access, &file))) {
+    goto Ret;
+  }
+  if ((fileRes = file_resize_sync(file, ring->buffer.size))) {
+    goto Ret;
+  }
+  String mapping;
+  if ((fileRes = file_map(file, 0 /* offset */, 0 /* size */, FileHints_None, &mapping))) {
+    goto Ret;
+  }
+  mem_cpy(mapping, dynstring_view(&ring->buffer));
+  fileRes = file_unmap(file, mapping);
+  success = fileRes == FileResult_Success;
+
+Ret:
+  if (file) {
+    file_destroy(file);
+  }
+  if (UNLIKELY(!success)) {
+    log_w(
+        "Failed to flush trace ring file",
+        log_param("error", fmt_text(file_result_str(fileRes))),
+        log_param("path", fmt_path(path)));
+  }
+  return success;
+}
+
+bool trace_dump_ring_update(TraceDumpRing* ring, const TraceSink* storeSink) {
+  const TimeSteady timeNow = time_steady_clock();
+  if (time_steady_duration(ring->timeLastFlush, timeNow) < ring->interval) {
+    return false; // Interval has not elapsed yet.
+  }
+  ring->timeLastFlush = timeNow;
+  return trace_dump_ring_flush(ring, storeSink);
+}
@@ -0,0 +1,100 @@
+#include "core/alloc.h"
+#include "core/array.h"
+#include "core/diag.h"
+#include "core/dynstring.h"
+#include "core/file.h"
+#include "core/format.h"
+#include "core/path.h"
+#include "core/sentinel.h"
+#include "log/logger.h"
+#include "trace/dump.h"
+#include "trace/sampler.h"
+
+#define trace_dump_sampler_max_entries 1024
+
+/**
+ * Dump the aggregated cpu-sampler stacks in the collapsed-stack format: one line per unique stack
+ * with the frames root-to-leaf separated by semicolons, followed by the sample count.
+ */
+
+static void dump_sampler_frame_write(DynString* out, const SymbolAddrRel frame) {
+  const String name = symbol_dbg_name(frame);
+  if (name.size) {
+    dynstring_append(out, name);
+  } else {
+    // No debug information available for this frame; fall back to the relative address.
+    format_write_u64(out, frame, &format_opts_int(.base = 16, .minDigits = 8));
+  }
+}
+
+void trace_dump_sampler(DynString* out) {
+  TraceSamplerEntry* entries =
+      alloc_array_t(g_allocHeap, TraceSamplerEntry, trace_dump_sampler_max_entries);
+
+  const u32 entryCount = trace_sampler_query(entries, trace_dump_sampler_max_entries);
+  for (u32 i = 0; i != entryCount; ++i) {
+    const TraceSamplerEntry* entry = &entries[i];
+
+    // Count the frames; unused frames are set to sentinel values.
+    u32 frameCount = 0;
+    while (frameCount != array_elems(entry->stack.frames) &&
+           !sentinel_check(entry->stack.frames[frameCount])) {
+      ++frameCount;
+    }
+
+    // Write the frames root-to-leaf (the stack stores the topmost frame first).
+    for (u32 frameIdx = frameCount; frameIdx-- != 0;) {
+      dump_sampler_frame_write(out, entry->stack.frames[frameIdx]);
+      dynstring_append_char(out, frameIdx ? ';' : ' ');
+    }
+    format_write_u64(out, entry->count, &format_opts_int());
+    dynstring_append_char(out, '\n');
+  }
+
+  alloc_free_array_t(g_allocHeap, entries, trace_dump_sampler_max_entries);
+}
+
+bool trace_dump_sampler_to_path(const String path) {
+  if (UNLIKELY(!path.size || path.size > 1024)) {
+    diag_crash_msg("trace: dump path length invalid");
+  }
+  /**
+   * Copy the path to the stack before writing the events to avoid potential issues when the path
+   * was allocated in scratch memory and we use scratch memory during the writing.
+   */
+  const Mem pathCopy = mem_stack(path.size);
+  mem_cpy(pathCopy, path);
+
+  DynString dynString = dynstring_create(g_allocHeap, 64 * usize_kibibyte);
+
+  trace_dump_sampler(&dynString);
+
+  const FileResult res = file_write_to_path_atomic(pathCopy, dynstring_view(&dynString));
+
+  dynstring_destroy(&dynString);
+
+  if (UNLIKELY(res != FileResult_Success)) {
+    log_e(
+        "Failed to dump cpu-sampler data",
+        log_param("error", fmt_text(file_result_str(res))),
+        log_param("path", fmt_path(pathCopy)),
+        log_param("size", fmt_size(dynString.size)));
+    return false;
+  }
+
+  log_i(
+      "Dumped cpu-sampler data",
+      log_param("path", fmt_path(pathCopy)),
+      log_param("size", fmt_size(dynString.size)));
+
+  return true;
+}
+
+bool trace_dump_sampler_to_path_default(void) {
+  const String pathScratch = path_build_scratch(
+      path_parent(g_pathExecutable),
+      string_lit("logs"),
+      path_name_timestamp_scratch(path_stem(g_pathExecutable), string_lit("stacks")));
+
+  return trace_dump_sampler_to_path(pathScratch);
+}
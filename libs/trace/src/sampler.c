@@ -0,0 +1,126 @@
+#include "core/array.h"
+#include "core/bits.h"
+#include "core/compare.h"
+#include "core/diag.h"
+#include "core/sort.h"
+#include "core/thread.h"
+#include "log/logger.h"
+
+#include "sampler.h"
+
+#define trace_sampler_slots 1024
+
+ASSERT((trace_sampler_slots & (trace_sampler_slots - 1u)) == 0, "Has to be a pow2");
+
+typedef enum {
+  TraceSamplerSlot_Empty = 0,
+  TraceSamplerSlot_Initializing, // Stack is being written by the claiming thread.
+  TraceSamplerSlot_Ready,
+} TraceSamplerSlotState;
+
+typedef struct {
+  i32         state; // TraceSamplerSlotState, atomically accessed.
+  i64         count; // Atomically accessed.
+  SymbolStack stack;
+} TraceSamplerSlot;
+
+/**
+ * Aggregation table; open-addressing on the stack hash.
+ * NOTE: Only atomics are used so recording stays async-signal-safe, slots are never removed while
+ * a capture is active (the whole table is reset when a new capture starts).
+ */
+static TraceSamplerSlot g_traceSamplerSlots[trace_sampler_slots];
+static i64              g_traceSamplerCount;   // Total amount of recorded samples.
+static i64              g_traceSamplerDropped; // Samples dropped due to the table being full.
+static bool             g_traceSamplerActive;
+
+bool trace_sampler_supported(void) { return trace_sampler_pal_supported(); }
+
+bool trace_sampler_active(void) { return g_traceSamplerActive; }
+
+void trace_sampler_start(const TimeDuration interval) {
+  diag_assert_msg(interval > 0, "trace: Invalid sample interval");
+
+  if (!trace_sampler_pal_supported()) {
+    log_w("Cpu sampling is not supported on this platform");
+    return;
+  }
+  if (g_traceSamplerActive) {
+    return; // A capture is already active.
+  }
+
+  // Discard the samples of any previous capture.
+  mem_set(array_mem(g_traceSamplerSlots), 0);
+  thread_atomic_store_i64(&g_traceSamplerCount, 0);
+  thread_atomic_store_i64(&g_traceSamplerDropped, 0);
+
+  g_traceSamplerActive = true;
+  trace_sampler_pal_start(interval);
+
+  log_i("Cpu sampler started", log_param("interval", fmt_duration(interval)));
+}
+
+void trace_sampler_stop(void) {
+  if (!g_traceSamplerActive) {
+    return;
+  }
+  trace_sampler_pal_stop();
+  g_traceSamplerActive = false;
+
+  log_i(
+      "Cpu sampler stopped",
+      log_param("samples", fmt_int(thread_atomic_load_i64(&g_traceSamplerCount))),
+      log_param("dropped", fmt_int(thread_atomic_load_i64(&g_traceSamplerDropped))));
+}
+
+u64 trace_sampler_count(void) { return (u64)thread_atomic_load_i64(&g_traceSamplerCount); }
+
+void trace_sampler_record(const SymbolStack* stack) {
+  if (!symbol_stack_valid(stack)) {
+    return; // No frames inside our executable (for example an external thread).
+  }
+  thread_atomic_add_i64(&g_traceSamplerCount, 1);
+
+  const u32 hash = bits_hash_32(mem_var(stack->frames));
+  for (u32 i = 0; i != trace_sampler_slots; ++i) {
+    TraceSamplerSlot* slot  = &g_traceSamplerSlots[(hash + i) & (trace_sampler_slots - 1)];
+    i32               state = thread_atomic_load_i32(&slot->state);
+    if (state == TraceSamplerSlot_Empty) {
+      if (thread_atomic_compare_exchange_i32(&slot->state, &state, TraceSamplerSlot_Initializing)) {
+        slot->stack = *stack;
+        thread_atomic_store_i32(&slot->state, TraceSamplerSlot_Ready);
+        thread_atomic_add_i64(&slot->count, 1);
+        return;
+      }
+      state = thread_atomic_load_i32(&slot->state); // Another thread claimed the slot; re-check.
+    }
+    if (state == TraceSamplerSlot_Initializing) {
+      continue; // Slot is being written by another thread; probe the next slot.
+    }
+    if (symbol_stack_equal(&slot->stack, stack)) {
+      thread_atomic_add_i64(&slot->count, 1);
+      return;
+    }
+  }
+  thread_atomic_add_i64(&g_traceSamplerDropped, 1); // Table is full; drop the sample.
+}
+
+static i8 trace_sampler_entry_compare(const void* a, const void* b) {
+  return compare_u64_reverse(
+      field_ptr(a, TraceSamplerEntry, count), field_ptr(b, TraceSamplerEntry, count));
+}
+
+u32 trace_sampler_query(TraceSamplerEntry* out, const u32 outMax) {
+  u32 count = 0;
+  for (u32 i = 0; i != trace_sampler_slots && count != outMax; ++i) {
+    TraceSamplerSlot* slot = &g_traceSamplerSlots[i];
+    if (thread_atomic_load_i32(&slot->state) != TraceSamplerSlot_Ready) {
+      continue;
+    }
+    out[count].stack = slot->stack;
+    out[count].count = (u64)thread_atomic_load_i64(&slot->count);
+    ++count;
+  }
+  sort_quicksort_t(out, out + count, TraceSamplerEntry, trace_sampler_entry_compare);
+  return count;
+}
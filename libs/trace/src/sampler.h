@@ -0,0 +1,12 @@
+#pragma once
+#include "trace/sampler.h"
+
+bool trace_sampler_pal_supported(void);
+void trace_sampler_pal_start(TimeDuration interval);
+void trace_sampler_pal_stop(void);
+
+/**
+ * Record a single sample for the given stack.
+ * NOTE: Is async-signal-safe; can be called from the platform sampling interrupt.
+ */
+void trace_sampler_record(const SymbolStack*);
@@ -0,0 +1,7 @@
+#if defined(VOLO_LINUX)
+#include "sampler_pal_linux.c"
+#elif defined(VOLO_WIN32)
+#include "sampler_pal_win32.c"
+#else
+#error Unsupported platform
+#endif
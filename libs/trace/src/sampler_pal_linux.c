@@ -0,0 +1,52 @@
+#include "core/diag.h"
+#include "core/time.h"
+
+#include "sampler.h"
+
+#include <signal.h>
+#include <sys/time.h>
+
+/**
+ * Cpu sampling using a posix profiling timer.
+ *
+ * The timer counts the cpu-time of the whole process and delivers SIGPROF to a thread that is
+ * currently running, so samples naturally land on the threads that consume the cpu. The handler
+ * walks the stack of the interrupted thread (frame-pointer walk; async-signal-safe) and records it.
+ */
+
+static void SYS_DECL trace_sampler_pal_handler(const int posixSignal) {
+  (void)posixSignal;
+  const SymbolStack stack = symbol_stack_walk();
+  trace_sampler_record(&stack);
+}
+
+bool trace_sampler_pal_supported(void) { return true; }
+
+void trace_sampler_pal_start(const TimeDuration interval) {
+  struct sigaction action = {
+      .sa_handler = trace_sampler_pal_handler,
+      .sa_flags   = SA_RESTART,
+  };
+  sigemptyset(&action.sa_mask);
+  if (UNLIKELY(sigaction(SIGPROF, &action, null) != 0)) {
+    diag_crash_msg("trace: Failed to install the sampling signal handler");
+  }
+
+  const struct timeval tv = {
+      .tv_sec  = interval / time_second,
+      .tv_usec = (interval % time_second) / time_microsecond,
+  };
+  const struct itimerval timer = {.it_interval = tv, .it_value = tv};
+  if (UNLIKELY(setitimer(ITIMER_PROF, &timer, null) != 0)) {
+    diag_crash_msg("trace: Failed to start the sampling timer");
+  }
+}
+
+void trace_sampler_pal_stop(void) {
+  /**
+   * Disarm the timer; the handler stays installed as a signal that was already raised can still be
+   * delivered after this point (recording an extra sample is harmless).
+   */
+  const struct itimerval timer = {0};
+  setitimer(ITIMER_PROF, &timer, null);
+}
@@ -0,0 +1,13 @@
+#include "sampler.h"
+
+/**
+ * Cpu sampling is not supported on win32 at this time; there is no equivalent of the posix
+ * profiling timer and capturing the stack of a running thread requires suspending it (and walking
+ * the x64 unwind tables from another thread), which has not been implemented yet.
+ */
+
+bool trace_sampler_pal_supported(void) { return false; }
+
+void trace_sampler_pal_start(const TimeDuration interval) { (void)interval; }
+
+void trace_sampler_pal_stop(void) {}
@@ -1,7 +1,10 @@
 #include "app/check.h"
 
 void app_check_init(CheckDef* check) {
+  register_spec(check, dump_bin);
   register_spec(check, dump_eventtrace);
+  register_spec(check, dump_report);
+  register_spec(check, sampler);
   register_spec(check, sink_store);
   register_spec(check, tracer);
 }
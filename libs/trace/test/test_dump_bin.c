@@ -0,0 +1,107 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/dynstring.h"
+#include "trace/dump.h"
+#include "trace/sink_store.h"
+#include "trace/tracer.h"
+
+typedef struct {
+  u32    streamId;
+  u8     id;
+  u32    timeDur;
+  String msg;
+} TestBinEvent;
+
+static Mem test_consume_str(Mem data, String* out) {
+  u8 length;
+  data = mem_consume_u8(data, &length);
+  *out = mem_slice(data, 0, length);
+  return mem_consume(data, length);
+}
+
+/**
+ * Find an event with the given id-name, see 'trace/dump.h' for the format layout.
+ * Returns true when found and writes the event to the output pointer.
+ */
+static bool test_find_event_by_id(Mem data, const String idName, TestBinEvent* out) {
+  data = mem_consume(data, 4 /* magic */ + 4 /* version */);
+
+  u8 targetId = sentinel_u8;
+  while (data.size) {
+    u8 recordType;
+    data = mem_consume_u8(data, &recordType);
+    switch (recordType) {
+    case 1 /* Stream */: {
+      String name;
+      data = mem_consume(data, sizeof(u32));
+      data = test_consume_str(data, &name);
+    } break;
+    case 2 /* Id */: {
+      u8     id;
+      String name;
+      data = mem_consume_u8(data, &id);
+      data = test_consume_str(data, &name);
+      if (string_eq(name, idName)) {
+        targetId = id;
+      }
+    } break;
+    case 3 /* Event */: {
+      TestBinEvent evt;
+      u64          timeStart;
+      data = mem_consume_le_u32(data, &evt.streamId);
+      data = mem_consume_u8(data, &evt.id);
+      data = mem_consume(data, 2 /* stack-depth + color */);
+      data = mem_consume_le_u64(data, &timeStart);
+      data = mem_consume_le_u32(data, &evt.timeDur);
+      data = test_consume_str(data, &evt.msg);
+      if (evt.id == targetId) {
+        *out = evt;
+        return true;
+      }
+    } break;
+    default:
+      return false; // Unknown record type.
+    }
+  }
+  return false;
+}
+
+spec(dump_bin) {
+
+  Tracer*    tracer;
+  TraceSink* storeSink;
+  DynString  buffer = {0};
+
+  setup() {
+    tracer = trace_create(g_allocHeap);
+    trace_add_sink(tracer, storeSink = trace_sink_store(g_allocHeap));
+
+    buffer = dynstring_create(g_allocHeap, 1024);
+  }
+
+  it("starts with the format magic") {
+    trace_dump_bin(storeSink, &buffer);
+
+    check(buffer.size >= 8);
+    check_eq_string(mem_slice(dynstring_view(&buffer), 0, 4), string_lit("VOTR"));
+  }
+
+  it("can dump events") {
+    static const String g_evtName = string_static("testEvt");
+
+    trace_event_begin_msg(tracer, g_evtName, TraceColor_Red, string_lit("Hello World"), fmt_args());
+    trace_event_end(tracer);
+
+    trace_dump_bin(storeSink, &buffer);
+
+    TestBinEvent evt;
+    check_require(test_find_event_by_id(dynstring_view(&buffer), g_evtName, &evt));
+    check_eq_string(evt.msg, string_lit("Hello World"));
+    check(evt.timeDur > 0);
+  }
+
+  teardown() {
+    trace_destroy(tracer);
+    dynstring_destroy(&buffer);
+  }
+}
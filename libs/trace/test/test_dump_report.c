@@ -0,0 +1,44 @@
+#include "check/spec.h"
+#include "core/alloc.h"
+#include "core/dynstring.h"
+#include "trace/dump.h"
+#include "trace/sink_store.h"
+#include "trace/tracer.h"
+
+spec(dump_report) {
+
+  Tracer*    tracer;
+  TraceSink* storeSink;
+  DynString  buffer = {0};
+
+  setup() {
+    tracer = trace_create(g_allocHeap);
+    trace_add_sink(tracer, storeSink = trace_sink_store(g_allocHeap));
+
+    buffer = dynstring_create(g_allocHeap, 1024);
+  }
+
+  it("starts with the report header") {
+    trace_dump_report(storeSink, &buffer);
+
+    check(string_starts_with(dynstring_view(&buffer), string_lit("Trace report:")));
+  }
+
+  it("reports recorded spans") {
+    trace_event_begin(tracer, string_lit("testEvtParent"), TraceColor_Red);
+    trace_event_begin(tracer, string_lit("testEvtChild"), TraceColor_Blue);
+    trace_event_end(tracer);
+    trace_event_end(tracer);
+
+    trace_dump_report(storeSink, &buffer);
+
+    const String report = dynstring_view(&buffer);
+    check(!sentinel_check(string_find_first(report, string_lit("testEvtParent"))));
+    check(!sentinel_check(string_find_first(report, string_lit("testEvtChild"))));
+  }
+
+  teardown() {
+    trace_destroy(tracer);
+    dynstring_destroy(&buffer);
+  }
+}
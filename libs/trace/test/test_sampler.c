@@ -0,0 +1,35 @@
+#include "check/spec.h"
+#include "core/array.h"
+#include "core/time.h"
+#include "trace/sampler.h"
+
+static CheckTestFlags test_sampler_flags(void) {
+  return trace_sampler_supported() ? CheckTestFlags_None : CheckTestFlags_Skip;
+}
+
+spec(sampler) {
+
+  it("is inactive by default") { check(!trace_sampler_active()); }
+
+  it("aggregates captured stacks", .flags = test_sampler_flags()) {
+    trace_sampler_start(time_millisecond);
+    check(trace_sampler_active());
+
+    // Burn cpu-time until a sample was recorded (with a generous cap to avoid hanging on failure).
+    const TimeSteady capTime = time_steady_clock() + time_seconds(5);
+    volatile u64     work    = 0;
+    while (!trace_sampler_count() && time_steady_clock() < capTime) {
+      ++work;
+    }
+
+    trace_sampler_stop();
+    check(!trace_sampler_active());
+    check(trace_sampler_count() > 0);
+
+    TraceSamplerEntry entries[64];
+    const u32         entryCount = trace_sampler_query(entries, array_elems(entries));
+    check(entryCount > 0);
+    check(entries[0].count > 0);
+    check(symbol_stack_valid(&entries[0].stack));
+  }
+}
@@ -49,6 +49,17 @@ typedef struct sUiTable {
  */
 f32 ui_table_height(const UiTable*, u32 rows);
 
+typedef struct {
+  u32 begin, end; // Row indices; 'end' is exclusive.
+} UiTableRowSpan;
+
+/**
+ * Query the range of rows that intersect the visible window of the given scrollview.
+ * Only the returned rows need to be materialized (use 'ui_table_jump_row()' to jump to the first);
+ * size the scrollview content using 'ui_table_height()' with the total row count.
+ */
+UiTableRowSpan ui_table_visible_rows(const UiTable*, const UiScrollview*, u32 totalRows);
+
 /**
  * Test if the table is currently active.
  * NOTE: Use 'ui_table_next_row()' to activate the first row.
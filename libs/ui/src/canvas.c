@@ -55,12 +55,22 @@ typedef struct {
 } UiPersistentElem;
 
 typedef enum {
-  UiCanvasFlags_InputAny     = 1 << 0,
-  UiCanvasFlags_InputControl = 1 << 1,
+  UiCanvasFlags_InputAny        = 1 << 0,
+  UiCanvasFlags_InputControl    = 1 << 1,
+  UiCanvasFlags_BuildCacheValid = 1 << 2,
 
   UiCanvasFlags_Volatile = UiCanvasFlags_InputAny | UiCanvasFlags_InputControl,
 } UiCanvasFlags;
 
+/**
+ * Clip rectangle in the cached build output.
+ * NOTE: Clip ids are assigned per window per frame; the recorded id is remapped while replaying.
+ */
+typedef struct {
+  u8     id; // Clip id at the time of recording.
+  UiRect rect;
+} UiBuildCacheClipRect;
+
 ecs_comp_define(UiRendererComp) {
   EcsEntityId rendObj;
   DynArray    deferredAtoms[UiLayer_Count - 1]; // UiAtomData[][]
@@ -86,6 +96,15 @@ ecs_comp_define(UiCanvasComp) {
   TimeSteady     activeStatusStart;
   UiInteractType interactType : 8;
   u8             soundRequests; // Bitset of UiSoundType's to play.
+
+  /**
+   * Cached output of the last build; canvasses whose commands (and other build inputs) are
+   * unchanged skip the build and replay this output instead.
+   */
+  u32           buildCacheHash; // Hash of the build inputs that produced the cached output.
+  UiBuildResult buildCacheResult;
+  DynArray      buildCacheClipRects;            // UiBuildCacheClipRect[]
+  DynArray      buildCacheAtoms[UiLayer_Count]; // UiAtomData[] per layer.
 };
 
 ecs_comp_define(UiOwnerComp) { EcsEntityId owner; };
@@ -101,6 +120,8 @@ static void ecs_destruct_canvas(void* data) {
   ui_editor_destroy(comp->textEditor);
   dynarray_destroy(&comp->trackedElems);
   dynarray_destroy(&comp->persistentElems);
+  dynarray_destroy(&comp->buildCacheClipRects);
+  array_for_t(comp->buildCacheAtoms, DynArray, atoms) { dynarray_destroy(atoms); }
 }
 
 static i8 ui_canvas_ptr_compare(const void* a, const void* b) {
@@ -215,11 +236,14 @@ static u8 ui_canvas_output_clip_rect(void* userCtx, const UiRect rect) {
   diag_assert(state->clipRectCount < ui_canvas_clip_rects_max);
   const u8 id          = state->clipRectCount++;
   state->clipRects[id] = rect;
+
+  *dynarray_push_t(&state->canvas->buildCacheClipRects, UiBuildCacheClipRect) =
+      (UiBuildCacheClipRect){.id = id, .rect = rect};
   return id;
 }
 
-static void ui_canvas_output_atom(void* userCtx, const UiAtomData data, const UiLayer layer) {
-  UiRenderState* state = userCtx;
+static void
+ui_canvas_submit_atom(UiRenderState* state, const UiAtomData data, const UiLayer layer) {
   if (layer == UiLayer_Normal) {
     *rend_object_add_instance_t(state->rendObj, UiAtomData, 0, geo_box_inverted3()) = data;
     return;
@@ -227,6 +251,12 @@ static void ui_canvas_output_atom(void* userCtx, const UiAtomData data, const Ui
   *dynarray_push_t(&state->renderer->deferredAtoms[layer - 1], UiAtomData) = data;
 }
 
+static void ui_canvas_output_atom(void* userCtx, const UiAtomData data, const UiLayer layer) {
+  UiRenderState* state = userCtx;
+  *dynarray_push_t(&state->canvas->buildCacheAtoms[layer], UiAtomData) = data;
+  ui_canvas_submit_atom(state, data, layer);
+}
+
 static void ui_canvas_output_rect(void* userCtx, const UiId id, const UiRect rect) {
   UiRenderState* state                       = userCtx;
   ui_canvas_tracked(state->canvas, id)->rect = rect;
@@ -304,8 +334,66 @@ static void ui_canvas_update_interaction(
   canvas->activeElemFlags = hoveredFlags;
 }
 
+/**
+ * Compute a hash of all the inputs that affect the build output of the given canvas.
+ */
+static u32 ui_canvas_build_hash(const UiRenderState* state, const UiId debugElem) {
+  const UiCanvasComp*         canvas   = state->canvas;
+  const UiSettingsGlobalComp* settings = state->settings;
+
+  u32 hash = ui_cmdbuffer_hash(canvas->cmdBuffer);
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(canvas->resolution)));
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(canvas->inputPos)));
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(debugElem)));
+
+  // The default style and the inspector mode feed into the build.
+  const u32 styleBits = (u32)settings->defaultOutline | ((u32)settings->defaultVariation << 8) |
+                        ((u32)settings->defaultWeight << 16);
+  hash = bits_hash_32_combine(hash, bits_hash_32(mem_var(styleBits)));
+  hash = bits_hash_32_combine(hash, bits_hash_32(mem_var(settings->defaultColor)));
+  hash = bits_hash_32_combine(hash, bits_hash_32(mem_var(settings->inspectorMode)));
+
+  // Glyph / image lookups depend on the atlases; invalidate when they are reloaded.
+  const uptr atlasPtrs[] = {(uptr)state->atlasFont, (uptr)state->atlasImage};
+  hash                   = bits_hash_32_combine(hash, bits_hash_32(mem_var(atlasPtrs)));
+  return hash;
+}
+
+/**
+ * Re-submit the cached output of the last build of this canvas.
+ * Clip ids are assigned per window per frame so the cached atoms are remapped while submitting.
+ */
+static UiBuildResult ui_canvas_build_replay(UiRenderState* state) {
+  UiCanvasComp* canvas = state->canvas;
+
+  u8 clipRemap[ui_canvas_clip_rects_max] = {0}; // Id 0 is the (identical) full-canvas rect.
+  dynarray_for_t(&canvas->buildCacheClipRects, UiBuildCacheClipRect, cacheRect) {
+    diag_assert(state->clipRectCount < ui_canvas_clip_rects_max);
+    const u8 newId           = state->clipRectCount++;
+    state->clipRects[newId]  = cacheRect->rect;
+    clipRemap[cacheRect->id] = newId;
+  }
+  for (UiLayer layer = 0; layer != UiLayer_Count; ++layer) {
+    dynarray_for_t(&canvas->buildCacheAtoms[layer], UiAtomData, atom) {
+      UiAtomData data = *atom;
+      data.clipId     = clipRemap[data.clipId];
+      ui_canvas_submit_atom(state, data, layer);
+    }
+  }
+  return canvas->buildCacheResult;
+}
+
 static UiBuildResult ui_canvas_build(UiRenderState* state, const UiId debugElem) {
+  UiCanvasComp* canvas = state->canvas;
+  const u32     hash   = ui_canvas_build_hash(state, debugElem);
+  if (canvas->flags & UiCanvasFlags_BuildCacheValid && canvas->buildCacheHash == hash) {
+    // Nothing that affects the output changed; skip the build and replay last frame's output.
+    // NOTE: The tracked elements are not cleared in this case and thus also remain valid.
+    return ui_canvas_build_replay(state);
+  }
   dynarray_clear(&state->canvas->trackedElems);
+  dynarray_clear(&canvas->buildCacheClipRects);
+  array_for_t(canvas->buildCacheAtoms, DynArray, atoms) { dynarray_clear(atoms); }
 
   const UiBuildCtx buildCtx = {
       .settings       = state->settings,
@@ -320,7 +408,12 @@ static UiBuildResult ui_canvas_build(UiRenderState* state, const UiId debugElem)
       .outputRect     = &ui_canvas_output_rect,
       .outputTextInfo = &ui_canvas_output_text_info,
   };
-  return ui_build(state->canvas->cmdBuffer, &buildCtx);
+  const UiBuildResult result = ui_build(canvas->cmdBuffer, &buildCtx);
+
+  canvas->flags |= UiCanvasFlags_BuildCacheValid;
+  canvas->buildCacheHash   = hash;
+  canvas->buildCacheResult = result;
+  return result;
 }
 
 ecs_view_define(InputGlobalView) { ecs_access_read(UiSettingsGlobalComp); }
@@ -730,7 +823,12 @@ ui_canvas_create(EcsWorld* world, const EcsEntityId window, const UiCanvasCreate
       .cmdBuffer       = ui_cmdbuffer_create(g_allocHeap),
       .textEditor      = ui_editor_create(g_allocHeap),
       .trackedElems    = dynarray_create_t(g_allocHeap, UiTrackedElem, 16),
-      .persistentElems = dynarray_create_t(g_allocHeap, UiPersistentElem, 16));
+      .persistentElems = dynarray_create_t(g_allocHeap, UiPersistentElem, 16),
+      .buildCacheClipRects = dynarray_create_t(g_allocHeap, UiBuildCacheClipRect, 8));
+
+  array_for_t(canvas->buildCacheAtoms, DynArray, atoms) {
+    *atoms = dynarray_create_t(g_allocHeap, UiAtomData, 32);
+  }
 
   if (flags & UiCanvasCreateFlags_ToFront) {
     ui_canvas_to_front(canvas);
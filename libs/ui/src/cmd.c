@@ -1,9 +1,9 @@
+#include "core/bits.h"
 #include "core/dynarray.h"
 #include "log/logger.h"
 
 #include "cmd.h"
 
-#define ui_cmdbuffer_transient_chunk_size (32 * usize_kibibyte)
 #define ui_cmdbuffer_max_text_size (8 * usize_kibibyte)
 
 ASSERT(ui_cmdbuffer_max_text_size < u16_max, "Text size needs to be storable in a u16");
@@ -11,40 +11,52 @@ ASSERT(ui_cmdbuffer_max_text_size < u16_max, "Text size needs to be storable in
 struct sUiCmdBuffer {
   DynArray   commands; // UiCmd[]
   Allocator* alloc;
-  Allocator* allocTransient;
 };
 
 INLINE_HINT static UiCmd* ui_cmdbuffer_push(UiCmdBuffer* buffer) {
-  return (UiCmd*)dynarray_push(&buffer->commands, 1).ptr;
+  UiCmd* cmd = (UiCmd*)dynarray_push(&buffer->commands, 1).ptr;
+  mem_set(mem_create(cmd, sizeof(UiCmd)), 0); // Zero (including padding) so commands can be hashed.
+  return cmd;
 }
 
 UiCmdBuffer* ui_cmdbuffer_create(Allocator* alloc) {
   UiCmdBuffer* buffer = alloc_alloc_t(alloc, UiCmdBuffer);
 
-  Allocator* allocTransient =
-      alloc_chunked_create(g_allocHeap, alloc_bump_create, ui_cmdbuffer_transient_chunk_size);
-
   *buffer = (UiCmdBuffer){
-      .commands       = dynarray_create_t(alloc, UiCmd, 128),
-      .alloc          = alloc,
-      .allocTransient = allocTransient,
+      .commands = dynarray_create_t(alloc, UiCmd, 128),
+      .alloc    = alloc,
   };
   return buffer;
 }
 
 void ui_cmdbuffer_destroy(UiCmdBuffer* buffer) {
   dynarray_destroy(&buffer->commands);
-  alloc_chunked_destroy(buffer->allocTransient);
   alloc_free_t(buffer->alloc, buffer);
 }
 
-void ui_cmdbuffer_clear(UiCmdBuffer* buffer) {
-  dynarray_clear(&buffer->commands);
-  alloc_reset(buffer->allocTransient);
-}
+void ui_cmdbuffer_clear(UiCmdBuffer* buffer) { dynarray_clear(&buffer->commands); }
 
 u32 ui_cmdbuffer_count(const UiCmdBuffer* buffer) { return (u32)buffer->commands.size; }
 
+u32 ui_cmdbuffer_hash(const UiCmdBuffer* buffer) {
+  u32 hash = 42;
+  dynarray_for_t(&buffer->commands, UiCmd, cmd) {
+    if (cmd->type == UiCmd_DrawText) {
+      // Text is stored externally; hash the contents instead of the (frame specific) pointer.
+      UiCmd copy            = *cmd;
+      copy.drawText.textPtr = null;
+      hash = bits_hash_32_combine(hash, bits_hash_32(mem_var(copy)));
+      if (cmd->drawText.textSize) {
+        hash = bits_hash_32_combine(
+            hash, bits_hash_32(mem_create(cmd->drawText.textPtr, cmd->drawText.textSize)));
+      }
+      continue;
+    }
+    hash = bits_hash_32_combine(hash, bits_hash_32(mem_var(*cmd)));
+  }
+  return hash;
+}
+
 void ui_cmd_push_rect_push(UiCmdBuffer* buffer) {
   UiCmd* cmd = ui_cmdbuffer_push(buffer);
   cmd->type  = UiCmd_RectPush;
@@ -212,10 +224,12 @@ void ui_cmd_push_draw_text(
         log_param("limit", fmt_size(ui_cmdbuffer_max_text_size)));
     return;
   }
-  const String textCopy = string_maybe_dup(buffer->allocTransient, text);
+  // NOTE: Text lives in the frame allocator; commands are re-recorded every frame so the text is
+  // always valid when the buffer is built later in the same frame.
+  const String textCopy = string_maybe_dup(g_allocFrame, text);
   if (UNLIKELY(text.size && !mem_valid(textCopy))) {
     // TODO: Report error.
-    return; // Transient allocator ran out of space.
+    return; // Frame allocator ran out of space.
   }
   UiCmd* cmd    = ui_cmdbuffer_push(buffer);
   cmd->type     = UiCmd_DrawText;
@@ -145,6 +145,12 @@ void         ui_cmdbuffer_destroy(UiCmdBuffer*);
 void         ui_cmdbuffer_clear(UiCmdBuffer*);
 u32          ui_cmdbuffer_count(const UiCmdBuffer*);
 
+/**
+ * Compute a hash of all the commands in the buffer (including any referenced text).
+ * Identical command streams produce identical hashes.
+ */
+u32 ui_cmdbuffer_hash(const UiCmdBuffer*);
+
 void ui_cmd_push_rect_push(UiCmdBuffer*);
 void ui_cmd_push_rect_pop(UiCmdBuffer*);
 void ui_cmd_push_rect_pos(UiCmdBuffer*, UiBase origin, UiVector offset, UiBase units, UiAxis);
@@ -1,6 +1,8 @@
 #include "core/diag.h"
+#include "core/math.h"
 #include "ui/canvas.h"
 #include "ui/layout.h"
+#include "ui/scrollview.h"
 #include "ui/shape.h"
 #include "ui/style.h"
 #include "ui/table.h"
@@ -66,6 +68,28 @@ f32 ui_table_height(const UiTable* table, const u32 rows) {
   return rows * table->rowHeight + (rows + 1) * table->spacing.y;
 }
 
+UiTableRowSpan ui_table_visible_rows(
+    const UiTable* table, const UiScrollview* scrollview, const u32 totalRows) {
+  const f32 step = table->rowHeight + table->spacing.y;
+  diag_assert(step > 0);
+
+  const f32 viewMin = scrollview->offset;
+  const f32 viewMax = scrollview->offset + scrollview->lastViewportHeight;
+
+  /**
+   * Row 'i' occupies the y range starting at 'ui_table_height(table, i)'; a row is visible when
+   * its bottom reaches the view start and its top does not pass the view end.
+   */
+  const f32 first = (viewMin - table->spacing.y - table->rowHeight) / step;
+  const f32 last  = (viewMax - table->spacing.y) / step; // Inclusive.
+
+  UiTableRowSpan span;
+  span.begin = first > 0 ? (u32)math_round_up_f32(first) : 0;
+  span.end   = last >= 0 ? math_min((u32)last + 1, totalRows) : 0;
+  span.begin = math_min(span.begin, span.end);
+  return span;
+}
+
 bool ui_table_active(const UiTable* table) { return !sentinel_check(table->row); }
 
 void ui_table_add_column(UiTable* table, const UiTableColumnType type, const f32 width) {
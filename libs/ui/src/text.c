@@ -1,3 +1,5 @@
+#include "core/alloc.h"
+#include "core/bits.h"
 #include "core/diag.h"
 #include "core/math.h"
 #include "core/unicode.h"
@@ -11,6 +13,11 @@
 #define ui_text_tab_size 8
 #define ui_text_max_lines 1000
 #define ui_text_max_backgrounds 50
+#define ui_text_cache_slots 1024
+#define ui_text_cache_probes 4
+#define ui_text_cache_lines_max 8
+
+ASSERT((ui_text_cache_slots & (ui_text_cache_slots - 1)) == 0, "Slots needs to be a power-of-two");
 
 typedef struct {
   const AssetFontTexComp*   font;
@@ -50,6 +57,82 @@ typedef struct {
   u32              count, active;
 } UiTextBackgroundCollector;
 
+typedef struct {
+  u16 offset, size; // Byte range into the text.
+  f32 width;
+} UiTextCacheLine;
+
+/**
+ * Cached output of the line layout (shaping) phase for a single piece of text.
+ * Texts with backgrounds or more then 'ui_text_cache_lines_max' lines are not cached.
+ */
+typedef struct {
+  u32             key;      // Hash of the shaping inputs; 0 when the slot is empty.
+  u32             lastUse;  // Use counter at the last hit; least-recently-used slots get evicted.
+  u16             textSize; // Sanity check against key collisions.
+  u8              lineCount;
+  u32             maxLineCharWidth;
+  f32             totalWidth;
+  UiTextCacheLine lines[ui_text_cache_lines_max];
+} UiTextCacheEntry;
+
+/**
+ * Cache of shaped text so unchanged labels skip the line layout work.
+ * NOTE: Does not need any synchronization as ui building is serialized.
+ */
+static UiTextCacheEntry* g_uiTextCache;
+static u32               g_uiTextCacheUse;
+
+static u32 ui_text_cache_key(
+    const AssetFontTexComp* font,
+    const UiFlags           flags,
+    const UiRect            rect,
+    const String            text,
+    const f32               fontSize,
+    const u8                fontVariation,
+    const UiTransform       fontTransform) {
+  const uptr fontPtr  = (uptr)font; // Invalidate when the font is reloaded.
+  const u32  modeBits = (u32)flags | ((u32)fontVariation << 16) | ((u32)fontTransform << 24);
+
+  u32 hash = bits_hash_32(text);
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(fontPtr)));
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(modeBits)));
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(rect.size)));
+  hash     = bits_hash_32_combine(hash, bits_hash_32(mem_var(fontSize)));
+  return hash ? hash : 1; // Hash 0 marks an empty slot.
+}
+
+static UiTextCacheEntry* ui_text_cache_find(const u32 key, const u16 textSize) {
+  if (UNLIKELY(!g_uiTextCache)) {
+    const usize cacheSize = sizeof(UiTextCacheEntry) * ui_text_cache_slots;
+    g_uiTextCache         = alloc_array_t(g_allocPersist, UiTextCacheEntry, ui_text_cache_slots);
+    mem_set(mem_create(g_uiTextCache, cacheSize), 0);
+  }
+  ++g_uiTextCacheUse;
+  for (u32 probe = 0; probe != ui_text_cache_probes; ++probe) {
+    UiTextCacheEntry* entry = &g_uiTextCache[(key + probe) & (ui_text_cache_slots - 1)];
+    if (entry->key == key && entry->textSize == textSize) {
+      entry->lastUse = g_uiTextCacheUse;
+      return entry;
+    }
+  }
+  return null;
+}
+
+static UiTextCacheEntry* ui_text_cache_insert_slot(const u32 key) {
+  UiTextCacheEntry* best = null;
+  for (u32 probe = 0; probe != ui_text_cache_probes; ++probe) {
+    UiTextCacheEntry* entry = &g_uiTextCache[(key + probe) & (ui_text_cache_slots - 1)];
+    if (!entry->key) {
+      return entry; // Empty slot.
+    }
+    if (!best || entry->lastUse < best->lastUse) {
+      best = entry; // Evict the least-recently-used slot.
+    }
+  }
+  return best;
+}
+
 static Unicode ui_text_apply_transform(Unicode cp, const UiTransform transform) {
   if (UNLIKELY(transform == UiTransform_ToUpper && cp >= 'a' && cp <= 'z')) {
     cp ^= 0x20;
@@ -472,6 +555,8 @@ UiTextBuildResult ui_text_build(
 
   /**
    * Compute all lines and backgrounds.
+   * Line layout output is cached; unchanged texts reuse last time's lines (reconstructed against
+   * the current text memory as the commands are stored in frame-transient memory).
    */
   const bool                overflowVert = (flags & UiFlags_VerticalOverflow) != 0;
   UiTextBackgroundCollector bgCollector  = {.active = sentinel_u32};
@@ -480,36 +565,74 @@ UiTextBuildResult ui_text_build(
   f32                       lineY            = 0;
   f32                       totalWidth       = 0;
   u32                       maxLineCharWidth = 0;
-  String                    remText          = text;
-  while (!string_is_empty(remText)) {
-    const f32 lineHeight = lineCount ? (1 + font->lineSpacing) * fontSize : fontSize;
-    if (!overflowVert && lineY + lineHeight >= totalRect.height - font->lineSpacing * fontSize) {
-      break; // Not enough space remaining for this line.
+
+  const bool cacheable = text.size < u16_max;
+  const u32  cacheKey =
+      ui_text_cache_key(font, flags, totalRect, text, fontSize, fontVariation, fontTransform);
+
+  UiTextCacheEntry* cacheHit = cacheable ? ui_text_cache_find(cacheKey, (u16)text.size) : null;
+  if (cacheHit) {
+    lineCount        = cacheHit->lineCount;
+    totalWidth       = cacheHit->totalWidth;
+    maxLineCharWidth = cacheHit->maxLineCharWidth;
+    for (u32 i = 0; i != lineCount; ++i) {
+      lineY += i ? (1 + font->lineSpacing) * fontSize : fontSize;
+      lines[i] = (UiTextLine){
+          .text = string_slice(text, cacheHit->lines[i].offset, cacheHit->lines[i].size),
+          .size = ui_vector(cacheHit->lines[i].width, fontSize),
+          .posY = lineY,
+      };
     }
-    lineY += lineHeight;
+  } else {
+    String remText = text;
+    while (!string_is_empty(remText)) {
+      const f32 lineHeight = lineCount ? (1 + font->lineSpacing) * fontSize : fontSize;
+      if (!overflowVert && lineY + lineHeight >= totalRect.height - font->lineSpacing * fontSize) {
+        break; // Not enough space remaining for this line.
+      }
+      lineY += lineHeight;
 
-    if (lineCount + 1 >= ui_text_max_lines) {
-      log_w("Ui text line count exceeds maximum", log_param("limit", fmt_int(ui_text_max_lines)));
-      break;
+      if (lineCount + 1 >= ui_text_max_lines) {
+        log_w("Ui text line count exceeds maximum", log_param("limit", fmt_int(ui_text_max_lines)));
+        break;
+      }
+      const usize lineIndex = lineCount++;
+      remText               = ui_text_line(
+          font,
+          flags,
+          remText,
+          totalRect.width,
+          fontSize,
+          fontVariation,
+          fontTransform,
+          &bgCollector,
+          &lines[lineIndex]);
+
+      lines[lineIndex].posY = lineY;
+      totalWidth            = math_max(totalWidth, lines[lineIndex].size.width);
+      maxLineCharWidth      = math_max(maxLineCharWidth, (u32)lines[lineIndex].text.size);
+
+      if (flags & UiFlags_SingleLine) {
+        break;
+      }
     }
-    const usize lineIndex = lineCount++;
-    remText               = ui_text_line(
-        font,
-        flags,
-        remText,
-        totalRect.width,
-        fontSize,
-        fontVariation,
-        fontTransform,
-        &bgCollector,
-        &lines[lineIndex]);
-
-    lines[lineIndex].posY = lineY;
-    totalWidth            = math_max(totalWidth, lines[lineIndex].size.width);
-    maxLineCharWidth      = math_max(maxLineCharWidth, (u32)lines[lineIndex].text.size);
-
-    if (flags & UiFlags_SingleLine) {
-      break;
+    if (cacheable && !bgCollector.count && lineCount <= ui_text_cache_lines_max) {
+      UiTextCacheEntry* entry = ui_text_cache_insert_slot(cacheKey);
+      entry->key              = cacheKey;
+      entry->lastUse          = g_uiTextCacheUse;
+      entry->textSize         = (u16)text.size;
+      entry->lineCount        = (u8)lineCount;
+      entry->maxLineCharWidth = maxLineCharWidth;
+      entry->totalWidth       = totalWidth;
+      for (u32 i = 0; i != lineCount; ++i) {
+        const usize offset =
+            lines[i].text.size ? (usize)((u8*)lines[i].text.ptr - (u8*)text.ptr) : 0;
+        entry->lines[i] = (UiTextCacheLine){
+            .offset = (u16)offset,
+            .size   = (u16)lines[i].text.size,
+            .width  = lines[i].size.width,
+        };
+      }
     }
   }
   const UiVector size = ui_vector(totalWidth, lineY + font->baseline * fontSize);
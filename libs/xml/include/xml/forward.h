@@ -6,8 +6,11 @@
  */
 
 typedef enum eXmlError       XmlError;
+typedef enum eXmlEventType   XmlEventType;
 typedef enum eXmlResultType  XmlResultType;
 typedef struct sXmlAttribute XmlAttribute;
 typedef struct sXmlDoc       XmlDoc;
+typedef struct sXmlEvent     XmlEvent;
+typedef struct sXmlPull      XmlPull;
 typedef struct sXmlResult    XmlResult;
 typedef u32                  XmlNode;
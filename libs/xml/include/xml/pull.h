@@ -0,0 +1,64 @@
+#pragma once
+#include "core/string.h"
+#include "xml/read.h"
+
+/**
+ * Streaming (pull based) Xml parser.
+ * Produces a flat stream of events instead of building an XmlDoc, allowing arbitrarily large
+ * documents to be processed with constant memory.
+ */
+
+#define xml_pull_depth_max 100
+
+typedef enum eXmlEventType {
+  XmlEventType_ElemBegin, // Element opened; 'name' contains the tag name.
+  XmlEventType_ElemEnd,   // Element closed; 'name' contains the tag name.
+  XmlEventType_Attr,      // Attribute on the last opened element; 'name' and 'value'.
+  XmlEventType_Text,      // Text content inside the current element; 'value'.
+  XmlEventType_Comment,   // Comment inside the current element; 'value'.
+  XmlEventType_End,       // Document fully parsed.
+  XmlEventType_Error,     // Parsing failed; 'error' contains the reason.
+} XmlEventType;
+
+/**
+ * Single parse event.
+ * NOTE: Strings are allocated in the original input or scratch memory, the caller is responsible
+ * for copying them if they wish to persist them.
+ */
+typedef struct sXmlEvent {
+  XmlEventType type;
+  String       name, value;
+  XmlError     error;
+} XmlEvent;
+
+/**
+ * Parser state, initialize using 'xml_pull_init()'.
+ * NOTE: Fields should not be accessed directly, except 'input' to observe the remaining text.
+ */
+typedef struct sXmlPull {
+  String input; // Remaining input text.
+  u32    depth;
+  bool   started;  // Markup (declaration or root element) has been encountered.
+  bool   inMarkup; // Positioned inside a tag, reading attributes.
+  bool   inDecl;   // Current markup is the xml declaration.
+  bool   finished;
+  String tags[xml_pull_depth_max]; // Names of the currently open elements.
+} XmlPull;
+
+/**
+ * Initialize a pull parser over the given input text.
+ * NOTE: The input text needs to stay valid while the parser is in use.
+ */
+XmlPull xml_pull_init(String input);
+
+/**
+ * Read the next parse event.
+ * Supports the same subset of Xml 1.0 as 'xml_read()'.
+ *
+ * Returns the event type (same as 'out->type').
+ * After an 'XmlEventType_Error' event (or once the root element has been closed) all further calls
+ * produce 'XmlEventType_End'.
+ *
+ * Pre-condition: out != null.
+ */
+XmlEventType xml_pull_next(XmlPull*, XmlEvent* out);
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/file.h"
 #include "core/string.h"
 #include "xml/forward.h"
 
@@ -26,8 +27,25 @@ typedef struct {
       .newline = string_lit("\n"),                                                                 \
       __VA_ARGS__})
 
+/**
+ * Sink that receives the xml output, invoked repeatedly with consecutive chunks of the document.
+ */
+typedef void (*XmlWriteSink)(void* ctx, String chunk);
+
 /**
  * Write a Xml node.
  * Supports a subset of Xml 1.0 (https://www.w3.org/TR/2008/REC-xml-20081126/).
  */
 void xml_write(DynString*, const XmlDoc*, XmlNode, const XmlWriteOpts*);
+
+/**
+ * Write a Xml node to the given sink in fixed-size chunks.
+ * Runs free of allocations; useful for streaming large documents without growing a string.
+ */
+void xml_write_sink(XmlWriteSink, void* ctx, const XmlDoc*, XmlNode, const XmlWriteOpts*);
+
+/**
+ * Write a Xml node directly to the given file in fixed-size chunks.
+ * Runs free of allocations; returns the first write error (if any).
+ */
+FileResult xml_write_file(File*, const XmlDoc*, XmlNode, const XmlWriteOpts*);
@@ -0,0 +1,141 @@
+#include "core/diag.h"
+#include "xml/pull.h"
+
+#include "lex.h"
+
+static XmlEventType pull_err(XmlPull* pull, XmlEvent* out, const XmlError err) {
+  pull->finished = true;
+  *out           = (XmlEvent){.type = XmlEventType_Error, .error = err};
+  return out->type;
+}
+
+static XmlEventType pull_err_from_token(
+    XmlPull* pull, XmlEvent* out, const XmlToken token, const XmlError custom) {
+  if (token.type == XmlTokenType_Error) {
+    return pull_err(pull, out, token.val_error);
+  }
+  if (token.type == XmlTokenType_End) {
+    return pull_err(pull, out, XmlError_Truncated);
+  }
+  return pull_err(pull, out, custom);
+}
+
+static XmlEventType pull_elem_begin(XmlPull* pull, XmlEvent* out, const String tag) {
+  pull->tags[pull->depth++] = tag;
+  pull->inMarkup            = true;
+  *out                      = (XmlEvent){.type = XmlEventType_ElemBegin, .name = tag};
+  return out->type;
+}
+
+static XmlEventType pull_elem_end(XmlPull* pull, XmlEvent* out) {
+  const String tag = pull->tags[--pull->depth];
+  if (!pull->depth && !pull->inDecl) {
+    pull->finished = true; // Root element closed.
+  }
+  pull->inDecl = false;
+  *out         = (XmlEvent){.type = XmlEventType_ElemEnd, .name = tag};
+  return out->type;
+}
+
+static XmlEventType pull_attr(XmlPull* pull, XmlEvent* out, const XmlToken nameToken) {
+  XmlToken equalToken;
+  pull->input = xml_lex(pull->input, XmlPhase_Markup, &equalToken);
+  if (UNLIKELY(equalToken.type != XmlTokenType_Equal)) {
+    return pull_err_from_token(pull, out, equalToken, XmlError_InvalidAttribute);
+  }
+  XmlToken valueToken;
+  pull->input = xml_lex(pull->input, XmlPhase_Markup, &valueToken);
+  if (UNLIKELY(valueToken.type != XmlTokenType_String)) {
+    return pull_err_from_token(pull, out, valueToken, XmlError_InvalidAttributeValue);
+  }
+  *out = (XmlEvent){
+      .type  = XmlEventType_Attr,
+      .name  = nameToken.val_name,
+      .value = valueToken.val_string,
+  };
+  return out->type;
+}
+
+XmlPull xml_pull_init(const String input) { return (XmlPull){.input = input}; }
+
+XmlEventType xml_pull_next(XmlPull* pull, XmlEvent* out) {
+  diag_assert(out);
+
+  if (pull->finished) {
+    *out = (XmlEvent){.type = XmlEventType_End};
+    return out->type;
+  }
+
+  XmlToken token;
+  for (;;) {
+    // Inside a tag; read attributes until the tag is closed.
+    if (pull->inMarkup) {
+      pull->input = xml_lex(pull->input, XmlPhase_Markup, &token);
+      switch (token.type) {
+      case XmlTokenType_Name:
+        return pull_attr(pull, out, token);
+      case XmlTokenType_TagClose:
+        if (UNLIKELY(pull->inDecl)) {
+          return pull_err(pull, out, XmlError_UnexpectedToken);
+        }
+        pull->inMarkup = false;
+        continue; // Element content follows.
+      case XmlTokenType_TagEndClose: // Self closing element.
+        if (UNLIKELY(pull->inDecl)) {
+          return pull_err(pull, out, XmlError_UnexpectedToken);
+        }
+        pull->inMarkup = false;
+        return pull_elem_end(pull, out);
+      case XmlTokenType_DeclClose:
+        if (UNLIKELY(!pull->inDecl)) {
+          return pull_err(pull, out, XmlError_UnexpectedToken);
+        }
+        pull->inMarkup = false;
+        return pull_elem_end(pull, out);
+      default:
+        return pull_err_from_token(pull, out, token, XmlError_InvalidAttribute);
+      }
+    }
+
+    // Before the root element (or after the optional declaration).
+    if (!pull->depth) {
+      pull->input = xml_lex(pull->input, XmlPhase_Markup, &token);
+      switch (token.type) {
+      case XmlTokenType_DeclStart:
+        if (UNLIKELY(pull->started || !string_eq(token.val_decl, string_lit("xml")))) {
+          return pull_err(pull, out, XmlError_InvalidDecl);
+        }
+        pull->started = pull->inDecl = true;
+        return pull_elem_begin(pull, out, token.val_decl);
+      case XmlTokenType_TagStart:
+        pull->started = true;
+        return pull_elem_begin(pull, out, token.val_tag);
+      default:
+        return pull_err_from_token(pull, out, token, XmlError_UnexpectedToken);
+      }
+    }
+
+    // Inside an element; read content.
+    pull->input = xml_lex(pull->input, XmlPhase_Content, &token);
+    switch (token.type) {
+    case XmlTokenType_Content:
+      *out = (XmlEvent){.type = XmlEventType_Text, .value = token.val_content};
+      return out->type;
+    case XmlTokenType_Comment:
+      *out = (XmlEvent){.type = XmlEventType_Comment, .value = token.val_comment};
+      return out->type;
+    case XmlTokenType_TagStart:
+      if (UNLIKELY(pull->depth == xml_pull_depth_max)) {
+        return pull_err(pull, out, XmlError_MaximumDepthExceeded);
+      }
+      return pull_elem_begin(pull, out, token.val_tag);
+    case XmlTokenType_TagEnd:
+      if (UNLIKELY(!string_eq(token.val_tag, pull->tags[pull->depth - 1]))) {
+        return pull_err(pull, out, XmlError_MismatchedEndTag);
+      }
+      return pull_elem_end(pull, out);
+    default:
+      return pull_err_from_token(pull, out, token, XmlError_UnexpectedToken);
+    }
+  }
+}
@@ -1,23 +1,58 @@
+#include "core/bits.h"
 #include "core/diag.h"
 #include "core/dynstring.h"
+#include "core/file.h"
 #include "xml/doc.h"
 #include "xml/write.h"
 
+#ifdef VOLO_SIMD
+#include "core/simd.h"
+#endif
+
+#define xml_write_buffer_size (4 * usize_kibibyte)
+
 typedef struct {
   const XmlDoc*       doc;
   const XmlWriteOpts* opts;
-  DynString*          out;
   u32                 indent;
+  DynString           buffer; // Fixed-capacity chunk buffer; flushed to the sink when full.
+  XmlWriteSink        sink;
+  void*               sinkCtx;
 } XmlWriteState;
 
 static void xml_write_node(XmlWriteState*, XmlNode);
 static void xml_write_node_attr(XmlWriteState*, XmlNode);
 static void xml_write_node_text(XmlWriteState*, XmlNode);
 
+static void xml_state_flush(XmlWriteState* s) {
+  if (s->buffer.size) {
+    s->sink(s->sinkCtx, dynstring_view(&s->buffer));
+    dynstring_clear(&s->buffer);
+  }
+}
+
+static void xml_state_out(XmlWriteState* s, const String text) {
+  if (UNLIKELY((s->buffer.data.size - s->buffer.size) < text.size)) {
+    xml_state_flush(s);
+    if (UNLIKELY(text.size >= s->buffer.data.size)) {
+      s->sink(s->sinkCtx, text); // Too big to buffer; hand it to the sink directly.
+      return;
+    }
+  }
+  dynstring_append(&s->buffer, text);
+}
+
+INLINE_HINT static void xml_state_out_char(XmlWriteState* s, const u8 c) {
+  if (UNLIKELY(s->buffer.size == s->buffer.data.size)) {
+    xml_state_flush(s);
+  }
+  dynstring_append_char(&s->buffer, c);
+}
+
 static void xml_write_separator(XmlWriteState* s) {
-  dynstring_append(s->out, s->opts->newline);
+  xml_state_out(s, s->opts->newline);
   for (u32 i = 0; i != s->indent; ++i) {
-    dynstring_append(s->out, s->opts->indent);
+    xml_state_out(s, s->opts->indent);
   }
 }
 
@@ -32,27 +67,27 @@ static void xml_write_outdent(XmlWriteState* s) {
 }
 
 static void xml_write_decl(XmlWriteState* s) {
-  dynstring_append(s->out, string_lit("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"));
+  xml_state_out(s, string_lit("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"));
   xml_write_separator(s);
 }
 
 static void xml_write_node_elem(XmlWriteState* s, const XmlNode node) {
-  dynstring_append_char(s->out, '<');
-  dynstring_append(s->out, xml_name(s->doc, node));
+  xml_state_out_char(s, '<');
+  xml_state_out(s, xml_name(s->doc, node));
 
   XmlNode attr = xml_first_attr(s->doc, node);
   for (; !sentinel_check(attr); attr = xml_next(s->doc, attr)) {
-    dynstring_append_char(s->out, ' ');
+    xml_state_out_char(s, ' ');
     xml_write_node_attr(s, attr);
   }
 
   XmlNode child = xml_first_child(s->doc, node);
   if (sentinel_check(child)) {
-    dynstring_append(s->out, string_lit("/>"));
+    xml_state_out(s, string_lit("/>"));
     return;
   }
 
-  dynstring_append_char(s->out, '>');
+  xml_state_out_char(s, '>');
 
   const bool singleChild = sentinel_check(xml_next(s->doc, child));
   if (singleChild && xml_type(s->doc, child) == XmlType_Text) {
@@ -69,43 +104,75 @@ static void xml_write_node_elem(XmlWriteState* s, const XmlNode node) {
     xml_write_outdent(s);
   }
 
-  dynstring_append(s->out, string_lit("</"));
-  dynstring_append(s->out, xml_name(s->doc, node));
-  dynstring_append_char(s->out, '>');
+  xml_state_out(s, string_lit("</"));
+  xml_state_out(s, xml_name(s->doc, node));
+  xml_state_out_char(s, '>');
 }
 
 static void xml_write_node_attr(XmlWriteState* s, const XmlNode node) {
-  dynstring_append(s->out, xml_name(s->doc, node));
-  dynstring_append_char(s->out, '=');
-  dynstring_append_char(s->out, '\"');
-  dynstring_append(s->out, xml_value(s->doc, node));
-  dynstring_append_char(s->out, '\"');
+  xml_state_out(s, xml_name(s->doc, node));
+  xml_state_out_char(s, '=');
+  xml_state_out_char(s, '\"');
+  xml_state_out(s, xml_value(s->doc, node));
+  xml_state_out_char(s, '\"');
+}
+
+/**
+ * Find the end of the escape-free run starting at 'itr': the first '<', '>' or '&' (or end).
+ */
+static const u8* xml_text_run_end(const u8* itr, const u8* end) {
+#ifdef VOLO_SIMD
+  // Scan whole blocks at a time until a block contains a character that needs escaping.
+  for (; (usize)(end - itr) >= 16; itr += 16) {
+    const SimdVec block   = simd_vec_load_unaligned(itr);
+    const SimdVec special = simd_vec_or(
+        simd_vec_or(
+            simd_vec_eq_u8(block, simd_vec_broadcast_u8('<')),
+            simd_vec_eq_u8(block, simd_vec_broadcast_u8('>'))),
+        simd_vec_eq_u8(block, simd_vec_broadcast_u8('&')));
+    const u32 mask = simd_vec_mask_u8(special);
+    if (mask) {
+      return itr + bits_ctz_32(mask);
+    }
+  }
+#endif
+  for (; itr != end; ++itr) {
+    if (*itr == '<' || *itr == '>' || *itr == '&') {
+      break;
+    }
+  }
+  return itr;
 }
 
 static void xml_write_node_text(XmlWriteState* s, const XmlNode node) {
   const String text = xml_value(s->doc, node);
-  mem_for_u8(text, itr) {
-    switch (*itr) {
+  const u8*    itr  = string_begin(text);
+  const u8*    end  = string_end(text);
+  while (itr != end) {
+    const u8* runEnd = xml_text_run_end(itr, end);
+    xml_state_out(s, mem_from_to(itr, runEnd)); // Copy the whole escape-free run at once.
+    if (runEnd == end) {
+      break;
+    }
+    switch (*runEnd) {
     case '<':
-      dynstring_append(s->out, string_lit("&lt;"));
+      xml_state_out(s, string_lit("&lt;"));
       break;
     case '>':
-      dynstring_append(s->out, string_lit("&gt;"));
+      xml_state_out(s, string_lit("&gt;"));
       break;
     case '&':
-      dynstring_append(s->out, string_lit("&amp;"));
-      break;
-    default:
-      dynstring_append_char(s->out, *itr);
+      xml_state_out(s, string_lit("&amp;"));
       break;
     }
+    itr = runEnd + 1;
   }
 }
 
 static void xml_write_node_comment(XmlWriteState* s, const XmlNode node) {
-  dynstring_append(s->out, string_lit("<!-- "));
-  dynstring_append(s->out, xml_value(s->doc, node));
-  dynstring_append(s->out, string_lit(" -->"));
+  xml_state_out(s, string_lit("<!-- "));
+  xml_state_out(s, xml_value(s->doc, node));
+  xml_state_out(s, string_lit(" -->"));
 }
 
 static void xml_write_node(XmlWriteState* s, const XmlNode node) {
@@ -128,15 +195,51 @@ static void xml_write_node(XmlWriteState* s, const XmlNode node) {
   diag_crash();
 }
 
-void xml_write(DynString* str, const XmlDoc* doc, const XmlNode node, const XmlWriteOpts* opts) {
+void xml_write_sink(
+    const XmlWriteSink  sink,
+    void*               ctx,
+    const XmlDoc*       doc,
+    const XmlNode       node,
+    const XmlWriteOpts* opts) {
+  u8            bufferMem[xml_write_buffer_size];
   XmlWriteState state = {
-      .doc    = doc,
-      .opts   = opts,
-      .out    = str,
-      .indent = 0,
+      .doc     = doc,
+      .opts    = opts,
+      .indent  = 0,
+      .buffer  = dynstring_create_over(mem_var(bufferMem)),
+      .sink    = sink,
+      .sinkCtx = ctx,
   };
   if (!(opts->flags & XmlWriteFlags_SkipDeclaration)) {
     xml_write_decl(&state);
   }
   xml_write_node(&state, node);
+  xml_state_flush(&state);
+}
+
+static void xml_write_dynstring_sink(void* ctx, const String chunk) {
+  dynstring_append((DynString*)ctx, chunk);
+}
+
+void xml_write(DynString* str, const XmlDoc* doc, const XmlNode node, const XmlWriteOpts* opts) {
+  xml_write_sink(xml_write_dynstring_sink, str, doc, node, opts);
+}
+
+typedef struct {
+  File*      file;
+  FileResult result;
+} XmlWriteFileCtx;
+
+static void xml_write_file_sink(void* ctx, const String chunk) {
+  XmlWriteFileCtx* fileCtx = ctx;
+  if (fileCtx->result == FileResult_Success) {
+    fileCtx->result = file_write_sync(fileCtx->file, chunk);
+  }
+}
+
+FileResult
+xml_write_file(File* file, const XmlDoc* doc, const XmlNode node, const XmlWriteOpts* opts) {
+  XmlWriteFileCtx ctx = {.file = file, .result = FileResult_Success};
+  xml_write_sink(xml_write_file_sink, &ctx, doc, node, opts);
+  return ctx.result;
 }
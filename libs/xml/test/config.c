@@ -3,6 +3,7 @@
 void app_check_init(CheckDef* check) {
   register_spec(check, doc);
   register_spec(check, eq);
+  register_spec(check, pull);
   register_spec(check, read);
   register_spec(check, write);
 }
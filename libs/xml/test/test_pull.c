@@ -0,0 +1,80 @@
+#include "check/spec.h"
+#include "xml/pull.h"
+
+spec(pull) {
+
+  it("can pull events from a document with a declaration") {
+    XmlPull pull = xml_pull_init(
+        string_lit("<?xml version=\"1.0\"?>"
+                   "<test a=\"1\"><child>Hello</child><!-- A comment --></test>"));
+
+    XmlEvent evt;
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_string(evt.name, string_lit("xml"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_Attr);
+    check_eq_string(evt.name, string_lit("version"));
+    check_eq_string(evt.value, string_lit("1.0"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemEnd);
+    check_eq_string(evt.name, string_lit("xml"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_string(evt.name, string_lit("test"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_Attr);
+    check_eq_string(evt.name, string_lit("a"));
+    check_eq_string(evt.value, string_lit("1"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_string(evt.name, string_lit("child"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_Text);
+    check_eq_string(evt.value, string_lit("Hello"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemEnd);
+    check_eq_string(evt.name, string_lit("child"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_Comment);
+    check_eq_string(evt.value, string_lit("A comment"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemEnd);
+    check_eq_string(evt.name, string_lit("test"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_End);
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_End);
+  }
+
+  it("can pull events from a self-closing root element") {
+    XmlPull pull = xml_pull_init(string_lit("<test/>"));
+
+    XmlEvent evt;
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_string(evt.name, string_lit("test"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemEnd);
+    check_eq_string(evt.name, string_lit("test"));
+
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_End);
+  }
+
+  it("fails on a mismatched end tag") {
+    XmlPull pull = xml_pull_init(string_lit("<test></other>"));
+
+    XmlEvent evt;
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_Error);
+    check_eq_int(evt.error, XmlError_MismatchedEndTag);
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_End);
+  }
+
+  it("fails on truncated input") {
+    XmlPull pull = xml_pull_init(string_lit("<test><child>"));
+
+    XmlEvent evt;
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_ElemBegin);
+    check_eq_int(xml_pull_next(&pull, &evt), XmlEventType_Error);
+    check_eq_int(evt.error, XmlError_Truncated);
+  }
+}
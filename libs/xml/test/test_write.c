@@ -5,6 +5,10 @@
 #include "xml/doc.h"
 #include "xml/write.h"
 
+static void test_write_collect_sink(void* ctx, const String chunk) {
+  dynstring_append((DynString*)ctx, chunk);
+}
+
 spec(write) {
 
   XmlDoc*   doc    = null;
@@ -146,6 +150,25 @@ spec(write) {
     }
   }
 
+  it("can write text with mixed escape-free runs and special characters") {
+    DynString rawText = dynstring_create(g_allocPage, usize_kibibyte * 16);
+    for (u32 i = 0; i != 256; ++i) {
+      dynstring_append(&rawText, string_lit("A reasonably long escape-free run & more <text>"));
+    }
+    const XmlNode node = xml_add_elem(doc, sentinel_u32, string_lit("test"));
+    xml_add_text(doc, node, dynstring_view(&rawText));
+
+    // Stream the document through the sink api; the output has to match the direct write exactly.
+    DynString reference = dynstring_create(g_allocPage, usize_kibibyte * 64);
+    xml_write(&reference, doc, node, &xml_write_opts());
+
+    xml_write_sink(test_write_collect_sink, &buffer, doc, node, &xml_write_opts());
+    check_eq_string(dynstring_view(&buffer), dynstring_view(&reference));
+
+    dynstring_destroy(&reference);
+    dynstring_destroy(&rawText);
+  }
+
   teardown() {
     xml_destroy(doc);
     dynstring_destroy(&buffer);